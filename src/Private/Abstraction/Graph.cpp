@@ -1 +1,8 @@
 #include "../../Public/Abstraction/Graph.h"
+
+namespace core {
+	template<typename E>
+	size_t Graph<E>::mergeExtent() const {
+		return getVertices();
+	}
+}
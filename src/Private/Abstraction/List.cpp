@@ -14,7 +14,7 @@ namespace core
 
 	template<typename E>
 	[[nodiscard]] double List<E>::load() const {
-		return this->maxCapacity * 1.0 / this->activeCapacity;
+		return this->activeCapacity * 1.0 / this->maxCapacity;
 	}
 
 	template<typename E>
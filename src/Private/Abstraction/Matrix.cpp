@@ -1 +1,8 @@
 #include "../../Public/Abstraction/Matrix.h"
+
+namespace core {
+	template<typename E>
+	size_t Matrix<E>::mergeExtent() const {
+		return getRows();
+	}
+}
@@ -1 +1,43 @@
 #include "../../Public/Abstraction/Set.h"
+
+namespace core {
+	template<typename E>
+	template<typename T> requires ValidBase<E, T>
+	[[nodiscard]] bool Set<E>::containsAll(T* set) {
+		if (set == nullptr) {
+			return false;
+		}
+		std::any erased(static_cast<Set<E>*>(set));
+		return containsAllInternal(&erased);
+	}
+
+	template<typename E>
+	template<typename T> requires ValidBase<E, T>
+	bool Set<E>::addAll(T* set) {
+		if (set == nullptr) {
+			return false;
+		}
+		std::any erased(static_cast<Set<E>*>(set));
+		return addAllInternal(&erased);
+	}
+
+	template<typename E>
+	template<typename T> requires ValidBase<E, T>
+	bool Set<E>::retainAll(T* set) {
+		if (set == nullptr) {
+			return false;
+		}
+		std::any erased(static_cast<Set<E>*>(set));
+		return retainAllInternal(&erased);
+	}
+
+	template<typename E>
+	template<typename T> requires ValidBase<E, T>
+	bool Set<E>::discardAll(T* set) {
+		if (set == nullptr) {
+			return false;
+		}
+		std::any erased(static_cast<Set<E>*>(set));
+		return discardAllInternal(&erased);
+	}
+}
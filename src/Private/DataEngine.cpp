@@ -1,4 +1,5 @@
 #include "../Public/DataEngine.h"
+#include <algorithm>
 
 namespace core {
 	template <typename E>
@@ -11,9 +12,14 @@ namespace core {
 		return maxCapacity;
 	}
 
+	template <typename E>
+	size_t DataEngine<E>::mergeExtent() const {
+		return getActiveSize();
+	}
+
 	template <typename E>
 	bool DataEngine<E>::isEmpty() const {
-		return activeCapacity > 0;
+		return getActiveSize() == 0;
 	}
 
 	template <typename E>
@@ -28,43 +34,57 @@ namespace core {
 
 	template<typename E>
 	template<typename T> requires ValidBase<E, T>
-	std::atomic<T>* DataEngine<E>::getThreadSafeImage() const {
-		return std::any_cast<std::atomic<T>*>(getThreadSafeImage());
+	std::unique_ptr<ThreadSafeImage<T>> DataEngine<E>::getThreadSafeImage() const {
+		std::unique_ptr<DataEngine<E>> copy = clone();
+		auto engine = dynamic_cast<T*>(copy.get());
+		if (engine == nullptr) {
+			return nullptr;
+		}
+		copy.release();
+		return std::make_unique<ThreadSafeImage<T>>(std::unique_ptr<T>(engine));
 	}
 
 	template<typename E>
 	template<typename T> requires ValidBase<E, T>
-	bool DataEngine<E>::operator==(T de) const {
-		return std::any_cast<T>(operator==(de));
+	bool DataEngine<E>::operator==(const T& de) const {
+		return equalsInternal(de);
 	}
 
 	template<typename E>
 	template<typename T> requires ValidBase<E, T>
-	bool DataEngine<E>::equals(T de, int start, int end) const {
-		return std::any_cast<T>(equals(de, start, end));
+	bool DataEngine<E>::equals(const T& de, int start, int end) const {
+		if (start < 0 || end < start) {
+			return false;
+		}
+		if (start == end) {
+			return true;
+		}
+		std::unique_ptr<E[]> mine(toArray(start, end));
+		std::unique_ptr<E[]> theirs(de.toArray(start, end));
+		return mine != nullptr && theirs != nullptr && std::equal(mine.get(), mine.get() + (end - start), theirs.get());
 	}
 
 	template<typename E>
 	template<typename T> requires ValidBase<E, T>
-	bool DataEngine<E>::equivalence(T de) const {
-		return std::any_cast<T>(equivalence(de));
+	bool DataEngine<E>::equivalence(const T& de) const {
+		return equivalenceInternal(de);
 	}
 
 	template<typename E>
 	template<typename T> requires ValidBase<E, T>
-	T DataEngine<E>::merge(T de) const {
-		return std::any_cast<T>(merge(std::any(de)));
+	std::unique_ptr<DataEngine<E>> DataEngine<E>::merge(const T& de) const {
+		return mergeInternal(de, 0, static_cast<int>(de.mergeExtent()));
 	}
 
 	template<typename E>
 	template<typename T> requires ValidBase<E, T>
-	T DataEngine<E>::merge(T de, int start) const {
-		return std::any_cast<T>(merge(std::any(de), start));
+	std::unique_ptr<DataEngine<E>> DataEngine<E>::merge(const T& de, int start) const {
+		return mergeInternal(de, start, static_cast<int>(de.mergeExtent()));
 	}
 
 	template<typename E>
 	template<typename T> requires ValidBase<E, T>
-	T DataEngine<E>::merge(T de, int start, int end) const {
-		return std::any_cast<T>(merge(std::any(de), start, end));
+	std::unique_ptr<DataEngine<E>> DataEngine<E>::merge(const T& de, int start, int end) const {
+		return mergeInternal(de, start, end);
 	}
 }
\ No newline at end of file
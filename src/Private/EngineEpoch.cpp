@@ -0,0 +1,92 @@
+#include "../Public/EngineEpoch.h"
+#include <algorithm>
+
+namespace core {
+	EpochDomain::~EpochDomain() {
+		drain();
+	}
+
+	[[nodiscard]] EpochDomain::Guard EpochDomain::pin() noexcept {
+		const size_t slot = threadSlot();
+		std::atomic<uint64_t>& state = slots[slot].state;
+		uint64_t current = state.load(std::memory_order_relaxed);
+		uint64_t next;
+		do {
+			//The first reader of a slot publishes the current epoch, later ones join at the slot's epoch
+			next = (current & COUNT_MASK) == 0 ? (epoch.load(std::memory_order_seq_cst) << COUNT_BITS) | 1 : current + 1;
+		} while (!state.compare_exchange_weak(current, next, std::memory_order_seq_cst, std::memory_order_relaxed));
+		//Orders the pin before every load of the traversal, pairs with the fence in retire
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		return Guard(this, slot);
+	}
+
+	void EpochDomain::retire(void* pointer, void (*deleter)(void*, void*), void* context) {
+		//Orders the unlink done by the caller before the epoch read, pairs with the fence in pin
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		const uint64_t current = epoch.load(std::memory_order_seq_cst);
+		Slot& slot = slots[threadSlot()];
+		unsigned spins = 0;
+		while (slot.locked.exchange(true, std::memory_order_acquire)) {
+			spinPause(spins);
+		}
+		slot.retired.push_back({ pointer, deleter, context, current });
+		if (slot.retired.size() % RECLAIM_PERIOD == 0) {
+			tryAdvance();
+			reclaim(slot);
+		}
+		slot.locked.store(false, std::memory_order_release);
+	}
+
+	void EpochDomain::collect() {
+		tryAdvance();
+		for (Slot& slot : slots) {
+			unsigned spins = 0;
+			while (slot.locked.exchange(true, std::memory_order_acquire)) {
+				spinPause(spins);
+			}
+			reclaim(slot);
+			slot.locked.store(false, std::memory_order_release);
+		}
+	}
+
+	void EpochDomain::drain() {
+		for (Slot& slot : slots) {
+			for (const Retired& retired : slot.retired) {
+				retired.deleter(retired.pointer, retired.context);
+			}
+			slot.retired.clear();
+		}
+	}
+
+	size_t EpochDomain::threadSlot() noexcept {
+		static std::atomic<size_t> assigned{ 0 };
+		thread_local const size_t slot = assigned.fetch_add(1, std::memory_order_relaxed) & (SLOTS - 1);
+		return slot;
+	}
+
+	void EpochDomain::unpin(size_t slot) noexcept {
+		slots[slot].state.fetch_sub(1, std::memory_order_release);
+	}
+
+	void EpochDomain::tryAdvance() noexcept {
+		uint64_t current = epoch.load(std::memory_order_seq_cst);
+		for (const Slot& slot : slots) {
+			const uint64_t state = slot.state.load(std::memory_order_seq_cst);
+			if ((state & COUNT_MASK) != 0 && (state >> COUNT_BITS) != current) {
+				return;
+			}
+		}
+		epoch.compare_exchange_strong(current, current + 1, std::memory_order_seq_cst);
+	}
+
+	void EpochDomain::reclaim(Slot& slot) {
+		//Readers pinned at the retirement epoch or before are gone once the epoch has moved two steps past it
+		const uint64_t current = epoch.load(std::memory_order_seq_cst);
+		auto live = std::partition(slot.retired.begin(), slot.retired.end(),
+			[current](const Retired& retired) { return retired.epoch + 2 > current; });
+		for (auto it = live; it != slot.retired.end(); ++it) {
+			it->deleter(it->pointer, it->context);
+		}
+		slot.retired.erase(live, slot.retired.end());
+	}
+}
@@ -0,0 +1,236 @@
+#include "../Public/EnginePool.h"
+#include "../Public/EngineCore.h"
+#include <algorithm>
+#include <bit>
+
+namespace core {
+	NodePool::NodePool(std::pmr::memory_resource* upstream) noexcept : upstream(upstream) {
+		for (auto& cache : caches) {
+			cache.store(nullptr, std::memory_order_relaxed);
+		}
+	}
+
+	NodePool::~NodePool() {
+		release();
+		for (auto& slot : caches) {
+			Cache* cache = slot.load(std::memory_order_relaxed);
+			if (cache != nullptr) {
+				std::destroy_at(cache);
+				upstream->deallocate(cache, sizeof(Cache), alignof(Cache));
+			}
+		}
+	}
+
+	void NodePool::release() noexcept {
+		for (auto& slot : caches) {
+			Cache* cache = slot.load(std::memory_order_relaxed);
+			if (cache != nullptr) {
+				std::fill(std::begin(cache->heads), std::end(cache->heads), nullptr);
+				std::fill(std::begin(cache->counts), std::end(cache->counts), 0);
+			}
+		}
+		std::fill(std::begin(classes), std::end(classes), SizeClass{});
+		while (slabs != nullptr) {
+			Slab* next = slabs->next;
+			upstream->deallocate(slabs, slabs->bytes, MAX_ALIGNMENT);
+			slabs = next;
+		}
+		while (large != nullptr) {
+			Large* next = large->next;
+			upstream->deallocate(reinterpret_cast<char*>(large + 1) - large->offset, large->bytes, large->alignment);
+			large = next;
+		}
+	}
+
+	void* NodePool::do_allocate(size_t bytes, size_t alignment) {
+		const size_t index = classOf(bytes, alignment);
+		if (index == CLASSES) {
+			return allocateLarge(bytes, alignment);
+		}
+		Cache& cache = threadCache();
+		lockCache(cache);
+		FreeBlock* block = cache.heads[index];
+		if (block == nullptr) {
+			try {
+				block = refill(index);
+			}
+			catch (...) {
+				unlockCache(cache);
+				throw;
+			}
+			cache.counts[index] = BATCH;
+		}
+		cache.heads[index] = block->next;
+		cache.counts[index]--;
+		unlockCache(cache);
+		return block;
+	}
+
+	void NodePool::do_deallocate(void* block, size_t bytes, size_t alignment) {
+		const size_t index = classOf(bytes, alignment);
+		if (index == CLASSES) {
+			deallocateLarge(block);
+			return;
+		}
+		//Blocks may be freed by any thread, they join the cache of the freeing one
+		Cache& cache = threadCache();
+		lockCache(cache);
+		auto freed = static_cast<FreeBlock*>(block);
+		freed->next = cache.heads[index];
+		cache.heads[index] = freed;
+		if (++cache.counts[index] == 2 * BATCH) {
+			flush(cache, index);
+		}
+		unlockCache(cache);
+	}
+
+	bool NodePool::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+		return this == &other;
+	}
+
+	size_t NodePool::threadSlot() noexcept {
+		static std::atomic<size_t> assigned{ 0 };
+		thread_local const size_t slot = assigned.fetch_add(1, std::memory_order_relaxed) & (SLOTS - 1);
+		return slot;
+	}
+
+	size_t NodePool::classOf(size_t bytes, size_t alignment) noexcept {
+		if (alignment > MAX_ALIGNMENT || bytes > MAX_BLOCK) {
+			return CLASSES;
+		}
+		const size_t size = (std::max<size_t>(bytes, 1) + alignment - 1) & ~(alignment - 1);
+		if (size > MAX_BLOCK) {
+			return CLASSES;
+		}
+		size_t index;
+		if (size <= SMALL_CLASSES * GRANULE) {
+			index = (size - 1) / GRANULE;
+		}
+		else {
+			const auto order = static_cast<size_t>(std::bit_width(size - 1)) - 1;
+			index = SMALL_CLASSES + (order - SMALL_ORDER) * 4 + ((size - 1) >> (order - 2)) - 4;
+		}
+		//Blocks sit at multiples of their size from an aligned start, so the size must be a multiple of the alignment
+		while (classSize(index) % alignment != 0) {
+			index++;
+		}
+		return index;
+	}
+
+	size_t NodePool::classSize(size_t index) noexcept {
+		if (index < SMALL_CLASSES) {
+			return (index + 1) * GRANULE;
+		}
+		const size_t step = index - SMALL_CLASSES;
+		const size_t order = SMALL_ORDER + step / 4;
+		return (4 + step % 4 + 1) << (order - 2);
+	}
+
+	void NodePool::lockCache(Cache& cache) noexcept {
+		unsigned spins = 0;
+		while (cache.locked.exchange(true, std::memory_order_acquire)) {
+			spinPause(spins);
+		}
+	}
+
+	void NodePool::unlockCache(Cache& cache) noexcept {
+		cache.locked.store(false, std::memory_order_release);
+	}
+
+	NodePool::Cache& NodePool::threadCache() {
+		std::atomic<Cache*>& slot = caches[threadSlot()];
+		Cache* cache = slot.load(std::memory_order_acquire);
+		if (cache != nullptr) {
+			return *cache;
+		}
+		Cache* created = ::new (upstream->allocate(sizeof(Cache), alignof(Cache))) Cache();
+		if (!slot.compare_exchange_strong(cache, created, std::memory_order_acq_rel)) {
+			std::destroy_at(created);
+			upstream->deallocate(created, sizeof(Cache), alignof(Cache));
+			return *cache;
+		}
+		return *created;
+	}
+
+	NodePool::FreeBlock* NodePool::refill(size_t index) {
+		std::lock_guard<std::mutex> guard(lock);
+		SizeClass& sizeClass = classes[index];
+		if (sizeClass.batches != nullptr) {
+			FreeBlock* batch = sizeClass.batches;
+			sizeClass.batches = batch->batch;
+			return batch;
+		}
+		const size_t size = classSize(index);
+		if (sizeClass.cursor == sizeClass.limit) {
+			//Block counts stay multiples of BATCH, so a slab is always carved out entirely
+			const size_t largest = std::max(BATCH, MAX_SLAB / size / BATCH * BATCH);
+			const size_t blocks = sizeClass.slabBlocks == 0 ? BATCH : std::min(sizeClass.slabBlocks * 2, largest);
+			const size_t bytes = MAX_ALIGNMENT + blocks * size;
+			auto slab = static_cast<Slab*>(upstream->allocate(bytes, MAX_ALIGNMENT));
+			slab->next = slabs;
+			slab->bytes = bytes;
+			slabs = slab;
+			sizeClass.cursor = reinterpret_cast<char*>(slab) + MAX_ALIGNMENT;
+			sizeClass.limit = sizeClass.cursor + blocks * size;
+			sizeClass.slabBlocks = blocks;
+		}
+		auto first = reinterpret_cast<FreeBlock*>(sizeClass.cursor);
+		FreeBlock* block = first;
+		for (size_t i = 1; i < BATCH; i++) {
+			block->next = reinterpret_cast<FreeBlock*>(sizeClass.cursor + i * size);
+			block = block->next;
+		}
+		block->next = nullptr;
+		sizeClass.cursor += BATCH * size;
+		return first;
+	}
+
+	void NodePool::flush(Cache& cache, size_t index) noexcept {
+		FreeBlock* first = cache.heads[index];
+		FreeBlock* last = first;
+		for (size_t i = 1; i < BATCH; i++) {
+			last = last->next;
+		}
+		cache.heads[index] = last->next;
+		cache.counts[index] -= BATCH;
+		last->next = nullptr;
+		std::lock_guard<std::mutex> guard(lock);
+		first->batch = classes[index].batches;
+		classes[index].batches = first;
+	}
+
+	void* NodePool::allocateLarge(size_t bytes, size_t alignment) {
+		alignment = std::max(alignment, alignof(Large));
+		const size_t offset = (sizeof(Large) + alignment - 1) & ~(alignment - 1);
+		auto base = static_cast<char*>(upstream->allocate(offset + bytes, alignment));
+		auto header = reinterpret_cast<Large*>(base + offset) - 1;
+		header->bytes = offset + bytes;
+		header->offset = offset;
+		header->alignment = alignment;
+		header->previous = nullptr;
+		std::lock_guard<std::mutex> guard(lock);
+		header->next = large;
+		if (large != nullptr) {
+			large->previous = header;
+		}
+		large = header;
+		return base + offset;
+	}
+
+	void NodePool::deallocateLarge(void* block) noexcept {
+		auto header = static_cast<Large*>(block) - 1;
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			if (header->previous != nullptr) {
+				header->previous->next = header->next;
+			}
+			else {
+				large = header->next;
+			}
+			if (header->next != nullptr) {
+				header->next->previous = header->previous;
+			}
+		}
+		upstream->deallocate(static_cast<char*>(block) - header->offset, header->bytes, header->alignment);
+	}
+}
@@ -0,0 +1,940 @@
+#include "../../Public/Implementation/AdaptiveRadixTree.h"
+#include <algorithm>
+#include <limits>
+
+namespace core {
+	template<typename K, typename V, typename Allocator>
+	AdaptiveRadixTree<K, V, Allocator>::AdaptiveRadixTree() : AdaptiveRadixTree(Allocator()) {}
+
+	template<typename K, typename V, typename Allocator>
+	AdaptiveRadixTree<K, V, Allocator>::AdaptiveRadixTree(const Allocator& allocator) : allocator(allocator), root(nullptr), memory(0) {
+		this->maxCapacity = std::numeric_limits<size_t>::max(); //Unbounded, nodes are allocated as keys need them
+		this->activeCapacity = 0;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	AdaptiveRadixTree<K, V, Allocator>::~AdaptiveRadixTree() {
+		releaseAll();
+	}
+
+	template<typename K, typename V, typename Allocator>
+	AdaptiveRadixTree<K, V, Allocator>::AdaptiveRadixTree(AdaptiveRadixTree&& other) noexcept : allocator(other.allocator), root(other.root),
+		memory(other.memory) {
+		this->maxCapacity = other.maxCapacity;
+		this->activeCapacity = other.activeCapacity;
+		other.root = nullptr;
+		other.memory = 0;
+		other.activeCapacity = 0;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	AdaptiveRadixTree<K, V, Allocator>& AdaptiveRadixTree<K, V, Allocator>::operator=(AdaptiveRadixTree&& other) noexcept(takesStorageOnMove<Allocator>) {
+		if (this != &other) {
+			requireStorageOnMove(allocator, other.allocator);
+			release(root);
+			propagateOnMove(allocator, other.allocator);
+			root = other.root;
+			memory = other.memory;
+			this->activeCapacity = other.activeCapacity;
+			other.root = nullptr;
+			other.memory = 0;
+			other.activeCapacity = 0;
+		}
+		return *this;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	bool AdaptiveRadixTree<K, V, Allocator>::put(K key, V value) {
+		const KeyBytes bytes(key);
+		if (!insert(&root, key, value, bytes, 0)) {
+			return false;
+		}
+		this->activeCapacity++;
+		return true;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	[[nodiscard]] bool AdaptiveRadixTree<K, V, Allocator>::get(const K& key, V& value) const {
+		const V* found = find(key);
+		if (found == nullptr) {
+			return false;
+		}
+		value = *found;
+		return true;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	bool AdaptiveRadixTree<K, V, Allocator>::remove(const K& key) {
+		if (root == nullptr) {
+			return false;
+		}
+		const KeyBytes bytes(key);
+		if (!erase(&root, key, bytes, 0)) {
+			return false;
+		}
+		this->activeCapacity--;
+		return true;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	[[nodiscard]] bool AdaptiveRadixTree<K, V, Allocator>::containsKey(const K& key) const {
+		return find(key) != nullptr;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	[[nodiscard]] bool AdaptiveRadixTree<K, V, Allocator>::containsValue(const V& value) {
+		bool found = false;
+		if (root != nullptr) {
+			auto match = [&](const E& entry) {
+				found = entry.value == value;
+				return !found;
+			};
+			visit(root, match);
+		}
+		return found;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	size_t AdaptiveRadixTree<K, V, Allocator>::scanPrefix(const K& prefix, std::function<bool(const E&)> visitor) const {
+		return scanPrefix(prefix, std::numeric_limits<size_t>::max(), visitor);
+	}
+
+	template<typename K, typename V, typename Allocator>
+	[[nodiscard]] bool AdaptiveRadixTree<K, V, Allocator>::longestPrefix(const K& key, E& entry) const {
+		const KeyBytes bytes(key);
+		Leaf* best = nullptr;
+		Node* node = root;
+		size_t depth = 0;
+		while (node != nullptr) {
+			if (isLeaf(node)) {
+				if (isPrefixOf(asLeaf(node), bytes, bytes.size())) {
+					best = asLeaf(node);
+				}
+				break;
+			}
+			if (node->prefixLength > 0) {
+				if (checkPrefix(node, bytes, depth) != std::min<size_t>(node->prefixLength, MAX_PREFIX)) {
+					break;
+				}
+				depth += node->prefixLength;
+				if (depth > bytes.size()) {
+					break;
+				}
+			}
+			//Candidates are verified in full, a skipped prefix byte that differs only rules out deeper keys
+			if (node->terminal != nullptr && isPrefixOf(node->terminal, bytes, bytes.size())) {
+				best = node->terminal;
+			}
+			if (depth == bytes.size()) {
+				break;
+			}
+			Node** child = findChild(node, bytes[depth]);
+			node = child != nullptr ? *child : nullptr;
+			depth++;
+		}
+		if (best == nullptr) {
+			return false;
+		}
+		entry = best->entry;
+		return true;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	[[nodiscard]] V* AdaptiveRadixTree<K, V, Allocator>::find(const K& key) {
+		return const_cast<V*>(std::as_const(*this).find(key));
+	}
+
+	template<typename K, typename V, typename Allocator>
+	[[nodiscard]] const V* AdaptiveRadixTree<K, V, Allocator>::find(const K& key) const {
+		const KeyBytes bytes(key);
+		Node* node = root;
+		size_t depth = 0;
+		while (node != nullptr) {
+			if (isLeaf(node)) {
+				Leaf* leaf = asLeaf(node);
+				return leaf->entry.key == key ? &leaf->entry.value : nullptr;
+			}
+			if (node->prefixLength > 0) {
+				if (checkPrefix(node, bytes, depth) != std::min<size_t>(node->prefixLength, MAX_PREFIX)) {
+					return nullptr;
+				}
+				depth += node->prefixLength;
+				if (depth > bytes.size()) {
+					return nullptr;
+				}
+			}
+			if (depth == bytes.size()) {
+				Leaf* leaf = node->terminal;
+				return leaf != nullptr && leaf->entry.key == key ? &leaf->entry.value : nullptr;
+			}
+			Node** child = findChild(node, bytes[depth]);
+			if (child == nullptr) {
+				return nullptr;
+			}
+			node = *child;
+			depth++;
+		}
+		return nullptr;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	[[nodiscard]] size_t AdaptiveRadixTree<K, V, Allocator>::getMemoryUsage() const {
+		return memory;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	std::unique_ptr<DataEngine<Entry<K, V>>> AdaptiveRadixTree<K, V, Allocator>::clone() const {
+		auto copied = std::make_unique<AdaptiveRadixTree>(allocator);
+		copied->root = copied->copy(root);
+		copied->activeCapacity = this->activeCapacity;
+		return copied;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	std::unique_ptr<DataEngine<Entry<K, V>>> AdaptiveRadixTree<K, V, Allocator>::move() {
+		return std::make_unique<AdaptiveRadixTree>(std::move(*this));
+	}
+
+	template<typename K, typename V, typename Allocator>
+	bool AdaptiveRadixTree<K, V, Allocator>::removeAll() {
+		if (root == nullptr) {
+			return false;
+		}
+		releaseAll();
+		root = nullptr;
+		memory = 0;
+		this->activeCapacity = 0;
+		return true;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	Entry<K, V>* AdaptiveRadixTree<K, V, Allocator>::toArray() const {
+		if (this->activeCapacity == 0) {
+			return nullptr;
+		}
+		std::unique_ptr<E[]> array(new E[this->activeCapacity]);
+		size_t index = 0;
+		auto store = [&](const E& entry) {
+			array[index++] = entry;
+			return true;
+		};
+		visit(root, store);
+		return array.release();
+	}
+
+	template<typename K, typename V, typename Allocator>
+	Entry<K, V>* AdaptiveRadixTree<K, V, Allocator>::toArray(int start, int end) const {
+		if (start < 0 || end <= start || static_cast<size_t>(end) > this->activeCapacity) {
+			return nullptr;
+		}
+		std::unique_ptr<E[]> array(new E[end - start]);
+		copyTo(std::span<E>(array.get(), end - start), start);
+		return array.release();
+	}
+
+	template<typename K, typename V, typename Allocator>
+	size_t AdaptiveRadixTree<K, V, Allocator>::copyTo(std::span<Entry<K, V>> destination, size_t start) const {
+		if (destination.empty() || start >= this->activeCapacity) {
+			return 0;
+		}
+		const size_t count = std::min(destination.size(), this->activeCapacity - start);
+		const size_t end = start + count;
+		size_t index = 0;
+		auto store = [&](const E& entry) {
+			if (index >= start) {
+				destination[index - start] = entry;
+			}
+			return ++index < end;
+		};
+		visit(root, store);
+		return count;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	void AdaptiveRadixTree<K, V, Allocator>::reverse() {}
+
+	template<typename K, typename V, typename Allocator>
+	typename AdaptiveRadixTree<K, V, Allocator>::iterator AdaptiveRadixTree<K, V, Allocator>::begin() {
+		return iterator(root);
+	}
+
+	template<typename K, typename V, typename Allocator>
+	typename AdaptiveRadixTree<K, V, Allocator>::const_iterator AdaptiveRadixTree<K, V, Allocator>::begin() const {
+		return const_iterator(root);
+	}
+
+	template<typename K, typename V, typename Allocator>
+	typename AdaptiveRadixTree<K, V, Allocator>::iterator AdaptiveRadixTree<K, V, Allocator>::end() {
+		return iterator(nullptr);
+	}
+
+	template<typename K, typename V, typename Allocator>
+	typename AdaptiveRadixTree<K, V, Allocator>::const_iterator AdaptiveRadixTree<K, V, Allocator>::end() const {
+		return const_iterator(nullptr);
+	}
+
+	template<typename K, typename V, typename Allocator>
+	void AdaptiveRadixTree<K, V, Allocator>::grow() {}
+
+	template<typename K, typename V, typename Allocator>
+	void AdaptiveRadixTree<K, V, Allocator>::shrink() {}
+
+	template<typename K, typename V, typename Allocator>
+	void AdaptiveRadixTree<K, V, Allocator>::compress() {}
+
+	template<typename K, typename V, typename Allocator>
+	bool AdaptiveRadixTree<K, V, Allocator>::equalsInternal(const DataEngine<E>& de) const {
+		auto other = dynamic_cast<const Trie<K, V>*>(&de);
+		if (other == nullptr || other->getActiveSize() != this->activeCapacity) {
+			return false;
+		}
+		if (this->activeCapacity == 0) {
+			return true;
+		}
+		//Both sides are in key byte order, so equal tries match entry by entry
+		std::unique_ptr<E[]> theirs(other->toArray());
+		if (theirs == nullptr) {
+			return false;
+		}
+		size_t index = 0;
+		auto compare = [&](const E& entry) {
+			return entry == theirs[index++];
+		};
+		return visit(root, compare);
+	}
+
+	template<typename K, typename V, typename Allocator>
+	[[nodiscard]] bool AdaptiveRadixTree<K, V, Allocator>::equivalenceInternal(const DataEngine<E>& de) const {
+		//Entries are ordered by key on both sides, so equivalence and equality coincide
+		return equalsInternal(de);
+	}
+
+	template<typename K, typename V, typename Allocator>
+	std::unique_ptr<DataEngine<Entry<K, V>>> AdaptiveRadixTree<K, V, Allocator>::mergeInternal(const DataEngine<E>& de, int start, int end) const {
+		auto other = dynamic_cast<const Trie<K, V>*>(&de);
+		if (other == nullptr || start < 0 || end < start || static_cast<size_t>(end) > other->getActiveSize()) {
+			return nullptr;
+		}
+		std::unique_ptr<AdaptiveRadixTree> merged(static_cast<AdaptiveRadixTree*>(clone().release()));
+		if (end > start) {
+			std::unique_ptr<E[]> added(other->toArray(start, end));
+			for (int i = 0; added != nullptr && i < end - start; i++) {
+				merged->put(std::move(added[i].key), std::move(added[i].value));
+			}
+		}
+		return merged;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	typename AdaptiveRadixTree<K, V, Allocator>::Node* AdaptiveRadixTree<K, V, Allocator>::next(const Node* node, int& position) noexcept {
+		if (position < 0) {
+			position = 0;
+			if (node->terminal != nullptr) {
+				return tag(node->terminal);
+			}
+		}
+		switch (node->type) {
+		case NodeType::NODE4: {
+			auto inner = static_cast<const Node4*>(node);
+			return position < inner->count ? inner->children[position++] : nullptr;
+		}
+		case NodeType::NODE16: {
+			auto inner = static_cast<const Node16*>(node);
+			return position < inner->count ? inner->children[position++] : nullptr;
+		}
+		case NodeType::NODE48: {
+			auto inner = static_cast<const Node48*>(node);
+			while (position < 256) {
+				const uint8_t slot = inner->index[position++];
+				if (slot != 0) {
+					return inner->children[slot - 1];
+				}
+			}
+			return nullptr;
+		}
+		case NodeType::NODE256: {
+			auto inner = static_cast<const Node256*>(node);
+			while (position < 256) {
+				Node* child = inner->children[position++];
+				if (child != nullptr) {
+					return child;
+				}
+			}
+			return nullptr;
+		}
+		}
+		return nullptr;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	typename AdaptiveRadixTree<K, V, Allocator>::Node** AdaptiveRadixTree<K, V, Allocator>::findChild(Node* node, uint8_t byte) noexcept {
+		switch (node->type) {
+		case NodeType::NODE4: {
+			auto inner = static_cast<Node4*>(node);
+			for (size_t i = 0; i < inner->count; i++) {
+				if (inner->keys[i] == byte) {
+					return inner->children + i;
+				}
+			}
+			return nullptr;
+		}
+		case NodeType::NODE16: {
+			auto inner = static_cast<Node16*>(node);
+#ifdef ENGINE_SSE2
+			//Compares all 16 key bytes at once, the bits past the count are masked off
+			const __m128i keys = _mm_loadu_si128(reinterpret_cast<const __m128i*>(inner->keys));
+			const uint32_t matches = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(static_cast<char>(byte)), keys)))
+				& ((1u << inner->count) - 1);
+			return matches != 0 ? inner->children + std::countr_zero(matches) : nullptr;
+#else
+			for (size_t i = 0; i < inner->count; i++) {
+				if (inner->keys[i] == byte) {
+					return inner->children + i;
+				}
+			}
+			return nullptr;
+#endif
+		}
+		case NodeType::NODE48: {
+			auto inner = static_cast<Node48*>(node);
+			const uint8_t slot = inner->index[byte];
+			return slot != 0 ? inner->children + slot - 1 : nullptr;
+		}
+		case NodeType::NODE256: {
+			auto inner = static_cast<Node256*>(node);
+			return inner->children[byte] != nullptr ? inner->children + byte : nullptr;
+		}
+		}
+		return nullptr;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	typename AdaptiveRadixTree<K, V, Allocator>::Leaf* AdaptiveRadixTree<K, V, Allocator>::minimum(Node* node) noexcept {
+		while (!isLeaf(node)) {
+			int position = -1;
+			node = next(node, position);
+		}
+		return asLeaf(node);
+	}
+
+	template<typename K, typename V, typename Allocator>
+	size_t AdaptiveRadixTree<K, V, Allocator>::checkPrefix(const Node* node, const KeyBytes& bytes, size_t depth) noexcept {
+		const size_t limit = std::min({ static_cast<size_t>(node->prefixLength), MAX_PREFIX, bytes.size() - depth });
+		size_t matched = 0;
+		while (matched < limit && node->prefix[matched] == bytes[depth + matched]) {
+			matched++;
+		}
+		return matched;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	size_t AdaptiveRadixTree<K, V, Allocator>::prefixMismatch(Node* node, const KeyBytes& bytes, size_t depth) noexcept {
+		size_t matched = checkPrefix(node, bytes, depth);
+		if (matched < MAX_PREFIX || node->prefixLength <= MAX_PREFIX) {
+			return matched;
+		}
+		//Every key below shares the whole prefix, so any leaf supplies the bytes that are not stored
+		const KeyBytes stored(minimum(node)->entry.key);
+		const size_t limit = std::min(static_cast<size_t>(node->prefixLength), bytes.size() - depth);
+		while (matched < limit && stored[depth + matched] == bytes[depth + matched]) {
+			matched++;
+		}
+		return matched;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	bool AdaptiveRadixTree<K, V, Allocator>::isPrefixOf(const Leaf* leaf, const KeyBytes& bytes, size_t length) noexcept {
+		const KeyBytes own(leaf->entry.key);
+		return own.size() <= length && std::memcmp(own.data(), bytes.data(), own.size()) == 0;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	typename AdaptiveRadixTree<K, V, Allocator>::Node* AdaptiveRadixTree<K, V, Allocator>::subtree(const K& prefix, size_t length) const {
+		const KeyBytes bytes(prefix);
+		length = std::min(length, bytes.size());
+		Node* node = root;
+		size_t depth = 0;
+		while (node != nullptr && !isLeaf(node) && depth < length) {
+			if (node->prefixLength > 0) {
+				const size_t stored = std::min<size_t>(node->prefixLength, MAX_PREFIX);
+				for (size_t i = 0; i < stored && depth + i < length; i++) {
+					if (node->prefix[i] != bytes[depth + i]) {
+						return nullptr;
+					}
+				}
+				if (depth + node->prefixLength >= length) {
+					break; //The prefix ends inside the compressed path, the whole subtree shares it
+				}
+				depth += node->prefixLength;
+			}
+			Node** child = findChild(node, bytes[depth]);
+			node = child != nullptr ? *child : nullptr;
+			depth++;
+		}
+		if (node == nullptr) {
+			return nullptr;
+		}
+		//Skipped prefix bytes were not compared, but every key of the subtree agrees with its smallest one
+		const KeyBytes smallest(minimum(node)->entry.key);
+		if (smallest.size() < length || std::memcmp(smallest.data(), bytes.data(), length) != 0) {
+			return nullptr;
+		}
+		return node;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	bool AdaptiveRadixTree<K, V, Allocator>::insert(Node** slot, K& key, V& value, const KeyBytes& bytes, size_t depth) {
+		Node* node = *slot;
+		if (node == nullptr) {
+			*slot = tag(allocateLeaf(std::move(key), std::move(value)));
+			return true;
+		}
+		if (isLeaf(node)) {
+			Leaf* existing = asLeaf(node);
+			if (existing->entry.key == key) {
+				existing->entry.value = std::move(value);
+				return false;
+			}
+			//Lazy expansion ends here: the two keys get a node branching where they first differ
+			const KeyBytes other(existing->entry.key);
+			const size_t limit = std::min(other.size(), bytes.size());
+			size_t common = depth;
+			while (common < limit && other[common] == bytes[common]) {
+				common++;
+			}
+			Node4* split = allocate<Node4>();
+			setPrefix(split, bytes.data() + depth, common - depth);
+			attach(split, existing, other, common);
+			Leaf* leaf = allocateLeaf(std::move(key), std::move(value));
+			attach(split, leaf, KeyBytes(leaf->entry.key), common);
+			*slot = split;
+			return true;
+		}
+		if (node->prefixLength > 0) {
+			const size_t matched = prefixMismatch(node, bytes, depth);
+			if (matched < node->prefixLength) {
+				//The key leaves the compressed path, which is cut in two around a new branching node
+				Node4* split = allocate<Node4>();
+				setPrefix(split, bytes.data() + depth, matched);
+				uint8_t branch;
+				if (node->prefixLength <= MAX_PREFIX) {
+					branch = node->prefix[matched];
+					node->prefixLength -= static_cast<uint32_t>(matched + 1);
+					std::memmove(node->prefix, node->prefix + matched + 1, std::min<size_t>(node->prefixLength, MAX_PREFIX));
+				}
+				else {
+					const KeyBytes stored(minimum(node)->entry.key);
+					branch = stored[depth + matched];
+					node->prefixLength -= static_cast<uint32_t>(matched + 1);
+					std::memcpy(node->prefix, stored.data() + depth + matched + 1, std::min<size_t>(node->prefixLength, MAX_PREFIX));
+				}
+				addChild(nullptr, split, branch, node);
+				Leaf* leaf = allocateLeaf(std::move(key), std::move(value));
+				attach(split, leaf, KeyBytes(leaf->entry.key), depth + matched);
+				*slot = split;
+				return true;
+			}
+			depth += node->prefixLength;
+		}
+		if (depth == bytes.size()) {
+			if (node->terminal != nullptr) {
+				node->terminal->entry.value = std::move(value);
+				return false;
+			}
+			node->terminal = allocateLeaf(std::move(key), std::move(value));
+			return true;
+		}
+		Node** child = findChild(node, bytes[depth]);
+		if (child != nullptr) {
+			return insert(child, key, value, bytes, depth + 1);
+		}
+		const uint8_t byte = bytes[depth];
+		addChild(slot, node, byte, tag(allocateLeaf(std::move(key), std::move(value))));
+		return true;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	bool AdaptiveRadixTree<K, V, Allocator>::erase(Node** slot, const K& key, const KeyBytes& bytes, size_t depth) {
+		Node* node = *slot;
+		if (isLeaf(node)) {
+			//Only a leaf at the root is reached this way, the others are removed by their parent
+			if (!(asLeaf(node)->entry.key == key)) {
+				return false;
+			}
+			deallocateLeaf(asLeaf(node));
+			*slot = nullptr;
+			return true;
+		}
+		if (node->prefixLength > 0) {
+			if (checkPrefix(node, bytes, depth) != std::min<size_t>(node->prefixLength, MAX_PREFIX)) {
+				return false;
+			}
+			depth += node->prefixLength;
+			if (depth > bytes.size()) {
+				return false;
+			}
+		}
+		if (depth == bytes.size()) {
+			Leaf* leaf = node->terminal;
+			if (leaf == nullptr || !(leaf->entry.key == key)) {
+				return false;
+			}
+			deallocateLeaf(leaf);
+			node->terminal = nullptr;
+			contract(slot, node);
+			return true;
+		}
+		Node** child = findChild(node, bytes[depth]);
+		if (child == nullptr) {
+			return false;
+		}
+		if (isLeaf(*child)) {
+			Leaf* leaf = asLeaf(*child);
+			if (!(leaf->entry.key == key)) {
+				return false;
+			}
+			deallocateLeaf(leaf);
+			removeChild(slot, node, bytes[depth], child);
+			return true;
+		}
+		return erase(child, key, bytes, depth + 1);
+	}
+
+	template<typename K, typename V, typename Allocator>
+	void AdaptiveRadixTree<K, V, Allocator>::addChild(Node** slot, Node* node, uint8_t byte, Node* child) {
+		switch (node->type) {
+		case NodeType::NODE4: {
+			auto inner = static_cast<Node4*>(node);
+			if (inner->count < 4) {
+				size_t position = 0;
+				while (position < inner->count && inner->keys[position] < byte) {
+					position++;
+				}
+				std::move_backward(inner->keys + position, inner->keys + inner->count, inner->keys + inner->count + 1);
+				std::move_backward(inner->children + position, inner->children + inner->count, inner->children + inner->count + 1);
+				inner->keys[position] = byte;
+				inner->children[position] = child;
+				inner->count++;
+				return;
+			}
+			Node16* grown = allocate<Node16>();
+			copyHeader(grown, inner);
+			std::copy(inner->keys, inner->keys + 4, grown->keys);
+			std::copy(inner->children, inner->children + 4, grown->children);
+			*slot = grown;
+			deallocate(inner);
+			addChild(slot, grown, byte, child);
+			return;
+		}
+		case NodeType::NODE16: {
+			auto inner = static_cast<Node16*>(node);
+			if (inner->count < 16) {
+				size_t position = 0;
+				while (position < inner->count && inner->keys[position] < byte) {
+					position++;
+				}
+				std::move_backward(inner->keys + position, inner->keys + inner->count, inner->keys + inner->count + 1);
+				std::move_backward(inner->children + position, inner->children + inner->count, inner->children + inner->count + 1);
+				inner->keys[position] = byte;
+				inner->children[position] = child;
+				inner->count++;
+				return;
+			}
+			Node48* grown = allocate<Node48>();
+			copyHeader(grown, inner);
+			for (uint8_t i = 0; i < 16; i++) {
+				grown->index[inner->keys[i]] = i + 1;
+				grown->children[i] = inner->children[i];
+			}
+			*slot = grown;
+			deallocate(inner);
+			addChild(slot, grown, byte, child);
+			return;
+		}
+		case NodeType::NODE48: {
+			auto inner = static_cast<Node48*>(node);
+			if (inner->count < 48) {
+				//Slots freed by removals are reused, so the first empty one may be anywhere
+				uint8_t position = 0;
+				while (inner->children[position] != nullptr) {
+					position++;
+				}
+				inner->children[position] = child;
+				inner->index[byte] = position + 1;
+				inner->count++;
+				return;
+			}
+			Node256* grown = allocate<Node256>();
+			copyHeader(grown, inner);
+			for (size_t i = 0; i < 256; i++) {
+				if (inner->index[i] != 0) {
+					grown->children[i] = inner->children[inner->index[i] - 1];
+				}
+			}
+			*slot = grown;
+			deallocate(inner);
+			addChild(slot, grown, byte, child);
+			return;
+		}
+		case NodeType::NODE256: {
+			auto inner = static_cast<Node256*>(node);
+			inner->children[byte] = child;
+			inner->count++;
+			return;
+		}
+		}
+	}
+
+	template<typename K, typename V, typename Allocator>
+	void AdaptiveRadixTree<K, V, Allocator>::removeChild(Node** slot, Node* node, uint8_t byte, Node** child) {
+		switch (node->type) {
+		case NodeType::NODE4: {
+			auto inner = static_cast<Node4*>(node);
+			const size_t position = child - inner->children;
+			std::move(inner->keys + position + 1, inner->keys + inner->count, inner->keys + position);
+			std::move(inner->children + position + 1, inner->children + inner->count, inner->children + position);
+			break;
+		}
+		case NodeType::NODE16: {
+			auto inner = static_cast<Node16*>(node);
+			const size_t position = child - inner->children;
+			std::move(inner->keys + position + 1, inner->keys + inner->count, inner->keys + position);
+			std::move(inner->children + position + 1, inner->children + inner->count, inner->children + position);
+			break;
+		}
+		case NodeType::NODE48: {
+			auto inner = static_cast<Node48*>(node);
+			inner->children[inner->index[byte] - 1] = nullptr;
+			inner->index[byte] = 0;
+			break;
+		}
+		case NodeType::NODE256: {
+			static_cast<Node256*>(node)->children[byte] = nullptr;
+			break;
+		}
+		}
+		node->count--;
+		contract(slot, node);
+	}
+
+	template<typename K, typename V, typename Allocator>
+	void AdaptiveRadixTree<K, V, Allocator>::contract(Node** slot, Node* node) {
+		switch (node->type) {
+		case NodeType::NODE4: {
+			auto inner = static_cast<Node4*>(node);
+			if (inner->count == 0) {
+				//Only the terminal is left, a node with neither would have been contracted already
+				*slot = tag(inner->terminal);
+				deallocate(inner);
+			}
+			else if (inner->count == 1 && inner->terminal == nullptr) {
+				//A lone child takes the place of the node, absorbing its prefix and the branch byte
+				Node* child = inner->children[0];
+				if (!isLeaf(child)) {
+					uint8_t prefix[MAX_PREFIX];
+					size_t length = std::min<size_t>(inner->prefixLength, MAX_PREFIX);
+					std::memcpy(prefix, inner->prefix, length);
+					if (length < MAX_PREFIX) {
+						prefix[length++] = inner->keys[0];
+					}
+					const size_t taken = std::min<size_t>(child->prefixLength, MAX_PREFIX - length);
+					std::memcpy(prefix + length, child->prefix, taken);
+					std::memcpy(child->prefix, prefix, length + taken);
+					child->prefixLength += inner->prefixLength + 1;
+				}
+				*slot = child;
+				deallocate(inner);
+			}
+			return;
+		}
+		case NodeType::NODE16: {
+			auto inner = static_cast<Node16*>(node);
+			if (inner->count <= NODE16_MINIMUM) {
+				Node4* shrunk = allocate<Node4>();
+				copyHeader(shrunk, inner);
+				std::copy(inner->keys, inner->keys + inner->count, shrunk->keys);
+				std::copy(inner->children, inner->children + inner->count, shrunk->children);
+				*slot = shrunk;
+				deallocate(inner);
+			}
+			return;
+		}
+		case NodeType::NODE48: {
+			auto inner = static_cast<Node48*>(node);
+			if (inner->count <= NODE48_MINIMUM) {
+				Node16* shrunk = allocate<Node16>();
+				copyHeader(shrunk, inner);
+				size_t position = 0;
+				for (size_t i = 0; i < 256; i++) {
+					if (inner->index[i] != 0) {
+						shrunk->keys[position] = static_cast<uint8_t>(i);
+						shrunk->children[position++] = inner->children[inner->index[i] - 1];
+					}
+				}
+				*slot = shrunk;
+				deallocate(inner);
+			}
+			return;
+		}
+		case NodeType::NODE256: {
+			auto inner = static_cast<Node256*>(node);
+			if (inner->count <= NODE256_MINIMUM) {
+				Node48* shrunk = allocate<Node48>();
+				copyHeader(shrunk, inner);
+				uint8_t position = 0;
+				for (size_t i = 0; i < 256; i++) {
+					if (inner->children[i] != nullptr) {
+						shrunk->children[position] = inner->children[i];
+						shrunk->index[i] = ++position;
+					}
+				}
+				*slot = shrunk;
+				deallocate(inner);
+			}
+			return;
+		}
+		}
+	}
+
+	template<typename K, typename V, typename Allocator>
+	void AdaptiveRadixTree<K, V, Allocator>::attach(Node* node, Leaf* leaf, const KeyBytes& bytes, size_t depth) {
+		if (depth == bytes.size()) {
+			node->terminal = leaf;
+		}
+		else {
+			addChild(nullptr, node, bytes[depth], tag(leaf));
+		}
+	}
+
+	template<typename K, typename V, typename Allocator>
+	void AdaptiveRadixTree<K, V, Allocator>::setPrefix(Node* node, const uint8_t* bytes, size_t length) noexcept {
+		node->prefixLength = static_cast<uint32_t>(length);
+		std::memcpy(node->prefix, bytes, std::min(length, MAX_PREFIX));
+	}
+
+	template<typename K, typename V, typename Allocator>
+	void AdaptiveRadixTree<K, V, Allocator>::copyHeader(Node* to, const Node* from) noexcept {
+		to->count = from->count;
+		to->prefixLength = from->prefixLength;
+		std::memcpy(to->prefix, from->prefix, MAX_PREFIX);
+		to->terminal = from->terminal;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	void AdaptiveRadixTree<K, V, Allocator>::deallocate(Node* node) noexcept {
+		switch (node->type) {
+		case NodeType::NODE4:
+			memory -= sizeof(Node4);
+			destroyObject(allocator, static_cast<Node4*>(node));
+			return;
+		case NodeType::NODE16:
+			memory -= sizeof(Node16);
+			destroyObject(allocator, static_cast<Node16*>(node));
+			return;
+		case NodeType::NODE48:
+			memory -= sizeof(Node48);
+			destroyObject(allocator, static_cast<Node48*>(node));
+			return;
+		case NodeType::NODE256:
+			memory -= sizeof(Node256);
+			destroyObject(allocator, static_cast<Node256*>(node));
+			return;
+		}
+	}
+
+	template<typename K, typename V, typename Allocator>
+	typename AdaptiveRadixTree<K, V, Allocator>::Leaf* AdaptiveRadixTree<K, V, Allocator>::allocateLeaf(K key, V value) {
+		Leaf* leaf = createObject<Leaf>(allocator, E{ std::move(key), std::move(value) });
+		memory += sizeof(Leaf);
+		return leaf;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	void AdaptiveRadixTree<K, V, Allocator>::deallocateLeaf(Leaf* leaf) noexcept {
+		memory -= sizeof(Leaf);
+		destroyObject(allocator, leaf);
+	}
+
+	template<typename K, typename V, typename Allocator>
+	typename AdaptiveRadixTree<K, V, Allocator>::Node* AdaptiveRadixTree<K, V, Allocator>::copy(Node* node) {
+		if (node == nullptr) {
+			return nullptr;
+		}
+		if (isLeaf(node)) {
+			const Leaf* leaf = asLeaf(node);
+			return tag(allocateLeaf(leaf->entry.key, leaf->entry.value));
+		}
+		Node* copied = nullptr;
+		switch (node->type) {
+		case NodeType::NODE4: {
+			auto inner = allocate<Node4>();
+			*inner = *static_cast<Node4*>(node);
+			for (size_t i = 0; i < inner->count; i++) {
+				inner->children[i] = copy(inner->children[i]);
+			}
+			copied = inner;
+			break;
+		}
+		case NodeType::NODE16: {
+			auto inner = allocate<Node16>();
+			*inner = *static_cast<Node16*>(node);
+			for (size_t i = 0; i < inner->count; i++) {
+				inner->children[i] = copy(inner->children[i]);
+			}
+			copied = inner;
+			break;
+		}
+		case NodeType::NODE48: {
+			auto inner = allocate<Node48>();
+			*inner = *static_cast<Node48*>(node);
+			for (Node*& child : inner->children) {
+				child = copy(child);
+			}
+			copied = inner;
+			break;
+		}
+		case NodeType::NODE256: {
+			auto inner = allocate<Node256>();
+			*inner = *static_cast<Node256*>(node);
+			for (Node*& child : inner->children) {
+				child = copy(child);
+			}
+			copied = inner;
+			break;
+		}
+		}
+		if (node->terminal != nullptr) {
+			copied->terminal = allocateLeaf(node->terminal->entry.key, node->terminal->entry.value);
+		}
+		return copied;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	void AdaptiveRadixTree<K, V, Allocator>::release(Node* node) noexcept {
+		if (node == nullptr) {
+			return;
+		}
+		if (isLeaf(node)) {
+			deallocateLeaf(asLeaf(node));
+			return;
+		}
+		int position = -1;
+		for (Node* child = next(node, position); child != nullptr; child = next(node, position)) {
+			release(child);
+		}
+		deallocate(node);
+	}
+
+	template<typename K, typename V, typename Allocator>
+	void AdaptiveRadixTree<K, V, Allocator>::releaseAll() noexcept {
+		if (root == nullptr) {
+			return;
+		}
+		if constexpr (std::is_trivially_destructible_v<Leaf>) {
+			if (releaseStorage(allocator)) {
+				return;
+			}
+		}
+		release(root);
+	}
+}
@@ -0,0 +1,508 @@
+#include "../../Public/Implementation/ArrayDeque.h"
+#include <bit>
+#include <cmath>
+#include <concepts>
+#include <stdexcept>
+#include <vector>
+
+namespace core {
+	template<typename E, typename Allocator>
+	ArrayDeque<E, Allocator>::ArrayDeque() : ArrayDeque(0) {}
+
+	template<typename E, typename Allocator>
+	ArrayDeque<E, Allocator>::ArrayDeque(const Allocator& allocator) : ArrayDeque(0, allocator) {}
+
+	template<typename E, typename Allocator>
+	ArrayDeque<E, Allocator>::ArrayDeque(size_t capacity, const Allocator& allocator) : allocator(allocator), head(0) {
+		this->maxCapacity = capacityFor(capacity);
+		this->activeCapacity = 0;
+		buffer = allocate(this->maxCapacity);
+		updateThresholds();
+	}
+
+	template<typename E, typename Allocator>
+	ArrayDeque<E, Allocator>::~ArrayDeque() {
+		release();
+	}
+
+	template<typename E, typename Allocator>
+	ArrayDeque<E, Allocator>::ArrayDeque(ArrayDeque&& other) noexcept : allocator(other.allocator), buffer(other.buffer), head(other.head), mask(other.mask),
+		growthThreshold(other.growthThreshold), shrinkThreshold(other.shrinkThreshold) {
+		this->maxCapacity = other.maxCapacity;
+		this->activeCapacity = other.activeCapacity;
+		other.buffer = nullptr;
+		other.head = 0;
+		other.maxCapacity = 0;
+		other.activeCapacity = 0;
+		other.updateThresholds();
+	}
+
+	template<typename E, typename Allocator>
+	ArrayDeque<E, Allocator>& ArrayDeque<E, Allocator>::operator=(ArrayDeque&& other) noexcept(takesStorageOnMove<Allocator>) {
+		if (this != &other) {
+			requireStorageOnMove(allocator, other.allocator);
+			release();
+			propagateOnMove(allocator, other.allocator);
+			buffer = other.buffer;
+			head = other.head;
+			this->maxCapacity = other.maxCapacity;
+			this->activeCapacity = other.activeCapacity;
+			updateThresholds();
+			other.buffer = nullptr;
+			other.head = 0;
+			other.maxCapacity = 0;
+			other.activeCapacity = 0;
+			other.updateThresholds();
+		}
+		return *this;
+	}
+
+	template<typename E, typename Allocator>
+	bool ArrayDeque<E, Allocator>::addFirst(E item) {
+		if (this->activeCapacity >= growthThreshold) {
+			grow();
+		}
+		head = (head - 1) & mask;
+		::new (static_cast<void*>(buffer + head)) E(std::move(item));
+		++this->activeCapacity;
+		return true;
+	}
+
+	template<typename E, typename Allocator>
+	bool ArrayDeque<E, Allocator>::addLast(E item) {
+		if (this->activeCapacity >= growthThreshold) {
+			grow();
+		}
+		::new (static_cast<void*>(slot(this->activeCapacity))) E(std::move(item));
+		++this->activeCapacity;
+		return true;
+	}
+
+	template<typename E, typename Allocator>
+	bool ArrayDeque<E, Allocator>::addFirst(const E* items, size_t count) {
+		if (items == nullptr || count == 0) {
+			return false;
+		}
+		reserve(this->activeCapacity + count);
+		head = (head - count) & mask;
+		copyIn(head, items, count);
+		this->activeCapacity += count;
+		return true;
+	}
+
+	template<typename E, typename Allocator>
+	bool ArrayDeque<E, Allocator>::addLast(const E* items, size_t count) {
+		if (items == nullptr || count == 0) {
+			return false;
+		}
+		reserve(this->activeCapacity + count);
+		copyIn((head + this->activeCapacity) & mask, items, count);
+		this->activeCapacity += count;
+		return true;
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] E ArrayDeque<E, Allocator>::removeFirst() {
+		if (this->activeCapacity == 0) {
+			throw std::out_of_range("removeFirst on an empty deque");
+		}
+		E item = std::move(buffer[head]);
+		std::destroy_at(buffer + head);
+		head = (head + 1) & mask;
+		if (--this->activeCapacity < shrinkThreshold) {
+			shrink();
+		}
+		return item;
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] E ArrayDeque<E, Allocator>::removeLast() {
+		if (this->activeCapacity == 0) {
+			throw std::out_of_range("removeLast on an empty deque");
+		}
+		E* last = slot(this->activeCapacity - 1);
+		E item = std::move(*last);
+		std::destroy_at(last);
+		if (--this->activeCapacity < shrinkThreshold) {
+			shrink();
+		}
+		return item;
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] E ArrayDeque<E, Allocator>::peekFirst() {
+		if (this->activeCapacity == 0) {
+			throw std::out_of_range("peekFirst on an empty deque");
+		}
+		return buffer[head];
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] E ArrayDeque<E, Allocator>::peekLast() {
+		if (this->activeCapacity == 0) {
+			throw std::out_of_range("peekLast on an empty deque");
+		}
+		return *slot(this->activeCapacity - 1);
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] E ArrayDeque<E, Allocator>::get(int index) const {
+		return *slot(index);
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] bool ArrayDeque<E, Allocator>::contains(E item) {
+		//Scans the two physical runs directly so that the inner loops carry no masking
+		const size_t first = firstRun(0, this->activeCapacity);
+		const E* run = slot(0);
+		if (std::find(run, run + first, item) != run + first) {
+			return true;
+		}
+		return std::find(buffer, buffer + (this->activeCapacity - first), item) != buffer + (this->activeCapacity - first);
+	}
+
+	template<typename E, typename Allocator>
+	void ArrayDeque<E, Allocator>::replaceAll(std::function<E* (E*)> operatorFunction, int start, int end) {
+		if (start < 0 || end <= start || static_cast<size_t>(end) > this->activeCapacity) {
+			return;
+		}
+		for (int i = start; i < end; i++) {
+			E* current = slot(i);
+			E* replacement = operatorFunction(current);
+			if (replacement != nullptr && replacement != current) {
+				*current = *replacement;
+			}
+		}
+	}
+
+	template<typename E, typename Allocator>
+	std::unique_ptr<DataEngine<E>> ArrayDeque<E, Allocator>::clone() const {
+		auto copy = std::make_unique<ArrayDeque>(this->activeCapacity, allocator);
+		const size_t first = firstRun(0, this->activeCapacity);
+		copy->copyIn(0, slot(0), first);
+		copy->copyIn(first, buffer, this->activeCapacity - first);
+		copy->activeCapacity = this->activeCapacity;
+		return copy;
+	}
+
+	template<typename E, typename Allocator>
+	std::unique_ptr<DataEngine<E>> ArrayDeque<E, Allocator>::move() {
+		return std::make_unique<ArrayDeque>(std::move(*this));
+	}
+
+	template<typename E, typename Allocator>
+	bool ArrayDeque<E, Allocator>::removeAll() {
+		if (this->activeCapacity == 0) {
+			return false;
+		}
+		const size_t first = firstRun(0, this->activeCapacity);
+		std::destroy(slot(0), slot(0) + first);
+		std::destroy(buffer, buffer + (this->activeCapacity - first));
+		this->activeCapacity = 0;
+		head = 0;
+		if (this->maxCapacity > DataEngine<E>::DEFAULT_CAPACITY) {
+			relocate(DataEngine<E>::DEFAULT_CAPACITY);
+		}
+		return true;
+	}
+
+	template<typename E, typename Allocator>
+	E* ArrayDeque<E, Allocator>::toArray() const {
+		return toArray(0, static_cast<int>(this->activeCapacity));
+	}
+
+	template<typename E, typename Allocator>
+	E* ArrayDeque<E, Allocator>::toArray(int start, int end) const {
+		if (start < 0 || end <= start || static_cast<size_t>(end) > this->activeCapacity) {
+			return nullptr;
+		}
+		std::unique_ptr<E[]> array(new E[end - start]);
+		copyTo(std::span<E>(array.get(), end - start), start);
+		return array.release();
+	}
+
+	template<typename E, typename Allocator>
+	size_t ArrayDeque<E, Allocator>::copyTo(std::span<E> destination, size_t start) const {
+		if (destination.empty() || start >= this->activeCapacity) {
+			return 0;
+		}
+		const size_t count = std::min(destination.size(), this->activeCapacity - start);
+		const size_t first = firstRun(start, start + count);
+		std::copy_n(slot(start), first, destination.data());
+		std::copy_n(slot(start + first), count - first, destination.data() + first);
+		return count;
+	}
+
+	template<typename E, typename Allocator>
+	void ArrayDeque<E, Allocator>::reverse() {
+		if (this->activeCapacity < 2) {
+			return;
+		}
+		for (size_t left = 0, right = this->activeCapacity - 1; left < right; left++, right--) {
+			std::swap(*slot(left), *slot(right));
+		}
+	}
+
+	template<typename E, typename Allocator>
+	typename ArrayDeque<E, Allocator>::iterator ArrayDeque<E, Allocator>::begin() {
+		return iterator(buffer, mask, head);
+	}
+
+	template<typename E, typename Allocator>
+	typename ArrayDeque<E, Allocator>::const_iterator ArrayDeque<E, Allocator>::begin() const {
+		return const_iterator(buffer, mask, head);
+	}
+
+	template<typename E, typename Allocator>
+	typename ArrayDeque<E, Allocator>::iterator ArrayDeque<E, Allocator>::end() {
+		return iterator(buffer, mask, head + this->activeCapacity);
+	}
+
+	template<typename E, typename Allocator>
+	typename ArrayDeque<E, Allocator>::const_iterator ArrayDeque<E, Allocator>::end() const {
+		return const_iterator(buffer, mask, head + this->activeCapacity);
+	}
+
+	template<typename E, typename Allocator>
+	void ArrayDeque<E, Allocator>::reserve(size_t capacity) {
+		if (capacity > growthThreshold) {
+			relocate(capacityFor(capacity));
+		}
+	}
+
+	template<typename E, typename Allocator>
+	void ArrayDeque<E, Allocator>::grow() {
+		relocate(std::max<size_t>(this->maxCapacity << 1, DataEngine<E>::DEFAULT_CAPACITY));
+	}
+
+	template<typename E, typename Allocator>
+	void ArrayDeque<E, Allocator>::shrink() {
+		if (this->maxCapacity > DataEngine<E>::DEFAULT_CAPACITY) {
+			relocate(this->maxCapacity >> 1);
+		}
+	}
+
+	template<typename E, typename Allocator>
+	void ArrayDeque<E, Allocator>::compress() {
+		const size_t target = capacityFor(this->activeCapacity);
+		if (target < this->maxCapacity) {
+			relocate(target);
+		}
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] bool ArrayDeque<E, Allocator>::containsAllInternal(std::any* deque, int start, int end) {
+		auto other = std::any_cast<Deque<E>*>(deque);
+		if (other == nullptr) {
+			return false;
+		}
+		std::unique_ptr<E[]> items((*other)->toArray(start, end));
+		if (items == nullptr) {
+			return false;
+		}
+		for (int i = 0; i < end - start; i++) {
+			if (!contains(items[i])) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] std::any* ArrayDeque<E, Allocator>::retainAll(std::any* deque) {
+		auto other = std::any_cast<Deque<E>*>(deque);
+		if (other == nullptr) {
+			return nullptr;
+		}
+		size_t write = 0;
+		for (size_t read = 0; read < this->activeCapacity; read++) {
+			if (!(*other)->contains(*slot(read))) {
+				continue;
+			}
+			if (write != read) {
+				*slot(write) = std::move(*slot(read));
+			}
+			write++;
+		}
+		for (size_t i = write; i < this->activeCapacity; i++) {
+			std::destroy_at(slot(i));
+		}
+		this->activeCapacity = write;
+		if (this->activeCapacity < shrinkThreshold) {
+			shrink();
+		}
+		return new std::any(static_cast<Deque<E>*>(this));
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] std::any* ArrayDeque<E, Allocator>::mergeFirst(std::any* deque) {
+		auto other = std::any_cast<Deque<E>*>(deque);
+		if (other == nullptr) {
+			return nullptr;
+		}
+		const size_t count = (*other)->getActiveSize();
+		if (count > 0) {
+			std::unique_ptr<E[]> items((*other)->toArray());
+			addFirst(items.get(), count);
+		}
+		return new std::any(static_cast<Deque<E>*>(this));
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] std::any* ArrayDeque<E, Allocator>::mergeLast(std::any* deque) {
+		auto other = std::any_cast<Deque<E>*>(deque);
+		if (other == nullptr) {
+			return nullptr;
+		}
+		const size_t count = (*other)->getActiveSize();
+		if (count > 0) {
+			std::unique_ptr<E[]> items((*other)->toArray());
+			addLast(items.get(), count);
+		}
+		return new std::any(static_cast<Deque<E>*>(this));
+	}
+
+	template<typename E, typename Allocator>
+	bool ArrayDeque<E, Allocator>::equalsInternal(const DataEngine<E>& de) const {
+		if (auto deque = dynamic_cast<const ArrayDeque*>(&de)) {
+			return equalTo(*deque);
+		}
+		auto other = dynamic_cast<const Deque<E>*>(&de);
+		if (other == nullptr || other->getActiveSize() != this->activeCapacity) {
+			return false;
+		}
+		if (this->activeCapacity == 0) {
+			return true;
+		}
+		std::unique_ptr<E[]> items(other->toArray());
+		for (size_t i = 0; i < this->activeCapacity; i++) {
+			if (!(*slot(i) == items[i])) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] bool ArrayDeque<E, Allocator>::equivalenceInternal(const DataEngine<E>& de) const {
+		auto other = dynamic_cast<const Deque<E>*>(&de);
+		if (other == nullptr || other->getActiveSize() != this->activeCapacity) {
+			return false;
+		}
+		if (this->activeCapacity == 0) {
+			return true;
+		}
+		std::unique_ptr<E[]> mine(toArray());
+		std::unique_ptr<E[]> theirs(other->toArray());
+		if constexpr (std::totally_ordered<E>) {
+			std::sort(mine.get(), mine.get() + this->activeCapacity);
+			std::sort(theirs.get(), theirs.get() + this->activeCapacity);
+			return std::equal(mine.get(), mine.get() + this->activeCapacity, theirs.get());
+		}
+		else {
+			return std::is_permutation(mine.get(), mine.get() + this->activeCapacity, theirs.get());
+		}
+	}
+
+	template<typename E, typename Allocator>
+	std::unique_ptr<DataEngine<E>> ArrayDeque<E, Allocator>::mergeInternal(const DataEngine<E>& de, int start, int end) const {
+		auto other = dynamic_cast<const Deque<E>*>(&de);
+		if (other == nullptr || start < 0 || end < start || static_cast<size_t>(end) > other->getActiveSize()) {
+			return nullptr;
+		}
+		auto merged = std::make_unique<ArrayDeque>(this->activeCapacity + (end - start), allocator);
+		const size_t first = firstRun(0, this->activeCapacity);
+		merged->copyIn(0, slot(0), first);
+		merged->copyIn(first, buffer, this->activeCapacity - first);
+		merged->activeCapacity = this->activeCapacity;
+		if (end > start) {
+			std::unique_ptr<E[]> items(other->toArray(start, end));
+			merged->addLast(items.get(), end - start);
+		}
+		return merged;
+	}
+
+	template<typename E, typename Allocator>
+	void ArrayDeque<E, Allocator>::relocate(size_t capacity) {
+		E* fresh = allocate(capacity);
+		if (buffer != nullptr) {
+			const size_t first = firstRun(0, this->activeCapacity);
+			const size_t second = this->activeCapacity - first;
+			if constexpr (RELOCATABLE) {
+				std::memcpy(static_cast<void*>(fresh), static_cast<const void*>(buffer + head), first * sizeof(E));
+				std::memcpy(static_cast<void*>(fresh + first), static_cast<const void*>(buffer), second * sizeof(E));
+			}
+			else {
+				std::uninitialized_move_n(buffer + head, first, fresh);
+				std::uninitialized_move_n(buffer, second, fresh + first);
+				std::destroy(buffer + head, buffer + head + first);
+				std::destroy(buffer, buffer + second);
+			}
+			deallocate(buffer, this->maxCapacity);
+		}
+		buffer = fresh;
+		head = 0;
+		this->maxCapacity = capacity;
+		updateThresholds();
+	}
+
+	template<typename E, typename Allocator>
+	void ArrayDeque<E, Allocator>::copyIn(size_t index, const E* items, size_t count) {
+		const size_t first = std::min(count, this->maxCapacity - index);
+		if constexpr (std::is_trivially_copyable_v<E>) {
+			std::memcpy(static_cast<void*>(buffer + index), static_cast<const void*>(items), first * sizeof(E));
+			std::memcpy(static_cast<void*>(buffer), static_cast<const void*>(items + first), (count - first) * sizeof(E));
+		}
+		else {
+			std::uninitialized_copy_n(items, first, buffer + index);
+			std::uninitialized_copy_n(items + first, count - first, buffer);
+		}
+	}
+
+	template<typename E, typename Allocator>
+	void ArrayDeque<E, Allocator>::release() noexcept {
+		if (buffer != nullptr) {
+			const size_t first = firstRun(0, this->activeCapacity);
+			std::destroy(buffer + head, buffer + head + first);
+			std::destroy(buffer, buffer + (this->activeCapacity - first));
+			deallocate(buffer, this->maxCapacity);
+			buffer = nullptr;
+		}
+	}
+
+	template<typename E, typename Allocator>
+	void ArrayDeque<E, Allocator>::updateThresholds() noexcept {
+		mask = this->maxCapacity - 1;
+		growthThreshold = static_cast<size_t>(this->maxCapacity * DataEngine<E>::GROWTH_LOAD_FACTOR);
+		shrinkThreshold = static_cast<size_t>(this->maxCapacity * DataEngine<E>::SHRINK_LOAD_FACTOR);
+	}
+
+	template<typename E, typename Allocator>
+	size_t ArrayDeque<E, Allocator>::capacityFor(size_t items) noexcept {
+		const auto required = static_cast<size_t>(std::ceil(items / DataEngine<E>::GROWTH_LOAD_FACTOR)) + 1;
+		return std::bit_ceil(std::max<size_t>(required, DataEngine<E>::DEFAULT_CAPACITY));
+	}
+
+	template<typename E, typename Allocator>
+	E* ArrayDeque<E, Allocator>::allocate(size_t capacity) const {
+		return allocateStorage<E>(allocator, capacity);
+	}
+
+	template<typename E, typename Allocator>
+	void ArrayDeque<E, Allocator>::deallocate(E* buffer, size_t capacity) const noexcept {
+		deallocateStorage(allocator, buffer, capacity);
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] bool ArrayDeque<E, Allocator>::equalTo(const ArrayDeque& other) const {
+		if (other.activeCapacity != this->activeCapacity) {
+			return false;
+		}
+		for (size_t i = 0; i < this->activeCapacity; i++) {
+			if (!(*slot(i) == *other.slot(i))) {
+				return false;
+			}
+		}
+		return true;
+	}
+}
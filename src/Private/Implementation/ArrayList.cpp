@@ -0,0 +1,524 @@
+#include "../../Public/Implementation/ArrayList.h"
+#include "../../Public/EngineSort.h"
+#include <algorithm>
+#include <concepts>
+#include <cmath>
+#include <vector>
+
+namespace core {
+	template<typename E, typename Allocator>
+	ArrayList<E, Allocator>::ArrayList() : ArrayList(DataEngine<E>::DEFAULT_CAPACITY) {}
+
+	template<typename E, typename Allocator>
+	ArrayList<E, Allocator>::ArrayList(const Allocator& allocator) : ArrayList(DataEngine<E>::DEFAULT_CAPACITY, allocator) {}
+
+	template<typename E, typename Allocator>
+	ArrayList<E, Allocator>::ArrayList(size_t capacity, const Allocator& allocator) : allocator(allocator) {
+		const auto required = static_cast<size_t>(std::ceil(capacity / DataEngine<E>::GROWTH_LOAD_FACTOR));
+		this->maxCapacity = std::max<size_t>(required, 1);
+		this->activeCapacity = 0;
+		buffer = allocate(this->maxCapacity);
+		updateThresholds();
+	}
+
+	template<typename E, typename Allocator>
+	ArrayList<E, Allocator>::~ArrayList() {
+		release();
+	}
+
+	template<typename E, typename Allocator>
+	ArrayList<E, Allocator>::ArrayList(ArrayList&& other) noexcept : allocator(other.allocator), buffer(other.buffer),
+		growthThreshold(other.growthThreshold), shrinkThreshold(other.shrinkThreshold) {
+		this->maxCapacity = other.maxCapacity;
+		this->activeCapacity = other.activeCapacity;
+		other.buffer = nullptr;
+		other.maxCapacity = 0;
+		other.activeCapacity = 0;
+		other.updateThresholds();
+	}
+
+	template<typename E, typename Allocator>
+	ArrayList<E, Allocator>& ArrayList<E, Allocator>::operator=(ArrayList&& other) noexcept(takesStorageOnMove<Allocator>) {
+		if (this != &other) {
+			requireStorageOnMove(allocator, other.allocator);
+			release();
+			propagateOnMove(allocator, other.allocator);
+			buffer = other.buffer;
+			this->maxCapacity = other.maxCapacity;
+			this->activeCapacity = other.activeCapacity;
+			growthThreshold = other.growthThreshold;
+			shrinkThreshold = other.shrinkThreshold;
+			other.buffer = nullptr;
+			other.maxCapacity = 0;
+			other.activeCapacity = 0;
+			other.updateThresholds();
+		}
+		return *this;
+	}
+
+	template<typename E, typename Allocator>
+	bool ArrayList<E, Allocator>::add(E item) {
+		if (this->activeCapacity >= growthThreshold) {
+			grow();
+		}
+		::new (static_cast<void*>(buffer + this->activeCapacity)) E(std::move(item));
+		++this->activeCapacity;
+		return true;
+	}
+
+	template<typename E, typename Allocator>
+	bool ArrayList<E, Allocator>::add(E item, int index) {
+		if (index < 0 || static_cast<size_t>(index) > this->activeCapacity) {
+			return false;
+		}
+		openGap(index, 1);
+		::new (static_cast<void*>(buffer + index)) E(std::move(item));
+		++this->activeCapacity;
+		return true;
+	}
+
+	template<typename E, typename Allocator>
+	bool ArrayList<E, Allocator>::addAll(E items[], int start, int end) {
+		if (items == nullptr || start < 0 || end <= start) {
+			return false;
+		}
+		const auto width = static_cast<size_t>(end - start);
+		reserve(this->activeCapacity + width);
+		std::uninitialized_copy_n(items + start, width, buffer + this->activeCapacity);
+		this->activeCapacity += width;
+		return true;
+	}
+
+	//get and set are unchecked like a raw array, callers are expected to stay within [0, getActiveSize())
+	template<typename E, typename Allocator>
+	E ArrayList<E, Allocator>::get(int index) const {
+		return buffer[index];
+	}
+
+	template<typename E, typename Allocator>
+	int ArrayList<E, Allocator>::getFirstIndex(E item) {
+		for (size_t i = 0; i < this->activeCapacity; i++) {
+			if (buffer[i] == item) {
+				return static_cast<int>(i);
+			}
+		}
+		return -1;
+	}
+
+	template<typename E, typename Allocator>
+	int ArrayList<E, Allocator>::getLastIndex(E item) {
+		for (size_t i = this->activeCapacity; i > 0; i--) {
+			if (buffer[i - 1] == item) {
+				return static_cast<int>(i - 1);
+			}
+		}
+		return -1;
+	}
+
+	template<typename E, typename Allocator>
+	bool ArrayList<E, Allocator>::remove(E item) {
+		//Single stable compaction pass instead of one shift per occurrence
+		size_t write = 0;
+		for (size_t read = 0; read < this->activeCapacity; read++) {
+			if (buffer[read] == item) {
+				continue;
+			}
+			if (write != read) {
+				buffer[write] = std::move(buffer[read]);
+			}
+			write++;
+		}
+		if (write == this->activeCapacity) {
+			return false;
+		}
+		std::destroy(buffer + write, buffer + this->activeCapacity);
+		this->activeCapacity = write;
+		if (this->activeCapacity < shrinkThreshold) {
+			shrink();
+		}
+		return true;
+	}
+
+	template<typename E, typename Allocator>
+	bool ArrayList<E, Allocator>::removeAt(int index) {
+		if (index < 0 || static_cast<size_t>(index) >= this->activeCapacity) {
+			return false;
+		}
+		std::destroy_at(buffer + index);
+		closeGap(index, 1);
+		--this->activeCapacity;
+		if (this->activeCapacity < shrinkThreshold) {
+			shrink();
+		}
+		return true;
+	}
+
+	template<typename E, typename Allocator>
+	void ArrayList<E, Allocator>::set(int index, E item) {
+		buffer[index] = std::move(item);
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] bool ArrayList<E, Allocator>::contains(E item) {
+		return getFirstIndex(item) != -1;
+	}
+
+	template<typename E, typename Allocator>
+	void ArrayList<E, Allocator>::replaceAll(std::function<E(E*)> operatorFunction, int start, int end) {
+		if (start < 0 || end <= start || static_cast<size_t>(end) > this->activeCapacity) {
+			return;
+		}
+		for (int i = start; i < end; i++) {
+			buffer[i] = operatorFunction(buffer + i);
+		}
+	}
+
+	template<typename E, typename Allocator>
+	std::unique_ptr<DataEngine<E>> ArrayList<E, Allocator>::clone() const {
+		auto copy = std::make_unique<ArrayList>(allocator);
+		copy->reserve(this->activeCapacity);
+		std::uninitialized_copy_n(buffer, this->activeCapacity, copy->buffer);
+		copy->activeCapacity = this->activeCapacity;
+		return copy;
+	}
+
+	template<typename E, typename Allocator>
+	std::unique_ptr<DataEngine<E>> ArrayList<E, Allocator>::move() {
+		return std::make_unique<ArrayList>(std::move(*this));
+	}
+
+	template<typename E, typename Allocator>
+	bool ArrayList<E, Allocator>::removeAll() {
+		if (this->activeCapacity == 0) {
+			return false;
+		}
+		std::destroy(buffer, buffer + this->activeCapacity);
+		this->activeCapacity = 0;
+		if (this->maxCapacity > DataEngine<E>::DEFAULT_CAPACITY) {
+			relocate(DataEngine<E>::DEFAULT_CAPACITY);
+		}
+		return true;
+	}
+
+	template<typename E, typename Allocator>
+	E* ArrayList<E, Allocator>::toArray() const {
+		return toArray(0, static_cast<int>(this->activeCapacity));
+	}
+
+	template<typename E, typename Allocator>
+	E* ArrayList<E, Allocator>::toArray(int start, int end) const {
+		if (start < 0 || end <= start || static_cast<size_t>(end) > this->activeCapacity) {
+			return nullptr;
+		}
+		std::unique_ptr<E[]> array(new E[end - start]);
+		copyTo(std::span<E>(array.get(), end - start), start);
+		return array.release();
+	}
+
+	template<typename E, typename Allocator>
+	size_t ArrayList<E, Allocator>::copyTo(std::span<E> destination, size_t start) const {
+		if (destination.empty() || start >= this->activeCapacity) {
+			return 0;
+		}
+		const size_t count = std::min(destination.size(), this->activeCapacity - start);
+		std::copy_n(buffer + start, count, destination.data());
+		return count;
+	}
+
+	template<typename E, typename Allocator>
+	void ArrayList<E, Allocator>::reverse() {
+		std::reverse(buffer, buffer + this->activeCapacity);
+	}
+
+	template<typename E, typename Allocator>
+	void ArrayList<E, Allocator>::sort(unsigned threads) requires std::totally_ordered<E> {
+		ParallelSort::sort(buffer, this->activeCapacity, threads);
+	}
+
+	template<typename E, typename Allocator>
+	E* ArrayList<E, Allocator>::begin() noexcept {
+		return buffer;
+	}
+
+	template<typename E, typename Allocator>
+	E* ArrayList<E, Allocator>::end() noexcept {
+		return buffer + this->activeCapacity;
+	}
+
+	template<typename E, typename Allocator>
+	const E* ArrayList<E, Allocator>::begin() const noexcept {
+		return buffer;
+	}
+
+	template<typename E, typename Allocator>
+	const E* ArrayList<E, Allocator>::end() const noexcept {
+		return buffer + this->activeCapacity;
+	}
+
+	template<typename E, typename Allocator>
+	std::span<E> ArrayList<E, Allocator>::view() noexcept {
+		return std::span<E>(buffer, this->activeCapacity);
+	}
+
+	template<typename E, typename Allocator>
+	std::span<const E> ArrayList<E, Allocator>::view() const noexcept {
+		return std::span<const E>(buffer, this->activeCapacity);
+	}
+
+	template<typename E, typename Allocator>
+	void ArrayList<E, Allocator>::reserve(size_t capacity) {
+		if (capacity <= growthThreshold) {
+			return;
+		}
+		auto target = static_cast<size_t>(std::ceil(capacity / DataEngine<E>::GROWTH_LOAD_FACTOR));
+		relocate(std::max(target, static_cast<size_t>(std::ceil(this->maxCapacity * DataEngine<E>::GOLDEN_RATIO))));
+	}
+
+	template<typename E, typename Allocator>
+	void ArrayList<E, Allocator>::grow() {
+		relocate(static_cast<size_t>(std::ceil(this->maxCapacity * DataEngine<E>::GOLDEN_RATIO)) + 1);
+	}
+
+	template<typename E, typename Allocator>
+	void ArrayList<E, Allocator>::shrink() {
+		if (this->maxCapacity <= DataEngine<E>::DEFAULT_CAPACITY) {
+			return;
+		}
+		const auto target = static_cast<size_t>(this->maxCapacity / DataEngine<E>::GOLDEN_RATIO);
+		relocate(std::max<size_t>(target, DataEngine<E>::DEFAULT_CAPACITY));
+	}
+
+	template<typename E, typename Allocator>
+	void ArrayList<E, Allocator>::compress() {
+		const auto target = static_cast<size_t>(std::ceil(this->activeCapacity / DataEngine<E>::GROWTH_LOAD_FACTOR));
+		if (target < this->maxCapacity) {
+			relocate(std::max<size_t>(target, 1));
+		}
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] bool ArrayList<E, Allocator>::containsAllInternal(std::any* list, int start, int end) {
+		auto other = std::any_cast<List<E>*>(list);
+		if (other == nullptr) {
+			return false;
+		}
+		for (int i = start; i < end; i++) {
+			if (!contains((*other)->get(i))) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] bool ArrayList<E, Allocator>::addAllInternal(std::any* list, int start, int end) {
+		auto other = std::any_cast<List<E>*>(list);
+		if (other == nullptr) {
+			return false;
+		}
+		reserve(this->activeCapacity + (end - start));
+		for (int i = start; i < end; i++) {
+			add((*other)->get(i));
+		}
+		return true;
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] std::any* ArrayList<E, Allocator>::retainAll(std::any* list) {
+		auto other = std::any_cast<List<E>*>(list);
+		if (other == nullptr) {
+			return nullptr;
+		}
+		size_t write = 0;
+		for (size_t read = 0; read < this->activeCapacity; read++) {
+			if (!(*other)->contains(buffer[read])) {
+				continue;
+			}
+			if (write != read) {
+				buffer[write] = std::move(buffer[read]);
+			}
+			write++;
+		}
+		std::destroy(buffer + write, buffer + this->activeCapacity);
+		this->activeCapacity = write;
+		if (this->activeCapacity < shrinkThreshold) {
+			shrink();
+		}
+		return new std::any(static_cast<List<E>*>(this));
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] std::any* ArrayList<E, Allocator>::subList(int start, int end) {
+		auto sub = std::make_unique<ArrayList>(static_cast<size_t>(end - start), allocator);
+		std::uninitialized_copy(buffer + start, buffer + end, sub->buffer);
+		sub->activeCapacity = end - start;
+		return new std::any(sub.release());
+	}
+
+	template<typename E, typename Allocator>
+	bool ArrayList<E, Allocator>::equalsInternal(const DataEngine<E>& de) const {
+		if (auto list = dynamic_cast<const ArrayList*>(&de)) {
+			return equalTo(*list);
+		}
+		auto other = dynamic_cast<const List<E>*>(&de);
+		if (other == nullptr || other->getActiveSize() != this->activeCapacity) {
+			return false;
+		}
+		for (size_t i = 0; i < this->activeCapacity; i++) {
+			if (!(buffer[i] == other->get(static_cast<int>(i)))) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] bool ArrayList<E, Allocator>::equivalenceInternal(const DataEngine<E>& de) const {
+		if (auto list = dynamic_cast<const ArrayList*>(&de)) {
+			return equivalentTo(*list);
+		}
+		auto other = dynamic_cast<const List<E>*>(&de);
+		if (other == nullptr || other->getActiveSize() != this->activeCapacity) {
+			return false;
+		}
+		std::vector<E> left(buffer, buffer + this->activeCapacity);
+		std::vector<E> right;
+		right.reserve(this->activeCapacity);
+		for (size_t i = 0; i < this->activeCapacity; i++) {
+			right.push_back(other->get(static_cast<int>(i)));
+		}
+		if constexpr (std::totally_ordered<E>) {
+			std::sort(left.begin(), left.end());
+			std::sort(right.begin(), right.end());
+			return left == right;
+		}
+		else {
+			return std::is_permutation(left.begin(), left.end(), right.begin());
+		}
+	}
+
+	template<typename E, typename Allocator>
+	std::unique_ptr<DataEngine<E>> ArrayList<E, Allocator>::mergeInternal(const DataEngine<E>& de, int start, int end) const {
+		if (auto list = dynamic_cast<const ArrayList*>(&de)) {
+			return mergeWith(*list, start, end);
+		}
+		auto other = dynamic_cast<const List<E>*>(&de);
+		if (other == nullptr || start < 0 || end < start || static_cast<size_t>(end) > other->getActiveSize()) {
+			return nullptr;
+		}
+		auto merged = std::make_unique<ArrayList>(this->activeCapacity + (end - start), allocator);
+		std::uninitialized_copy_n(buffer, this->activeCapacity, merged->buffer);
+		merged->activeCapacity = this->activeCapacity;
+		for (int i = start; i < end; i++) {
+			merged->add(other->get(i));
+		}
+		return merged;
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] bool ArrayList<E, Allocator>::equalTo(const ArrayList& other) const {
+		return other.activeCapacity == this->activeCapacity && std::equal(buffer, buffer + this->activeCapacity, other.buffer);
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] bool ArrayList<E, Allocator>::equivalentTo(const ArrayList& other) const {
+		if (other.activeCapacity != this->activeCapacity) {
+			return false;
+		}
+		if constexpr (std::totally_ordered<E>) {
+			std::vector<E> left(buffer, buffer + this->activeCapacity);
+			std::vector<E> right(other.buffer, other.buffer + this->activeCapacity);
+			std::sort(left.begin(), left.end());
+			std::sort(right.begin(), right.end());
+			return left == right;
+		}
+		else {
+			return std::is_permutation(buffer, buffer + this->activeCapacity, other.buffer);
+		}
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] std::unique_ptr<ArrayList<E, Allocator>> ArrayList<E, Allocator>::mergeWith(const ArrayList& other, int start, int end) const {
+		if (start < 0 || end < start || static_cast<size_t>(end) > other.activeCapacity) {
+			return nullptr;
+		}
+		const size_t added = static_cast<size_t>(end - start);
+		auto merged = std::make_unique<ArrayList>(this->activeCapacity + added, allocator);
+		std::uninitialized_copy_n(buffer, this->activeCapacity, merged->buffer);
+		std::uninitialized_copy_n(other.buffer + start, added, merged->buffer + this->activeCapacity);
+		merged->activeCapacity = this->activeCapacity + added;
+		return merged;
+	}
+
+	template<typename E, typename Allocator>
+	void ArrayList<E, Allocator>::relocate(size_t capacity) {
+		E* fresh = allocate(capacity);
+		if (buffer != nullptr) {
+			if constexpr (RELOCATABLE) {
+				std::memcpy(static_cast<void*>(fresh), static_cast<const void*>(buffer), this->activeCapacity * sizeof(E));
+			}
+			else {
+				std::uninitialized_move_n(buffer, this->activeCapacity, fresh);
+				std::destroy(buffer, buffer + this->activeCapacity);
+			}
+			deallocate(buffer, this->maxCapacity);
+		}
+		buffer = fresh;
+		this->maxCapacity = capacity;
+		updateThresholds();
+	}
+
+	template<typename E, typename Allocator>
+	void ArrayList<E, Allocator>::openGap(size_t index, size_t width) {
+		reserve(this->activeCapacity + width);
+		if constexpr (RELOCATABLE) {
+			std::memmove(static_cast<void*>(buffer + index + width), static_cast<const void*>(buffer + index),
+				(this->activeCapacity - index) * sizeof(E));
+		}
+		else {
+			for (size_t i = this->activeCapacity; i > index; i--) {
+				::new (static_cast<void*>(buffer + i - 1 + width)) E(std::move(buffer[i - 1]));
+				std::destroy_at(buffer + i - 1);
+			}
+		}
+	}
+
+	template<typename E, typename Allocator>
+	void ArrayList<E, Allocator>::closeGap(size_t index, size_t width) {
+		if constexpr (RELOCATABLE) {
+			std::memmove(static_cast<void*>(buffer + index), static_cast<const void*>(buffer + index + width),
+				(this->activeCapacity - index - width) * sizeof(E));
+		}
+		else {
+			for (size_t i = index + width; i < this->activeCapacity; i++) {
+				::new (static_cast<void*>(buffer + i - width)) E(std::move(buffer[i]));
+				std::destroy_at(buffer + i);
+			}
+		}
+	}
+
+	template<typename E, typename Allocator>
+	void ArrayList<E, Allocator>::release() noexcept {
+		if (buffer != nullptr) {
+			std::destroy(buffer, buffer + this->activeCapacity);
+			deallocate(buffer, this->maxCapacity);
+			buffer = nullptr;
+		}
+	}
+
+	template<typename E, typename Allocator>
+	void ArrayList<E, Allocator>::updateThresholds() noexcept {
+		growthThreshold = static_cast<size_t>(this->maxCapacity * DataEngine<E>::GROWTH_LOAD_FACTOR);
+		shrinkThreshold = static_cast<size_t>(this->maxCapacity * DataEngine<E>::SHRINK_LOAD_FACTOR);
+	}
+
+	template<typename E, typename Allocator>
+	E* ArrayList<E, Allocator>::allocate(size_t capacity) const {
+		return allocateStorage<E>(allocator, capacity);
+	}
+
+	template<typename E, typename Allocator>
+	void ArrayList<E, Allocator>::deallocate(E* buffer, size_t capacity) const noexcept {
+		deallocateStorage(allocator, buffer, capacity);
+	}
+}
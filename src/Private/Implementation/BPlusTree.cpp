@@ -0,0 +1,782 @@
+#include "../../Public/Implementation/BPlusTree.h"
+#include <type_traits>
+#include <vector>
+
+namespace core {
+	template<typename K, typename V, typename Allocator>
+	BPlusTree<K, V, Allocator>::BPlusTree() : BPlusTree(Allocator()) {}
+
+	template<typename K, typename V, typename Allocator>
+	BPlusTree<K, V, Allocator>::BPlusTree(const Allocator& allocator) : allocator(allocator), root(nullptr), head(nullptr), tail(nullptr), height(0) {
+		this->maxCapacity = 0;
+		this->activeCapacity = 0;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	BPlusTree<K, V, Allocator>::BPlusTree(const E* entries, size_t count, const Allocator& allocator) : BPlusTree(allocator) {
+		for (size_t i = 1; i < count; i++) {
+			if (!(entries[i - 1].key < entries[i].key)) {
+				throw std::invalid_argument("bulk load requires strictly increasing keys");
+			}
+		}
+		build(entries, count);
+	}
+
+	template<typename K, typename V, typename Allocator>
+	BPlusTree<K, V, Allocator>::~BPlusTree() {
+		releaseAll();
+	}
+
+	template<typename K, typename V, typename Allocator>
+	BPlusTree<K, V, Allocator>::BPlusTree(BPlusTree&& other) noexcept : allocator(other.allocator), root(other.root), head(other.head), tail(other.tail),
+		height(other.height) {
+		this->maxCapacity = other.maxCapacity;
+		this->activeCapacity = other.activeCapacity;
+		other.root = nullptr;
+		other.head = nullptr;
+		other.tail = nullptr;
+		other.height = 0;
+		other.maxCapacity = 0;
+		other.activeCapacity = 0;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	BPlusTree<K, V, Allocator>& BPlusTree<K, V, Allocator>::operator=(BPlusTree&& other) noexcept(takesStorageOnMove<Allocator>) {
+		if (this != &other) {
+			requireStorageOnMove(allocator, other.allocator);
+			release(root);
+			propagateOnMove(allocator, other.allocator);
+			root = other.root;
+			head = other.head;
+			tail = other.tail;
+			height = other.height;
+			this->maxCapacity = other.maxCapacity;
+			this->activeCapacity = other.activeCapacity;
+			other.root = nullptr;
+			other.head = nullptr;
+			other.tail = nullptr;
+			other.height = 0;
+			other.maxCapacity = 0;
+			other.activeCapacity = 0;
+		}
+		return *this;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	bool BPlusTree<K, V, Allocator>::put(K key, V value) {
+		if (root == nullptr) {
+			head = tail = allocateLeaf();
+			root = head;
+			height = 1;
+		}
+		Inner* path[MAX_HEIGHT];
+		size_t slots[MAX_HEIGHT];
+		size_t depth = 0;
+		Node* node = root;
+		while (!node->leaf) {
+			Inner* inner = static_cast<Inner*>(node);
+			const size_t slot = childIndex(inner, key);
+			path[depth] = inner;
+			slots[depth++] = slot;
+			node = inner->children[slot];
+		}
+		Leaf* leaf = static_cast<Leaf*>(node);
+		const size_t index = entryIndex(leaf, key);
+		if (index < leaf->count && !(key < leaf->entries[index].key)) {
+			leaf->entries[index].value = std::move(value);
+			return false;
+		}
+		this->activeCapacity++;
+		if (leaf->count < LEAF_CAPACITY) {
+			std::move_backward(leaf->entries + index, leaf->entries + leaf->count, leaf->entries + leaf->count + 1);
+			leaf->entries[index] = E{ std::move(key), std::move(value) };
+			leaf->count++;
+			return true;
+		}
+
+		//Splits the full leaf so that the halves differ by at most one entry once the new one is in
+		Leaf* right = allocateLeaf();
+		right->previous = leaf;
+		right->next = leaf->next;
+		(leaf->next != nullptr ? leaf->next->previous : tail) = right;
+		leaf->next = right;
+		const size_t middle = (LEAF_CAPACITY + 1) / 2;
+		if (index < middle) {
+			std::move(leaf->entries + middle - 1, leaf->entries + LEAF_CAPACITY, right->entries);
+			right->count = static_cast<uint32_t>(LEAF_CAPACITY - middle + 1);
+			std::move_backward(leaf->entries + index, leaf->entries + middle - 1, leaf->entries + middle);
+			leaf->entries[index] = E{ std::move(key), std::move(value) };
+		}
+		else {
+			const size_t offset = index - middle;
+			std::move(leaf->entries + middle, leaf->entries + index, right->entries);
+			right->entries[offset] = E{ std::move(key), std::move(value) };
+			std::move(leaf->entries + index, leaf->entries + LEAF_CAPACITY, right->entries + offset + 1);
+			right->count = static_cast<uint32_t>(LEAF_CAPACITY + 1 - middle);
+		}
+		leaf->count = static_cast<uint32_t>(middle);
+		insertIntoParents(path, slots, depth, right->entries[0].key, right);
+		return true;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	[[nodiscard]] bool BPlusTree<K, V, Allocator>::get(const K& key, V& value) const {
+		const V* found = find(key);
+		if (found == nullptr) {
+			return false;
+		}
+		value = *found;
+		return true;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	bool BPlusTree<K, V, Allocator>::remove(const K& key) {
+		if (root == nullptr) {
+			return false;
+		}
+		Inner* path[MAX_HEIGHT];
+		size_t slots[MAX_HEIGHT];
+		size_t depth = 0;
+		Node* node = root;
+		while (!node->leaf) {
+			Inner* inner = static_cast<Inner*>(node);
+			const size_t slot = childIndex(inner, key);
+			path[depth] = inner;
+			slots[depth++] = slot;
+			node = inner->children[slot];
+		}
+		Leaf* leaf = static_cast<Leaf*>(node);
+		const size_t index = entryIndex(leaf, key);
+		if (index == leaf->count || key < leaf->entries[index].key) {
+			return false;
+		}
+		std::move(leaf->entries + index + 1, leaf->entries + leaf->count, leaf->entries + index);
+		leaf->entries[--leaf->count] = E{}; //Releases whatever the vacated slot still owns
+		this->activeCapacity--;
+		if (depth == 0) {
+			if (leaf->count == 0) {
+				deallocateLeaf(leaf);
+				root = head = tail = nullptr;
+				height = 0;
+			}
+			return true;
+		}
+		if (leaf->count < LEAF_MINIMUM) {
+			rebalance(leaf, path, slots, depth);
+		}
+		return true;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	[[nodiscard]] bool BPlusTree<K, V, Allocator>::containsKey(const K& key) const {
+		return find(key) != nullptr;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	[[nodiscard]] bool BPlusTree<K, V, Allocator>::containsValue(const V& value) {
+		for (Leaf* leaf = head; leaf != nullptr; leaf = leaf->next) {
+			for (size_t i = 0; i < leaf->count; i++) {
+				if (leaf->entries[i].value == value) {
+					return true;
+				}
+			}
+		}
+		return false;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	[[nodiscard]] bool BPlusTree<K, V, Allocator>::first(E& entry) const {
+		if (head == nullptr) {
+			return false;
+		}
+		entry = head->entries[0];
+		return true;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	[[nodiscard]] bool BPlusTree<K, V, Allocator>::last(E& entry) const {
+		if (tail == nullptr) {
+			return false;
+		}
+		entry = tail->entries[tail->count - 1];
+		return true;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	[[nodiscard]] bool BPlusTree<K, V, Allocator>::ceiling(const K& key, E& entry) const {
+		size_t index;
+		Leaf* leaf = lowerBound(key, index);
+		if (leaf == nullptr) {
+			return false;
+		}
+		entry = leaf->entries[index];
+		return true;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	[[nodiscard]] bool BPlusTree<K, V, Allocator>::floor(const K& key, E& entry) const {
+		Leaf* leaf = leafFor(key);
+		if (leaf == nullptr) {
+			return false;
+		}
+		const size_t index = entryIndex(leaf, key);
+		if (index < leaf->count && !(key < leaf->entries[index].key)) {
+			entry = leaf->entries[index];
+		}
+		else if (index > 0) {
+			entry = leaf->entries[index - 1];
+		}
+		else if (leaf->previous != nullptr) {
+			//Every key of the previous leaf is below the separator, which is not above the key
+			entry = leaf->previous->entries[leaf->previous->count - 1];
+		}
+		else {
+			return false;
+		}
+		return true;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	size_t BPlusTree<K, V, Allocator>::scan(const K& from, std::function<bool(const E&)> visitor) const {
+		size_t visited = 0;
+		size_t index;
+		for (Leaf* leaf = lowerBound(from, index); leaf != nullptr; leaf = leaf->next, index = 0) {
+			for (; index < leaf->count; index++) {
+				visited++;
+				if (!visitor(leaf->entries[index])) {
+					return visited;
+				}
+			}
+		}
+		return visited;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	[[nodiscard]] V* BPlusTree<K, V, Allocator>::find(const K& key) {
+		return const_cast<V*>(std::as_const(*this).find(key));
+	}
+
+	template<typename K, typename V, typename Allocator>
+	[[nodiscard]] const V* BPlusTree<K, V, Allocator>::find(const K& key) const {
+		Leaf* leaf = leafFor(key);
+		if (leaf == nullptr) {
+			return nullptr;
+		}
+		const size_t index = entryIndex(leaf, key);
+		if (index == leaf->count || key < leaf->entries[index].key) {
+			return nullptr;
+		}
+		return &leaf->entries[index].value;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	[[nodiscard]] size_t BPlusTree<K, V, Allocator>::getHeight() const {
+		return height;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	std::unique_ptr<DataEngine<Entry<K, V>>> BPlusTree<K, V, Allocator>::clone() const {
+		auto copy = std::make_unique<BPlusTree>(allocator);
+		if (this->activeCapacity > 0) {
+			std::unique_ptr<E[]> entries(new E[this->activeCapacity]);
+			collect(entries.get());
+			copy->build(entries.get(), this->activeCapacity);
+		}
+		return copy;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	std::unique_ptr<DataEngine<Entry<K, V>>> BPlusTree<K, V, Allocator>::move() {
+		return std::make_unique<BPlusTree>(std::move(*this));
+	}
+
+	template<typename K, typename V, typename Allocator>
+	bool BPlusTree<K, V, Allocator>::removeAll() {
+		if (root == nullptr) {
+			return false;
+		}
+		releaseAll();
+		root = head = tail = nullptr;
+		height = 0;
+		this->maxCapacity = 0;
+		this->activeCapacity = 0;
+		return true;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	Entry<K, V>* BPlusTree<K, V, Allocator>::toArray() const {
+		if (this->activeCapacity == 0) {
+			return nullptr;
+		}
+		std::unique_ptr<E[]> array(new E[this->activeCapacity]);
+		collect(array.get());
+		return array.release();
+	}
+
+	template<typename K, typename V, typename Allocator>
+	Entry<K, V>* BPlusTree<K, V, Allocator>::toArray(int start, int end) const {
+		if (start < 0 || end <= start || static_cast<size_t>(end) > this->activeCapacity) {
+			return nullptr;
+		}
+		std::unique_ptr<E[]> array(new E[end - start]);
+		copyTo(std::span<E>(array.get(), end - start), start);
+		return array.release();
+	}
+
+	template<typename K, typename V, typename Allocator>
+	size_t BPlusTree<K, V, Allocator>::copyTo(std::span<Entry<K, V>> destination, size_t start) const {
+		if (destination.empty() || start >= this->activeCapacity) {
+			return 0;
+		}
+		const size_t count = std::min(destination.size(), this->activeCapacity - start);
+		//Whole leaves before the range are skipped by their count alone
+		Leaf* leaf = head;
+		size_t from = start;
+		while (from >= leaf->count) {
+			from -= leaf->count;
+			leaf = leaf->next;
+		}
+		for (size_t copied = 0; copied < count; leaf = leaf->next, from = 0) {
+			const size_t taken = std::min<size_t>(leaf->count - from, count - copied);
+			std::copy(leaf->entries + from, leaf->entries + from + taken, destination.data() + copied);
+			copied += taken;
+		}
+		return count;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	void BPlusTree<K, V, Allocator>::reverse() {}
+
+	template<typename K, typename V, typename Allocator>
+	typename BPlusTree<K, V, Allocator>::iterator BPlusTree<K, V, Allocator>::begin() {
+		return iterator(head, tail, 0);
+	}
+
+	template<typename K, typename V, typename Allocator>
+	typename BPlusTree<K, V, Allocator>::const_iterator BPlusTree<K, V, Allocator>::begin() const {
+		return const_iterator(head, tail, 0);
+	}
+
+	template<typename K, typename V, typename Allocator>
+	typename BPlusTree<K, V, Allocator>::iterator BPlusTree<K, V, Allocator>::end() {
+		return iterator(nullptr, tail, 0);
+	}
+
+	template<typename K, typename V, typename Allocator>
+	typename BPlusTree<K, V, Allocator>::const_iterator BPlusTree<K, V, Allocator>::end() const {
+		return const_iterator(nullptr, tail, 0);
+	}
+
+	template<typename K, typename V, typename Allocator>
+	void BPlusTree<K, V, Allocator>::grow() {}
+
+	template<typename K, typename V, typename Allocator>
+	void BPlusTree<K, V, Allocator>::shrink() {}
+
+	template<typename K, typename V, typename Allocator>
+	void BPlusTree<K, V, Allocator>::compress() {
+		if (this->activeCapacity == 0) {
+			return;
+		}
+		const size_t count = this->activeCapacity;
+		std::unique_ptr<E[]> entries(new E[count]);
+		collect(entries.get());
+		removeAll();
+		build(entries.get(), count);
+	}
+
+	template<typename K, typename V, typename Allocator>
+	bool BPlusTree<K, V, Allocator>::equalsInternal(const DataEngine<E>& de) const {
+		if (auto tree = dynamic_cast<const BPlusTree*>(&de)) {
+			return equalTo(*tree);
+		}
+		auto other = dynamic_cast<const Tree<K, V>*>(&de);
+		if (other == nullptr || other->getActiveSize() != this->activeCapacity) {
+			return false;
+		}
+		if (this->activeCapacity == 0) {
+			return true;
+		}
+		//Both sides are sorted by key, so equal trees match entry by entry
+		std::unique_ptr<E[]> theirs(other->toArray());
+		if (theirs == nullptr) {
+			return false;
+		}
+		size_t i = 0;
+		for (Leaf* leaf = head; leaf != nullptr; leaf = leaf->next) {
+			if (!std::equal(leaf->entries, leaf->entries + leaf->count, theirs.get() + i)) {
+				return false;
+			}
+			i += leaf->count;
+		}
+		return true;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	[[nodiscard]] bool BPlusTree<K, V, Allocator>::equivalenceInternal(const DataEngine<E>& de) const {
+		//Entries are ordered by key on both sides, so equivalence and equality coincide
+		return equalsInternal(de);
+	}
+
+	template<typename K, typename V, typename Allocator>
+	std::unique_ptr<DataEngine<Entry<K, V>>> BPlusTree<K, V, Allocator>::mergeInternal(const DataEngine<E>& de, int start, int end) const {
+		auto other = dynamic_cast<const Tree<K, V>*>(&de);
+		if (other == nullptr || start < 0 || end < start || static_cast<size_t>(end) > other->getActiveSize()) {
+			return nullptr;
+		}
+		if (end == start) {
+			return clone();
+		}
+		std::unique_ptr<E[]> added(other->toArray(start, end));
+		const size_t addedCount = static_cast<size_t>(end - start);
+		std::unique_ptr<E[]> own(this->activeCapacity > 0 ? new E[this->activeCapacity] : nullptr);
+		collect(own.get());
+
+		//Linear merge of the two sorted runs, the added entry wins on equal keys
+		std::vector<E> merged;
+		merged.reserve(this->activeCapacity + addedCount);
+		size_t i = 0;
+		size_t j = 0;
+		while (i < this->activeCapacity && j < addedCount) {
+			if (own[i].key < added[j].key) {
+				merged.push_back(std::move(own[i++]));
+			}
+			else if (added[j].key < own[i].key) {
+				merged.push_back(std::move(added[j++]));
+			}
+			else {
+				merged.push_back(std::move(added[j++]));
+				i++;
+			}
+		}
+		for (; i < this->activeCapacity; i++) {
+			merged.push_back(std::move(own[i]));
+		}
+		for (; j < addedCount; j++) {
+			merged.push_back(std::move(added[j]));
+		}
+		auto tree = std::make_unique<BPlusTree>(allocator);
+		tree->build(merged.data(), merged.size());
+		return tree;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	typename BPlusTree<K, V, Allocator>::Leaf* BPlusTree<K, V, Allocator>::leafFor(const K& key) const noexcept {
+		Node* node = root;
+		if (node == nullptr) {
+			return nullptr;
+		}
+		while (!node->leaf) {
+			Inner* inner = static_cast<Inner*>(node);
+			node = inner->children[childIndex(inner, key)];
+		}
+		return static_cast<Leaf*>(node);
+	}
+
+	template<typename K, typename V, typename Allocator>
+	typename BPlusTree<K, V, Allocator>::Leaf* BPlusTree<K, V, Allocator>::lowerBound(const K& key, size_t& index) const noexcept {
+		Leaf* leaf = leafFor(key);
+		if (leaf == nullptr) {
+			return nullptr;
+		}
+		index = entryIndex(leaf, key);
+		if (index == leaf->count) {
+			//Every key of the leaf is smaller, the next leaf starts at or above the key
+			leaf = leaf->next;
+			index = 0;
+		}
+		return leaf;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	void BPlusTree<K, V, Allocator>::insertIntoParents(Inner** path, size_t* slots, size_t depth, K separator, Node* right) {
+		while (depth > 0) {
+			Inner* inner = path[--depth];
+			const size_t slot = slots[depth];
+			if (inner->count < INNER_CAPACITY) {
+				std::move_backward(inner->keys + slot, inner->keys + inner->count, inner->keys + inner->count + 1);
+				std::move_backward(inner->children + slot + 1, inner->children + inner->count + 1, inner->children + inner->count + 2);
+				inner->keys[slot] = std::move(separator);
+				inner->children[slot + 1] = right;
+				inner->count++;
+				return;
+			}
+
+			//Lays out the overfull node, then pushes its middle key up and moves the upper half to a sibling
+			K keys[INNER_CAPACITY + 1];
+			Node* children[INNER_CAPACITY + 2];
+			std::move(inner->keys, inner->keys + slot, keys);
+			keys[slot] = std::move(separator);
+			std::move(inner->keys + slot, inner->keys + INNER_CAPACITY, keys + slot + 1);
+			std::copy(inner->children, inner->children + slot + 1, children);
+			children[slot + 1] = right;
+			std::copy(inner->children + slot + 1, inner->children + INNER_CAPACITY + 1, children + slot + 2);
+
+			const size_t middle = (INNER_CAPACITY + 1) / 2;
+			Inner* sibling = allocateInner();
+			std::move(keys, keys + middle, inner->keys);
+			std::copy(children, children + middle + 1, inner->children);
+			inner->count = static_cast<uint32_t>(middle);
+			std::move(keys + middle + 1, keys + INNER_CAPACITY + 1, sibling->keys);
+			std::copy(children + middle + 1, children + INNER_CAPACITY + 2, sibling->children);
+			sibling->count = static_cast<uint32_t>(INNER_CAPACITY - middle);
+			separator = std::move(keys[middle]);
+			right = sibling;
+		}
+		Inner* top = allocateInner();
+		top->keys[0] = std::move(separator);
+		top->children[0] = root;
+		top->children[1] = right;
+		top->count = 1;
+		root = top;
+		height++;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	void BPlusTree<K, V, Allocator>::rebalance(Leaf* leaf, Inner** path, size_t* slots, size_t depth) {
+		Inner* parent = path[depth - 1];
+		const size_t slot = slots[depth - 1];
+		Leaf* left = slot > 0 ? static_cast<Leaf*>(parent->children[slot - 1]) : nullptr;
+		Leaf* right = slot < parent->count ? static_cast<Leaf*>(parent->children[slot + 1]) : nullptr;
+		if (left != nullptr && left->count > LEAF_MINIMUM) {
+			std::move_backward(leaf->entries, leaf->entries + leaf->count, leaf->entries + leaf->count + 1);
+			leaf->entries[0] = std::move(left->entries[--left->count]);
+			leaf->count++;
+			parent->keys[slot - 1] = leaf->entries[0].key;
+			return;
+		}
+		if (right != nullptr && right->count > LEAF_MINIMUM) {
+			leaf->entries[leaf->count++] = std::move(right->entries[0]);
+			std::move(right->entries + 1, right->entries + right->count, right->entries);
+			right->count--;
+			parent->keys[slot] = right->entries[0].key;
+			return;
+		}
+
+		//Neither sibling can spare an entry, so the leaf merges with one of them into a single leaf
+		if (left != nullptr) {
+			std::move(leaf->entries, leaf->entries + leaf->count, left->entries + left->count);
+			left->count += leaf->count;
+			left->next = leaf->next;
+			(leaf->next != nullptr ? leaf->next->previous : tail) = left;
+			deallocateLeaf(leaf);
+			eraseFromInner(parent, slot - 1);
+		}
+		else {
+			std::move(right->entries, right->entries + right->count, leaf->entries + leaf->count);
+			leaf->count += right->count;
+			leaf->next = right->next;
+			(right->next != nullptr ? right->next->previous : tail) = leaf;
+			deallocateLeaf(right);
+			eraseFromInner(parent, slot);
+		}
+
+		for (size_t level = depth - 1;; level--) {
+			Inner* inner = path[level];
+			if (level == 0) {
+				if (inner->count == 0) {
+					//The root is left with a single child, which takes its place
+					root = inner->children[0];
+					deallocateInner(inner);
+					height--;
+				}
+				return;
+			}
+			if (inner->count >= INNER_MINIMUM || !rebalanceInner(inner, path[level - 1], slots[level - 1])) {
+				return;
+			}
+		}
+	}
+
+	template<typename K, typename V, typename Allocator>
+	bool BPlusTree<K, V, Allocator>::rebalanceInner(Inner* inner, Inner* parent, size_t slot) {
+		Inner* left = slot > 0 ? static_cast<Inner*>(parent->children[slot - 1]) : nullptr;
+		Inner* right = slot < parent->count ? static_cast<Inner*>(parent->children[slot + 1]) : nullptr;
+		if (left != nullptr && left->count > INNER_MINIMUM) {
+			//Rotates the last child of the left sibling in through the parent separator
+			std::move_backward(inner->keys, inner->keys + inner->count, inner->keys + inner->count + 1);
+			std::move_backward(inner->children, inner->children + inner->count + 1, inner->children + inner->count + 2);
+			inner->keys[0] = std::move(parent->keys[slot - 1]);
+			inner->children[0] = left->children[left->count];
+			parent->keys[slot - 1] = std::move(left->keys[left->count - 1]);
+			left->count--;
+			inner->count++;
+			return false;
+		}
+		if (right != nullptr && right->count > INNER_MINIMUM) {
+			inner->keys[inner->count] = std::move(parent->keys[slot]);
+			inner->children[inner->count + 1] = right->children[0];
+			inner->count++;
+			parent->keys[slot] = std::move(right->keys[0]);
+			std::move(right->keys + 1, right->keys + right->count, right->keys);
+			std::move(right->children + 1, right->children + right->count + 1, right->children);
+			right->count--;
+			return false;
+		}
+
+		//Merges with a sibling, pulling the separator between them down
+		if (left != nullptr) {
+			left->keys[left->count] = std::move(parent->keys[slot - 1]);
+			std::move(inner->keys, inner->keys + inner->count, left->keys + left->count + 1);
+			std::copy(inner->children, inner->children + inner->count + 1, left->children + left->count + 1);
+			left->count += inner->count + 1;
+			deallocateInner(inner);
+			eraseFromInner(parent, slot - 1);
+		}
+		else {
+			inner->keys[inner->count] = std::move(parent->keys[slot]);
+			std::move(right->keys, right->keys + right->count, inner->keys + inner->count + 1);
+			std::copy(right->children, right->children + right->count + 1, inner->children + inner->count + 1);
+			inner->count += right->count + 1;
+			deallocateInner(right);
+			eraseFromInner(parent, slot);
+		}
+		return true;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	void BPlusTree<K, V, Allocator>::eraseFromInner(Inner* inner, size_t index) {
+		std::move(inner->keys + index + 1, inner->keys + inner->count, inner->keys + index);
+		std::move(inner->children + index + 2, inner->children + inner->count + 1, inner->children + index + 1);
+		inner->count--;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	void BPlusTree<K, V, Allocator>::build(const E* entries, size_t count) {
+		if (count == 0) {
+			return;
+		}
+		//Spreads the entries evenly, so that every leaf but a lone root stays at least half full
+		const size_t leaves = (count + LEAF_CAPACITY - 1) / LEAF_CAPACITY;
+		std::vector<Node*> level(leaves);
+		std::vector<K> smallest(leaves);
+		Leaf* previous = nullptr;
+		size_t offset = 0;
+		for (size_t i = 0; i < leaves; i++) {
+			const size_t size = count / leaves + (i < count % leaves ? 1 : 0);
+			Leaf* leaf = allocateLeaf();
+			std::copy(entries + offset, entries + offset + size, leaf->entries);
+			leaf->count = static_cast<uint32_t>(size);
+			leaf->previous = previous;
+			(previous != nullptr ? previous->next : head) = leaf;
+			previous = leaf;
+			level[i] = leaf;
+			smallest[i] = entries[offset].key;
+			offset += size;
+		}
+		tail = previous;
+		this->activeCapacity = count;
+		height = 1;
+
+		//Builds each inner level over the one below it, again spreading the children evenly
+		while (level.size() > 1) {
+			const size_t nodes = level.size();
+			const size_t parents = (nodes + INNER_CAPACITY) / (INNER_CAPACITY + 1);
+			std::vector<Node*> upper(parents);
+			std::vector<K> upperSmallest(parents);
+			size_t child = 0;
+			for (size_t i = 0; i < parents; i++) {
+				const size_t size = nodes / parents + (i < nodes % parents ? 1 : 0);
+				Inner* inner = allocateInner();
+				inner->children[0] = level[child];
+				for (size_t j = 1; j < size; j++) {
+					inner->keys[j - 1] = std::move(smallest[child + j]);
+					inner->children[j] = level[child + j];
+				}
+				inner->count = static_cast<uint32_t>(size - 1);
+				upper[i] = inner;
+				upperSmallest[i] = std::move(smallest[child]);
+				child += size;
+			}
+			level = std::move(upper);
+			smallest = std::move(upperSmallest);
+			height++;
+		}
+		root = level[0];
+	}
+
+	template<typename K, typename V, typename Allocator>
+	void BPlusTree<K, V, Allocator>::collect(E* destination) const {
+		for (Leaf* leaf = head; leaf != nullptr; leaf = leaf->next) {
+			destination = std::copy(leaf->entries, leaf->entries + leaf->count, destination);
+		}
+	}
+
+	template<typename K, typename V, typename Allocator>
+	typename BPlusTree<K, V, Allocator>::Leaf* BPlusTree<K, V, Allocator>::allocateLeaf() {
+		Leaf* leaf = createObject<Leaf>(allocator);
+		this->maxCapacity += LEAF_CAPACITY;
+		return leaf;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	void BPlusTree<K, V, Allocator>::deallocateLeaf(Leaf* leaf) noexcept {
+		destroyObject(allocator, leaf);
+		this->maxCapacity -= LEAF_CAPACITY;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	typename BPlusTree<K, V, Allocator>::Inner* BPlusTree<K, V, Allocator>::allocateInner() {
+		return createObject<Inner>(allocator);
+	}
+
+	template<typename K, typename V, typename Allocator>
+	void BPlusTree<K, V, Allocator>::deallocateInner(Inner* inner) noexcept {
+		destroyObject(allocator, inner);
+	}
+
+	template<typename K, typename V, typename Allocator>
+	void BPlusTree<K, V, Allocator>::release(Node* node) noexcept {
+		if (node == nullptr) {
+			return;
+		}
+		if (node->leaf) {
+			deallocateLeaf(static_cast<Leaf*>(node));
+			return;
+		}
+		Inner* inner = static_cast<Inner*>(node);
+		for (size_t i = 0; i <= inner->count; i++) {
+			release(inner->children[i]);
+		}
+		deallocateInner(inner);
+	}
+
+	template<typename K, typename V, typename Allocator>
+	void BPlusTree<K, V, Allocator>::releaseAll() noexcept {
+		if (root == nullptr) {
+			return;
+		}
+		if constexpr (std::is_trivially_destructible_v<Leaf> && std::is_trivially_destructible_v<Inner>) {
+			if (releaseStorage(allocator)) {
+				return;
+			}
+		}
+		release(root);
+	}
+
+	template<typename K, typename V, typename Allocator>
+	[[nodiscard]] bool BPlusTree<K, V, Allocator>::equalTo(const BPlusTree& other) const {
+		if (other.activeCapacity != this->activeCapacity) {
+			return false;
+		}
+		//Equal trees may split their entries differently, so both leaf chains are walked entry by entry
+		const Leaf* mine = head;
+		const Leaf* theirs = other.head;
+		size_t i = 0;
+		size_t j = 0;
+		for (size_t visited = 0; visited < this->activeCapacity; visited++) {
+			while (i == mine->count) {
+				mine = mine->next;
+				i = 0;
+			}
+			while (j == theirs->count) {
+				theirs = theirs->next;
+				j = 0;
+			}
+			if (!(mine->entries[i++] == theirs->entries[j++])) {
+				return false;
+			}
+		}
+		return true;
+	}
+}
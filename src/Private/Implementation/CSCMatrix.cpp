@@ -0,0 +1,275 @@
+#include "../../Public/Implementation/CSCMatrix.h"
+#include <algorithm>
+#include <iterator>
+
+namespace core {
+	template<typename E, typename Allocator>
+	CSCMatrix<E, Allocator>::CSCMatrix() : CSCMatrix(0, 0) {}
+
+	template<typename E, typename Allocator>
+	CSCMatrix<E, Allocator>::CSCMatrix(const Allocator& allocator) : CSCMatrix(0, 0, allocator) {}
+
+	template<typename E, typename Allocator>
+	CSCMatrix<E, Allocator>::CSCMatrix(size_t rows, size_t columns, const Allocator& allocator) : allocator(allocator), transposed(columns, rows, allocator) {
+		this->activeCapacity = rows * columns;
+		this->maxCapacity = rows * columns;
+	}
+
+	template<typename E, typename Allocator>
+	CSCMatrix<E, Allocator>::CSCMatrix(size_t rows, size_t columns, const MatrixTriplet<E>* triplets, size_t count, const Allocator& allocator) :
+		CSCMatrix(rows, columns, allocator) {
+		transposed.build(triplets, count, true);
+	}
+
+	template<typename E, typename Allocator>
+	CSCMatrix<E, Allocator>::CSCMatrix(const CSRMatrix<E, Allocator>& matrix) : CSCMatrix(Adopt{}, matrix.transpose()) {}
+
+	template<typename E, typename Allocator>
+	CSCMatrix<E, Allocator>::CSCMatrix(Adopt, CSRMatrix<E, Allocator>&& transposed) noexcept : allocator(transposed.get_allocator()),
+		transposed(std::move(transposed)) {
+		this->activeCapacity = this->transposed.activeCapacity;
+		this->maxCapacity = this->transposed.maxCapacity;
+	}
+
+	template<typename E, typename Allocator>
+	CSCMatrix<E, Allocator>::CSCMatrix(CSCMatrix&& other) noexcept : allocator(other.allocator), transposed(std::move(other.transposed)) {
+		this->activeCapacity = other.activeCapacity;
+		this->maxCapacity = other.maxCapacity;
+		other.activeCapacity = 0;
+		other.maxCapacity = 0;
+	}
+
+	template<typename E, typename Allocator>
+	CSCMatrix<E, Allocator>& CSCMatrix<E, Allocator>::operator=(CSCMatrix&& other) noexcept(takesStorageOnMove<Allocator>) {
+		if (this != &other) {
+			propagateOnMove(allocator, other.allocator);
+			transposed = std::move(other.transposed);
+			this->activeCapacity = other.activeCapacity;
+			this->maxCapacity = other.maxCapacity;
+			other.activeCapacity = 0;
+			other.maxCapacity = 0;
+		}
+		return *this;
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] size_t CSCMatrix<E, Allocator>::getRows() const {
+		return transposed.columns;
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] size_t CSCMatrix<E, Allocator>::getColumns() const {
+		return transposed.rows;
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] E CSCMatrix<E, Allocator>::get(size_t row, size_t column) const {
+		return transposed.get(column, row);
+	}
+
+	template<typename E, typename Allocator>
+	bool CSCMatrix<E, Allocator>::set(size_t row, size_t column, E value) {
+		return transposed.set(column, row, value);
+	}
+
+	template<typename E, typename Allocator>
+	void CSCMatrix<E, Allocator>::multiply(const E* vector, E* result, unsigned threads) const {
+		transposed.multiplyTransposed(vector, result, threads);
+	}
+
+	template<typename E, typename Allocator>
+	void CSCMatrix<E, Allocator>::multiplyTransposed(const E* vector, E* result, unsigned threads) const {
+		transposed.multiply(vector, result, threads);
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] DenseMatrix<E, Allocator> CSCMatrix<E, Allocator>::multiply(const DenseMatrix<E, Allocator>& dense, unsigned threads) const {
+		if (dense.getRows() != getColumns()) {
+			throw std::invalid_argument("matrix sizes do not match");
+		}
+		const size_t width = dense.getColumns();
+		DenseMatrix<E, Allocator> product(getRows(), width, allocator);
+
+		//Bands are whole vectors wide so that no two threads share one
+		constexpr size_t WIDTH = MatrixLanes<E>::WIDTH;
+		const size_t vectors = std::max<size_t>((width + WIDTH - 1) / WIDTH, 1);
+		const size_t count = std::min(parallelWorkers(threads, getNonZeros() * width, CSRMatrix<E, Allocator>::THREAD_WORK), vectors);
+		parallel(count, [&](size_t worker) {
+			const size_t first = std::min(vectors * worker / count * WIDTH, width);
+			const size_t last = std::min(vectors * (worker + 1) / count * WIDTH, width);
+			if (first == last) {
+				return;
+			}
+			for (size_t column = 0; column < transposed.rows; column++) {
+				const E* source = dense.getRow(column) + first;
+				for (size_t index = transposed.offsets[column]; index < transposed.offsets[column + 1]; index++) {
+					CSRMatrix<E, Allocator>::addScaled(product.getRow(transposed.indices[index]) + first, source, transposed.values[index], last - first);
+				}
+			}
+		});
+		return product;
+	}
+
+	template<typename E, typename Allocator>
+	std::unique_ptr<DataEngine<E>> CSCMatrix<E, Allocator>::clone() const {
+		auto copy = transposed.clone();
+		return std::unique_ptr<CSCMatrix>(new CSCMatrix(Adopt{}, std::move(static_cast<CSRMatrix<E, Allocator>&>(*copy))));
+	}
+
+	template<typename E, typename Allocator>
+	std::unique_ptr<DataEngine<E>> CSCMatrix<E, Allocator>::move() {
+		return std::make_unique<CSCMatrix>(std::move(*this));
+	}
+
+	template<typename E, typename Allocator>
+	bool CSCMatrix<E, Allocator>::removeAll() {
+		if (this->activeCapacity == 0) {
+			return false;
+		}
+		transposed.removeAll();
+		this->activeCapacity = 0;
+		this->maxCapacity = 0;
+		return true;
+	}
+
+	template<typename E, typename Allocator>
+	E* CSCMatrix<E, Allocator>::toArray() const {
+		if (this->activeCapacity == 0) {
+			return nullptr;
+		}
+		const size_t columns = getColumns();
+		std::unique_ptr<E[]> array(new E[this->activeCapacity]());
+		forEach([&](size_t row, size_t column, const E& value) {
+			array[row * columns + column] = value;
+		});
+		return array.release();
+	}
+
+	template<typename E, typename Allocator>
+	E* CSCMatrix<E, Allocator>::toArray(int start, int end) const {
+		if (start < 0 || end <= start || static_cast<size_t>(end) > this->activeCapacity) {
+			return nullptr;
+		}
+		std::unique_ptr<E[]> array(new E[end - start]);
+		copyTo(std::span<E>(array.get(), end - start), start);
+		return array.release();
+	}
+
+	template<typename E, typename Allocator>
+	size_t CSCMatrix<E, Allocator>::copyTo(std::span<E> destination, size_t start) const {
+		if (destination.empty() || start >= this->activeCapacity) {
+			return 0;
+		}
+		const size_t count = std::min(destination.size(), this->activeCapacity - start);
+		const size_t columns = getColumns();
+		std::fill_n(destination.data(), count, E());
+		forEach([&](size_t row, size_t column, const E& value) {
+			const size_t position = row * columns + column;
+			if (position >= start && position < start + count) {
+				destination[position - start] = value;
+			}
+		});
+		return count;
+	}
+
+	template<typename E, typename Allocator>
+	void CSCMatrix<E, Allocator>::reverse() {
+		//Half a turn of the matrix is half a turn of its transpose
+		transposed.reverse();
+	}
+
+	template<typename E, typename Allocator>
+	E* CSCMatrix<E, Allocator>::begin() noexcept {
+		return transposed.begin();
+	}
+
+	template<typename E, typename Allocator>
+	E* CSCMatrix<E, Allocator>::end() noexcept {
+		return transposed.end();
+	}
+
+	template<typename E, typename Allocator>
+	const E* CSCMatrix<E, Allocator>::begin() const noexcept {
+		return transposed.begin();
+	}
+
+	template<typename E, typename Allocator>
+	const E* CSCMatrix<E, Allocator>::end() const noexcept {
+		return transposed.end();
+	}
+
+	template<typename E, typename Allocator>
+	std::span<E> CSCMatrix<E, Allocator>::view() noexcept {
+		return transposed.view();
+	}
+
+	template<typename E, typename Allocator>
+	std::span<const E> CSCMatrix<E, Allocator>::view() const noexcept {
+		return transposed.view();
+	}
+
+	template<typename E, typename Allocator>
+	void CSCMatrix<E, Allocator>::grow() {}
+
+	template<typename E, typename Allocator>
+	void CSCMatrix<E, Allocator>::shrink() {}
+
+	template<typename E, typename Allocator>
+	void CSCMatrix<E, Allocator>::compress() {}
+
+	template<typename E, typename Allocator>
+	bool CSCMatrix<E, Allocator>::equalsInternal(const DataEngine<E>& de) const {
+		auto other = dynamic_cast<const Matrix<E>*>(&de);
+		if (other == nullptr || other->getRows() != getRows() || other->getColumns() != getColumns()) {
+			return false;
+		}
+		size_t theirs = 0;
+		bool matched = true;
+		CSRMatrix<E, Allocator>::visitNonZeros(*other, 0, getRows(), [&](size_t row, size_t column, const E& value) {
+			theirs++;
+			matched = matched && get(row, column) == value;
+		});
+		const auto& values = transposed.values;
+		return matched && theirs == static_cast<size_t>(std::count_if(values.begin(), values.end(), [](const E& value) { return value != E(); }));
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] bool CSCMatrix<E, Allocator>::equivalenceInternal(const DataEngine<E>& de) const {
+		auto other = dynamic_cast<const Matrix<E>*>(&de);
+		if (other == nullptr || other->getActiveSize() != this->activeCapacity) {
+			return false;
+		}
+		const auto& values = transposed.values;
+		std::vector<E> mine;
+		std::copy_if(values.begin(), values.end(), std::back_inserter(mine), [](const E& value) { return value != E(); });
+		std::vector<E> theirs;
+		CSRMatrix<E, Allocator>::visitNonZeros(*other, 0, other->getRows(), [&](size_t, size_t, const E& value) {
+			theirs.push_back(value);
+		});
+		std::sort(mine.begin(), mine.end());
+		std::sort(theirs.begin(), theirs.end());
+		return mine == theirs;
+	}
+
+	template<typename E, typename Allocator>
+	std::unique_ptr<DataEngine<E>> CSCMatrix<E, Allocator>::mergeInternal(const DataEngine<E>& de, int start, int end) const {
+		auto other = dynamic_cast<const Matrix<E>*>(&de);
+		if (other == nullptr || start < 0 || end < start || static_cast<size_t>(end) > other->getRows()) {
+			return nullptr;
+		}
+		const size_t rows = getRows();
+		const size_t width = rows == 0 ? other->getColumns() : getColumns();
+		if (other->getColumns() != width) {
+			return nullptr;
+		}
+		std::vector<MatrixTriplet<E>> triplets;
+		triplets.reserve(getNonZeros());
+		forEach([&](size_t row, size_t column, const E& value) {
+			triplets.push_back({ row, column, value });
+		});
+		CSRMatrix<E, Allocator>::visitNonZeros(*other, start, end, [&](size_t row, size_t column, const E& value) {
+			triplets.push_back({ rows + row - start, column, value });
+		});
+		return std::unique_ptr<DataEngine<E>>(new CSCMatrix(rows + (end - start), width, triplets.data(), triplets.size(), allocator));
+	}
+}
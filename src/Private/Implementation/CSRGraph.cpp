@@ -0,0 +1,845 @@
+#include "../../Public/Implementation/CSRGraph.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <map>
+#include <numeric>
+#include <random>
+#include <unordered_map>
+
+namespace core {
+	template<typename E, typename Allocator>
+	CSRGraph<E, Allocator>::CSRGraph() : CSRGraph(Allocator()) {}
+
+	template<typename E, typename Allocator>
+	CSRGraph<E, Allocator>::CSRGraph(const Allocator& allocator) : allocator(allocator), vertices(0), directed(true), weighted(false),
+		offsets(1, 0, allocator), targets(allocator), weights(allocator), reverseOffsets(1, 0, allocator), reverseTargets(allocator),
+		reverseWeights(allocator) {
+		this->activeCapacity = 0;
+		this->maxCapacity = 0;
+	}
+
+	template<typename E, typename Allocator>
+	CSRGraph<E, Allocator>::CSRGraph(size_t vertices, const GraphEdge<E>* edges, size_t count, bool directed, unsigned threads,
+		const Allocator& allocator) : allocator(allocator), vertices(vertices), directed(directed), weighted(false), offsets(allocator),
+		targets(allocator), weights(allocator), reverseOffsets(allocator), reverseTargets(allocator), reverseWeights(allocator) {
+		build(edges, count, threads);
+	}
+
+	template<typename E, typename Allocator>
+	CSRGraph<E, Allocator>::CSRGraph(size_t vertices, const WeightedGraphEdge<E>* edges, size_t count, bool directed, unsigned threads,
+		const Allocator& allocator) : allocator(allocator), vertices(vertices), directed(directed), weighted(true), offsets(allocator),
+		targets(allocator), weights(allocator), reverseOffsets(allocator), reverseTargets(allocator), reverseWeights(allocator) {
+		build(edges, count, threads);
+	}
+
+	template<typename E, typename Allocator>
+	CSRGraph<E, Allocator>::CSRGraph(CSRGraph&& other) noexcept : allocator(other.allocator), vertices(other.vertices), directed(other.directed), weighted(other.weighted),
+		offsets(std::move(other.offsets)), targets(std::move(other.targets)), weights(std::move(other.weights)),
+		reverseOffsets(std::move(other.reverseOffsets)), reverseTargets(std::move(other.reverseTargets)),
+		reverseWeights(std::move(other.reverseWeights)) {
+		this->activeCapacity = other.activeCapacity;
+		this->maxCapacity = other.maxCapacity;
+		other.vertices = 0;
+		other.activeCapacity = 0;
+		other.maxCapacity = 0;
+	}
+
+	template<typename E, typename Allocator>
+	CSRGraph<E, Allocator>& CSRGraph<E, Allocator>::operator=(CSRGraph&& other) noexcept(takesStorageOnMove<Allocator>) {
+		if (this != &other) {
+			propagateOnMove(allocator, other.allocator);
+			vertices = other.vertices;
+			directed = other.directed;
+			weighted = other.weighted;
+			offsets = std::move(other.offsets);
+			targets = std::move(other.targets);
+			weights = std::move(other.weights);
+			reverseOffsets = std::move(other.reverseOffsets);
+			reverseTargets = std::move(other.reverseTargets);
+			reverseWeights = std::move(other.reverseWeights);
+			this->activeCapacity = other.activeCapacity;
+			this->maxCapacity = other.maxCapacity;
+			other.vertices = 0;
+			other.activeCapacity = 0;
+			other.maxCapacity = 0;
+		}
+		return *this;
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] size_t CSRGraph<E, Allocator>::getVertices() const {
+		return vertices;
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] bool CSRGraph<E, Allocator>::isDirected() const {
+		return directed;
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] size_t CSRGraph<E, Allocator>::getDegree(E vertex) const {
+		if (vertex >= vertices) {
+			throw std::out_of_range("vertex out of range");
+		}
+		return offsets[vertex + 1] - offsets[vertex];
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] bool CSRGraph<E, Allocator>::containsEdge(E source, E target) const {
+		if (source >= vertices || target >= vertices) {
+			throw std::out_of_range("vertex out of range");
+		}
+		auto arcs = neighbors(source);
+		return std::binary_search(arcs.begin(), arcs.end(), target);
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] std::vector<E> CSRGraph<E, Allocator>::getNeighbors(E vertex) const {
+		if (vertex >= vertices) {
+			throw std::out_of_range("vertex out of range");
+		}
+		auto arcs = neighbors(vertex);
+		return std::vector<E>(arcs.begin(), arcs.end());
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] CSRGraph<E, Allocator> CSRGraph<E, Allocator>::transpose() const {
+		CSRGraph transposed(allocator);
+		transposed.vertices = vertices;
+		transposed.directed = directed;
+		transposed.weighted = weighted;
+		if (directed) {
+			transposed.offsets = reverseOffsets;
+			transposed.targets = reverseTargets;
+			transposed.weights = reverseWeights;
+			transposed.reverseOffsets = offsets;
+			transposed.reverseTargets = targets;
+			transposed.reverseWeights = weights;
+		}
+		else {
+			transposed.offsets = offsets;
+			transposed.targets = targets;
+			transposed.weights = weights;
+			transposed.reverseOffsets.clear();
+		}
+		transposed.activeCapacity = transposed.targets.size();
+		transposed.maxCapacity = transposed.targets.size();
+		return transposed;
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] std::vector<E> CSRGraph<E, Allocator>::breadthFirst(E source, unsigned threads) const {
+		if (source >= vertices) {
+			throw std::out_of_range("vertex out of range");
+		}
+		std::vector<E> parents(vertices, NONE);
+		parents[source] = source;
+		std::vector<E> frontier{ source };
+		std::vector<E> next;
+		std::vector<uint64_t> bitmap;
+		std::vector<uint64_t> nextBitmap;
+		size_t unchecked = targets.size();
+		size_t scout = offsets[source + 1] - offsets[source];
+		while (!frontier.empty()) {
+			if (scout > unchecked / ALPHA) {
+				const size_t words = (vertices + 63) / 64;
+				bitmap.resize(words);
+				nextBitmap.resize(words);
+				toBitmap(frontier, bitmap, threads);
+				size_t awake = frontier.size();
+				size_t previous;
+				do {
+					previous = awake;
+					awake = bottomUp(parents, bitmap, nextBitmap, threads);
+					bitmap.swap(nextBitmap);
+				} while (awake >= previous || awake > vertices / BETA);
+				toQueue(bitmap, frontier, threads);
+				scout = 1;
+			}
+			else {
+				unchecked -= std::min(scout, unchecked);
+				scout = topDown(parents, frontier, next, scout, threads);
+				frontier.swap(next);
+			}
+		}
+		return parents;
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] std::vector<double> CSRGraph<E, Allocator>::shortestPaths(E source, double delta, unsigned threads, std::vector<GraphPhase>* phases) const {
+		if (source >= vertices) {
+			throw std::out_of_range("vertex out of range");
+		}
+		if (!(delta > 0)) {
+			throw std::invalid_argument("bucket width must be positive");
+		}
+		if (phases != nullptr) {
+			phases->clear();
+		}
+		auto mark = std::chrono::steady_clock::now();
+		std::vector<double> distances(vertices, std::numeric_limits<double>::infinity());
+		distances[source] = 0;
+
+		//The buckets of each worker are kept by worker index, so that they outlive the threads of a round.
+		//They are sparse and keyed by the index of the bucket as a double, which stays defined however
+		//long the paths are compared to the bucket width
+		const size_t most = workers(threads, targets.size());
+		std::vector<std::map<double, std::vector<E>>> buckets(most);
+		const double degree = vertices == 0 ? 0 : static_cast<double>(targets.size()) / vertices;
+		std::vector<E> frontier{ source };
+		double bucket = 0;
+		record(phases, "initialize", mark);
+		while (!frontier.empty()) {
+			const size_t count = std::min(most, workers(threads, static_cast<size_t>(frontier.size() * degree)));
+			const bool shared = count > 1;
+			std::atomic<size_t> cursor = 0;
+			parallel(count, [&](size_t worker) {
+				auto& own = buckets[worker];
+				for (size_t first; (first = cursor.fetch_add(FRONTIER_CHUNK, std::memory_order_relaxed)) < frontier.size();) {
+					const size_t last = std::min(first + FRONTIER_CHUNK, frontier.size());
+					for (size_t i = first; i < last; i++) {
+						const E vertex = frontier[i];
+						const double distance = shared ? std::atomic_ref<double>(distances[vertex]).load(std::memory_order_relaxed) : distances[vertex];
+						//Already relaxed from a lower bucket
+						if (std::floor(distance / delta) < bucket) {
+							continue;
+						}
+						for (size_t index = offsets[vertex]; index < offsets[vertex + 1]; index++) {
+							const E target = targets[index];
+							const double candidate = distance + (weighted ? weights[index] : 1.0f);
+							bool improved = false;
+							if (shared) {
+								std::atomic_ref<double> slot(distances[target]);
+								double current = slot.load(std::memory_order_relaxed);
+								while (candidate < current && !(improved = slot.compare_exchange_weak(current, candidate, std::memory_order_relaxed))) {}
+							}
+							else if (candidate < distances[target]) {
+								distances[target] = candidate;
+								improved = true;
+							}
+							if (improved) {
+								own[std::floor(candidate / delta)].push_back(target);
+							}
+						}
+					}
+				}
+			});
+			record(phases, "relax", mark);
+
+			//The lowest bucket left, which is the current one again if a light arc refilled it. Buckets are
+			//erased once emptied, so the first one of each worker is never empty
+			double lowest = std::numeric_limits<double>::infinity();
+			for (const auto& own : buckets) {
+				if (!own.empty()) {
+					lowest = std::min(lowest, own.begin()->first);
+				}
+			}
+			frontier.clear();
+			for (auto& own : buckets) {
+				if (!own.empty() && own.begin()->first == lowest) {
+					frontier.insert(frontier.end(), own.begin()->second.begin(), own.begin()->second.end());
+					own.erase(own.begin());
+				}
+			}
+			bucket = lowest;
+			record(phases, "bucket", mark);
+		}
+		return distances;
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] std::vector<E> CSRGraph<E, Allocator>::components(unsigned threads, std::vector<GraphPhase>* phases) const {
+		if (phases != nullptr) {
+			phases->clear();
+		}
+		auto mark = std::chrono::steady_clock::now();
+		std::vector<E> labels(vertices);
+		std::iota(labels.begin(), labels.end(), E(0));
+		const size_t count = workers(threads, vertices + targets.size());
+
+		//Links the first arcs of every vertex, which usually joins most of the largest component
+		for (size_t round = 0; round < SAMPLED_ARCS; round++) {
+			std::atomic<size_t> cursor = 0;
+			parallel(count, [&](size_t) {
+				for (size_t first; (first = cursor.fetch_add(CHUNK, std::memory_order_relaxed)) < vertices;) {
+					const size_t last = std::min(first + CHUNK, vertices);
+					for (size_t vertex = first; vertex < last; vertex++) {
+						if (offsets[vertex] + round < offsets[vertex + 1]) {
+							link(labels, static_cast<E>(vertex), targets[offsets[vertex] + round]);
+						}
+					}
+				}
+			});
+			compressLabels(labels, threads);
+		}
+		record(phases, "sample", mark);
+
+		//The most frequent label among a sample of the vertices
+		E largest = 0;
+		if (vertices > 0) {
+			std::mt19937_64 random(vertices);
+			std::unordered_map<E, size_t> frequencies;
+			size_t best = 0;
+			for (size_t i = 0; i < SAMPLED_VERTICES; i++) {
+				const E label = labels[random() % vertices];
+				if (++frequencies[label] > best) {
+					best = frequencies[label];
+					largest = label;
+				}
+			}
+		}
+		record(phases, "identify", mark);
+
+		//Every arc touching a vertex outside the largest component is linked from that vertex: its
+		//remaining arcs, and for a directed graph the arcs entering it
+		std::atomic<size_t> cursor = 0;
+		parallel(count, [&](size_t) {
+			for (size_t first; (first = cursor.fetch_add(CHUNK, std::memory_order_relaxed)) < vertices;) {
+				const size_t last = std::min(first + CHUNK, vertices);
+				for (size_t vertex = first; vertex < last; vertex++) {
+					if (std::atomic_ref<E>(labels[vertex]).load(std::memory_order_relaxed) == largest) {
+						continue;
+					}
+					for (size_t index = offsets[vertex] + SAMPLED_ARCS; index < offsets[vertex + 1]; index++) {
+						link(labels, static_cast<E>(vertex), targets[index]);
+					}
+					if (directed) {
+						for (E predecessor : predecessors(static_cast<E>(vertex))) {
+							link(labels, static_cast<E>(vertex), predecessor);
+						}
+					}
+				}
+			}
+		});
+		record(phases, "link", mark);
+		compressLabels(labels, threads);
+		record(phases, "compress", mark);
+		return labels;
+	}
+
+	template<typename E, typename Allocator>
+	std::unique_ptr<DataEngine<E>> CSRGraph<E, Allocator>::clone() const {
+		auto copy = std::make_unique<CSRGraph>(allocator);
+		copy->vertices = vertices;
+		copy->directed = directed;
+		copy->weighted = weighted;
+		copy->offsets = offsets;
+		copy->targets = targets;
+		copy->weights = weights;
+		copy->reverseOffsets = reverseOffsets;
+		copy->reverseTargets = reverseTargets;
+		copy->reverseWeights = reverseWeights;
+		copy->activeCapacity = this->activeCapacity;
+		copy->maxCapacity = this->maxCapacity;
+		return copy;
+	}
+
+	template<typename E, typename Allocator>
+	std::unique_ptr<DataEngine<E>> CSRGraph<E, Allocator>::move() {
+		return std::make_unique<CSRGraph>(std::move(*this));
+	}
+
+	template<typename E, typename Allocator>
+	bool CSRGraph<E, Allocator>::removeAll() {
+		throw std::logic_error("removeAll on an immutable graph");
+	}
+
+	template<typename E, typename Allocator>
+	E* CSRGraph<E, Allocator>::toArray() const {
+		if (targets.empty()) {
+			return nullptr;
+		}
+		std::unique_ptr<E[]> array(new E[targets.size()]);
+		std::copy(targets.begin(), targets.end(), array.get());
+		return array.release();
+	}
+
+	template<typename E, typename Allocator>
+	E* CSRGraph<E, Allocator>::toArray(int start, int end) const {
+		if (start < 0 || end <= start || static_cast<size_t>(end) > targets.size()) {
+			return nullptr;
+		}
+		std::unique_ptr<E[]> array(new E[end - start]);
+		copyTo(std::span<E>(array.get(), end - start), start);
+		return array.release();
+	}
+
+	template<typename E, typename Allocator>
+	size_t CSRGraph<E, Allocator>::copyTo(std::span<E> destination, size_t start) const {
+		if (destination.empty() || start >= targets.size()) {
+			return 0;
+		}
+		const size_t count = std::min(destination.size(), targets.size() - start);
+		std::copy_n(targets.begin() + start, count, destination.begin());
+		return count;
+	}
+
+	template<typename E, typename Allocator>
+	void CSRGraph<E, Allocator>::reverse() {
+		throw std::logic_error("reverse on an immutable graph, use transpose");
+	}
+
+	template<typename E, typename Allocator>
+	const E* CSRGraph<E, Allocator>::begin() const noexcept {
+		return targets.data();
+	}
+
+	template<typename E, typename Allocator>
+	const E* CSRGraph<E, Allocator>::end() const noexcept {
+		return targets.data() + targets.size();
+	}
+
+	template<typename E, typename Allocator>
+	std::span<const E> CSRGraph<E, Allocator>::view() const noexcept {
+		return targets;
+	}
+
+	template<typename E, typename Allocator>
+	void CSRGraph<E, Allocator>::grow() {}
+
+	template<typename E, typename Allocator>
+	void CSRGraph<E, Allocator>::shrink() {}
+
+	template<typename E, typename Allocator>
+	void CSRGraph<E, Allocator>::compress() {}
+
+	template<typename E, typename Allocator>
+	bool CSRGraph<E, Allocator>::equalsInternal(const DataEngine<E>& de) const {
+		auto other = dynamic_cast<const Graph<E>*>(&de);
+		if (other == nullptr || other->getVertices() != vertices || other->getActiveSize() != targets.size()) {
+			return false;
+		}
+		if (auto graph = dynamic_cast<const CSRGraph*>(other)) {
+			return equalTo(*graph);
+		}
+		for (size_t vertex = 0; vertex < vertices; vertex++) {
+			auto mine = neighbors(static_cast<E>(vertex));
+			auto theirs = other->getNeighbors(static_cast<E>(vertex));
+			if (!std::equal(mine.begin(), mine.end(), theirs.begin(), theirs.end())) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] bool CSRGraph<E, Allocator>::equivalenceInternal(const DataEngine<E>& de) const {
+		auto other = dynamic_cast<const Graph<E>*>(&de);
+		if (other == nullptr || other->getVertices() != vertices || other->getActiveSize() != targets.size()) {
+			return false;
+		}
+		for (size_t vertex = 0; vertex < vertices; vertex++) {
+			auto mine = neighbors(static_cast<E>(vertex));
+			auto theirs = other->getNeighbors(static_cast<E>(vertex));
+			std::sort(theirs.begin(), theirs.end());
+			if (!std::equal(mine.begin(), mine.end(), theirs.begin(), theirs.end())) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	template<typename E, typename Allocator>
+	std::unique_ptr<DataEngine<E>> CSRGraph<E, Allocator>::mergeInternal(const DataEngine<E>& de, int start, int end) const {
+		auto other = dynamic_cast<const Graph<E>*>(&de);
+		if (other == nullptr || start < 0 || end < start || static_cast<size_t>(end) > other->getVertices()) {
+			return nullptr;
+		}
+		const size_t size = std::max(vertices, other->getVertices());
+		if (!weighted) {
+			std::vector<GraphEdge<E>> edges;
+			edges.reserve(targets.size());
+			for (size_t vertex = 0; vertex < vertices; vertex++) {
+				for (E target : neighbors(static_cast<E>(vertex))) {
+					edges.push_back({ static_cast<E>(vertex), target });
+				}
+			}
+			for (int vertex = start; vertex < end; vertex++) {
+				for (E target : other->getNeighbors(static_cast<E>(vertex))) {
+					edges.push_back({ static_cast<E>(vertex), target });
+				}
+			}
+			return std::unique_ptr<DataEngine<E>>(new CSRGraph(size, edges.data(), edges.size(), directed, 1, allocator));
+		}
+
+		//The arcs of an unweighted graph weigh one
+		std::vector<WeightedGraphEdge<E>> edges;
+		edges.reserve(targets.size());
+		for (size_t index = 0, vertex = 0; vertex < vertices; vertex++) {
+			for (; index < offsets[vertex + 1]; index++) {
+				edges.push_back({ static_cast<E>(vertex), targets[index], weights[index] });
+			}
+		}
+		auto graph = dynamic_cast<const CSRGraph*>(other);
+		for (int vertex = start; vertex < end; vertex++) {
+			auto arcs = other->getNeighbors(static_cast<E>(vertex));
+			for (size_t i = 0; i < arcs.size(); i++) {
+				const float weight = graph != nullptr && graph->weighted ? graph->neighborWeights(static_cast<E>(vertex))[i] : 1.0f;
+				edges.push_back({ static_cast<E>(vertex), arcs[i], weight });
+			}
+		}
+		return std::unique_ptr<DataEngine<E>>(new CSRGraph(size, edges.data(), edges.size(), directed, 1, allocator));
+	}
+
+	template<typename E, typename Allocator>
+	template<typename Edge>
+	void CSRGraph<E, Allocator>::build(const Edge* edges, size_t count, unsigned threads) {
+		if (vertices > NONE) {
+			throw std::length_error("too many vertices for the identifier type");
+		}
+		build(vertices, edges, count, false, !directed, threads, offsets, targets, weights);
+		if (directed) {
+			build(vertices, edges, count, true, false, threads, reverseOffsets, reverseTargets, reverseWeights);
+		}
+		this->activeCapacity = targets.size();
+		this->maxCapacity = targets.size();
+	}
+
+	template<typename E, typename Allocator>
+	template<typename Edge>
+	void CSRGraph<E, Allocator>::build(size_t vertices, const Edge* edges, size_t count, bool reversed, bool symmetric,
+		unsigned threads, EngineVector<size_t, Allocator>& offsets, EngineVector<E, Allocator>& targets,
+		EngineVector<float, Allocator>& weights) {
+		constexpr bool WEIGHTED = std::is_same_v<Edge, WeightedGraphEdge<E>>;
+		const size_t arcs = symmetric ? 2 * count : count;
+		const size_t workerCount = workers(threads, arcs);
+		const bool shared = workerCount > 1;
+
+		//Out-degrees, counted one slot to the right of their vertex
+		offsets.assign(vertices + 1, 0);
+		std::atomic<bool> outside = false;
+		std::atomic<bool> negative = false;
+		auto increment = [&](size_t& counter) {
+			return shared ? std::atomic_ref<size_t>(counter).fetch_add(1, std::memory_order_relaxed) : counter++;
+		};
+		parallel(workerCount, [&](size_t worker) {
+			const size_t last = count * (worker + 1) / workerCount;
+			for (size_t i = count * worker / workerCount; i < last; i++) {
+				const size_t source = edges[i].source;
+				const size_t target = edges[i].target;
+				if (source >= vertices || target >= vertices) {
+					outside.store(true, std::memory_order_relaxed);
+					return;
+				}
+				if constexpr (WEIGHTED) {
+					if (!(edges[i].weight >= 0) || !std::isfinite(edges[i].weight)) {
+						negative.store(true, std::memory_order_relaxed);
+						return;
+					}
+				}
+				increment(offsets[(reversed ? target : source) + 1]);
+				if (symmetric) {
+					increment(offsets[target + 1]);
+				}
+			}
+		});
+		if (outside.load()) {
+			throw std::out_of_range("edge end is not a vertex");
+		}
+		if (negative.load()) {
+			throw std::invalid_argument("edge weight is negative or not finite");
+		}
+		prefixSum(offsets, workerCount);
+
+		//Scatter, each arc taking the next free slot of its vertex
+		targets.resize(offsets[vertices]);
+		if constexpr (WEIGHTED) {
+			weights.resize(offsets[vertices]);
+		}
+		std::vector<size_t> next(offsets.begin(), offsets.end() - 1);
+		auto place = [&](E source, E target, const Edge& edge) {
+			const size_t slot = increment(next[source]);
+			targets[slot] = target;
+			if constexpr (WEIGHTED) {
+				weights[slot] = edge.weight;
+			}
+		};
+		parallel(workerCount, [&](size_t worker) {
+			const size_t last = count * (worker + 1) / workerCount;
+			for (size_t i = count * worker / workerCount; i < last; i++) {
+				const E source = reversed ? edges[i].target : edges[i].source;
+				const E target = reversed ? edges[i].source : edges[i].target;
+				place(source, target, edges[i]);
+				if (symmetric) {
+					place(target, source, edges[i]);
+				}
+			}
+		});
+
+		//Sorts the arcs of each vertex and counts the distinct ones, in chunks claimed as the threads go.
+		//Weighted arcs are sorted by weight as well, so that the lightest of repeated arcs comes first
+		std::atomic<size_t> cursor = 0;
+		parallel(workerCount, [&](size_t) {
+			std::vector<std::pair<E, float>> scratch;
+			for (size_t first; (first = cursor.fetch_add(CHUNK, std::memory_order_relaxed)) < vertices;) {
+				const size_t last = std::min(first + CHUNK, vertices);
+				for (size_t vertex = first; vertex < last; vertex++) {
+					if constexpr (WEIGHTED) {
+						scratch.clear();
+						for (size_t index = offsets[vertex]; index < offsets[vertex + 1]; index++) {
+							scratch.emplace_back(targets[index], weights[index]);
+						}
+						std::sort(scratch.begin(), scratch.end());
+						auto unique = std::unique(scratch.begin(), scratch.end(), [](const auto& a, const auto& b) { return a.first == b.first; });
+						next[vertex] = unique - scratch.begin();
+						for (size_t i = 0; i < next[vertex]; i++) {
+							targets[offsets[vertex] + i] = scratch[i].first;
+							weights[offsets[vertex] + i] = scratch[i].second;
+						}
+					}
+					else {
+						auto begin = targets.begin() + offsets[vertex];
+						auto end = targets.begin() + offsets[vertex + 1];
+						std::sort(begin, end);
+						next[vertex] = std::unique(begin, end) - begin;
+					}
+				}
+			}
+		});
+
+		//Repeated arcs were left at the end of their vertex, the others move down to close the gaps
+		EngineVector<size_t, Allocator> distinct(vertices + 1, 0, offsets.get_allocator());
+		std::copy(next.begin(), next.end(), distinct.begin() + 1);
+		prefixSum(distinct, workerCount);
+		if (distinct[vertices] != offsets[vertices]) {
+			EngineVector<E, Allocator> packed(distinct[vertices], targets.get_allocator());
+			EngineVector<float, Allocator> packedWeights(WEIGHTED ? distinct[vertices] : 0, weights.get_allocator());
+			parallel(workerCount, [&](size_t worker) {
+				const size_t last = vertices * (worker + 1) / workerCount;
+				for (size_t vertex = vertices * worker / workerCount; vertex < last; vertex++) {
+					std::copy_n(targets.begin() + offsets[vertex], next[vertex], packed.begin() + distinct[vertex]);
+					if constexpr (WEIGHTED) {
+						std::copy_n(weights.begin() + offsets[vertex], next[vertex], packedWeights.begin() + distinct[vertex]);
+					}
+				}
+			});
+			targets = std::move(packed);
+			weights = std::move(packedWeights);
+			offsets = std::move(distinct);
+		}
+	}
+
+	template<typename E, typename Allocator>
+	void CSRGraph<E, Allocator>::prefixSum(EngineVector<size_t, Allocator>& offsets, size_t count) {
+		const size_t size = offsets.size() - 1;
+		if (count == 1) {
+			for (size_t i = 1; i <= size; i++) {
+				offsets[i] += offsets[i - 1];
+			}
+			return;
+		}
+		//Each thread sums its block, then scans it from the total of the blocks before
+		std::vector<size_t> totals(count + 1, 0);
+		parallel(count, [&](size_t worker) {
+			const size_t last = 1 + size * (worker + 1) / count;
+			size_t total = 0;
+			for (size_t i = 1 + size * worker / count; i < last; i++) {
+				total += offsets[i];
+			}
+			totals[worker + 1] = total;
+		});
+		for (size_t worker = 0; worker < count; worker++) {
+			totals[worker + 1] += totals[worker];
+		}
+		parallel(count, [&](size_t worker) {
+			const size_t last = 1 + size * (worker + 1) / count;
+			size_t running = totals[worker];
+			for (size_t i = 1 + size * worker / count; i < last; i++) {
+				running += offsets[i];
+				offsets[i] = running;
+			}
+		});
+	}
+
+	template<typename E, typename Allocator>
+	size_t CSRGraph<E, Allocator>::topDown(std::vector<E>& parents, const std::vector<E>& frontier, std::vector<E>& next, size_t work, unsigned threads) const {
+		const size_t count = workers(threads, work);
+		if (count == 1) {
+			size_t scout = 0;
+			next.clear();
+			for (E vertex : frontier) {
+				for (E target : neighbors(vertex)) {
+					if (parents[target] == NONE) {
+						parents[target] = vertex;
+						next.push_back(target);
+						scout += offsets[target + 1] - offsets[target];
+					}
+				}
+			}
+			return scout;
+		}
+
+		std::vector<size_t> scouts(count, 0);
+		std::atomic<size_t> cursor = 0;
+		collect(count, next, [&](size_t worker, std::vector<E>& claimed) {
+			size_t scout = 0;
+			for (size_t first; (first = cursor.fetch_add(FRONTIER_CHUNK, std::memory_order_relaxed)) < frontier.size();) {
+				const size_t last = std::min(first + FRONTIER_CHUNK, frontier.size());
+				for (size_t i = first; i < last; i++) {
+					const E vertex = frontier[i];
+					for (E target : neighbors(vertex)) {
+						std::atomic_ref<E> parent(parents[target]);
+						E expected = NONE;
+						if (parent.load(std::memory_order_relaxed) == NONE && parent.compare_exchange_strong(expected, vertex, std::memory_order_relaxed)) {
+							claimed.push_back(target);
+							scout += offsets[target + 1] - offsets[target];
+						}
+					}
+				}
+			}
+			scouts[worker] = scout;
+		});
+		size_t scout = 0;
+		for (size_t value : scouts) {
+			scout += value;
+		}
+		return scout;
+	}
+
+	template<typename E, typename Allocator>
+	size_t CSRGraph<E, Allocator>::bottomUp(std::vector<E>& parents, const std::vector<uint64_t>& frontier, std::vector<uint64_t>& next, unsigned threads) const {
+		std::fill(next.begin(), next.end(), 0);
+		const size_t* entering = (directed ? reverseOffsets : offsets).data();
+		const E* sources = (directed ? reverseTargets : targets).data();
+		const size_t count = workers(threads, vertices + targets.size());
+		std::vector<size_t> awake(count, 0);
+		std::atomic<size_t> cursor = 0;
+		parallel(count, [&](size_t worker) {
+			size_t found = 0;
+			for (size_t first; (first = cursor.fetch_add(CHUNK, std::memory_order_relaxed)) < vertices;) {
+				const size_t last = std::min(first + CHUNK, vertices);
+				for (size_t vertex = first; vertex < last; vertex++) {
+					if (parents[vertex] != NONE) {
+						continue;
+					}
+					for (size_t index = entering[vertex]; index < entering[vertex + 1]; index++) {
+						const E source = sources[index];
+						if (frontier[source >> 6] >> (source & 63) & 1) {
+							parents[vertex] = source;
+							next[vertex >> 6] |= uint64_t(1) << (vertex & 63);
+							found++;
+							break;
+						}
+					}
+				}
+			}
+			awake[worker] = found;
+		});
+		size_t total = 0;
+		for (size_t value : awake) {
+			total += value;
+		}
+		return total;
+	}
+
+	template<typename E, typename Allocator>
+	void CSRGraph<E, Allocator>::toBitmap(const std::vector<E>& frontier, std::vector<uint64_t>& bitmap, unsigned threads) const {
+		std::fill(bitmap.begin(), bitmap.end(), 0);
+		const size_t count = workers(threads, frontier.size());
+		parallel(count, [&](size_t worker) {
+			const size_t last = frontier.size() * (worker + 1) / count;
+			for (size_t i = frontier.size() * worker / count; i < last; i++) {
+				const uint64_t bit = uint64_t(1) << (frontier[i] & 63);
+				if (count == 1) {
+					bitmap[frontier[i] >> 6] |= bit;
+				}
+				else {
+					std::atomic_ref<uint64_t>(bitmap[frontier[i] >> 6]).fetch_or(bit, std::memory_order_relaxed);
+				}
+			}
+		});
+	}
+
+	template<typename E, typename Allocator>
+	void CSRGraph<E, Allocator>::toQueue(const std::vector<uint64_t>& bitmap, std::vector<E>& frontier, unsigned threads) const {
+		const size_t count = workers(threads, vertices);
+		collect(count, frontier, [&](size_t worker, std::vector<E>& found) {
+			const size_t last = bitmap.size() * (worker + 1) / count;
+			for (size_t word = bitmap.size() * worker / count; word < last; word++) {
+				for (uint64_t bits = bitmap[word]; bits != 0; bits &= bits - 1) {
+					found.push_back(static_cast<E>(word * 64 + std::countr_zero(bits)));
+				}
+			}
+		});
+	}
+
+	template<typename E, typename Allocator>
+	void CSRGraph<E, Allocator>::link(std::vector<E>& labels, E first, E second) noexcept {
+		auto load = [&](E vertex) { return std::atomic_ref<E>(labels[vertex]).load(std::memory_order_relaxed); };
+		E a = load(first);
+		E b = load(second);
+		while (a != b) {
+			const E high = std::max(a, b);
+			const E low = std::min(a, b);
+			E parent = load(high);
+			if (parent == low) {
+				return;
+			}
+			//Only a root is hung, if high has a parent meanwhile the walk goes on from there
+			if (parent == high && std::atomic_ref<E>(labels[high]).compare_exchange_strong(parent, low, std::memory_order_relaxed)) {
+				return;
+			}
+			a = load(load(high));
+			b = load(low);
+		}
+	}
+
+	template<typename E, typename Allocator>
+	void CSRGraph<E, Allocator>::compressLabels(std::vector<E>& labels, unsigned threads) const {
+		const size_t count = workers(threads, vertices);
+		parallel(count, [&](size_t worker) {
+			const size_t last = vertices * (worker + 1) / count;
+			for (size_t vertex = vertices * worker / count; vertex < last; vertex++) {
+				std::atomic_ref<E> label(labels[vertex]);
+				for (E parent = label.load(std::memory_order_relaxed), grandparent; parent != (grandparent = std::atomic_ref<E>(labels[parent]).load(std::memory_order_relaxed)); parent = grandparent) {
+					label.store(grandparent, std::memory_order_relaxed);
+				}
+			}
+		});
+	}
+
+	template<typename E, typename Allocator>
+	void CSRGraph<E, Allocator>::record(std::vector<GraphPhase>* phases, const char* name, std::chrono::steady_clock::time_point& mark) {
+		if (phases == nullptr) {
+			return;
+		}
+		const auto now = std::chrono::steady_clock::now();
+		const double seconds = std::chrono::duration<double>(now - mark).count();
+		mark = now;
+		for (auto& phase : *phases) {
+			if (phase.name == name) {
+				phase.seconds += seconds;
+				return;
+			}
+		}
+		phases->push_back({ name, seconds });
+	}
+
+	template<typename E, typename Allocator>
+	template<typename Producer>
+	void CSRGraph<E, Allocator>::collect(size_t count, std::vector<E>& output, Producer&& producer) {
+		if (count == 1) {
+			output.clear();
+			producer(0, output);
+			return;
+		}
+		std::vector<std::vector<E>> buffers(count);
+		parallel(count, [&](size_t worker) {
+			producer(worker, buffers[worker]);
+		});
+		std::vector<size_t> starts(count + 1, 0);
+		for (size_t worker = 0; worker < count; worker++) {
+			starts[worker + 1] = starts[worker] + buffers[worker].size();
+		}
+		output.resize(starts[count]);
+		parallel(count, [&](size_t worker) {
+			std::copy(buffers[worker].begin(), buffers[worker].end(), output.begin() + starts[worker]);
+		});
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] bool CSRGraph<E, Allocator>::equalTo(const CSRGraph& other) const {
+		return other.vertices == vertices && other.offsets == offsets && other.targets == targets && other.weights == weights;
+	}
+}
@@ -0,0 +1,530 @@
+#include "../../Public/Implementation/CSRMatrix.h"
+#include "../../Public/Implementation/CSCMatrix.h"
+#include <algorithm>
+#include <iterator>
+#include <limits>
+
+namespace core {
+	template<typename E, typename Allocator>
+	CSRMatrix<E, Allocator>::CSRMatrix() : CSRMatrix(0, 0) {}
+
+	template<typename E, typename Allocator>
+	CSRMatrix<E, Allocator>::CSRMatrix(const Allocator& allocator) : CSRMatrix(0, 0, allocator) {}
+
+	template<typename E, typename Allocator>
+	CSRMatrix<E, Allocator>::CSRMatrix(size_t rows, size_t columns, const Allocator& allocator) : allocator(allocator), rows(rows), columns(columns),
+		offsets(rows + 1, 0, allocator), indices(allocator), values(allocator) {
+		if (columns > std::numeric_limits<uint32_t>::max()) {
+			throw std::length_error("too many columns for 32 bit indices");
+		}
+		this->activeCapacity = rows * columns;
+		this->maxCapacity = rows * columns;
+	}
+
+	template<typename E, typename Allocator>
+	CSRMatrix<E, Allocator>::CSRMatrix(size_t rows, size_t columns, const MatrixTriplet<E>* triplets, size_t count, const Allocator& allocator) :
+		CSRMatrix(rows, columns, allocator) {
+		build(triplets, count, false);
+	}
+
+	template<typename E, typename Allocator>
+	CSRMatrix<E, Allocator>::CSRMatrix(const CSCMatrix<E, Allocator>& matrix) : CSRMatrix(matrix.transposed.transpose()) {}
+
+	template<typename E, typename Allocator>
+	CSRMatrix<E, Allocator>::CSRMatrix(CSRMatrix&& other) noexcept : allocator(other.allocator), rows(other.rows), columns(other.columns),
+		offsets(std::move(other.offsets)), indices(std::move(other.indices)), values(std::move(other.values)) {
+		this->activeCapacity = other.activeCapacity;
+		this->maxCapacity = other.maxCapacity;
+		other.rows = 0;
+		other.columns = 0;
+		other.activeCapacity = 0;
+		other.maxCapacity = 0;
+	}
+
+	template<typename E, typename Allocator>
+	CSRMatrix<E, Allocator>& CSRMatrix<E, Allocator>::operator=(CSRMatrix&& other) noexcept(takesStorageOnMove<Allocator>) {
+		if (this != &other) {
+			propagateOnMove(allocator, other.allocator);
+			rows = other.rows;
+			columns = other.columns;
+			offsets = std::move(other.offsets);
+			indices = std::move(other.indices);
+			values = std::move(other.values);
+			this->activeCapacity = other.activeCapacity;
+			this->maxCapacity = other.maxCapacity;
+			other.rows = 0;
+			other.columns = 0;
+			other.activeCapacity = 0;
+			other.maxCapacity = 0;
+		}
+		return *this;
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] size_t CSRMatrix<E, Allocator>::getRows() const {
+		return rows;
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] size_t CSRMatrix<E, Allocator>::getColumns() const {
+		return columns;
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] E CSRMatrix<E, Allocator>::get(size_t row, size_t column) const {
+		if (row >= rows || column >= columns) {
+			throw std::out_of_range("matrix position out of range");
+		}
+		auto first = indices.begin() + offsets[row];
+		auto last = indices.begin() + offsets[row + 1];
+		auto found = std::lower_bound(first, last, column);
+		return found != last && *found == column ? values[found - indices.begin()] : E();
+	}
+
+	template<typename E, typename Allocator>
+	bool CSRMatrix<E, Allocator>::set(size_t row, size_t column, E value) {
+		if (row >= rows || column >= columns) {
+			throw std::out_of_range("matrix position out of range");
+		}
+		auto first = indices.begin() + offsets[row];
+		auto last = indices.begin() + offsets[row + 1];
+		auto found = std::lower_bound(first, last, column);
+		if (found != last && *found == column) {
+			values[found - indices.begin()] = value;
+			return true;
+		}
+		return value == E();
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] CSRMatrix<E, Allocator> CSRMatrix<E, Allocator>::transpose() const {
+		CSRMatrix transposed(columns, rows, allocator);
+		const size_t nonZeros = values.size();
+		for (size_t index = 0; index < nonZeros; index++) {
+			transposed.offsets[indices[index] + 1]++;
+		}
+		for (size_t column = 0; column < columns; column++) {
+			transposed.offsets[column + 1] += transposed.offsets[column];
+		}
+		transposed.indices.resize(nonZeros);
+		transposed.values.resize(nonZeros);
+
+		//Rows are scattered in order, so the new rows come out sorted
+		std::vector<size_t> next(transposed.offsets.begin(), transposed.offsets.end() - 1);
+		for (size_t row = 0; row < rows; row++) {
+			for (size_t index = offsets[row]; index < offsets[row + 1]; index++) {
+				const size_t position = next[indices[index]]++;
+				transposed.indices[position] = static_cast<uint32_t>(row);
+				transposed.values[position] = values[index];
+			}
+		}
+		return transposed;
+	}
+
+	template<typename E, typename Allocator>
+	void CSRMatrix<E, Allocator>::multiply(const E* vector, E* result, unsigned threads) const {
+		const size_t nonZeros = values.size();
+		const size_t count = parallelWorkers(threads, nonZeros, THREAD_WORK);
+		if (count == 1) {
+			for (size_t row = 0; row < rows; row++) {
+				E sum = E();
+				for (size_t index = offsets[row]; index < offsets[row + 1]; index++) {
+					sum += values[index] * vector[indices[index]];
+				}
+				result[row] = sum;
+			}
+			return;
+		}
+
+		//Each worker takes an equal share of the merge path and owns the rows that end inside it
+		const size_t path = rows + nonZeros;
+		std::vector<std::pair<size_t, E>> carries(count, { rows, E() });
+		parallel(count, [&](size_t worker) {
+			auto [row, index] = mergePath(path * worker / count);
+			auto [lastRow, lastIndex] = mergePath(path * (worker + 1) / count);
+			for (; row < lastRow; row++) {
+				E sum = E();
+				for (; index < offsets[row + 1]; index++) {
+					sum += values[index] * vector[indices[index]];
+				}
+				result[row] = sum;
+			}
+			//The start of the row cut at the end of the share, added by the worker owning the row
+			E carry = E();
+			for (; index < lastIndex; index++) {
+				carry += values[index] * vector[indices[index]];
+			}
+			carries[worker] = { lastRow, carry };
+		});
+		for (auto& [row, carry] : carries) {
+			if (row < rows) {
+				result[row] += carry;
+			}
+		}
+	}
+
+	template<typename E, typename Allocator>
+	void CSRMatrix<E, Allocator>::multiplyTransposed(const E* vector, E* result, unsigned threads) const {
+		const size_t nonZeros = values.size();
+		const size_t count = parallelWorkers(threads, nonZeros, THREAD_WORK);
+		std::fill_n(result, columns, E());
+		if (count == 1) {
+			for (size_t row = 0; row < rows; row++) {
+				const E factor = vector[row];
+				for (size_t index = offsets[row]; index < offsets[row + 1]; index++) {
+					result[indices[index]] += values[index] * factor;
+				}
+			}
+			return;
+		}
+
+		//The first worker scatters straight into the result, the others into private copies
+		const size_t path = rows + nonZeros;
+		std::vector<E> copies((count - 1) * columns);
+		parallel(count, [&](size_t worker) {
+			E* target = worker == 0 ? result : copies.data() + (worker - 1) * columns;
+			auto [row, index] = mergePath(path * worker / count);
+			const size_t lastIndex = mergePath(path * (worker + 1) / count).second;
+			while (index < lastIndex) {
+				while (offsets[row + 1] <= index) {
+					row++;
+				}
+				const E factor = vector[row];
+				const size_t stop = std::min(offsets[row + 1], lastIndex);
+				for (; index < stop; index++) {
+					target[indices[index]] += values[index] * factor;
+				}
+			}
+		});
+		parallel(count, [&](size_t worker) {
+			const size_t first = columns * worker / count;
+			const size_t last = columns * (worker + 1) / count;
+			for (size_t copy = 0; copy + 1 < count; copy++) {
+				const E* source = copies.data() + copy * columns;
+				for (size_t column = first; column < last; column++) {
+					result[column] += source[column];
+				}
+			}
+		});
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] DenseMatrix<E, Allocator> CSRMatrix<E, Allocator>::multiply(const DenseMatrix<E, Allocator>& dense, unsigned threads) const {
+		if (dense.getRows() != columns) {
+			throw std::invalid_argument("matrix sizes do not match");
+		}
+		const size_t width = dense.getColumns();
+		DenseMatrix<E, Allocator> product(rows, width, allocator);
+		const size_t path = rows + values.size();
+		const size_t count = parallelWorkers(threads, values.size() * width, THREAD_WORK);
+		parallel(count, [&](size_t worker) {
+			const size_t first = mergePath(path * worker / count).first;
+			const size_t last = worker + 1 == count ? rows : mergePath(path * (worker + 1) / count).first;
+			for (size_t row = first; row < last; row++) {
+				E* target = product.getRow(row);
+				for (size_t index = offsets[row]; index < offsets[row + 1]; index++) {
+					addScaled(target, dense.getRow(indices[index]), values[index], width);
+				}
+			}
+		});
+		return product;
+	}
+
+	template<typename E, typename Allocator>
+	std::unique_ptr<DataEngine<E>> CSRMatrix<E, Allocator>::clone() const {
+		auto copy = std::make_unique<CSRMatrix>(rows, columns, allocator);
+		copy->offsets = offsets;
+		copy->indices = indices;
+		copy->values = values;
+		return copy;
+	}
+
+	template<typename E, typename Allocator>
+	std::unique_ptr<DataEngine<E>> CSRMatrix<E, Allocator>::move() {
+		return std::make_unique<CSRMatrix>(std::move(*this));
+	}
+
+	template<typename E, typename Allocator>
+	bool CSRMatrix<E, Allocator>::removeAll() {
+		if (this->activeCapacity == 0) {
+			return false;
+		}
+		*this = CSRMatrix(allocator);
+		return true;
+	}
+
+	template<typename E, typename Allocator>
+	E* CSRMatrix<E, Allocator>::toArray() const {
+		if (this->activeCapacity == 0) {
+			return nullptr;
+		}
+		std::unique_ptr<E[]> array(new E[this->activeCapacity]());
+		forEach([&](size_t row, size_t column, const E& value) {
+			array[row * columns + column] = value;
+		});
+		return array.release();
+	}
+
+	template<typename E, typename Allocator>
+	E* CSRMatrix<E, Allocator>::toArray(int start, int end) const {
+		if (start < 0 || end <= start || static_cast<size_t>(end) > this->activeCapacity) {
+			return nullptr;
+		}
+		std::unique_ptr<E[]> array(new E[end - start]);
+		copyTo(std::span<E>(array.get(), end - start), start);
+		return array.release();
+	}
+
+	template<typename E, typename Allocator>
+	size_t CSRMatrix<E, Allocator>::copyTo(std::span<E> destination, size_t start) const {
+		if (destination.empty() || start >= this->activeCapacity) {
+			return 0;
+		}
+		const size_t count = std::min(destination.size(), this->activeCapacity - start);
+		std::fill_n(destination.data(), count, E());
+		const size_t end = start + count;
+		const size_t lastRow = (end - 1) / columns;
+		for (size_t row = start / columns; row <= lastRow; row++) {
+			for (size_t index = offsets[row]; index < offsets[row + 1]; index++) {
+				const size_t position = row * columns + indices[index];
+				if (position >= start && position < end) {
+					destination[position - start] = values[index];
+				}
+			}
+		}
+		return count;
+	}
+
+	template<typename E, typename Allocator>
+	void CSRMatrix<E, Allocator>::reverse() {
+		//Reversing the arrays puts the last row first with its columns descending, mirroring the
+		//columns restores the order
+		const size_t nonZeros = values.size();
+		std::reverse(values.begin(), values.end());
+		std::reverse(indices.begin(), indices.end());
+		for (auto& index : indices) {
+			index = static_cast<uint32_t>(columns - 1 - index);
+		}
+		std::reverse(offsets.begin(), offsets.end());
+		for (auto& offset : offsets) {
+			offset = nonZeros - offset;
+		}
+	}
+
+	template<typename E, typename Allocator>
+	E* CSRMatrix<E, Allocator>::begin() noexcept {
+		return values.data();
+	}
+
+	template<typename E, typename Allocator>
+	E* CSRMatrix<E, Allocator>::end() noexcept {
+		return values.data() + values.size();
+	}
+
+	template<typename E, typename Allocator>
+	const E* CSRMatrix<E, Allocator>::begin() const noexcept {
+		return values.data();
+	}
+
+	template<typename E, typename Allocator>
+	const E* CSRMatrix<E, Allocator>::end() const noexcept {
+		return values.data() + values.size();
+	}
+
+	template<typename E, typename Allocator>
+	std::span<E> CSRMatrix<E, Allocator>::view() noexcept {
+		return values;
+	}
+
+	template<typename E, typename Allocator>
+	std::span<const E> CSRMatrix<E, Allocator>::view() const noexcept {
+		return values;
+	}
+
+	template<typename E, typename Allocator>
+	void CSRMatrix<E, Allocator>::grow() {}
+
+	template<typename E, typename Allocator>
+	void CSRMatrix<E, Allocator>::shrink() {}
+
+	template<typename E, typename Allocator>
+	void CSRMatrix<E, Allocator>::compress() {}
+
+	template<typename E, typename Allocator>
+	bool CSRMatrix<E, Allocator>::equalsInternal(const DataEngine<E>& de) const {
+		auto other = dynamic_cast<const Matrix<E>*>(&de);
+		if (other == nullptr || other->getRows() != rows || other->getColumns() != columns) {
+			return false;
+		}
+		//Every non-zero of the other matrix must be matched here, and there must be no other non-zero
+		size_t theirs = 0;
+		bool matched = true;
+		visitNonZeros(*other, 0, rows, [&](size_t row, size_t column, const E& value) {
+			theirs++;
+			matched = matched && get(row, column) == value;
+		});
+		return matched && theirs == static_cast<size_t>(std::count_if(values.begin(), values.end(), [](const E& value) { return value != E(); }));
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] bool CSRMatrix<E, Allocator>::equivalenceInternal(const DataEngine<E>& de) const {
+		auto other = dynamic_cast<const Matrix<E>*>(&de);
+		if (other == nullptr || other->getActiveSize() != this->activeCapacity) {
+			return false;
+		}
+		//Both hold the same number of elements, so equal non-zeros leave equal numbers of zeros
+		std::vector<E> mine;
+		std::copy_if(values.begin(), values.end(), std::back_inserter(mine), [](const E& value) { return value != E(); });
+		std::vector<E> theirs;
+		visitNonZeros(*other, 0, other->getRows(), [&](size_t, size_t, const E& value) {
+			theirs.push_back(value);
+		});
+		std::sort(mine.begin(), mine.end());
+		std::sort(theirs.begin(), theirs.end());
+		return mine == theirs;
+	}
+
+	template<typename E, typename Allocator>
+	std::unique_ptr<DataEngine<E>> CSRMatrix<E, Allocator>::mergeInternal(const DataEngine<E>& de, int start, int end) const {
+		auto other = dynamic_cast<const Matrix<E>*>(&de);
+		if (other == nullptr || start < 0 || end < start || static_cast<size_t>(end) > other->getRows()) {
+			return nullptr;
+		}
+		//A matrix without rows takes the width of the other one
+		const size_t width = rows == 0 ? other->getColumns() : columns;
+		if (other->getColumns() != width) {
+			return nullptr;
+		}
+		std::vector<MatrixTriplet<E>> triplets;
+		triplets.reserve(values.size());
+		forEach([&](size_t row, size_t column, const E& value) {
+			triplets.push_back({ row, column, value });
+		});
+		visitNonZeros(*other, start, end, [&](size_t row, size_t column, const E& value) {
+			triplets.push_back({ rows + row - start, column, value });
+		});
+		return std::unique_ptr<DataEngine<E>>(new CSRMatrix(rows + (end - start), width, triplets.data(), triplets.size(), allocator));
+	}
+
+	template<typename E, typename Allocator>
+	void CSRMatrix<E, Allocator>::build(const MatrixTriplet<E>* triplets, size_t count, bool swap) {
+		//Counting sort of the elements by row, keeping their input order within a row
+		for (size_t i = 0; i < count; i++) {
+			const size_t row = swap ? triplets[i].column : triplets[i].row;
+			const size_t column = swap ? triplets[i].row : triplets[i].column;
+			if (row >= rows || column >= columns) {
+				throw std::out_of_range("matrix element out of range");
+			}
+			offsets[row + 1]++;
+		}
+		for (size_t row = 0; row < rows; row++) {
+			offsets[row + 1] += offsets[row];
+		}
+		indices.resize(count);
+		values.resize(count);
+		std::vector<size_t> next(offsets.begin(), offsets.end() - 1);
+		for (size_t i = 0; i < count; i++) {
+			const size_t position = next[swap ? triplets[i].column : triplets[i].row]++;
+			indices[position] = static_cast<uint32_t>(swap ? triplets[i].row : triplets[i].column);
+			values[position] = triplets[i].value;
+		}
+
+		//Sorts each row by column and sums the duplicates, compacting the rows as it goes
+		std::vector<std::pair<uint32_t, E>> scratch;
+		size_t write = 0;
+		for (size_t row = 0; row < rows; row++) {
+			const size_t first = offsets[row];
+			const size_t last = offsets[row + 1];
+			if (!std::is_sorted(indices.begin() + first, indices.begin() + last)) {
+				scratch.clear();
+				for (size_t index = first; index < last; index++) {
+					scratch.emplace_back(indices[index], values[index]);
+				}
+				std::stable_sort(scratch.begin(), scratch.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+				for (size_t index = first; index < last; index++) {
+					indices[index] = scratch[index - first].first;
+					values[index] = scratch[index - first].second;
+				}
+			}
+			offsets[row] = write;
+			for (size_t index = first; index < last; index++) {
+				if (write > offsets[row] && indices[write - 1] == indices[index]) {
+					values[write - 1] += values[index];
+				}
+				else {
+					indices[write] = indices[index];
+					values[write++] = values[index];
+				}
+			}
+		}
+		offsets[rows] = write;
+		if (write < count) {
+			indices.resize(write);
+			values.resize(write);
+			indices.shrink_to_fit();
+			values.shrink_to_fit();
+		}
+	}
+
+	template<typename E, typename Allocator>
+	std::pair<size_t, size_t> CSRMatrix<E, Allocator>::mergePath(size_t diagonal) const noexcept {
+		//Binary search along the diagonal for the point where the row ends and the element indices cross
+		const size_t nonZeros = values.size();
+		size_t low = diagonal > nonZeros ? diagonal - nonZeros : 0;
+		size_t high = std::min(diagonal, rows);
+		while (low < high) {
+			const size_t pivot = low + (high - low) / 2;
+			if (offsets[pivot + 1] <= diagonal - pivot - 1) {
+				low = pivot + 1;
+			}
+			else {
+				high = pivot;
+			}
+		}
+		return { low, diagonal - low };
+	}
+
+	template<typename E, typename Allocator>
+	template<typename Visitor>
+	void CSRMatrix<E, Allocator>::visitNonZeros(const Matrix<E>& matrix, size_t rowBegin, size_t rowEnd, Visitor&& visitor) {
+		if (auto sparse = dynamic_cast<const CSRMatrix*>(&matrix)) {
+			for (size_t row = rowBegin; row < rowEnd; row++) {
+				for (size_t index = sparse->offsets[row]; index < sparse->offsets[row + 1]; index++) {
+					if (sparse->values[index] != E()) {
+						visitor(row, static_cast<size_t>(sparse->indices[index]), sparse->values[index]);
+					}
+				}
+			}
+		}
+		else if (auto sparse = dynamic_cast<const CSCMatrix<E, Allocator>*>(&matrix)) {
+			sparse->forEach([&](size_t row, size_t column, const E& value) {
+				if (row >= rowBegin && row < rowEnd && value != E()) {
+					visitor(row, column, value);
+				}
+			});
+		}
+		else {
+			for (size_t row = rowBegin; row < rowEnd; row++) {
+				for (size_t column = 0; column < matrix.getColumns(); column++) {
+					const E value = matrix.get(row, column);
+					if (value != E()) {
+						visitor(row, column, value);
+					}
+				}
+			}
+		}
+	}
+
+	template<typename E, typename Allocator>
+	void CSRMatrix<E, Allocator>::addScaled(E* target, const E* source, E scale, size_t count) noexcept {
+		using Lanes = MatrixLanes<E>;
+		const typename Lanes::Vector factor = Lanes::broadcast(scale);
+		size_t i = 0;
+		for (; i + Lanes::WIDTH <= count; i += Lanes::WIDTH) {
+			Lanes::store(target + i, Lanes::multiplyAdd(factor, Lanes::load(source + i), Lanes::load(target + i)));
+		}
+		for (; i < count; i++) {
+			target[i] += scale * source[i];
+		}
+	}
+}
@@ -0,0 +1,374 @@
+#include "../../Public/Implementation/ConcurrentArrayQueue.h"
+#include "../../Public/EngineSort.h"
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <vector>
+
+namespace core {
+	template<typename E, typename Allocator>
+	ConcurrentArrayQueue<E, Allocator>::ConcurrentArrayQueue() : ConcurrentArrayQueue(DataEngine<E>::DEFAULT_CAPACITY) {}
+
+	template<typename E, typename Allocator>
+	ConcurrentArrayQueue<E, Allocator>::ConcurrentArrayQueue(const Allocator& allocator) :
+		ConcurrentArrayQueue(DataEngine<E>::DEFAULT_CAPACITY, allocator) {}
+
+	template<typename E, typename Allocator>
+	ConcurrentArrayQueue<E, Allocator>::ConcurrentArrayQueue(size_t capacity, const Allocator& allocator) : allocator(allocator),
+		enqueuePosition(0), dequeuePosition(0), padding{} {
+		this->maxCapacity = std::bit_ceil(std::max<size_t>(capacity, 2));
+		this->activeCapacity = 0; //Unused, the live size is derived from the positions
+		mask = this->maxCapacity - 1;
+		cells = reinterpret_cast<Cell*>(allocateStorage<RingLine>(allocator,
+			(this->maxCapacity * sizeof(Cell) + RING_ALIGNMENT - 1) / RING_ALIGNMENT));
+		for (size_t i = 0; i < this->maxCapacity; i++) {
+			::new (static_cast<void*>(cells + i)) Cell;
+			cells[i].sequence.store(i, std::memory_order_relaxed);
+		}
+	}
+
+	template<typename E, typename Allocator>
+	ConcurrentArrayQueue<E, Allocator>::~ConcurrentArrayQueue() {
+		const size_t head = dequeuePosition.load(std::memory_order_relaxed);
+		const size_t tail = enqueuePosition.load(std::memory_order_relaxed);
+		for (size_t position = head; position != tail; position++) {
+			std::destroy_at(cells[position & mask].item());
+		}
+		std::destroy(cells, cells + this->maxCapacity);
+		deallocateStorage(allocator, reinterpret_cast<RingLine*>(cells), (this->maxCapacity * sizeof(Cell) + RING_ALIGNMENT - 1) / RING_ALIGNMENT);
+	}
+
+	template<typename E, typename Allocator>
+	bool ConcurrentArrayQueue<E, Allocator>::enqueue(E item) {
+		size_t position = enqueuePosition.load(std::memory_order_relaxed);
+		Cell* cell;
+		while (true) {
+			cell = cells + (position & mask);
+			const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+			const auto difference = static_cast<std::ptrdiff_t>(sequence - position);
+			if (difference == 0) {
+				if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+					break;
+				}
+			}
+			else if (difference < 0) {
+				return false; //The slot still holds the item from one lap ago, the queue is full
+			}
+			else {
+				position = enqueuePosition.load(std::memory_order_relaxed);
+			}
+		}
+		::new (static_cast<void*>(cell->storage)) E(std::move(item));
+		cell->sequence.store(position + 1, std::memory_order_release);
+		return true;
+	}
+
+	template<typename E, typename Allocator>
+	bool ConcurrentArrayQueue<E, Allocator>::dequeue(E& item) {
+		size_t position = dequeuePosition.load(std::memory_order_relaxed);
+		Cell* cell;
+		while (true) {
+			cell = cells + (position & mask);
+			const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+			const auto difference = static_cast<std::ptrdiff_t>(sequence - (position + 1));
+			if (difference == 0) {
+				if (dequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+					break;
+				}
+			}
+			else if (difference < 0) {
+				return false; //The slot has not been published for this lap, the queue is empty
+			}
+			else {
+				position = dequeuePosition.load(std::memory_order_relaxed);
+			}
+		}
+		E* slot = cell->item();
+		item = std::move(*slot);
+		std::destroy_at(slot);
+		cell->sequence.store(position + this->maxCapacity, std::memory_order_release);
+		return true;
+	}
+
+	template<typename E, typename Allocator>
+	size_t ConcurrentArrayQueue<E, Allocator>::enqueue(const E* items, size_t count) {
+		if (items == nullptr || count == 0) {
+			return 0;
+		}
+		size_t position = enqueuePosition.load(std::memory_order_relaxed);
+		size_t claimed;
+		while (true) {
+			//Only the run of free slots at the tail is claimed, a slot whose consumer is still copying its item out ends it
+			claimed = 0;
+			while (claimed < count && cells[(position + claimed) & mask].sequence.load(std::memory_order_acquire) == position + claimed) {
+				claimed++;
+			}
+			if (claimed == 0) {
+				const size_t sequence = cells[position & mask].sequence.load(std::memory_order_acquire);
+				if (static_cast<std::ptrdiff_t>(sequence - position) < 0) {
+					return 0;
+				}
+				position = enqueuePosition.load(std::memory_order_relaxed);
+				continue;
+			}
+			if (enqueuePosition.compare_exchange_weak(position, position + claimed, std::memory_order_relaxed)) {
+				break;
+			}
+		}
+		for (size_t i = 0; i < claimed; i++) {
+			Cell* cell = cells + ((position + i) & mask);
+			::new (static_cast<void*>(cell->storage)) E(items[i]);
+			cell->sequence.store(position + i + 1, std::memory_order_release);
+		}
+		return claimed;
+	}
+
+	template<typename E, typename Allocator>
+	size_t ConcurrentArrayQueue<E, Allocator>::dequeue(E* items, size_t count) {
+		if (items == nullptr || count == 0) {
+			return 0;
+		}
+		size_t position = dequeuePosition.load(std::memory_order_relaxed);
+		size_t claimed;
+		while (true) {
+			//Only the run of published slots at the head is claimed, a slot whose producer has not published yet ends it
+			claimed = 0;
+			while (claimed < count && cells[(position + claimed) & mask].sequence.load(std::memory_order_acquire) == position + claimed + 1) {
+				claimed++;
+			}
+			if (claimed == 0) {
+				const size_t sequence = cells[position & mask].sequence.load(std::memory_order_acquire);
+				if (static_cast<std::ptrdiff_t>(sequence - (position + 1)) < 0) {
+					return 0;
+				}
+				position = dequeuePosition.load(std::memory_order_relaxed);
+				continue;
+			}
+			if (dequeuePosition.compare_exchange_weak(position, position + claimed, std::memory_order_relaxed)) {
+				break;
+			}
+		}
+		for (size_t i = 0; i < claimed; i++) {
+			Cell* cell = cells + ((position + i) & mask);
+			E* slot = cell->item();
+			items[i] = std::move(*slot);
+			std::destroy_at(slot);
+			cell->sequence.store(position + i + this->maxCapacity, std::memory_order_release);
+		}
+		return claimed;
+	}
+
+	template<typename E, typename Allocator>
+	void ConcurrentArrayQueue<E, Allocator>::put(E item) {
+		unsigned spins = 0;
+		while (!enqueue(item)) {
+			spinPause(spins);
+		}
+	}
+
+	template<typename E, typename Allocator>
+	void ConcurrentArrayQueue<E, Allocator>::putAll(const E* items, size_t count) {
+		unsigned spins = 0;
+		while (count > 0) {
+			const size_t added = enqueue(items, count);
+			if (added == 0) {
+				spinPause(spins);
+				continue;
+			}
+			items += added;
+			count -= added;
+			spins = 0;
+		}
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] E ConcurrentArrayQueue<E, Allocator>::take() {
+		E item;
+		unsigned spins = 0;
+		while (!dequeue(item)) {
+			spinPause(spins);
+		}
+		return item;
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] size_t ConcurrentArrayQueue<E, Allocator>::getActiveSize() const {
+		const size_t head = dequeuePosition.load(std::memory_order_acquire);
+		const size_t tail = enqueuePosition.load(std::memory_order_acquire);
+		const auto used = static_cast<std::ptrdiff_t>(tail - head);
+		return std::clamp<std::ptrdiff_t>(used, 0, static_cast<std::ptrdiff_t>(this->maxCapacity));
+	}
+
+	template<typename E, typename Allocator>
+	void ConcurrentArrayQueue<E, Allocator>::sort() {
+		std::vector<E> items(this->maxCapacity);
+		items.resize(dequeue(items.data(), items.size()));
+		if constexpr (std::totally_ordered<E>) {
+			ParallelSort::sort(items.data(), items.size());
+		}
+		putAll(items.data(), items.size());
+	}
+
+	template<typename E, typename Allocator>
+	std::unique_ptr<DataEngine<E>> ConcurrentArrayQueue<E, Allocator>::clone() const {
+		auto copy = std::make_unique<ConcurrentArrayQueue>(this->maxCapacity, allocator);
+		const size_t count = getActiveSize();
+		if (count > 0) {
+			std::vector<E> items(count);
+			copyOut(items.data(), 0, count);
+			copy->enqueue(items.data(), count);
+		}
+		return copy;
+	}
+
+	template<typename E, typename Allocator>
+	std::unique_ptr<DataEngine<E>> ConcurrentArrayQueue<E, Allocator>::move() {
+		auto moved = std::make_unique<ConcurrentArrayQueue>(this->maxCapacity, allocator);
+		E item;
+		while (dequeue(item)) {
+			moved->enqueue(std::move(item));
+		}
+		return moved;
+	}
+
+	template<typename E, typename Allocator>
+	bool ConcurrentArrayQueue<E, Allocator>::removeAll() {
+		bool removed = false;
+		E item;
+		while (dequeue(item)) {
+			removed = true;
+		}
+		return removed;
+	}
+
+	template<typename E, typename Allocator>
+	E* ConcurrentArrayQueue<E, Allocator>::toArray() const {
+		return toArray(0, static_cast<int>(getActiveSize()));
+	}
+
+	template<typename E, typename Allocator>
+	E* ConcurrentArrayQueue<E, Allocator>::toArray(int start, int end) const {
+		if (start < 0 || end <= start || static_cast<size_t>(end) > getActiveSize()) {
+			return nullptr;
+		}
+		std::unique_ptr<E[]> array(new E[end - start]);
+		copyOut(array.get(), start, end);
+		return array.release();
+	}
+
+	template<typename E, typename Allocator>
+	size_t ConcurrentArrayQueue<E, Allocator>::copyTo(std::span<E> destination, size_t start) const {
+		const size_t size = getActiveSize();
+		if (destination.empty() || start >= size) {
+			return 0;
+		}
+		const size_t count = std::min(destination.size(), size - start);
+		copyOut(destination.data(), start, start + count);
+		return count;
+	}
+
+	template<typename E, typename Allocator>
+	void ConcurrentArrayQueue<E, Allocator>::reverse() {
+		std::vector<E> items(this->maxCapacity);
+		items.resize(dequeue(items.data(), items.size()));
+		std::reverse(items.begin(), items.end());
+		putAll(items.data(), items.size());
+	}
+
+	template<typename E, typename Allocator>
+	typename ConcurrentArrayQueue<E, Allocator>::iterator ConcurrentArrayQueue<E, Allocator>::begin() {
+		return iterator(cells, mask, dequeuePosition.load(std::memory_order_acquire));
+	}
+
+	template<typename E, typename Allocator>
+	typename ConcurrentArrayQueue<E, Allocator>::const_iterator ConcurrentArrayQueue<E, Allocator>::begin() const {
+		return const_iterator(cells, mask, dequeuePosition.load(std::memory_order_acquire));
+	}
+
+	template<typename E, typename Allocator>
+	typename ConcurrentArrayQueue<E, Allocator>::iterator ConcurrentArrayQueue<E, Allocator>::end() {
+		return iterator(cells, mask, enqueuePosition.load(std::memory_order_acquire));
+	}
+
+	template<typename E, typename Allocator>
+	typename ConcurrentArrayQueue<E, Allocator>::const_iterator ConcurrentArrayQueue<E, Allocator>::end() const {
+		return const_iterator(cells, mask, enqueuePosition.load(std::memory_order_acquire));
+	}
+
+	template<typename E, typename Allocator>
+	void ConcurrentArrayQueue<E, Allocator>::grow() {}
+
+	template<typename E, typename Allocator>
+	void ConcurrentArrayQueue<E, Allocator>::shrink() {}
+
+	template<typename E, typename Allocator>
+	void ConcurrentArrayQueue<E, Allocator>::compress() {}
+
+	template<typename E, typename Allocator>
+	bool ConcurrentArrayQueue<E, Allocator>::equalsInternal(const DataEngine<E>& de) const {
+		auto other = dynamic_cast<const Queue<E>*>(&de);
+		const size_t count = getActiveSize();
+		if (other == nullptr || other->getActiveSize() != count) {
+			return false;
+		}
+		if (count == 0) {
+			return true;
+		}
+		std::unique_ptr<E[]> mine(toArray());
+		std::unique_ptr<E[]> theirs(other->toArray());
+		return theirs != nullptr && std::equal(mine.get(), mine.get() + count, theirs.get());
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] bool ConcurrentArrayQueue<E, Allocator>::equivalenceInternal(const DataEngine<E>& de) const {
+		auto other = dynamic_cast<const Queue<E>*>(&de);
+		const size_t count = getActiveSize();
+		if (other == nullptr || other->getActiveSize() != count) {
+			return false;
+		}
+		if (count == 0) {
+			return true;
+		}
+		std::unique_ptr<E[]> mine(toArray());
+		std::unique_ptr<E[]> theirs(other->toArray());
+		if (theirs == nullptr) {
+			return false;
+		}
+		if constexpr (std::totally_ordered<E>) {
+			std::sort(mine.get(), mine.get() + count);
+			std::sort(theirs.get(), theirs.get() + count);
+			return std::equal(mine.get(), mine.get() + count, theirs.get());
+		}
+		else {
+			return std::is_permutation(mine.get(), mine.get() + count, theirs.get());
+		}
+	}
+
+	template<typename E, typename Allocator>
+	std::unique_ptr<DataEngine<E>> ConcurrentArrayQueue<E, Allocator>::mergeInternal(const DataEngine<E>& de, int start, int end) const {
+		auto other = dynamic_cast<const Queue<E>*>(&de);
+		if (other == nullptr || start < 0 || end < start || static_cast<size_t>(end) > other->getActiveSize()) {
+			return nullptr;
+		}
+		const size_t count = getActiveSize();
+		auto merged = std::make_unique<ConcurrentArrayQueue>(count + (end - start), allocator);
+		if (count > 0) {
+			std::vector<E> items(count);
+			copyOut(items.data(), 0, count);
+			merged->enqueue(items.data(), count);
+		}
+		if (end > start) {
+			std::unique_ptr<E[]> items(other->toArray(start, end));
+			merged->enqueue(items.get(), end - start);
+		}
+		return merged;
+	}
+
+	template<typename E, typename Allocator>
+	void ConcurrentArrayQueue<E, Allocator>::copyOut(E* destination, size_t start, size_t end) const {
+		const size_t head = dequeuePosition.load(std::memory_order_acquire);
+		for (size_t position = start; position < end; position++) {
+			*destination++ = *cells[(head + position) & mask].item();
+		}
+	}
+}
@@ -0,0 +1,509 @@
+#include "../../Public/Implementation/ConcurrentHashMap.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <memory>
+
+namespace core {
+	template<typename K, typename V, typename Allocator>
+	ConcurrentHashMap<K, V, Allocator>::ConcurrentHashMap() : ConcurrentHashMap(0) {}
+
+	template<typename K, typename V, typename Allocator>
+	ConcurrentHashMap<K, V, Allocator>::ConcurrentHashMap(const Allocator& allocator) : ConcurrentHashMap(0, allocator) {}
+
+	template<typename K, typename V, typename Allocator>
+	ConcurrentHashMap<K, V, Allocator>::ConcurrentHashMap(size_t capacity, const Allocator& allocator) : allocator(allocator) {
+		this->maxCapacity = capacityFor(capacity);
+		this->activeCapacity = 0; //Unused, the live size is the sum of the stripe counts
+		table.store(allocateTable(this->maxCapacity), std::memory_order_release);
+	}
+
+	template<typename K, typename V, typename Allocator>
+	ConcurrentHashMap<K, V, Allocator>::~ConcurrentHashMap() {
+		Table* current = table.load(std::memory_order_acquire);
+		while (current != nullptr) {
+			for (size_t i = 0; i < current->capacity; i++) {
+				Node* node = chain(current->buckets[i]);
+				while (node != nullptr) {
+					Node* next = node->next.load(std::memory_order_relaxed);
+					destroyObject(allocator, node);
+					node = next;
+				}
+			}
+			Table* next = current->next.load(std::memory_order_relaxed);
+			deallocateTable(allocator, current);
+			current = next;
+		}
+	}
+
+	template<typename K, typename V, typename Allocator>
+	bool ConcurrentHashMap<K, V, Allocator>::put(K key, V value) {
+		return insert(std::move(key), std::move(value), true);
+	}
+
+	template<typename K, typename V, typename Allocator>
+	[[nodiscard]] bool ConcurrentHashMap<K, V, Allocator>::get(const K& key, V& value) const {
+		auto guard = domain.pin();
+		const Node* node = locate(key, hash(key));
+		if (node == nullptr) {
+			return false;
+		}
+		value = node->entry.value;
+		return true;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	bool ConcurrentHashMap<K, V, Allocator>::remove(const K& key) {
+		auto guard = domain.pin();
+		helpResize();
+		const size_t h = hash(key);
+		Stripe& stripe = stripes[h & (STRIPES - 1)];
+		StripeGuard locked(stripe);
+		Table* current = owner(h);
+		std::atomic<Node*>* link = &current->buckets[h & current->mask];
+		for (Node* node = link->load(std::memory_order_relaxed); node != nullptr; node = link->load(std::memory_order_relaxed)) {
+			if (node->hash == h && node->entry.key == key) {
+				link->store(node->next.load(std::memory_order_relaxed), std::memory_order_release);
+				const size_t count = stripe.count.load(std::memory_order_relaxed) - 1;
+				stripe.count.store(count, std::memory_order_relaxed);
+				locked.unlock();
+				domain.retire(node, allocator);
+				checkLoad(count);
+				return true;
+			}
+			link = &node->next;
+		}
+		return false;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	[[nodiscard]] bool ConcurrentHashMap<K, V, Allocator>::containsKey(const K& key) {
+		auto guard = domain.pin();
+		return locate(key, hash(key)) != nullptr;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	[[nodiscard]] bool ConcurrentHashMap<K, V, Allocator>::containsValue(const V& value) {
+		auto guard = domain.pin();
+		//Entries only move forward into the next table, which is scanned after the current one
+		for (Table* current = table.load(std::memory_order_acquire); current != nullptr;
+			current = current->next.load(std::memory_order_acquire)) {
+			for (size_t i = 0; i < current->capacity; i++) {
+				for (Node* node = chain(current->buckets[i]); node != nullptr; node = node->next.load(std::memory_order_acquire)) {
+					if (node->entry.value == value) {
+						return true;
+					}
+				}
+			}
+		}
+		return false;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	bool ConcurrentHashMap<K, V, Allocator>::putIfAbsent(K key, V value) {
+		return insert(std::move(key), std::move(value), false);
+	}
+
+	template<typename K, typename V, typename Allocator>
+	[[nodiscard]] size_t ConcurrentHashMap<K, V, Allocator>::getActiveSize() const {
+		size_t size = 0;
+		for (const Stripe& stripe : stripes) {
+			size += stripe.count.load(std::memory_order_relaxed);
+		}
+		return size;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	void ConcurrentHashMap<K, V, Allocator>::sort() {}
+
+	template<typename K, typename V, typename Allocator>
+	std::unique_ptr<DataEngine<Entry<K, V>>> ConcurrentHashMap<K, V, Allocator>::clone() const {
+		std::vector<E> entries = snapshot();
+		auto copy = std::make_unique<ConcurrentHashMap>(entries.size(), allocator);
+		for (E& entry : entries) {
+			copy->insert(std::move(entry.key), std::move(entry.value), true);
+		}
+		return copy;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	std::unique_ptr<DataEngine<Entry<K, V>>> ConcurrentHashMap<K, V, Allocator>::move() {
+		auto moved = std::make_unique<ConcurrentHashMap>(allocator);
+		const StripesGuard locked(this);
+		Table* fresh = moved->table.load(std::memory_order_relaxed);
+		moved->table.store(table.load(std::memory_order_relaxed), std::memory_order_relaxed);
+		table.store(fresh, std::memory_order_release);
+		for (size_t i = 0; i < STRIPES; i++) {
+			moved->stripes[i].count.store(stripes[i].count.load(std::memory_order_relaxed), std::memory_order_relaxed);
+			stripes[i].count.store(0, std::memory_order_relaxed);
+		}
+		std::swap(moved->maxCapacity, this->maxCapacity);
+		return moved;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	bool ConcurrentHashMap<K, V, Allocator>::removeAll() {
+		std::vector<Node*> removed;
+		{
+			auto guard = domain.pin();
+			const StripesGuard locked(this);
+			for (Table* current = table.load(std::memory_order_acquire); current != nullptr;
+				current = current->next.load(std::memory_order_acquire)) {
+				for (size_t i = 0; i < current->capacity; i++) {
+					Node* node = chain(current->buckets[i]);
+					if (node != nullptr) {
+						current->buckets[i].store(nullptr, std::memory_order_release);
+					}
+					for (; node != nullptr; node = node->next.load(std::memory_order_relaxed)) {
+						removed.push_back(node);
+					}
+				}
+			}
+			for (Stripe& stripe : stripes) {
+				stripe.count.store(0, std::memory_order_relaxed);
+			}
+		}
+		for (Node* node : removed) {
+			domain.retire(node, allocator);
+		}
+		return !removed.empty();
+	}
+
+	template<typename K, typename V, typename Allocator>
+	Entry<K, V>* ConcurrentHashMap<K, V, Allocator>::toArray() const {
+		std::vector<E> entries = snapshot();
+		if (entries.empty()) {
+			return nullptr;
+		}
+		std::unique_ptr<E[]> array(new E[entries.size()]);
+		std::move(entries.begin(), entries.end(), array.get());
+		return array.release();
+	}
+
+	template<typename K, typename V, typename Allocator>
+	Entry<K, V>* ConcurrentHashMap<K, V, Allocator>::toArray(int start, int end) const {
+		std::vector<E> entries = snapshot();
+		if (start < 0 || end <= start || static_cast<size_t>(end) > entries.size()) {
+			return nullptr;
+		}
+		std::unique_ptr<E[]> array(new E[end - start]);
+		std::move(entries.begin() + start, entries.begin() + end, array.get());
+		return array.release();
+	}
+
+	template<typename K, typename V, typename Allocator>
+	size_t ConcurrentHashMap<K, V, Allocator>::copyTo(std::span<Entry<K, V>> destination, size_t start) const {
+		if (destination.empty()) {
+			return 0;
+		}
+		size_t position = 0;
+		size_t copied = 0;
+		auto guard = domain.pin();
+		const StripesGuard locked(this);
+		//Same walk as snapshot, the entries before start are only counted
+		for (Table* current = table.load(std::memory_order_acquire); current != nullptr && copied < destination.size();
+			current = current->next.load(std::memory_order_acquire)) {
+			for (size_t i = 0; i < current->capacity && copied < destination.size(); i++) {
+				for (Node* node = chain(current->buckets[i]); node != nullptr && copied < destination.size();
+					node = node->next.load(std::memory_order_acquire)) {
+					if (position++ >= start) {
+						destination[copied++] = node->entry;
+					}
+				}
+			}
+		}
+		return copied;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	void ConcurrentHashMap<K, V, Allocator>::reverse() {}
+
+	template<typename K, typename V, typename Allocator>
+	typename ConcurrentHashMap<K, V, Allocator>::iterator ConcurrentHashMap<K, V, Allocator>::begin() {
+		return iterator(table.load(std::memory_order_acquire));
+	}
+
+	template<typename K, typename V, typename Allocator>
+	typename ConcurrentHashMap<K, V, Allocator>::const_iterator ConcurrentHashMap<K, V, Allocator>::begin() const {
+		return const_iterator(table.load(std::memory_order_acquire));
+	}
+
+	template<typename K, typename V, typename Allocator>
+	typename ConcurrentHashMap<K, V, Allocator>::iterator ConcurrentHashMap<K, V, Allocator>::end() {
+		return iterator(nullptr);
+	}
+
+	template<typename K, typename V, typename Allocator>
+	typename ConcurrentHashMap<K, V, Allocator>::const_iterator ConcurrentHashMap<K, V, Allocator>::end() const {
+		return const_iterator(nullptr);
+	}
+
+	template<typename K, typename V, typename Allocator>
+	void ConcurrentHashMap<K, V, Allocator>::grow() {
+		Table* current = table.load(std::memory_order_acquire);
+		resize(current, current->capacity << 1);
+	}
+
+	template<typename K, typename V, typename Allocator>
+	void ConcurrentHashMap<K, V, Allocator>::shrink() {
+		Table* current = table.load(std::memory_order_acquire);
+		resize(current, current->capacity >> 1);
+	}
+
+	template<typename K, typename V, typename Allocator>
+	void ConcurrentHashMap<K, V, Allocator>::compress() {
+		resize(table.load(std::memory_order_acquire), capacityFor(getActiveSize()));
+	}
+
+	template<typename K, typename V, typename Allocator>
+	bool ConcurrentHashMap<K, V, Allocator>::equalsInternal(const DataEngine<E>& de) const {
+		auto other = dynamic_cast<const Map<K, V>*>(&de);
+		if (other == nullptr) {
+			return false;
+		}
+		std::vector<E> entries = snapshot();
+		if (other->getActiveSize() != entries.size()) {
+			return false;
+		}
+		V value;
+		for (const E& entry : entries) {
+			if (!other->get(entry.key, value) || !(value == entry.value)) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	[[nodiscard]] bool ConcurrentHashMap<K, V, Allocator>::equivalenceInternal(const DataEngine<E>& de) const {
+		//Entries carry no order, so equivalence and equality coincide
+		return equalsInternal(de);
+	}
+
+	template<typename K, typename V, typename Allocator>
+	std::unique_ptr<DataEngine<Entry<K, V>>> ConcurrentHashMap<K, V, Allocator>::mergeInternal(const DataEngine<E>& de, int start, int end) const {
+		auto other = dynamic_cast<const Map<K, V>*>(&de);
+		if (other == nullptr || start < 0 || end < start || static_cast<size_t>(end) > other->getActiveSize()) {
+			return nullptr;
+		}
+		std::vector<E> entries = snapshot();
+		auto merged = std::make_unique<ConcurrentHashMap>(entries.size() + (end - start), allocator);
+		for (E& entry : entries) {
+			merged->insert(std::move(entry.key), std::move(entry.value), true);
+		}
+		if (end > start) {
+			std::unique_ptr<E[]> added(other->toArray(start, end));
+			for (int i = 0; added != nullptr && i < end - start; i++) {
+				merged->insert(std::move(added[i].key), std::move(added[i].value), true);
+			}
+		}
+		return merged;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	void ConcurrentHashMap<K, V, Allocator>::lock(Stripe& stripe) noexcept {
+		unsigned spins = 0;
+		while (stripe.locked.exchange(true, std::memory_order_acquire)) {
+			//Spinning on a plain load keeps the line shared until the holder releases it
+			while (stripe.locked.load(std::memory_order_relaxed)) {
+				spinPause(spins);
+			}
+		}
+	}
+
+	template<typename K, typename V, typename Allocator>
+	void ConcurrentHashMap<K, V, Allocator>::unlock(Stripe& stripe) noexcept {
+		stripe.locked.store(false, std::memory_order_release);
+	}
+
+	template<typename K, typename V, typename Allocator>
+	void ConcurrentHashMap<K, V, Allocator>::lockAll() const noexcept {
+		//Writers hold a single stripe at a time, so taking them in order cannot deadlock
+		for (Stripe& stripe : stripes) {
+			lock(stripe);
+		}
+	}
+
+	template<typename K, typename V, typename Allocator>
+	void ConcurrentHashMap<K, V, Allocator>::unlockAll() const noexcept {
+		for (Stripe& stripe : stripes) {
+			unlock(stripe);
+		}
+	}
+
+	template<typename K, typename V, typename Allocator>
+	typename ConcurrentHashMap<K, V, Allocator>::Node* ConcurrentHashMap<K, V, Allocator>::locate(const K& key, size_t hash) const {
+		Table* current = table.load(std::memory_order_acquire);
+		for (;;) {
+			Node* node = current->buckets[hash & current->mask].load(std::memory_order_acquire);
+			if (node == FORWARD) {
+				current = current->next.load(std::memory_order_acquire);
+				continue;
+			}
+			for (; node != nullptr; node = node->next.load(std::memory_order_acquire)) {
+				if (node->hash == hash && node->entry.key == key) {
+					return node;
+				}
+			}
+			return nullptr;
+		}
+	}
+
+	template<typename K, typename V, typename Allocator>
+	typename ConcurrentHashMap<K, V, Allocator>::Table* ConcurrentHashMap<K, V, Allocator>::owner(size_t hash) const {
+		Table* current = table.load(std::memory_order_acquire);
+		while (current->buckets[hash & current->mask].load(std::memory_order_acquire) == FORWARD) {
+			current = current->next.load(std::memory_order_acquire);
+		}
+		return current;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	bool ConcurrentHashMap<K, V, Allocator>::insert(K key, V value, bool replace) {
+		auto guard = domain.pin();
+		helpResize();
+		const size_t h = hash(key);
+		Stripe& stripe = stripes[h & (STRIPES - 1)];
+		StripeGuard locked(stripe);
+		Table* current = owner(h);
+		std::atomic<Node*>& bucket = current->buckets[h & current->mask];
+		Node* head = bucket.load(std::memory_order_relaxed);
+		std::atomic<Node*>* link = &bucket;
+		for (Node* node = head; node != nullptr; node = link->load(std::memory_order_relaxed)) {
+			if (node->hash == h && node->entry.key == key) {
+				if (!replace) {
+					return false;
+				}
+				//Readers may be copying the old value, so the entry is replaced as a whole
+				link->store(createObject<Node>(allocator, h, E{ std::move(key), std::move(value) }, node->next.load(std::memory_order_relaxed)),
+					std::memory_order_release);
+				locked.unlock();
+				domain.retire(node, allocator);
+				return false;
+			}
+			link = &node->next;
+		}
+		bucket.store(createObject<Node>(allocator, h, E{ std::move(key), std::move(value) }, head), std::memory_order_release);
+		const size_t count = stripe.count.load(std::memory_order_relaxed) + 1;
+		stripe.count.store(count, std::memory_order_relaxed);
+		locked.unlock();
+		checkLoad(count);
+		return true;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	void ConcurrentHashMap<K, V, Allocator>::helpResize() {
+		Table* current = table.load(std::memory_order_acquire);
+		Table* next = current->next.load(std::memory_order_acquire);
+		if (next == nullptr) {
+			return;
+		}
+		const size_t start = current->transferIndex.fetch_add(MIGRATION_CHUNK, std::memory_order_relaxed);
+		if (start >= current->capacity) {
+			return;
+		}
+		const size_t end = std::min(start + MIGRATION_CHUNK, current->capacity);
+		for (size_t i = start; i < end; i++) {
+			const StripeGuard locked(stripes[i & (STRIPES - 1)]);
+			migrate(current, next, i);
+		}
+		if (current->transferred.fetch_add(end - start, std::memory_order_acq_rel) + (end - start) == current->capacity) {
+			//Every bucket forwards now, readers still holding the old table follow next until it is freed
+			table.store(next, std::memory_order_release);
+			std::atomic_ref<size_t>(this->maxCapacity).store(next->capacity, std::memory_order_relaxed);
+			domain.retire(current, [](void* released, void* context) {
+				deallocateTable(*static_cast<const Allocator*>(context), static_cast<Table*>(released));
+			}, &allocator);
+		}
+	}
+
+	template<typename K, typename V, typename Allocator>
+	void ConcurrentHashMap<K, V, Allocator>::migrate(Table* from, Table* to, size_t bucket) {
+		//Nodes are copied rather than relinked, readers may still be walking the old chain
+		Node* head = from->buckets[bucket].load(std::memory_order_relaxed);
+		for (Node* node = head; node != nullptr; node = node->next.load(std::memory_order_relaxed)) {
+			std::atomic<Node*>& target = to->buckets[node->hash & to->mask];
+			target.store(createObject<Node>(allocator, node->hash, node->entry, target.load(std::memory_order_relaxed)), std::memory_order_release);
+		}
+		from->buckets[bucket].store(FORWARD, std::memory_order_release);
+		while (head != nullptr) {
+			Node* next = head->next.load(std::memory_order_relaxed);
+			domain.retire(head, allocator);
+			head = next;
+		}
+	}
+
+	template<typename K, typename V, typename Allocator>
+	void ConcurrentHashMap<K, V, Allocator>::resize(Table* current, size_t capacity) {
+		if (capacity < STRIPES || capacity == current->capacity ||
+			current->next.load(std::memory_order_acquire) != nullptr || table.load(std::memory_order_acquire) != current) {
+			return;
+		}
+		auto fresh = allocateTable(capacity);
+		Table* expected = nullptr;
+		if (!current->next.compare_exchange_strong(expected, fresh, std::memory_order_acq_rel)) {
+			deallocateTable(allocator, fresh);
+		}
+	}
+
+	template<typename K, typename V, typename Allocator>
+	typename ConcurrentHashMap<K, V, Allocator>::Table* ConcurrentHashMap<K, V, Allocator>::allocateTable(size_t capacity) const {
+		auto buckets = allocateStorage<std::atomic<Node*>>(allocator, capacity);
+		std::uninitialized_value_construct_n(buckets, capacity);
+		try {
+			return createObject<Table>(allocator, capacity, buckets);
+		}
+		catch (...) {
+			deallocateStorage(allocator, buckets, capacity);
+			throw;
+		}
+	}
+
+	template<typename K, typename V, typename Allocator>
+	void ConcurrentHashMap<K, V, Allocator>::deallocateTable(const Allocator& allocator, Table* released) noexcept {
+		std::destroy_n(released->buckets, released->capacity);
+		deallocateStorage(allocator, released->buckets, released->capacity);
+		destroyObject(allocator, released);
+	}
+
+	template<typename K, typename V, typename Allocator>
+	void ConcurrentHashMap<K, V, Allocator>::checkLoad(size_t count) {
+		Table* current = table.load(std::memory_order_acquire);
+		if (current->next.load(std::memory_order_relaxed) != nullptr) {
+			return;
+		}
+		const auto growthThreshold = static_cast<size_t>(current->capacity * DataEngine<E>::GROWTH_LOAD_FACTOR);
+		const auto shrinkThreshold = static_cast<size_t>(current->capacity * DataEngine<E>::SHRINK_LOAD_FACTOR);
+		if (count > growthThreshold / STRIPES && getActiveSize() > growthThreshold) {
+			resize(current, current->capacity << 1);
+		}
+		//Below STRIPES entries per table the share of one stripe rounds to zero, so only the total can tell
+		else if ((shrinkThreshold < STRIPES || count < shrinkThreshold / STRIPES) && current->capacity > STRIPES && getActiveSize() < shrinkThreshold) {
+			resize(current, current->capacity >> 1);
+		}
+	}
+
+	template<typename K, typename V, typename Allocator>
+	std::vector<Entry<K, V>> ConcurrentHashMap<K, V, Allocator>::snapshot() const {
+		std::vector<E> entries;
+		auto guard = domain.pin();
+		const StripesGuard locked(this);
+		entries.reserve(getActiveSize());
+		//With every stripe locked, an entry is either in an unforwarded bucket or already in the next table
+		for (Table* current = table.load(std::memory_order_acquire); current != nullptr;
+			current = current->next.load(std::memory_order_acquire)) {
+			for (size_t i = 0; i < current->capacity; i++) {
+				for (Node* node = chain(current->buckets[i]); node != nullptr; node = node->next.load(std::memory_order_acquire)) {
+					entries.push_back(node->entry);
+				}
+			}
+		}
+		return entries;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	size_t ConcurrentHashMap<K, V, Allocator>::capacityFor(size_t entries) noexcept {
+		const auto required = static_cast<size_t>(std::ceil(entries / DataEngine<E>::GROWTH_LOAD_FACTOR));
+		return std::bit_ceil(std::max<size_t>(required, STRIPES));
+	}
+}
@@ -0,0 +1,512 @@
+#include "../../Public/Implementation/ConcurrentSkipList.h"
+#include <algorithm>
+#include <bit>
+#include <limits>
+#include <memory>
+#include <new>
+
+namespace core {
+	template<typename K, typename V, typename Allocator>
+	ConcurrentSkipList<K, V, Allocator>::ConcurrentSkipList() : ConcurrentSkipList(Allocator()) {}
+
+	template<typename K, typename V, typename Allocator>
+	ConcurrentSkipList<K, V, Allocator>::ConcurrentSkipList(const Allocator& allocator) : allocator(allocator) {
+		this->maxCapacity = std::numeric_limits<size_t>::max(); //Unbounded, nodes are allocated one at a time
+		this->activeCapacity = 0; //Unused, the live size is the sum of the counters
+		for (auto& link : head) {
+			link.store(0, std::memory_order_relaxed);
+		}
+	}
+
+	template<typename K, typename V, typename Allocator>
+	ConcurrentSkipList<K, V, Allocator>::~ConcurrentSkipList() {
+		//Every node still linked at the bottom is owned by the list, the unlinked ones by the domain
+		Node* node = pointer(head[0].load(std::memory_order_acquire));
+		while (node != nullptr) {
+			Node* next = pointer(node->links()[0].load(std::memory_order_relaxed));
+			deallocate(allocator, node);
+			node = next;
+		}
+	}
+
+	template<typename K, typename V, typename Allocator>
+	bool ConcurrentSkipList<K, V, Allocator>::put(K key, V value) {
+		return insert(std::move(key), std::move(value), true);
+	}
+
+	template<typename K, typename V, typename Allocator>
+	[[nodiscard]] bool ConcurrentSkipList<K, V, Allocator>::get(const K& key, V& value) const {
+		auto guard = domain.pin();
+		Node* predecessor;
+		Node* node = lowerBound(key, &predecessor);
+		if (node == nullptr || key < node->key) {
+			return false;
+		}
+		value = *node->value.load(std::memory_order_acquire);
+		return true;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	bool ConcurrentSkipList<K, V, Allocator>::remove(const K& key) {
+		auto guard = domain.pin();
+		std::atomic<uintptr_t>* predecessors[MAX_HEIGHT];
+		Node* successors[MAX_HEIGHT];
+		if (!find(key, predecessors, successors)) {
+			return false;
+		}
+		Node* node = successors[0];
+		for (int level = node->height - 1; level > 0; level--) {
+			uintptr_t link = node->links()[level].load(std::memory_order_acquire);
+			while (!marked(link) && !node->links()[level].compare_exchange_weak(link, link | MARK)) {}
+		}
+		//Marking the bottom link removes the key, only one remover can win it
+		uintptr_t link = node->links()[0].load(std::memory_order_acquire);
+		do {
+			if (marked(link)) {
+				return false;
+			}
+		} while (!node->links()[0].compare_exchange_weak(link, link | MARK));
+		count(-1);
+		find(key, predecessors, successors);
+		release(node);
+		return true;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	[[nodiscard]] bool ConcurrentSkipList<K, V, Allocator>::containsKey(const K& key) {
+		auto guard = domain.pin();
+		Node* predecessor;
+		Node* node = lowerBound(key, &predecessor);
+		return node != nullptr && !(key < node->key);
+	}
+
+	template<typename K, typename V, typename Allocator>
+	[[nodiscard]] bool ConcurrentSkipList<K, V, Allocator>::containsValue(const V& value) {
+		auto guard = domain.pin();
+		for (Node* node = successor(nullptr, 0); node != nullptr; node = successor(node, 0)) {
+			if (*node->value.load(std::memory_order_acquire) == value) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	[[nodiscard]] bool ConcurrentSkipList<K, V, Allocator>::first(E& entry) {
+		auto guard = domain.pin();
+		Node* node = successor(nullptr, 0);
+		if (node == nullptr) {
+			return false;
+		}
+		entry = read(node);
+		return true;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	[[nodiscard]] bool ConcurrentSkipList<K, V, Allocator>::last(E& entry) {
+		auto guard = domain.pin();
+		Node* node = nullptr;
+		for (int level = MAX_HEIGHT - 1; level >= 0; level--) {
+			for (Node* next = successor(node, level); next != nullptr; next = successor(next, level)) {
+				node = next;
+			}
+		}
+		if (node == nullptr) {
+			return false;
+		}
+		entry = read(node);
+		return true;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	[[nodiscard]] bool ConcurrentSkipList<K, V, Allocator>::ceiling(const K& key, E& entry) {
+		auto guard = domain.pin();
+		Node* predecessor;
+		Node* node = lowerBound(key, &predecessor);
+		if (node == nullptr) {
+			return false;
+		}
+		entry = read(node);
+		return true;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	[[nodiscard]] bool ConcurrentSkipList<K, V, Allocator>::floor(const K& key, E& entry) {
+		auto guard = domain.pin();
+		Node* predecessor;
+		Node* node = lowerBound(key, &predecessor);
+		if (node == nullptr || key < node->key) {
+			node = predecessor;
+		}
+		if (node == nullptr) {
+			return false;
+		}
+		entry = read(node);
+		return true;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	size_t ConcurrentSkipList<K, V, Allocator>::scan(const K& from, std::function<bool(const E&)> visitor) {
+		auto guard = domain.pin();
+		Node* predecessor;
+		size_t visited = 0;
+		for (Node* node = lowerBound(from, &predecessor); node != nullptr; node = successor(node, 0)) {
+			visited++;
+			if (!visitor(read(node))) {
+				break;
+			}
+		}
+		return visited;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	bool ConcurrentSkipList<K, V, Allocator>::putIfAbsent(K key, V value) {
+		return insert(std::move(key), std::move(value), false);
+	}
+
+	template<typename K, typename V, typename Allocator>
+	[[nodiscard]] size_t ConcurrentSkipList<K, V, Allocator>::getActiveSize() const {
+		std::ptrdiff_t size = 0;
+		for (const Counter& counter : counters) {
+			size += counter.value.load(std::memory_order_relaxed);
+		}
+		return static_cast<size_t>(std::max<std::ptrdiff_t>(size, 0));
+	}
+
+	template<typename K, typename V, typename Allocator>
+	void ConcurrentSkipList<K, V, Allocator>::sort() {}
+
+	template<typename K, typename V, typename Allocator>
+	std::unique_ptr<DataEngine<Entry<K, V>>> ConcurrentSkipList<K, V, Allocator>::clone() const {
+		auto copy = std::make_unique<ConcurrentSkipList>(allocator);
+		auto guard = domain.pin();
+		for (Node* node = successor(nullptr, 0); node != nullptr; node = successor(node, 0)) {
+			copy->insert(node->key, *node->value.load(std::memory_order_acquire), true);
+		}
+		return copy;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	std::unique_ptr<DataEngine<Entry<K, V>>> ConcurrentSkipList<K, V, Allocator>::move() {
+		auto moved = std::make_unique<ConcurrentSkipList>(allocator);
+		for (int level = 0; level < MAX_HEIGHT; level++) {
+			moved->head[level].store(head[level].exchange(0, std::memory_order_acq_rel), std::memory_order_release);
+		}
+		for (size_t i = 0; i < COUNTERS; i++) {
+			moved->counters[i].value.store(counters[i].value.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+		}
+		return moved;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	bool ConcurrentSkipList<K, V, Allocator>::removeAll() {
+		bool removed = false;
+		for (;;) {
+			E entry;
+			if (!first(entry)) {
+				return removed;
+			}
+			removed |= remove(entry.key);
+		}
+	}
+
+	template<typename K, typename V, typename Allocator>
+	Entry<K, V>* ConcurrentSkipList<K, V, Allocator>::toArray() const {
+		std::vector<E> entries = snapshot();
+		if (entries.empty()) {
+			return nullptr;
+		}
+		std::unique_ptr<E[]> array(new E[entries.size()]);
+		std::move(entries.begin(), entries.end(), array.get());
+		return array.release();
+	}
+
+	template<typename K, typename V, typename Allocator>
+	Entry<K, V>* ConcurrentSkipList<K, V, Allocator>::toArray(int start, int end) const {
+		std::vector<E> entries = snapshot();
+		if (start < 0 || end <= start || static_cast<size_t>(end) > entries.size()) {
+			return nullptr;
+		}
+		std::unique_ptr<E[]> array(new E[end - start]);
+		std::move(entries.begin() + start, entries.begin() + end, array.get());
+		return array.release();
+	}
+
+	template<typename K, typename V, typename Allocator>
+	size_t ConcurrentSkipList<K, V, Allocator>::copyTo(std::span<Entry<K, V>> destination, size_t start) const {
+		if (destination.empty()) {
+			return 0;
+		}
+		size_t position = 0;
+		size_t copied = 0;
+		auto guard = domain.pin();
+		for (Node* node = successor(nullptr, 0); node != nullptr && copied < destination.size(); node = successor(node, 0)) {
+			if (position++ >= start) {
+				destination[copied++] = read(node);
+			}
+		}
+		return copied;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	void ConcurrentSkipList<K, V, Allocator>::reverse() {}
+
+	template<typename K, typename V, typename Allocator>
+	typename ConcurrentSkipList<K, V, Allocator>::ConcurrentSkipListIterator ConcurrentSkipList<K, V, Allocator>::begin() const {
+		return ConcurrentSkipListIterator(successor(nullptr, 0));
+	}
+
+	template<typename K, typename V, typename Allocator>
+	typename ConcurrentSkipList<K, V, Allocator>::ConcurrentSkipListIterator ConcurrentSkipList<K, V, Allocator>::end() const {
+		return ConcurrentSkipListIterator(nullptr);
+	}
+
+	template<typename K, typename V, typename Allocator>
+	void ConcurrentSkipList<K, V, Allocator>::grow() {}
+
+	template<typename K, typename V, typename Allocator>
+	void ConcurrentSkipList<K, V, Allocator>::shrink() {}
+
+	template<typename K, typename V, typename Allocator>
+	void ConcurrentSkipList<K, V, Allocator>::compress() {}
+
+	template<typename K, typename V, typename Allocator>
+	bool ConcurrentSkipList<K, V, Allocator>::equalsInternal(const DataEngine<E>& de) const {
+		auto other = dynamic_cast<const SkipList<K, V>*>(&de);
+		if (other == nullptr) {
+			return false;
+		}
+		std::vector<E> entries = snapshot();
+		if (entries.size() != other->getActiveSize()) {
+			return false;
+		}
+		if (entries.empty()) {
+			return true;
+		}
+		//Both sides are sorted by key, so equal lists match entry by entry
+		std::unique_ptr<E[]> theirs(other->toArray());
+		return theirs != nullptr && std::equal(entries.begin(), entries.end(), theirs.get());
+	}
+
+	template<typename K, typename V, typename Allocator>
+	[[nodiscard]] bool ConcurrentSkipList<K, V, Allocator>::equivalenceInternal(const DataEngine<E>& de) const {
+		//Entries are ordered by key on both sides, so equivalence and equality coincide
+		return equalsInternal(de);
+	}
+
+	template<typename K, typename V, typename Allocator>
+	std::unique_ptr<DataEngine<Entry<K, V>>> ConcurrentSkipList<K, V, Allocator>::mergeInternal(const DataEngine<E>& de, int start, int end) const {
+		auto other = dynamic_cast<const SkipList<K, V>*>(&de);
+		if (other == nullptr || start < 0 || end < start || static_cast<size_t>(end) > other->getActiveSize()) {
+			return nullptr;
+		}
+		std::unique_ptr<ConcurrentSkipList> merged(static_cast<ConcurrentSkipList*>(clone().release()));
+		if (end > start) {
+			std::unique_ptr<E[]> added(other->toArray(start, end));
+			for (int i = 0; added != nullptr && i < end - start; i++) {
+				merged->insert(std::move(added[i].key), std::move(added[i].value), true);
+			}
+		}
+		return merged;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	typename ConcurrentSkipList<K, V, Allocator>::Node* ConcurrentSkipList<K, V, Allocator>::successor(Node* node, int level) const noexcept {
+		return skip((node == nullptr ? head : node->links())[level].load(std::memory_order_acquire), level);
+	}
+
+	template<typename K, typename V, typename Allocator>
+	typename ConcurrentSkipList<K, V, Allocator>::Node* ConcurrentSkipList<K, V, Allocator>::skip(uintptr_t link, int level) noexcept {
+		Node* node = pointer(link);
+		while (node != nullptr) {
+			const uintptr_t next = node->links()[level].load(std::memory_order_acquire);
+			if (!marked(next)) {
+				return node;
+			}
+			node = pointer(next);
+		}
+		return nullptr;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	bool ConcurrentSkipList<K, V, Allocator>::find(const K& key, std::atomic<uintptr_t>** predecessors, Node** successors) {
+	retry:
+		//Marks, links and the searches of writers are sequentially consistent, so that a remover searching
+		//after marking and an inserter checking for marks after linking cannot both miss each other
+		std::atomic<uintptr_t>* links = head;
+		for (int level = MAX_HEIGHT - 1; level >= 0; level--) {
+			uintptr_t link = links[level].load();
+			if (marked(link)) {
+				goto retry; //The predecessor was removed under us
+			}
+			Node* node = pointer(link);
+			while (node != nullptr) {
+				uintptr_t next = node->links()[level].load();
+				if (marked(next)) {
+					//Snips the removed node at this level, which only succeeds while the predecessor still points to it
+					uintptr_t expected = reinterpret_cast<uintptr_t>(node);
+					if (!links[level].compare_exchange_strong(expected, next & ~MARK)) {
+						goto retry;
+					}
+					node = pointer(next);
+					continue;
+				}
+				if (!(node->key < key)) {
+					break;
+				}
+				links = node->links();
+				node = pointer(next);
+			}
+			predecessors[level] = links + level;
+			successors[level] = node;
+		}
+		return successors[0] != nullptr && !(key < successors[0]->key);
+	}
+
+	template<typename K, typename V, typename Allocator>
+	typename ConcurrentSkipList<K, V, Allocator>::Node* ConcurrentSkipList<K, V, Allocator>::lowerBound(const K& key, Node** predecessor) const {
+		Node* previous = nullptr;
+		Node* node = nullptr;
+		for (int level = MAX_HEIGHT - 1; level >= 0; level--) {
+			node = successor(previous, level);
+			while (node != nullptr && node->key < key) {
+				previous = node;
+				node = successor(node, level);
+			}
+		}
+		*predecessor = previous;
+		return node;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	bool ConcurrentSkipList<K, V, Allocator>::insert(K key, V value, bool replace) {
+		auto guard = domain.pin();
+		std::atomic<uintptr_t>* predecessors[MAX_HEIGHT];
+		Node* successors[MAX_HEIGHT];
+		Node* node = nullptr;
+		for (;;) {
+			//Once the node is made the key and the value live in it, the parameters are moved-from
+			if (find(node == nullptr ? key : node->key, predecessors, successors)) {
+				V* fresh = nullptr;
+				if (node != nullptr) {
+					fresh = node->value.exchange(nullptr, std::memory_order_relaxed);
+					deallocate(allocator, node); //Never published
+				}
+				if (!replace) {
+					destroyObject(allocator, fresh);
+					return false;
+				}
+				if (fresh == nullptr) {
+					fresh = createObject<V>(allocator, std::move(value));
+				}
+				domain.retire(successors[0]->value.exchange(fresh, std::memory_order_acq_rel), allocator);
+				return false;
+			}
+			if (node == nullptr) {
+				node = allocate(std::move(key), std::move(value), randomHeight());
+			}
+			for (int level = 0; level < node->height; level++) {
+				node->links()[level].store(reinterpret_cast<uintptr_t>(successors[level]), std::memory_order_relaxed);
+			}
+			uintptr_t expected = reinterpret_cast<uintptr_t>(successors[0]);
+			if (predecessors[0]->compare_exchange_strong(expected, reinterpret_cast<uintptr_t>(node), std::memory_order_acq_rel)) {
+				break;
+			}
+		}
+		count(1);
+		//The key is visible, the upper levels are only shortcuts and are given up once a remover marks them
+		bool abandoned = false;
+		for (int level = 1; level < node->height && !abandoned; level++) {
+			for (;;) {
+				uintptr_t link = node->links()[level].load(std::memory_order_acquire);
+				const auto target = reinterpret_cast<uintptr_t>(successors[level]);
+				if (marked(link) || (link != target &&
+					!node->links()[level].compare_exchange_strong(link, target, std::memory_order_acq_rel))) {
+					abandoned = true;
+					break;
+				}
+				uintptr_t expected = target;
+				if (predecessors[level]->compare_exchange_strong(expected, reinterpret_cast<uintptr_t>(node))) {
+					//A remover may have marked the level before the node became reachable through it
+					abandoned = marked(node->links()[level].load());
+					break;
+				}
+				find(node->key, predecessors, successors);
+				if (successors[0] != node) {
+					abandoned = true; //Removed meanwhile
+					break;
+				}
+			}
+		}
+		if (abandoned) {
+			find(node->key, predecessors, successors);
+		}
+		release(node);
+		return true;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	void ConcurrentSkipList<K, V, Allocator>::release(Node* node) {
+		if (node->claims.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+			domain.retire(node, [](void* retired, void* context) {
+				deallocate(*static_cast<const Allocator*>(context), static_cast<Node*>(retired));
+			}, &allocator);
+		}
+	}
+
+	template<typename K, typename V, typename Allocator>
+	void ConcurrentSkipList<K, V, Allocator>::count(std::ptrdiff_t delta) noexcept {
+		//Thread local storage sits at the same offset in every thread, only the high address bits differ
+		thread_local const char marker = 0;
+		const size_t index = static_cast<size_t>((reinterpret_cast<uintptr_t>(&marker) * 0x9E3779B97F4A7C15ull) >> 60) & (COUNTERS - 1);
+		counters[index].value.fetch_add(delta, std::memory_order_relaxed);
+	}
+
+	template<typename K, typename V, typename Allocator>
+	std::vector<Entry<K, V>> ConcurrentSkipList<K, V, Allocator>::snapshot() const {
+		std::vector<E> entries;
+		auto guard = domain.pin();
+		for (Node* node = successor(nullptr, 0); node != nullptr; node = successor(node, 0)) {
+			entries.push_back(read(node));
+		}
+		return entries;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	typename ConcurrentSkipList<K, V, Allocator>::Node* ConcurrentSkipList<K, V, Allocator>::allocate(K key, V value, int height) const {
+		NodeUnit* memory = allocateStorage<NodeUnit>(allocator, units(height));
+		Node* node;
+		try {
+			node = ::new (static_cast<void*>(memory)) Node(std::move(key), createObject<V>(allocator, std::move(value)), height);
+		}
+		catch (...) {
+			deallocateStorage(allocator, memory, units(height));
+			throw;
+		}
+		for (int level = 0; level < height; level++) {
+			::new (static_cast<void*>(node->links() + level)) std::atomic<uintptr_t>(0);
+		}
+		return node;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	void ConcurrentSkipList<K, V, Allocator>::deallocate(const Allocator& allocator, Node* node) noexcept {
+		const int height = node->height;
+		destroyObject(allocator, node->value.load(std::memory_order_relaxed));
+		std::destroy_at(node);
+		deallocateStorage(allocator, reinterpret_cast<NodeUnit*>(node), units(height));
+	}
+
+	template<typename K, typename V, typename Allocator>
+	int ConcurrentSkipList<K, V, Allocator>::randomHeight() noexcept {
+		thread_local uint64_t state = 0;
+		if (state == 0) {
+			state = (reinterpret_cast<uintptr_t>(&state) * 0x9E3779B97F4A7C15ull) | 1;
+		}
+		state ^= state << 13;
+		state ^= state >> 7;
+		state ^= state << 17;
+		//Each pair of trailing zero bits adds a level, which happens with probability 1/4
+		return 1 + std::countr_zero(state | (uint64_t{ 1 } << (2 * (MAX_HEIGHT - 1)))) / 2;
+	}
+}
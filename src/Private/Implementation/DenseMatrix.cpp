@@ -0,0 +1,530 @@
+#include "../../Public/Implementation/DenseMatrix.h"
+
+namespace core {
+	template<typename E, typename Allocator>
+	DenseMatrix<E, Allocator>::DenseMatrix() : DenseMatrix(Allocator()) {}
+
+	template<typename E, typename Allocator>
+	DenseMatrix<E, Allocator>::DenseMatrix(const Allocator& allocator) : allocator(allocator), values(nullptr), rows(0), columns(0), stride(0) {
+		this->activeCapacity = 0;
+		this->maxCapacity = 0;
+	}
+
+	template<typename E, typename Allocator>
+	DenseMatrix<E, Allocator>::DenseMatrix(size_t rows, size_t columns, const Allocator& allocator) : allocator(allocator), rows(rows), columns(columns),
+		stride((columns + LINE - 1) / LINE * LINE) {
+		values = allocate(rows * stride);
+		this->activeCapacity = rows * columns;
+		this->maxCapacity = rows * stride;
+	}
+
+	template<typename E, typename Allocator>
+	DenseMatrix<E, Allocator>::DenseMatrix(size_t rows, size_t columns, const E* values, const Allocator& allocator) :
+		DenseMatrix(rows, columns, allocator) {
+		for (size_t row = 0; row < rows; row++) {
+			std::copy_n(values + row * columns, columns, getRow(row));
+		}
+	}
+
+	template<typename E, typename Allocator>
+	template<MatrixExpression Expression> requires std::same_as<typename Expression::Element, E>
+	DenseMatrix<E, Allocator>::DenseMatrix(const Expression& expression, const Allocator& allocator) :
+		DenseMatrix(expression.getRows(), expression.getColumns(), allocator) {
+		evaluate(expression);
+	}
+
+	template<typename E, typename Allocator>
+	DenseMatrix<E, Allocator>::~DenseMatrix() {
+		release(values, this->maxCapacity);
+	}
+
+	template<typename E, typename Allocator>
+	DenseMatrix<E, Allocator>::DenseMatrix(DenseMatrix&& other) noexcept : allocator(other.allocator), values(other.values), rows(other.rows),
+		columns(other.columns), stride(other.stride) {
+		this->activeCapacity = other.activeCapacity;
+		this->maxCapacity = other.maxCapacity;
+		other.values = nullptr;
+		other.rows = 0;
+		other.columns = 0;
+		other.stride = 0;
+		other.activeCapacity = 0;
+		other.maxCapacity = 0;
+	}
+
+	template<typename E, typename Allocator>
+	DenseMatrix<E, Allocator>& DenseMatrix<E, Allocator>::operator=(DenseMatrix&& other) noexcept(takesStorageOnMove<Allocator>) {
+		if (this != &other) {
+			requireStorageOnMove(allocator, other.allocator);
+			release(values, this->maxCapacity);
+			propagateOnMove(allocator, other.allocator);
+			values = other.values;
+			rows = other.rows;
+			columns = other.columns;
+			stride = other.stride;
+			this->activeCapacity = other.activeCapacity;
+			this->maxCapacity = other.maxCapacity;
+			other.values = nullptr;
+			other.rows = 0;
+			other.columns = 0;
+			other.stride = 0;
+			other.activeCapacity = 0;
+			other.maxCapacity = 0;
+		}
+		return *this;
+	}
+
+	template<typename E, typename Allocator>
+	template<MatrixExpression Expression> requires std::same_as<typename Expression::Element, E>
+	DenseMatrix<E, Allocator>& DenseMatrix<E, Allocator>::operator=(const Expression& expression) {
+		if (expression.getRows() != rows || expression.getColumns() != columns || expression.aliases(*this)) {
+			DenseMatrix evaluated(expression, allocator);
+			*this = std::move(evaluated);
+		}
+		else {
+			evaluate(expression);
+		}
+		return *this;
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] size_t DenseMatrix<E, Allocator>::getRows() const {
+		return rows;
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] size_t DenseMatrix<E, Allocator>::getColumns() const {
+		return columns;
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] E DenseMatrix<E, Allocator>::get(size_t row, size_t column) const {
+		if (row >= rows || column >= columns) {
+			throw std::out_of_range("matrix position out of range");
+		}
+		return values[row * stride + column];
+	}
+
+	template<typename E, typename Allocator>
+	bool DenseMatrix<E, Allocator>::set(size_t row, size_t column, E value) {
+		if (row >= rows || column >= columns) {
+			throw std::out_of_range("matrix position out of range");
+		}
+		values[row * stride + column] = value;
+		return true;
+	}
+
+	template<typename E, typename Allocator>
+	void DenseMatrix<E, Allocator>::fill(E value) {
+		for (size_t row = 0; row < rows; row++) {
+			std::fill_n(getRow(row), columns, value);
+		}
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] DenseMatrix<E, Allocator> DenseMatrix<E, Allocator>::transpose() const {
+		DenseMatrix transposed(columns, rows, allocator);
+		for (size_t top = 0; top < rows; top += LINE) {
+			const size_t bottom = std::min(top + LINE, rows);
+			for (size_t left = 0; left < columns; left += LINE) {
+				const size_t right = std::min(left + LINE, columns);
+				for (size_t row = top; row < bottom; row++) {
+					for (size_t column = left; column < right; column++) {
+						transposed.values[column * transposed.stride + row] = values[row * stride + column];
+					}
+				}
+			}
+		}
+		return transposed;
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] DenseMatrix<E, Allocator> DenseMatrix<E, Allocator>::multiply(const DenseMatrix& other, unsigned threads) const {
+		DenseMatrix product(rows, other.columns, allocator);
+		multiply(*this, other, product, threads);
+		return product;
+	}
+
+	template<typename E, typename Allocator>
+	void DenseMatrix<E, Allocator>::multiply(const DenseMatrix& left, const DenseMatrix& right, DenseMatrix& result, unsigned threads) {
+		if (left.columns != right.rows || result.rows != left.rows || result.columns != right.columns) {
+			throw std::invalid_argument("matrix sizes do not match");
+		}
+		if (&result == &left || &result == &right) {
+			throw std::invalid_argument("the result of a product cannot be one of its operands");
+		}
+		result.fill(E());
+		const size_t work = left.rows * right.columns * left.columns;
+		if (work == 0) {
+			return;
+		}
+		const size_t workers = parallelWorkers(threads, work, THREAD_WORK);
+		if (workers == 1) {
+			multiplyBlock(left, right, result, 0, result.rows, 0, result.columns);
+			return;
+		}
+
+		//Splits the result into the grid of blocks closest to square, block edges on kernel boundaries
+		size_t gridRows = 1;
+		double best = -1;
+		for (size_t candidate = 1; candidate <= workers; candidate++) {
+			if (workers % candidate == 0) {
+				const double perimeter = double(result.rows) / candidate + double(result.columns) / (workers / candidate);
+				if (best < 0 || perimeter < best) {
+					best = perimeter;
+					gridRows = candidate;
+				}
+			}
+		}
+		const size_t gridColumns = workers / gridRows;
+		auto rowEdge = [&](size_t part) {
+			return part == gridRows ? result.rows : result.rows * part / gridRows / KERNEL_ROWS * KERNEL_ROWS;
+		};
+		auto columnEdge = [&](size_t part) {
+			return part == gridColumns ? result.columns : result.columns * part / gridColumns / KERNEL_COLUMNS * KERNEL_COLUMNS;
+		};
+
+		parallel(workers, [&](size_t worker) {
+			const size_t gridRow = worker / gridColumns;
+			const size_t gridColumn = worker % gridColumns;
+			const size_t rowBegin = rowEdge(gridRow), rowEnd = rowEdge(gridRow + 1);
+			const size_t columnBegin = columnEdge(gridColumn), columnEnd = columnEdge(gridColumn + 1);
+			if (rowBegin != rowEnd && columnBegin != columnEnd) {
+				multiplyBlock(left, right, result, rowBegin, rowEnd, columnBegin, columnEnd);
+			}
+		});
+	}
+
+	template<typename E, typename Allocator>
+	std::unique_ptr<DataEngine<E>> DenseMatrix<E, Allocator>::clone() const {
+		auto copy = std::make_unique<DenseMatrix>(rows, columns, allocator);
+		if (values != nullptr) {
+			std::memcpy(copy->values, values, rows * stride * sizeof(E));
+		}
+		return copy;
+	}
+
+	template<typename E, typename Allocator>
+	std::unique_ptr<DataEngine<E>> DenseMatrix<E, Allocator>::move() {
+		return std::make_unique<DenseMatrix>(std::move(*this));
+	}
+
+	template<typename E, typename Allocator>
+	bool DenseMatrix<E, Allocator>::removeAll() {
+		if (this->activeCapacity == 0) {
+			return false;
+		}
+		*this = DenseMatrix(allocator);
+		return true;
+	}
+
+	template<typename E, typename Allocator>
+	E* DenseMatrix<E, Allocator>::toArray() const {
+		if (this->activeCapacity == 0) {
+			return nullptr;
+		}
+		std::unique_ptr<E[]> array(new E[this->activeCapacity]);
+		for (size_t row = 0; row < rows; row++) {
+			std::copy_n(getRow(row), columns, array.get() + row * columns);
+		}
+		return array.release();
+	}
+
+	template<typename E, typename Allocator>
+	E* DenseMatrix<E, Allocator>::toArray(int start, int end) const {
+		if (start < 0 || end <= start || static_cast<size_t>(end) > this->activeCapacity) {
+			return nullptr;
+		}
+		std::unique_ptr<E[]> array(new E[end - start]);
+		copyTo(std::span<E>(array.get(), end - start), start);
+		return array.release();
+	}
+
+	template<typename E, typename Allocator>
+	size_t DenseMatrix<E, Allocator>::copyTo(std::span<E> destination, size_t start) const {
+		if (destination.empty() || start >= this->activeCapacity) {
+			return 0;
+		}
+		const size_t count = std::min(destination.size(), this->activeCapacity - start);
+		for (size_t index = start, copied = 0; copied < count; ) {
+			const size_t row = index / columns;
+			const size_t column = index % columns;
+			const size_t taken = std::min(columns - column, count - copied);
+			std::copy_n(getRow(row) + column, taken, destination.data() + copied);
+			index += taken;
+			copied += taken;
+		}
+		return count;
+	}
+
+	template<typename E, typename Allocator>
+	void DenseMatrix<E, Allocator>::reverse() {
+		for (size_t top = 0, bottom = rows; top + 1 < bottom; top++, bottom--) {
+			std::swap_ranges(getRow(top), getRow(top) + columns, std::make_reverse_iterator(getRow(bottom - 1) + columns));
+		}
+		if (rows % 2 == 1) {
+			std::reverse(getRow(rows / 2), getRow(rows / 2) + columns);
+		}
+	}
+
+	template<typename E, typename Allocator>
+	typename DenseMatrix<E, Allocator>::iterator DenseMatrix<E, Allocator>::begin() {
+		return iterator(values, columns, stride);
+	}
+
+	template<typename E, typename Allocator>
+	typename DenseMatrix<E, Allocator>::const_iterator DenseMatrix<E, Allocator>::begin() const {
+		return const_iterator(values, columns, stride);
+	}
+
+	template<typename E, typename Allocator>
+	typename DenseMatrix<E, Allocator>::iterator DenseMatrix<E, Allocator>::end() {
+		return iterator(values + rows * stride, columns, stride);
+	}
+
+	template<typename E, typename Allocator>
+	typename DenseMatrix<E, Allocator>::const_iterator DenseMatrix<E, Allocator>::end() const {
+		return const_iterator(values + rows * stride, columns, stride);
+	}
+
+	template<typename E, typename Allocator>
+	void DenseMatrix<E, Allocator>::grow() {}
+
+	template<typename E, typename Allocator>
+	void DenseMatrix<E, Allocator>::shrink() {}
+
+	template<typename E, typename Allocator>
+	void DenseMatrix<E, Allocator>::compress() {}
+
+	template<typename E, typename Allocator>
+	bool DenseMatrix<E, Allocator>::equalsInternal(const DataEngine<E>& de) const {
+		if (auto matrix = dynamic_cast<const DenseMatrix*>(&de)) {
+			return equalTo(*matrix);
+		}
+		auto other = dynamic_cast<const Matrix<E>*>(&de);
+		if (other == nullptr || other->getRows() != rows || other->getColumns() != columns) {
+			return false;
+		}
+		if (this->activeCapacity == 0) {
+			return true;
+		}
+		std::unique_ptr<E[]> items(other->toArray());
+		for (size_t row = 0; row < rows; row++) {
+			if (!std::equal(getRow(row), getRow(row) + columns, items.get() + row * columns)) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] bool DenseMatrix<E, Allocator>::equivalenceInternal(const DataEngine<E>& de) const {
+		auto other = dynamic_cast<const Matrix<E>*>(&de);
+		if (other == nullptr || other->getActiveSize() != this->activeCapacity) {
+			return false;
+		}
+		if (this->activeCapacity == 0) {
+			return true;
+		}
+		std::unique_ptr<E[]> mine(toArray());
+		std::unique_ptr<E[]> theirs(other->toArray());
+		std::sort(mine.get(), mine.get() + this->activeCapacity);
+		std::sort(theirs.get(), theirs.get() + this->activeCapacity);
+		return std::equal(mine.get(), mine.get() + this->activeCapacity, theirs.get());
+	}
+
+	template<typename E, typename Allocator>
+	std::unique_ptr<DataEngine<E>> DenseMatrix<E, Allocator>::mergeInternal(const DataEngine<E>& de, int start, int end) const {
+		if (auto matrix = dynamic_cast<const DenseMatrix*>(&de)) {
+			return mergeWith(*matrix, start, end);
+		}
+		auto other = dynamic_cast<const Matrix<E>*>(&de);
+		if (other == nullptr || start < 0 || end < start || static_cast<size_t>(end) > other->getRows()) {
+			return nullptr;
+		}
+		//A matrix without rows takes the width of the other one
+		const size_t width = rows == 0 ? other->getColumns() : columns;
+		if (other->getColumns() != width) {
+			return nullptr;
+		}
+		auto merged = std::make_unique<DenseMatrix>(rows + (end - start), width, allocator);
+		for (size_t row = 0; row < rows; row++) {
+			std::copy_n(getRow(row), columns, merged->getRow(row));
+		}
+		if (end > start && width > 0) {
+			std::unique_ptr<E[]> added(other->toArray(static_cast<int>(start * width), static_cast<int>(end * width)));
+			for (size_t row = 0; row < static_cast<size_t>(end - start); row++) {
+				std::copy_n(added.get() + row * width, width, merged->getRow(rows + row));
+			}
+		}
+		return merged;
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] bool DenseMatrix<E, Allocator>::equalTo(const DenseMatrix& other) const {
+		if (other.rows != rows || other.columns != columns) {
+			return false;
+		}
+		for (size_t row = 0; row < rows; row++) {
+			if (!std::equal(getRow(row), getRow(row) + columns, other.getRow(row))) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] std::unique_ptr<DenseMatrix<E, Allocator>> DenseMatrix<E, Allocator>::mergeWith(const DenseMatrix& other, int start, int end) const {
+		if (start < 0 || end < start || static_cast<size_t>(end) > other.rows) {
+			return nullptr;
+		}
+		const size_t width = rows == 0 ? other.columns : columns;
+		if (other.columns != width) {
+			return nullptr;
+		}
+		auto merged = std::make_unique<DenseMatrix>(rows + (end - start), width, allocator);
+		for (size_t row = 0; row < rows; row++) {
+			std::copy_n(getRow(row), columns, merged->getRow(row));
+		}
+		for (size_t row = static_cast<size_t>(start); row < static_cast<size_t>(end); row++) {
+			std::copy_n(other.getRow(row), width, merged->getRow(rows + row - start));
+		}
+		return merged;
+	}
+
+	template<typename E, typename Allocator>
+	template<typename Expression>
+	void DenseMatrix<E, Allocator>::evaluate(const Expression& expression) noexcept {
+		const size_t vectorColumns = columns / Lanes::WIDTH * Lanes::WIDTH;
+		for (size_t row = 0; row < rows; row++) {
+			E* line = getRow(row);
+			size_t column = 0;
+			for (; column < vectorColumns; column += Lanes::WIDTH) {
+				Lanes::store(line + column, expression.packet(row, column));
+			}
+			for (; column < columns; column++) {
+				line[column] = expression(row, column);
+			}
+		}
+	}
+
+	template<typename E, typename Allocator>
+	E* DenseMatrix<E, Allocator>::allocate(size_t count) const {
+		if (count == 0) {
+			return nullptr;
+		}
+		auto block = reinterpret_cast<E*>(allocateStorage<Line>(allocator, (count * sizeof(E) + ALIGNMENT - 1) / ALIGNMENT));
+		std::memset(block, 0, count * sizeof(E));
+		return block;
+	}
+
+	template<typename E, typename Allocator>
+	void DenseMatrix<E, Allocator>::release(E* block, size_t count) const noexcept {
+		if (block != nullptr) {
+			deallocateStorage(allocator, reinterpret_cast<Line*>(block), (count * sizeof(E) + ALIGNMENT - 1) / ALIGNMENT);
+		}
+	}
+
+	template<typename E, typename Allocator>
+	void DenseMatrix<E, Allocator>::multiplyBlock(const DenseMatrix& left, const DenseMatrix& right, DenseMatrix& result,
+		size_t rowBegin, size_t rowEnd, size_t columnBegin, size_t columnEnd) {
+		const size_t depth = left.columns;
+		const size_t panelWidth = std::min(COLUMN_BLOCK, (columnEnd - columnBegin + KERNEL_COLUMNS - 1) / KERNEL_COLUMNS * KERNEL_COLUMNS);
+		const size_t panelHeight = std::min(ROW_BLOCK, (rowEnd - rowBegin + KERNEL_ROWS - 1) / KERNEL_ROWS * KERNEL_ROWS);
+		const size_t panelDepth = std::min(DEPTH_BLOCK, depth);
+		//The packed panels are drawn from the allocator of the result like its elements
+		auto releaseLeft = [&](E* block) { result.release(block, panelHeight * panelDepth); };
+		auto releaseRight = [&](E* block) { result.release(block, panelDepth * panelWidth); };
+		std::unique_ptr<E, decltype(releaseLeft)> packedLeft(result.allocate(panelHeight * panelDepth), releaseLeft);
+		std::unique_ptr<E, decltype(releaseRight)> packedRight(result.allocate(panelDepth * panelWidth), releaseRight);
+
+		for (size_t columnBlock = columnBegin; columnBlock < columnEnd; columnBlock += COLUMN_BLOCK) {
+			const size_t width = std::min(COLUMN_BLOCK, columnEnd - columnBlock);
+			for (size_t depthBlock = 0; depthBlock < depth; depthBlock += DEPTH_BLOCK) {
+				const size_t slice = std::min(DEPTH_BLOCK, depth - depthBlock);
+				packRight(right.getRow(depthBlock) + columnBlock, right.stride, slice, width, packedRight.get());
+				for (size_t rowBlock = rowBegin; rowBlock < rowEnd; rowBlock += ROW_BLOCK) {
+					const size_t height = std::min(ROW_BLOCK, rowEnd - rowBlock);
+					packLeft(left.getRow(rowBlock) + depthBlock, left.stride, height, slice, packedLeft.get());
+
+					//The right micro-panel stays in the first level cache while the kernel runs down the rows
+					for (size_t column = 0; column < width; column += KERNEL_COLUMNS) {
+						const E* panelRight = packedRight.get() + column * slice;
+						for (size_t row = 0; row < height; row += KERNEL_ROWS) {
+							const E* panelLeft = packedLeft.get() + row * slice;
+							E* target = result.getRow(rowBlock + row) + columnBlock + column;
+							if (row + KERNEL_ROWS <= height && column + KERNEL_COLUMNS <= width) {
+								kernel(slice, panelLeft, panelRight, target, result.stride, KernelBlock());
+								continue;
+							}
+							//Partial blocks at the edges go through a scratch block
+							alignas(ALIGNMENT) E edge[KERNEL_ROWS * KERNEL_COLUMNS] = {};
+							kernel(slice, panelLeft, panelRight, edge, KERNEL_COLUMNS, KernelBlock());
+							const size_t edgeRows = std::min(KERNEL_ROWS, height - row);
+							const size_t edgeColumns = std::min(KERNEL_COLUMNS, width - column);
+							for (size_t i = 0; i < edgeRows; i++) {
+								for (size_t j = 0; j < edgeColumns; j++) {
+									target[i * result.stride + j] += edge[i * KERNEL_COLUMNS + j];
+								}
+							}
+						}
+					}
+				}
+			}
+		}
+	}
+
+	template<typename E, typename Allocator>
+	void DenseMatrix<E, Allocator>::packLeft(const E* source, size_t sourceStride, size_t height, size_t depth, E* target) noexcept {
+		for (size_t panel = 0; panel < height; panel += KERNEL_ROWS) {
+			const size_t count = std::min(KERNEL_ROWS, height - panel);
+			for (size_t row = 0; row < count; row++) {
+				const E* line = source + (panel + row) * sourceStride;
+				for (size_t k = 0; k < depth; k++) {
+					target[k * KERNEL_ROWS + row] = line[k];
+				}
+			}
+			for (size_t row = count; row < KERNEL_ROWS; row++) {
+				for (size_t k = 0; k < depth; k++) {
+					target[k * KERNEL_ROWS + row] = E();
+				}
+			}
+			target += KERNEL_ROWS * depth;
+		}
+	}
+
+	template<typename E, typename Allocator>
+	void DenseMatrix<E, Allocator>::packRight(const E* source, size_t sourceStride, size_t depth, size_t width, E* target) noexcept {
+		for (size_t panel = 0; panel < width; panel += KERNEL_COLUMNS) {
+			const size_t count = std::min(KERNEL_COLUMNS, width - panel);
+			for (size_t k = 0; k < depth; k++) {
+				const E* line = source + k * sourceStride + panel;
+				std::copy_n(line, count, target);
+				std::fill(target + count, target + KERNEL_COLUMNS, E());
+				target += KERNEL_COLUMNS;
+			}
+		}
+	}
+
+	template<typename E, typename Allocator>
+	template<size_t... Index>
+	void DenseMatrix<E, Allocator>::kernel(size_t depth, const E* left, const E* right, E* target, size_t targetStride,
+		std::index_sequence<Index...>) noexcept {
+		//Index runs over the vectors of the block row by row. Expanding it as packs unrolls the block
+		//completely whatever the optimizer settings, so that the sums stay in registers
+		constexpr size_t VECTORS = Lanes::KERNEL_VECTORS;
+		Vector sums[sizeof...(Index)];
+		((sums[Index] = Lanes::zero()), ...);
+		for (size_t k = 0; k < depth; k++) {
+			Vector operands[VECTORS];
+			[&]<size_t... Vectors>(std::index_sequence<Vectors...>) {
+				((operands[Vectors] = Lanes::load(right + Vectors * Lanes::WIDTH)), ...);
+			}(std::make_index_sequence<VECTORS>());
+			((sums[Index] = Lanes::multiplyAdd(Lanes::broadcast(left[Index / VECTORS]), operands[Index % VECTORS], sums[Index])), ...);
+			left += KERNEL_ROWS;
+			right += KERNEL_COLUMNS;
+		}
+		E* line;
+		((line = target + Index / VECTORS * targetStride + Index % VECTORS * Lanes::WIDTH,
+			Lanes::store(line, Lanes::add(Lanes::load(line), sums[Index]))), ...);
+	}
+}
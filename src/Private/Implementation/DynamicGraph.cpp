@@ -0,0 +1,602 @@
+#include "../../Public/Implementation/DynamicGraph.h"
+#include <algorithm>
+
+namespace core {
+	template<typename E, typename Allocator>
+	DynamicGraph<E, Allocator>::DynamicGraph() : DynamicGraph(0, true) {}
+
+	template<typename E, typename Allocator>
+	DynamicGraph<E, Allocator>::DynamicGraph(const Allocator& allocator) : DynamicGraph(0, true, allocator) {}
+
+	template<typename E, typename Allocator>
+	DynamicGraph<E, Allocator>::DynamicGraph(size_t vertices, bool directed, const Allocator& allocator) : allocator(allocator),
+		directed(directed), blank(allocator), current(nullptr) {
+		if (vertices > NONE) {
+			throw std::length_error("too many vertices for the identifier type");
+		}
+		current.store(empty(vertices).release(), std::memory_order_relaxed);
+		this->maxCapacity = std::numeric_limits<size_t>::max(); //Unbounded, pages are allocated as arcs arrive
+		this->activeCapacity = 0; //Unused, the live size is that of the current version
+	}
+
+	template<typename E, typename Allocator>
+	DynamicGraph<E, Allocator>::DynamicGraph(size_t vertices, const GraphEdge<E>* edges, size_t count, bool directed, unsigned threads,
+		const Allocator& allocator) : DynamicGraph(vertices, directed, allocator) {
+		insertEdges(edges, count, threads);
+	}
+
+	template<typename E, typename Allocator>
+	DynamicGraph<E, Allocator>::~DynamicGraph() {
+		release(current.load(std::memory_order_relaxed));
+	}
+
+	template<typename E, typename Allocator>
+	DynamicGraph<E, Allocator>::DynamicGraph(DynamicGraph&& other) : allocator(other.allocator), directed(other.directed),
+		blank(other.allocator), current(nullptr) {
+		//The other graph is left with an empty version, allocated before anything is taken from it
+		auto vacant = other.empty(0);
+		current.store(other.current.load(std::memory_order_relaxed), std::memory_order_relaxed);
+		other.current.store(vacant.release(), std::memory_order_relaxed);
+		//The pages without arcs pointed to the blank page of the other graph
+		for (const Page*& page : const_cast<Version*>(current.load(std::memory_order_relaxed))->pages) {
+			if (page == &other.blank) {
+				page = &blank;
+			}
+		}
+		this->maxCapacity = other.maxCapacity;
+		this->activeCapacity = 0;
+	}
+
+	template<typename E, typename Allocator>
+	DynamicGraph<E, Allocator>& DynamicGraph<E, Allocator>::operator=(DynamicGraph&& other) {
+		if (this != &other) {
+			requireStorageOnMove(allocator, other.allocator);
+			auto vacant = other.empty(0);
+			release(current.load(std::memory_order_relaxed));
+			//The retired pages and versions go back to the allocator they came from before it is replaced
+			domain.drain();
+			propagateOnMove(allocator, other.allocator);
+			directed = other.directed;
+			current.store(other.current.load(std::memory_order_relaxed), std::memory_order_relaxed);
+			for (const Page*& page : const_cast<Version*>(current.load(std::memory_order_relaxed))->pages) {
+				if (page == &other.blank) {
+					page = &blank;
+				}
+			}
+			other.current.store(vacant.release(), std::memory_order_relaxed);
+		}
+		return *this;
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] size_t DynamicGraph<E, Allocator>::getVertices() const {
+		return snapshot().getVertices();
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] bool DynamicGraph<E, Allocator>::isDirected() const {
+		return directed;
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] size_t DynamicGraph<E, Allocator>::getDegree(E vertex) const {
+		auto view = snapshot();
+		if (vertex >= view.getVertices()) {
+			throw std::out_of_range("vertex out of range");
+		}
+		return view.getDegree(vertex);
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] bool DynamicGraph<E, Allocator>::containsEdge(E source, E target) const {
+		auto view = snapshot();
+		if (source >= view.getVertices() || target >= view.getVertices()) {
+			throw std::out_of_range("vertex out of range");
+		}
+		auto arcs = view.neighbors(source);
+		return std::binary_search(arcs.begin(), arcs.end(), target);
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] std::vector<E> DynamicGraph<E, Allocator>::getNeighbors(E vertex) const {
+		auto view = snapshot();
+		if (vertex >= view.getVertices()) {
+			throw std::out_of_range("vertex out of range");
+		}
+		auto arcs = view.neighbors(vertex);
+		return std::vector<E>(arcs.begin(), arcs.end());
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] size_t DynamicGraph<E, Allocator>::getActiveSize() const {
+		return snapshot().getArcs();
+	}
+
+	template<typename E, typename Allocator>
+	size_t DynamicGraph<E, Allocator>::insertEdges(const GraphEdge<E>* edges, size_t count, unsigned threads) {
+		return update(edges, count, false, threads);
+	}
+
+	template<typename E, typename Allocator>
+	size_t DynamicGraph<E, Allocator>::removeEdges(const GraphEdge<E>* edges, size_t count, unsigned threads) {
+		return update(edges, count, true, threads);
+	}
+
+	template<typename E, typename Allocator>
+	bool DynamicGraph<E, Allocator>::insertEdge(E source, E target) {
+		const GraphEdge<E> edge{ source, target };
+		return update(&edge, 1, false, 1) != 0;
+	}
+
+	template<typename E, typename Allocator>
+	bool DynamicGraph<E, Allocator>::removeEdge(E source, E target) {
+		const GraphEdge<E> edge{ source, target };
+		return update(&edge, 1, true, 1) != 0;
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] std::vector<E> DynamicGraph<E, Allocator>::breadthFirst(E source, unsigned threads) const {
+		auto view = snapshot();
+		if (source >= view.getVertices()) {
+			throw std::out_of_range("vertex out of range");
+		}
+		std::vector<E> parents(view.getVertices(), NONE);
+		parents[source] = source;
+		std::vector<E> frontier{ source };
+		std::vector<E> next;
+		size_t work = view.getDegree(source);
+		while (!frontier.empty()) {
+			const size_t count = CSRGraph<E, Allocator>::workers(threads, work);
+			if (count == 1) {
+				work = 0;
+				next.clear();
+				for (E vertex : frontier) {
+					for (E target : view.neighbors(vertex)) {
+						if (parents[target] == NONE) {
+							parents[target] = vertex;
+							next.push_back(target);
+							work += view.getDegree(target);
+						}
+					}
+				}
+			}
+			else {
+				std::vector<size_t> scouts(count, 0);
+				std::atomic<size_t> cursor = 0;
+				CSRGraph<E, Allocator>::collect(count, next, [&](size_t worker, std::vector<E>& claimed) {
+					size_t scout = 0;
+					for (size_t first; (first = cursor.fetch_add(CSRGraph<E, Allocator>::FRONTIER_CHUNK, std::memory_order_relaxed)) < frontier.size();) {
+						const size_t last = std::min(first + CSRGraph<E, Allocator>::FRONTIER_CHUNK, frontier.size());
+						for (size_t i = first; i < last; i++) {
+							const E vertex = frontier[i];
+							for (E target : view.neighbors(vertex)) {
+								std::atomic_ref<E> parent(parents[target]);
+								E expected = NONE;
+								if (parent.load(std::memory_order_relaxed) == NONE && parent.compare_exchange_strong(expected, vertex, std::memory_order_relaxed)) {
+									claimed.push_back(target);
+									scout += view.getDegree(target);
+								}
+							}
+						}
+					}
+					scouts[worker] = scout;
+				});
+				work = 0;
+				for (size_t scout : scouts) {
+					work += scout;
+				}
+			}
+			frontier.swap(next);
+		}
+		return parents;
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] CSRGraph<E, Allocator> DynamicGraph<E, Allocator>::toCSR(unsigned threads) const {
+		auto view = snapshot();
+		const size_t vertices = view.getVertices();
+		CSRGraph<E, Allocator> graph(allocator);
+		graph.vertices = vertices;
+		graph.directed = directed;
+		graph.offsets.assign(vertices + 1, 0);
+		graph.targets.reserve(view.getArcs());
+		for (size_t vertex = 0; vertex < vertices; vertex++) {
+			auto arcs = view.neighbors(static_cast<E>(vertex));
+			graph.targets.insert(graph.targets.end(), arcs.begin(), arcs.end());
+			graph.offsets[vertex + 1] = graph.targets.size();
+		}
+		if (directed) {
+			auto arcs = edges(view);
+			CSRGraph<E, Allocator>::build(vertices, arcs.data(), arcs.size(), true, false, threads,
+				graph.reverseOffsets, graph.reverseTargets, graph.reverseWeights);
+		}
+		else {
+			graph.reverseOffsets.clear();
+		}
+		graph.activeCapacity = graph.targets.size();
+		graph.maxCapacity = graph.targets.size();
+		return graph;
+	}
+
+	template<typename E, typename Allocator>
+	void DynamicGraph<E, Allocator>::sort() {}
+
+	template<typename E, typename Allocator>
+	std::unique_ptr<DataEngine<E>> DynamicGraph<E, Allocator>::clone() const {
+		auto view = snapshot();
+		auto copy = std::make_unique<DynamicGraph>(0, directed, allocator);
+		auto version = copy->empty(view.getVertices());
+		std::vector<ObjectPtr<Page, Allocator>> pages(version->pages.size());
+		for (size_t page = 0; page < pages.size(); page++) {
+			if (view.version->pages[page] != &blank) {
+				pages[page] = makeObject<Page>(copy->allocator, *view.version->pages[page], copy->allocator);
+			}
+		}
+		for (size_t page = 0; page < pages.size(); page++) {
+			if (pages[page] != nullptr) {
+				version->pages[page] = pages[page].release();
+			}
+		}
+		version->arcs = view.getArcs();
+		copy->release(copy->current.exchange(version.release(), std::memory_order_relaxed));
+		return copy;
+	}
+
+	template<typename E, typename Allocator>
+	std::unique_ptr<DataEngine<E>> DynamicGraph<E, Allocator>::move() {
+		return std::make_unique<DynamicGraph>(std::move(*this));
+	}
+
+	template<typename E, typename Allocator>
+	bool DynamicGraph<E, Allocator>::removeAll() {
+		std::lock_guard<std::mutex> lock(writer);
+		const Version* base = current.load(std::memory_order_relaxed);
+		if (base->arcs == 0) {
+			return false;
+		}
+		publish(empty(base->vertices));
+		return true;
+	}
+
+	template<typename E, typename Allocator>
+	E* DynamicGraph<E, Allocator>::toArray() const {
+		auto view = snapshot();
+		if (view.getArcs() == 0) {
+			return nullptr;
+		}
+		std::unique_ptr<E[]> array(new E[view.getArcs()]);
+		E* out = array.get();
+		for (const Page* page : view.version->pages) {
+			out = std::copy(page->targets.begin(), page->targets.end(), out);
+		}
+		return array.release();
+	}
+
+	template<typename E, typename Allocator>
+	E* DynamicGraph<E, Allocator>::toArray(int start, int end) const {
+		auto view = snapshot();
+		if (start < 0 || end <= start || static_cast<size_t>(end) > view.getArcs()) {
+			return nullptr;
+		}
+		std::unique_ptr<E[]> array(new E[end - start]);
+		size_t skip = start;
+		size_t left = end - start;
+		E* out = array.get();
+		for (const Page* page : view.version->pages) {
+			const size_t size = page->targets.size();
+			if (skip >= size) {
+				skip -= size;
+				continue;
+			}
+			const size_t taken = std::min(size - skip, left);
+			out = std::copy_n(page->targets.begin() + skip, taken, out);
+			left -= taken;
+			skip = 0;
+			if (left == 0) {
+				break;
+			}
+		}
+		return array.release();
+	}
+
+	template<typename E, typename Allocator>
+	size_t DynamicGraph<E, Allocator>::copyTo(std::span<E> destination, size_t start) const {
+		auto view = snapshot();
+		if (destination.empty() || start >= view.getArcs()) {
+			return 0;
+		}
+		const size_t count = std::min(destination.size(), view.getArcs() - start);
+		size_t skip = start;
+		size_t left = count;
+		E* out = destination.data();
+		for (const Page* page : view.version->pages) {
+			const size_t size = page->targets.size();
+			if (skip >= size) {
+				skip -= size;
+				continue;
+			}
+			const size_t taken = std::min(size - skip, left);
+			out = std::copy_n(page->targets.begin() + skip, taken, out);
+			left -= taken;
+			skip = 0;
+			if (left == 0) {
+				break;
+			}
+		}
+		return count;
+	}
+
+	template<typename E, typename Allocator>
+	void DynamicGraph<E, Allocator>::reverse() {
+		if (!directed) {
+			return;
+		}
+		std::lock_guard<std::mutex> lock(writer);
+		auto view = snapshot();
+		auto arcs = edges(view);
+		for (GraphEdge<E>& arc : arcs) {
+			std::swap(arc.source, arc.target);
+		}
+		size_t changed = 0;
+		auto next = apply(*empty(view.getVertices()), arcs.data(), arcs.size(), false, 1, changed);
+		if (next != nullptr) {
+			publish(std::move(next));
+		}
+	}
+
+	template<typename E, typename Allocator>
+	typename DynamicGraph<E, Allocator>::DynamicGraphIterator DynamicGraph<E, Allocator>::begin() const {
+		return DynamicGraphIterator(current.load(std::memory_order_acquire), 0);
+	}
+
+	template<typename E, typename Allocator>
+	typename DynamicGraph<E, Allocator>::DynamicGraphIterator DynamicGraph<E, Allocator>::end() const {
+		const Version* version = current.load(std::memory_order_acquire);
+		return DynamicGraphIterator(version, version->pages.size());
+	}
+
+	template<typename E, typename Allocator>
+	void DynamicGraph<E, Allocator>::grow() {}
+
+	template<typename E, typename Allocator>
+	void DynamicGraph<E, Allocator>::shrink() {}
+
+	template<typename E, typename Allocator>
+	void DynamicGraph<E, Allocator>::compress() {}
+
+	template<typename E, typename Allocator>
+	bool DynamicGraph<E, Allocator>::equalsInternal(const DataEngine<E>& de) const {
+		auto other = dynamic_cast<const Graph<E>*>(&de);
+		auto view = snapshot();
+		if (other == nullptr || other->getVertices() != view.getVertices() || other->getActiveSize() != view.getArcs()) {
+			return false;
+		}
+		for (size_t vertex = 0; vertex < view.getVertices(); vertex++) {
+			auto mine = view.neighbors(static_cast<E>(vertex));
+			auto theirs = other->getNeighbors(static_cast<E>(vertex));
+			if (!std::equal(mine.begin(), mine.end(), theirs.begin(), theirs.end())) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] bool DynamicGraph<E, Allocator>::equivalenceInternal(const DataEngine<E>& de) const {
+		auto other = dynamic_cast<const Graph<E>*>(&de);
+		auto view = snapshot();
+		if (other == nullptr || other->getVertices() != view.getVertices() || other->getActiveSize() != view.getArcs()) {
+			return false;
+		}
+		for (size_t vertex = 0; vertex < view.getVertices(); vertex++) {
+			auto mine = view.neighbors(static_cast<E>(vertex));
+			auto theirs = other->getNeighbors(static_cast<E>(vertex));
+			std::sort(theirs.begin(), theirs.end());
+			if (!std::equal(mine.begin(), mine.end(), theirs.begin(), theirs.end())) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	template<typename E, typename Allocator>
+	std::unique_ptr<DataEngine<E>> DynamicGraph<E, Allocator>::mergeInternal(const DataEngine<E>& de, int start, int end) const {
+		auto other = dynamic_cast<const Graph<E>*>(&de);
+		if (other == nullptr || start < 0 || end < start || static_cast<size_t>(end) > other->getVertices()) {
+			return nullptr;
+		}
+		auto view = snapshot();
+		auto arcs = edges(view);
+		for (int vertex = start; vertex < end; vertex++) {
+			for (E target : other->getNeighbors(static_cast<E>(vertex))) {
+				arcs.push_back({ static_cast<E>(vertex), target });
+			}
+		}
+		const size_t size = std::max(view.getVertices(), other->getVertices());
+		return std::unique_ptr<DataEngine<E>>(new DynamicGraph(size, arcs.data(), arcs.size(), directed, 1, allocator));
+	}
+
+	template<typename E, typename Allocator>
+	size_t DynamicGraph<E, Allocator>::update(const GraphEdge<E>* edges, size_t count, bool removing, unsigned threads) {
+		std::lock_guard<std::mutex> lock(writer);
+		size_t changed = 0;
+		//Only writers replace the current version, and they hold the lock
+		auto next = apply(*current.load(std::memory_order_relaxed), edges, count, removing, threads, changed);
+		if (next != nullptr) {
+			publish(std::move(next));
+		}
+		return changed;
+	}
+
+	template<typename E, typename Allocator>
+	ObjectPtr<typename DynamicGraph<E, Allocator>::Version, Allocator> DynamicGraph<E, Allocator>::apply(const Version& base, const GraphEdge<E>* edges,
+		size_t count, bool removing, unsigned threads, size_t& changed) const {
+		changed = 0;
+		const size_t arcCount = directed ? count : 2 * count;
+		const size_t workerCount = CSRGraph<E, Allocator>::workers(threads, arcCount);
+		const bool shared = workerCount > 1;
+
+		//Vertices needed by the batch, an insertion adds them
+		std::vector<size_t> highest(workerCount, 0);
+		std::atomic<bool> outside = false;
+		parallel(workerCount, [&](size_t worker) {
+			size_t high = 0;
+			const size_t last = count * (worker + 1) / workerCount;
+			for (size_t i = count * worker / workerCount; i < last; i++) {
+				if (edges[i].source == NONE || edges[i].target == NONE) {
+					outside.store(true, std::memory_order_relaxed);
+					return;
+				}
+				high = std::max<size_t>(high, static_cast<size_t>(std::max(edges[i].source, edges[i].target)) + 1);
+			}
+			highest[worker] = high;
+		});
+		const size_t vertices = std::max(base.vertices, *std::max_element(highest.begin(), highest.end()));
+		if (outside.load() || (removing && vertices > base.vertices)) {
+			throw std::out_of_range("edge end is not a vertex");
+		}
+
+		//Arcs bucketed by page with a counting sort, counted one slot to the right of their page
+		const size_t pageCount = (vertices + PAGE - 1) / PAGE;
+		std::vector<size_t> starts(pageCount + 1, 0);
+		auto increment = [&](size_t& counter) {
+			return shared ? std::atomic_ref<size_t>(counter).fetch_add(1, std::memory_order_relaxed) : counter++;
+		};
+		parallel(workerCount, [&](size_t worker) {
+			const size_t last = count * (worker + 1) / workerCount;
+			for (size_t i = count * worker / workerCount; i < last; i++) {
+				increment(starts[edges[i].source / PAGE + 1]);
+				if (!directed) {
+					increment(starts[edges[i].target / PAGE + 1]);
+				}
+			}
+		});
+		for (size_t page = 0; page < pageCount; page++) {
+			starts[page + 1] += starts[page];
+		}
+		std::vector<GraphEdge<E>> arcs(starts[pageCount]);
+		std::vector<size_t> next(starts.begin(), starts.end() - 1);
+		parallel(workerCount, [&](size_t worker) {
+			const size_t last = count * (worker + 1) / workerCount;
+			for (size_t i = count * worker / workerCount; i < last; i++) {
+				arcs[increment(next[edges[i].source / PAGE])] = edges[i];
+				if (!directed) {
+					arcs[increment(next[edges[i].target / PAGE])] = { edges[i].target, edges[i].source };
+				}
+			}
+		});
+		std::vector<size_t> touched;
+		for (size_t page = 0; page < pageCount; page++) {
+			if (starts[page + 1] != starts[page]) {
+				touched.push_back(page);
+			}
+		}
+
+		//Each touched page sorts its arcs and merges them with its current ones, a page at a time. A
+		//page left as it was is not replaced
+		std::vector<ObjectPtr<Page, Allocator>> built(touched.size());
+		std::vector<size_t> changes(touched.size(), 0);
+		std::atomic<size_t> cursor = 0;
+		parallel(std::min(workerCount, std::max<size_t>(touched.size(), 1)), [&](size_t) {
+			for (size_t i; (i = cursor.fetch_add(1, std::memory_order_relaxed)) < touched.size();) {
+				const size_t page = touched[i];
+				auto arc = arcs.begin() + starts[page];
+				auto last = arcs.begin() + starts[page + 1];
+				std::sort(arc, last, [](const GraphEdge<E>& a, const GraphEdge<E>& b) {
+					return a.source != b.source ? a.source < b.source : a.target < b.target;
+				});
+				last = std::unique(arc, last, [](const GraphEdge<E>& a, const GraphEdge<E>& b) {
+					return a.source == b.source && a.target == b.target;
+				});
+				const Page& before = page < base.pages.size() ? *base.pages[page] : blank;
+				auto after = makeObject<Page>(allocator, allocator);
+				after->targets.reserve(before.targets.size() + (removing ? 0 : last - arc));
+				for (size_t local = 0; local < PAGE; local++) {
+					auto old = before.targets.begin() + before.offsets[local];
+					auto stop = before.targets.begin() + before.offsets[local + 1];
+					for (; arc != last && static_cast<size_t>(arc->source) == page * PAGE + local; ++arc) {
+						for (; old != stop && *old < arc->target; ++old) {
+							after->targets.push_back(*old);
+						}
+						if (old != stop && *old == arc->target) {
+							++old;
+						}
+						if (!removing) {
+							after->targets.push_back(arc->target);
+						}
+					}
+					after->targets.insert(after->targets.end(), old, stop);
+					after->offsets[local + 1] = after->targets.size();
+				}
+				changes[i] = removing ? before.targets.size() - after->targets.size() : after->targets.size() - before.targets.size();
+				if (changes[i] != 0) {
+					built[i] = std::move(after);
+				}
+			}
+		});
+
+		for (size_t value : changes) {
+			changed += value;
+		}
+		if (changed == 0 && vertices == base.vertices) {
+			return nullptr;
+		}
+		auto version = makeObject<Version>(allocator, allocator);
+		version->vertices = vertices;
+		version->arcs = removing ? base.arcs - changed : base.arcs + changed;
+		version->pages.reserve(pageCount);
+		version->pages.assign(base.pages.begin(), base.pages.end());
+		version->pages.resize(pageCount, &blank);
+		for (size_t i = 0; i < touched.size(); i++) {
+			if (built[i] != nullptr) {
+				version->pages[touched[i]] = built[i]->targets.empty() ? &blank : built[i].release();
+			}
+		}
+		return version;
+	}
+
+	template<typename E, typename Allocator>
+	void DynamicGraph<E, Allocator>::publish(ObjectPtr<Version, Allocator> next) {
+		const Version* previous = current.load(std::memory_order_relaxed);
+		const Version* latest = next.release();
+		current.store(latest, std::memory_order_release);
+		for (size_t page = 0; page < previous->pages.size(); page++) {
+			const Page* old = previous->pages[page];
+			if (old != &blank && (page >= latest->pages.size() || latest->pages[page] != old)) {
+				domain.retire(const_cast<Page*>(old), allocator);
+			}
+		}
+		domain.retire(const_cast<Version*>(previous), allocator);
+	}
+
+	template<typename E, typename Allocator>
+	ObjectPtr<typename DynamicGraph<E, Allocator>::Version, Allocator> DynamicGraph<E, Allocator>::empty(size_t vertices) const {
+		auto version = makeObject<Version>(allocator, allocator);
+		version->vertices = vertices;
+		version->arcs = 0;
+		version->pages.assign((vertices + PAGE - 1) / PAGE, &blank);
+		return version;
+	}
+
+	template<typename E, typename Allocator>
+	void DynamicGraph<E, Allocator>::release(const Version* version) noexcept {
+		for (const Page* page : version->pages) {
+			if (page != &blank) {
+				destroyObject(allocator, const_cast<Page*>(page));
+			}
+		}
+		destroyObject(allocator, const_cast<Version*>(version));
+	}
+
+	template<typename E, typename Allocator>
+	std::vector<GraphEdge<E>> DynamicGraph<E, Allocator>::edges(const Snapshot& view) {
+		std::vector<GraphEdge<E>> arcs;
+		arcs.reserve(view.getArcs());
+		for (size_t vertex = 0; vertex < view.getVertices(); vertex++) {
+			for (E target : view.neighbors(static_cast<E>(vertex))) {
+				arcs.push_back({ static_cast<E>(vertex), target });
+			}
+		}
+		return arcs;
+	}
+}
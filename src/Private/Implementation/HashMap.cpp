@@ -0,0 +1,429 @@
+#include "../../Public/Implementation/HashMap.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace core {
+	template<typename K, typename V, typename Allocator>
+	HashMap<K, V, Allocator>::HashMap() : HashMap(0) {}
+
+	template<typename K, typename V, typename Allocator>
+	HashMap<K, V, Allocator>::HashMap(const Allocator& allocator) : HashMap(0, allocator) {}
+
+	template<typename K, typename V, typename Allocator>
+	HashMap<K, V, Allocator>::HashMap(size_t capacity, const Allocator& allocator) : allocator(allocator), deleted(0) {
+		this->maxCapacity = capacityFor(capacity);
+		this->activeCapacity = 0;
+		control = allocateControl(this->maxCapacity);
+		slots = allocateSlots(this->maxCapacity);
+		updateThresholds();
+	}
+
+	template<typename K, typename V, typename Allocator>
+	HashMap<K, V, Allocator>::~HashMap() {
+		release();
+	}
+
+	template<typename K, typename V, typename Allocator>
+	HashMap<K, V, Allocator>::HashMap(HashMap&& other) noexcept : allocator(other.allocator), control(other.control), slots(other.slots), mask(other.mask),
+		deleted(other.deleted), growthThreshold(other.growthThreshold), shrinkThreshold(other.shrinkThreshold) {
+		this->maxCapacity = other.maxCapacity;
+		this->activeCapacity = other.activeCapacity;
+		other.control = nullptr;
+		other.slots = nullptr;
+		other.maxCapacity = 0;
+		other.activeCapacity = 0;
+		other.deleted = 0;
+		other.updateThresholds();
+	}
+
+	template<typename K, typename V, typename Allocator>
+	HashMap<K, V, Allocator>& HashMap<K, V, Allocator>::operator=(HashMap&& other) noexcept(takesStorageOnMove<Allocator>) {
+		if (this != &other) {
+			requireStorageOnMove(allocator, other.allocator);
+			release();
+			propagateOnMove(allocator, other.allocator);
+			control = other.control;
+			slots = other.slots;
+			deleted = other.deleted;
+			this->maxCapacity = other.maxCapacity;
+			this->activeCapacity = other.activeCapacity;
+			updateThresholds();
+			other.control = nullptr;
+			other.slots = nullptr;
+			other.maxCapacity = 0;
+			other.activeCapacity = 0;
+			other.deleted = 0;
+			other.updateThresholds();
+		}
+		return *this;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	bool HashMap<K, V, Allocator>::put(K key, V value) {
+		const size_t h = hash(key);
+		if (this->maxCapacity > 0) {
+			const size_t index = indexOf(key, h);
+			if (index != this->maxCapacity) {
+				slots[index].value = std::move(value);
+				return false;
+			}
+		}
+		if (this->activeCapacity + deleted >= growthThreshold) {
+			//Rehashing in place is enough when tombstones rather than entries filled the table
+			if (capacityFor(this->activeCapacity + 1) > this->maxCapacity) {
+				grow();
+			}
+			else {
+				rehash(this->maxCapacity);
+			}
+		}
+		const size_t index = availableIndex(h);
+		deleted -= control[index] == DELETED;
+		::new (static_cast<void*>(slots + index)) E{ std::move(key), std::move(value) };
+		control[index] = fingerprint(h);
+		++this->activeCapacity;
+		return true;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	[[nodiscard]] bool HashMap<K, V, Allocator>::get(const K& key, V& value) const {
+		if (this->activeCapacity == 0) {
+			return false;
+		}
+		const size_t index = indexOf(key, hash(key));
+		if (index == this->maxCapacity) {
+			return false;
+		}
+		value = slots[index].value;
+		return true;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	bool HashMap<K, V, Allocator>::remove(const K& key) {
+		if (this->activeCapacity == 0) {
+			return false;
+		}
+		const size_t index = indexOf(key, hash(key));
+		if (index == this->maxCapacity) {
+			return false;
+		}
+		std::destroy_at(slots + index);
+		//A group holding an empty slot ends every probe reaching it, so no other key relies on this slot
+		if (Group(control + (index & ~(GROUP_WIDTH - 1))).matchEmpty() != 0) {
+			control[index] = EMPTY;
+		}
+		else {
+			control[index] = DELETED;
+			++deleted;
+		}
+		if (--this->activeCapacity < shrinkThreshold) {
+			shrink();
+		}
+		return true;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	[[nodiscard]] bool HashMap<K, V, Allocator>::containsKey(const K& key) {
+		return find(key) != nullptr;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	[[nodiscard]] bool HashMap<K, V, Allocator>::containsValue(const V& value) {
+		for (size_t i = 0; i < this->maxCapacity; i++) {
+			if (control[i] >= 0 && slots[i].value == value) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	[[nodiscard]] V* HashMap<K, V, Allocator>::find(const K& key) {
+		if (this->activeCapacity == 0) {
+			return nullptr;
+		}
+		const size_t index = indexOf(key, hash(key));
+		return index == this->maxCapacity ? nullptr : &slots[index].value;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	void HashMap<K, V, Allocator>::reserve(size_t capacity) {
+		const size_t target = capacityFor(capacity);
+		if (target > this->maxCapacity) {
+			rehash(target);
+		}
+	}
+
+	template<typename K, typename V, typename Allocator>
+	std::unique_ptr<DataEngine<Entry<K, V>>> HashMap<K, V, Allocator>::clone() const {
+		//Same capacity and same hash function, so every entry keeps its slot and no rehash is needed
+		auto copy = std::make_unique<HashMap>(0, allocator);
+		copy->release();
+		copy->maxCapacity = this->maxCapacity;
+		copy->control = allocateControl(this->maxCapacity);
+		copy->slots = allocateSlots(this->maxCapacity);
+		//Each control byte is published once its slot is built, so a throwing copy leaves only built slots to destroy
+		for (size_t i = 0; i < this->maxCapacity; i++) {
+			if (control[i] >= 0) {
+				::new (static_cast<void*>(copy->slots + i)) E(slots[i]);
+			}
+			copy->control[i] = control[i];
+		}
+		copy->activeCapacity = this->activeCapacity;
+		copy->deleted = deleted;
+		copy->updateThresholds();
+		return copy;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	std::unique_ptr<DataEngine<Entry<K, V>>> HashMap<K, V, Allocator>::move() {
+		return std::make_unique<HashMap>(std::move(*this));
+	}
+
+	template<typename K, typename V, typename Allocator>
+	bool HashMap<K, V, Allocator>::removeAll() {
+		if (this->activeCapacity == 0) {
+			return false;
+		}
+		if (this->maxCapacity > capacityFor(0)) {
+			release();
+			this->maxCapacity = capacityFor(0);
+			control = allocateControl(this->maxCapacity);
+			slots = allocateSlots(this->maxCapacity);
+			updateThresholds();
+		}
+		else {
+			for (size_t i = 0; i < this->maxCapacity; i++) {
+				if (control[i] >= 0) {
+					std::destroy_at(slots + i);
+				}
+			}
+			std::memset(control, EMPTY, this->maxCapacity);
+		}
+		this->activeCapacity = 0;
+		deleted = 0;
+		return true;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	Entry<K, V>* HashMap<K, V, Allocator>::toArray() const {
+		return toArray(0, static_cast<int>(this->activeCapacity));
+	}
+
+	template<typename K, typename V, typename Allocator>
+	Entry<K, V>* HashMap<K, V, Allocator>::toArray(int start, int end) const {
+		if (start < 0 || end <= start || static_cast<size_t>(end) > this->activeCapacity) {
+			return nullptr;
+		}
+		std::unique_ptr<E[]> array(new E[end - start]);
+		copyTo(std::span<E>(array.get(), end - start), start);
+		return array.release();
+	}
+
+	template<typename K, typename V, typename Allocator>
+	size_t HashMap<K, V, Allocator>::copyTo(std::span<Entry<K, V>> destination, size_t start) const {
+		if (destination.empty() || start >= this->activeCapacity) {
+			return 0;
+		}
+		const size_t count = std::min(destination.size(), this->activeCapacity - start);
+		size_t position = 0;
+		size_t copied = 0;
+		for (size_t i = 0; i < this->maxCapacity && copied < count; i++) {
+			if (control[i] >= 0) {
+				if (position >= start) {
+					destination[copied++] = slots[i];
+				}
+				position++;
+			}
+		}
+		return count;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	void HashMap<K, V, Allocator>::reverse() {}
+
+	template<typename K, typename V, typename Allocator>
+	typename HashMap<K, V, Allocator>::iterator HashMap<K, V, Allocator>::begin() {
+		return iterator(control, slots, 0, this->maxCapacity);
+	}
+
+	template<typename K, typename V, typename Allocator>
+	typename HashMap<K, V, Allocator>::const_iterator HashMap<K, V, Allocator>::begin() const {
+		return const_iterator(control, slots, 0, this->maxCapacity);
+	}
+
+	template<typename K, typename V, typename Allocator>
+	typename HashMap<K, V, Allocator>::iterator HashMap<K, V, Allocator>::end() {
+		return iterator(control, slots, this->maxCapacity, this->maxCapacity);
+	}
+
+	template<typename K, typename V, typename Allocator>
+	typename HashMap<K, V, Allocator>::const_iterator HashMap<K, V, Allocator>::end() const {
+		return const_iterator(control, slots, this->maxCapacity, this->maxCapacity);
+	}
+
+	template<typename K, typename V, typename Allocator>
+	void HashMap<K, V, Allocator>::grow() {
+		rehash(std::max<size_t>(this->maxCapacity << 1, capacityFor(0)));
+	}
+
+	template<typename K, typename V, typename Allocator>
+	void HashMap<K, V, Allocator>::shrink() {
+		if (this->maxCapacity > DataEngine<E>::DEFAULT_CAPACITY) {
+			rehash(this->maxCapacity >> 1);
+		}
+	}
+
+	template<typename K, typename V, typename Allocator>
+	void HashMap<K, V, Allocator>::compress() {
+		rehash(capacityFor(this->activeCapacity));
+	}
+
+	template<typename K, typename V, typename Allocator>
+	bool HashMap<K, V, Allocator>::equalsInternal(const DataEngine<E>& de) const {
+		auto other = dynamic_cast<const Map<K, V>*>(&de);
+		if (other == nullptr || other->getActiveSize() != this->activeCapacity) {
+			return false;
+		}
+		V value;
+		for (size_t i = 0; i < this->maxCapacity; i++) {
+			if (control[i] >= 0 && (!other->get(slots[i].key, value) || !(value == slots[i].value))) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	[[nodiscard]] bool HashMap<K, V, Allocator>::equivalenceInternal(const DataEngine<E>& de) const {
+		//Entries carry no order, so equivalence and equality coincide
+		return equalsInternal(de);
+	}
+
+	template<typename K, typename V, typename Allocator>
+	std::unique_ptr<DataEngine<Entry<K, V>>> HashMap<K, V, Allocator>::mergeInternal(const DataEngine<E>& de, int start, int end) const {
+		auto other = dynamic_cast<const Map<K, V>*>(&de);
+		if (other == nullptr || start < 0 || end < start || static_cast<size_t>(end) > other->getActiveSize()) {
+			return nullptr;
+		}
+		std::unique_ptr<HashMap> merged(static_cast<HashMap*>(clone().release()));
+		if (end > start) {
+			std::unique_ptr<E[]> entries(other->toArray(start, end));
+			merged->reserve(this->activeCapacity + (end - start));
+			for (int i = 0; i < end - start; i++) {
+				merged->put(std::move(entries[i].key), std::move(entries[i].value));
+			}
+		}
+		return merged;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	size_t HashMap<K, V, Allocator>::indexOf(const K& key, size_t hash) const {
+		const int8_t tag = fingerprint(hash);
+		size_t base = hash & mask & ~(GROUP_WIDTH - 1);
+		//Triangular steps over groups visit every group once when the group count is a power of two
+		for (size_t step = GROUP_WIDTH; ; step += GROUP_WIDTH) {
+			const Group group(control + base);
+			for (uint32_t bits = group.match(tag); bits != 0; bits &= bits - 1) {
+				const size_t index = base + std::countr_zero(bits);
+				if (slots[index].key == key) {
+					return index;
+				}
+			}
+			if (group.matchEmpty() != 0) {
+				return this->maxCapacity;
+			}
+			base = (base + step) & mask;
+		}
+	}
+
+	template<typename K, typename V, typename Allocator>
+	size_t HashMap<K, V, Allocator>::availableIndex(size_t hash) const {
+		size_t base = hash & mask & ~(GROUP_WIDTH - 1);
+		for (size_t step = GROUP_WIDTH; ; step += GROUP_WIDTH) {
+			const uint32_t bits = Group(control + base).matchAvailable();
+			if (bits != 0) {
+				return base + std::countr_zero(bits);
+			}
+			base = (base + step) & mask;
+		}
+	}
+
+	template<typename K, typename V, typename Allocator>
+	void HashMap<K, V, Allocator>::rehash(size_t capacity) {
+		int8_t* oldControl = control;
+		E* oldSlots = slots;
+		const size_t oldCapacity = this->maxCapacity;
+		control = allocateControl(capacity);
+		slots = allocateSlots(capacity);
+		this->maxCapacity = capacity;
+		deleted = 0;
+		updateThresholds();
+		for (size_t i = 0; i < oldCapacity; i++) {
+			if (oldControl[i] < 0) {
+				continue;
+			}
+			const size_t h = hash(oldSlots[i].key);
+			const size_t index = availableIndex(h);
+			if constexpr (RELOCATABLE) {
+				std::memcpy(static_cast<void*>(slots + index), static_cast<const void*>(oldSlots + i), sizeof(E));
+			}
+			else {
+				::new (static_cast<void*>(slots + index)) E(std::move(oldSlots[i]));
+				std::destroy_at(oldSlots + i);
+			}
+			control[index] = fingerprint(h);
+		}
+		if (oldControl != nullptr) {
+			deallocate(oldControl, oldSlots, oldCapacity);
+		}
+	}
+
+	template<typename K, typename V, typename Allocator>
+	void HashMap<K, V, Allocator>::release() noexcept {
+		if (control == nullptr) {
+			return;
+		}
+		for (size_t i = 0; i < this->maxCapacity; i++) {
+			if (control[i] >= 0) {
+				std::destroy_at(slots + i);
+			}
+		}
+		deallocate(control, slots, this->maxCapacity);
+		control = nullptr;
+		slots = nullptr;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	void HashMap<K, V, Allocator>::updateThresholds() noexcept {
+		mask = this->maxCapacity - 1;
+		growthThreshold = static_cast<size_t>(this->maxCapacity * DataEngine<E>::GROWTH_LOAD_FACTOR);
+		shrinkThreshold = static_cast<size_t>(this->maxCapacity * DataEngine<E>::SHRINK_LOAD_FACTOR);
+	}
+
+	template<typename K, typename V, typename Allocator>
+	size_t HashMap<K, V, Allocator>::capacityFor(size_t entries) noexcept {
+		const auto required = static_cast<size_t>(std::ceil(entries / DataEngine<E>::GROWTH_LOAD_FACTOR)) + 1;
+		return std::bit_ceil(std::max<size_t>(required, std::max<size_t>(DataEngine<E>::DEFAULT_CAPACITY, GROUP_WIDTH)));
+	}
+
+	template<typename K, typename V, typename Allocator>
+	int8_t* HashMap<K, V, Allocator>::allocateControl(size_t capacity) const {
+		//Capacities are powers of two of at least GROUP_WIDTH, so they are whole groups
+		auto bytes = reinterpret_cast<int8_t*>(allocateStorage<ControlBlock>(allocator, capacity / GROUP_WIDTH));
+		std::memset(bytes, EMPTY, capacity);
+		return bytes;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	Entry<K, V>* HashMap<K, V, Allocator>::allocateSlots(size_t capacity) const {
+		return allocateStorage<E>(allocator, capacity);
+	}
+
+	template<typename K, typename V, typename Allocator>
+	void HashMap<K, V, Allocator>::deallocate(int8_t* control, E* slots, size_t capacity) const noexcept {
+		deallocateStorage(allocator, reinterpret_cast<ControlBlock*>(control), capacity / GROUP_WIDTH);
+		deallocateStorage(allocator, slots, capacity);
+	}
+}
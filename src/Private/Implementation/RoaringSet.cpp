@@ -0,0 +1,1089 @@
+#include "../../Public/Implementation/RoaringSet.h"
+#include <algorithm>
+#include <bit>
+
+namespace core {
+	template<typename E, typename Allocator>
+	void RoaringSet<E, Allocator>::RoaringSetIterator::settle() {
+		while (chunk < set->containers.size()) {
+			const Container& container = set->containers[chunk];
+			switch (container.kind) {
+			case Container::Kind::ARRAY:
+				if (position < container.values.size()) {
+					current = itemOf(set->keys[chunk], container.values[position]);
+					return;
+				}
+				break;
+			case Container::Kind::BITMAP:
+				if (position < BITMAP_WORDS * 64) {
+					size_t word = position / 64;
+					uint64_t bits = container.words[word] & (~uint64_t{ 0 } << (position % 64));
+					while (bits == 0 && ++word < BITMAP_WORDS) {
+						bits = container.words[word];
+					}
+					if (bits != 0) {
+						position = word * 64 + std::countr_zero(bits);
+						current = itemOf(set->keys[chunk], static_cast<uint32_t>(position));
+						return;
+					}
+				}
+				break;
+			case Container::Kind::RUN:
+				if (2 * position < container.values.size()) {
+					current = itemOf(set->keys[chunk], container.values[2 * position] + offset);
+					return;
+				}
+				break;
+			}
+			chunk++;
+			position = 0;
+			offset = 0;
+		}
+	}
+
+	template<typename E, typename Allocator>
+	typename RoaringSet<E, Allocator>::RoaringSetIterator& RoaringSet<E, Allocator>::RoaringSetIterator::operator++() {
+		const Container& container = set->containers[chunk];
+		if (container.kind == Container::Kind::RUN && offset < container.values[2 * position + 1]) {
+			offset++;
+		}
+		else {
+			position++;
+			offset = 0;
+		}
+		settle();
+		return *this;
+	}
+
+	template<typename E, typename Allocator>
+	RoaringSet<E, Allocator>::RoaringSet() : RoaringSet(Allocator()) {}
+
+	template<typename E, typename Allocator>
+	RoaringSet<E, Allocator>::RoaringSet(const Allocator& allocator) : allocator(allocator), keys(allocator), containers(allocator) {
+		this->maxCapacity = std::numeric_limits<size_t>::max(); //Unbounded, containers are sized to their content
+		this->activeCapacity = 0;
+	}
+
+	template<typename E, typename Allocator>
+	RoaringSet<E, Allocator>::RoaringSet(const E* items, size_t count, const Allocator& allocator) : RoaringSet(allocator) {
+		std::vector<E> sorted(items, items + count);
+		std::sort(sorted.begin(), sorted.end());
+		sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+		for (size_t first = 0, last; first < sorted.size(); first = last) {
+			const Key key = keyOf(sorted[first]);
+			for (last = first + 1; last < sorted.size() && keyOf(sorted[last]) == key; last++) {}
+			Container container(allocator);
+			container.cardinality = static_cast<uint32_t>(last - first);
+			container.values.reserve(last - first);
+			for (size_t i = first; i < last; i++) {
+				container.values.push_back(lowOf(sorted[i]));
+			}
+			normalize(container);
+			keys.push_back(key);
+			containers.push_back(std::move(container));
+		}
+		this->activeCapacity = sorted.size();
+	}
+
+	template<typename E, typename Allocator>
+	RoaringSet<E, Allocator>::RoaringSet(RoaringSet&& other) noexcept : allocator(other.allocator), keys(std::move(other.keys)), containers(std::move(other.containers)) {
+		this->maxCapacity = other.maxCapacity;
+		this->activeCapacity = other.activeCapacity;
+		other.keys.clear();
+		other.containers.clear();
+		other.activeCapacity = 0;
+	}
+
+	template<typename E, typename Allocator>
+	RoaringSet<E, Allocator>& RoaringSet<E, Allocator>::operator=(RoaringSet&& other) noexcept(takesStorageOnMove<Allocator>) {
+		if (this != &other) {
+			requireStorageOnMove(allocator, other.allocator);
+			propagateOnMove(allocator, other.allocator);
+			keys = std::move(other.keys);
+			containers = std::move(other.containers);
+			this->activeCapacity = other.activeCapacity;
+			other.keys.clear();
+			other.containers.clear();
+			other.activeCapacity = 0;
+		}
+		return *this;
+	}
+
+	template<typename E, typename Allocator>
+	bool RoaringSet<E, Allocator>::add(E item) {
+		const ptrdiff_t index = find(keyOf(item));
+		if (index < 0) {
+			Container container(allocator);
+			container.cardinality = 1;
+			container.values.push_back(lowOf(item));
+			keys.insert(keys.begin() + ~index, keyOf(item));
+			containers.insert(containers.begin() + ~index, std::move(container));
+			this->activeCapacity++;
+			return true;
+		}
+		if (!insert(containers[index], lowOf(item))) {
+			return false;
+		}
+		this->activeCapacity++;
+		return true;
+	}
+
+	template<typename E, typename Allocator>
+	bool RoaringSet<E, Allocator>::remove(E item) {
+		const ptrdiff_t index = find(keyOf(item));
+		if (index < 0 || !erase(containers[index], lowOf(item))) {
+			return false;
+		}
+		if (containers[index].cardinality == 0) {
+			keys.erase(keys.begin() + index);
+			containers.erase(containers.begin() + index);
+		}
+		this->activeCapacity--;
+		return true;
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] bool RoaringSet<E, Allocator>::contains(E item) const {
+		const ptrdiff_t index = find(keyOf(item));
+		return index >= 0 && probe(containers[index], lowOf(item));
+	}
+
+	template<typename E, typename Allocator>
+	bool RoaringSet<E, Allocator>::optimize() {
+		bool changed = false;
+		for (Container& container : containers) {
+			changed |= compact(container);
+		}
+		return changed;
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] size_t RoaringSet<E, Allocator>::getMemoryUsage() const noexcept {
+		size_t bytes = keys.capacity() * sizeof(Key) + (containers.capacity() - containers.size()) * sizeof(Container);
+		for (const Container& container : containers) {
+			bytes += footprint(container);
+		}
+		return bytes;
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] E RoaringSet<E, Allocator>::first() const {
+		if (containers.empty()) {
+			throw std::out_of_range("set is empty");
+		}
+		return itemOf(keys.front(), minimum(containers.front()));
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] E RoaringSet<E, Allocator>::last() const {
+		if (containers.empty()) {
+			throw std::out_of_range("set is empty");
+		}
+		return itemOf(keys.back(), maximum(containers.back()));
+	}
+
+	template<typename E, typename Allocator>
+	std::unique_ptr<DataEngine<E>> RoaringSet<E, Allocator>::clone() const {
+		auto copy = std::make_unique<RoaringSet>(allocator);
+		copy->keys = keys;
+		copy->containers = containers;
+		copy->activeCapacity = this->activeCapacity;
+		return copy;
+	}
+
+	template<typename E, typename Allocator>
+	std::unique_ptr<DataEngine<E>> RoaringSet<E, Allocator>::move() {
+		return std::make_unique<RoaringSet>(std::move(*this));
+	}
+
+	template<typename E, typename Allocator>
+	bool RoaringSet<E, Allocator>::removeAll() {
+		if (containers.empty()) {
+			return false;
+		}
+		keys.clear();
+		containers.clear();
+		this->activeCapacity = 0;
+		return true;
+	}
+
+	template<typename E, typename Allocator>
+	E* RoaringSet<E, Allocator>::toArray() const {
+		return toArray(0, static_cast<int>(this->activeCapacity));
+	}
+
+	template<typename E, typename Allocator>
+	E* RoaringSet<E, Allocator>::toArray(int start, int end) const {
+		if (start < 0 || end <= start || static_cast<size_t>(end) > this->activeCapacity) {
+			return nullptr;
+		}
+		std::unique_ptr<E[]> array(new E[end - start]);
+		copyTo(std::span<E>(array.get(), end - start), start);
+		return array.release();
+	}
+
+	template<typename E, typename Allocator>
+	size_t RoaringSet<E, Allocator>::copyTo(std::span<E> destination, size_t start) const {
+		if (destination.empty() || start >= this->activeCapacity) {
+			return 0;
+		}
+		const size_t count = std::min(destination.size(), this->activeCapacity - start);
+		std::vector<uint16_t> values;
+		size_t skip = start;
+		size_t left = count;
+		E* out = destination.data();
+		for (size_t chunk = 0; chunk < containers.size() && left > 0; chunk++) {
+			const Container& container = containers[chunk];
+			if (skip >= container.cardinality) {
+				skip -= container.cardinality;
+				continue;
+			}
+			values.resize(container.cardinality);
+			decode(container, values.data());
+			const size_t taken = std::min(container.cardinality - skip, left);
+			for (size_t i = skip; i < skip + taken; i++) {
+				*out++ = itemOf(keys[chunk], values[i]);
+			}
+			left -= taken;
+			skip = 0;
+		}
+		return count;
+	}
+
+	template<typename E, typename Allocator>
+	void RoaringSet<E, Allocator>::reverse() {}
+
+	template<typename E, typename Allocator>
+	typename RoaringSet<E, Allocator>::RoaringSetIterator RoaringSet<E, Allocator>::begin() const {
+		return RoaringSetIterator(this, 0);
+	}
+
+	template<typename E, typename Allocator>
+	typename RoaringSet<E, Allocator>::RoaringSetIterator RoaringSet<E, Allocator>::end() const {
+		return RoaringSetIterator(this, containers.size());
+	}
+
+	template<typename E, typename Allocator>
+	void RoaringSet<E, Allocator>::grow() {}
+
+	template<typename E, typename Allocator>
+	void RoaringSet<E, Allocator>::shrink() {}
+
+	template<typename E, typename Allocator>
+	void RoaringSet<E, Allocator>::compress() {
+		optimize();
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] bool RoaringSet<E, Allocator>::containsAllInternal(std::any* set) {
+		auto other = std::any_cast<Set<E>*>(set);
+		return other != nullptr && covers(*other);
+	}
+
+	template<typename E, typename Allocator>
+	bool RoaringSet<E, Allocator>::addAllInternal(std::any* set) {
+		auto other = std::any_cast<Set<E>*>(set);
+		return other != nullptr && absorb(*other);
+	}
+
+	template<typename E, typename Allocator>
+	bool RoaringSet<E, Allocator>::absorb(const Set<E>* other) {
+		if (other == this) {
+			return false;
+		}
+		auto roaring = dynamic_cast<const RoaringSet*>(other);
+		if (roaring == nullptr) {
+			bool changed = false;
+			std::unique_ptr<E[]> items(other->toArray());
+			for (size_t i = 0; i < other->getActiveSize(); i++) {
+				changed |= add(items[i]);
+			}
+			return changed;
+		}
+		//Merges the two chunk lists, the chunks of the invoking set alone are moved over as they are
+		EngineVector<Key, Allocator> mergedKeys(allocator);
+		EngineVector<Container, Allocator> merged(allocator);
+		mergedKeys.reserve(keys.size() + roaring->keys.size());
+		merged.reserve(keys.size() + roaring->keys.size());
+		size_t i = 0;
+		size_t j = 0;
+		while (i < keys.size() || j < roaring->keys.size()) {
+			if (j == roaring->keys.size() || (i < keys.size() && keys[i] < roaring->keys[j])) {
+				mergedKeys.push_back(keys[i]);
+				merged.push_back(std::move(containers[i++]));
+			}
+			else if (i == keys.size() || roaring->keys[j] < keys[i]) {
+				mergedKeys.push_back(roaring->keys[j]);
+				merged.emplace_back(roaring->containers[j++], allocator);
+			}
+			else {
+				mergedKeys.push_back(keys[i]);
+				merged.push_back(unite(containers[i++], roaring->containers[j++]));
+			}
+		}
+		const size_t before = this->activeCapacity;
+		keys.swap(mergedKeys);
+		containers.swap(merged);
+		recount();
+		return this->activeCapacity != before;
+	}
+
+	template<typename E, typename Allocator>
+	bool RoaringSet<E, Allocator>::retainAllInternal(std::any* set) {
+		auto other = std::any_cast<Set<E>*>(set);
+		if (other == nullptr || *other == this) {
+			return false;
+		}
+		const size_t before = this->activeCapacity;
+		auto roaring = dynamic_cast<RoaringSet*>(*other);
+		if (roaring == nullptr) {
+			std::unique_ptr<E[]> items(toArray());
+			for (size_t i = 0; i < before; i++) {
+				if (!(*other)->contains(items[i])) {
+					remove(items[i]);
+				}
+			}
+			return this->activeCapacity != before;
+		}
+		size_t j = 0;
+		for (size_t i = 0; i < keys.size(); i++) {
+			while (j < roaring->keys.size() && roaring->keys[j] < keys[i]) {
+				j++;
+			}
+			if (j < roaring->keys.size() && roaring->keys[j] == keys[i]) {
+				containers[i] = intersect(containers[i], roaring->containers[j]);
+			}
+			else {
+				containers[i].cardinality = 0;
+			}
+		}
+		prune();
+		recount();
+		return this->activeCapacity != before;
+	}
+
+	template<typename E, typename Allocator>
+	bool RoaringSet<E, Allocator>::discardAllInternal(std::any* set) {
+		auto other = std::any_cast<Set<E>*>(set);
+		if (other == nullptr) {
+			return false;
+		}
+		if (*other == this) {
+			return removeAll();
+		}
+		const size_t before = this->activeCapacity;
+		auto roaring = dynamic_cast<RoaringSet*>(*other);
+		if (roaring == nullptr) {
+			std::unique_ptr<E[]> items((*other)->toArray());
+			for (size_t i = 0; i < (*other)->getActiveSize(); i++) {
+				remove(items[i]);
+			}
+			return this->activeCapacity != before;
+		}
+		size_t j = 0;
+		for (size_t i = 0; i < keys.size(); i++) {
+			while (j < roaring->keys.size() && roaring->keys[j] < keys[i]) {
+				j++;
+			}
+			if (j < roaring->keys.size() && roaring->keys[j] == keys[i]) {
+				containers[i] = subtract(containers[i], roaring->containers[j]);
+			}
+		}
+		prune();
+		recount();
+		return this->activeCapacity != before;
+	}
+
+	template<typename E, typename Allocator>
+	bool RoaringSet<E, Allocator>::equalsInternal(const DataEngine<E>& de) const {
+		auto other = dynamic_cast<const Set<E>*>(&de);
+		return other != nullptr && other->getActiveSize() == this->activeCapacity && covers(other);
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] bool RoaringSet<E, Allocator>::equivalenceInternal(const DataEngine<E>& de) const {
+		return equalsInternal(de);
+	}
+
+	template<typename E, typename Allocator>
+	std::unique_ptr<DataEngine<E>> RoaringSet<E, Allocator>::mergeInternal(const DataEngine<E>& de, int start, int end) const {
+		auto other = dynamic_cast<const Set<E>*>(&de);
+		if (other == nullptr || start < 0 || end < start || static_cast<size_t>(end) > other->getActiveSize()) {
+			return nullptr;
+		}
+		std::unique_ptr<RoaringSet> merged(static_cast<RoaringSet*>(clone().release()));
+		if (start == 0 && static_cast<size_t>(end) == other->getActiveSize()) {
+			merged->absorb(other);
+		}
+		else if (end > start) {
+			std::unique_ptr<E[]> items(other->toArray(start, end));
+			for (int i = 0; i < end - start; i++) {
+				merged->add(items[i]);
+			}
+		}
+		return merged;
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] ptrdiff_t RoaringSet<E, Allocator>::find(Key key) const noexcept {
+		auto found = std::lower_bound(keys.begin(), keys.end(), key);
+		const ptrdiff_t index = found - keys.begin();
+		return found != keys.end() && *found == key ? index : ~index;
+	}
+
+	template<typename E, typename Allocator>
+	void RoaringSet<E, Allocator>::recount() noexcept {
+		size_t count = 0;
+		for (const Container& container : containers) {
+			count += container.cardinality;
+		}
+		this->activeCapacity = count;
+	}
+
+	template<typename E, typename Allocator>
+	void RoaringSet<E, Allocator>::prune() {
+		size_t write = 0;
+		for (size_t read = 0; read < containers.size(); read++) {
+			if (containers[read].cardinality == 0) {
+				continue;
+			}
+			if (write != read) {
+				keys[write] = keys[read];
+				containers[write] = std::move(containers[read]);
+			}
+			write++;
+		}
+		keys.resize(write);
+		containers.erase(containers.begin() + write, containers.end());
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] bool RoaringSet<E, Allocator>::covers(const Set<E>* other) const {
+		if (other == this) {
+			return true;
+		}
+		if (other->getActiveSize() > this->activeCapacity) {
+			return false;
+		}
+		auto roaring = dynamic_cast<const RoaringSet*>(other);
+		if (roaring == nullptr) {
+			std::unique_ptr<E[]> items(other->toArray());
+			for (size_t i = 0; i < other->getActiveSize(); i++) {
+				if (!contains(items[i])) {
+					return false;
+				}
+			}
+			return true;
+		}
+		size_t i = 0;
+		for (size_t j = 0; j < roaring->keys.size(); j++) {
+			while (i < keys.size() && keys[i] < roaring->keys[j]) {
+				i++;
+			}
+			if (i == keys.size() || keys[i] != roaring->keys[j] || !includes(containers[i], roaring->containers[j])) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	template<typename E, typename Allocator>
+	bool RoaringSet<E, Allocator>::probe(const Container& container, uint16_t low) noexcept {
+		switch (container.kind) {
+		case Container::Kind::ARRAY:
+			return std::binary_search(container.values.begin(), container.values.end(), low);
+		case Container::Kind::BITMAP:
+			return (container.words[low / 64] >> (low % 64)) & 1;
+		case Container::Kind::RUN: {
+			//Last run starting at or before the value
+			size_t lower = 0;
+			size_t upper = container.values.size() / 2;
+			while (lower < upper) {
+				const size_t middle = (lower + upper) / 2;
+				if (container.values[2 * middle] <= low) {
+					lower = middle + 1;
+				}
+				else {
+					upper = middle;
+				}
+			}
+			return lower > 0 && low - container.values[2 * lower - 2] <= container.values[2 * lower - 1];
+		}
+		}
+		return false;
+	}
+
+	template<typename E, typename Allocator>
+	bool RoaringSet<E, Allocator>::insert(Container& container, uint16_t low) {
+		if (container.kind == Container::Kind::RUN) {
+			if (probe(container, low)) {
+				return false;
+			}
+			expand(container);
+		}
+		if (container.kind == Container::Kind::BITMAP) {
+			uint64_t& word = container.words[low / 64];
+			const uint64_t bit = uint64_t{ 1 } << (low % 64);
+			if (word & bit) {
+				return false;
+			}
+			word |= bit;
+			container.cardinality++;
+			return true;
+		}
+		auto position = std::lower_bound(container.values.begin(), container.values.end(), low);
+		if (position != container.values.end() && *position == low) {
+			return false;
+		}
+		container.values.insert(position, low);
+		container.cardinality++;
+		normalize(container);
+		return true;
+	}
+
+	template<typename E, typename Allocator>
+	bool RoaringSet<E, Allocator>::erase(Container& container, uint16_t low) {
+		if (container.kind == Container::Kind::RUN) {
+			if (!probe(container, low)) {
+				return false;
+			}
+			expand(container);
+		}
+		if (container.kind == Container::Kind::BITMAP) {
+			uint64_t& word = container.words[low / 64];
+			const uint64_t bit = uint64_t{ 1 } << (low % 64);
+			if (!(word & bit)) {
+				return false;
+			}
+			word &= ~bit;
+			container.cardinality--;
+			normalize(container);
+			return true;
+		}
+		auto position = std::lower_bound(container.values.begin(), container.values.end(), low);
+		if (position == container.values.end() || *position != low) {
+			return false;
+		}
+		container.values.erase(position);
+		container.cardinality--;
+		return true;
+	}
+
+	template<typename E, typename Allocator>
+	uint16_t RoaringSet<E, Allocator>::minimum(const Container& container) noexcept {
+		if (container.kind != Container::Kind::BITMAP) {
+			return container.values.front();
+		}
+		size_t word = 0;
+		while (container.words[word] == 0) {
+			word++;
+		}
+		return static_cast<uint16_t>(word * 64 + std::countr_zero(container.words[word]));
+	}
+
+	template<typename E, typename Allocator>
+	uint16_t RoaringSet<E, Allocator>::maximum(const Container& container) noexcept {
+		switch (container.kind) {
+		case Container::Kind::ARRAY:
+			return container.values.back();
+		case Container::Kind::RUN:
+			return static_cast<uint16_t>(container.values[container.values.size() - 2] + container.values.back());
+		default: {
+			size_t word = BITMAP_WORDS - 1;
+			while (container.words[word] == 0) {
+				word--;
+			}
+			return static_cast<uint16_t>(word * 64 + 63 - std::countl_zero(container.words[word]));
+		}
+		}
+	}
+
+	template<typename E, typename Allocator>
+	uint16_t* RoaringSet<E, Allocator>::decode(const Container& container, uint16_t* out) noexcept {
+		switch (container.kind) {
+		case Container::Kind::ARRAY:
+			return std::copy(container.values.begin(), container.values.end(), out);
+		case Container::Kind::BITMAP:
+			for (size_t word = 0; word < BITMAP_WORDS; word++) {
+				for (uint64_t bits = container.words[word]; bits != 0; bits &= bits - 1) {
+					*out++ = static_cast<uint16_t>(word * 64 + std::countr_zero(bits));
+				}
+			}
+			return out;
+		case Container::Kind::RUN:
+			for (size_t run = 0; run < container.values.size(); run += 2) {
+				const uint32_t first = container.values[run];
+				for (uint32_t value = first; value <= first + container.values[run + 1]; value++) {
+					*out++ = static_cast<uint16_t>(value);
+				}
+			}
+			return out;
+		}
+		return out;
+	}
+
+	template<typename E, typename Allocator>
+	void RoaringSet<E, Allocator>::fill(uint64_t* words, uint32_t first, uint32_t last) noexcept {
+		const uint32_t firstWord = first / 64;
+		const uint32_t lastWord = last / 64;
+		const uint64_t head = ~uint64_t{ 0 } << (first % 64);
+		const uint64_t tail = ~uint64_t{ 0 } >> (63 - last % 64);
+		if (firstWord == lastWord) {
+			words[firstWord] |= head & tail;
+			return;
+		}
+		words[firstWord] |= head;
+		for (uint32_t word = firstWord + 1; word < lastWord; word++) {
+			words[word] = ~uint64_t{ 0 };
+		}
+		words[lastWord] |= tail;
+	}
+
+	template<typename E, typename Allocator>
+	void RoaringSet<E, Allocator>::expand(Container& container) {
+		if (container.kind != Container::Kind::RUN) {
+			return;
+		}
+		auto runs = std::move(container.values);
+		container.values.clear();
+		if (container.cardinality <= ARRAY_LIMIT) {
+			container.kind = Container::Kind::ARRAY;
+			container.values.reserve(container.cardinality);
+			for (size_t run = 0; run < runs.size(); run += 2) {
+				const uint32_t first = runs[run];
+				for (uint32_t value = first; value <= first + runs[run + 1]; value++) {
+					container.values.push_back(static_cast<uint16_t>(value));
+				}
+			}
+			return;
+		}
+		container.kind = Container::Kind::BITMAP;
+		container.words.assign(BITMAP_WORDS, 0);
+		for (size_t run = 0; run < runs.size(); run += 2) {
+			fill(container.words.data(), runs[run], runs[run] + runs[run + 1]);
+		}
+	}
+
+	template<typename E, typename Allocator>
+	void RoaringSet<E, Allocator>::normalize(Container& container) {
+		if (container.kind == Container::Kind::ARRAY && container.cardinality > ARRAY_LIMIT) {
+			container.kind = Container::Kind::BITMAP;
+			container.words.assign(BITMAP_WORDS, 0);
+			for (uint16_t value : container.values) {
+				container.words[value / 64] |= uint64_t{ 1 } << (value % 64);
+			}
+			discard(container.values);
+		}
+		else if (container.kind == Container::Kind::BITMAP && container.cardinality <= ARRAY_LIMIT) {
+			container.values.resize(container.cardinality);
+			decode(container, container.values.data());
+			container.kind = Container::Kind::ARRAY;
+			discard(container.words);
+		}
+	}
+
+	template<typename E, typename Allocator>
+	bool RoaringSet<E, Allocator>::compact(Container& container) {
+		size_t runs = 0;
+		switch (container.kind) {
+		case Container::Kind::ARRAY:
+			for (size_t i = 0; i < container.values.size(); i++) {
+				runs += i == 0 || container.values[i] != container.values[i - 1] + 1;
+			}
+			break;
+		case Container::Kind::BITMAP: {
+			//A run starts at every set bit whose lower neighbor is clear
+			uint64_t carry = 0;
+			for (size_t word = 0; word < BITMAP_WORDS; word++) {
+				const uint64_t bits = container.words[word];
+				runs += std::popcount(bits & ~((bits << 1) | carry));
+				carry = bits >> 63;
+			}
+			break;
+		}
+		case Container::Kind::RUN:
+			runs = container.values.size() / 2;
+			break;
+		}
+		const size_t expanded = container.cardinality <= ARRAY_LIMIT ? 2 * container.cardinality : 8 * BITMAP_WORDS;
+		if (container.kind == Container::Kind::RUN) {
+			if (4 * runs < expanded) {
+				return false;
+			}
+			expand(container);
+			return true;
+		}
+		if (4 * runs >= expanded) {
+			return false;
+		}
+		std::vector<uint16_t> values(container.cardinality);
+		decode(container, values.data());
+		container.values.clear();
+		container.values.reserve(2 * runs);
+		for (size_t first = 0, last; first < values.size(); first = last + 1) {
+			for (last = first; last + 1 < values.size() && values[last + 1] == values[last] + 1; last++) {}
+			container.values.push_back(values[first]);
+			container.values.push_back(static_cast<uint16_t>(last - first));
+		}
+		container.values.shrink_to_fit();
+		discard(container.words);
+		container.kind = Container::Kind::RUN;
+		return true;
+	}
+
+	template<typename E, typename Allocator>
+	size_t RoaringSet<E, Allocator>::footprint(const Container& container) noexcept {
+		return sizeof(Container) + container.values.capacity() * sizeof(uint16_t) + container.words.capacity() * sizeof(uint64_t);
+	}
+
+	template<typename E, typename Allocator>
+	typename RoaringSet<E, Allocator>::Container RoaringSet<E, Allocator>::unite(const Container& a, const Container& b) {
+		Container result(a.get_allocator());
+		if (a.kind == Container::Kind::RUN && b.kind == Container::Kind::RUN) {
+			//Merges the runs of both in order of their first value, joining those that touch
+			result.kind = Container::Kind::RUN;
+			size_t i = 0;
+			size_t j = 0;
+			uint32_t first = 0;
+			uint32_t last = 0;
+			bool open = false;
+			while (i < a.values.size() || j < b.values.size()) {
+				const bool fromA = j == b.values.size() || (i < a.values.size() && a.values[i] <= b.values[j]);
+				const EngineVector<uint16_t, Allocator>& runs = fromA ? a.values : b.values;
+				size_t& index = fromA ? i : j;
+				const uint32_t start = runs[index];
+				const uint32_t stop = start + runs[index + 1];
+				index += 2;
+				if (open && start <= last + 1) {
+					last = std::max(last, stop);
+					continue;
+				}
+				if (open) {
+					result.values.push_back(static_cast<uint16_t>(first));
+					result.values.push_back(static_cast<uint16_t>(last - first));
+					result.cardinality += last - first + 1;
+				}
+				first = start;
+				last = stop;
+				open = true;
+			}
+			if (open) {
+				result.values.push_back(static_cast<uint16_t>(first));
+				result.values.push_back(static_cast<uint16_t>(last - first));
+				result.cardinality += last - first + 1;
+			}
+			compact(result);
+			return result;
+		}
+		if (a.kind == Container::Kind::RUN || b.kind == Container::Kind::RUN) {
+			Container left = a;
+			Container right = b;
+			expand(left);
+			expand(right);
+			return unite(left, right);
+		}
+		if (a.kind == Container::Kind::ARRAY && b.kind == Container::Kind::ARRAY) {
+			result.values.resize(a.values.size() + b.values.size());
+			auto last = std::set_union(a.values.begin(), a.values.end(), b.values.begin(), b.values.end(), result.values.begin());
+			result.values.erase(last, result.values.end());
+			result.cardinality = static_cast<uint32_t>(result.values.size());
+			normalize(result);
+			return result;
+		}
+		result.kind = Container::Kind::BITMAP;
+		if (a.kind == Container::Kind::BITMAP && b.kind == Container::Kind::BITMAP) {
+			result.words.resize(BITMAP_WORDS);
+			result.cardinality = combine<Logic::OR>(a.words.data(), b.words.data(), result.words.data());
+			return result;
+		}
+		const Container& bitmap = a.kind == Container::Kind::BITMAP ? a : b;
+		const Container& array = a.kind == Container::Kind::BITMAP ? b : a;
+		result.words = bitmap.words;
+		result.cardinality = bitmap.cardinality;
+		for (uint16_t value : array.values) {
+			const uint64_t bit = uint64_t{ 1 } << (value % 64);
+			result.cardinality += !(result.words[value / 64] & bit);
+			result.words[value / 64] |= bit;
+		}
+		return result;
+	}
+
+	template<typename E, typename Allocator>
+	typename RoaringSet<E, Allocator>::Container RoaringSet<E, Allocator>::intersect(const Container& a, const Container& b) {
+		Container result(a.get_allocator());
+		if (a.kind == Container::Kind::RUN && b.kind == Container::Kind::RUN) {
+			//Overlaps of the runs, the run ending first moves on
+			result.kind = Container::Kind::RUN;
+			size_t i = 0;
+			size_t j = 0;
+			while (i < a.values.size() && j < b.values.size()) {
+				const uint32_t aLast = a.values[i] + a.values[i + 1];
+				const uint32_t bLast = b.values[j] + b.values[j + 1];
+				const uint32_t first = std::max(a.values[i], b.values[j]);
+				const uint32_t last = std::min(aLast, bLast);
+				if (first <= last) {
+					result.values.push_back(static_cast<uint16_t>(first));
+					result.values.push_back(static_cast<uint16_t>(last - first));
+					result.cardinality += last - first + 1;
+				}
+				if (aLast <= bLast) {
+					i += 2;
+				}
+				if (bLast <= aLast) {
+					j += 2;
+				}
+			}
+			compact(result);
+			return result;
+		}
+		if (a.kind == Container::Kind::ARRAY || b.kind == Container::Kind::ARRAY) {
+			const Container& array = a.kind == Container::Kind::ARRAY ? a : b;
+			const Container& other = a.kind == Container::Kind::ARRAY ? b : a;
+			result.values.resize(std::min<size_t>(array.cardinality, other.cardinality));
+			uint16_t* out = result.values.data();
+			if (other.kind == Container::Kind::ARRAY) {
+				const bool smaller = array.values.size() <= other.values.size();
+				const Container& left = smaller ? array : other;
+				const Container& right = smaller ? other : array;
+				out = filter(left.values.data(), left.values.size(), right.values.data(), right.values.size(), true, out);
+			}
+			else {
+				for (uint16_t value : array.values) {
+					*out = value;
+					out += probe(other, value);
+				}
+			}
+			result.values.resize(out - result.values.data());
+			result.cardinality = static_cast<uint32_t>(result.values.size());
+			return result;
+		}
+		if (a.kind == Container::Kind::RUN || b.kind == Container::Kind::RUN) {
+			Container left = a;
+			Container right = b;
+			expand(left);
+			expand(right);
+			return intersect(left, right);
+		}
+		result.kind = Container::Kind::BITMAP;
+		result.words.resize(BITMAP_WORDS);
+		result.cardinality = combine<Logic::AND>(a.words.data(), b.words.data(), result.words.data());
+		normalize(result);
+		return result;
+	}
+
+	template<typename E, typename Allocator>
+	typename RoaringSet<E, Allocator>::Container RoaringSet<E, Allocator>::subtract(const Container& a, const Container& b) {
+		Container result(a.get_allocator());
+		if (a.kind == Container::Kind::RUN) {
+			Container left = a;
+			expand(left);
+			return subtract(left, b);
+		}
+		if (a.kind == Container::Kind::ARRAY) {
+			result.values.resize(a.values.size());
+			uint16_t* out = result.values.data();
+			if (b.kind == Container::Kind::ARRAY) {
+				out = filter(a.values.data(), a.values.size(), b.values.data(), b.values.size(), false, out);
+			}
+			else {
+				for (uint16_t value : a.values) {
+					*out = value;
+					out += !probe(b, value);
+				}
+			}
+			result.values.resize(out - result.values.data());
+			result.cardinality = static_cast<uint32_t>(result.values.size());
+			return result;
+		}
+		result.kind = Container::Kind::BITMAP;
+		if (b.kind == Container::Kind::BITMAP) {
+			result.words.resize(BITMAP_WORDS);
+			result.cardinality = combine<Logic::AND_NOT>(a.words.data(), b.words.data(), result.words.data());
+		}
+		else {
+			result.words = a.words;
+			result.cardinality = a.cardinality;
+			std::vector<uint16_t> values(b.cardinality);
+			decode(b, values.data());
+			for (uint16_t value : values) {
+				const uint64_t bit = uint64_t{ 1 } << (value % 64);
+				result.cardinality -= (result.words[value / 64] & bit) != 0;
+				result.words[value / 64] &= ~bit;
+			}
+		}
+		normalize(result);
+		return result;
+	}
+
+	template<typename E, typename Allocator>
+	bool RoaringSet<E, Allocator>::includes(const Container& a, const Container& b) {
+		if (b.cardinality > a.cardinality) {
+			return false;
+		}
+		if (a.kind == Container::Kind::BITMAP && b.kind == Container::Kind::BITMAP) {
+			for (size_t word = 0; word < BITMAP_WORDS; word++) {
+				if (b.words[word] & ~a.words[word]) {
+					return false;
+				}
+			}
+			return true;
+		}
+		if (a.kind == Container::Kind::ARRAY && b.kind == Container::Kind::ARRAY) {
+			return std::includes(a.values.begin(), a.values.end(), b.values.begin(), b.values.end());
+		}
+		std::vector<uint16_t> values(b.cardinality);
+		decode(b, values.data());
+		for (uint16_t value : values) {
+			if (!probe(a, value)) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	template<typename E, typename Allocator>
+	uint32_t RoaringSet<E, Allocator>::matchBlock(const uint16_t* a, const uint16_t* b) noexcept {
+#if ENGINE_AVX2
+		//Both halves hold the block of a. The values of b sit in the low half and four lanes further round in
+		//the high one, so four rotations by one lane meet every pair
+		const __m256i block = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a)));
+		const __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b));
+		__m256i rotated = _mm256_inserti128_si256(_mm256_castsi128_si256(values), _mm_alignr_epi8(values, values, 8), 1);
+		__m256i matches = _mm256_cmpeq_epi16(block, rotated);
+		for (size_t k = 1; k < 4; k++) {
+			rotated = _mm256_alignr_epi8(rotated, rotated, 2);
+			matches = _mm256_or_si256(matches, _mm256_cmpeq_epi16(block, rotated));
+		}
+		const __m128i merged = _mm_or_si128(_mm256_castsi256_si128(matches), _mm256_extracti128_si256(matches, 1));
+		return static_cast<uint32_t>(_mm_movemask_epi8(_mm_packs_epi16(merged, _mm_setzero_si128())));
+#elif ENGINE_SSE2
+		//Compares the block of a with each value of b broadcast, two mask bits per 16 bit lane
+		const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a));
+		__m128i matches = _mm_setzero_si128();
+		for (size_t k = 0; k < 8; k++) {
+			matches = _mm_or_si128(matches, _mm_cmpeq_epi16(block, _mm_set1_epi16(static_cast<short>(b[k]))));
+		}
+		const uint32_t bytes = static_cast<uint32_t>(_mm_movemask_epi8(matches));
+		uint32_t mask = 0;
+		for (size_t k = 0; k < 8; k++) {
+			mask |= ((bytes >> (2 * k)) & 1) << k;
+		}
+		return mask;
+#else
+		uint32_t mask = 0;
+		for (size_t i = 0; i < 8; i++) {
+			for (size_t k = 0; k < 8; k++) {
+				mask |= static_cast<uint32_t>(a[i] == b[k]) << i;
+			}
+		}
+		return mask;
+#endif
+	}
+
+	template<typename E, typename Allocator>
+	uint16_t* RoaringSet<E, Allocator>::filter(const uint16_t* a, size_t aSize, const uint16_t* b, size_t bSize, bool keep, uint16_t* out) noexcept {
+		if (aSize * 64 < bSize) {
+			//Gallops through the much larger b, each search starting where the previous one ended
+			const uint16_t* from = b;
+			const uint16_t* stop = b + bSize;
+			for (size_t i = 0; i < aSize; i++) {
+				size_t step = 1;
+				while (from + step < stop && from[step] < a[i]) {
+					step *= 2;
+				}
+				from = std::lower_bound(from, from + std::min<size_t>(step + 1, stop - from), a[i]);
+				*out = a[i];
+				out += (from != stop && *from == a[i]) == keep;
+			}
+			return out;
+		}
+		//Blocks of eight are compared until either array runs out, the block of a with the smaller last
+		//value has met every block of b that can hold its values and is written out
+		size_t i = 0;
+		size_t j = 0;
+		uint32_t mask = 0;
+		while (i + 8 <= aSize && j + 8 <= bSize) {
+			mask |= matchBlock(a + i, b + j);
+			const uint16_t aLast = a[i + 7];
+			const uint16_t bLast = b[j + 7];
+			if (aLast <= bLast) {
+				for (size_t k = 0; k < 8; k++) {
+					*out = a[i + k];
+					out += ((mask >> k) & 1) == keep;
+				}
+				mask = 0;
+				i += 8;
+			}
+			if (bLast <= aLast) {
+				j += 8;
+			}
+		}
+		//The rest is merged one by one, the values of a matched by earlier blocks of b are in the mask
+		for (size_t k = i; k < aSize; k++) {
+			while (j < bSize && b[j] < a[k]) {
+				j++;
+			}
+			const bool found = (k - i < 8 && ((mask >> (k - i)) & 1)) || (j < bSize && b[j] == a[k]);
+			*out = a[k];
+			out += found == keep;
+		}
+		return out;
+	}
+
+	template<typename E, typename Allocator>
+	template<typename RoaringSet<E, Allocator>::Logic logic>
+	uint32_t RoaringSet<E, Allocator>::combine(const uint64_t* a, const uint64_t* b, uint64_t* out) noexcept {
+		size_t word = 0;
+#if ENGINE_AVX2
+		for (; word + 4 <= BITMAP_WORDS; word += 4) {
+			const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + word));
+			const __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + word));
+			__m256i z;
+			if constexpr (logic == Logic::OR) {
+				z = _mm256_or_si256(x, y);
+			}
+			else if constexpr (logic == Logic::AND) {
+				z = _mm256_and_si256(x, y);
+			}
+			else {
+				z = _mm256_andnot_si256(y, x);
+			}
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + word), z);
+		}
+#elif ENGINE_SSE2
+		for (; word + 2 <= BITMAP_WORDS; word += 2) {
+			const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + word));
+			const __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + word));
+			__m128i z;
+			if constexpr (logic == Logic::OR) {
+				z = _mm_or_si128(x, y);
+			}
+			else if constexpr (logic == Logic::AND) {
+				z = _mm_and_si128(x, y);
+			}
+			else {
+				z = _mm_andnot_si128(y, x);
+			}
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + word), z);
+		}
+#else
+		//BITMAP_WORDS is a multiple of the vector widths, so only the scalar build combines word by word
+		for (; word < BITMAP_WORDS; word++) {
+			if constexpr (logic == Logic::OR) {
+				out[word] = a[word] | b[word];
+			}
+			else if constexpr (logic == Logic::AND) {
+				out[word] = a[word] & b[word];
+			}
+			else {
+				out[word] = a[word] & ~b[word];
+			}
+		}
+#endif
+		uint32_t cardinality = 0;
+		for (word = 0; word < BITMAP_WORDS; word++) {
+			cardinality += std::popcount(out[word]);
+		}
+		return cardinality;
+	}
+}
@@ -0,0 +1,422 @@
+#include "../../Public/Implementation/SegmentedStack.h"
+#include <concepts>
+#include <vector>
+
+namespace core {
+	template<typename E, typename Allocator>
+	SegmentedStack<E, Allocator>::SegmentedStack() : SegmentedStack(0) {}
+
+	template<typename E, typename Allocator>
+	SegmentedStack<E, Allocator>::SegmentedStack(const Allocator& allocator) : SegmentedStack(0, allocator) {}
+
+	template<typename E, typename Allocator>
+	SegmentedStack<E, Allocator>::SegmentedStack(size_t capacity, const Allocator& allocator) : allocator(allocator), bottom(nullptr), top(nullptr), last(nullptr), used(0), spares(0), reserved(0) {
+		this->maxCapacity = 0;
+		this->activeCapacity = 0;
+		reserve(capacity);
+	}
+
+	template<typename E, typename Allocator>
+	SegmentedStack<E, Allocator>::~SegmentedStack() {
+		release();
+	}
+
+	template<typename E, typename Allocator>
+	SegmentedStack<E, Allocator>::SegmentedStack(SegmentedStack&& other) noexcept : allocator(other.allocator), bottom(other.bottom), top(other.top), last(other.last),
+		used(other.used), spares(other.spares), reserved(other.reserved) {
+		this->maxCapacity = other.maxCapacity;
+		this->activeCapacity = other.activeCapacity;
+		other.bottom = other.top = other.last = nullptr;
+		other.used = other.spares = other.reserved = 0;
+		other.maxCapacity = 0;
+		other.activeCapacity = 0;
+	}
+
+	template<typename E, typename Allocator>
+	SegmentedStack<E, Allocator>& SegmentedStack<E, Allocator>::operator=(SegmentedStack&& other) noexcept(takesStorageOnMove<Allocator>) {
+		if (this != &other) {
+			requireStorageOnMove(allocator, other.allocator);
+			release();
+			propagateOnMove(allocator, other.allocator);
+			bottom = other.bottom;
+			top = other.top;
+			last = other.last;
+			used = other.used;
+			spares = other.spares;
+			reserved = other.reserved;
+			this->maxCapacity = other.maxCapacity;
+			this->activeCapacity = other.activeCapacity;
+			other.bottom = other.top = other.last = nullptr;
+			other.used = other.spares = other.reserved = 0;
+			other.maxCapacity = 0;
+			other.activeCapacity = 0;
+		}
+		return *this;
+	}
+
+	template<typename E, typename Allocator>
+	bool SegmentedStack<E, Allocator>::push(E item) {
+		emplace(std::move(item));
+		return true;
+	}
+
+	template<typename E, typename Allocator>
+	template<typename... Args>
+	E& SegmentedStack<E, Allocator>::emplace(Args&&... args) {
+		if (top == nullptr) {
+			grow(); //The first block becomes the bottom and the top
+		}
+		else if (used == BLOCK_SIZE) {
+			//The item is built before the top moves up, so a throwing constructor leaves the stack as it was
+			Block* next = following();
+			E* slot = ::new (static_cast<void*>(next->items())) E(std::forward<Args>(args)...);
+			top = next;
+			used = 1;
+			spares--;
+			++this->activeCapacity;
+			return *slot;
+		}
+		E* slot = ::new (static_cast<void*>(top->items() + used)) E(std::forward<Args>(args)...);
+		++used;
+		++this->activeCapacity;
+		return *slot;
+	}
+
+	template<typename E, typename Allocator>
+	bool SegmentedStack<E, Allocator>::pop(E& item) {
+		if (this->activeCapacity == 0) {
+			return false;
+		}
+		item = std::move(top->items()[used - 1]);
+		return pop();
+	}
+
+	template<typename E, typename Allocator>
+	bool SegmentedStack<E, Allocator>::pop() {
+		if (this->activeCapacity == 0) {
+			return false;
+		}
+		std::destroy_at(top->items() + --used);
+		--this->activeCapacity;
+		//The emptied block becomes the first spare, the block below is full
+		if (used == 0 && top->below != nullptr) {
+			top = top->below;
+			used = BLOCK_SIZE;
+			if (++spares > CACHED_BLOCKS) {
+				shrink();
+			}
+		}
+		return true;
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] E* SegmentedStack<E, Allocator>::peek() {
+		return this->activeCapacity == 0 ? nullptr : top->items() + (used - 1);
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] E* SegmentedStack<E, Allocator>::get(size_t index) {
+		if (index >= this->activeCapacity) {
+			return nullptr;
+		}
+		//Every block below the top is full
+		const size_t below = this->activeCapacity - used;
+		if (index >= below) {
+			return top->items() + (index - below);
+		}
+		const size_t blocks = below / BLOCK_SIZE;
+		const size_t target = index / BLOCK_SIZE;
+		Block* block;
+		if (target < blocks - target) {
+			block = bottom;
+			for (size_t i = 0; i < target; i++) {
+				block = block->above;
+			}
+		}
+		else {
+			block = top;
+			for (size_t i = blocks; i > target; i--) {
+				block = block->below;
+			}
+		}
+		return block->items() + index % BLOCK_SIZE;
+	}
+
+	template<typename E, typename Allocator>
+	std::unique_ptr<DataEngine<E>> SegmentedStack<E, Allocator>::clone() const {
+		auto copy = std::make_unique<SegmentedStack>(this->activeCapacity, allocator);
+		forEachRun([&](const E* items, size_t count) {
+			for (size_t i = 0; i < count; i++) {
+				copy->emplace(items[i]);
+			}
+		});
+		return copy;
+	}
+
+	template<typename E, typename Allocator>
+	std::unique_ptr<DataEngine<E>> SegmentedStack<E, Allocator>::move() {
+		return std::make_unique<SegmentedStack>(std::move(*this));
+	}
+
+	template<typename E, typename Allocator>
+	bool SegmentedStack<E, Allocator>::removeAll() {
+		if (this->activeCapacity == 0) {
+			return false;
+		}
+		for (Block* block = bottom; block != top; block = block->above) {
+			std::destroy_n(block->items(), BLOCK_SIZE);
+			spares++;
+		}
+		std::destroy_n(top->items(), used);
+		top = bottom;
+		used = 0;
+		this->activeCapacity = 0;
+		shrink();
+		return true;
+	}
+
+	template<typename E, typename Allocator>
+	E* SegmentedStack<E, Allocator>::toArray() const {
+		return toArray(0, static_cast<int>(this->activeCapacity));
+	}
+
+	template<typename E, typename Allocator>
+	E* SegmentedStack<E, Allocator>::toArray(int start, int end) const {
+		if (start < 0 || end <= start || static_cast<size_t>(end) > this->activeCapacity) {
+			return nullptr;
+		}
+		std::unique_ptr<E[]> array(new E[end - start]);
+		copyTo(std::span<E>(array.get(), end - start), start);
+		return array.release();
+	}
+
+	template<typename E, typename Allocator>
+	size_t SegmentedStack<E, Allocator>::copyTo(std::span<E> destination, size_t start) const {
+		if (destination.empty() || start >= this->activeCapacity) {
+			return 0;
+		}
+		const size_t count = std::min(destination.size(), this->activeCapacity - start);
+		size_t skip = start;
+		size_t left = count;
+		E* out = destination.data();
+		forEachRun([&](const E* items, size_t run) {
+			if (left == 0) {
+				return;
+			}
+			if (skip >= run) {
+				skip -= run;
+				return;
+			}
+			const size_t taken = std::min(run - skip, left);
+			out = std::copy_n(items + skip, taken, out);
+			left -= taken;
+			skip = 0;
+		});
+		return count;
+	}
+
+	template<typename E, typename Allocator>
+	void SegmentedStack<E, Allocator>::reverse() {
+		if (this->activeCapacity < 2) {
+			return;
+		}
+		//Two cursors walk towards each other, the lower one up from the bottom and the upper one down
+		Block* lowBlock = bottom;
+		size_t low = 0;
+		Block* highBlock = top;
+		size_t high = used - 1;
+		for (size_t swaps = this->activeCapacity / 2; swaps > 0; swaps--) {
+			std::swap(lowBlock->items()[low], highBlock->items()[high]);
+			if (++low == BLOCK_SIZE) {
+				lowBlock = lowBlock->above;
+				low = 0;
+			}
+			if (high-- == 0) {
+				highBlock = highBlock->below;
+				high = BLOCK_SIZE - 1;
+			}
+		}
+	}
+
+	template<typename E, typename Allocator>
+	typename SegmentedStack<E, Allocator>::iterator SegmentedStack<E, Allocator>::begin() {
+		return iterator(bottom, top, 0);
+	}
+
+	template<typename E, typename Allocator>
+	typename SegmentedStack<E, Allocator>::const_iterator SegmentedStack<E, Allocator>::begin() const {
+		return const_iterator(bottom, top, 0);
+	}
+
+	template<typename E, typename Allocator>
+	typename SegmentedStack<E, Allocator>::iterator SegmentedStack<E, Allocator>::end() {
+		return iterator(top, top, used);
+	}
+
+	template<typename E, typename Allocator>
+	typename SegmentedStack<E, Allocator>::const_iterator SegmentedStack<E, Allocator>::end() const {
+		return const_iterator(top, top, used);
+	}
+
+	template<typename E, typename Allocator>
+	void SegmentedStack<E, Allocator>::reserve(size_t capacity) {
+		reserved = std::max(reserved, (capacity + BLOCK_SIZE - 1) / BLOCK_SIZE);
+		while (this->maxCapacity < capacity) {
+			grow();
+		}
+	}
+
+	template<typename E, typename Allocator>
+	void SegmentedStack<E, Allocator>::grow() {
+		Block* block = allocate();
+		block->below = last;
+		block->above = nullptr;
+		if (last == nullptr) {
+			bottom = top = block;
+			used = 0;
+		}
+		else {
+			last->above = block;
+			spares++;
+		}
+		last = block;
+		this->maxCapacity += BLOCK_SIZE;
+	}
+
+	template<typename E, typename Allocator>
+	void SegmentedStack<E, Allocator>::shrink() {
+		trim(CACHED_BLOCKS, false);
+	}
+
+	template<typename E, typename Allocator>
+	void SegmentedStack<E, Allocator>::compress() {
+		trim(0, true);
+	}
+
+	template<typename E, typename Allocator>
+	bool SegmentedStack<E, Allocator>::equalsInternal(const DataEngine<E>& de) const {
+		auto other = dynamic_cast<const Stack<E>*>(&de);
+		if (other == nullptr || other->getActiveSize() != this->activeCapacity) {
+			return false;
+		}
+		if (this->activeCapacity == 0) {
+			return true;
+		}
+		std::unique_ptr<E[]> items(other->toArray());
+		size_t index = 0;
+		bool equal = true;
+		forEachRun([&](const E* run, size_t count) {
+			for (size_t i = 0; i < count && equal; i++) {
+				equal = run[i] == items[index++];
+			}
+		});
+		return equal;
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] bool SegmentedStack<E, Allocator>::equivalenceInternal(const DataEngine<E>& de) const {
+		auto other = dynamic_cast<const Stack<E>*>(&de);
+		if (other == nullptr || other->getActiveSize() != this->activeCapacity) {
+			return false;
+		}
+		if (this->activeCapacity == 0) {
+			return true;
+		}
+		std::unique_ptr<E[]> mine(toArray());
+		std::unique_ptr<E[]> theirs(other->toArray());
+		if constexpr (std::totally_ordered<E>) {
+			std::sort(mine.get(), mine.get() + this->activeCapacity);
+			std::sort(theirs.get(), theirs.get() + this->activeCapacity);
+			return std::equal(mine.get(), mine.get() + this->activeCapacity, theirs.get());
+		}
+		else {
+			return std::is_permutation(mine.get(), mine.get() + this->activeCapacity, theirs.get());
+		}
+	}
+
+	template<typename E, typename Allocator>
+	std::unique_ptr<DataEngine<E>> SegmentedStack<E, Allocator>::mergeInternal(const DataEngine<E>& de, int start, int end) const {
+		auto other = dynamic_cast<const Stack<E>*>(&de);
+		if (other == nullptr || start < 0 || end < start || static_cast<size_t>(end) > other->getActiveSize()) {
+			return nullptr;
+		}
+		auto merged = std::make_unique<SegmentedStack>(this->activeCapacity + (end - start), allocator);
+		forEachRun([&](const E* items, size_t count) {
+			for (size_t i = 0; i < count; i++) {
+				merged->emplace(items[i]);
+			}
+		});
+		if (end > start) {
+			std::unique_ptr<E[]> items(other->toArray(start, end));
+			for (int i = 0; i < end - start; i++) {
+				merged->emplace(std::move(items[i]));
+			}
+		}
+		return merged;
+	}
+
+	template<typename E, typename Allocator>
+	typename SegmentedStack<E, Allocator>::Block* SegmentedStack<E, Allocator>::following() {
+		if (spares == 0) {
+			grow();
+		}
+		return top->above;
+	}
+
+	template<typename E, typename Allocator>
+	void SegmentedStack<E, Allocator>::trim(size_t keep, bool force) noexcept {
+		while (spares > keep && (force || this->maxCapacity > reserved * BLOCK_SIZE)) {
+			Block* block = last;
+			last = block->below;
+			last->above = nullptr;
+			deallocate(block);
+			spares--;
+			this->maxCapacity -= BLOCK_SIZE;
+		}
+		if (force) {
+			reserved = 0;
+		}
+	}
+
+	template<typename E, typename Allocator>
+	void SegmentedStack<E, Allocator>::release() noexcept {
+		if (bottom == nullptr) {
+			return;
+		}
+		for (Block* block = bottom; block != top; block = block->above) {
+			std::destroy_n(block->items(), BLOCK_SIZE);
+		}
+		std::destroy_n(top->items(), used);
+		for (Block* block = bottom; block != nullptr;) {
+			Block* above = block->above;
+			deallocate(block);
+			block = above;
+		}
+		bottom = top = last = nullptr;
+		used = spares = 0;
+		this->maxCapacity = 0;
+		this->activeCapacity = 0;
+	}
+
+	template<typename E, typename Allocator>
+	template<typename Visitor>
+	void SegmentedStack<E, Allocator>::forEachRun(Visitor&& visitor) const {
+		if (this->activeCapacity == 0) {
+			return;
+		}
+		for (const Block* block = bottom; block != top; block = block->above) {
+			visitor(block->items(), BLOCK_SIZE);
+		}
+		visitor(static_cast<const Block*>(top)->items(), used);
+	}
+
+	template<typename E, typename Allocator>
+	typename SegmentedStack<E, Allocator>::Block* SegmentedStack<E, Allocator>::allocate() const {
+		return allocateStorage<Block>(allocator, 1);
+	}
+
+	template<typename E, typename Allocator>
+	void SegmentedStack<E, Allocator>::deallocate(Block* block) const noexcept {
+		deallocateStorage(allocator, block, 1);
+	}
+}
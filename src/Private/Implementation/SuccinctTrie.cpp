@@ -0,0 +1,530 @@
+#include "../../Public/Implementation/SuccinctTrie.h"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+namespace core {
+	template<typename K, typename V, typename Allocator>
+	SuccinctTrie<K, V, Allocator>::SuccinctTrie() : SuccinctTrie(Allocator()) {}
+
+	template<typename K, typename V, typename Allocator>
+	SuccinctTrie<K, V, Allocator>::SuccinctTrie(const Allocator& allocator) : allocator(allocator), storage(allocator) {
+		build(nullptr, 0);
+	}
+
+	template<typename K, typename V, typename Allocator>
+	SuccinctTrie<K, V, Allocator>::SuccinctTrie(const E* entries, size_t count, const Allocator& allocator) : allocator(allocator),
+		storage(allocator) {
+		for (size_t i = 1; i < count; i++) {
+			if (!(entries[i - 1].key < entries[i].key)) {
+				throw std::invalid_argument("succinct trie requires strictly increasing keys");
+			}
+		}
+		build(entries, count);
+	}
+
+	template<typename K, typename V, typename Allocator>
+	SuccinctTrie<K, V, Allocator>::SuccinctTrie(const void* encoding, size_t size, const Allocator& allocator) : allocator(allocator),
+		storage(allocator) {
+		if (encoding == nullptr || reinterpret_cast<uintptr_t>(encoding) % alignof(uint64_t) != 0 || size < sizeof(Header)) {
+			throw std::invalid_argument("encoding is missing, misaligned or truncated");
+		}
+		auto found = static_cast<const Header*>(encoding);
+		if (found->magic != MAGIC || found->version != VERSION || found->valueSize != sizeof(V)) {
+			throw std::invalid_argument("encoding was not built for this trie");
+		}
+		//Every key ends at a node of its own and every node but the root takes a label byte, so both counts
+		//are bounded by the size before the expected sections are laid out from them
+		if (found->nodeCount == 0 || found->nodeCount > size || found->keyCount > found->nodeCount) {
+			throw std::invalid_argument("encoding is corrupt");
+		}
+		const Header expected = layout(found->keyCount, found->nodeCount);
+		if (found->louds != expected.louds || found->loudsRanks != expected.loudsRanks || found->loudsSelects != expected.loudsSelects ||
+			found->labels != expected.labels || found->terminals != expected.terminals || found->terminalRanks != expected.terminalRanks ||
+			found->values != expected.values || found->size != expected.size) {
+			throw std::invalid_argument("encoding is corrupt");
+		}
+		if (found->size > size) {
+			throw std::invalid_argument("encoding is missing, misaligned or truncated");
+		}
+		bind(encoding);
+	}
+
+	template<typename K, typename V, typename Allocator>
+	SuccinctTrie<K, V, Allocator>::SuccinctTrie(SuccinctTrie&& other) : allocator(other.allocator), storage(std::move(other.storage)) {
+		bind(storage.empty() ? static_cast<const void*>(other.header) : storage.data());
+		other.build(nullptr, 0);
+	}
+
+	template<typename K, typename V, typename Allocator>
+	SuccinctTrie<K, V, Allocator>& SuccinctTrie<K, V, Allocator>::operator=(SuccinctTrie&& other) {
+		if (this != &other) {
+			propagateOnMove(allocator, other.allocator);
+			storage = std::move(other.storage);
+			//The storage is copied rather than taken over when the allocators differ
+			bind(storage.empty() ? static_cast<const void*>(other.header) : storage.data());
+			other.build(nullptr, 0);
+		}
+		return *this;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	bool SuccinctTrie<K, V, Allocator>::put(K, V) {
+		throw std::logic_error("put on an immutable trie");
+	}
+
+	template<typename K, typename V, typename Allocator>
+	[[nodiscard]] bool SuccinctTrie<K, V, Allocator>::get(const K& key, V& value) const {
+		const size_t node = descend(key);
+		if (node == NONE || !terminal(node)) {
+			return false;
+		}
+		value = valueOf(node);
+		return true;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	bool SuccinctTrie<K, V, Allocator>::remove(const K&) {
+		throw std::logic_error("remove on an immutable trie");
+	}
+
+	template<typename K, typename V, typename Allocator>
+	[[nodiscard]] bool SuccinctTrie<K, V, Allocator>::containsKey(const K& key) const {
+		const size_t node = descend(key);
+		return node != NONE && terminal(node);
+	}
+
+	template<typename K, typename V, typename Allocator>
+	[[nodiscard]] bool SuccinctTrie<K, V, Allocator>::containsValue(const V& value) {
+		//Values are stored contiguously, no walk over the keys is needed
+		for (size_t i = 0; i < this->activeCapacity; i++) {
+			V stored;
+			std::memcpy(&stored, values + i * sizeof(V), sizeof(V));
+			if (stored == value) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	size_t SuccinctTrie<K, V, Allocator>::scanPrefix(const K& prefix, std::function<bool(const E&)> visitor) const {
+		const size_t node = descend(prefix);
+		size_t visited = 0;
+		if (node != NONE) {
+			std::string key = prefix;
+			auto counted = [&](const E& entry) {
+				visited++;
+				return visitor(entry);
+			};
+			walk(node, key, counted);
+		}
+		return visited;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	[[nodiscard]] bool SuccinctTrie<K, V, Allocator>::longestPrefix(const K& key, E& entry) const {
+		size_t node = 0;
+		size_t best = terminal(0) ? 0 : NONE;
+		size_t length = 0;
+		for (size_t i = 0; i < key.size(); i++) {
+			node = child(node, static_cast<uint8_t>(key[i]));
+			if (node == NONE) {
+				break;
+			}
+			if (terminal(node)) {
+				best = node;
+				length = i + 1;
+			}
+		}
+		if (best == NONE) {
+			return false;
+		}
+		entry = E{ key.substr(0, length), valueOf(best) };
+		return true;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	[[nodiscard]] const void* SuccinctTrie<K, V, Allocator>::getEncoding() const {
+		return header;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	[[nodiscard]] size_t SuccinctTrie<K, V, Allocator>::getEncodedSize() const {
+		return header->size;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	[[nodiscard]] size_t SuccinctTrie<K, V, Allocator>::getNodeCount() const {
+		return header->nodeCount;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	std::unique_ptr<DataEngine<Entry<K, V>>> SuccinctTrie<K, V, Allocator>::clone() const {
+		auto copy = std::make_unique<SuccinctTrie>(allocator);
+		const size_t lines = (header->size + sizeof(Line) - 1) / sizeof(Line);
+		copy->storage.assign(lines, Line{});
+		std::memcpy(copy->storage.data(), header, header->size);
+		copy->bind(copy->storage.data());
+		return copy;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	std::unique_ptr<DataEngine<Entry<K, V>>> SuccinctTrie<K, V, Allocator>::move() {
+		return std::make_unique<SuccinctTrie>(std::move(*this));
+	}
+
+	template<typename K, typename V, typename Allocator>
+	bool SuccinctTrie<K, V, Allocator>::removeAll() {
+		throw std::logic_error("removeAll on an immutable trie");
+	}
+
+	template<typename K, typename V, typename Allocator>
+	Entry<K, V>* SuccinctTrie<K, V, Allocator>::toArray() const {
+		if (this->activeCapacity == 0) {
+			return nullptr;
+		}
+		std::unique_ptr<E[]> array(new E[this->activeCapacity]);
+		size_t index = 0;
+		std::string key;
+		auto store = [&](const E& entry) {
+			array[index++] = entry;
+			return true;
+		};
+		walk(0, key, store);
+		return array.release();
+	}
+
+	template<typename K, typename V, typename Allocator>
+	Entry<K, V>* SuccinctTrie<K, V, Allocator>::toArray(int start, int end) const {
+		if (start < 0 || end <= start || static_cast<size_t>(end) > this->activeCapacity) {
+			return nullptr;
+		}
+		std::unique_ptr<E[]> array(new E[end - start]);
+		copyTo(std::span<E>(array.get(), end - start), start);
+		return array.release();
+	}
+
+	template<typename K, typename V, typename Allocator>
+	size_t SuccinctTrie<K, V, Allocator>::copyTo(std::span<Entry<K, V>> destination, size_t start) const {
+		if (destination.empty() || start >= this->activeCapacity) {
+			return 0;
+		}
+		const size_t count = std::min(destination.size(), this->activeCapacity - start);
+		const size_t end = start + count;
+		size_t index = 0;
+		std::string key;
+		auto store = [&](const E& entry) {
+			if (index >= start) {
+				destination[index - start] = entry;
+			}
+			return ++index < end;
+		};
+		walk(0, key, store);
+		return count;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	void SuccinctTrie<K, V, Allocator>::reverse() {}
+
+	template<typename K, typename V, typename Allocator>
+	typename SuccinctTrie<K, V, Allocator>::SuccinctTrieIterator SuccinctTrie<K, V, Allocator>::begin() const {
+		return SuccinctTrieIterator(this);
+	}
+
+	template<typename K, typename V, typename Allocator>
+	typename SuccinctTrie<K, V, Allocator>::SuccinctTrieIterator SuccinctTrie<K, V, Allocator>::end() const {
+		return SuccinctTrieIterator(nullptr);
+	}
+
+	template<typename K, typename V, typename Allocator>
+	void SuccinctTrie<K, V, Allocator>::grow() {}
+
+	template<typename K, typename V, typename Allocator>
+	void SuccinctTrie<K, V, Allocator>::shrink() {}
+
+	template<typename K, typename V, typename Allocator>
+	void SuccinctTrie<K, V, Allocator>::compress() {}
+
+	template<typename K, typename V, typename Allocator>
+	bool SuccinctTrie<K, V, Allocator>::equalsInternal(const DataEngine<E>& de) const {
+		auto other = dynamic_cast<const Trie<K, V>*>(&de);
+		if (other == nullptr || other->getActiveSize() != this->activeCapacity) {
+			return false;
+		}
+		if (this->activeCapacity == 0) {
+			return true;
+		}
+		//Both sides are in key byte order, so equal tries match entry by entry
+		std::unique_ptr<E[]> theirs(other->toArray());
+		if (theirs == nullptr) {
+			return false;
+		}
+		size_t index = 0;
+		std::string key;
+		auto compare = [&](const E& entry) {
+			return entry == theirs[index++];
+		};
+		return walk(0, key, compare);
+	}
+
+	template<typename K, typename V, typename Allocator>
+	[[nodiscard]] bool SuccinctTrie<K, V, Allocator>::equivalenceInternal(const DataEngine<E>& de) const {
+		//Entries are ordered by key on both sides, so equivalence and equality coincide
+		return equalsInternal(de);
+	}
+
+	template<typename K, typename V, typename Allocator>
+	std::unique_ptr<DataEngine<Entry<K, V>>> SuccinctTrie<K, V, Allocator>::mergeInternal(const DataEngine<E>& de, int start, int end) const {
+		auto other = dynamic_cast<const Trie<K, V>*>(&de);
+		if (other == nullptr || start < 0 || end < start || static_cast<size_t>(end) > other->getActiveSize()) {
+			return nullptr;
+		}
+		if (end == start) {
+			return clone();
+		}
+		std::unique_ptr<E[]> added(other->toArray(start, end));
+		const size_t addedCount = static_cast<size_t>(end - start);
+		std::unique_ptr<E[]> own(toArray());
+
+		//Linear merge of the two sorted runs, the added entry wins on equal keys
+		std::vector<E> merged;
+		merged.reserve(this->activeCapacity + addedCount);
+		size_t i = 0;
+		size_t j = 0;
+		while (i < this->activeCapacity && j < addedCount) {
+			if (own[i].key < added[j].key) {
+				merged.push_back(std::move(own[i++]));
+			}
+			else if (added[j].key < own[i].key) {
+				merged.push_back(std::move(added[j++]));
+			}
+			else {
+				merged.push_back(std::move(added[j++]));
+				i++;
+			}
+		}
+		for (; i < this->activeCapacity; i++) {
+			merged.push_back(std::move(own[i]));
+		}
+		for (; j < addedCount; j++) {
+			merged.push_back(std::move(added[j]));
+		}
+		return std::unique_ptr<DataEngine<E>>(new SuccinctTrie(merged.data(), merged.size(), allocator));
+	}
+
+	template<typename K, typename V, typename Allocator>
+	void SuccinctTrie<K, V, Allocator>::bind(const void* encoding) noexcept {
+		auto base = static_cast<const uint8_t*>(encoding);
+		header = static_cast<const Header*>(encoding);
+		louds = reinterpret_cast<const uint64_t*>(base + header->louds);
+		loudsRanks = reinterpret_cast<const uint64_t*>(base + header->loudsRanks);
+		loudsSelects = reinterpret_cast<const uint32_t*>(base + header->loudsSelects);
+		labels = base + header->labels;
+		terminals = reinterpret_cast<const uint64_t*>(base + header->terminals);
+		terminalRanks = reinterpret_cast<const uint64_t*>(base + header->terminalRanks);
+		values = base + header->values;
+		this->activeCapacity = header->keyCount;
+		this->maxCapacity = header->keyCount;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	void SuccinctTrie<K, V, Allocator>::build(const E* entries, size_t count) {
+		std::vector<uint64_t> shape;
+		std::vector<uint64_t> ends;
+		std::vector<uint8_t> edges;
+		size_t shapeBits = 0;
+		auto append = [&](bool bit) {
+			if (shapeBits % 64 == 0) {
+				shape.push_back(0);
+			}
+			shape.back() |= uint64_t(bit) << (shapeBits++ % 64);
+		};
+		append(true); //The super root, whose only child is the root
+		append(false);
+
+		//Breadth-first over the sorted keys, a node covers the keys sharing its first depth bytes
+		struct Range {
+			size_t low;
+			size_t high;
+			size_t depth;
+		};
+		std::vector<Range> queue{ { 0, count, 0 } };
+		std::vector<const V*> ordered;
+		ordered.reserve(count);
+		for (size_t head = 0; head < queue.size(); head++) {
+			auto [low, high, depth] = queue[head];
+			if (head % 64 == 0) {
+				ends.push_back(0);
+			}
+			if (low < high && entries[low].key.size() == depth) {
+				//Only the smallest key of the range can end here
+				ends.back() |= uint64_t(1) << (head % 64);
+				ordered.push_back(&entries[low].value);
+				low++;
+			}
+			while (low < high) {
+				const char label = entries[low].key[depth];
+				size_t next = low + 1;
+				while (next < high && entries[next].key[depth] == label) {
+					next++;
+				}
+				append(true);
+				edges.push_back(static_cast<uint8_t>(label));
+				queue.push_back({ low, next, depth + 1 });
+				low = next;
+			}
+			append(false);
+		}
+
+		const size_t nodes = queue.size();
+		const size_t samples = (nodes + 1 + SELECT_SAMPLE - 1) / SELECT_SAMPLE;
+		const Header sections = layout(count, nodes);
+		storage.assign(sections.size / sizeof(Line), Line{});
+		auto base = reinterpret_cast<uint8_t*>(storage.data());
+		std::memcpy(base, &sections, sizeof(Header));
+		std::copy(shape.begin(), shape.end(), reinterpret_cast<uint64_t*>(base + sections.louds));
+		std::copy(edges.begin(), edges.end(), base + sections.labels);
+		std::copy(ends.begin(), ends.end(), reinterpret_cast<uint64_t*>(base + sections.terminals));
+		for (size_t i = 0; i < count; i++) {
+			std::memcpy(base + sections.values + i * sizeof(V), ordered[i], sizeof(V));
+		}
+		auto shapeRanks = reinterpret_cast<uint64_t*>(base + sections.loudsRanks);
+		rankDirectory(shape.data(), shape.size(), shapeRanks);
+		rankDirectory(ends.data(), ends.size(), reinterpret_cast<uint64_t*>(base + sections.terminalRanks));
+
+		//Samples the block holding every SELECT_SAMPLE-th zero
+		auto selects = reinterpret_cast<uint32_t*>(base + sections.loudsSelects);
+		size_t block = 0;
+		for (size_t sample = 0; sample < samples; sample++) {
+			while ((block + 1) * BLOCK_BITS - shapeRanks[block + 1] <= sample * SELECT_SAMPLE) {
+				block++;
+			}
+			selects[sample] = static_cast<uint32_t>(block);
+		}
+		bind(base);
+	}
+
+	template<typename K, typename V, typename Allocator>
+	typename SuccinctTrie<K, V, Allocator>::Header SuccinctTrie<K, V, Allocator>::layout(size_t keys, size_t nodes) noexcept {
+		//The shape holds the two bits of the super root and two per node, every node but the root has a label
+		const size_t shapeWords = (2 * nodes + 1 + 63) / 64;
+		const size_t shapeBlocks = (shapeWords + BLOCK_WORDS - 1) / BLOCK_WORDS;
+		const size_t samples = (nodes + 1 + SELECT_SAMPLE - 1) / SELECT_SAMPLE;
+		const size_t endWords = (nodes + 63) / 64;
+		const size_t endBlocks = (endWords + BLOCK_WORDS - 1) / BLOCK_WORDS;
+		auto align = [](size_t offset) { return (offset + SECTION_ALIGNMENT - 1) / SECTION_ALIGNMENT * SECTION_ALIGNMENT; };
+		Header sections{};
+		sections.magic = MAGIC;
+		sections.version = VERSION;
+		sections.valueSize = sizeof(V);
+		sections.keyCount = keys;
+		sections.nodeCount = nodes;
+		sections.louds = align(sizeof(Header));
+		sections.loudsRanks = align(sections.louds + shapeWords * sizeof(uint64_t));
+		sections.loudsSelects = align(sections.loudsRanks + (shapeBlocks + 1) * sizeof(uint64_t));
+		sections.labels = align(sections.loudsSelects + samples * sizeof(uint32_t));
+		sections.terminals = align(sections.labels + nodes - 1);
+		sections.terminalRanks = align(sections.terminals + endWords * sizeof(uint64_t));
+		sections.values = align(sections.terminalRanks + (endBlocks + 1) * sizeof(uint64_t));
+		sections.size = align(sections.values + keys * sizeof(V));
+		return sections;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	void SuccinctTrie<K, V, Allocator>::rankDirectory(const uint64_t* bits, size_t words, uint64_t* ranks) noexcept {
+		uint64_t ones = 0;
+		for (size_t word = 0; word < words; word++) {
+			if (word % BLOCK_WORDS == 0) {
+				ranks[word / BLOCK_WORDS] = ones;
+			}
+			ones += std::popcount(bits[word]);
+		}
+		ranks[(words + BLOCK_WORDS - 1) / BLOCK_WORDS] = ones;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	size_t SuccinctTrie<K, V, Allocator>::rank(const uint64_t* bits, const uint64_t* ranks, size_t position) noexcept {
+		const size_t word = position / 64;
+		size_t ones = ranks[word / BLOCK_WORDS];
+		for (size_t i = word / BLOCK_WORDS * BLOCK_WORDS; i < word; i++) {
+			ones += std::popcount(bits[i]);
+		}
+		if (position % 64 != 0) {
+			ones += std::popcount(bits[word] << (64 - position % 64));
+		}
+		return ones;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	size_t SuccinctTrie<K, V, Allocator>::select0(size_t index) const noexcept {
+		//The sample gives a block at or before the zero, the directory finds its block
+		size_t block = loudsSelects[index / SELECT_SAMPLE];
+		while ((block + 1) * BLOCK_BITS - loudsRanks[block + 1] <= index) {
+			block++;
+		}
+		size_t remaining = index - (block * BLOCK_BITS - loudsRanks[block]);
+		size_t word = block * BLOCK_WORDS;
+		uint64_t zeros = ~louds[word];
+		for (size_t count = std::popcount(zeros); remaining >= count; count = std::popcount(zeros)) {
+			remaining -= count;
+			zeros = ~louds[++word];
+		}
+		//Skips whole bytes, then clears the zeros before the one wanted
+		size_t position = word * 64;
+		for (size_t count = std::popcount(zeros & 0xFF); remaining >= count; count = std::popcount(zeros & 0xFF)) {
+			remaining -= count;
+			zeros >>= 8;
+			position += 8;
+		}
+		for (; remaining > 0; remaining--) {
+			zeros &= zeros - 1;
+		}
+		return position + std::countr_zero(zeros);
+	}
+
+	template<typename K, typename V, typename Allocator>
+	size_t SuccinctTrie<K, V, Allocator>::nextZero(size_t position) const noexcept {
+		size_t word = position / 64;
+		uint64_t zeros = ~louds[word] >> (position % 64);
+		if (zeros != 0) {
+			return position + std::countr_zero(zeros);
+		}
+		while ((zeros = ~louds[++word]) == 0) {}
+		return word * 64 + std::countr_zero(zeros);
+	}
+
+	template<typename K, typename V, typename Allocator>
+	std::pair<size_t, size_t> SuccinctTrie<K, V, Allocator>::children(size_t node) const noexcept {
+		//The degree of node k follows its zero, k + 1 zeros precede it and each one before it is a node
+		const size_t start = select0(node) + 1;
+		return { start - node - 1, nextZero(start) - start };
+	}
+
+	template<typename K, typename V, typename Allocator>
+	size_t SuccinctTrie<K, V, Allocator>::child(size_t node, uint8_t label) const noexcept {
+		auto [first, count] = children(node);
+		const uint8_t* begin = labels + first - 1;
+		const uint8_t* found = count <= 16 ? std::find(begin, begin + count, label) : std::lower_bound(begin, begin + count, label);
+		if (found == begin + count || *found != label) {
+			return NONE;
+		}
+		return first + (found - begin);
+	}
+
+	template<typename K, typename V, typename Allocator>
+	size_t SuccinctTrie<K, V, Allocator>::descend(const std::string& bytes) const noexcept {
+		size_t node = 0;
+		for (size_t i = 0; i < bytes.size() && node != NONE; i++) {
+			node = child(node, static_cast<uint8_t>(bytes[i]));
+		}
+		return node;
+	}
+
+	template<typename K, typename V, typename Allocator>
+	V SuccinctTrie<K, V, Allocator>::valueOf(size_t node) const noexcept {
+		V value;
+		std::memcpy(&value, values + rank(terminals, terminalRanks, node) * sizeof(V), sizeof(V));
+		return value;
+	}
+}
@@ -0,0 +1,446 @@
+#include "../../Public/Implementation/WorkStealingDeque.h"
+#include "../../Public/EngineSort.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <concepts>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace core {
+	template<typename E, typename Allocator>
+	WorkStealingDeque<E, Allocator>::WorkStealingDeque() : WorkStealingDeque(0) {}
+
+	template<typename E, typename Allocator>
+	WorkStealingDeque<E, Allocator>::WorkStealingDeque(const Allocator& allocator) : WorkStealingDeque(0, allocator) {}
+
+	template<typename E, typename Allocator>
+	WorkStealingDeque<E, Allocator>::WorkStealingDeque(size_t capacity, const Allocator& allocator) : allocator(allocator), top(0), bottom(0),
+		padding{} {
+		const auto required = static_cast<size_t>(std::ceil(capacity / DataEngine<E>::GROWTH_LOAD_FACTOR)) + 1;
+		this->maxCapacity = std::bit_ceil(std::max<size_t>(required, DataEngine<E>::DEFAULT_CAPACITY));
+		this->activeCapacity = 0; //Unused, the live size is derived from the positions
+		ring.store(allocateRing(this->maxCapacity, nullptr), std::memory_order_relaxed);
+		growthThreshold = static_cast<size_t>(this->maxCapacity * DataEngine<E>::GROWTH_LOAD_FACTOR);
+	}
+
+	template<typename E, typename Allocator>
+	WorkStealingDeque<E, Allocator>::~WorkStealingDeque() {
+		Ring* current = ring.load(std::memory_order_relaxed);
+		while (current != nullptr) {
+			Ring* previous = current->previous;
+			deallocateRing(current);
+			current = previous;
+		}
+	}
+
+	template<typename E, typename Allocator>
+	bool WorkStealingDeque<E, Allocator>::addFirst(E) {
+		return false;
+	}
+
+	template<typename E, typename Allocator>
+	bool WorkStealingDeque<E, Allocator>::addLast(E item) {
+		const std::ptrdiff_t b = bottom.load(std::memory_order_relaxed);
+		const std::ptrdiff_t t = top.load(std::memory_order_acquire);
+		if (static_cast<size_t>(b - t) >= growthThreshold) {
+			grow();
+		}
+		ring.load(std::memory_order_relaxed)->store(b, item);
+		//Publishes the item before the new bottom becomes visible to thieves
+		std::atomic_thread_fence(std::memory_order_release);
+		bottom.store(b + 1, std::memory_order_relaxed);
+		return true;
+	}
+
+	template<typename E, typename Allocator>
+	bool WorkStealingDeque<E, Allocator>::tryRemoveLast(E& item) {
+		const std::ptrdiff_t b = bottom.load(std::memory_order_relaxed) - 1;
+		Ring* current = ring.load(std::memory_order_relaxed);
+		bottom.store(b, std::memory_order_relaxed);
+		//Orders the bottom reservation against the read of top, pairing with the fence in steal
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		std::ptrdiff_t t = top.load(std::memory_order_relaxed);
+		if (t > b) {
+			bottom.store(b + 1, std::memory_order_relaxed);
+			return false;
+		}
+		item = current->load(b);
+		if (t == b) {
+			//Last item, race the thieves for it
+			const bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+			bottom.store(b + 1, std::memory_order_relaxed);
+			return won;
+		}
+		return true;
+	}
+
+	template<typename E, typename Allocator>
+	bool WorkStealingDeque<E, Allocator>::steal(E& item) {
+		std::ptrdiff_t t = top.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		const std::ptrdiff_t b = bottom.load(std::memory_order_acquire);
+		if (t >= b) {
+			return false;
+		}
+		const E candidate = ring.load(std::memory_order_acquire)->load(t);
+		if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+			return false;
+		}
+		item = candidate;
+		return true;
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] E WorkStealingDeque<E, Allocator>::removeFirst() {
+		E item;
+		unsigned spins = 0;
+		while (!steal(item)) {
+			if (getActiveSize() == 0) {
+				throw std::out_of_range("removeFirst on an empty deque");
+			}
+			spinPause(spins);
+		}
+		return item;
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] E WorkStealingDeque<E, Allocator>::removeLast() {
+		E item;
+		if (!tryRemoveLast(item)) {
+			throw std::out_of_range("removeLast on an empty deque");
+		}
+		return item;
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] E WorkStealingDeque<E, Allocator>::peekFirst() {
+		const std::ptrdiff_t t = top.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		const std::ptrdiff_t b = bottom.load(std::memory_order_acquire);
+		if (t >= b) {
+			throw std::out_of_range("peekFirst on an empty deque");
+		}
+		return ring.load(std::memory_order_acquire)->load(t);
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] E WorkStealingDeque<E, Allocator>::peekLast() {
+		const std::ptrdiff_t b = bottom.load(std::memory_order_relaxed);
+		if (top.load(std::memory_order_acquire) >= b) {
+			throw std::out_of_range("peekLast on an empty deque");
+		}
+		return ring.load(std::memory_order_relaxed)->load(b - 1);
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] bool WorkStealingDeque<E, Allocator>::contains(E item) {
+		const Ring* current = ring.load(std::memory_order_relaxed);
+		const std::ptrdiff_t b = bottom.load(std::memory_order_relaxed);
+		for (std::ptrdiff_t i = top.load(std::memory_order_acquire); i < b; i++) {
+			if (current->load(i) == item) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	template<typename E, typename Allocator>
+	void WorkStealingDeque<E, Allocator>::replaceAll(std::function<E* (E*)> operatorFunction, int start, int end) {
+		if (start < 0 || end <= start || static_cast<size_t>(end) > getActiveSize()) {
+			return;
+		}
+		Ring* current = ring.load(std::memory_order_relaxed);
+		const std::ptrdiff_t t = top.load(std::memory_order_relaxed);
+		for (int i = start; i < end; i++) {
+			E value = current->load(t + i);
+			E* replacement = operatorFunction(&value);
+			if (replacement != nullptr) {
+				current->store(t + i, *replacement);
+			}
+		}
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] size_t WorkStealingDeque<E, Allocator>::getActiveSize() const {
+		const std::ptrdiff_t b = bottom.load(std::memory_order_acquire);
+		const std::ptrdiff_t t = top.load(std::memory_order_acquire);
+		return b > t ? static_cast<size_t>(b - t) : 0;
+	}
+
+	template<typename E, typename Allocator>
+	void WorkStealingDeque<E, Allocator>::sort() {
+		const size_t count = getActiveSize();
+		if constexpr (std::totally_ordered<E>) {
+			std::vector<E> items(count);
+			copyOut(items.data(), 0, count);
+			ParallelSort::sort(items.data(), count);
+			Ring* current = ring.load(std::memory_order_relaxed);
+			const std::ptrdiff_t t = top.load(std::memory_order_relaxed);
+			for (size_t i = 0; i < count; i++) {
+				current->store(t + i, items[i]);
+			}
+		}
+	}
+
+	template<typename E, typename Allocator>
+	std::unique_ptr<DataEngine<E>> WorkStealingDeque<E, Allocator>::clone() const {
+		const size_t count = getActiveSize();
+		auto copy = std::make_unique<WorkStealingDeque>(count, allocator);
+		std::vector<E> items(count);
+		copyOut(items.data(), 0, count);
+		for (const E& item : items) {
+			copy->addLast(item);
+		}
+		return copy;
+	}
+
+	template<typename E, typename Allocator>
+	std::unique_ptr<DataEngine<E>> WorkStealingDeque<E, Allocator>::move() {
+		auto moved = std::make_unique<WorkStealingDeque>(getActiveSize(), allocator);
+		E item;
+		while (steal(item)) {
+			moved->addLast(item);
+		}
+		return moved;
+	}
+
+	template<typename E, typename Allocator>
+	bool WorkStealingDeque<E, Allocator>::removeAll() {
+		bool removed = false;
+		E item;
+		while (getActiveSize() > 0) {
+			removed |= tryRemoveLast(item);
+		}
+		return removed;
+	}
+
+	template<typename E, typename Allocator>
+	E* WorkStealingDeque<E, Allocator>::toArray() const {
+		return toArray(0, static_cast<int>(getActiveSize()));
+	}
+
+	template<typename E, typename Allocator>
+	E* WorkStealingDeque<E, Allocator>::toArray(int start, int end) const {
+		if (start < 0 || end <= start || static_cast<size_t>(end) > getActiveSize()) {
+			return nullptr;
+		}
+		std::unique_ptr<E[]> array(new E[end - start]);
+		copyOut(array.get(), start, end);
+		return array.release();
+	}
+
+	template<typename E, typename Allocator>
+	size_t WorkStealingDeque<E, Allocator>::copyTo(std::span<E> destination, size_t start) const {
+		const size_t size = getActiveSize();
+		if (destination.empty() || start >= size) {
+			return 0;
+		}
+		const size_t count = std::min(destination.size(), size - start);
+		copyOut(destination.data(), start, start + count);
+		return count;
+	}
+
+	template<typename E, typename Allocator>
+	void WorkStealingDeque<E, Allocator>::reverse() {
+		Ring* current = ring.load(std::memory_order_relaxed);
+		std::ptrdiff_t left = top.load(std::memory_order_relaxed);
+		std::ptrdiff_t right = bottom.load(std::memory_order_relaxed) - 1;
+		for (; left < right; left++, right--) {
+			const E swap = current->load(left);
+			current->store(left, current->load(right));
+			current->store(right, swap);
+		}
+	}
+
+	template<typename E, typename Allocator>
+	typename WorkStealingDeque<E, Allocator>::iterator WorkStealingDeque<E, Allocator>::begin() {
+		return iterator(ring.load(std::memory_order_relaxed), top.load(std::memory_order_acquire));
+	}
+
+	template<typename E, typename Allocator>
+	typename WorkStealingDeque<E, Allocator>::const_iterator WorkStealingDeque<E, Allocator>::begin() const {
+		return const_iterator(ring.load(std::memory_order_relaxed), top.load(std::memory_order_acquire));
+	}
+
+	template<typename E, typename Allocator>
+	typename WorkStealingDeque<E, Allocator>::iterator WorkStealingDeque<E, Allocator>::end() {
+		return iterator(ring.load(std::memory_order_relaxed), bottom.load(std::memory_order_relaxed));
+	}
+
+	template<typename E, typename Allocator>
+	typename WorkStealingDeque<E, Allocator>::const_iterator WorkStealingDeque<E, Allocator>::end() const {
+		return const_iterator(ring.load(std::memory_order_relaxed), bottom.load(std::memory_order_relaxed));
+	}
+
+	template<typename E, typename Allocator>
+	typename WorkStealingDeque<E, Allocator>::Ring* WorkStealingDeque<E, Allocator>::allocateRing(size_t capacity, Ring* previous) const {
+		Slot* slots = allocateStorage<Slot>(allocator, capacity);
+		std::uninitialized_default_construct_n(slots, capacity);
+		try {
+			return createObject<Ring>(allocator, capacity, slots, previous);
+		}
+		catch (...) {
+			deallocateStorage(allocator, slots, capacity);
+			throw;
+		}
+	}
+
+	template<typename E, typename Allocator>
+	void WorkStealingDeque<E, Allocator>::deallocateRing(Ring* released) const noexcept {
+		deallocateStorage(allocator, released->slots, released->capacity);
+		destroyObject(allocator, released);
+	}
+
+	template<typename E, typename Allocator>
+	void WorkStealingDeque<E, Allocator>::grow() {
+		Ring* old = ring.load(std::memory_order_relaxed);
+		const std::ptrdiff_t b = bottom.load(std::memory_order_relaxed);
+		const std::ptrdiff_t t = top.load(std::memory_order_acquire);
+		Ring* fresh = allocateRing(old->capacity << 1, old);
+		//Positions are absolute, so every item keeps its position and in-flight steals stay valid
+		for (std::ptrdiff_t i = t; i < b; i++) {
+			fresh->store(i, old->load(i));
+		}
+		ring.store(fresh, std::memory_order_release);
+		this->maxCapacity = fresh->capacity;
+		growthThreshold = static_cast<size_t>(this->maxCapacity * DataEngine<E>::GROWTH_LOAD_FACTOR);
+	}
+
+	template<typename E, typename Allocator>
+	void WorkStealingDeque<E, Allocator>::shrink() {}
+
+	template<typename E, typename Allocator>
+	void WorkStealingDeque<E, Allocator>::compress() {}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] bool WorkStealingDeque<E, Allocator>::containsAllInternal(std::any* deque, int start, int end) {
+		auto other = std::any_cast<Deque<E>*>(deque);
+		if (other == nullptr) {
+			return false;
+		}
+		std::unique_ptr<E[]> items((*other)->toArray(start, end));
+		if (items == nullptr) {
+			return false;
+		}
+		for (int i = 0; i < end - start; i++) {
+			if (!contains(items[i])) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] std::any* WorkStealingDeque<E, Allocator>::retainAll(std::any* deque) {
+		auto other = std::any_cast<Deque<E>*>(deque);
+		if (other == nullptr) {
+			return nullptr;
+		}
+		Ring* current = ring.load(std::memory_order_relaxed);
+		const std::ptrdiff_t t = top.load(std::memory_order_relaxed);
+		const std::ptrdiff_t b = bottom.load(std::memory_order_relaxed);
+		std::ptrdiff_t write = t;
+		for (std::ptrdiff_t read = t; read < b; read++) {
+			const E item = current->load(read);
+			if ((*other)->contains(item)) {
+				current->store(write++, item);
+			}
+		}
+		bottom.store(write, std::memory_order_release);
+		return new std::any(static_cast<Deque<E>*>(this));
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] std::any* WorkStealingDeque<E, Allocator>::mergeFirst(std::any*) {
+		return nullptr;
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] std::any* WorkStealingDeque<E, Allocator>::mergeLast(std::any* deque) {
+		auto other = std::any_cast<Deque<E>*>(deque);
+		if (other == nullptr) {
+			return nullptr;
+		}
+		const size_t count = (*other)->getActiveSize();
+		if (count > 0) {
+			std::unique_ptr<E[]> items((*other)->toArray());
+			for (size_t i = 0; i < count; i++) {
+				addLast(items[i]);
+			}
+		}
+		return new std::any(static_cast<Deque<E>*>(this));
+	}
+
+	template<typename E, typename Allocator>
+	bool WorkStealingDeque<E, Allocator>::equalsInternal(const DataEngine<E>& de) const {
+		auto other = dynamic_cast<const Deque<E>*>(&de);
+		const size_t count = getActiveSize();
+		if (other == nullptr || other->getActiveSize() != count) {
+			return false;
+		}
+		if (count == 0) {
+			return true;
+		}
+		std::unique_ptr<E[]> mine(toArray());
+		std::unique_ptr<E[]> theirs(other->toArray());
+		return theirs != nullptr && std::equal(mine.get(), mine.get() + count, theirs.get());
+	}
+
+	template<typename E, typename Allocator>
+	[[nodiscard]] bool WorkStealingDeque<E, Allocator>::equivalenceInternal(const DataEngine<E>& de) const {
+		auto other = dynamic_cast<const Deque<E>*>(&de);
+		const size_t count = getActiveSize();
+		if (other == nullptr || other->getActiveSize() != count) {
+			return false;
+		}
+		if (count == 0) {
+			return true;
+		}
+		std::unique_ptr<E[]> mine(toArray());
+		std::unique_ptr<E[]> theirs(other->toArray());
+		if (theirs == nullptr) {
+			return false;
+		}
+		if constexpr (std::totally_ordered<E>) {
+			std::sort(mine.get(), mine.get() + count);
+			std::sort(theirs.get(), theirs.get() + count);
+			return std::equal(mine.get(), mine.get() + count, theirs.get());
+		}
+		else {
+			return std::is_permutation(mine.get(), mine.get() + count, theirs.get());
+		}
+	}
+
+	template<typename E, typename Allocator>
+	std::unique_ptr<DataEngine<E>> WorkStealingDeque<E, Allocator>::mergeInternal(const DataEngine<E>& de, int start, int end) const {
+		auto other = dynamic_cast<const Deque<E>*>(&de);
+		if (other == nullptr || start < 0 || end < start || static_cast<size_t>(end) > other->getActiveSize()) {
+			return nullptr;
+		}
+		const size_t count = getActiveSize();
+		auto merged = std::make_unique<WorkStealingDeque>(count + (end - start), allocator);
+		std::vector<E> items(count);
+		copyOut(items.data(), 0, count);
+		for (const E& item : items) {
+			merged->addLast(item);
+		}
+		if (end > start) {
+			std::unique_ptr<E[]> theirs(other->toArray(start, end));
+			for (int i = 0; i < end - start; i++) {
+				merged->addLast(theirs[i]);
+			}
+		}
+		return merged;
+	}
+
+	template<typename E, typename Allocator>
+	void WorkStealingDeque<E, Allocator>::copyOut(E* destination, size_t start, size_t end) const {
+		const Ring* current = ring.load(std::memory_order_acquire);
+		const std::ptrdiff_t t = top.load(std::memory_order_acquire);
+		for (size_t i = start; i < end; i++) {
+			*destination++ = current->load(t + static_cast<std::ptrdiff_t>(i));
+		}
+	}
+}
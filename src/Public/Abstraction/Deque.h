@@ -125,7 +125,7 @@ namespace core {
 	* @param start Starting index
 	* @param end Endpoint index
 	*/
-	virtual void replaceALl(std::function<E* (E*)> operatorFunction, int start, int end) = 0;
+	virtual void replaceAll(std::function<E* (E*)> operatorFunction, int start, int end) = 0;
 protected:
 
 	/**
@@ -1,4 +1,88 @@
 #pragma once
-class Graph {
-};
+#include "../../Public/DataEngine.h"
+#include "../../Public/EngineCore.h"
+#include "../../Public/EngineMacros.h"
+#include <string>
+#include <vector>
 
+namespace core {
+	/**
+	* Edge of a graph in list form, the usual input of graph builders
+	* @tparam E Type of the vertex identifiers
+	*/
+	template<typename E>
+	struct GraphEdge {
+		E source;
+		E target;
+	};
+
+	/**
+	* Edge of a weighted graph in list form
+	* @tparam E Type of the vertex identifiers
+	*/
+	template<typename E>
+	struct WeightedGraphEdge {
+		E source;
+		E target;
+		float weight;
+	};
+
+	/**
+	* Time spent in one phase of a graph algorithm, summed over all the times the phase ran
+	*/
+	struct GraphPhase {
+		std::string name;
+		double seconds;
+	};
+
+	/**
+	* Superclass for all Graph implementations. A graph has a fixed number of vertices, identified by the
+	* integers from zero, and a set of arcs between them. An undirected graph stores each of its edges as
+	* two arcs, one in each direction. The elements of a graph are the targets of its arcs, listed vertex
+	* by vertex, so its size is the number of arcs. Merging adds the arcs of a range of vertices of the
+	* other graph. It is a generic class, implemented through the DataEngine MACROS. Cloning through copy
+	* constructors is disabled due to shallow copying. Instead, deep copying is enabled via polymorphic
+	* methods provided.
+	*/
+	S_ABSTRACT_ENGINE_CLASS(Graph, Nature::UNDEFINED, Behavior::NONE, Ordering::UNSUPPORTED)
+	/**
+	* @return Returns the number of vertices
+	*/
+	[[nodiscard]] virtual size_t getVertices() const = 0;
+
+	/**
+	* @return Returns the number of vertices, merges take ranges of vertices
+	*/
+	[[nodiscard]] size_t mergeExtent() const override;
+
+	/**
+	* @return Returns true if the arcs of the graph have a direction, false if each edge is stored both ways
+	*/
+	[[nodiscard]] virtual bool isDirected() const = 0;
+
+	/**
+	* Gets the number of arcs leaving a vertex
+	* @param vertex The vertex
+	* @return Returns the out-degree of the vertex
+	* @throws std::out_of_range if the vertex does not exist
+	*/
+	[[nodiscard]] virtual size_t getDegree(E vertex) const = 0;
+
+	/**
+	* Checks if the invoking graph has an arc from one vertex to another
+	* @param source The vertex the arc leaves
+	* @param target The vertex the arc enters
+	* @return Returns true if the arc exists, false otherwise
+	* @throws std::out_of_range if either vertex does not exist
+	*/
+	[[nodiscard]] virtual bool containsEdge(E source, E target) const = 0;
+
+	/**
+	* Gets the targets of the arcs leaving a vertex
+	* @param vertex The vertex
+	* @return Returns the neighbors of the vertex
+	* @throws std::out_of_range if the vertex does not exist
+	*/
+	[[nodiscard]] virtual std::vector<E> getNeighbors(E vertex) const = 0;
+	E_ENGINE_CLASS
+}
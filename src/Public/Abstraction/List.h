@@ -90,7 +90,7 @@ namespace core {
 	* @param index Index of the item to be fetched
 	* @return Returns the item at the given index, else nullptr
 	*/
-	virtual E get(int index) = 0;
+	virtual E get(int index) const = 0;
 
 	/**
 	* Gets the first index of the given item in the list
@@ -215,6 +215,8 @@ namespace core {
 	List& operator=(List&&) noexcept = default;
 
 protected:
+	List() = default;
+
 	/**
 	* @return Returns the total load on the invoking list
 	*/
@@ -1,4 +1,52 @@
 #pragma once
-class Map {
-};
+#include "../../Public/DataEngine.h"
+#include "../../Public/EngineCore.h"
+#include "../../Public/EngineMacros.h"
 
+namespace core {
+	/**
+	* Superclass for all Map implementations. This abstraction defines behavior to be supported
+	* by all implementations of Map. A map associates each unique key with exactly one value and stores
+	* the pairs as Entry<K, V>, which is the element type seen through DataEngine. It is a generic class,
+	* implemented through the map forms of the DataEngine MACROS. Cloning through copy constructors is
+	* disabled due to shallow copying. Instead, deep copying is enabled via polymorphic methods provided.
+	*/
+	S_ABSTRACT_MAP_ENGINE_CLASS(Map, Nature::UNDEFINED, Behavior::NONE, Ordering::UNSUPPORTED)
+	/**
+	* Associates the value with the key, replacing the value already associated with it
+	* @param key The key
+	* @param value The value
+	* @return Returns true if the key was not present before, false if its value was replaced
+	*/
+	virtual bool put(K key, V value) = 0;
+
+	/**
+	* Gets the value associated with the key
+	* @param key The key to be searched
+	* @param value Receives a copy of the value if the key is present
+	* @return Returns true if the key is present, false otherwise
+	*/
+	[[nodiscard]] virtual bool get(const K& key, V& value) const = 0;
+
+	/**
+	* Removes the key and its value
+	* @param key The key to be removed
+	* @return Returns true if the key was present, false otherwise
+	*/
+	virtual bool remove(const K& key) = 0;
+
+	/**
+	* Checks if the invoking map contains the given key
+	* @param key The key to be checked
+	* @return Returns true if the key is present, false otherwise
+	*/
+	[[nodiscard]] virtual bool containsKey(const K& key) = 0;
+
+	/**
+	* Checks if any key of the invoking map is associated with the given value
+	* @param value The value to be checked
+	* @return Returns true if the value is present, false otherwise
+	*/
+	[[nodiscard]] virtual bool containsValue(const V& value) = 0;
+	E_ENGINE_CLASS
+}
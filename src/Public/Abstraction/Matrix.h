@@ -1,4 +1,61 @@
 #pragma once
-class Matrix {
-};
+#include "../../Public/DataEngine.h"
+#include "../../Public/EngineCore.h"
+#include "../../Public/EngineMacros.h"
 
+namespace core {
+	/**
+	* Element of a matrix in coordinate form, the usual input of sparse matrices
+	* @tparam E Type of the element
+	*/
+	template<typename E>
+	struct MatrixTriplet {
+		size_t row;
+		size_t column;
+		E value;
+	};
+
+	/**
+	* Superclass for all Matrix implementations. A matrix is a two dimensional grid of elements addressed
+	* by row and column, both counted from zero. The size of a matrix is the number of elements in its
+	* grid, and its array forms list the elements row by row. Merging stacks the rows of the other matrix
+	* under those of the invoking one. It is a generic class, implemented through the DataEngine MACROS.
+	* Cloning through copy constructors is disabled due to shallow copying. Instead, deep copying is
+	* enabled via polymorphic methods provided.
+	*/
+	S_ABSTRACT_ENGINE_CLASS(Matrix, Nature::UNDEFINED, Behavior::NONE, Ordering::UNSUPPORTED)
+	/**
+	* @return Returns the number of rows
+	*/
+	[[nodiscard]] virtual size_t getRows() const = 0;
+
+	/**
+	* @return Returns the number of rows, merges take ranges of rows
+	*/
+	[[nodiscard]] size_t mergeExtent() const override;
+
+	/**
+	* @return Returns the number of columns
+	*/
+	[[nodiscard]] virtual size_t getColumns() const = 0;
+
+	/**
+	* Gets the element at the given position
+	* @param row Row of the element
+	* @param column Column of the element
+	* @return Returns the element
+	* @throws std::out_of_range if the position lies outside the matrix
+	*/
+	[[nodiscard]] virtual E get(size_t row, size_t column) const = 0;
+
+	/**
+	* Replaces the element at the given position
+	* @param row Row of the element
+	* @param column Column of the element
+	* @param value The new element
+	* @return Returns true if the element was replaced, false if the matrix cannot store it there
+	* @throws std::out_of_range if the position lies outside the matrix
+	*/
+	virtual bool set(size_t row, size_t column, E value) = 0;
+	E_ENGINE_CLASS
+}
@@ -1,4 +1,29 @@
 #pragma once
-class Queue {
-};
+#include "../../Public/DataEngine.h"
+#include "../../Public/EngineCore.h"
+#include "../../Public/EngineMacros.h"
 
+namespace core {
+	/**
+	* Superclass for all Queue implementations. This abstraction defines behavior to be supported
+	* by all implementations of Queue. A queue is defined as a first-in-first-out engine, which allows
+	* item addition at the tail and item removal from the head only. It is a generic class, implemented
+	* through the DataEngine MACROS. Cloning through copy constructors is disabled due to shallow copying.
+	* Instead, deep copying is enabled via polymorphic methods provided.
+	*/
+	S_ABSTRACT_ENGINE_CLASS(Queue, Nature::UNDEFINED, Behavior::NONE, Ordering::UNSUPPORTED)
+	/**
+	* Adds the item to the tail of the queue without blocking
+	* @param item The item to be added
+	* @return Returns true if addition is successful, false otherwise, e.g. when a bounded queue is full
+	*/
+	virtual bool enqueue(E item) = 0;
+
+	/**
+	* Removes the item at the head of the queue without blocking
+	* @param item Receives the removed item
+	* @return Returns true if an item was removed, false if the queue is empty
+	*/
+	virtual bool dequeue(E& item) = 0;
+	E_ENGINE_CLASS
+}
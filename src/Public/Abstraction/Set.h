@@ -1,4 +1,99 @@
 #pragma once
-class Set {
-};
+#include "../../Public/DataEngine.h"
+#include "../../Public/EngineCore.h"
+#include "../../Public/EngineMacros.h"
+#include <any>
 
+namespace core {
+	/**
+	* Superclass for all Set implementations. A set holds each item at most once. The bulk operations
+	* combine another set with the invoking one in place: addAll is the union, retainAll the intersection
+	* and discardAll the difference. They go through internal type-erasure forms, so that an
+	* implementation can recognize a set of its own kind and combine the two directly. It is a generic
+	* class, implemented through the DataEngine MACROS. Cloning through copy constructors is disabled due
+	* to shallow copying. Instead, deep copying is enabled via polymorphic methods provided.
+	*/
+	S_ABSTRACT_ENGINE_CLASS(Set, Nature::UNDEFINED, Behavior::NONE, Ordering::UNSUPPORTED)
+	/**
+	* Adds the given item to the set
+	* @param item Item to be added
+	* @return Returns true if the item was not present before, false otherwise
+	*/
+	virtual bool add(E item) = 0;
+
+	/**
+	* Removes the given item from the set
+	* @param item Item to be removed
+	* @return Returns true if the item was present, false otherwise
+	*/
+	virtual bool remove(E item) = 0;
+
+	/**
+	* Checks if the given item is present in the set
+	* @param item The item to be checked
+	* @return Returns true if the item is present, false otherwise
+	*/
+	[[nodiscard]] virtual bool contains(E item) const = 0;
+
+	/**
+	* Checks if all the items of the given set are present in the invoking set
+	* @param set The set to be checked
+	* @return Returns true if all the items are present, false otherwise
+	*/
+	template<typename T> requires ValidBase<E, T>
+	[[nodiscard]] bool containsAll(T* set);
+
+	/**
+	* Adds all the items of the given set to the invoking set, their union
+	* @param set The set to be added
+	* @return Returns true if the invoking set changed, false otherwise
+	*/
+	template<typename T> requires ValidBase<E, T>
+	bool addAll(T* set);
+
+	/**
+	* Keeps only the items of the invoking set that are present in the given set, their intersection
+	* @param set The set to be retained
+	* @return Returns true if the invoking set changed, false otherwise
+	*/
+	template<typename T> requires ValidBase<E, T>
+	bool retainAll(T* set);
+
+	/**
+	* Removes all the items of the given set from the invoking set, their difference
+	* @param set The set to be discarded
+	* @return Returns true if the invoking set changed, false otherwise
+	*/
+	template<typename T> requires ValidBase<E, T>
+	bool discardAll(T* set);
+
+protected:
+	/**
+	* Internal type-erasure form of containsAll
+	* @param set Holds the set to be checked as a Set<E>*
+	* @return Returns true if all the items are present, false otherwise
+	*/
+	[[nodiscard]] virtual bool containsAllInternal(std::any* set) = 0;
+
+	/**
+	* Internal type-erasure form of addAll
+	* @param set Holds the set to be added as a Set<E>*
+	* @return Returns true if the invoking set changed, false otherwise
+	*/
+	virtual bool addAllInternal(std::any* set) = 0;
+
+	/**
+	* Internal type-erasure form of retainAll
+	* @param set Holds the set to be retained as a Set<E>*
+	* @return Returns true if the invoking set changed, false otherwise
+	*/
+	virtual bool retainAllInternal(std::any* set) = 0;
+
+	/**
+	* Internal type-erasure form of discardAll
+	* @param set Holds the set to be discarded as a Set<E>*
+	* @return Returns true if the invoking set changed, false otherwise
+	*/
+	virtual bool discardAllInternal(std::any* set) = 0;
+	E_ENGINE_CLASS
+}
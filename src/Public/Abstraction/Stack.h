@@ -1,4 +1,34 @@
 #pragma once
-class Stack {
-};
+#include "../../Public/DataEngine.h"
+#include "../../Public/EngineCore.h"
+#include "../../Public/EngineMacros.h"
 
+namespace core {
+	/**
+	* Superclass for all Stack implementations. This abstraction defines behavior to be supported
+	* by all implementations of Stack. A stack is defined as a last-in-first-out engine, which allows
+	* item addition and removal at the top only. Items are listed from the bottom to the top. It is a
+	* generic class, implemented through the DataEngine MACROS. Cloning through copy constructors is
+	* disabled due to shallow copying. Instead, deep copying is enabled via polymorphic methods provided.
+	*/
+	S_ABSTRACT_ENGINE_CLASS(Stack, Nature::UNDEFINED, Behavior::NONE, Ordering::UNSUPPORTED)
+	/**
+	* Adds the item to the top of the stack
+	* @param item The item to be added
+	* @return Returns true if addition is successful, false otherwise
+	*/
+	virtual bool push(E item) = 0;
+
+	/**
+	* Removes the item at the top of the stack
+	* @param item Receives the removed item
+	* @return Returns true if an item was removed, false if the stack is empty
+	*/
+	virtual bool pop(E& item) = 0;
+
+	/**
+	* @return Returns the item at the top of the stack, nullptr if the stack is empty
+	*/
+	[[nodiscard]] virtual E* peek() = 0;
+	E_ENGINE_CLASS
+}
@@ -1,4 +1,93 @@
 #pragma once
-class Tree {
-};
+#include "../../Public/DataEngine.h"
+#include "../../Public/EngineCore.h"
+#include "../../Public/EngineMacros.h"
+#include <functional>
 
+namespace core {
+	/**
+	* Superclass for all Tree implementations. A tree is an ordered map kept in a hierarchy of nodes: it
+	* associates each unique key with exactly one value and keeps the pairs sorted by key, so that besides
+	* the lookups of Map it answers ordered queries and range scans. An ordered set is a Tree whose value
+	* type is empty, such as std::monostate. It is a generic class, implemented through the map forms of
+	* the DataEngine MACROS. Cloning through copy constructors is disabled due to shallow copying. Instead,
+	* deep copying is enabled via polymorphic methods provided.
+	*/
+	S_ABSTRACT_MAP_ENGINE_CLASS(Tree, Nature::UNDEFINED, Behavior::NONE, Ordering::UNSUPPORTED)
+	/**
+	* Associates the value with the key, replacing the value already associated with it
+	* @param key The key
+	* @param value The value
+	* @return Returns true if the key was not present before, false if its value was replaced
+	*/
+	virtual bool put(K key, V value) = 0;
+
+	/**
+	* Gets the value associated with the key
+	* @param key The key to be searched
+	* @param value Receives a copy of the value if the key is present
+	* @return Returns true if the key is present, false otherwise
+	*/
+	[[nodiscard]] virtual bool get(const K& key, V& value) const = 0;
+
+	/**
+	* Removes the key and its value
+	* @param key The key to be removed
+	* @return Returns true if the key was present, false otherwise
+	*/
+	virtual bool remove(const K& key) = 0;
+
+	/**
+	* Checks if the invoking tree contains the given key
+	* @param key The key to be checked
+	* @return Returns true if the key is present, false otherwise
+	*/
+	[[nodiscard]] virtual bool containsKey(const K& key) const = 0;
+
+	/**
+	* Checks if any key of the invoking tree is associated with the given value
+	* @param value The value to be checked
+	* @return Returns true if the value is present, false otherwise
+	*/
+	[[nodiscard]] virtual bool containsValue(const V& value) = 0;
+
+	/**
+	* Gets the entry with the smallest key
+	* @param entry Receives a copy of the entry if the tree is not empty
+	* @return Returns true if the tree is not empty, false otherwise
+	*/
+	[[nodiscard]] virtual bool first(E& entry) const = 0;
+
+	/**
+	* Gets the entry with the greatest key
+	* @param entry Receives a copy of the entry if the tree is not empty
+	* @return Returns true if the tree is not empty, false otherwise
+	*/
+	[[nodiscard]] virtual bool last(E& entry) const = 0;
+
+	/**
+	* Gets the entry with the smallest key greater than or equal to the given key
+	* @param key The lower bound
+	* @param entry Receives a copy of the entry if there is one
+	* @return Returns true if such an entry exists, false otherwise
+	*/
+	[[nodiscard]] virtual bool ceiling(const K& key, E& entry) const = 0;
+
+	/**
+	* Gets the entry with the greatest key less than or equal to the given key
+	* @param key The upper bound
+	* @param entry Receives a copy of the entry if there is one
+	* @return Returns true if such an entry exists, false otherwise
+	*/
+	[[nodiscard]] virtual bool floor(const K& key, E& entry) const = 0;
+
+	/**
+	* Visits the entries in ascending key order, starting at the first key greater than or equal to the
+	* lower bound, until the visitor returns false or the entries run out
+	* @param from The lower bound
+	* @param visitor Function receiving each entry, returning false to stop the scan
+	* @return Returns the number of entries visited
+	*/
+	virtual size_t scan(const K& from, std::function<bool(const E&)> visitor) const = 0;
+	E_ENGINE_CLASS
+}
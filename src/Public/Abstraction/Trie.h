@@ -1,4 +1,72 @@
 #pragma once
-class Trie {
-};
+#include "../../Public/DataEngine.h"
+#include "../../Public/EngineCore.h"
+#include "../../Public/EngineMacros.h"
+#include <functional>
 
+namespace core {
+	/**
+	* Superclass for all Trie implementations. A trie is an ordered map indexed by the bytes of its keys: it
+	* associates each unique key with exactly one value and keeps the pairs in the lexicographic order of
+	* those bytes, so that besides the lookups of Map it answers prefix queries. Strings are indexed by their
+	* characters, integers by their big-endian bytes with the sign flipped, so that the byte order is the
+	* numeric order. It is a generic class, implemented through the map forms of the DataEngine MACROS.
+	* Cloning through copy constructors is disabled due to shallow copying. Instead, deep copying is enabled
+	* via polymorphic methods provided.
+	*/
+	S_ABSTRACT_MAP_ENGINE_CLASS(Trie, Nature::UNDEFINED, Behavior::NONE, Ordering::UNSUPPORTED)
+	/**
+	* Associates the value with the key, replacing the value already associated with it
+	* @param key The key
+	* @param value The value
+	* @return Returns true if the key was not present before, false if its value was replaced
+	*/
+	virtual bool put(K key, V value) = 0;
+
+	/**
+	* Gets the value associated with the key
+	* @param key The key to be searched
+	* @param value Receives a copy of the value if the key is present
+	* @return Returns true if the key is present, false otherwise
+	*/
+	[[nodiscard]] virtual bool get(const K& key, V& value) const = 0;
+
+	/**
+	* Removes the key and its value
+	* @param key The key to be removed
+	* @return Returns true if the key was present, false otherwise
+	*/
+	virtual bool remove(const K& key) = 0;
+
+	/**
+	* Checks if the invoking trie contains the given key
+	* @param key The key to be checked
+	* @return Returns true if the key is present, false otherwise
+	*/
+	[[nodiscard]] virtual bool containsKey(const K& key) const = 0;
+
+	/**
+	* Checks if any key of the invoking trie is associated with the given value
+	* @param value The value to be checked
+	* @return Returns true if the value is present, false otherwise
+	*/
+	[[nodiscard]] virtual bool containsValue(const V& value) = 0;
+
+	/**
+	* Visits the entries whose keys start with the given prefix in ascending order, until the visitor
+	* returns false or the entries run out
+	* @param prefix The prefix, an empty one visits every entry
+	* @param visitor Function receiving each entry, returning false to stop the scan
+	* @return Returns the number of entries visited
+	*/
+	virtual size_t scanPrefix(const K& prefix, std::function<bool(const E&)> visitor) const = 0;
+
+	/**
+	* Gets the entry with the longest key that is a prefix of the given key, the key itself included
+	* @param key The key to be matched
+	* @param entry Receives a copy of the entry if there is one
+	* @return Returns true if some key is a prefix of the given key, false otherwise
+	*/
+	[[nodiscard]] virtual bool longestPrefix(const K& key, E& entry) const = 0;
+	E_ENGINE_CLASS
+}
@@ -2,7 +2,9 @@
 #include <atomic>
 #include <memory>
 #include <any>
+#include <span>
 #include "EngineCore.h"
+#include "EngineImage.h"
 
 namespace core {
 
@@ -12,7 +14,9 @@ namespace core {
 	template<typename E, typename Derived>
 	concept ValidBase = is_base_of<DataEngine<E>, Derived>::value;
 
-	class Dummy {}; //Dummy needed for sortable.
+	//Empty stand-ins for Sortable, one per layer so that an implementation never inherits the same base twice
+	class Dummy {};
+	class ImplementationDummy {};
 
 	/**
 	* The top-level virtual class for all DataEngines. It defines behavior that is shared between among
@@ -24,13 +28,14 @@ namespace core {
 	* @tparam E Type parameter of stored data
 	*/
 	template <typename E>
-	class DataEngine : Iterable<E> {
+	class DataEngine {
 	protected:
 		size_t maxCapacity;
 		size_t activeCapacity;
 
 		constexpr static double GOLDEN_RATIO = 1.61803398875;
 		constexpr static int DEFAULT_CAPACITY = 16;
+		constexpr static size_t CACHE_LINE_SIZE = 64; //Alignment used to keep hot atomics off shared lines
 
 		constexpr static double GROWTH_LOAD_FACTOR = 0.75;
 		constexpr static double SHRINK_LOAD_FACTOR = 0.25;
@@ -39,7 +44,6 @@ namespace core {
 		virtual void shrink() = 0; //Method to shrink the capacity of the data engine
 		virtual void compress() = 0; //Method to compress the data engine
 
-		virtual ~DataEngine() = default;
 		DataEngine() = default;
 
 		//Adding move semantics
@@ -47,6 +51,9 @@ namespace core {
 		DataEngine& operator=(DataEngine&&) noexcept = default;
 
 	public:
+		//Public so that the engines returned by clone, move and merge can be released through DataEngine
+		virtual ~DataEngine() = default;
+
 		//Removing copy semantics
 		DataEngine(const DataEngine&) = delete;
 		DataEngine& operator=(const DataEngine&) = delete;
@@ -55,10 +62,16 @@ namespace core {
 		[[nodiscard]] bool isMutable() const;
 		[[nodiscard]] bool isThreadSafe() const;
 
-		//Size methods
-		[[nodiscard]] size_t getActiveSize() const;
+		//Size methods, concurrent engines override getActiveSize to report a snapshot of their live size
+		[[nodiscard]] virtual size_t getActiveSize() const;
 		[[nodiscard]] size_t getMaxCapacity() const;
 
+		/**
+		* @return Returns the end of the range merged when merge is given none, the active size unless the
+		* engine merges ranges of something else than its items
+		*/
+		[[nodiscard]] virtual size_t mergeExtent() const;
+
 		//Empty check
 		[[nodiscard]] bool isEmpty() const;
 
@@ -68,19 +81,23 @@ namespace core {
 		virtual std::unique_ptr<DataEngine> clone() const = 0;
 
 		/**
-		* Virtual polymorphic move method
+		* Virtual polymorphic move method. It allocates the engine it returns, and may allocate a new empty
+		* state for the invoking one, so it can throw std::bad_alloc
 		*/
-		virtual std::unique_ptr<DataEngine> move() noexcept = 0;
+		virtual std::unique_ptr<DataEngine> move() = 0;
 
 		//Functions that all implementations must guarantee
 
 		/**
-		* Creates a thread-safe image of the invoking data-engine by wrapping it in atomic
+		* Creates a thread-safe image of the invoking data-engine, holding a copy of it as its first version.
+		* Readers traverse snapshots of the image without locks while writers publish new versions, see
+		* ThreadSafeImage
 		*
-		* @return Returns a @code std::atomic pointer containing the invoking engine
+		* @tparam T Type of the engine held by the image
+		* @return Returns the image, nullptr if the invoking data engine is not a T
 		*/
 		template<typename T> requires ValidBase<E, T>
-		std::atomic<T>* getThreadSafeImage() const;
+		std::unique_ptr<ThreadSafeImage<T>> getThreadSafeImage() const;
 
 		/**
 		* Removes all the items if present
@@ -90,14 +107,16 @@ namespace core {
 		virtual bool removeAll() = 0;
 
 		/**
-		* Converts the invoking data engine into an array of all the elements
+		* Converts the invoking data engine into an array of all the elements. The array is a copy owned by
+		* the caller, to be released with delete[]. copyTo, or view on Contiguous engines, avoids the copy
 		*
 		* @return Returns an array representation
 		*/
 		virtual E* toArray() const = 0;
 
 		/**
-		* Converts the invoking data engine into an array of all the elements in the provided range
+		* Converts the invoking data engine into an array of all the elements in the provided range. The array
+		* is a copy owned by the caller, to be released with delete[]
 		*
 		* @param start Starting index
 		* @param end Endpoint index
@@ -105,16 +124,29 @@ namespace core {
 		*/
 		virtual E* toArray(int start, int end) const = 0;
 
+		/**
+		* Copies the elements, in the order of toArray, into storage owned by the caller: as many as the
+		* destination holds, from the provided index on. Nothing is allocated, so a large engine can be
+		* streamed out through a fixed-size buffer. Engines which cannot seek to an index walk up to it, so
+		* for them the cost of a call grows with start
+		*
+		* @param destination Storage receiving the elements
+		* @param start Index of the first element copied
+		* @return Returns the number of elements copied, 0 if start is past the last element
+		*/
+		virtual size_t copyTo(std::span<E> destination, size_t start) const = 0;
+
 		/**
 		* Checks if the invoking data engine and the data engine passed are truly equal, i.e. equal length
-		* and ordering of elements
+		* and ordering of elements. Implementations resolve the comparison at compile time when both sides
+		* have the same static type, see ENGINE_STATIC_DISPATCH
 		*
 		* @tparam T Type argument for data engine
 		* @param de Data engine to compare with
 		* @return Returns true if equal, false otherwise
 		*/
 		template<typename T> requires ValidBase<E, T>
-		bool operator==(T de) const;
+		bool operator==(const T& de) const;
 
 		/**
 		* Checks if the invoking data engine and the data engine passed are truly equal in the provided range,
@@ -127,7 +159,7 @@ namespace core {
 		* @return Returns true if equal, false otherwise
 		*/
 		template<typename T> requires ValidBase<E, T>
-		[[nodiscard]] bool equals(T de, int start, int end) const;
+		[[nodiscard]] bool equals(const T& de, int start, int end) const;
 
 		/**
 		* Checks if the invoking data engine and the data engine passed are equivalent, i.e. have the same
@@ -138,7 +170,7 @@ namespace core {
 		* @return Returns true if equivalent, false otherwise
 		*/
 		template<typename T> requires ValidBase<E, T>
-		[[nodiscard]] bool equivalence(T de) const;
+		[[nodiscard]] bool equivalence(const T& de) const;
 
 		/**
 		* Merges the invoking data engine with the data engine passed. It creates a new instance containing
@@ -146,10 +178,10 @@ namespace core {
 		*
 		* @tparam T Type argument for the data engine
 		* @param de Data engine to merge with
-		* @return Returns the merged data engine
+		* @return Returns the merged data engine, of the type of the invoking one, nullptr if they cannot be merged
 		*/
 		template<typename T> requires ValidBase<E, T>
-		T merge(T de) const;
+		std::unique_ptr<DataEngine> merge(const T& de) const;
 
 		/**
 		* Merge the invoking data engine with the data engine passed, starting from the provided index
@@ -158,10 +190,10 @@ namespace core {
 		* @tparam T Type argument for the data engine
 		* @param de Data engine to merge with
 		* @param start Starting index
-		* @return Returns the merged data engine
+		* @return Returns the merged data engine, of the type of the invoking one, nullptr if they cannot be merged
 		*/
 		template<typename T> requires ValidBase<E, T>
-		T merge(T de, int start) const;
+		std::unique_ptr<DataEngine> merge(const T& de, int start) const;
 
 		/**
 		* Merge the invoking data engine with the data engine passed, starting from the provided start index
@@ -172,10 +204,10 @@ namespace core {
 		* @param de Data engine to merge with
 		* @param start Starting index
 		* @param end Endpoint index
-		* @return Returns the merged data engine
+		* @return Returns the merged data engine, of the type of the invoking one, nullptr if they cannot be merged
 		*/
 		template<typename T> requires ValidBase<E, T>
-		T merge(T de, int start, int end) const;
+		std::unique_ptr<DataEngine> merge(const T& de, int start, int end) const;
 
 		/**
 		* Reverses the invoking data engine
@@ -184,58 +216,33 @@ namespace core {
 
 
 	protected:
-		//Type-erasure forms of methods that need to be both virtual and template
+		//Dynamic forms of the comparisons and merge, reached when the static type of either side is not known
 
 		/**
-		* Internal type-erasure form of getThreadSafeImage, used to create a thread-safe image of the
-		* invoking data-engine. This form uses std::any to cast back and forth during polymorphism
-		*
-		* @return Returns the thread-safe image of the invoking data-engine
-		*/
-		[[nodiscard]] virtual std::atomic<std::any>* getThreadSafeImage() const = 0;
-
-		/**
-		* Internal type-erasure form of operator==, used to compare the invoking data-engine with another
-		* for true equality, i.e. equal length and ordering of elements
+		* Internal dynamic form of operator==, used to compare the invoking data-engine with another for true
+		* equality, i.e. equal length and ordering of elements
 		*
 		* @param de Data engine to compare with
 		* @return Returns true if equal, false otherwise
 		*/
-		virtual bool operator==(std::any de) const = 0;
+		[[nodiscard]] virtual bool equalsInternal(const DataEngine& de) const = 0;
 
 		/**
-		* Internal type-erasure form of equivalence method, used to compare the invoking data-engine with
-		* another for equivalence, i.e. same elements but not necessarily in the same order
+		* Internal dynamic form of equivalence method, used to compare the invoking data-engine with another
+		* for equivalence, i.e. same elements but not necessarily in the same order
 		* @param de Data engine to compare with
 		* @return Returns true if equivalent, false otherwise
 		*/
-		[[nodiscard]] virtual bool equivalence(std::any de) const = 0;
-
-		/**
-		* Internal type-erasure form for merging data engines
-		*
-		* @param de Data Engine to be merged with
-		* @return Returns the merged data engine
-		*/
-		virtual std::any merge(std::any de) = 0;
-
-		/**
-		* Internal type-erasure form for merging data engines
-		*
-		* @param de Data Engine to be merged with
-		* @param start Starting index
-		* @return Returns the merged data engine
-		*/
-		virtual std::any merge(std::any de, int start) = 0;
+		[[nodiscard]] virtual bool equivalenceInternal(const DataEngine& de) const = 0;
 
 		/**
-		* Internal type-erasure form for merging data engines
+		* Internal dynamic form for merging data engines
 		*
 		* @param de Data Engine to be merged with
 		* @param start Starting index
 		* @param end Endpoint index
-		* @return Returns the merged data engine
+		* @return Returns the merged data engine, of the type of the invoking one, nullptr if they cannot be merged
 		*/
-		virtual std::any merge(std::any de, int start, int end) = 0;
+		[[nodiscard]] virtual std::unique_ptr<DataEngine> mergeInternal(const DataEngine& de, int start, int end) const = 0;
 	};
 }
\ No newline at end of file
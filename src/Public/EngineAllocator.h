@@ -0,0 +1,197 @@
+#pragma once
+#include <concepts>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace core {
+
+	/**
+	* Allocators accepted by the engines: standard allocators whose pointers are plain pointers, which covers
+	* std::allocator, std::pmr::polymorphic_allocator over any memory resource and custom allocators. Every
+	* implementation takes its allocator as its last template parameter, std::allocator by default, and
+	* rebinds it to each kind of storage it obtains, buffers of elements as well as nodes and blocks. An
+	* engine scoped to a request can so draw all its memory from a std::pmr::monotonic_buffer_resource and
+	* have it released at once with the resource.
+	*
+	* Clones and merges are created with the allocator of the invoking engine. Move assignment takes over
+	* the allocator of the other engine when the allocator propagates on move assignment, as std::allocator
+	* does. Otherwise engines keeping their elements in vectors move them one by one when the allocators
+	* differ, while engines holding nodes or buffers directly throw std::invalid_argument unless both
+	* allocators compare equal, as polymorphic allocators over the same resource do
+	* @tparam Allocator The allocator type
+	*/
+	template<typename Allocator>
+	concept EngineAllocator = requires { typename std::allocator_traits<Allocator>::value_type; } &&
+		std::is_pointer_v<typename std::allocator_traits<Allocator>::pointer>;
+
+	//Alias of an engine allocator rebound to the given type
+	template<typename Allocator, typename Type>
+	using rebind_t = typename std::allocator_traits<Allocator>::template rebind_alloc<Type>;
+
+	//Vector drawing its storage from an engine allocator
+	template<typename Type, typename Allocator>
+	using EngineVector = std::vector<Type, rebind_t<Allocator, Type>>;
+
+	/**
+	* Obtains uninitialized storage for the given number of objects from an engine allocator. Allocators
+	* with const allocate_object and deallocate_object members, such as PoolAllocator, are called directly
+	* instead of through a rebound copy
+	* @tparam Type Type of the objects
+	* @param allocator Allocator of the engine
+	* @param count Number of objects
+	* @return Returns the storage, aligned for Type
+	*/
+	template<typename Type, typename Allocator>
+	Type* allocateStorage(const Allocator& allocator, size_t count) {
+		if constexpr (requires { allocator.template allocate_object<Type>(count); }) {
+			return allocator.template allocate_object<Type>(count);
+		}
+		else {
+			rebind_t<Allocator, Type> rebound(allocator);
+			return std::allocator_traits<rebind_t<Allocator, Type>>::allocate(rebound, count);
+		}
+	}
+
+	/**
+	* Gives storage obtained through allocateStorage back to the allocator
+	* @param allocator Allocator of the engine, equal to the one the storage was obtained from
+	* @param storage The storage
+	* @param count Number of objects the storage was obtained for
+	*/
+	template<typename Type, typename Allocator>
+	void deallocateStorage(const Allocator& allocator, Type* storage, size_t count) noexcept {
+		if constexpr (requires { allocator.deallocate_object(storage, count); }) {
+			allocator.deallocate_object(storage, count);
+		}
+		else {
+			rebind_t<Allocator, Type> rebound(allocator);
+			std::allocator_traits<rebind_t<Allocator, Type>>::deallocate(rebound, storage, count);
+		}
+	}
+
+	/**
+	* Gives all the storage drawn through the allocator back at once, when the allocator supports it
+	* through a release member and nothing else draws from the same storage, as for a PoolAllocator no
+	* other engine shares. No object obtained through the allocator may be used afterwards
+	* @param allocator Allocator of the engine
+	* @return Returns true if the storage was released, false if the engine must free its objects itself
+	*/
+	template<typename Allocator>
+	bool releaseStorage(Allocator& allocator) noexcept {
+		if constexpr (requires { { allocator.release() } -> std::same_as<bool>; }) {
+			return allocator.release();
+		}
+		else {
+			return false;
+		}
+	}
+
+	/**
+	* Counterpart of new drawing from an engine allocator
+	* @tparam Type Type of the object
+	* @param allocator Allocator of the engine
+	* @param args Arguments of the constructor of Type
+	* @return Returns the constructed object
+	*/
+	template<typename Type, typename Allocator, typename... Args>
+	Type* createObject(const Allocator& allocator, Args&&... args) {
+		Type* object = allocateStorage<Type>(allocator, 1);
+		try {
+			::new (static_cast<void*>(object)) Type(std::forward<Args>(args)...);
+		}
+		catch (...) {
+			deallocateStorage(allocator, object, 1);
+			throw;
+		}
+		return object;
+	}
+
+	/**
+	* Counterpart of delete for objects made by createObject
+	* @param allocator Allocator of the engine
+	* @param object The object, ignored when nullptr
+	*/
+	template<typename Type, typename Allocator>
+	void destroyObject(const Allocator& allocator, Type* object) noexcept {
+		if (object != nullptr) {
+			std::destroy_at(object);
+			deallocateStorage(allocator, object, 1);
+		}
+	}
+
+	/**
+	* Deleter of std::unique_ptr for objects made by createObject. It refers to the allocator of the engine,
+	* which must outlive the pointers using it
+	* @tparam Allocator The allocator type
+	*/
+	template<typename Allocator>
+	struct ObjectDeleter {
+		const Allocator* allocator = nullptr;
+
+		template<typename Type>
+		void operator()(Type* object) const noexcept {
+			destroyObject(*allocator, object);
+		}
+	};
+
+	//Alias of a std::unique_ptr owning an object made by createObject
+	template<typename Type, typename Allocator>
+	using ObjectPtr = std::unique_ptr<Type, ObjectDeleter<Allocator>>;
+
+	/**
+	* Owning form of createObject
+	* @tparam Type Type of the object
+	* @param allocator Allocator of the engine, it must outlive the returned pointer
+	* @param args Arguments of the constructor of Type
+	* @return Returns the constructed object
+	*/
+	template<typename Type, typename Allocator, typename... Args>
+	ObjectPtr<Type, Allocator> makeObject(const Allocator& allocator, Args&&... args) {
+		return ObjectPtr<Type, Allocator>(createObject<Type>(allocator, std::forward<Args>(args)...), ObjectDeleter<Allocator>{ &allocator });
+	}
+
+	/**
+	* True when an engine moved from always hands its storage over: the allocator propagates on move
+	* assignment or all its instances compare equal. Move assignment of the engines is noexcept only then
+	* @tparam Allocator The allocator type
+	*/
+	template<typename Allocator>
+	inline constexpr bool takesStorageOnMove = std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value ||
+		std::allocator_traits<Allocator>::is_always_equal::value;
+
+	/**
+	* Takes over the allocator of an engine being moved from, if the allocator propagates on move assignment.
+	* Engines keeping their elements in vectors need nothing more: the vectors move the elements one by one
+	* into storage of their own allocator when the two differ
+	* @param allocator Allocator of the engine being assigned to
+	* @param other Allocator of the engine being moved from
+	*/
+	template<typename Allocator>
+	void propagateOnMove(Allocator& allocator, const Allocator& other) noexcept {
+		if constexpr (std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value) {
+			allocator = other;
+		}
+	}
+
+	/**
+	* Checks that an engine holding its nodes or buffers directly can take over the storage of the engine
+	* it is moved from. Such engines have no element-wise fallback, so unlike std containers they reject
+	* allocators that neither propagate nor compare equal, before anything is released
+	* @param allocator Allocator of the engine being assigned to
+	* @param other Allocator of the engine being moved from
+	* @throws std::invalid_argument If the storage cannot be taken over
+	*/
+	template<typename Allocator>
+	void requireStorageOnMove(const Allocator& allocator, const Allocator& other) noexcept(takesStorageOnMove<Allocator>) {
+		if constexpr (!takesStorageOnMove<Allocator>) {
+			if (!(allocator == other)) {
+				throw std::invalid_argument("engines moved into each other need equal or propagating allocators");
+			}
+		}
+	}
+}
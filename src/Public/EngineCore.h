@@ -1,5 +1,25 @@
 #pragma once
+#include<compare>
+#include<concepts>
+#include<cstddef>
+#include<iterator>
+#include<ranges>
 #include<type_traits>
+#include<thread>
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#include<immintrin.h>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ENGINE_SSE2 1 //Baseline vector instructions available to every engine
+#endif
+#if defined(__AVX2__) && (defined(__FMA__) || defined(_MSC_VER))
+#define ENGINE_AVX2 1 //Wider vectors with fused multiply-add, only when the build targets them
+#endif
+#if defined(__AVX512F__)
+#define ENGINE_AVX512 1
+#endif
+#elif defined(_M_ARM64) || defined(_M_ARM)
+#include<intrin.h>
+#endif
 
 namespace core {
 
@@ -62,6 +82,51 @@ namespace core {
 		static constexpr bool value = true;
 	};
 
+	/**
+	* Custom "is trivially relocatable" trait. A type is trivially relocatable when moving it to a new
+	* address and abandoning the old one is equivalent to a memcpy. Defaults to trivially copyable types,
+	* specialize it for types that own resources but do not hold pointers into themselves
+	* @tparam Type The type to be checked
+	*/
+	template<typename Type>
+	struct is_trivially_relocatable {
+		static constexpr bool value = std::is_trivially_copyable_v<Type>;
+	};
+
+	/**
+	* Key-value pair used as the element type of map engines. Entries compare by key first, then by value
+	* @tparam K Type of the key
+	* @tparam V Type of the value
+	*/
+	template<typename K, typename V>
+	struct Entry {
+		K key;
+		V value;
+
+		bool operator==(const Entry&) const = default;
+		auto operator<=>(const Entry&) const = default;
+	};
+
+	/**
+	* Backoff step for spin loops on contended atomics. The first iterations only hint the core that it is
+	* spinning, later iterations give up the time slice so that a preempted peer can make progress
+	* @param spins Number of spins done so far, incremented by the call
+	*/
+	inline void spinPause(unsigned& spins) noexcept {
+		if (spins++ < 64) {
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+			_mm_pause();
+#elif defined(_M_ARM64) || defined(_M_ARM)
+			__yield();
+#elif defined(__aarch64__) || defined(__arm__)
+			__asm__ __volatile__("yield");
+#endif
+		}
+		else {
+			std::this_thread::yield();
+		}
+	}
+
 	/**
 	* General template for an interface
 	*/
@@ -100,37 +165,56 @@ namespace core {
 	E_INTERFACE
 
 	/**
-	* All concrete implementations of DataEngine are required to have an Iterator. The Iterator
-	* interface defines the basic layout of an Iterator
+	* Base of the iterators of all concrete implementations of DataEngine. Each implementation defines its
+	* own iterator type and returns it by value from begin and end, so that stepping and dereferencing are
+	* resolved at compile time and inlined into the loops over the engine. The base supplies the member
+	* types read by std::iterator_traits and the postfix operators, the derived iterator defines the
+	* prefix ones, operator*, operator-> and operator==, and must be default constructible
+	* @tparam Derived The derived iterator
+	* @tparam E Type of the items, const qualified when the items cannot be modified through the iterator
+	* @tparam Category Strongest standard iterator tag modeled by the derived iterator
 	*/
-	S_INTERFACE(Iterator)
-	using value_type = E;
-	using difference_type = std::ptrdiff_t;
-	using pointer = E*;
-	using reference = E&;
-
-	virtual reference operator*() const = 0; 
-	virtual pointer operator->() const = 0;
-
-	virtual Iterator& operator++() = 0;
-	virtual Iterator& operator++(int) = 0;
-
-	virtual bool operator==(const Iterator& other) const = 0; \
-	virtual bool operator!=(const Iterator& other) const = 0; \
-	E_INTERFACE
+	template<typename Derived, typename E, typename Category = std::forward_iterator_tag>
+	class Iterator {
+	public:
+		using value_type = std::remove_cv_t<E>;
+		using difference_type = std::ptrdiff_t;
+		using pointer = E*;
+		using reference = E&;
+		using iterator_category = Category;
+		using iterator_concept = Category;
+
+		friend Derived operator++(Derived& iterator, int) {
+			Derived previous = iterator;
+			++iterator;
+			return previous;
+		}
+
+		friend Derived operator--(Derived& iterator, int) requires std::derived_from<Category, std::bidirectional_iterator_tag> {
+			Derived previous = iterator;
+			--iterator;
+			return previous;
+		}
+	};
 
 	/**
-	* The Iterable interface defines the methods that create an Iterator in both directions. All
-	* DataEngine classes have access to it and are required to override it
-	*/
-	S_INTERFACE(Iterable)
-	/**
-	* @return Returns an Iterator at the beginning of the engine
+	* All concrete implementations of DataEngine are required to be Iterable: begin and end return an
+	* iterator of their own and its end, contiguous engines return plain pointers. Engines are usable with
+	* range-for loops and std::ranges algorithms through it
 	*/
-	virtual Iterator<E> begin() = 0;
+	template<typename Engine>
+	concept Iterable = requires(Engine& engine) {
+		{ engine.begin() } -> std::input_iterator;
+		{ engine.end() } -> std::sentinel_for<decltype(engine.begin())>;
+	};
+
 	/**
-	* @return Returns an Iterator at the end of the engine
+	* Implementations keeping their elements in one block of memory are also Contiguous: view returns a span
+	* over the live storage, holding the elements begin and end iterate over, without copying them. The span
+	* is borrowed, it is invalidated by any change to the engine
 	*/
-	virtual Iterator<E> end() = 0;
-	E_INTERFACE
+	template<typename Engine>
+	concept Contiguous = Iterable<Engine> && requires(Engine& engine) {
+		{ engine.view() } -> std::ranges::contiguous_range;
+	};
 }
@@ -0,0 +1,140 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "EngineAllocator.h"
+#include "EngineCore.h"
+
+namespace core {
+
+	/**
+	* Epoch based memory reclamation for concurrent engines. Readers pin the domain for the duration of a
+	* lock-free traversal, writers retire the memory they unlink instead of freeing it. Retired memory is
+	* freed once the global epoch has advanced twice past its retirement, by then no pinned reader can still
+	* reference it. The epoch only advances when every pinned reader has observed the current one.
+	*
+	* Threads are spread over SLOTS reader slots, each slot also keeps the retire list of its threads.
+	* Threads beyond SLOTS share slots, a shared slot stays at the oldest epoch of its readers, which only
+	* delays reclamation. Pinning is reentrant
+	*/
+	class EpochDomain {
+	public:
+		static constexpr size_t SLOTS = 128;
+
+		/**
+		* Scoped pin of a domain. References to memory retired in the domain must not outlive it
+		*/
+		class Guard {
+			EpochDomain* domain;
+			size_t slot;
+		public:
+			Guard(EpochDomain* domain, size_t slot) noexcept : domain(domain), slot(slot) {}
+			~Guard() { domain->unpin(slot); }
+
+			Guard(const Guard&) = delete;
+			Guard& operator=(const Guard&) = delete;
+		};
+
+		EpochDomain() = default;
+
+		/**
+		* Frees all the retired memory, no thread may be pinned
+		*/
+		~EpochDomain();
+
+		EpochDomain(const EpochDomain&) = delete;
+		EpochDomain& operator=(const EpochDomain&) = delete;
+
+		/**
+		* Pins the calling thread until the returned guard is destroyed
+		* @return Returns the guard of the pin
+		*/
+		[[nodiscard]] Guard pin() noexcept;
+
+		/**
+		* Hands memory that is no longer reachable to the domain, it is freed once no reader can hold it
+		* @param pointer The unlinked memory
+		* @param deleter Function freeing the memory, called with the pointer and the context
+		* @param context State the deleter needs, such as the allocator of the memory, it must outlive the domain
+		*/
+		void retire(void* pointer, void (*deleter)(void*, void*), void* context = nullptr);
+
+		/**
+		* Typed form of retire, the object is freed through delete
+		* @param pointer The unlinked object
+		*/
+		template<typename Type>
+		void retire(Type* pointer) {
+			retire(static_cast<void*>(pointer), [](void* object, void*) { delete static_cast<Type*>(object); }, nullptr);
+		}
+
+		/**
+		* Typed form of retire for objects made by createObject, the object is destroyed and given back to
+		* the allocator. Engines declare their allocator before their domain, so it outlives the domain
+		* @param pointer The unlinked object
+		* @param allocator Allocator the object was obtained from
+		*/
+		template<typename Type, typename Allocator>
+		void retire(Type* pointer, const Allocator& allocator) {
+			retire(static_cast<void*>(pointer), [](void* object, void* context) {
+				destroyObject(*static_cast<const Allocator*>(context), static_cast<Type*>(object));
+			}, const_cast<Allocator*>(&allocator));
+		}
+
+		/**
+		* Advances the epoch if the pinned readers allow it and frees the retired memory of every slot that
+		* no reader can reference anymore. Retire only does so every RECLAIM_PERIOD retirements of a slot,
+		* writers that retire rarely call it to have their memory freed sooner
+		*/
+		void collect();
+
+		/**
+		* Frees all the retired memory immediately, no thread may be pinned
+		*/
+		void drain();
+
+	private:
+		static constexpr size_t CACHE_LINE_SIZE = 64;
+		static constexpr unsigned COUNT_BITS = 24;
+		static constexpr uint64_t COUNT_MASK = (uint64_t{ 1 } << COUNT_BITS) - 1;
+		static constexpr size_t RECLAIM_PERIOD = 64; //Retirements in a slot between reclamation attempts
+
+		struct Retired {
+			void* pointer;
+			void (*deleter)(void*, void*);
+			void* context;
+			uint64_t epoch;
+		};
+
+		/**
+		* Reader state of a group of threads, the epoch seen by its readers in the high bits and the
+		* number of pinned readers in the low COUNT_BITS
+		*/
+		struct alignas(CACHE_LINE_SIZE) Slot {
+			std::atomic<uint64_t> state{ 0 };
+			std::atomic<bool> locked{ false }; //Guards retired, only contended when threads share the slot
+			std::vector<Retired> retired;
+		};
+
+		alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> epoch{ 0 };
+		Slot slots[SLOTS];
+
+		/**
+		* @return Returns the slot of the calling thread
+		*/
+		static size_t threadSlot() noexcept;
+
+		void unpin(size_t slot) noexcept;
+
+		/**
+		* Advances the global epoch if every pinned reader has observed it
+		*/
+		void tryAdvance() noexcept;
+
+		/**
+		* Frees the retired memory of the slot that no reader can reference anymore, its lock must be held
+		*/
+		void reclaim(Slot& slot);
+	};
+}
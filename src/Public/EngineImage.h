@@ -0,0 +1,106 @@
+#pragma once
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include "EngineEpoch.h"
+
+namespace core {
+
+	/**
+	* Read-copy-update image of an engine, as created by DataEngine::getThreadSafeImage. The image holds
+	* an immutable version of the engine. Readers take a Snapshot, which pins the version current at that
+	* time and reads it through the const interface of the engine without any lock, whatever is published
+	* meanwhile. Writers are serialized, each prepares a new version aside, usually through update on a
+	* copy of the current one, and makes it current with a single pointer store.
+	*
+	* Replaced versions are retired to the epoch domain of the image and freed once no snapshot can still
+	* reference them, so a snapshot held for long keeps every version replaced meanwhile alive. Reads cost
+	* a pin and writes a copy of the engine, which suits engines read far more often than written, such as
+	* configuration or routing tables
+	* @tparam T Type of the engine
+	*/
+	template<typename T>
+	class ThreadSafeImage {
+	public:
+		/**
+		* Consistent, lock-free view of the version current when the snapshot was taken. The image must
+		* outlive it
+		*/
+		class Snapshot {
+			EpochDomain::Guard guard;
+			const T* version;
+		public:
+			explicit Snapshot(const ThreadSafeImage& image) noexcept
+				: guard(image.domain.pin()), version(image.current.load(std::memory_order_acquire)) {}
+
+			const T& operator*() const noexcept { return *version; }
+			const T* operator->() const noexcept { return version; }
+
+			/**
+			* @return Returns the version, valid as long as the snapshot
+			*/
+			[[nodiscard]] const T* get() const noexcept { return version; }
+		};
+
+		/**
+		* Creates an image whose first version is the given engine
+		* @param initial The engine, which must not be nullptr
+		*/
+		explicit ThreadSafeImage(std::unique_ptr<T> initial) noexcept : current(initial.release()) {}
+
+		/**
+		* Frees the current version and the retired ones, no snapshot may be alive
+		*/
+		~ThreadSafeImage() {
+			delete current.load(std::memory_order_relaxed);
+		}
+
+		ThreadSafeImage(const ThreadSafeImage&) = delete;
+		ThreadSafeImage& operator=(const ThreadSafeImage&) = delete;
+
+		/**
+		* Takes a snapshot of the current version
+		* @return Returns the snapshot
+		*/
+		[[nodiscard]] Snapshot snapshot() const noexcept { return Snapshot(*this); }
+
+		/**
+		* Makes the given engine the current version, readers see it from their next snapshot on
+		* @param next The engine, which must not be nullptr
+		*/
+		void publish(std::unique_ptr<T> next) {
+			std::lock_guard<std::mutex> guard(writer);
+			replace(std::move(next));
+		}
+
+		/**
+		* Applies a change to a copy of the current version and publishes the copy. Nothing is published if
+		* the change throws
+		* @param change Function modifying the engine it is given
+		*/
+		template<typename Change>
+		void update(Change&& change) {
+			std::lock_guard<std::mutex> guard(writer);
+			//clone keeps the dynamic type, which is a T
+			std::unique_ptr<T> next(static_cast<T*>(current.load(std::memory_order_relaxed)->clone().release()));
+			change(*next);
+			replace(std::move(next));
+		}
+
+	private:
+		std::atomic<const T*> current;
+		std::mutex writer;
+		mutable EpochDomain domain;
+
+		/**
+		* Makes the engine current and retires the previous version, under the writer lock
+		*/
+		void replace(std::unique_ptr<T> next) {
+			const T* previous = current.exchange(next.release(), std::memory_order_acq_rel);
+			domain.retire(const_cast<T*>(previous));
+			//Writes are rare, so replaced versions are reclaimed at once rather than after many retirements
+			domain.collect();
+		}
+	};
+}
@@ -1,5 +1,6 @@
 #pragma once
 #include "DataEngine.h"
+#include "EngineAllocator.h"
 
 namespace core {
 	/**
@@ -50,6 +51,56 @@ namespace core {
 		static constexpr Behavior engineBehavior = behavior;\
 		static constexpr Ordering engineOrder = ordering; \
 
+#endif
+
+	/**
+	* Compile-time forms of operator==, equivalence and merge, injected into every implementation. When the
+	* argument has the static type of the implementation itself, they call its non-virtual forms directly
+	* if it declares them: equalTo(const Self&), equivalentTo(const Self&) and
+	* mergeWith(const Self&, int start, int end), which compare or copy the two representations without
+	* a virtual call or a cast. Any other argument goes through the dynamic forms of DataEngine. Merging
+	* always produces the type of the invoking engine, so merge returns it without a cast by the caller
+	*/
+#ifndef ENGINE_STATIC_DISPATCH
+#define ENGINE_STATIC_DISPATCH(...) \
+		using Self = __VA_ARGS__; \
+		template<typename T> requires ValidBase<E, T> \
+		bool operator==(const T& de) const { \
+			if constexpr (std::is_same_v<T, Self> && requires(const Self& self) { self.equalTo(self); }) { \
+				return equalTo(de); \
+			} \
+			else { \
+				return this->equalsInternal(de); \
+			} \
+		} \
+		template<typename T> requires ValidBase<E, T> \
+		[[nodiscard]] bool equivalence(const T& de) const { \
+			if constexpr (std::is_same_v<T, Self> && requires(const Self& self) { self.equivalentTo(self); }) { \
+				return equivalentTo(de); \
+			} \
+			else { \
+				return this->equivalenceInternal(de); \
+			} \
+		} \
+		template<typename T> requires ValidBase<E, T> \
+		std::unique_ptr<Self> merge(const T& de, int start, int end) const { \
+			if constexpr (std::is_same_v<T, Self> && requires(const Self& self) { self.mergeWith(self, 0, 0); }) { \
+				return mergeWith(de, start, end); \
+			} \
+			else { \
+				std::unique_ptr<DataEngine<E>> merged = this->mergeInternal(de, start, end); \
+				return std::unique_ptr<Self>(static_cast<Self*>(merged.release())); \
+			} \
+		} \
+		template<typename T> requires ValidBase<E, T> \
+		std::unique_ptr<Self> merge(const T& de, int start) const { \
+			return merge(de, start, static_cast<int>(de.mergeExtent())); \
+		} \
+		template<typename T> requires ValidBase<E, T> \
+		std::unique_ptr<Self> merge(const T& de) const { \
+			return merge(de, 0, static_cast<int>(de.mergeExtent())); \
+		}
+
 #endif
 
 #ifndef S_ABSTRACT_ENGINE_CLASS
@@ -62,17 +113,66 @@ namespace core {
 			public: \
 			ENGINE_CONSTANTS(Implementation::ABSTRACTION_E, nature, behavior, ordering)
 
+#endif
+
+	/**
+	* Allocator member shared by the implementation macros. It is declared ahead of the members of the
+	* implementation, so that it is constructed before and destroyed after all the storage it provides
+	*/
+#ifndef ENGINE_ALLOCATOR
+#define ENGINE_ALLOCATOR \
+		static_assert(EngineAllocator<Allocator>, "Invalid allocator for implementation class"); \
+		protected: \
+			[[no_unique_address]] Allocator allocator; \
+		public: \
+			using allocator_type = Allocator; \
+			allocator_type get_allocator() const noexcept { return allocator; }
+
 #endif
 
 #ifndef S_IMPLEMENTAION_CLASS
 #define S_IMPLEMENTATION_CLASS(name, Abstraction, nature, behavior, ordering) \
-		template<typename E>\
+		template<typename E, typename Allocator = std::allocator<E>>\
 		class name : public Abstraction,\
-		conditional_t<(nature == Nature::THREAD_MUTABLE), Sortable<E>, Dummy> { \
+		conditional_t<(nature == Nature::THREAD_MUTABLE), Sortable<E>, ImplementationDummy> { \
 			static_assert(Valid(Implementation::IMPLEMENTATION_E, nature, behavior, ordering), \
 					"Invalid configuration for implementation class");\
-		public: \
-			ENGINE_CONSTANTS(Implementation::IMPLEMENTATION_E, nature, behavior, ordering)
+			ENGINE_ALLOCATOR \
+			ENGINE_CONSTANTS(Implementation::IMPLEMENTATION_E, nature, behavior, ordering) \
+			ENGINE_STATIC_DISPATCH(name<E, Allocator>)
+
+#endif
+
+	/**
+	* Key-value engines cannot go through the macros above, they need two type parameters and a comma
+	* cannot be passed inside a macro argument. The map forms below store Entry<K, V> as the element
+	* type of DataEngine, expose it as E, and take the abstraction as a bare template name. Their
+	* allocator defaults to std::allocator of the entries
+	*/
+#ifndef S_ABSTRACT_MAP_ENGINE_CLASS
+#define S_ABSTRACT_MAP_ENGINE_CLASS(name, nature, behavior, ordering) \
+		template<typename K, typename V>\
+		class name : public DataEngine<Entry<K, V>>,\
+				conditional_t<nature == Nature::THREAD_MUTABLE, Sortable<Entry<K, V>>, Dummy> { \
+			static_assert(Valid(Implementation::ABSTRACTION_E, nature, behavior, ordering), \
+				"Invalid configuration for abstraction class");\
+			public: \
+			using E = Entry<K, V>; \
+			ENGINE_CONSTANTS(Implementation::ABSTRACTION_E, nature, behavior, ordering)
+
+#endif
+
+#ifndef S_MAP_IMPLEMENTATION_CLASS
+#define S_MAP_IMPLEMENTATION_CLASS(name, Abstraction, nature, behavior, ordering) \
+		template<typename K, typename V, typename Allocator = std::allocator<Entry<K, V>>>\
+		class name : public Abstraction<K, V>,\
+		conditional_t<(nature == Nature::THREAD_MUTABLE), Sortable<Entry<K, V>>, ImplementationDummy> { \
+			static_assert(Valid(Implementation::IMPLEMENTATION_E, nature, behavior, ordering), \
+					"Invalid configuration for implementation class");\
+			ENGINE_ALLOCATOR \
+			using E = Entry<K, V>; \
+			ENGINE_CONSTANTS(Implementation::IMPLEMENTATION_E, nature, behavior, ordering) \
+			ENGINE_STATIC_DISPATCH(name<K, V, Allocator>)
 
 #endif
 
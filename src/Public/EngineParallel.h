@@ -0,0 +1,62 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace core {
+
+	/**
+	* @param threads Threads requested, 0 for one per hardware thread
+	* @param work Amount of work
+	* @param threadWork Work below which a thread does not pay off
+	* @return Returns the number of threads worth using for the given work
+	*/
+	inline size_t parallelWorkers(unsigned threads, size_t work, size_t threadWork) noexcept {
+		const size_t count = threads == 0 ? std::max(std::thread::hardware_concurrency(), 1u) : threads;
+		return std::max<size_t>(std::min(count, work / threadWork), 1);
+	}
+
+	/**
+	* Runs the task for each worker index, the last one on the calling thread. Each call starts its own
+	* threads, the parallel engine operations are coarse enough for it not to matter. The first exception
+	* thrown by a worker is rethrown once all of them are done
+	* @param count Number of workers, at least 1
+	* @param task Function called with the index of the worker
+	*/
+	template<typename Task>
+	void parallel(size_t count, Task&& task) {
+		std::vector<std::exception_ptr> errors(count);
+		auto run = [&](size_t worker) {
+			try {
+				task(worker);
+			}
+			catch (...) {
+				errors[worker] = std::current_exception();
+			}
+		};
+		std::vector<std::thread> pool;
+		pool.reserve(count - 1);
+		try {
+			for (size_t worker = 0; worker + 1 < count; worker++) {
+				pool.emplace_back(run, worker);
+			}
+		}
+		catch (...) {
+			for (auto& thread : pool) {
+				thread.join();
+			}
+			throw;
+		}
+		run(count - 1);
+		for (auto& thread : pool) {
+			thread.join();
+		}
+		for (auto& error : errors) {
+			if (error) {
+				std::rethrow_exception(error);
+			}
+		}
+	}
+}
@@ -0,0 +1,252 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <new>
+#include <type_traits>
+
+namespace core {
+
+	/**
+	* Slab allocator for the one-node-at-a-time storage of the node based engines. Requests up to
+	* MAX_BLOCK bytes, aligned to at most MAX_ALIGNMENT, are rounded up to one of CLASSES size classes and
+	* carved out of slabs holding blocks of a single class. Larger requests go to the upstream resource.
+	*
+	* Each thread frees to and allocates from the cache of its slot. A cache exchanges blocks with the
+	* shared pool only in batches of BATCH blocks, so the pool lock is taken once every BATCH calls at most.
+	* Threads beyond SLOTS share caches, which only adds contention on the cache lock.
+	*
+	* Every block of the pool can be given back at once through release(), in time proportional to the
+	* number of slabs. NodePool is a std::pmr::memory_resource, so it also serves polymorphic allocators
+	*/
+	class NodePool : public std::pmr::memory_resource {
+	public:
+		static constexpr size_t SLOTS = 64;
+		static constexpr size_t CLASSES = 32;
+		static constexpr size_t MAX_BLOCK = 4096;
+		static constexpr size_t MAX_ALIGNMENT = 64;
+		static constexpr size_t BATCH = 32;
+		static constexpr size_t MAX_SLAB = 64 * 1024; //Slabs double from BATCH blocks up to this size
+
+		/**
+		* Creates an empty pool
+		* @param upstream Resource the slabs and the large blocks are obtained from
+		*/
+		explicit NodePool(std::pmr::memory_resource* upstream = std::pmr::get_default_resource()) noexcept;
+
+		/**
+		* Gives every slab and large block back to the upstream resource
+		*/
+		~NodePool() override;
+
+		NodePool(const NodePool&) = delete;
+		NodePool& operator=(const NodePool&) = delete;
+
+		/**
+		* Gives every slab and large block back to the upstream resource at once, without visiting the
+		* blocks. No block of the pool may be in use afterwards and no thread may use the pool meanwhile
+		*/
+		void release() noexcept;
+
+		/**
+		* @return Returns the resource the slabs are obtained from
+		*/
+		[[nodiscard]] std::pmr::memory_resource* getUpstream() const noexcept { return upstream; }
+
+	protected:
+		void* do_allocate(size_t bytes, size_t alignment) override;
+		void do_deallocate(void* block, size_t bytes, size_t alignment) override;
+		[[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+	private:
+		static constexpr size_t CACHE_LINE_SIZE = 64;
+		static constexpr size_t GRANULE = 16;
+		static constexpr size_t SMALL_CLASSES = 16; //Classes of GRANULE steps, four classes per power of two follow
+		static constexpr size_t SMALL_ORDER = 8; //Base two logarithm of the largest small class
+
+		/**
+		* A free block, the first block of a batch links the next batch of the shared pool
+		*/
+		struct FreeBlock {
+			FreeBlock* next;
+			FreeBlock* batch;
+		};
+
+		/**
+		* Free blocks of the threads of a slot, for each size class
+		*/
+		struct alignas(CACHE_LINE_SIZE) Cache {
+			std::atomic<bool> locked{ false };
+			FreeBlock* heads[CLASSES]{};
+			uint32_t counts[CLASSES]{};
+		};
+
+		/**
+		* Header of a slab, its blocks start MAX_ALIGNMENT bytes after it
+		*/
+		struct Slab {
+			Slab* next;
+			size_t bytes;
+		};
+
+		/**
+		* Header of a block obtained from upstream, stored right before the block
+		*/
+		struct Large {
+			Large* previous;
+			Large* next;
+			size_t bytes; //Requested from upstream, header included
+			size_t offset; //From the start of the upstream block to the block
+			size_t alignment; //Requested from upstream
+		};
+
+		/**
+		* Shared state of a size class, guarded by the pool lock
+		*/
+		struct SizeClass {
+			FreeBlock* batches = nullptr;
+			char* cursor = nullptr; //Uncarved part of the newest slab
+			char* limit = nullptr;
+			size_t slabBlocks = 0; //Blocks of the newest slab
+		};
+
+		std::pmr::memory_resource* upstream;
+		std::atomic<Cache*> caches[SLOTS];
+		std::mutex lock;
+		SizeClass classes[CLASSES];
+		Slab* slabs = nullptr;
+		Large* large = nullptr;
+
+		/**
+		* @return Returns the slot of the calling thread
+		*/
+		static size_t threadSlot() noexcept;
+
+		/**
+		* @return Returns the smallest class whose blocks hold the given bytes at the given alignment,
+		* CLASSES if the request goes upstream
+		*/
+		static size_t classOf(size_t bytes, size_t alignment) noexcept;
+
+		/**
+		* @return Returns the block size of the class
+		*/
+		static size_t classSize(size_t index) noexcept;
+
+		static void lockCache(Cache& cache) noexcept;
+		static void unlockCache(Cache& cache) noexcept;
+
+		/**
+		* @return Returns the cache of the calling thread's slot, created on first use
+		*/
+		Cache& threadCache();
+
+		/**
+		* Takes BATCH blocks of the class from the shared pool, carving a new slab if it has none left
+		* @return Returns the blocks, chained through next
+		*/
+		FreeBlock* refill(size_t index);
+
+		/**
+		* Hands BATCH blocks of the class from the cache back to the shared pool, the cache lock must be held
+		*/
+		void flush(Cache& cache, size_t index) noexcept;
+
+		void* allocateLarge(size_t bytes, size_t alignment);
+		void deallocateLarge(void* block) noexcept;
+	};
+
+	/**
+	* Engine allocator drawing from a NodePool. A default constructed allocator creates a pool of its own,
+	* so an engine built with the default allocator keeps its nodes in slabs no other engine uses. Copies,
+	* rebound ones included, share the pool, which lives as long as any of them.
+	*
+	* The allocator propagates on copy assignment, move assignment and swap, and is given to allocateStorage
+	* as it is rather than through a rebound copy, so obtaining a node never touches the shared count
+	* @tparam T The value type
+	*/
+	template<typename T>
+	class PoolAllocator {
+		template<typename U>
+		friend class PoolAllocator;
+
+		std::shared_ptr<NodePool> pool;
+	public:
+		using value_type = T;
+		using propagate_on_container_copy_assignment = std::true_type;
+		using propagate_on_container_move_assignment = std::true_type;
+		using propagate_on_container_swap = std::true_type;
+
+		/**
+		* Creates an allocator over a pool of its own, drawing from the default resource
+		*/
+		PoolAllocator() : pool(std::make_shared<NodePool>()) {}
+
+		/**
+		* Creates an allocator over the given pool
+		* @param pool The pool
+		*/
+		explicit PoolAllocator(std::shared_ptr<NodePool> pool) noexcept : pool(std::move(pool)) {}
+
+		template<typename U>
+		PoolAllocator(const PoolAllocator<U>& other) noexcept : pool(other.pool) {}
+
+		T* allocate(size_t count) {
+			return allocate_object<T>(count);
+		}
+
+		void deallocate(T* storage, size_t count) noexcept {
+			deallocate_object(storage, count);
+		}
+
+		/**
+		* Obtains storage for objects of any type, mirrors std::pmr::polymorphic_allocator::allocate_object
+		* @tparam U Type of the objects
+		* @param count Number of objects
+		* @return Returns the uninitialized storage
+		*/
+		template<typename U>
+		U* allocate_object(size_t count = 1) const {
+			if (count > std::numeric_limits<size_t>::max() / sizeof(U)) {
+				throw std::bad_array_new_length();
+			}
+			return static_cast<U*>(pool->allocate(count * sizeof(U), alignof(U)));
+		}
+
+		/**
+		* Gives storage obtained through allocate_object back to the pool
+		* @param storage The storage
+		* @param count Number of objects the storage was obtained for
+		*/
+		template<typename U>
+		void deallocate_object(U* storage, size_t count = 1) const noexcept {
+			pool->deallocate(storage, count * sizeof(U), alignof(U));
+		}
+
+		/**
+		* Gives every block of the pool back at once, if this allocator is the last one sharing it
+		* @return Returns true if the pool was released
+		*/
+		bool release() noexcept {
+			if (pool.use_count() != 1) {
+				return false;
+			}
+			pool->release();
+			return true;
+		}
+
+		/**
+		* @return Returns the pool of the allocator
+		*/
+		[[nodiscard]] NodePool* resource() const noexcept { return pool.get(); }
+
+		template<typename U>
+		bool operator==(const PoolAllocator<U>& other) const noexcept {
+			return pool == other.pool;
+		}
+	};
+}
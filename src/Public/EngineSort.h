@@ -0,0 +1,286 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <vector>
+#include "EngineParallel.h"
+
+namespace core {
+
+	/**
+	* Keys sorted by ParallelSort through their bit patterns: integers and IEC 559 single and double
+	* precision floating point numbers
+	* @tparam E The key type
+	*/
+	template<typename E>
+	concept RadixKey = (std::is_integral_v<E> && !std::is_same_v<E, bool>) ||
+		(std::is_floating_point_v<E> && std::numeric_limits<E>::is_iec559 && (sizeof(E) == 4 || sizeof(E) == 8));
+
+	/**
+	* Sort of contiguous items shared by the engines. Radix keys compared with std::less are sorted by an
+	* LSD radix sort, one byte per pass, whose histograms and scatters are split across threads. Passes in
+	* which every key has the same byte are skipped. Any other items are sorted as runs in parallel and
+	* the runs merged pairwise, each merge split across threads along its merge path.
+	*
+	* Both sorts are stable. Floating point keys compared with std::less are ordered by their bit patterns
+	* at any count, so -0.0 precedes 0.0 and NaNs go to the ends by sign. Each call starts its own threads
+	* through core::parallel, and an exception thrown by the comparison reaches the caller once they are done,
+	* leaving the items in an unspecified order
+	*/
+	class ParallelSort {
+	public:
+		static constexpr size_t THREAD_WORK = size_t(1) << 16; //Items per thread below which a thread does not pay off
+		static constexpr size_t RADIX_THRESHOLD = size_t(1) << 11; //Items below which a comparison sort is faster
+		static constexpr size_t RADIX_BITS = 8;
+		static constexpr size_t RADIX = size_t(1) << RADIX_BITS;
+
+		ParallelSort() = delete;
+
+		/**
+		* Sorts the items in ascending order of the comparison
+		* @param items The items
+		* @param count Number of items
+		* @param threads Threads to use, 0 for one per hardware thread, fewer are used for small inputs
+		* @param compare Strict weak ordering of the items
+		*/
+		template<typename E, typename Compare = std::less<>>
+		static void sort(E* items, size_t count, unsigned threads = 0, Compare compare = Compare()) {
+			if (count < 2) {
+				return;
+			}
+			const size_t workerCount = parallelWorkers(threads, count, THREAD_WORK);
+			if constexpr (RadixKey<E> && (std::is_same_v<Compare, std::less<>> || std::is_same_v<Compare, std::less<E>> ||
+				std::is_same_v<Compare, std::ranges::less>)) {
+				if (count >= RADIX_THRESHOLD) {
+					radixSort(items, count, workerCount);
+					return;
+				}
+				//Small inputs compare the bit patterns too, so that zeros and NaNs are ordered whatever the count
+				if constexpr (std::is_floating_point_v<E>) {
+					auto bitwise = [](E first, E second) { return radixKey(first) < radixKey(second); };
+					mergeSort(items, count, workerCount, bitwise);
+					return;
+				}
+			}
+			mergeSort(items, count, workerCount, compare);
+		}
+
+	private:
+		/**
+		* Maps a key to an unsigned integer of the same width whose order is the order of the keys
+		*/
+		template<RadixKey E>
+		static auto radixKey(E key) noexcept {
+			if constexpr (std::is_floating_point_v<E>) {
+				using Bits = std::conditional_t<sizeof(E) == 4, uint32_t, uint64_t>;
+				constexpr Bits SIGN = Bits(1) << (sizeof(E) * 8 - 1);
+				const auto bits = std::bit_cast<Bits>(key);
+				//Negative numbers grow as their magnitude shrinks, so all their bits are flipped
+				return (bits & SIGN) != 0 ? Bits(~bits) : Bits(bits | SIGN);
+			}
+			else {
+				using Bits = std::make_unsigned_t<E>;
+				if constexpr (std::is_signed_v<E>) {
+					return Bits(static_cast<Bits>(key) ^ (Bits(1) << (sizeof(E) * 8 - 1)));
+				}
+				else {
+					return static_cast<Bits>(key);
+				}
+			}
+		}
+
+		template<RadixKey E>
+		static void radixSort(E* items, size_t count, size_t workerCount) {
+			constexpr size_t PASSES = sizeof(E);
+			using Histogram = std::array<size_t, RADIX>;
+			const size_t block = (count + workerCount - 1) / workerCount;
+			auto bounds = [count, block](size_t worker) {
+				return std::pair(std::min(worker * block, count), std::min((worker + 1) * block, count));
+			};
+			//One read counts the bytes of every pass, the totals hold for any order of the items
+			std::vector<Histogram> initial(workerCount * PASSES);
+			parallel(workerCount, [&](size_t worker) {
+				auto [begin, end] = bounds(worker);
+				Histogram* counts = initial.data() + worker * PASSES;
+				for (size_t i = begin; i < end; i++) {
+					const auto key = radixKey(items[i]);
+					for (size_t pass = 0; pass < PASSES; pass++) {
+						counts[pass][(key >> (pass * RADIX_BITS)) & (RADIX - 1)]++;
+					}
+				}
+			});
+			auto scratch = std::make_unique_for_overwrite<E[]>(count);
+			E* source = items;
+			E* target = scratch.get();
+			std::vector<Histogram> offsets(workerCount);
+			bool permuted = false;
+			for (size_t pass = 0; pass < PASSES; pass++) {
+				const unsigned shift = static_cast<unsigned>(pass * RADIX_BITS);
+				bool trivial = false;
+				for (size_t digit = 0; digit < RADIX && !trivial; digit++) {
+					size_t total = 0;
+					for (size_t worker = 0; worker < workerCount; worker++) {
+						total += initial[worker * PASSES + pass][digit];
+					}
+					trivial = total == count;
+				}
+				if (trivial) {
+					continue;
+				}
+				//The initial counts of a block only match it until the first scatter moves the items
+				if (permuted) {
+					parallel(workerCount, [&](size_t worker) {
+						auto [begin, end] = bounds(worker);
+						Histogram& counts = offsets[worker];
+						counts.fill(0);
+						for (size_t i = begin; i < end; i++) {
+							counts[(radixKey(source[i]) >> shift) & (RADIX - 1)]++;
+						}
+					});
+				}
+				else {
+					for (size_t worker = 0; worker < workerCount; worker++) {
+						offsets[worker] = initial[worker * PASSES + pass];
+					}
+				}
+				//Each block scatters after the same digit of the blocks before it, which keeps the sort stable
+				size_t position = 0;
+				for (size_t digit = 0; digit < RADIX; digit++) {
+					for (size_t worker = 0; worker < workerCount; worker++) {
+						const size_t counted = offsets[worker][digit];
+						offsets[worker][digit] = position;
+						position += counted;
+					}
+				}
+				parallel(workerCount, [&](size_t worker) {
+					auto [begin, end] = bounds(worker);
+					Histogram& next = offsets[worker];
+					for (size_t i = begin; i < end; i++) {
+						target[next[(radixKey(source[i]) >> shift) & (RADIX - 1)]++] = source[i];
+					}
+				});
+				std::swap(source, target);
+				permuted = true;
+			}
+			if (source != items) {
+				parallel(workerCount, [&](size_t worker) {
+					auto [begin, end] = bounds(worker);
+					std::copy(source + begin, source + end, items + begin);
+				});
+			}
+		}
+
+		/**
+		* Finds where the merge of two sorted ranges crosses the given output position
+		* @return Returns the number of items of the first range among the first position outputs
+		*/
+		template<typename E, typename Compare>
+		static size_t mergePath(const E* first, size_t firstCount, const E* second, size_t secondCount, size_t position,
+			Compare& compare) {
+			size_t low = position > secondCount ? position - secondCount : 0;
+			size_t high = std::min(position, firstCount);
+			while (low < high) {
+				const size_t pivot = low + (high - low) / 2;
+				//Ties go to the first range, so that the merge is stable
+				if (compare(second[position - pivot - 1], first[pivot])) {
+					high = pivot;
+				}
+				else {
+					low = pivot + 1;
+				}
+			}
+			return low;
+		}
+
+		template<typename E, typename Compare>
+		static void mergeSort(E* items, size_t count, size_t workerCount, Compare& compare) {
+			if (workerCount == 1) {
+				std::stable_sort(items, items + count, compare);
+				return;
+			}
+			std::vector<size_t> runs(workerCount + 1);
+			for (size_t run = 0; run <= workerCount; run++) {
+				runs[run] = run * count / workerCount;
+			}
+			parallel(workerCount, [&](size_t run) {
+				std::stable_sort(items + runs[run], items + runs[run + 1], compare);
+			});
+			if constexpr (std::is_default_constructible_v<E> && std::is_move_assignable_v<E>) {
+				auto scratch = std::make_unique_for_overwrite<E[]>(count);
+				E* source = items;
+				E* target = scratch.get();
+				while (runs.size() > 2) {
+					const size_t pairs = (runs.size() - 1) / 2;
+					const bool odd = (runs.size() - 1) % 2 != 0;
+					//Few long pairs are left in the last rounds, so each merge is split along its merge path
+					const size_t shares = std::max<size_t>(workerCount / pairs, 1);
+					//The splits are found before any item is moved, the searches would otherwise read moved-from items
+					std::vector<size_t> splits(pairs * (shares + 1));
+					for (size_t pair = 0; pair < pairs; pair++) {
+						const size_t begin = runs[2 * pair];
+						const size_t middle = runs[2 * pair + 1];
+						const size_t end = runs[2 * pair + 2];
+						for (size_t share = 0; share <= shares; share++) {
+							splits[pair * (shares + 1) + share] = mergePath(source + begin, middle - begin, source + middle, end - middle,
+								share * (end - begin) / shares, compare);
+						}
+					}
+					parallel(pairs * shares + (odd ? 1 : 0), [&](size_t task) {
+						const size_t pair = task / shares;
+						if (pair == pairs) {
+							std::move(source + runs[2 * pair], source + count, target + runs[2 * pair]);
+							return;
+						}
+						const size_t begin = runs[2 * pair];
+						const size_t middle = runs[2 * pair + 1];
+						const size_t end = runs[2 * pair + 2];
+						const size_t share = task % shares;
+						const size_t from = share * (end - begin) / shares;
+						const size_t to = (share + 1) * (end - begin) / shares;
+						const size_t firstFrom = splits[pair * (shares + 1) + share];
+						const size_t firstTo = splits[pair * (shares + 1) + share + 1];
+						std::merge(std::make_move_iterator(source + begin + firstFrom), std::make_move_iterator(source + begin + firstTo),
+							std::make_move_iterator(source + middle + (from - firstFrom)), std::make_move_iterator(source + middle + (to - firstTo)),
+							target + begin + from, compare);
+					});
+					std::vector<size_t> merged;
+					for (size_t run = 0; run < runs.size(); run += 2) {
+						merged.push_back(runs[run]);
+					}
+					if (merged.back() != count) {
+						merged.push_back(count);
+					}
+					runs = std::move(merged);
+					std::swap(source, target);
+				}
+				if (source != items) {
+					parallel(workerCount, [&](size_t worker) {
+						std::move(source + worker * count / workerCount, source + (worker + 1) * count / workerCount,
+							items + worker * count / workerCount);
+					});
+				}
+			}
+			else {
+				//Without scratch items the runs are merged in place, one thread per pair
+				for (size_t width = 1; width < workerCount; width <<= 1) {
+					const size_t pairs = (workerCount + 2 * width - 1) / (2 * width);
+					parallel(pairs, [&](size_t pair) {
+						const size_t begin = pair * 2 * width;
+						const size_t middle = std::min(begin + width, workerCount);
+						const size_t end = std::min(begin + 2 * width, workerCount);
+						if (middle < end) {
+							std::inplace_merge(items + runs[begin], items + runs[middle], items + runs[end], compare);
+						}
+					});
+				}
+			}
+		}
+	};
+}
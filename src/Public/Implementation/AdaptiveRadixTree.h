@@ -0,0 +1,386 @@
+#pragma once
+#include "../../Public/Abstraction/Trie.h"
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace core {
+
+	/**
+	* An adaptive radix tree (ART) implementation of Trie, after Leis, Kemper and Neumann. Inner nodes come
+	* in four sizes, holding up to 4, 16, 48 and 256 children, and a node grows or shrinks to the next size
+	* as children come and go, so the space per key stays close to that of a comparison tree while every
+	* level still consumes a whole key byte. Node4 and Node16 keep sorted key bytes beside their children,
+	* Node16 is searched with a single SSE2 compare, Node48 maps the 256 bytes to its 48 slots and Node256
+	* indexes its children directly.
+	*
+	* Paths are compressed: a node stores the bytes shared by its whole subtree, the first MAX_PREFIX of them
+	* inline, and lookups skip longer prefixes optimistically, verifying the full key at the leaf. Expansion
+	* is lazy: a key is stored as a single leaf until a second key needs to branch off it. A key that ends
+	* where others continue is held by the node it ends at, so keys may be prefixes of each other.
+	*
+	* Keys are strings or integers, std::string is indexed by its bytes and integers by their big-endian
+	* bytes with the sign flipped, which keeps the traversal order equal to the order of the keys
+	*/
+	S_MAP_IMPLEMENTATION_CLASS(AdaptiveRadixTree, Trie, Nature::MUTABLE, Behavior::DYNAMIC, Ordering::SORTED)
+	static_assert((std::integral<K> && !std::same_as<K, bool>) || std::same_as<K, std::string>,
+		"AdaptiveRadixTree requires integer or std::string keys");
+
+	/**
+	* Number of prefix bytes stored inline in a node, longer prefixes are checked against a leaf
+	*/
+	static constexpr size_t MAX_PREFIX = 8;
+
+	/**
+	* The bytes of a key in traversal order. Strings are viewed in place, integers are encoded into the
+	* object itself, which is therefore not copyable
+	*/
+	class KeyBytes {
+		const uint8_t* bytes;
+		size_t length;
+		uint8_t buffer[std::integral<K> ? sizeof(K) : 1];
+	public:
+		explicit KeyBytes(const K& key) noexcept {
+			if constexpr (std::integral<K>) {
+				using U = std::make_unsigned_t<K>;
+				U value = static_cast<U>(key);
+				if constexpr (std::is_signed_v<K>) {
+					value ^= U(1) << (8 * sizeof(K) - 1);
+				}
+				for (size_t i = 0; i < sizeof(K); i++) {
+					buffer[i] = static_cast<uint8_t>(value >> (8 * (sizeof(K) - 1 - i)));
+				}
+				bytes = buffer;
+				length = sizeof(K);
+			}
+			else {
+				bytes = reinterpret_cast<const uint8_t*>(key.data());
+				length = key.size();
+			}
+		}
+		KeyBytes(const KeyBytes&) = delete;
+		KeyBytes& operator=(const KeyBytes&) = delete;
+
+		uint8_t operator[](size_t index) const noexcept { return bytes[index]; }
+		const uint8_t* data() const noexcept { return bytes; }
+		size_t size() const noexcept { return length; }
+	};
+
+	enum class NodeType : uint8_t { NODE4, NODE16, NODE48, NODE256 };
+
+	/**
+	* An entry stored at the bottom of the tree, child pointers to leaves are tagged with the low bit
+	*/
+	struct alignas(alignof(void*)) Leaf {
+		E entry;
+	};
+
+	/**
+	* Common header of the inner nodes
+	*/
+	struct Node {
+		NodeType type;
+		uint16_t count; //Children, the terminal leaf excluded
+		uint32_t prefixLength; //Bytes shared by the subtree below the parent's branch byte
+		uint8_t prefix[MAX_PREFIX]; //The first of them
+		Leaf* terminal; //The key ending at this node, after its prefix
+
+		explicit Node(NodeType type) : type(type), count(0), prefixLength(0), prefix(), terminal(nullptr) {}
+	};
+
+	struct Node4 : Node {
+		uint8_t keys[4];
+		Node* children[4];
+
+		Node4() : Node(NodeType::NODE4), keys(), children() {}
+	};
+
+	struct Node16 : Node {
+		uint8_t keys[16];
+		Node* children[16];
+
+		Node16() : Node(NodeType::NODE16), keys(), children() {}
+	};
+
+	struct Node48 : Node {
+		uint8_t index[256]; //Slot of the child of each byte plus one, zero if there is none
+		Node* children[48];
+
+		Node48() : Node(NodeType::NODE48), index(), children() {}
+	};
+
+	struct Node256 : Node {
+		Node* children[256];
+
+		Node256() : Node(NodeType::NODE256), children() {}
+	};
+
+	/**
+	* Iterator over the entries in ascending key order, holding the path to the current leaf
+	* @tparam T E, or const E for the iterators of a const tree
+	*/
+	template<typename T>
+	class AdaptiveRadixTreeIterator : public Iterator<AdaptiveRadixTreeIterator<T>, T> {
+		std::vector<std::pair<Node*, int>> path;
+		Leaf* leaf = nullptr;
+	public:
+		AdaptiveRadixTreeIterator() = default;
+		explicit AdaptiveRadixTreeIterator(Node* root) : leaf(nullptr) {
+			if (root != nullptr && isLeaf(root)) {
+				leaf = asLeaf(root);
+			}
+			else if (root != nullptr) {
+				path.emplace_back(root, -1);
+				advance();
+			}
+		}
+
+		T& operator*() const { return leaf->entry; }
+		T* operator->() const { return &leaf->entry; }
+
+		AdaptiveRadixTreeIterator& operator++() { advance(); return *this; }
+
+		bool operator==(const AdaptiveRadixTreeIterator& other) const { return leaf == other.leaf; }
+	private:
+		void advance() {
+			while (!path.empty()) {
+				auto& [node, position] = path.back();
+				Node* child = next(node, position);
+				if (child == nullptr) {
+					path.pop_back();
+				}
+				else if (isLeaf(child)) {
+					leaf = asLeaf(child);
+					return;
+				}
+				else {
+					path.emplace_back(child, -1);
+				}
+			}
+			leaf = nullptr;
+		}
+	};
+
+	using iterator = AdaptiveRadixTreeIterator<E>;
+	using const_iterator = AdaptiveRadixTreeIterator<const E>;
+
+	/**
+	* Creates an empty tree
+	*/
+	AdaptiveRadixTree();
+
+	/**
+	* Creates an empty tree drawing its nodes and leaves from the given allocator
+	* @param allocator Allocator of the nodes
+	*/
+	explicit AdaptiveRadixTree(const Allocator& allocator);
+
+	~AdaptiveRadixTree() override;
+
+	//Adding move semantics
+	AdaptiveRadixTree(AdaptiveRadixTree&& other) noexcept;
+	AdaptiveRadixTree& operator=(AdaptiveRadixTree&& other) noexcept(takesStorageOnMove<Allocator>);
+
+	bool put(K key, V value) override;
+	[[nodiscard]] bool get(const K& key, V& value) const override;
+	bool remove(const K& key) override;
+	[[nodiscard]] bool containsKey(const K& key) const override;
+	[[nodiscard]] bool containsValue(const V& value) override;
+	size_t scanPrefix(const K& prefix, std::function<bool(const E&)> visitor) const override;
+	[[nodiscard]] bool longestPrefix(const K& key, E& entry) const override;
+
+	/**
+	* Finds the value associated with the key without copying it. The pointer stays valid until the key
+	* is removed
+	* @param key The key to be searched
+	* @return Returns a pointer to the value, nullptr if the key is not present
+	*/
+	[[nodiscard]] V* find(const K& key);
+	[[nodiscard]] const V* find(const K& key) const;
+
+	/**
+	* Visits the entries whose keys share the first bytes of the given key in ascending order, without the
+	* indirect call of scanPrefix. For integer keys the bytes are the most significant ones
+	* @param prefix Key holding the prefix
+	* @param length Number of its bytes to match, clamped to the length of the key
+	* @param visitor Function receiving each entry, returning false to stop the scan
+	* @return Returns the number of entries visited
+	*/
+	template<typename Function>
+	size_t scanPrefix(const K& prefix, size_t length, Function&& visitor) const {
+		Node* node = subtree(prefix, length);
+		size_t visited = 0;
+		if (node != nullptr) {
+			auto counted = [&](const E& entry) {
+				visited++;
+				return static_cast<bool>(visitor(entry));
+			};
+			visit(node, counted);
+		}
+		return visited;
+	}
+
+	/**
+	* @return Returns the number of bytes held by the nodes and leaves of the tree
+	*/
+	[[nodiscard]] size_t getMemoryUsage() const;
+
+	std::unique_ptr<DataEngine<E>> clone() const override;
+	std::unique_ptr<DataEngine<E>> move() override;
+
+	bool removeAll() override;
+	E* toArray() const override;
+	E* toArray(int start, int end) const override;
+	size_t copyTo(std::span<E> destination, size_t start) const override;
+
+	/**
+	* The order is fixed by the key bytes, reversing leaves the tree untouched
+	*/
+	void reverse() override;
+
+	iterator begin();
+	iterator end();
+	const_iterator begin() const;
+	const_iterator end() const;
+
+protected:
+	//Nodes are resized one at a time as their children come and go, there is no capacity to manage
+	void grow() override;
+	void shrink() override;
+	void compress() override;
+
+	[[nodiscard]] bool equalsInternal(const DataEngine<E>& de) const override;
+	[[nodiscard]] bool equivalenceInternal(const DataEngine<E>& de) const override;
+	[[nodiscard]] std::unique_ptr<DataEngine<E>> mergeInternal(const DataEngine<E>& de, int start, int end) const override;
+
+private:
+	//Child counts at which a node is replaced by the next smaller kind, below the capacity of that kind
+	static constexpr uint16_t NODE16_MINIMUM = 3;
+	static constexpr uint16_t NODE48_MINIMUM = 12;
+	static constexpr uint16_t NODE256_MINIMUM = 37;
+
+	Node* root;
+	size_t memory;
+
+	static bool isLeaf(const Node* node) noexcept { return (reinterpret_cast<uintptr_t>(node) & 1) != 0; }
+	static Leaf* asLeaf(Node* node) noexcept { return reinterpret_cast<Leaf*>(reinterpret_cast<uintptr_t>(node) & ~uintptr_t(1)); }
+	static Node* tag(Leaf* leaf) noexcept { return reinterpret_cast<Node*>(reinterpret_cast<uintptr_t>(leaf) | 1); }
+
+	/**
+	* Steps through the children of a node in byte order, the terminal leaf first
+	* @param node The inner node
+	* @param position Cursor, -1 before the first child
+	* @return Returns the next child, nullptr once they run out
+	*/
+	static Node* next(const Node* node, int& position) noexcept;
+
+	/**
+	* Visits the leaves of the subtree in order
+	* @return Returns false if the visitor stopped the walk
+	*/
+	template<typename Function>
+	static bool visit(Node* node, Function& visitor) {
+		if (isLeaf(node)) {
+			return visitor(static_cast<const E&>(asLeaf(node)->entry));
+		}
+		int position = -1;
+		for (Node* child = next(node, position); child != nullptr; child = next(node, position)) {
+			if (!visit(child, visitor)) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/**
+	* @return Returns the slot holding the child for the byte, nullptr if there is none
+	*/
+	static Node** findChild(Node* node, uint8_t byte) noexcept;
+
+	/**
+	* @return Returns the leaf with the smallest key of the subtree
+	*/
+	static Leaf* minimum(Node* node) noexcept;
+
+	/**
+	* Compares the stored prefix of the node with the key, optimistically ignoring the bytes not stored
+	* @return Returns the number of stored bytes that match
+	*/
+	static size_t checkPrefix(const Node* node, const KeyBytes& bytes, size_t depth) noexcept;
+
+	/**
+	* Compares the whole prefix of the node with the key, reading the bytes not stored from a leaf
+	* @return Returns the length of the matching part of the prefix
+	*/
+	static size_t prefixMismatch(Node* node, const KeyBytes& bytes, size_t depth) noexcept;
+
+	/**
+	* @return Returns true if the key of the leaf is a prefix of, or equal to, the given bytes
+	*/
+	static bool isPrefixOf(const Leaf* leaf, const KeyBytes& bytes, size_t length) noexcept;
+
+	/**
+	* Descends to the subtree holding every key that starts with the first bytes of the prefix
+	* @return Returns its root, nullptr if no key starts with them
+	*/
+	Node* subtree(const K& prefix, size_t length) const;
+
+	bool insert(Node** slot, K& key, V& value, const KeyBytes& bytes, size_t depth);
+	bool erase(Node** slot, const K& key, const KeyBytes& bytes, size_t depth);
+
+	/**
+	* Adds a child under the byte, growing the node into the slot if it is full
+	*/
+	void addChild(Node** slot, Node* node, uint8_t byte, Node* child);
+
+	/**
+	* Removes the child held in the given child slot, then shrinks the node if needed
+	*/
+	void removeChild(Node** slot, Node* node, uint8_t byte, Node** child);
+
+	/**
+	* Replaces a node that became too sparse with a smaller kind, a lone child or its terminal leaf
+	*/
+	void contract(Node** slot, Node* node);
+
+	/**
+	* Places a leaf under a fresh node, as its terminal if the key ends at the depth
+	*/
+	void attach(Node* node, Leaf* leaf, const KeyBytes& bytes, size_t depth);
+
+	static void setPrefix(Node* node, const uint8_t* bytes, size_t length) noexcept;
+	static void copyHeader(Node* to, const Node* from) noexcept;
+
+	template<typename T>
+	T* allocate() {
+		T* node = createObject<T>(allocator);
+		memory += sizeof(T);
+		return node;
+	}
+	void deallocate(Node* node) noexcept;
+	Leaf* allocateLeaf(K key, V value);
+	void deallocateLeaf(Leaf* leaf) noexcept;
+
+	/**
+	* Deep copies a subtree
+	*/
+	Node* copy(Node* node);
+
+	/**
+	* Frees every node and leaf of the subtree
+	*/
+	void release(Node* node) noexcept;
+
+	/**
+	* Frees every node and leaf of the tree. When the leaves need no destructor and the allocator owns its
+	* storage alone, as a PoolAllocator of this tree does, the storage is dropped at once instead of node by node
+	*/
+	void releaseAll() noexcept;
+	E_ENGINE_CLASS
+}
@@ -0,0 +1,220 @@
+#pragma once
+#include "../../Public/Abstraction/Deque.h"
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <new>
+
+namespace core {
+
+	/**
+	* A Deque implementation backed by a ring buffer whose capacity is always a power of two, so that
+	* positions wrap with a mask instead of a modulo. The buffer doubles once the load crosses
+	* GROWTH_LOAD_FACTOR and halves under SHRINK_LOAD_FACTOR, unwrapping the ring into the new buffer
+	* with at most two block copies. Bulk insertion at either end is also done with at most two block
+	* copies. All operations at the ends are amortized O(1)
+	*/
+	S_IMPLEMENTATION_CLASS(ArrayDeque, Deque<E>, Nature::MUTABLE, Behavior::DYNAMIC, Ordering::UNSORTED)
+
+	/**
+	* Iterator over the ring buffer of an ArrayDeque, from head to tail. Positions only grow and are masked
+	* on access, so the iterator is random access across the seam of the ring
+	* @tparam T E, or const E for the iterators of a const deque
+	*/
+	template<typename T>
+	class ArrayDequeIterator : public Iterator<ArrayDequeIterator<T>, T, std::random_access_iterator_tag> {
+		T* buffer = nullptr;
+		size_t mask = 0;
+		size_t position = 0;
+	public:
+		ArrayDequeIterator() = default;
+		ArrayDequeIterator(T* buffer, size_t mask, size_t position) : buffer(buffer), mask(mask), position(position) {}
+
+		T& operator*() const { return buffer[position & mask]; }
+		T* operator->() const { return buffer + (position & mask); }
+		T& operator[](std::ptrdiff_t offset) const { return buffer[(position + offset) & mask]; }
+
+		ArrayDequeIterator& operator++() { ++position; return *this; }
+		ArrayDequeIterator& operator--() { --position; return *this; }
+		ArrayDequeIterator& operator+=(std::ptrdiff_t offset) { position += offset; return *this; }
+		ArrayDequeIterator& operator-=(std::ptrdiff_t offset) { position -= offset; return *this; }
+
+		friend ArrayDequeIterator operator+(ArrayDequeIterator iterator, std::ptrdiff_t offset) { return iterator += offset; }
+		friend ArrayDequeIterator operator+(std::ptrdiff_t offset, ArrayDequeIterator iterator) { return iterator += offset; }
+		friend ArrayDequeIterator operator-(ArrayDequeIterator iterator, std::ptrdiff_t offset) { return iterator -= offset; }
+		friend std::ptrdiff_t operator-(const ArrayDequeIterator& left, const ArrayDequeIterator& right) {
+			return static_cast<std::ptrdiff_t>(left.position - right.position);
+		}
+
+		bool operator==(const ArrayDequeIterator& other) const { return position == other.position; }
+		auto operator<=>(const ArrayDequeIterator& other) const { return position <=> other.position; }
+	};
+
+	using iterator = ArrayDequeIterator<E>;
+	using const_iterator = ArrayDequeIterator<const E>;
+
+	/**
+	* Creates an empty deque with DEFAULT_CAPACITY
+	*/
+	ArrayDeque();
+
+	/**
+	* Creates an empty deque able to hold the given number of items before growing
+	* @param capacity Initial capacity
+	* @param allocator Allocator of the buffer
+	*/
+	explicit ArrayDeque(size_t capacity, const Allocator& allocator = Allocator());
+
+	/**
+	* Creates an empty deque drawing its buffer from the given allocator
+	* @param allocator Allocator of the buffer
+	*/
+	explicit ArrayDeque(const Allocator& allocator);
+
+	~ArrayDeque() override;
+
+	//Adding move semantics
+	ArrayDeque(ArrayDeque&& other) noexcept;
+	ArrayDeque& operator=(ArrayDeque&& other) noexcept(takesStorageOnMove<Allocator>);
+
+	bool addFirst(E item) override;
+	bool addLast(E item) override;
+
+	/**
+	* Adds the given items to the head of the deque, keeping their order, i.e. items[0] becomes the
+	* new head
+	* @param items The items to be added
+	* @param count Number of items
+	* @return Returns true if addition is successful, false otherwise
+	*/
+	bool addFirst(const E* items, size_t count);
+
+	/**
+	* Adds the given items to the tail of the deque, keeping their order
+	* @param items The items to be added
+	* @param count Number of items
+	* @return Returns true if addition is successful, false otherwise
+	*/
+	bool addLast(const E* items, size_t count);
+
+	[[nodiscard]] E removeFirst() override;
+	[[nodiscard]] E removeLast() override;
+	[[nodiscard]] E peekFirst() override;
+	[[nodiscard]] E peekLast() override;
+
+	/**
+	* Gets the item at the given position, counted from the head. The position is unchecked
+	* @param index Position of the item
+	* @return Returns the item
+	*/
+	[[nodiscard]] E get(int index) const;
+
+	[[nodiscard]] bool contains(E item) override;
+
+	using Deque<E>::replaceAll;
+	void replaceAll(std::function<E* (E*)> operatorFunction, int start, int end) override;
+
+	std::unique_ptr<DataEngine<E>> clone() const override;
+	std::unique_ptr<DataEngine<E>> move() override;
+
+	bool removeAll() override;
+	E* toArray() const override;
+	E* toArray(int start, int end) const override;
+	size_t copyTo(std::span<E> destination, size_t start) const override;
+	void reverse() override;
+
+	iterator begin();
+	iterator end();
+	const_iterator begin() const;
+	const_iterator end() const;
+
+	/**
+	* Ensures that the deque can hold the given number of items without growing
+	* @param capacity Required capacity
+	*/
+	void reserve(size_t capacity);
+
+protected:
+	void grow() override;
+	void shrink() override;
+	void compress() override;
+
+	[[nodiscard]] bool containsAllInternal(std::any* deque, int start, int end) override;
+	[[nodiscard]] std::any* retainAll(std::any* deque) override;
+	[[nodiscard]] std::any* mergeFirst(std::any* deque) override;
+	[[nodiscard]] std::any* mergeLast(std::any* deque) override;
+
+	[[nodiscard]] bool equalsInternal(const DataEngine<E>& de) const override;
+	[[nodiscard]] bool equivalenceInternal(const DataEngine<E>& de) const override;
+	[[nodiscard]] std::unique_ptr<DataEngine<E>> mergeInternal(const DataEngine<E>& de, int start, int end) const override;
+
+private:
+	/**
+	* True when the buffer can be moved to a new location with a plain memcpy
+	*/
+	static constexpr bool RELOCATABLE = is_trivially_relocatable<E>::value;
+
+	E* buffer;
+	size_t head; //Physical index of the first item
+	size_t mask; //Always maxCapacity - 1
+
+	//Cached bounds so that the hot paths never touch floating point
+	size_t growthThreshold;
+	size_t shrinkThreshold;
+
+	/**
+	* @param index Logical position counted from the head
+	* @return Returns the slot holding the item at the given position
+	*/
+	E* slot(size_t index) const noexcept { return buffer + ((head + index) & mask); }
+
+	/**
+	* Moves all the items into a freshly allocated buffer of the given capacity, unwrapping the ring so
+	* that the head lands on index 0
+	* @param capacity New capacity, must be a power of two and at least the active size
+	*/
+	void relocate(size_t capacity);
+
+	/**
+	* Copies the given items into the ring starting at the given physical index, wrapping at most once
+	* @param index Physical index of the first slot
+	* @param items Items to be copied
+	* @param count Number of items
+	*/
+	void copyIn(size_t index, const E* items, size_t count);
+
+	/**
+	* The items lying between two logical positions occupy at most two physical runs, the second one
+	* always starting at slot(start + firstRun(start, end))
+	* @param start Starting position
+	* @param end Endpoint position
+	* @return Returns the length of the first run
+	*/
+	size_t firstRun(size_t start, size_t end) const noexcept {
+		return std::min(end - start, mask + 1 - ((head + start) & mask));
+	}
+
+	/**
+	* Destroys all the items and releases the buffer
+	*/
+	void release() noexcept;
+
+	/**
+	* Recomputes the mask and the cached thresholds from the max capacity
+	*/
+	void updateThresholds() noexcept;
+
+	/**
+	* @return Returns the smallest power of two capacity that holds the given number of items under
+	* GROWTH_LOAD_FACTOR
+	*/
+	static size_t capacityFor(size_t items) noexcept;
+
+	E* allocate(size_t capacity) const;
+	void deallocate(E* buffer, size_t capacity) const noexcept;
+
+	//Static form of operator==, picked at compile time by ENGINE_STATIC_DISPATCH
+	[[nodiscard]] bool equalTo(const ArrayDeque& other) const;
+
+	E_ENGINE_CLASS
+}
@@ -0,0 +1,164 @@
+#pragma once
+#include "../../Public/Abstraction/List.h"
+#include <concepts>
+#include <cstring>
+#include <memory>
+#include <new>
+
+namespace core {
+
+	/**
+	* A List implementation backed by a single contiguous buffer. The buffer grows by GOLDEN_RATIO once
+	* the load crosses GROWTH_LOAD_FACTOR and shrinks by the same ratio once it falls under
+	* SHRINK_LOAD_FACTOR. Elements that are trivially relocatable are moved between buffers with a
+	* single memcpy, all other elements are moved one by one. Indexed access is O(1), insertion and
+	* removal at the tail are amortized O(1)
+	*/
+	S_IMPLEMENTATION_CLASS(ArrayList, List<E>, Nature::MUTABLE, Behavior::DYNAMIC, Ordering::UNSORTED)
+
+	/**
+	* The buffer is contiguous, iterators over it are plain pointers
+	*/
+	using iterator = E*;
+	using const_iterator = const E*;
+
+	/**
+	* Creates an empty list with DEFAULT_CAPACITY
+	*/
+	ArrayList();
+
+	/**
+	* Creates an empty list with DEFAULT_CAPACITY drawing its buffer from the given allocator
+	* @param allocator Allocator of the buffer
+	*/
+	explicit ArrayList(const Allocator& allocator);
+
+	/**
+	* Creates an empty list able to hold the given number of items before growing
+	* @param capacity Initial capacity
+	* @param allocator Allocator of the buffer
+	*/
+	explicit ArrayList(size_t capacity, const Allocator& allocator = Allocator());
+
+	~ArrayList() override;
+
+	//Adding move semantics
+	ArrayList(ArrayList&& other) noexcept;
+	ArrayList& operator=(ArrayList&& other) noexcept(takesStorageOnMove<Allocator>);
+
+	bool add(E item) override;
+	bool add(E item, int index) override;
+	using List<E>::addAll;
+	bool addAll(E items[], int start, int end) override;
+
+	E get(int index) const override;
+	int getFirstIndex(E item) override;
+	int getLastIndex(E item) override;
+
+	bool remove(E item) override;
+	bool removeAt(int index) override;
+	void set(int index, E item) override;
+
+	[[nodiscard]] bool contains(E item) override;
+	using List<E>::replaceAll;
+	void replaceAll(std::function<E(E*)> operatorFunction, int start, int end) override;
+
+	std::unique_ptr<DataEngine<E>> clone() const override;
+	std::unique_ptr<DataEngine<E>> move() override;
+
+	bool removeAll() override;
+	E* toArray() const override;
+	E* toArray(int start, int end) const override;
+	size_t copyTo(std::span<E> destination, size_t start) const override;
+	void reverse() override;
+
+	/**
+	* Sorts the items in ascending order through ParallelSort, by radix for integer and floating point items
+	* @param threads Threads to use, 0 for one per hardware thread
+	*/
+	void sort(unsigned threads = 0) requires std::totally_ordered<E>;
+
+	iterator begin() noexcept;
+	iterator end() noexcept;
+	const_iterator begin() const noexcept;
+	const_iterator end() const noexcept;
+
+	/**
+	* Borrows the live storage of the list, see Contiguous
+	* @return Returns a span over the items, invalidated by any change to the list
+	*/
+	std::span<E> view() noexcept;
+	std::span<const E> view() const noexcept;
+
+	/**
+	* Ensures that the list can hold the given number of items without growing
+	* @param capacity Required capacity
+	*/
+	void reserve(size_t capacity);
+
+protected:
+	void grow() override;
+	void shrink() override;
+	void compress() override;
+
+	[[nodiscard]] bool containsAllInternal(std::any* list, int start, int end) override;
+	[[nodiscard]] bool addAllInternal(std::any* list, int start, int end) override;
+	[[nodiscard]] std::any* retainAll(std::any* list) override;
+	[[nodiscard]] std::any* subList(int start, int end) override;
+
+	[[nodiscard]] bool equalsInternal(const DataEngine<E>& de) const override;
+	[[nodiscard]] bool equivalenceInternal(const DataEngine<E>& de) const override;
+	[[nodiscard]] std::unique_ptr<DataEngine<E>> mergeInternal(const DataEngine<E>& de, int start, int end) const override;
+
+private:
+	/**
+	* True when the buffer can be moved to a new location with a plain memcpy
+	*/
+	static constexpr bool RELOCATABLE = is_trivially_relocatable<E>::value;
+
+	E* buffer;
+
+	//Cached bounds so that the hot paths never touch floating point
+	size_t growthThreshold;
+	size_t shrinkThreshold;
+
+	/**
+	* Moves all the items into a freshly allocated buffer of the given capacity
+	* @param capacity New capacity, must be at least the active size
+	*/
+	void relocate(size_t capacity);
+
+	/**
+	* Opens a gap of the given width at the given index, growing if required
+	* @param index Index of the gap
+	* @param width Width of the gap
+	*/
+	void openGap(size_t index, size_t width);
+
+	/**
+	* Closes a gap of the given width at the given index, the slots must already be destroyed
+	* @param index Index of the gap
+	* @param width Width of the gap
+	*/
+	void closeGap(size_t index, size_t width);
+
+	/**
+	* Destroys all the items and releases the buffer
+	*/
+	void release() noexcept;
+
+	/**
+	* Recomputes the cached growth and shrink thresholds from the max capacity
+	*/
+	void updateThresholds() noexcept;
+
+	//Static forms of operator==, equivalence and merge, picked at compile time by ENGINE_STATIC_DISPATCH
+	[[nodiscard]] bool equalTo(const ArrayList& other) const;
+	[[nodiscard]] bool equivalentTo(const ArrayList& other) const;
+	[[nodiscard]] std::unique_ptr<ArrayList> mergeWith(const ArrayList& other, int start, int end) const;
+
+	E* allocate(size_t capacity) const;
+	void deallocate(E* buffer, size_t capacity) const noexcept;
+
+	E_ENGINE_CLASS
+}
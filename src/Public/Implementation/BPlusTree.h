@@ -0,0 +1,308 @@
+#pragma once
+#include "../../Public/Abstraction/Tree.h"
+#include <algorithm>
+#include <concepts>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+namespace core {
+
+	/**
+	* A cache-conscious B+tree implementation of Tree. Node sizes are fixed at compile time: every node
+	* spans NODE_BYTES, eight cache lines, and the fanout is derived from the key and entry sizes so that
+	* the node is filled. Inner nodes keep their keys contiguous, apart from the child pointers, so a
+	* search within a node touches as few lines as possible. Leaves hold the entries themselves in key
+	* order and are linked both ways, so a range scan walks plain arrays.
+	*
+	* Nodes split when full and borrow from or merge with a sibling when they fall under half full. The
+	* bulk-load constructor builds a packed tree from sorted input in O(n), and compress repacks the tree
+	* the same way. Merging two trees is a linear merge followed by a bulk load
+	*/
+	S_MAP_IMPLEMENTATION_CLASS(BPlusTree, Tree, Nature::MUTABLE, Behavior::DYNAMIC, Ordering::SORTED)
+	static_assert(std::totally_ordered<K>, "BPlusTree requires totally ordered keys");
+
+	/**
+	* Target size of a node, in bytes
+	*/
+	static constexpr size_t NODE_BYTES = 8 * DataEngine<E>::CACHE_LINE_SIZE;
+
+	/**
+	* Number of entries a leaf holds, after the header and the two sibling links
+	*/
+	static constexpr size_t LEAF_CAPACITY = std::max<size_t>(4, (NODE_BYTES - 3 * sizeof(void*)) / sizeof(E));
+
+	/**
+	* Number of keys an inner node holds, it has one child more
+	*/
+	static constexpr size_t INNER_CAPACITY = std::max<size_t>(4, (NODE_BYTES - 2 * sizeof(void*)) / (sizeof(K) + sizeof(void*)));
+
+	/**
+	* Common header of the nodes
+	*/
+	struct Node {
+		uint32_t count; //Entries of a leaf, keys of an inner node
+		bool leaf;
+
+		explicit Node(bool leaf) : count(0), leaf(leaf) {}
+	};
+
+	struct alignas(DataEngine<E>::CACHE_LINE_SIZE) Inner : Node {
+		K keys[INNER_CAPACITY]; //keys[i] is the smallest key under children[i + 1]
+		Node* children[INNER_CAPACITY + 1];
+
+		Inner() : Node(false) {}
+	};
+
+	struct alignas(DataEngine<E>::CACHE_LINE_SIZE) Leaf : Node {
+		Leaf* previous;
+		Leaf* next;
+		E entries[LEAF_CAPACITY];
+
+		Leaf() : Node(true), previous(nullptr), next(nullptr) {}
+	};
+
+	/**
+	* Iterator over the entries in ascending key order, stepping back from the end starts at the last leaf
+	* @tparam T E, or const E for the iterators of a const tree
+	*/
+	template<typename T>
+	class BPlusTreeIterator : public Iterator<BPlusTreeIterator<T>, T, std::bidirectional_iterator_tag> {
+		Leaf* leaf = nullptr;
+		Leaf* last = nullptr;
+		size_t index = 0;
+	public:
+		BPlusTreeIterator() = default;
+		BPlusTreeIterator(Leaf* leaf, Leaf* last, size_t index) : leaf(leaf), last(last), index(index) {}
+
+		T& operator*() const { return leaf->entries[index]; }
+		T* operator->() const { return leaf->entries + index; }
+
+		BPlusTreeIterator& operator++() {
+			if (++index == leaf->count) {
+				leaf = leaf->next;
+				index = 0;
+			}
+			return *this;
+		}
+
+		BPlusTreeIterator& operator--() {
+			if (leaf == nullptr) {
+				leaf = last;
+				index = leaf->count;
+			}
+			else if (index == 0) {
+				leaf = leaf->previous;
+				index = leaf->count;
+			}
+			--index;
+			return *this;
+		}
+
+		bool operator==(const BPlusTreeIterator& other) const { return leaf == other.leaf && index == other.index; }
+	};
+
+	using iterator = BPlusTreeIterator<E>;
+	using const_iterator = BPlusTreeIterator<const E>;
+
+	/**
+	* Creates an empty tree
+	*/
+	BPlusTree();
+
+	/**
+	* Creates an empty tree drawing its nodes from the given allocator
+	* @param allocator Allocator of the nodes
+	*/
+	explicit BPlusTree(const Allocator& allocator);
+
+	/**
+	* Bulk-loads a packed tree in O(n). Leaves and inner nodes are filled evenly, as full as the minimum
+	* occupancy of the last node allows
+	* @param entries Entries sorted by strictly increasing key
+	* @param count Number of entries
+	* @param allocator Allocator of the nodes
+	* @throws std::invalid_argument if the keys are not strictly increasing
+	*/
+	BPlusTree(const E* entries, size_t count, const Allocator& allocator = Allocator());
+
+	~BPlusTree() override;
+
+	//Adding move semantics
+	BPlusTree(BPlusTree&& other) noexcept;
+	BPlusTree& operator=(BPlusTree&& other) noexcept(takesStorageOnMove<Allocator>);
+
+	bool put(K key, V value) override;
+	[[nodiscard]] bool get(const K& key, V& value) const override;
+	bool remove(const K& key) override;
+	[[nodiscard]] bool containsKey(const K& key) const override;
+	[[nodiscard]] bool containsValue(const V& value) override;
+
+	[[nodiscard]] bool first(E& entry) const override;
+	[[nodiscard]] bool last(E& entry) const override;
+	[[nodiscard]] bool ceiling(const K& key, E& entry) const override;
+	[[nodiscard]] bool floor(const K& key, E& entry) const override;
+	size_t scan(const K& from, std::function<bool(const E&)> visitor) const override;
+
+	/**
+	* Finds the value associated with the key without copying it. The pointer stays valid until the
+	* tree is next modified
+	* @param key The key to be searched
+	* @return Returns a pointer to the value, nullptr if the key is not present
+	*/
+	[[nodiscard]] V* find(const K& key);
+	[[nodiscard]] const V* find(const K& key) const;
+
+	/**
+	* Visits the entries with keys in [from, to) in ascending order, leaf by leaf, without the indirect
+	* call of scan
+	* @param from Inclusive lower bound
+	* @param to Exclusive upper bound
+	* @param visitor Function receiving each entry
+	* @return Returns the number of entries visited
+	*/
+	template<typename Function>
+	size_t scan(const K& from, const K& to, Function&& visitor) const {
+		size_t visited = 0;
+		size_t index;
+		for (Leaf* leaf = lowerBound(from, index); leaf != nullptr; leaf = leaf->next, index = 0) {
+			for (; index < leaf->count; index++) {
+				if (!(leaf->entries[index].key < to)) {
+					return visited;
+				}
+				visitor(static_cast<const E&>(leaf->entries[index]));
+				visited++;
+			}
+		}
+		return visited;
+	}
+
+	/**
+	* @return Returns the number of levels, 0 for an empty tree
+	*/
+	[[nodiscard]] size_t getHeight() const;
+
+	std::unique_ptr<DataEngine<E>> clone() const override;
+	std::unique_ptr<DataEngine<E>> move() override;
+
+	bool removeAll() override;
+	E* toArray() const override;
+	E* toArray(int start, int end) const override;
+	size_t copyTo(std::span<E> destination, size_t start) const override;
+
+	/**
+	* The order is fixed by the keys, reversing leaves the tree untouched
+	*/
+	void reverse() override;
+
+	iterator begin();
+	iterator end();
+	const_iterator begin() const;
+	const_iterator end() const;
+
+protected:
+	//Nodes are allocated one at a time as the tree grows and shrinks
+	void grow() override;
+	void shrink() override;
+
+	/**
+	* Repacks the tree through a bulk load
+	*/
+	void compress() override;
+
+	[[nodiscard]] bool equalsInternal(const DataEngine<E>& de) const override;
+	[[nodiscard]] bool equivalenceInternal(const DataEngine<E>& de) const override;
+	[[nodiscard]] std::unique_ptr<DataEngine<E>> mergeInternal(const DataEngine<E>& de, int start, int end) const override;
+
+private:
+	static constexpr size_t LEAF_MINIMUM = LEAF_CAPACITY / 2;
+	static constexpr size_t INNER_MINIMUM = INNER_CAPACITY / 2;
+	static constexpr size_t MAX_HEIGHT = 64; //Bounds the descent path, fanouts of at least 4 never reach it
+
+	Node* root;
+	Leaf* head; //Leftmost leaf
+	Leaf* tail; //Rightmost leaf
+	size_t height;
+
+	/**
+	* @return Returns the index of the child of the inner node whose subtree covers the key
+	*/
+	static size_t childIndex(const Inner* inner, const K& key) noexcept {
+		return std::upper_bound(inner->keys, inner->keys + inner->count, key) - inner->keys;
+	}
+
+	/**
+	* @return Returns the index of the first entry of the leaf whose key is not less than the given one
+	*/
+	static size_t entryIndex(const Leaf* leaf, const K& key) noexcept {
+		return std::lower_bound(leaf->entries, leaf->entries + leaf->count, key,
+			[](const E& entry, const K& bound) { return entry.key < bound; }) - leaf->entries;
+	}
+
+	/**
+	* Descends to the leaf covering the key
+	*/
+	Leaf* leafFor(const K& key) const noexcept;
+
+	/**
+	* Locates the first entry whose key is not less than the given one
+	* @param key The lower bound
+	* @param index Receives the index of the entry in the returned leaf
+	* @return Returns the leaf holding the entry, nullptr if there is none
+	*/
+	Leaf* lowerBound(const K& key, size_t& index) const noexcept;
+
+	/**
+	* Inserts a separator and the node split off to its right into the parents along the path, splitting
+	* them as needed
+	*/
+	void insertIntoParents(Inner** path, size_t* slots, size_t depth, K separator, Node* right);
+
+	/**
+	* Restores the minimum occupancy of an underfull leaf and of the parents left underfull in turn
+	*/
+	void rebalance(Leaf* leaf, Inner** path, size_t* slots, size_t depth);
+
+	/**
+	* Restores the minimum occupancy of an underfull inner node
+	* @return Returns true if the parent lost a key and may be underfull
+	*/
+	bool rebalanceInner(Inner* inner, Inner* parent, size_t slot);
+
+	/**
+	* Removes the key at the index and the child to its right from an inner node
+	*/
+	static void eraseFromInner(Inner* inner, size_t index);
+
+	/**
+	* Builds the tree from sorted entries, the tree must be empty
+	*/
+	void build(const E* entries, size_t count);
+
+	/**
+	* Copies the entries in key order into the destination, which must hold getActiveSize entries
+	*/
+	void collect(E* destination) const;
+
+	Leaf* allocateLeaf();
+	void deallocateLeaf(Leaf* leaf) noexcept;
+	Inner* allocateInner();
+	void deallocateInner(Inner* inner) noexcept;
+
+	/**
+	* Frees every node of the subtree
+	*/
+	void release(Node* node) noexcept;
+
+	/**
+	* Frees every node of the tree. When the nodes need no destructor and the allocator owns its storage
+	* alone, as a PoolAllocator of this tree does, the storage is dropped at once instead of node by node
+	*/
+	void releaseAll() noexcept;
+
+	//Static form of operator==, picked at compile time by ENGINE_STATIC_DISPATCH
+	[[nodiscard]] bool equalTo(const BPlusTree& other) const;
+
+	E_ENGINE_CLASS
+}
@@ -0,0 +1,191 @@
+#pragma once
+#include "../../Public/Implementation/CSRMatrix.h"
+
+namespace core {
+
+	/**
+	* A sparse Matrix implementation in compressed sparse column form: the values and row indices of the
+	* stored elements column after column, with the column boundaries in an offset array of columns + 1
+	* entries. These are exactly the arrays of the compressed sparse row form of the transpose, so the
+	* matrix is kept as a CSRMatrix of its transpose and shares its kernels: the product with a vector is
+	* the transposed product of that CSRMatrix, and the other way around. Row indices are 32 bits wide,
+	* limiting the number of rows to UINT32_MAX.
+	*
+	* As for CSRMatrix, the size and the array forms count every element of the grid while iteration only
+	* visits the stored elements, column by column
+	*/
+	S_IMPLEMENTATION_CLASS(CSCMatrix, Matrix<E>, Nature::MUTABLE, Behavior::FIXED_LENGTH, Ordering::UNSORTED)
+	friend class CSRMatrix<E, Allocator>;
+
+	/**
+	* Creates an empty matrix with no rows and no columns
+	*/
+	CSCMatrix();
+
+	/**
+	* Creates an empty matrix with no rows and no columns, which later draws its storage from the given allocator
+	* @param allocator Allocator of the storage
+	*/
+	explicit CSCMatrix(const Allocator& allocator);
+
+	/**
+	* Creates a matrix of the given size without any stored element
+	* @param rows Number of rows
+	* @param columns Number of columns
+	* @param allocator Allocator of the storage
+	* @throws std::length_error if there are more than UINT32_MAX rows
+	*/
+	CSCMatrix(size_t rows, size_t columns, const Allocator& allocator = Allocator());
+
+	/**
+	* Creates a matrix from elements in coordinate form, in any order. Elements given more than once at
+	* the same position are summed
+	* @param rows Number of rows
+	* @param columns Number of columns
+	* @param triplets The elements
+	* @param count Number of elements
+	* @param allocator Allocator of the storage
+	* @throws std::out_of_range if an element lies outside the matrix
+	* @throws std::length_error if there are more than UINT32_MAX rows
+	*/
+	CSCMatrix(size_t rows, size_t columns, const MatrixTriplet<E>* triplets, size_t count, const Allocator& allocator = Allocator());
+
+	/**
+	* Converts a matrix in compressed sparse row form, in time linear in its stored elements
+	* @param matrix The matrix to convert
+	*/
+	explicit CSCMatrix(const CSRMatrix<E, Allocator>& matrix);
+
+	~CSCMatrix() override = default;
+
+	//Adding move semantics
+	CSCMatrix(CSCMatrix&& other) noexcept;
+	CSCMatrix& operator=(CSCMatrix&& other) noexcept(takesStorageOnMove<Allocator>);
+
+	[[nodiscard]] size_t getRows() const override;
+	[[nodiscard]] size_t getColumns() const override;
+	[[nodiscard]] E get(size_t row, size_t column) const override;
+
+	/**
+	* @return Returns false if no element is stored at the position and the value is not zero
+	*/
+	bool set(size_t row, size_t column, E value) override;
+
+	/**
+	* @return Returns the number of stored elements
+	*/
+	[[nodiscard]] size_t getNonZeros() const noexcept { return transposed.getNonZeros(); }
+
+	/**
+	* @return Returns the columns + 1 column boundaries, the elements of column j are at
+	* [offsets[j], offsets[j + 1])
+	*/
+	[[nodiscard]] const size_t* getOffsets() const noexcept { return transposed.getOffsets(); }
+
+	/**
+	* @return Returns the row of each stored element
+	*/
+	[[nodiscard]] const uint32_t* getIndices() const noexcept { return transposed.getIndices(); }
+
+	/**
+	* @return Returns the value of each stored element
+	*/
+	[[nodiscard]] const E* getValues() const noexcept { return transposed.getValues(); }
+
+	/**
+	* Visits the stored elements column by column
+	* @param visitor Function receiving the row, the column and the value of each element
+	*/
+	template<typename Visitor>
+	void forEach(Visitor&& visitor) const {
+		transposed.forEach([&](size_t column, size_t row, const E& value) { visitor(row, column, value); });
+	}
+
+	/**
+	* Computes result = matrix * vector, each thread scattering its share of the columns into a private
+	* copy of the result
+	* @param vector getColumns() elements
+	* @param result Receives getRows() elements, distinct from the vector
+	* @param threads Number of threads to split the work over, 0 for one per hardware thread
+	*/
+	void multiply(const E* vector, E* result, unsigned threads = 1) const;
+
+	/**
+	* Computes result = transpose(matrix) * vector, split over threads along the merge path
+	* @param vector getRows() elements
+	* @param result Receives getColumns() elements, distinct from the vector
+	* @param threads Number of threads to split the work over, 0 for one per hardware thread
+	*/
+	void multiplyTransposed(const E* vector, E* result, unsigned threads = 1) const;
+
+	/**
+	* Multiplies the invoking matrix by a dense one. Each stored element adds a multiple of a row of the
+	* dense matrix to a row of the product. Threads get bands of the columns of the product, so that the
+	* scattered rows never overlap
+	* @param dense Right hand side, with getColumns() rows
+	* @param threads Number of threads to split the work over, 0 for one per hardware thread
+	* @return Returns the product
+	* @throws std::invalid_argument if the sizes do not match
+	*/
+	[[nodiscard]] DenseMatrix<E, Allocator> multiply(const DenseMatrix<E, Allocator>& dense, unsigned threads = 1) const;
+
+	std::unique_ptr<DataEngine<E>> clone() const override;
+	std::unique_ptr<DataEngine<E>> move() override;
+
+	/**
+	* Releases the elements, leaving a matrix with no rows and no columns
+	*/
+	bool removeAll() override;
+
+	/**
+	* Expands the matrix, zeros included, row by row
+	*/
+	E* toArray() const override;
+	E* toArray(int start, int end) const override;
+	size_t copyTo(std::span<E> destination, size_t start) const override;
+
+	/**
+	* Reverses the elements in row-major order, i.e. rotates the matrix by half a turn
+	*/
+	void reverse() override;
+
+	/**
+	* Iterates the stored elements column by column, they are the rows of the transposed form
+	*/
+	E* begin() noexcept;
+	E* end() noexcept;
+	const E* begin() const noexcept;
+	const E* end() const noexcept;
+
+	/**
+	* Borrows the live storage of the matrix, see Contiguous
+	* @return Returns a span over the stored elements, column by column, invalidated by any change to the matrix
+	*/
+	std::span<E> view() noexcept;
+	std::span<const E> view() const noexcept;
+
+protected:
+	//The structure is fixed once built
+	void grow() override;
+	void shrink() override;
+	void compress() override;
+
+	[[nodiscard]] bool equalsInternal(const DataEngine<E>& de) const override;
+	[[nodiscard]] bool equivalenceInternal(const DataEngine<E>& de) const override;
+
+	/**
+	* Stacks the given rows of the other matrix under the invoking one, the column counts must match
+	*/
+	[[nodiscard]] std::unique_ptr<DataEngine<E>> mergeInternal(const DataEngine<E>& de, int start, int end) const override;
+
+private:
+	CSRMatrix<E, Allocator> transposed; //Row i of the transpose is column i
+
+	/**
+	* Tag selecting the constructor that adopts the transpose as it is
+	*/
+	struct Adopt {};
+
+	CSCMatrix(Adopt, CSRMatrix<E, Allocator>&& transposed) noexcept;
+	E_ENGINE_CLASS
+}
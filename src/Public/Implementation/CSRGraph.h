@@ -0,0 +1,336 @@
+#pragma once
+#include "../../Public/Abstraction/Graph.h"
+#include "../../Public/EngineParallel.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace core {
+	template<typename E, typename Allocator>
+	class DynamicGraph;
+
+	/**
+	* An immutable Graph implementation in compressed sparse row form: the targets of the arcs vertex after
+	* vertex, sorted within each vertex, with the vertex boundaries in an offset array of vertices + 1
+	* entries. A directed graph keeps the same form of its reverse arcs as well, so that the arcs entering
+	* a vertex are as easy to reach as those leaving it, an undirected graph needs only one. Vertex
+	* identifiers are unsigned integers, the greatest value is reserved for NONE.
+	*
+	* The graph is built from an edge list with a parallel counting sort: degrees are counted with atomic
+	* increments, turned into offsets with a parallel prefix sum, and the arcs are scattered to their slots
+	* by the same atomic counters. Each vertex then sorts its arcs and drops repeated ones.
+	*
+	* Breadth first search is direction optimizing. While the frontier is small it is a queue and each
+	* step scans the arcs leaving it, claiming the unvisited targets with a compare-and-swap. Once the
+	* arcs leaving the frontier outnumber a fraction of the arcs left to check, the frontier turns into a
+	* bitmap and each step has the unvisited vertices look for a parent in it through their entering arcs,
+	* stopping at the first one found. Steps with little work run on the calling thread only.
+	*
+	* A graph built from weighted edges keeps a single precision weight next to each arc. Shortest paths
+	* use delta-stepping: vertices wait in buckets of tentative distance delta wide, the lowest bucket is
+	* relaxed in parallel, with the distances lowered by compare-and-swap, until it stays empty, and each
+	* thread files the vertices it improved into buckets of its own. Connected components use a lock-free
+	* union-find that always hangs the greater root under the smaller one, sampled as in Afforest: the first
+	* arcs of each vertex are linked first, then the vertices outside the largest component found so far
+	* link the rest of their arcs. The arcs of directed graphs are followed both ways, giving the weakly
+	* connected components. Both report how long each of their phases took on request.
+	*
+	* Every method that would modify the graph throws std::logic_error, merging builds a new graph instead
+	*/
+	S_IMPLEMENTATION_CLASS(CSRGraph, Graph<E>, Nature::IMMUTABLE, Behavior::FIXED_LENGTH, Ordering::UNSORTED)
+	static_assert(std::is_integral_v<E> && std::is_unsigned_v<E>, "CSRGraph requires unsigned integer vertex identifiers");
+	friend class DynamicGraph<E, Allocator>;
+
+	/**
+	* The targets of the arcs, vertex by vertex, are contiguous and read-only, iterators over them are
+	* plain pointers
+	*/
+	using iterator = const E*;
+
+	/**
+	* Marks a missing vertex, such as the parent of a vertex a search did not reach
+	*/
+	static constexpr E NONE = std::numeric_limits<E>::max();
+
+	/**
+	* Creates an empty directed graph with no vertices
+	*/
+	CSRGraph();
+
+	/**
+	* Creates an empty directed graph with no vertices, which later draws its storage from the given allocator
+	* @param allocator Allocator of the storage
+	*/
+	explicit CSRGraph(const Allocator& allocator);
+
+	/**
+	* Creates a graph from a list of edges, in any order. Edges given more than once are kept once
+	* @param vertices Number of vertices
+	* @param edges The edges
+	* @param count Number of edges
+	* @param directed False to store each edge in both directions
+	* @param threads Number of threads to split the work over, 0 for one per hardware thread
+	* @param allocator Allocator of the storage
+	* @throws std::out_of_range if an edge has an end that is not a vertex
+	* @throws std::length_error if there are more vertices than identifiers below NONE
+	*/
+	CSRGraph(size_t vertices, const GraphEdge<E>* edges, size_t count, bool directed = true, unsigned threads = 1,
+		const Allocator& allocator = Allocator());
+
+	/**
+	* Creates a weighted graph from a list of edges, in any order. Of the edges given more than once, the
+	* lightest is kept
+	* @param vertices Number of vertices
+	* @param edges The edges
+	* @param count Number of edges
+	* @param directed False to store each edge in both directions
+	* @param threads Number of threads to split the work over, 0 for one per hardware thread
+	* @param allocator Allocator of the storage
+	* @throws std::out_of_range if an edge has an end that is not a vertex
+	* @throws std::invalid_argument if a weight is negative, infinite or not a number
+	* @throws std::length_error if there are more vertices than identifiers below NONE
+	*/
+	CSRGraph(size_t vertices, const WeightedGraphEdge<E>* edges, size_t count, bool directed = true, unsigned threads = 1,
+		const Allocator& allocator = Allocator());
+
+	~CSRGraph() override = default;
+
+	//Adding move semantics
+	CSRGraph(CSRGraph&& other) noexcept;
+	CSRGraph& operator=(CSRGraph&& other) noexcept(takesStorageOnMove<Allocator>);
+
+	[[nodiscard]] size_t getVertices() const override;
+	[[nodiscard]] bool isDirected() const override;
+	[[nodiscard]] size_t getDegree(E vertex) const override;
+	[[nodiscard]] bool containsEdge(E source, E target) const override;
+	[[nodiscard]] std::vector<E> getNeighbors(E vertex) const override;
+
+	/**
+	* Gets the targets of the arcs leaving a vertex, in increasing order, without copying them
+	* @param vertex The vertex, which is not checked
+	* @return Returns a view of the neighbors
+	*/
+	[[nodiscard]] std::span<const E> neighbors(E vertex) const noexcept {
+		return { targets.data() + offsets[vertex], targets.data() + offsets[vertex + 1] };
+	}
+
+	/**
+	* Gets the sources of the arcs entering a vertex, in increasing order, without copying them
+	* @param vertex The vertex, which is not checked
+	* @return Returns a view of the predecessors
+	*/
+	[[nodiscard]] std::span<const E> predecessors(E vertex) const noexcept {
+		const EngineVector<size_t, Allocator>& entering = directed ? reverseOffsets : offsets;
+		const EngineVector<E, Allocator>& sources = directed ? reverseTargets : targets;
+		return { sources.data() + entering[vertex], sources.data() + entering[vertex + 1] };
+	}
+
+	/**
+	* @return Returns true if the arcs carry weights, false if they all weigh one
+	*/
+	[[nodiscard]] bool isWeighted() const noexcept { return weighted; }
+
+	/**
+	* Gets the weights of the arcs leaving a weighted graph's vertex, in the order of neighbors()
+	* @param vertex The vertex, which is not checked
+	* @return Returns a view of the weights
+	*/
+	[[nodiscard]] std::span<const float> neighborWeights(E vertex) const noexcept {
+		return { weights.data() + offsets[vertex], weights.data() + offsets[vertex + 1] };
+	}
+
+	/**
+	* Creates the graph with every arc reversed, which only copies the arrays
+	* @return Returns the reversed graph
+	*/
+	[[nodiscard]] CSRGraph transpose() const;
+
+	/**
+	* Searches the graph breadth first from a vertex
+	* @param source The vertex to start from
+	* @param threads Number of threads to split the work over, 0 for one per hardware thread
+	* @return Returns the parent of each vertex in the search tree, the source being its own parent and
+	* NONE marking the vertices not reached
+	* @throws std::out_of_range if the source does not exist
+	*/
+	[[nodiscard]] std::vector<E> breadthFirst(E source, unsigned threads = 1) const;
+
+	/**
+	* Computes the length of the shortest path from a vertex to every other one with delta-stepping. A
+	* bucket width close to the average arc weight divided by the average degree is usually a good start:
+	* wider buckets relax more arcs in vain, narrower ones take more rounds
+	* @param source The vertex to start from
+	* @param delta Width of the buckets
+	* @param threads Number of threads to split the work over, 0 for one per hardware thread
+	* @param phases Receives the time spent relaxing arcs and moving between buckets, if not null
+	* @return Returns the distance of each vertex, infinity for the vertices not reached
+	* @throws std::out_of_range if the source does not exist
+	* @throws std::invalid_argument if delta is not positive
+	*/
+	[[nodiscard]] std::vector<double> shortestPaths(E source, double delta, unsigned threads = 1, std::vector<GraphPhase>* phases = nullptr) const;
+
+	/**
+	* Finds the connected components, following arcs both ways
+	* @param threads Number of threads to split the work over, 0 for one per hardware thread
+	* @param phases Receives the time spent sampling, finding the largest component, linking the
+	* remaining arcs and compressing the labels, if not null
+	* @return Returns the label of each vertex, which is the smallest vertex of its component
+	*/
+	[[nodiscard]] std::vector<E> components(unsigned threads = 1, std::vector<GraphPhase>* phases = nullptr) const;
+
+	std::unique_ptr<DataEngine<E>> clone() const override;
+	std::unique_ptr<DataEngine<E>> move() override;
+	bool removeAll() override;
+	E* toArray() const override;
+	E* toArray(int start, int end) const override;
+	size_t copyTo(std::span<E> destination, size_t start) const override;
+	void reverse() override;
+
+	iterator begin() const noexcept;
+	iterator end() const noexcept;
+
+	/**
+	* Borrows the live storage of the graph, see Contiguous
+	* @return Returns a span over the targets of the arcs, vertex by vertex, invalidated by any change to the graph
+	*/
+	std::span<const E> view() const noexcept;
+
+protected:
+	//The structure is fixed once built
+	void grow() override;
+	void shrink() override;
+	void compress() override;
+
+	/**
+	* Equal graphs have the same vertices, and each vertex the same neighbors in the same order
+	*/
+	[[nodiscard]] bool equalsInternal(const DataEngine<E>& de) const override;
+
+	/**
+	* Equivalent graphs have the same vertices, and each vertex the same neighbors in any order
+	*/
+	[[nodiscard]] bool equivalenceInternal(const DataEngine<E>& de) const override;
+
+	/**
+	* Adds the arcs leaving the given vertices of the other graph to those of the invoking one, the new
+	* graph has as many vertices as the larger of the two
+	*/
+	[[nodiscard]] std::unique_ptr<DataEngine<E>> mergeInternal(const DataEngine<E>& de, int start, int end) const override;
+
+private:
+	/**
+	* Arcs a thread should at least get
+	*/
+	static constexpr size_t THREAD_WORK = size_t(1) << 16;
+
+	/**
+	* Vertices a thread claims at a time, a multiple of the 64 bits of a bitmap word so that no two
+	* threads write the same word
+	*/
+	static constexpr size_t CHUNK = 4096;
+
+	/**
+	* Frontier vertices a thread claims at a time in a top-down step
+	*/
+	static constexpr size_t FRONTIER_CHUNK = 64;
+
+	/**
+	* The search turns bottom up once the arcs leaving the frontier exceed the arcs left to check
+	* divided by ALPHA, and back top down once the frontier shrinks and holds fewer than the vertices
+	* divided by BETA
+	*/
+	static constexpr size_t ALPHA = 15;
+	static constexpr size_t BETA = 18;
+
+	/**
+	* Arcs of each vertex linked before looking for the largest component, and vertices sampled to find it
+	*/
+	static constexpr size_t SAMPLED_ARCS = 2;
+	static constexpr size_t SAMPLED_VERTICES = 1024;
+
+	size_t vertices;
+	bool directed;
+	bool weighted;
+	EngineVector<size_t, Allocator> offsets;
+	EngineVector<E, Allocator> targets;
+	EngineVector<float, Allocator> weights; //Empty for an unweighted graph
+	EngineVector<size_t, Allocator> reverseOffsets; //Empty for an undirected graph
+	EngineVector<E, Allocator> reverseTargets;
+	EngineVector<float, Allocator> reverseWeights;
+
+	/**
+	* Builds both forms of the graph from the edges
+	*/
+	template<typename Edge>
+	void build(const Edge* edges, size_t count, unsigned threads);
+
+	/**
+	* Builds one compressed sparse row form from the edges: from their sources to their targets, from
+	* their targets to their sources when reversed, or both ways when symmetric
+	*/
+	template<typename Edge>
+	static void build(size_t vertices, const Edge* edges, size_t count, bool reversed, bool symmetric,
+		unsigned threads, EngineVector<size_t, Allocator>& offsets, EngineVector<E, Allocator>& targets,
+		EngineVector<float, Allocator>& weights);
+
+	/**
+	* Turns counts stored one slot to the right into offsets, in place
+	*/
+	static void prefixSum(EngineVector<size_t, Allocator>& offsets, size_t count);
+
+	/**
+	* One top-down step, from the frontier queue to the next one
+	* @return Returns the number of arcs leaving the next frontier
+	*/
+	size_t topDown(std::vector<E>& parents, const std::vector<E>& frontier, std::vector<E>& next, size_t work, unsigned threads) const;
+
+	/**
+	* One bottom-up step, from the frontier bitmap to the next one
+	* @return Returns the number of vertices in the next frontier
+	*/
+	size_t bottomUp(std::vector<E>& parents, const std::vector<uint64_t>& frontier, std::vector<uint64_t>& next, unsigned threads) const;
+
+	/**
+	* Converts the frontier between its queue and bitmap forms
+	*/
+	void toBitmap(const std::vector<E>& frontier, std::vector<uint64_t>& bitmap, unsigned threads) const;
+	void toQueue(const std::vector<uint64_t>& bitmap, std::vector<E>& frontier, unsigned threads) const;
+
+	/**
+	* Joins the trees of two vertices, hanging the greater root under the smaller one
+	*/
+	static void link(std::vector<E>& labels, E first, E second) noexcept;
+
+	/**
+	* Points every vertex straight at the root of its tree
+	*/
+	void compressLabels(std::vector<E>& labels, unsigned threads) const;
+
+	/**
+	* Adds the time elapsed since the mark to the phase of the given name and moves the mark to now
+	*/
+	static void record(std::vector<GraphPhase>* phases, const char* name, std::chrono::steady_clock::time_point& mark);
+
+	/**
+	* @return Returns the number of threads worth using for the given work
+	*/
+	static size_t workers(unsigned threads, size_t work) noexcept { return parallelWorkers(threads, work, THREAD_WORK); }
+
+	/**
+	* Runs the producer for each worker index with a buffer of its own, then concatenates the buffers
+	* into the output in worker order
+	*/
+	template<typename Producer>
+	static void collect(size_t count, std::vector<E>& output, Producer&& producer);
+
+	//Static form of operator==, picked at compile time by ENGINE_STATIC_DISPATCH
+	[[nodiscard]] bool equalTo(const CSRGraph& other) const;
+
+	E_ENGINE_CLASS
+}
@@ -0,0 +1,242 @@
+#pragma once
+#include "../../Public/Abstraction/Matrix.h"
+#include "../../Public/Implementation/DenseMatrix.h"
+#include "../../Public/EngineParallel.h"
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace core {
+	template<typename E, typename Allocator>
+	class CSCMatrix;
+
+	/**
+	* A sparse Matrix implementation in compressed sparse row form. Only the stored elements are kept: their
+	* values and column indices row after row, with the row boundaries in an offset array of rows + 1
+	* entries, so the footprint is that of the stored elements plus one offset per row. Column indices
+	* are 32 bits wide to save memory bandwidth, limiting the number of columns to UINT32_MAX. Within a row
+	* the columns are strictly increasing, so an element is found by binary search.
+	*
+	* The size of the matrix and its array forms still count every element of the grid, the zeros
+	* included, as in any Matrix. Iteration only visits the stored elements. Replacing an element only
+	* succeeds where one is stored, the structure is fixed once built.
+	*
+	* Sparse matrix-vector products are split over threads along the merge path of the row boundaries
+	* and the stored elements, so that each thread gets the same share of rows plus elements even when a
+	* few rows hold most of the elements. A row cut between two threads is finished by adding the partial
+	* sum of the first one once both are done
+	*/
+	S_IMPLEMENTATION_CLASS(CSRMatrix, Matrix<E>, Nature::MUTABLE, Behavior::FIXED_LENGTH, Ordering::UNSORTED)
+	static_assert(std::is_arithmetic_v<E>, "CSRMatrix requires an arithmetic element type");
+	friend class CSCMatrix<E, Allocator>;
+
+	/**
+	* The stored elements are contiguous, row by row, iterators over them are plain pointers
+	*/
+	using iterator = E*;
+	using const_iterator = const E*;
+
+	/**
+	* Creates an empty matrix with no rows and no columns
+	*/
+	CSRMatrix();
+
+	/**
+	* Creates an empty matrix with no rows and no columns, which later draws its storage from the given allocator
+	* @param allocator Allocator of the storage
+	*/
+	explicit CSRMatrix(const Allocator& allocator);
+
+	/**
+	* Creates a matrix of the given size without any stored element
+	* @param rows Number of rows
+	* @param columns Number of columns
+	* @param allocator Allocator of the storage
+	* @throws std::length_error if there are more than UINT32_MAX columns
+	*/
+	CSRMatrix(size_t rows, size_t columns, const Allocator& allocator = Allocator());
+
+	/**
+	* Creates a matrix from elements in coordinate form, in any order. Elements given more than once at
+	* the same position are summed
+	* @param rows Number of rows
+	* @param columns Number of columns
+	* @param triplets The elements
+	* @param count Number of elements
+	* @param allocator Allocator of the storage
+	* @throws std::out_of_range if an element lies outside the matrix
+	* @throws std::length_error if there are more than UINT32_MAX columns
+	*/
+	CSRMatrix(size_t rows, size_t columns, const MatrixTriplet<E>* triplets, size_t count, const Allocator& allocator = Allocator());
+
+	/**
+	* Converts a matrix in compressed sparse column form, in time linear in its stored elements
+	* @param matrix The matrix to convert
+	*/
+	explicit CSRMatrix(const CSCMatrix<E, Allocator>& matrix);
+
+	~CSRMatrix() override = default;
+
+	//Adding move semantics
+	CSRMatrix(CSRMatrix&& other) noexcept;
+	CSRMatrix& operator=(CSRMatrix&& other) noexcept(takesStorageOnMove<Allocator>);
+
+	[[nodiscard]] size_t getRows() const override;
+	[[nodiscard]] size_t getColumns() const override;
+	[[nodiscard]] E get(size_t row, size_t column) const override;
+
+	/**
+	* @return Returns false if no element is stored at the position and the value is not zero
+	*/
+	bool set(size_t row, size_t column, E value) override;
+
+	/**
+	* @return Returns the number of stored elements
+	*/
+	[[nodiscard]] size_t getNonZeros() const noexcept { return values.size(); }
+
+	/**
+	* @return Returns the rows + 1 row boundaries, the elements of row i are at [offsets[i], offsets[i + 1])
+	*/
+	[[nodiscard]] const size_t* getOffsets() const noexcept { return offsets.data(); }
+
+	/**
+	* @return Returns the column of each stored element
+	*/
+	[[nodiscard]] const uint32_t* getIndices() const noexcept { return indices.data(); }
+
+	/**
+	* @return Returns the value of each stored element
+	*/
+	[[nodiscard]] const E* getValues() const noexcept { return values.data(); }
+
+	/**
+	* Visits the stored elements row by row
+	* @param visitor Function receiving the row, the column and the value of each element
+	*/
+	template<typename Visitor>
+	void forEach(Visitor&& visitor) const {
+		for (size_t row = 0; row < rows; row++) {
+			for (size_t index = offsets[row]; index < offsets[row + 1]; index++) {
+				visitor(row, static_cast<size_t>(indices[index]), values[index]);
+			}
+		}
+	}
+
+	/**
+	* Creates the transpose with a counting sort of the stored elements by column
+	* @return Returns the transposed matrix
+	*/
+	[[nodiscard]] CSRMatrix transpose() const;
+
+	/**
+	* Computes result = matrix * vector
+	* @param vector getColumns() elements
+	* @param result Receives getRows() elements, distinct from the vector
+	* @param threads Number of threads to split the work over, 0 for one per hardware thread
+	*/
+	void multiply(const E* vector, E* result, unsigned threads = 1) const;
+
+	/**
+	* Computes result = transpose(matrix) * vector without forming the transpose. Each thread scatters
+	* its share of the stored elements into a private copy of the result, the copies are summed at the end
+	* @param vector getRows() elements
+	* @param result Receives getColumns() elements, distinct from the vector
+	* @param threads Number of threads to split the work over, 0 for one per hardware thread
+	*/
+	void multiplyTransposed(const E* vector, E* result, unsigned threads = 1) const;
+
+	/**
+	* Multiplies the invoking matrix by a dense one. Each stored element adds a multiple of a row of the
+	* dense matrix to a row of the product, vector by vector. Threads get balanced ranges of rows
+	* @param dense Right hand side, with getColumns() rows
+	* @param threads Number of threads to split the work over, 0 for one per hardware thread
+	* @return Returns the product
+	* @throws std::invalid_argument if the sizes do not match
+	*/
+	[[nodiscard]] DenseMatrix<E, Allocator> multiply(const DenseMatrix<E, Allocator>& dense, unsigned threads = 1) const;
+
+	std::unique_ptr<DataEngine<E>> clone() const override;
+	std::unique_ptr<DataEngine<E>> move() override;
+
+	/**
+	* Releases the elements, leaving a matrix with no rows and no columns
+	*/
+	bool removeAll() override;
+
+	/**
+	* Expands the matrix, zeros included, row by row
+	*/
+	E* toArray() const override;
+	E* toArray(int start, int end) const override;
+	size_t copyTo(std::span<E> destination, size_t start) const override;
+
+	/**
+	* Reverses the elements in row-major order, i.e. rotates the matrix by half a turn
+	*/
+	void reverse() override;
+
+	iterator begin() noexcept;
+	iterator end() noexcept;
+	const_iterator begin() const noexcept;
+	const_iterator end() const noexcept;
+
+	/**
+	* Borrows the live storage of the matrix, see Contiguous
+	* @return Returns a span over the stored elements, row by row, invalidated by any change to the matrix
+	*/
+	std::span<E> view() noexcept;
+	std::span<const E> view() const noexcept;
+
+protected:
+	//The structure is fixed once built
+	void grow() override;
+	void shrink() override;
+	void compress() override;
+
+	[[nodiscard]] bool equalsInternal(const DataEngine<E>& de) const override;
+	[[nodiscard]] bool equivalenceInternal(const DataEngine<E>& de) const override;
+
+	/**
+	* Stacks the given rows of the other matrix under the invoking one, the column counts must match
+	*/
+	[[nodiscard]] std::unique_ptr<DataEngine<E>> mergeInternal(const DataEngine<E>& de, int start, int end) const override;
+
+private:
+	/**
+	* Stored elements a thread should at least get
+	*/
+	static constexpr size_t THREAD_WORK = size_t(1) << 16;
+
+	size_t rows;
+	size_t columns;
+	EngineVector<size_t, Allocator> offsets;
+	EngineVector<uint32_t, Allocator> indices;
+	EngineVector<E, Allocator> values;
+
+	/**
+	* Builds the structure from elements in coordinate form, swapping rows and columns if asked
+	*/
+	void build(const MatrixTriplet<E>* triplets, size_t count, bool swap);
+
+	/**
+	* @return Returns the row and the stored element at which a diagonal crosses the merge path of the row
+	* boundaries and the stored elements
+	*/
+	std::pair<size_t, size_t> mergePath(size_t diagonal) const noexcept;
+
+	/**
+	* Visits the non-zero elements of any matrix within a range of rows, through its stored elements when
+	* it is sparse and element by element otherwise
+	*/
+	template<typename Visitor>
+	static void visitNonZeros(const Matrix<E>& matrix, size_t rowBegin, size_t rowEnd, Visitor&& visitor);
+
+	/**
+	* Adds scale * source to target over the given number of elements
+	*/
+	static void addScaled(E* target, const E* source, E scale, size_t count) noexcept;
+	E_ENGINE_CLASS
+}
@@ -0,0 +1,184 @@
+#pragma once
+#include "../../Public/Abstraction/Queue.h"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <new>
+
+namespace core {
+
+	/**
+	* A bounded, lock-free, multi-producer multi-consumer Queue implementation. Every slot of the ring
+	* carries a sequence number telling producers and consumers whose turn it is, so that the only shared
+	* writes are one CAS on the enqueue or dequeue position per operation. Both positions live on their
+	* own cache line. Batch operations claim a whole run of positions with a single CAS.
+	*
+	* The capacity is fixed at construction and rounded up to a power of two. enqueue/dequeue never block,
+	* put/take spin with backoff until they succeed. Operations that observe the whole queue (clone,
+	* toArray, iteration, equality, merge) and sort/reverse are only consistent when no other thread is
+	* using the queue
+	*/
+	S_IMPLEMENTATION_CLASS(ConcurrentArrayQueue, Queue<E>, Nature::THREAD_MUTABLE, Behavior::FIXED_LENGTH, Ordering::UNSORTED)
+
+	/**
+	* A slot of the ring. Its sequence equals the position that may write it next, or that position plus
+	* one once the item is published
+	*/
+	struct Cell {
+		std::atomic<size_t> sequence;
+		alignas(E) unsigned char storage[sizeof(E)];
+
+		E* item() noexcept { return std::launder(reinterpret_cast<E*>(storage)); }
+	};
+
+	/**
+	* Iterator over the queued items from head to tail, only valid while the queue is quiescent
+	* @tparam T E, or const E for the iterators of a const queue
+	*/
+	template<typename T>
+	class ConcurrentArrayQueueIterator : public Iterator<ConcurrentArrayQueueIterator<T>, T, std::bidirectional_iterator_tag> {
+		Cell* cells = nullptr;
+		size_t mask = 0;
+		size_t position = 0;
+	public:
+		ConcurrentArrayQueueIterator() = default;
+		ConcurrentArrayQueueIterator(Cell* cells, size_t mask, size_t position) : cells(cells), mask(mask), position(position) {}
+
+		T& operator*() const { return *cells[position & mask].item(); }
+		T* operator->() const { return cells[position & mask].item(); }
+
+		ConcurrentArrayQueueIterator& operator++() { ++position; return *this; }
+		ConcurrentArrayQueueIterator& operator--() { --position; return *this; }
+
+		bool operator==(const ConcurrentArrayQueueIterator& other) const { return position == other.position; }
+	};
+
+	using iterator = ConcurrentArrayQueueIterator<E>;
+	using const_iterator = ConcurrentArrayQueueIterator<const E>;
+
+	/**
+	* Creates an empty queue with DEFAULT_CAPACITY
+	*/
+	ConcurrentArrayQueue();
+
+	/**
+	* Creates an empty queue with DEFAULT_CAPACITY drawing its ring from the given allocator
+	* @param allocator Allocator of the ring
+	*/
+	explicit ConcurrentArrayQueue(const Allocator& allocator);
+
+	/**
+	* Creates an empty queue holding at most the given number of items, rounded up to a power of two
+	* @param capacity Maximum number of items
+	* @param allocator Allocator of the ring
+	*/
+	explicit ConcurrentArrayQueue(size_t capacity, const Allocator& allocator = Allocator());
+
+	~ConcurrentArrayQueue() override;
+
+	bool enqueue(E item) override;
+	bool dequeue(E& item) override;
+
+	/**
+	* Adds as many of the given items as fit to the tail of the queue without blocking. The batch stops at
+	* the first slot still being emptied by a consumer. All the accepted items are claimed with a single
+	* atomic operation and stay contiguous in the queue
+	* @param items The items to be added
+	* @param count Number of items
+	* @return Returns the number of items added, which is a prefix of the given items
+	*/
+	size_t enqueue(const E* items, size_t count);
+
+	/**
+	* Removes up to the given number of items from the head of the queue without blocking. The batch stops
+	* at the first slot a producer has claimed but not published yet, so fewer items than are queued may
+	* be removed. All the removed items are claimed with a single atomic operation
+	* @param items Receives the removed items
+	* @param count Maximum number of items
+	* @return Returns the number of items removed
+	*/
+	size_t dequeue(E* items, size_t count);
+
+	/**
+	* Adds the item to the tail of the queue, waiting while the queue is full
+	* @param item The item to be added
+	*/
+	void put(E item);
+
+	/**
+	* Adds all the given items to the tail of the queue, waiting while the queue is full. Items are
+	* added in batches, so items of other producers may be interleaved between batches
+	* @param items The items to be added
+	* @param count Number of items
+	*/
+	void putAll(const E* items, size_t count);
+
+	/**
+	* Removes the item at the head of the queue, waiting while the queue is empty
+	* @return Returns the removed item
+	*/
+	[[nodiscard]] E take();
+
+	/**
+	* @return Returns the number of queued items at some instant during the call
+	*/
+	[[nodiscard]] size_t getActiveSize() const override;
+
+	/**
+	* Sorts the queued items through ParallelSort. Items are drained, sorted and put back, so nothing
+	* is lost under concurrency but the order only holds when no other thread is using the queue.
+	* Types without a total order keep their order
+	*/
+	void sort() override;
+
+	std::unique_ptr<DataEngine<E>> clone() const override;
+	std::unique_ptr<DataEngine<E>> move() override;
+
+	bool removeAll() override;
+	E* toArray() const override;
+	E* toArray(int start, int end) const override;
+	size_t copyTo(std::span<E> destination, size_t start) const override;
+	void reverse() override;
+
+	iterator begin();
+	iterator end();
+	const_iterator begin() const;
+	const_iterator end() const;
+
+protected:
+	//The capacity is fixed, grow, shrink and compress leave the ring untouched
+	void grow() override;
+	void shrink() override;
+	void compress() override;
+
+	[[nodiscard]] bool equalsInternal(const DataEngine<E>& de) const override;
+	[[nodiscard]] bool equivalenceInternal(const DataEngine<E>& de) const override;
+	[[nodiscard]] std::unique_ptr<DataEngine<E>> mergeInternal(const DataEngine<E>& de, int start, int end) const override;
+
+private:
+	/**
+	* Unit in which the ring is obtained from the allocator, so that the cells start on a cache line
+	*/
+	static constexpr size_t RING_ALIGNMENT = std::max(alignof(Cell), DataEngine<E>::CACHE_LINE_SIZE);
+	struct alignas(RING_ALIGNMENT) RingLine {
+		unsigned char bytes[RING_ALIGNMENT];
+	};
+
+	Cell* cells;
+	size_t mask;
+
+	alignas(DataEngine<E>::CACHE_LINE_SIZE) std::atomic<size_t> enqueuePosition;
+	alignas(DataEngine<E>::CACHE_LINE_SIZE) std::atomic<size_t> dequeuePosition;
+
+	//Keeps the members of subclasses off the dequeue position's line
+	char padding[DataEngine<E>::CACHE_LINE_SIZE - sizeof(std::atomic<size_t>)];
+
+	/**
+	* Copies the queued items in order into initialized storage, only valid while quiescent
+	* @param destination Destination storage
+	* @param start Starting position counted from the head
+	* @param end Endpoint position counted from the head
+	*/
+	void copyOut(E* destination, size_t start, size_t end) const;
+	E_ENGINE_CLASS
+}
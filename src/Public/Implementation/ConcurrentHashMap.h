@@ -0,0 +1,317 @@
+#pragma once
+#include "../../Public/Abstraction/Map.h"
+#include "../../Public/EngineEpoch.h"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace core {
+
+	/**
+	* A concurrent, separately chained Map implementation for read-heavy workloads. Reads are lock-free:
+	* they walk immutable nodes under an epoch pin and never write shared memory besides their own reader
+	* slot. Writers lock one of STRIPES cache-line sized spin locks, chosen by the low bits of the hash, and
+	* replace nodes instead of mutating them, so a reader always sees a complete entry. Unlinked nodes are
+	* retired to an EpochDomain and freed once no reader can reach them.
+	*
+	* Resizing is incremental. Crossing a load factor installs the next table, after which every writer
+	* migrates a chunk of MIGRATION_CHUNK buckets before its own operation, and a migrated bucket forwards
+	* readers and writers to the next table. Bucket counts stay powers of two not below STRIPES, so a bucket
+	* and all the buckets it migrates to share one stripe lock.
+	*
+	* clone, toArray, equality and merge take every stripe lock and see an exact snapshot, readers are
+	* never blocked. containsValue and iteration are weakly consistent, and move requires that no other
+	* thread uses the map
+	*/
+	S_MAP_IMPLEMENTATION_CLASS(ConcurrentHashMap, Map, Nature::THREAD_MUTABLE, Behavior::DYNAMIC, Ordering::UNSORTED)
+
+	/**
+	* An immutable entry of a chain, only the link to the next node changes after publication
+	*/
+	struct Node {
+		const size_t hash;
+		E entry;
+		std::atomic<Node*> next;
+	};
+
+	/**
+	* A bucket array. While it is being migrated, next points to the table replacing it
+	*/
+	struct Table {
+		const size_t capacity;
+		const size_t mask;
+		std::atomic<Node*>* buckets;
+		std::atomic<Table*> next{ nullptr };
+		std::atomic<size_t> transferIndex{ 0 }; //Next bucket to be claimed for migration
+		std::atomic<size_t> transferred{ 0 }; //Buckets migrated so far
+
+		Table(size_t capacity, std::atomic<Node*>* buckets) : capacity(capacity), mask(capacity - 1), buckets(buckets) {}
+	};
+
+	/**
+	* Weakly consistent iterator over the entries of every live table, only safe while no thread writes
+	* @tparam T E, or const E for the iterators of a const map
+	*/
+	template<typename T>
+	class ConcurrentHashMapIterator : public Iterator<ConcurrentHashMapIterator<T>, T> {
+		Table* table = nullptr;
+		size_t bucket = 0;
+		Node* node = nullptr;
+
+		void settle() {
+			while (table != nullptr && node == nullptr) {
+				if (++bucket == table->capacity) {
+					table = table->next.load(std::memory_order_acquire);
+					bucket = 0;
+					if (table == nullptr) {
+						return;
+					}
+				}
+				node = chain(table->buckets[bucket]);
+			}
+		}
+	public:
+		ConcurrentHashMapIterator() = default;
+		explicit ConcurrentHashMapIterator(Table* table) : table(table), bucket(0),
+			node(table == nullptr ? nullptr : chain(table->buckets[0])) { settle(); }
+
+		T& operator*() const { return node->entry; }
+		T* operator->() const { return &node->entry; }
+
+		ConcurrentHashMapIterator& operator++() { node = node->next.load(std::memory_order_acquire); settle(); return *this; }
+
+		bool operator==(const ConcurrentHashMapIterator& other) const { return node == other.node; }
+	};
+
+	using iterator = ConcurrentHashMapIterator<E>;
+	using const_iterator = ConcurrentHashMapIterator<const E>;
+
+	/**
+	* Creates an empty map with the minimum capacity
+	*/
+	ConcurrentHashMap();
+
+	/**
+	* Creates an empty map with the minimum capacity drawing its tables and nodes from the given allocator
+	* @param allocator Allocator of the tables and nodes
+	*/
+	explicit ConcurrentHashMap(const Allocator& allocator);
+
+	/**
+	* Creates an empty map able to hold the given number of entries before resizing
+	* @param capacity Initial capacity
+	* @param allocator Allocator of the tables and nodes
+	*/
+	explicit ConcurrentHashMap(size_t capacity, const Allocator& allocator = Allocator());
+
+	~ConcurrentHashMap() override;
+
+	bool put(K key, V value) override;
+
+	/**
+	* Lock-free. The value is copied while the node is pinned
+	*/
+	[[nodiscard]] bool get(const K& key, V& value) const override;
+	bool remove(const K& key) override;
+
+	/**
+	* Lock-free
+	*/
+	[[nodiscard]] bool containsKey(const K& key) override;
+
+	/**
+	* Lock-free and weakly consistent, entries added or removed during the scan may be missed
+	*/
+	[[nodiscard]] bool containsValue(const V& value) override;
+
+	/**
+	* Associates the value with the key only if the key is not present, as a single atomic step
+	* @param key The key
+	* @param value The value
+	* @return Returns true if the entry was added, false if the key was already present
+	*/
+	bool putIfAbsent(K key, V value);
+
+	/**
+	* @return Returns the number of entries at some instant during the call
+	*/
+	[[nodiscard]] size_t getActiveSize() const override;
+
+	/**
+	* Entries are unordered, sorting leaves the map untouched
+	*/
+	void sort() override;
+
+	std::unique_ptr<DataEngine<E>> clone() const override;
+	std::unique_ptr<DataEngine<E>> move() override;
+
+	bool removeAll() override;
+	E* toArray() const override;
+	E* toArray(int start, int end) const override;
+	size_t copyTo(std::span<E> destination, size_t start) const override;
+
+	/**
+	* Entries are unordered, reversing leaves the map untouched
+	*/
+	void reverse() override;
+
+	iterator begin();
+	iterator end();
+	const_iterator begin() const;
+	const_iterator end() const;
+
+protected:
+	//Each hook only installs the next table, writers carry out the migration
+	void grow() override;
+	void shrink() override;
+	void compress() override;
+
+	[[nodiscard]] bool equalsInternal(const DataEngine<E>& de) const override;
+	[[nodiscard]] bool equivalenceInternal(const DataEngine<E>& de) const override;
+	[[nodiscard]] std::unique_ptr<DataEngine<E>> mergeInternal(const DataEngine<E>& de, int start, int end) const override;
+
+private:
+	static constexpr size_t STRIPES = 64;
+	static constexpr size_t MIGRATION_CHUNK = 16;
+
+	/**
+	* Marks a migrated bucket, never dereferenced
+	*/
+	static inline Node* const FORWARD = reinterpret_cast<Node*>(std::uintptr_t{ 1 });
+
+	/**
+	* A stripe lock together with the number of entries in the buckets it guards
+	*/
+	struct alignas(DataEngine<E>::CACHE_LINE_SIZE) Stripe {
+		std::atomic<bool> locked{ false };
+		std::atomic<size_t> count{ 0 }; //Written under the lock only
+	};
+
+	alignas(DataEngine<E>::CACHE_LINE_SIZE) std::atomic<Table*> table;
+	mutable Stripe stripes[STRIPES];
+	mutable EpochDomain domain;
+
+	/**
+	* Spreads the hash so that both the stripe and the bucket bits are well mixed, even for identity hashes
+	*/
+	static size_t hash(const K& key) noexcept {
+		uint64_t h = static_cast<uint64_t>(std::hash<K>{}(key)) * 0x9E3779B97F4A7C15ull;
+		return static_cast<size_t>(h ^ (h >> 32));
+	}
+
+	/**
+	* @return Returns the head of the bucket, nullptr if the bucket was migrated
+	*/
+	static Node* chain(const std::atomic<Node*>& bucket) noexcept {
+		Node* head = bucket.load(std::memory_order_acquire);
+		return head == FORWARD ? nullptr : head;
+	}
+
+	/**
+	* @return Returns a table of the given capacity with empty buckets
+	*/
+	Table* allocateTable(size_t capacity) const;
+
+	/**
+	* Frees a table and its buckets, not the nodes they hold. Static so that it can serve as a deleter of
+	* the domain with the allocator as context
+	*/
+	static void deallocateTable(const Allocator& allocator, Table* released) noexcept;
+
+	static void lock(Stripe& stripe) noexcept;
+	static void unlock(Stripe& stripe) noexcept;
+	void lockAll() const noexcept;
+	void unlockAll() const noexcept;
+
+	/**
+	* Scoped hold of a stripe lock, unlock releases it before the end of the scope
+	*/
+	class StripeGuard {
+		Stripe* stripe;
+	public:
+		explicit StripeGuard(Stripe& stripe) noexcept : stripe(&stripe) {
+			lock(stripe);
+		}
+		~StripeGuard() {
+			unlock();
+		}
+
+		StripeGuard(const StripeGuard&) = delete;
+		StripeGuard& operator=(const StripeGuard&) = delete;
+
+		void unlock() noexcept {
+			if (stripe != nullptr) {
+				ConcurrentHashMap::unlock(*stripe);
+				stripe = nullptr;
+			}
+		}
+	};
+
+	/**
+	* Scoped hold of every stripe lock
+	*/
+	class StripesGuard {
+		const ConcurrentHashMap* map;
+	public:
+		explicit StripesGuard(const ConcurrentHashMap* map) noexcept : map(map) {
+			map->lockAll();
+		}
+		~StripesGuard() {
+			map->unlockAll();
+		}
+
+		StripesGuard(const StripesGuard&) = delete;
+		StripesGuard& operator=(const StripesGuard&) = delete;
+	};
+
+	/**
+	* Lock-free lookup, the caller must be pinned
+	* @return Returns the node holding the key, nullptr if the key is not present
+	*/
+	Node* locate(const K& key, size_t hash) const;
+
+	/**
+	* Follows forwarded buckets to the table owning the hash, the stripe of the hash must be locked
+	*/
+	Table* owner(size_t hash) const;
+
+	/**
+	* Shared body of put and putIfAbsent
+	*/
+	bool insert(K key, V value, bool replace);
+
+	/**
+	* Migrates the next unclaimed chunk of buckets if a resize is running, the caller must be pinned
+	*/
+	void helpResize();
+
+	/**
+	* Copies the chain of a bucket into the next table and forwards the bucket, its stripe must be locked
+	*/
+	void migrate(Table* from, Table* to, size_t bucket);
+
+	/**
+	* Installs a table of the given capacity after the current one, unless a resize is already running
+	*/
+	void resize(Table* current, size_t capacity);
+
+	/**
+	* Starts a resize when the stripe count suggests that the map crossed a load factor and the total
+	* confirms it. Summing every stripe is only paid once the cheap check fires
+	*/
+	void checkLoad(size_t count);
+
+	/**
+	* Collects every entry under all stripe locks
+	*/
+	std::vector<E> snapshot() const;
+
+	/**
+	* @return Returns the power of two bucket count holding the given number of entries under
+	* GROWTH_LOAD_FACTOR, at least STRIPES
+	*/
+	static size_t capacityFor(size_t entries) noexcept;
+	E_ENGINE_CLASS
+}
@@ -0,0 +1,248 @@
+#pragma once
+#include "../../Public/Abstraction/SkipList.h"
+#include "../../Public/EngineEpoch.h"
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace core {
+
+	/**
+	* A lock-free SkipList implementation after Fraser and Herlihy-Shavit. Every operation is lock-free:
+	* insertion links a node bottom-up with one CAS per level, and the bottom-level link is the point at
+	* which the key becomes visible. Removal is logical, then physical: the remover marks the links of the
+	* node top-down, the thread that marks the bottom link owns the removal, and marked nodes are snipped
+	* out by any writer that walks past them. Lookups and scans never write shared memory and skip marked
+	* nodes.
+	*
+	* Values live behind their own pointer, so replacing a value is a single exchange and readers copy a
+	* complete value. Unlinked nodes and replaced values are retired to an EpochDomain, a node only once
+	* both its inserter and its remover are done with it, so no level can still reach it. Node heights
+	* follow a geometric distribution with p = 1/4, capped at MAX_HEIGHT.
+	*
+	* Scans and iteration are weakly consistent, a long scan holds back reclamation for its duration.
+	* move requires that no other thread uses the skip list
+	*/
+	S_MAP_IMPLEMENTATION_CLASS(ConcurrentSkipList, SkipList, Nature::THREAD_MUTABLE, Behavior::DYNAMIC, Ordering::SORTED)
+	static_assert(std::totally_ordered<K>, "ConcurrentSkipList requires totally ordered keys");
+
+	/**
+	* A node of the list. Its links are allocated right after it, one per level, and the low bit of a
+	* link marks the node as removed at that level
+	*/
+	struct alignas(std::atomic<uintptr_t>) Node {
+		const K key;
+		std::atomic<V*> value;
+		const int height;
+		std::atomic<int> claims; //Inserter and remover, the last one to let go retires the node
+
+		Node(K key, V* value, int height) : key(std::move(key)), value(value), height(height), claims(2) {}
+
+		std::atomic<uintptr_t>* links() noexcept { return reinterpret_cast<std::atomic<uintptr_t>*>(this + 1); }
+	};
+
+	/**
+	* Weakly consistent iterator over the entries in ascending key order, only safe while no thread writes.
+	* Values are swapped as a whole, so entries are assembled and returned by value
+	*/
+	class ConcurrentSkipListIterator : public Iterator<ConcurrentSkipListIterator, const E> {
+		Node* node = nullptr;
+	public:
+		using reference = E;
+		using pointer = void;
+
+		ConcurrentSkipListIterator() = default;
+		explicit ConcurrentSkipListIterator(Node* node) : node(node) {}
+
+		E operator*() const { return E{ node->key, *node->value.load(std::memory_order_acquire) }; }
+
+		ConcurrentSkipListIterator& operator++() { node = skip(node->links()[0].load(std::memory_order_acquire), 0); return *this; }
+
+		bool operator==(const ConcurrentSkipListIterator& other) const { return node == other.node; }
+	};
+
+	/**
+	* Creates an empty skip list
+	*/
+	ConcurrentSkipList();
+
+	/**
+	* Creates an empty skip list drawing its nodes and values from the given allocator
+	* @param allocator Allocator of the nodes and values
+	*/
+	explicit ConcurrentSkipList(const Allocator& allocator);
+
+	~ConcurrentSkipList() override;
+
+	bool put(K key, V value) override;
+
+	/**
+	* Lock-free. The value is copied while the node is pinned
+	*/
+	[[nodiscard]] bool get(const K& key, V& value) const override;
+	bool remove(const K& key) override;
+	[[nodiscard]] bool containsKey(const K& key) override;
+
+	/**
+	* Weakly consistent, entries added or removed during the scan may be missed
+	*/
+	[[nodiscard]] bool containsValue(const V& value) override;
+
+	[[nodiscard]] bool first(E& entry) override;
+	[[nodiscard]] bool last(E& entry) override;
+	[[nodiscard]] bool ceiling(const K& key, E& entry) override;
+	[[nodiscard]] bool floor(const K& key, E& entry) override;
+
+	/**
+	* Weakly consistent, every entry present for the whole scan is visited exactly once and in order
+	*/
+	size_t scan(const K& from, std::function<bool(const E&)> visitor) override;
+
+	/**
+	* Associates the value with the key only if the key is not present, as a single atomic step
+	* @param key The key
+	* @param value The value
+	* @return Returns true if the entry was added, false if the key was already present
+	*/
+	bool putIfAbsent(K key, V value);
+
+	/**
+	* @return Returns the number of entries at some instant during the call
+	*/
+	[[nodiscard]] size_t getActiveSize() const override;
+
+	/**
+	* Entries are always sorted by key, sorting leaves the list untouched
+	*/
+	void sort() override;
+
+	std::unique_ptr<DataEngine<E>> clone() const override;
+	std::unique_ptr<DataEngine<E>> move() override;
+
+	bool removeAll() override;
+	E* toArray() const override;
+	E* toArray(int start, int end) const override;
+	size_t copyTo(std::span<E> destination, size_t start) const override;
+
+	/**
+	* The order is fixed by the keys, reversing leaves the list untouched
+	*/
+	void reverse() override;
+
+	ConcurrentSkipListIterator begin() const;
+	ConcurrentSkipListIterator end() const;
+
+protected:
+	//Nodes are allocated one at a time, there is no capacity to manage
+	void grow() override;
+	void shrink() override;
+	void compress() override;
+
+	[[nodiscard]] bool equalsInternal(const DataEngine<E>& de) const override;
+	[[nodiscard]] bool equivalenceInternal(const DataEngine<E>& de) const override;
+	[[nodiscard]] std::unique_ptr<DataEngine<E>> mergeInternal(const DataEngine<E>& de, int start, int end) const override;
+
+private:
+	static constexpr int MAX_HEIGHT = 16;
+	static constexpr size_t COUNTERS = 16;
+	static constexpr uintptr_t MARK = 1;
+
+	/**
+	* A share of the entry count, updated by the threads that map to it
+	*/
+	struct alignas(DataEngine<E>::CACHE_LINE_SIZE) Counter {
+		std::atomic<std::ptrdiff_t> value{ 0 };
+	};
+
+	mutable std::atomic<uintptr_t> head[MAX_HEIGHT]; //Links of the head, which is never marked
+	Counter counters[COUNTERS];
+	mutable EpochDomain domain;
+
+	static Node* pointer(uintptr_t link) noexcept { return reinterpret_cast<Node*>(link & ~MARK); }
+	static bool marked(uintptr_t link) noexcept { return (link & MARK) != 0; }
+
+	/**
+	* @return Returns the first node after the given one, or after the head if it is nullptr, that is not
+	* marked at the level
+	*/
+	Node* successor(Node* node, int level) const noexcept;
+
+	/**
+	* @return Returns the first node from the link on that is not marked at the level
+	*/
+	static Node* skip(uintptr_t link, int level) noexcept;
+
+	/**
+	* Storage unit of the nodes, a node and its links span a whole number of units
+	*/
+	struct alignas(Node) NodeUnit {
+		std::byte bytes[alignof(Node)];
+	};
+
+	/**
+	* @return Returns the number of units spanned by a node of the given height
+	*/
+	static size_t units(int height) noexcept {
+		return (sizeof(Node) + height * sizeof(std::atomic<uintptr_t>) + sizeof(NodeUnit) - 1) / sizeof(NodeUnit);
+	}
+
+	Node* allocate(K key, V value, int height) const;
+
+	/**
+	* Frees a node together with its value. Static so that it can serve as a deleter of the domain with
+	* the allocator as context
+	*/
+	static void deallocate(const Allocator& allocator, Node* node) noexcept;
+
+	/**
+	* Draws a height from the geometric distribution, using a per thread generator
+	*/
+	static int randomHeight() noexcept;
+
+	/**
+	* Locates the neighbours of the key at every level, snipping the marked nodes it walks past. The caller
+	* must be pinned
+	* @param key The key to be searched
+	* @param predecessors Receives, per level, the link pointing to the first node not less than the key
+	* @param successors Receives, per level, that node
+	* @return Returns true if the bottom successor holds the key
+	*/
+	bool find(const K& key, std::atomic<uintptr_t>** predecessors, Node** successors);
+
+	/**
+	* Read-only search that skips marked nodes. The caller must be pinned
+	* @param key The key to be searched
+	* @param predecessor Receives the last bottom-level node less than the key, nullptr if there is none
+	* @return Returns the first bottom-level node not less than the key, nullptr if there is none
+	*/
+	Node* lowerBound(const K& key, Node** predecessor) const;
+
+	/**
+	* Shared body of put and putIfAbsent
+	*/
+	bool insert(K key, V value, bool replace);
+
+	/**
+	* Drops one claim on the node and retires it once both claims are gone
+	*/
+	void release(Node* node);
+
+	/**
+	* Adds to the share of the entry count of the calling thread
+	*/
+	void count(std::ptrdiff_t delta) noexcept;
+
+	/**
+	* Collects every entry in key order, weakly consistent
+	*/
+	std::vector<E> snapshot() const;
+
+	/**
+	* Copies the entry of the node, the caller must be pinned
+	*/
+	static E read(Node* node) { return E{ node->key, *node->value.load(std::memory_order_acquire) }; }
+	E_ENGINE_CLASS
+}
@@ -0,0 +1,314 @@
+#pragma once
+#include "../../Public/Abstraction/Matrix.h"
+#include "../../Public/EngineParallel.h"
+#include "../../Public/Implementation/MatrixExpression.h"
+#include <algorithm>
+#include <concepts>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace core {
+
+	/**
+	* A dense Matrix implementation storing the elements row by row in a single block aligned to
+	* ALIGNMENT bytes. Each row is padded to a whole number of ALIGNMENT byte lines, so that every row
+	* starts on a line of its own and vector loads along a row never split one. The padding is kept at zero.
+	*
+	* Multiplication follows the layered scheme of high performance GEMM libraries: the product is computed
+	* a panel of COLUMN_BLOCK columns, a slice of DEPTH_BLOCK and a panel of ROW_BLOCK rows at a time, sized
+	* for the last level, second level and first level caches respectively. Each panel is first packed into
+	* contiguous, aligned micro-panels in the order the kernel reads them, and the kernel keeps a block of
+	* KERNEL_ROWS by KERNEL_COLUMNS elements of the product in vector registers while streaming through the
+	* micro-panels with fused multiply-adds. The kernel uses AVX-512 or AVX2 with FMA when the build targets
+	* them and SSE2 otherwise. Products can be split over several threads, each computing its own block of
+	* the result with its own packing buffers
+	*/
+	S_IMPLEMENTATION_CLASS(DenseMatrix, Matrix<E>, Nature::MUTABLE, Behavior::FIXED_LENGTH, Ordering::UNSORTED)
+	static_assert(std::is_arithmetic_v<E>, "DenseMatrix requires an arithmetic element type");
+
+	/**
+	* Iterator over the elements row by row, skipping the padding
+	* @tparam T E, or const E for the iterators of a const matrix
+	*/
+	template<typename T>
+	class DenseMatrixIterator : public Iterator<DenseMatrixIterator<T>, T, std::bidirectional_iterator_tag> {
+		T* row = nullptr;
+		size_t column = 0;
+		size_t columns = 0;
+		size_t stride = 0;
+	public:
+		DenseMatrixIterator() = default;
+		DenseMatrixIterator(T* row, size_t columns, size_t stride) : row(row), column(0), columns(columns), stride(stride) {}
+
+		T& operator*() const { return row[column]; }
+		T* operator->() const { return row + column; }
+
+		DenseMatrixIterator& operator++() {
+			if (++column == columns) {
+				row += stride;
+				column = 0;
+			}
+			return *this;
+		}
+
+		DenseMatrixIterator& operator--() {
+			if (column == 0) {
+				row -= stride;
+				column = columns;
+			}
+			--column;
+			return *this;
+		}
+
+		bool operator==(const DenseMatrixIterator& other) const { return row == other.row && column == other.column; }
+	};
+
+	using iterator = DenseMatrixIterator<E>;
+	using const_iterator = DenseMatrixIterator<const E>;
+
+	/**
+	* Creates an empty matrix with no rows and no columns
+	*/
+	DenseMatrix();
+
+	/**
+	* Creates an empty matrix with no rows and no columns, which later draws its elements from the given allocator
+	* @param allocator Allocator of the elements
+	*/
+	explicit DenseMatrix(const Allocator& allocator);
+
+	/**
+	* Creates a matrix of the given size filled with zeros
+	* @param rows Number of rows
+	* @param columns Number of columns
+	* @param allocator Allocator of the elements
+	*/
+	DenseMatrix(size_t rows, size_t columns, const Allocator& allocator = Allocator());
+
+	/**
+	* Creates a matrix of the given size from elements listed row by row
+	* @param rows Number of rows
+	* @param columns Number of columns
+	* @param values rows * columns elements, row by row without padding
+	* @param allocator Allocator of the elements
+	*/
+	DenseMatrix(size_t rows, size_t columns, const E* values, const Allocator& allocator = Allocator());
+
+	/**
+	* Evaluates a matrix expression into a new matrix of its size, in a single pass
+	* @param expression Expression built from element-wise operations on matrices
+	* @param allocator Allocator of the elements
+	*/
+	template<MatrixExpression Expression> requires std::same_as<typename Expression::Element, E>
+	DenseMatrix(const Expression& expression, const Allocator& allocator = Allocator());
+
+	~DenseMatrix() override;
+
+	//Adding move semantics
+	DenseMatrix(DenseMatrix&& other) noexcept;
+	DenseMatrix& operator=(DenseMatrix&& other) noexcept(takesStorageOnMove<Allocator>);
+
+	/**
+	* Evaluates a matrix expression into the invoking matrix in a single pass, without temporaries. The
+	* evaluation is done in place when the expression reads the invoking matrix only at the positions
+	* being written. An expression of another size, or one that reads the invoking matrix elsewhere, such
+	* as through its transpose, is evaluated into a new matrix which then replaces the invoking one
+	* @param expression Expression built from element-wise operations on matrices
+	* @return Returns the invoking matrix
+	*/
+	template<MatrixExpression Expression> requires std::same_as<typename Expression::Element, E>
+	DenseMatrix& operator=(const Expression& expression);
+
+	//Compound assignments, evaluated like the expressions they stand for
+	template<typename Operand> requires MatrixOperands<DenseMatrix, Operand>
+	DenseMatrix& operator+=(const Operand& operand) { return *this = *this + operand; }
+	template<typename Operand> requires MatrixOperands<DenseMatrix, Operand>
+	DenseMatrix& operator-=(const Operand& operand) { return *this = *this - operand; }
+	DenseMatrix& operator*=(E scalar) { return *this = *this * scalar; }
+	DenseMatrix& operator/=(E scalar) { return *this = *this / scalar; }
+
+	[[nodiscard]] size_t getRows() const override;
+	[[nodiscard]] size_t getColumns() const override;
+	[[nodiscard]] E get(size_t row, size_t column) const override;
+	bool set(size_t row, size_t column, E value) override;
+
+	/**
+	* Unchecked access to an element
+	* @param row Row of the element
+	* @param column Column of the element
+	* @return Returns a reference to the element
+	*/
+	E& operator()(size_t row, size_t column) noexcept { return values[row * stride + column]; }
+	const E& operator()(size_t row, size_t column) const noexcept { return values[row * stride + column]; }
+
+	/**
+	* @param row Row index, unchecked
+	* @return Returns the first element of the row, aligned to ALIGNMENT bytes
+	*/
+	E* getRow(size_t row) noexcept { return values + row * stride; }
+	const E* getRow(size_t row) const noexcept { return values + row * stride; }
+
+	/**
+	* @return Returns the distance in elements between the starts of two consecutive rows
+	*/
+	[[nodiscard]] size_t getStride() const noexcept { return stride; }
+
+	/**
+	* Sets every element to the given value
+	* @param value The value
+	*/
+	void fill(E value);
+
+	/**
+	* Creates the transpose, copying square tiles so that both matrices are walked a cache line at a time
+	* @return Returns the transposed matrix
+	*/
+	[[nodiscard]] DenseMatrix transpose() const;
+
+	/**
+	* Multiplies the invoking matrix by the given one
+	* @param other Right hand side, with as many rows as the invoking matrix has columns
+	* @param threads Number of threads to split the work over, 0 for one per hardware thread
+	* @return Returns the product
+	* @throws std::invalid_argument if the sizes do not match
+	*/
+	[[nodiscard]] DenseMatrix multiply(const DenseMatrix& other, unsigned threads = 1) const;
+
+	/**
+	* Computes result = left * right, overwriting the result
+	* @param left Left hand side
+	* @param right Right hand side, with as many rows as left has columns
+	* @param result Matrix with the rows of left and the columns of right, distinct from both
+	* @param threads Number of threads to split the work over, 0 for one per hardware thread
+	* @throws std::invalid_argument if the sizes do not match or the result is one of the operands
+	*/
+	static void multiply(const DenseMatrix& left, const DenseMatrix& right, DenseMatrix& result, unsigned threads = 1);
+
+	std::unique_ptr<DataEngine<E>> clone() const override;
+	std::unique_ptr<DataEngine<E>> move() override;
+
+	/**
+	* Releases the elements, leaving a matrix with no rows and no columns
+	*/
+	bool removeAll() override;
+	E* toArray() const override;
+	E* toArray(int start, int end) const override;
+	size_t copyTo(std::span<E> destination, size_t start) const override;
+
+	/**
+	* Reverses the elements in row-major order, i.e. rotates the matrix by half a turn
+	*/
+	void reverse() override;
+
+	iterator begin();
+	iterator end();
+	const_iterator begin() const;
+	const_iterator end() const;
+
+protected:
+	//The size is fixed, the padding is part of the layout
+	void grow() override;
+	void shrink() override;
+	void compress() override;
+
+	[[nodiscard]] bool equalsInternal(const DataEngine<E>& de) const override;
+	[[nodiscard]] bool equivalenceInternal(const DataEngine<E>& de) const override;
+
+	/**
+	* Stacks the given rows of the other matrix under the invoking one, the column counts must match
+	*/
+	[[nodiscard]] std::unique_ptr<DataEngine<E>> mergeInternal(const DataEngine<E>& de, int start, int end) const override;
+
+private:
+	using Lanes = MatrixLanes<E>;
+	using Vector = typename Lanes::Vector;
+
+	static constexpr size_t ALIGNMENT = 64;
+	static constexpr size_t LINE = ALIGNMENT / sizeof(E) > 0 ? ALIGNMENT / sizeof(E) : 1; //Elements per line
+	static constexpr size_t KERNEL_ROWS = Lanes::KERNEL_ROWS;
+	static constexpr size_t KERNEL_COLUMNS = Lanes::KERNEL_VECTORS * Lanes::WIDTH;
+	using KernelBlock = std::make_index_sequence<KERNEL_ROWS * Lanes::KERNEL_VECTORS>;
+
+	/**
+	* Cache budgets of the blocking. A KERNEL_COLUMNS wide micro-panel of the right hand side stays in the
+	* first level cache while the kernel runs down a row panel, the packed row panel stays in the second
+	* level cache and the packed column panel in a share of the last level cache
+	*/
+	static constexpr size_t FIRST_LEVEL_BYTES = 32 * 1024;
+	static constexpr size_t SECOND_LEVEL_BYTES = 512 * 1024;
+	static constexpr size_t THIRD_LEVEL_BYTES = 4 * 1024 * 1024;
+	static constexpr size_t DEPTH_BLOCK = std::max<size_t>(FIRST_LEVEL_BYTES / 2 / (KERNEL_COLUMNS * sizeof(E)) / 8 * 8, 64);
+	static constexpr size_t ROW_BLOCK = std::max<size_t>(SECOND_LEVEL_BYTES / 2 / (DEPTH_BLOCK * sizeof(E)) / KERNEL_ROWS, 1) * KERNEL_ROWS;
+	static constexpr size_t COLUMN_BLOCK = std::max<size_t>(THIRD_LEVEL_BYTES / 2 / (DEPTH_BLOCK * sizeof(E)) / KERNEL_COLUMNS, 1) * KERNEL_COLUMNS;
+
+	/**
+	* Products below this many multiply-adds per thread are not worth a thread of their own
+	*/
+	static constexpr size_t THREAD_WORK = size_t(1) << 21;
+
+	E* values;
+	size_t rows;
+	size_t columns;
+	size_t stride;
+
+	/**
+	* Writes the expression over the elements of the same size, a vector at a time with the remainder of
+	* each row done element by element so that the padding stays at zero
+	*/
+	template<typename Expression>
+	void evaluate(const Expression& expression) noexcept;
+
+	//Static forms of operator== and merge, picked at compile time by ENGINE_STATIC_DISPATCH, they read the
+	//rows of the other matrix in place instead of through a packed copy
+	[[nodiscard]] bool equalTo(const DenseMatrix& other) const;
+	[[nodiscard]] std::unique_ptr<DenseMatrix> mergeWith(const DenseMatrix& other, int start, int end) const;
+
+	/**
+	* Unit in which elements are obtained from the allocator, so that every row starts on an ALIGNMENT boundary
+	*/
+	struct alignas(ALIGNMENT) Line {
+		unsigned char bytes[ALIGNMENT];
+	};
+
+	/**
+	* Obtains zeroed storage for the given number of elements, nullptr for none
+	*/
+	E* allocate(size_t count) const;
+
+	/**
+	* Gives back storage obtained through allocate for the given number of elements
+	*/
+	void release(E* block, size_t count) const noexcept;
+
+	/**
+	* Computes the rows [rowBegin, rowEnd) and columns [columnBegin, columnEnd) of result = left * right,
+	* the block must start on a kernel boundary
+	*/
+	static void multiplyBlock(const DenseMatrix& left, const DenseMatrix& right, DenseMatrix& result,
+		size_t rowBegin, size_t rowEnd, size_t columnBegin, size_t columnEnd);
+
+	/**
+	* Packs a block of the left hand side into KERNEL_ROWS high micro-panels, column by column within
+	* each, padding the last one with zeros
+	*/
+	static void packLeft(const E* source, size_t sourceStride, size_t height, size_t depth, E* target) noexcept;
+
+	/**
+	* Packs a block of the right hand side into KERNEL_COLUMNS wide micro-panels, row by row within each,
+	* padding the last one with zeros
+	*/
+	static void packRight(const E* source, size_t sourceStride, size_t depth, size_t width, E* target) noexcept;
+
+	/**
+	* Adds the product of a packed micro-panel pair to a KERNEL_ROWS by KERNEL_COLUMNS block of the result
+	*/
+	template<size_t... Index>
+	static void kernel(size_t depth, const E* left, const E* right, E* target, size_t targetStride,
+		std::index_sequence<Index...>) noexcept;
+	E_ENGINE_CLASS
+}
@@ -0,0 +1,338 @@
+#pragma once
+#include "../../Public/Abstraction/Graph.h"
+#include "../../Public/Implementation/CSRGraph.h"
+#include "../../Public/EngineEpoch.h"
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace core {
+
+	/**
+	* A mutable Graph implementation updated by batches of edges, for graphs that change too often to be
+	* rebuilt. The vertices are split into pages of PAGE consecutive vertices, and each page keeps the arcs
+	* leaving its vertices in compressed sparse row form, sorted within each vertex. A vertex is reached
+	* through the page table and its arcs are contiguous, so traversals run close to the speed of a
+	* CSRGraph. Pages without arcs all share one blank page.
+	*
+	* Pages are never modified once published. A batch buckets its arcs by page with a parallel counting
+	* sort, then each touched page sorts its bucket and merges it with its current arcs into a new page,
+	* the pages being spread over threads. The new pages and a new page table are published together as
+	* the next version of the graph, and the replaced ones are retired to an EpochDomain. The cost of a
+	* batch is that of its arcs plus the arcs of the pages it touches, which large batches amortize.
+	*
+	* Readers take a Snapshot, which pins the version current at that time: every read through it sees
+	* the graph between two whole batches, never part of one, and it is lock-free. Memory retired while a
+	* snapshot lives is only freed after it is gone, so snapshots should be short-lived. Batches are
+	* applied one at a time, writers are serialized by a mutex. Inserting an edge adds the vertices it
+	* needs, vertex identifiers are unsigned integers, the greatest value is reserved for NONE.
+	*
+	* Iteration walks the current version without pinning it and move requires that no other thread uses
+	* the graph, both are only safe while no thread writes
+	*/
+	S_IMPLEMENTATION_CLASS(DynamicGraph, Graph<E>, Nature::THREAD_MUTABLE, Behavior::DYNAMIC, Ordering::UNSORTED)
+	static_assert(std::is_integral_v<E> && std::is_unsigned_v<E>, "DynamicGraph requires unsigned integer vertex identifiers");
+
+	/**
+	* Vertices per page, a power of two
+	*/
+	static constexpr size_t PAGE = 256;
+
+	/**
+	* Arcs leaving the vertices of a page, immutable once published
+	*/
+	struct Page {
+		EngineVector<size_t, Allocator> offsets;
+		EngineVector<E, Allocator> targets;
+
+		explicit Page(const Allocator& allocator) : offsets(PAGE + 1, 0, allocator), targets(allocator) {}
+		Page(const Page& other, const Allocator& allocator) : offsets(other.offsets, allocator), targets(other.targets, allocator) {}
+	};
+
+	/**
+	* A published state of the graph, immutable as well
+	*/
+	struct Version {
+		size_t vertices = 0;
+		size_t arcs = 0;
+		EngineVector<const Page*, Allocator> pages;
+
+		explicit Version(const Allocator& allocator) : pages(allocator) {}
+	};
+
+	/**
+	* Consistent, lock-free view of the graph as it was when the snapshot was taken. The graph must
+	* outlive it
+	*/
+	class Snapshot {
+		friend class DynamicGraph;
+		EpochDomain::Guard guard;
+		const Version* version;
+	public:
+		explicit Snapshot(const DynamicGraph& graph) noexcept
+			: guard(graph.domain.pin()), version(graph.current.load(std::memory_order_acquire)) {}
+
+		/**
+		* @return Returns the number of vertices
+		*/
+		[[nodiscard]] size_t getVertices() const noexcept { return version->vertices; }
+
+		/**
+		* @return Returns the number of arcs
+		*/
+		[[nodiscard]] size_t getArcs() const noexcept { return version->arcs; }
+
+		/**
+		* Gets the targets of the arcs leaving a vertex, in increasing order, without copying them
+		* @param vertex The vertex, which is not checked
+		* @return Returns a view of the neighbors, valid as long as the snapshot
+		*/
+		[[nodiscard]] std::span<const E> neighbors(E vertex) const noexcept {
+			const Page& page = *version->pages[vertex / PAGE];
+			const size_t local = vertex % PAGE;
+			return { page.targets.data() + page.offsets[local], page.targets.data() + page.offsets[local + 1] };
+		}
+
+		/**
+		* @param vertex The vertex, which is not checked
+		* @return Returns the out-degree of the vertex
+		*/
+		[[nodiscard]] size_t getDegree(E vertex) const noexcept {
+			const Page& page = *version->pages[vertex / PAGE];
+			const size_t local = vertex % PAGE;
+			return page.offsets[local + 1] - page.offsets[local];
+		}
+	};
+
+	/**
+	* Iterator over the targets of the arcs, vertex by vertex, of the version current when it was created.
+	* Versions are immutable, so are the targets seen through it
+	*/
+	class DynamicGraphIterator : public Iterator<DynamicGraphIterator, const E> {
+		const Version* version = nullptr;
+		size_t page = 0;
+		size_t index = 0;
+
+		void settle() {
+			while (page < version->pages.size() && index == version->pages[page]->targets.size()) {
+				page++;
+				index = 0;
+			}
+		}
+	public:
+		DynamicGraphIterator() = default;
+		DynamicGraphIterator(const Version* version, size_t page) : version(version), page(page), index(0) { settle(); }
+
+		const E& operator*() const { return version->pages[page]->targets[index]; }
+		const E* operator->() const { return &operator*(); }
+
+		DynamicGraphIterator& operator++() { index++; settle(); return *this; }
+
+		bool operator==(const DynamicGraphIterator& other) const { return page == other.page && index == other.index; }
+	};
+
+	/**
+	* Marks a missing vertex, such as the parent of a vertex a search did not reach
+	*/
+	static constexpr E NONE = std::numeric_limits<E>::max();
+
+	/**
+	* Creates an empty directed graph with no vertices
+	*/
+	DynamicGraph();
+
+	/**
+	* Creates an empty directed graph with no vertices, which later draws its pages from the given allocator
+	* @param allocator Allocator of the pages and versions
+	*/
+	explicit DynamicGraph(const Allocator& allocator);
+
+	/**
+	* Creates a graph without arcs
+	* @param vertices Number of vertices
+	* @param directed False to store each edge in both directions
+	* @param allocator Allocator of the pages and versions
+	* @throws std::length_error if there are more vertices than identifiers below NONE
+	*/
+	explicit DynamicGraph(size_t vertices, bool directed = true, const Allocator& allocator = Allocator());
+
+	/**
+	* Creates a graph from a list of edges, in any order, as a first batch
+	* @param vertices Number of vertices, at least
+	* @param edges The edges
+	* @param count Number of edges
+	* @param directed False to store each edge in both directions
+	* @param threads Number of threads to split the work over, 0 for one per hardware thread
+	* @param allocator Allocator of the pages and versions
+	* @throws std::out_of_range if an edge has NONE as an end
+	* @throws std::length_error if there are more vertices than identifiers below NONE
+	*/
+	DynamicGraph(size_t vertices, const GraphEdge<E>* edges, size_t count, bool directed = true, unsigned threads = 1,
+		const Allocator& allocator = Allocator());
+
+	~DynamicGraph() override;
+
+	//Adding move semantics
+	DynamicGraph(DynamicGraph&& other);
+	DynamicGraph& operator=(DynamicGraph&& other);
+
+	[[nodiscard]] size_t getVertices() const override;
+	[[nodiscard]] bool isDirected() const override;
+	[[nodiscard]] size_t getDegree(E vertex) const override;
+	[[nodiscard]] bool containsEdge(E source, E target) const override;
+	[[nodiscard]] std::vector<E> getNeighbors(E vertex) const override;
+
+	/**
+	* @return Returns the number of arcs of the current version
+	*/
+	[[nodiscard]] size_t getActiveSize() const override;
+
+	/**
+	* Pins the current version of the graph for consistent reads
+	* @return Returns the snapshot
+	*/
+	[[nodiscard]] Snapshot snapshot() const noexcept { return Snapshot(*this); }
+
+	/**
+	* Adds a batch of edges, in any order, as one step visible to readers. Edges already present or given
+	* more than once are added once, the vertex set grows to hold the ends of every edge
+	* @param edges The edges
+	* @param count Number of edges
+	* @param threads Number of threads to split the work over, 0 for one per hardware thread
+	* @return Returns the number of arcs added
+	* @throws std::out_of_range if an edge has NONE as an end, the graph is then left untouched
+	*/
+	size_t insertEdges(const GraphEdge<E>* edges, size_t count, unsigned threads = 1);
+
+	/**
+	* Removes a batch of edges, in any order, as one step visible to readers. Missing edges are skipped
+	* @param edges The edges
+	* @param count Number of edges
+	* @param threads Number of threads to split the work over, 0 for one per hardware thread
+	* @return Returns the number of arcs removed
+	* @throws std::out_of_range if an edge has an end that is not a vertex, the graph is then left untouched
+	*/
+	size_t removeEdges(const GraphEdge<E>* edges, size_t count, unsigned threads = 1);
+
+	/**
+	* Adds a single edge, a batch of one
+	* @return Returns true if the edge was added, false if it was present
+	*/
+	bool insertEdge(E source, E target);
+
+	/**
+	* Removes a single edge, a batch of one
+	* @return Returns true if the edge was removed, false if it was missing
+	*/
+	bool removeEdge(E source, E target);
+
+	/**
+	* Searches the current version breadth first from a vertex, top down
+	* @param source The vertex to start from
+	* @param threads Number of threads to split the work over, 0 for one per hardware thread
+	* @return Returns the parent of each vertex in the search tree, the source being its own parent and
+	* NONE marking the vertices not reached
+	* @throws std::out_of_range if the source does not exist
+	*/
+	[[nodiscard]] std::vector<E> breadthFirst(E source, unsigned threads = 1) const;
+
+	/**
+	* Freezes the current version into a CSRGraph, for the algorithms that need one
+	* @param threads Number of threads to split the work over, 0 for one per hardware thread
+	* @return Returns the static graph
+	*/
+	[[nodiscard]] CSRGraph<E, Allocator> toCSR(unsigned threads = 1) const;
+
+	/**
+	* Arcs are always sorted within their vertex, sorting leaves the graph untouched
+	*/
+	void sort() override;
+
+	std::unique_ptr<DataEngine<E>> clone() const override;
+	std::unique_ptr<DataEngine<E>> move() override;
+
+	/**
+	* Removes every arc, the vertices stay
+	*/
+	bool removeAll() override;
+	E* toArray() const override;
+	E* toArray(int start, int end) const override;
+	size_t copyTo(std::span<E> destination, size_t start) const override;
+
+	/**
+	* Reverses every arc of a directed graph as one batch, an undirected graph is left untouched
+	*/
+	void reverse() override;
+
+	DynamicGraphIterator begin() const;
+	DynamicGraphIterator end() const;
+
+protected:
+	//Pages are replaced whole by every batch
+	void grow() override;
+	void shrink() override;
+	void compress() override;
+
+	/**
+	* Equal graphs have the same vertices, and each vertex the same neighbors in the same order
+	*/
+	[[nodiscard]] bool equalsInternal(const DataEngine<E>& de) const override;
+
+	/**
+	* Equivalent graphs have the same vertices, and each vertex the same neighbors in any order
+	*/
+	[[nodiscard]] bool equivalenceInternal(const DataEngine<E>& de) const override;
+
+	/**
+	* Adds the arcs leaving the given vertices of the other graph to those of the invoking one, the new
+	* graph has as many vertices as the larger of the two
+	*/
+	[[nodiscard]] std::unique_ptr<DataEngine<E>> mergeInternal(const DataEngine<E>& de, int start, int end) const override;
+
+private:
+	bool directed;
+	const Page blank; //Shared by the pages without arcs, never retired
+	std::atomic<const Version*> current;
+	std::mutex writer;
+	mutable EpochDomain domain;
+
+	/**
+	* Applies a batch and publishes the result, under the writer lock
+	* @return Returns the number of arcs added or removed
+	*/
+	size_t update(const GraphEdge<E>* edges, size_t count, bool removing, unsigned threads);
+
+	/**
+	* Computes the version following the base once the batch is applied, without publishing it
+	* @param changed Receives the number of arcs added or removed
+	* @return Returns the next version, which owns the new pages and shares the others with the base
+	*/
+	ObjectPtr<Version, Allocator> apply(const Version& base, const GraphEdge<E>* edges, size_t count, bool removing,
+		unsigned threads, size_t& changed) const;
+
+	/**
+	* Makes the version current, retiring the previous one and the pages it no longer shares
+	*/
+	void publish(ObjectPtr<Version, Allocator> next);
+
+	/**
+	* @return Returns a version of the given vertices without arcs
+	*/
+	ObjectPtr<Version, Allocator> empty(size_t vertices) const;
+
+	/**
+	* Frees a version together with the pages it owns, no reader may hold it
+	*/
+	void release(const Version* version) noexcept;
+
+	/**
+	* @return Returns the arcs of the snapshot as edges, vertex by vertex
+	*/
+	static std::vector<GraphEdge<E>> edges(const Snapshot& view);
+	E_ENGINE_CLASS
+}
@@ -0,0 +1,245 @@
+#pragma once
+#include "../../Public/Abstraction/Map.h"
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <new>
+
+namespace core {
+
+	/**
+	* A flat, open-addressing Map implementation in the style of Swiss tables. Entries live directly in
+	* one slot array, next to a control array holding one byte per slot: EMPTY, DELETED, or the top 7 bits
+	* of the hash of a full slot. Lookups scan a whole group of 16 control bytes with a single SSE2
+	* compare, so most probes touch one control line and one slot line. Without SSE2 the group is
+	* scanned byte by byte.
+	*
+	* The capacity is a power of two that doubles once full and deleted slots cross GROWTH_LOAD_FACTOR,
+	* and halves under SHRINK_LOAD_FACTOR. Removal leaves no tombstone when its group still has an empty
+	* slot, since no probe can have passed through such a group
+	*/
+	S_MAP_IMPLEMENTATION_CLASS(HashMap, Map, Nature::MUTABLE, Behavior::DYNAMIC, Ordering::UNSORTED)
+
+	/**
+	* Iterator over the full slots of a HashMap in slot order
+	* @tparam T E, or const E for the iterators of a const map
+	*/
+	template<typename T>
+	class HashMapIterator : public Iterator<HashMapIterator<T>, T> {
+		const int8_t* control = nullptr;
+		T* slots = nullptr;
+		size_t index = 0;
+		size_t capacity = 0;
+
+		void skip() { while (index < capacity && control[index] < 0) { ++index; } }
+	public:
+		HashMapIterator() = default;
+		HashMapIterator(const int8_t* control, T* slots, size_t index, size_t capacity) :
+			control(control), slots(slots), index(index), capacity(capacity) { skip(); }
+
+		T& operator*() const { return slots[index]; }
+		T* operator->() const { return slots + index; }
+
+		HashMapIterator& operator++() { ++index; skip(); return *this; }
+
+		bool operator==(const HashMapIterator& other) const { return index == other.index; }
+	};
+
+	using iterator = HashMapIterator<E>;
+	using const_iterator = HashMapIterator<const E>;
+
+	/**
+	* Creates an empty map with DEFAULT_CAPACITY
+	*/
+	HashMap();
+
+	/**
+	* Creates an empty map with DEFAULT_CAPACITY drawing its arrays from the given allocator
+	* @param allocator Allocator of the arrays
+	*/
+	explicit HashMap(const Allocator& allocator);
+
+	/**
+	* Creates an empty map able to hold the given number of entries before growing
+	* @param capacity Initial capacity
+	* @param allocator Allocator of the arrays
+	*/
+	explicit HashMap(size_t capacity, const Allocator& allocator = Allocator());
+
+	~HashMap() override;
+
+	//Adding move semantics
+	HashMap(HashMap&& other) noexcept;
+	HashMap& operator=(HashMap&& other) noexcept(takesStorageOnMove<Allocator>);
+
+	bool put(K key, V value) override;
+	[[nodiscard]] bool get(const K& key, V& value) const override;
+	bool remove(const K& key) override;
+	[[nodiscard]] bool containsKey(const K& key) override;
+	[[nodiscard]] bool containsValue(const V& value) override;
+
+	/**
+	* Finds the value associated with the key without copying it. The pointer stays valid until the
+	* map is next modified
+	* @param key The key to be searched
+	* @return Returns a pointer to the value, nullptr if the key is not present
+	*/
+	[[nodiscard]] V* find(const K& key);
+
+	/**
+	* Ensures that the map can hold the given number of entries without growing
+	* @param capacity Required capacity
+	*/
+	void reserve(size_t capacity);
+
+	std::unique_ptr<DataEngine<E>> clone() const override;
+	std::unique_ptr<DataEngine<E>> move() override;
+
+	bool removeAll() override;
+	E* toArray() const override;
+	E* toArray(int start, int end) const override;
+	size_t copyTo(std::span<E> destination, size_t start) const override;
+
+	/**
+	* Entries are unordered, reversing leaves the map untouched
+	*/
+	void reverse() override;
+
+	iterator begin();
+	iterator end();
+	const_iterator begin() const;
+	const_iterator end() const;
+
+protected:
+	void grow() override;
+	void shrink() override;
+	void compress() override;
+
+	[[nodiscard]] bool equalsInternal(const DataEngine<E>& de) const override;
+	[[nodiscard]] bool equivalenceInternal(const DataEngine<E>& de) const override;
+	[[nodiscard]] std::unique_ptr<DataEngine<E>> mergeInternal(const DataEngine<E>& de, int start, int end) const override;
+
+private:
+	static constexpr size_t GROUP_WIDTH = 16;
+	static constexpr int8_t EMPTY = -128;
+	static constexpr int8_t DELETED = -2;
+
+	/**
+	* True when entries can be moved to a new slot array with a plain memcpy
+	*/
+	static constexpr bool RELOCATABLE = is_trivially_relocatable<E>::value;
+
+	/**
+	* A view of GROUP_WIDTH consecutive control bytes, answering each query with a bit mask where bit i
+	* stands for the i-th slot of the group
+	*/
+	struct Group {
+#ifdef ENGINE_SSE2
+		__m128i bytes;
+
+		explicit Group(const int8_t* control) : bytes(_mm_load_si128(reinterpret_cast<const __m128i*>(control))) {}
+
+		uint32_t match(int8_t fingerprint) const noexcept {
+			return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(fingerprint), bytes)));
+		}
+
+		uint32_t matchEmpty() const noexcept { return match(EMPTY); }
+
+		//EMPTY and DELETED are the only negative values below -1
+		uint32_t matchAvailable() const noexcept {
+			return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(-1), bytes)));
+		}
+#else
+		const int8_t* bytes;
+
+		explicit Group(const int8_t* control) : bytes(control) {}
+
+		uint32_t match(int8_t fingerprint) const noexcept {
+			uint32_t bits = 0;
+			for (size_t i = 0; i < GROUP_WIDTH; i++) {
+				bits |= static_cast<uint32_t>(bytes[i] == fingerprint) << i;
+			}
+			return bits;
+		}
+
+		uint32_t matchEmpty() const noexcept { return match(EMPTY); }
+
+		uint32_t matchAvailable() const noexcept {
+			uint32_t bits = 0;
+			for (size_t i = 0; i < GROUP_WIDTH; i++) {
+				bits |= static_cast<uint32_t>(bytes[i] < -1) << i;
+			}
+			return bits;
+		}
+#endif
+	};
+
+	int8_t* control;
+	E* slots;
+	size_t mask;
+	size_t deleted; //Number of DELETED control bytes
+
+	//Cached bounds so that the hot paths never touch floating point
+	size_t growthThreshold;
+	size_t shrinkThreshold;
+
+	/**
+	* Hashes the key and spreads the result so that both the low bits used for the position and the high
+	* bits used for the fingerprint are well mixed, even for identity hashes
+	*/
+	static size_t hash(const K& key) noexcept {
+		uint64_t h = static_cast<uint64_t>(std::hash<K>{}(key)) * 0x9E3779B97F4A7C15ull;
+		return static_cast<size_t>(h ^ (h >> 32));
+	}
+
+	static int8_t fingerprint(size_t hash) noexcept { return static_cast<int8_t>(hash >> (sizeof(size_t) * 8 - 7)); }
+
+	/**
+	* @return Returns the slot index of the key, or maxCapacity if the key is not present
+	*/
+	size_t indexOf(const K& key, size_t hash) const;
+
+	/**
+	* @return Returns the first EMPTY or DELETED slot on the probe sequence of the hash
+	*/
+	size_t availableIndex(size_t hash) const;
+
+	/**
+	* Moves every entry into freshly allocated arrays of the given capacity, dropping all tombstones
+	* @param capacity New capacity, must be a power of two holding every entry
+	*/
+	void rehash(size_t capacity);
+
+	/**
+	* Destroys all the entries and releases both arrays
+	*/
+	void release() noexcept;
+
+	/**
+	* Recomputes the mask and the cached thresholds from the max capacity
+	*/
+	void updateThresholds() noexcept;
+
+	/**
+	* @return Returns the smallest power of two capacity that holds the given number of entries under
+	* GROWTH_LOAD_FACTOR
+	*/
+	static size_t capacityFor(size_t entries) noexcept;
+
+	/**
+	* Unit in which control bytes are obtained from the allocator, so that groups load aligned
+	*/
+	struct alignas(GROUP_WIDTH) ControlBlock {
+		int8_t bytes[GROUP_WIDTH];
+	};
+
+	int8_t* allocateControl(size_t capacity) const;
+	E* allocateSlots(size_t capacity) const;
+
+	/**
+	* Gives both arrays of the given capacity back to the allocator, without destroying the entries
+	*/
+	void deallocate(int8_t* control, E* slots, size_t capacity) const noexcept;
+	E_ENGINE_CLASS
+}
@@ -0,0 +1,313 @@
+#pragma once
+#include "../../Public/EngineCore.h"
+#include "../../Public/Implementation/MatrixLanes.h"
+#include <concepts>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+
+namespace core {
+	template<typename E, typename Allocator>
+	class DenseMatrix;
+
+	/**
+	* Base of the nodes of a matrix expression. Element-wise arithmetic on matrices does not compute
+	* anything, it builds a tree of nodes whose type records the whole expression. Assigning the tree to a
+	* DenseMatrix evaluates it in a single pass over the destination, a vector of elements at a time,
+	* reading every operand in place: no temporary matrix is created however many operations are chained.
+	* Nodes hold their subexpressions by value and the matrices they read by address, so an expression must
+	* be evaluated while those matrices are alive.
+	*
+	* Every node provides Element and SCALAR, getRows and getColumns, the element at a position through
+	* operator(), packet for MatrixLanes::WIDTH consecutive elements of a row, and two aliasing queries:
+	* references tells whether the node reads a given matrix at all, aliases whether it reads that matrix
+	* at positions other than the one being evaluated, which would make evaluating in place wrong
+	*/
+	struct MatrixExpressionBase {};
+
+	template<typename T>
+	concept MatrixExpression = std::derived_from<T, MatrixExpressionBase>;
+
+	/**
+	* Leaf reading a DenseMatrix
+	*/
+	template<typename E, typename Allocator>
+	class MatrixReference : public MatrixExpressionBase {
+		using Lanes = MatrixLanes<E>;
+		const DenseMatrix<E, Allocator>* matrix;
+	public:
+		using Element = E;
+		static constexpr bool SCALAR = false;
+
+		explicit MatrixReference(const DenseMatrix<E, Allocator>& matrix) noexcept : matrix(&matrix) {}
+
+		size_t getRows() const noexcept { return matrix->getRows(); }
+		size_t getColumns() const noexcept { return matrix->getColumns(); }
+		E operator()(size_t row, size_t column) const noexcept { return (*matrix)(row, column); }
+		typename Lanes::Vector packet(size_t row, size_t column) const noexcept { return Lanes::load(matrix->getRow(row) + column); }
+
+		template<typename Target>
+		bool references(const Target& target) const noexcept { return static_cast<const void*>(matrix) == static_cast<const void*>(&target); }
+		template<typename Target>
+		bool aliases(const Target&) const noexcept { return false; } //Every element is read where it is written
+	};
+
+	/**
+	* Leaf standing for a scalar at every position, it takes its size from the other operand
+	*/
+	template<typename E>
+	class MatrixScalar : public MatrixExpressionBase {
+		using Lanes = MatrixLanes<E>;
+		E value;
+	public:
+		using Element = E;
+		static constexpr bool SCALAR = true;
+
+		explicit MatrixScalar(E value) noexcept : value(value) {}
+
+		size_t getRows() const noexcept { return 0; }
+		size_t getColumns() const noexcept { return 0; }
+		E operator()(size_t, size_t) const noexcept { return value; }
+		typename Lanes::Vector packet(size_t, size_t) const noexcept { return Lanes::broadcast(value); }
+
+		template<typename Target>
+		bool references(const Target&) const noexcept { return false; }
+		template<typename Target>
+		bool aliases(const Target&) const noexcept { return false; }
+	};
+
+	/**
+	* Node combining two operands of the same size element by element
+	* @tparam Operation Provides apply for elements and applyPacket for vectors
+	*/
+	template<typename Operation, MatrixExpression Left, MatrixExpression Right>
+	class MatrixBinary : public MatrixExpressionBase {
+		static_assert(std::same_as<typename Left::Element, typename Right::Element>, "Matrix operands must have the same element type");
+		using Lanes = MatrixLanes<typename Left::Element>;
+		Left left;
+		Right right;
+	public:
+		using Element = typename Left::Element;
+		static constexpr bool SCALAR = Left::SCALAR && Right::SCALAR;
+
+		/**
+		* @throws std::invalid_argument if both operands are matrices of different sizes
+		*/
+		MatrixBinary(const Left& left, const Right& right) : left(left), right(right) {
+			if constexpr (!Left::SCALAR && !Right::SCALAR) {
+				if (left.getRows() != right.getRows() || left.getColumns() != right.getColumns()) {
+					throw std::invalid_argument("matrix sizes do not match");
+				}
+			}
+		}
+
+		size_t getRows() const noexcept { return Left::SCALAR ? right.getRows() : left.getRows(); }
+		size_t getColumns() const noexcept { return Left::SCALAR ? right.getColumns() : left.getColumns(); }
+		Element operator()(size_t row, size_t column) const noexcept {
+			return Operation::apply(left(row, column), right(row, column));
+		}
+		typename Lanes::Vector packet(size_t row, size_t column) const noexcept {
+			return Operation::applyPacket(left.packet(row, column), right.packet(row, column));
+		}
+
+		template<typename Target>
+		bool references(const Target& target) const noexcept { return left.references(target) || right.references(target); }
+		template<typename Target>
+		bool aliases(const Target& target) const noexcept { return left.aliases(target) || right.aliases(target); }
+	};
+
+	/**
+	* Node reading its operand with rows and columns swapped
+	*/
+	template<MatrixExpression Child>
+	class MatrixTransposed : public MatrixExpressionBase {
+		using Lanes = MatrixLanes<typename Child::Element>;
+		Child child;
+	public:
+		using Element = typename Child::Element;
+		static constexpr bool SCALAR = Child::SCALAR;
+
+		explicit MatrixTransposed(const Child& child) : child(child) {}
+
+		size_t getRows() const noexcept { return child.getColumns(); }
+		size_t getColumns() const noexcept { return child.getRows(); }
+		Element operator()(size_t row, size_t column) const noexcept { return child(column, row); }
+		typename Lanes::Vector packet(size_t row, size_t column) const noexcept {
+			//A row of the transpose is a column of the operand, gathered one element at a time
+			alignas(64) Element lanes[Lanes::WIDTH];
+			for (size_t lane = 0; lane < Lanes::WIDTH; lane++) {
+				lanes[lane] = child(column + lane, row);
+			}
+			return Lanes::load(lanes);
+		}
+
+		template<typename Target>
+		bool references(const Target& target) const noexcept { return child.references(target); }
+		template<typename Target>
+		bool aliases(const Target& target) const noexcept { return child.references(target); }
+	};
+
+	//Element-wise operations of MatrixBinary
+	template<typename E>
+	struct MatrixSum {
+		static E apply(E a, E b) noexcept { return a + b; }
+		static typename MatrixLanes<E>::Vector applyPacket(typename MatrixLanes<E>::Vector a, typename MatrixLanes<E>::Vector b) noexcept {
+			return MatrixLanes<E>::add(a, b);
+		}
+	};
+
+	template<typename E>
+	struct MatrixDifference {
+		static E apply(E a, E b) noexcept { return a - b; }
+		static typename MatrixLanes<E>::Vector applyPacket(typename MatrixLanes<E>::Vector a, typename MatrixLanes<E>::Vector b) noexcept {
+			return MatrixLanes<E>::subtract(a, b);
+		}
+	};
+
+	template<typename E>
+	struct MatrixProduct {
+		static E apply(E a, E b) noexcept { return a * b; }
+		static typename MatrixLanes<E>::Vector applyPacket(typename MatrixLanes<E>::Vector a, typename MatrixLanes<E>::Vector b) noexcept {
+			return MatrixLanes<E>::multiply(a, b);
+		}
+	};
+
+	template<typename E>
+	struct MatrixQuotient {
+		static E apply(E a, E b) noexcept { return a / b; }
+		static typename MatrixLanes<E>::Vector applyPacket(typename MatrixLanes<E>::Vector a, typename MatrixLanes<E>::Vector b) noexcept {
+			return MatrixLanes<E>::divide(a, b);
+		}
+	};
+
+	/**
+	* Tells how a type takes part in a matrix expression: expression nodes take part as they are, dense
+	* matrices through a MatrixReference
+	*/
+	template<typename T>
+	struct matrix_operand {
+		static constexpr bool value = false;
+	};
+
+	template<MatrixExpression T>
+	struct matrix_operand<T> {
+		static constexpr bool value = true;
+		using Element = typename T::Element;
+		using Expression = T;
+		static const T& lift(const T& operand) noexcept { return operand; }
+	};
+
+	template<typename E, typename Allocator>
+	struct matrix_operand<DenseMatrix<E, Allocator>> {
+		static constexpr bool value = true;
+		using Element = E;
+		using Expression = MatrixReference<E, Allocator>;
+		static Expression lift(const DenseMatrix<E, Allocator>& operand) noexcept { return Expression(operand); }
+	};
+
+	template<typename T>
+	concept MatrixOperand = matrix_operand<T>::value;
+
+	template<typename Left, typename Right>
+	concept MatrixOperands = MatrixOperand<Left> && MatrixOperand<Right> &&
+		std::same_as<typename matrix_operand<Left>::Element, typename matrix_operand<Right>::Element>;
+
+	/**
+	* Builds the node applying an operation to two operands, either of which may be a scalar
+	*/
+	template<template<typename> typename Operation, typename Left, typename Right>
+	auto matrixNode(const Left& left, const Right& right) {
+		if constexpr (!MatrixOperand<Left>) {
+			using E = typename matrix_operand<Right>::Element;
+			using RightExpression = typename matrix_operand<Right>::Expression;
+			return MatrixBinary<Operation<E>, MatrixScalar<E>, RightExpression>(MatrixScalar<E>(left), matrix_operand<Right>::lift(right));
+		}
+		else if constexpr (!MatrixOperand<Right>) {
+			using E = typename matrix_operand<Left>::Element;
+			using LeftExpression = typename matrix_operand<Left>::Expression;
+			return MatrixBinary<Operation<E>, LeftExpression, MatrixScalar<E>>(matrix_operand<Left>::lift(left), MatrixScalar<E>(right));
+		}
+		else {
+			using E = typename matrix_operand<Left>::Element;
+			using LeftExpression = typename matrix_operand<Left>::Expression;
+			using RightExpression = typename matrix_operand<Right>::Expression;
+			return MatrixBinary<Operation<E>, LeftExpression, RightExpression>(matrix_operand<Left>::lift(left), matrix_operand<Right>::lift(right));
+		}
+	}
+
+	/**
+	* Element-wise sum of two matrices of the same size
+	* @throws std::invalid_argument if the sizes do not match
+	*/
+	template<typename Left, typename Right> requires MatrixOperands<Left, Right>
+	auto operator+(const Left& left, const Right& right) {
+		return matrixNode<MatrixSum>(left, right);
+	}
+
+	/**
+	* Element-wise difference of two matrices of the same size
+	* @throws std::invalid_argument if the sizes do not match
+	*/
+	template<typename Left, typename Right> requires MatrixOperands<Left, Right>
+	auto operator-(const Left& left, const Right& right) {
+		return matrixNode<MatrixDifference>(left, right);
+	}
+
+	/**
+	* Element-wise product of two matrices of the same size, not to be confused with DenseMatrix::multiply
+	* @throws std::invalid_argument if the sizes do not match
+	*/
+	template<typename Left, typename Right> requires MatrixOperands<Left, Right>
+	auto hadamard(const Left& left, const Right& right) {
+		return matrixNode<MatrixProduct>(left, right);
+	}
+
+	/**
+	* Lazy transpose, evaluated as part of the enclosing expression
+	*/
+	template<MatrixOperand Operand>
+	auto transposed(const Operand& operand) {
+		return MatrixTransposed<typename matrix_operand<Operand>::Expression>(matrix_operand<Operand>::lift(operand));
+	}
+
+	//Scalar forms, the scalar applies to every element
+	template<MatrixOperand Operand>
+	auto operator+(const Operand& operand, typename matrix_operand<Operand>::Element scalar) {
+		return matrixNode<MatrixSum>(operand, scalar);
+	}
+
+	template<MatrixOperand Operand>
+	auto operator+(typename matrix_operand<Operand>::Element scalar, const Operand& operand) {
+		return matrixNode<MatrixSum>(scalar, operand);
+	}
+
+	template<MatrixOperand Operand>
+	auto operator-(const Operand& operand, typename matrix_operand<Operand>::Element scalar) {
+		return matrixNode<MatrixDifference>(operand, scalar);
+	}
+
+	template<MatrixOperand Operand>
+	auto operator-(typename matrix_operand<Operand>::Element scalar, const Operand& operand) {
+		return matrixNode<MatrixDifference>(scalar, operand);
+	}
+
+	template<MatrixOperand Operand>
+	auto operator-(const Operand& operand) {
+		return matrixNode<MatrixDifference>(typename matrix_operand<Operand>::Element(), operand);
+	}
+
+	template<MatrixOperand Operand>
+	auto operator*(const Operand& operand, typename matrix_operand<Operand>::Element scalar) {
+		return matrixNode<MatrixProduct>(operand, scalar);
+	}
+
+	template<MatrixOperand Operand>
+	auto operator*(typename matrix_operand<Operand>::Element scalar, const Operand& operand) {
+		return matrixNode<MatrixProduct>(scalar, operand);
+	}
+
+	template<MatrixOperand Operand>
+	auto operator/(const Operand& operand, typename matrix_operand<Operand>::Element scalar) {
+		return matrixNode<MatrixQuotient>(operand, scalar);
+	}
+}
@@ -0,0 +1,140 @@
+#pragma once
+#include "../../Public/EngineCore.h"
+#include <cstddef>
+
+namespace core {
+	/**
+	* Vector operations behind the DenseMatrix kernels and the evaluation of matrix expressions. The general
+	* form handles one element at a time and serves every arithmetic type, float and double use the widest
+	* vectors the build targets. KERNEL_ROWS and KERNEL_VECTORS give the shape of the block of the product held in registers:
+	* KERNEL_ROWS rows of KERNEL_VECTORS vectors, sized to leave room for the operands in the register file
+	* @tparam T Element type
+	*/
+	template<typename T>
+	struct MatrixLanes {
+		using Vector = T;
+		static constexpr size_t WIDTH = 1;
+		static constexpr size_t KERNEL_ROWS = 4;
+		static constexpr size_t KERNEL_VECTORS = 4;
+
+		static Vector zero() noexcept { return T(); }
+		static Vector load(const T* source) noexcept { return *source; }
+		static void store(T* target, Vector value) noexcept { *target = value; }
+		static Vector broadcast(T value) noexcept { return value; }
+		static Vector add(Vector a, Vector b) noexcept { return a + b; }
+		static Vector subtract(Vector a, Vector b) noexcept { return a - b; }
+		static Vector multiply(Vector a, Vector b) noexcept { return a * b; }
+		static Vector divide(Vector a, Vector b) noexcept { return a / b; }
+		static Vector multiplyAdd(Vector a, Vector b, Vector c) noexcept { return c + a * b; }
+	};
+
+#if ENGINE_AVX512
+	template<>
+	struct MatrixLanes<double> {
+		using Vector = __m512d;
+		static constexpr size_t WIDTH = 8;
+		static constexpr size_t KERNEL_ROWS = 14; //28 accumulators, 2 operands and a broadcast out of 32
+		static constexpr size_t KERNEL_VECTORS = 2;
+
+		static Vector zero() noexcept { return _mm512_setzero_pd(); }
+		static Vector load(const double* source) noexcept { return _mm512_loadu_pd(source); }
+		static void store(double* target, Vector value) noexcept { _mm512_storeu_pd(target, value); }
+		static Vector broadcast(double value) noexcept { return _mm512_set1_pd(value); }
+		static Vector add(Vector a, Vector b) noexcept { return _mm512_add_pd(a, b); }
+		static Vector subtract(Vector a, Vector b) noexcept { return _mm512_sub_pd(a, b); }
+		static Vector multiply(Vector a, Vector b) noexcept { return _mm512_mul_pd(a, b); }
+		static Vector divide(Vector a, Vector b) noexcept { return _mm512_div_pd(a, b); }
+		static Vector multiplyAdd(Vector a, Vector b, Vector c) noexcept { return _mm512_fmadd_pd(a, b, c); }
+	};
+
+	template<>
+	struct MatrixLanes<float> {
+		using Vector = __m512;
+		static constexpr size_t WIDTH = 16;
+		static constexpr size_t KERNEL_ROWS = 14;
+		static constexpr size_t KERNEL_VECTORS = 2;
+
+		static Vector zero() noexcept { return _mm512_setzero_ps(); }
+		static Vector load(const float* source) noexcept { return _mm512_loadu_ps(source); }
+		static void store(float* target, Vector value) noexcept { _mm512_storeu_ps(target, value); }
+		static Vector broadcast(float value) noexcept { return _mm512_set1_ps(value); }
+		static Vector add(Vector a, Vector b) noexcept { return _mm512_add_ps(a, b); }
+		static Vector subtract(Vector a, Vector b) noexcept { return _mm512_sub_ps(a, b); }
+		static Vector multiply(Vector a, Vector b) noexcept { return _mm512_mul_ps(a, b); }
+		static Vector divide(Vector a, Vector b) noexcept { return _mm512_div_ps(a, b); }
+		static Vector multiplyAdd(Vector a, Vector b, Vector c) noexcept { return _mm512_fmadd_ps(a, b, c); }
+	};
+#elif ENGINE_AVX2
+	template<>
+	struct MatrixLanes<double> {
+		using Vector = __m256d;
+		static constexpr size_t WIDTH = 4;
+		static constexpr size_t KERNEL_ROWS = 6; //12 accumulators, 2 operands and a broadcast out of 16
+		static constexpr size_t KERNEL_VECTORS = 2;
+
+		static Vector zero() noexcept { return _mm256_setzero_pd(); }
+		static Vector load(const double* source) noexcept { return _mm256_loadu_pd(source); }
+		static void store(double* target, Vector value) noexcept { _mm256_storeu_pd(target, value); }
+		static Vector broadcast(double value) noexcept { return _mm256_set1_pd(value); }
+		static Vector add(Vector a, Vector b) noexcept { return _mm256_add_pd(a, b); }
+		static Vector subtract(Vector a, Vector b) noexcept { return _mm256_sub_pd(a, b); }
+		static Vector multiply(Vector a, Vector b) noexcept { return _mm256_mul_pd(a, b); }
+		static Vector divide(Vector a, Vector b) noexcept { return _mm256_div_pd(a, b); }
+		static Vector multiplyAdd(Vector a, Vector b, Vector c) noexcept { return _mm256_fmadd_pd(a, b, c); }
+	};
+
+	template<>
+	struct MatrixLanes<float> {
+		using Vector = __m256;
+		static constexpr size_t WIDTH = 8;
+		static constexpr size_t KERNEL_ROWS = 6;
+		static constexpr size_t KERNEL_VECTORS = 2;
+
+		static Vector zero() noexcept { return _mm256_setzero_ps(); }
+		static Vector load(const float* source) noexcept { return _mm256_loadu_ps(source); }
+		static void store(float* target, Vector value) noexcept { _mm256_storeu_ps(target, value); }
+		static Vector broadcast(float value) noexcept { return _mm256_set1_ps(value); }
+		static Vector add(Vector a, Vector b) noexcept { return _mm256_add_ps(a, b); }
+		static Vector subtract(Vector a, Vector b) noexcept { return _mm256_sub_ps(a, b); }
+		static Vector multiply(Vector a, Vector b) noexcept { return _mm256_mul_ps(a, b); }
+		static Vector divide(Vector a, Vector b) noexcept { return _mm256_div_ps(a, b); }
+		static Vector multiplyAdd(Vector a, Vector b, Vector c) noexcept { return _mm256_fmadd_ps(a, b, c); }
+	};
+#elif ENGINE_SSE2
+	template<>
+	struct MatrixLanes<double> {
+		using Vector = __m128d;
+		static constexpr size_t WIDTH = 2;
+		static constexpr size_t KERNEL_ROWS = 6;
+		static constexpr size_t KERNEL_VECTORS = 2;
+
+		static Vector zero() noexcept { return _mm_setzero_pd(); }
+		static Vector load(const double* source) noexcept { return _mm_loadu_pd(source); }
+		static void store(double* target, Vector value) noexcept { _mm_storeu_pd(target, value); }
+		static Vector broadcast(double value) noexcept { return _mm_set1_pd(value); }
+		static Vector add(Vector a, Vector b) noexcept { return _mm_add_pd(a, b); }
+		static Vector subtract(Vector a, Vector b) noexcept { return _mm_sub_pd(a, b); }
+		static Vector multiply(Vector a, Vector b) noexcept { return _mm_mul_pd(a, b); }
+		static Vector divide(Vector a, Vector b) noexcept { return _mm_div_pd(a, b); }
+		static Vector multiplyAdd(Vector a, Vector b, Vector c) noexcept { return _mm_add_pd(c, _mm_mul_pd(a, b)); }
+	};
+
+	template<>
+	struct MatrixLanes<float> {
+		using Vector = __m128;
+		static constexpr size_t WIDTH = 4;
+		static constexpr size_t KERNEL_ROWS = 6;
+		static constexpr size_t KERNEL_VECTORS = 2;
+
+		static Vector zero() noexcept { return _mm_setzero_ps(); }
+		static Vector load(const float* source) noexcept { return _mm_loadu_ps(source); }
+		static void store(float* target, Vector value) noexcept { _mm_storeu_ps(target, value); }
+		static Vector broadcast(float value) noexcept { return _mm_set1_ps(value); }
+		static Vector add(Vector a, Vector b) noexcept { return _mm_add_ps(a, b); }
+		static Vector subtract(Vector a, Vector b) noexcept { return _mm_sub_ps(a, b); }
+		static Vector multiply(Vector a, Vector b) noexcept { return _mm_mul_ps(a, b); }
+		static Vector divide(Vector a, Vector b) noexcept { return _mm_div_ps(a, b); }
+		static Vector multiplyAdd(Vector a, Vector b, Vector c) noexcept { return _mm_add_ps(c, _mm_mul_ps(a, b)); }
+	};
+#endif
+}
@@ -0,0 +1,315 @@
+#pragma once
+#include "../../Public/Abstraction/Set.h"
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace core {
+
+	/**
+	* A compressed bitmap Set implementation for unsigned integers in the style of Roaring bitmaps. Items
+	* are split by their high bits into chunks of 2^16 values, and each chunk present keeps its low 16
+	* bits in the container that suits its content best: a sorted array while it holds at most
+	* ARRAY_LIMIT items, a bitmap of 2^16 bits above that, or a list of runs for clustered items once
+	* optimize has found runs to be smaller. The chunks are kept sorted by their high bits, so items are
+	* iterated in increasing order.
+	*
+	* The bulk operations combine two RoaringSets chunk by chunk and container by container. Bitmaps are
+	* combined a vector of words at a time, sorted arrays are intersected and subtracted by comparing
+	* blocks of eight items against each other with AVX2 or SSE2, and gallop through the larger one when
+	* their sizes differ widely. Runs meet runs as intervals. Without SSE2 the blocks are compared item by
+	* item.
+	* Other Set implementations are combined item by item
+	*/
+	S_IMPLEMENTATION_CLASS(RoaringSet, Set<E>, Nature::MUTABLE, Behavior::DYNAMIC, Ordering::SORTED)
+	static_assert(std::is_integral_v<E> && std::is_unsigned_v<E>, "RoaringSet requires unsigned integer items");
+
+	/**
+	* Largest number of items held by an array container, beyond it a bitmap is smaller
+	*/
+	static constexpr size_t ARRAY_LIMIT = 4096;
+
+	/**
+	* Number of 64 bit words of a bitmap container
+	*/
+	static constexpr size_t BITMAP_WORDS = 1024;
+
+	/**
+	* Low 16 bits of the items of one chunk. An array holds them sorted, a run holds pairs of the first
+	* value and the length minus one of each run, sorted and separated by at least one missing value
+	*/
+	struct Container {
+		enum class Kind : uint8_t { ARRAY, BITMAP, RUN };
+
+		Kind kind = Kind::ARRAY;
+		uint32_t cardinality = 0;
+		EngineVector<uint16_t, Allocator> values; //Array and run containers
+		EngineVector<uint64_t, Allocator> words; //Bitmap containers
+
+		explicit Container(const Allocator& allocator) : values(allocator), words(allocator) {}
+
+		//A copy draws from the given allocator, by default from the one of the copied container
+		Container(const Container& other, const Allocator& allocator) : kind(other.kind), cardinality(other.cardinality),
+			values(other.values, allocator), words(other.words, allocator) {}
+		Container(const Container& other) : Container(other, other.get_allocator()) {}
+		Container(Container&& other) noexcept = default;
+		Container& operator=(const Container& other) = default;
+		Container& operator=(Container&& other) = default;
+
+		Allocator get_allocator() const { return Allocator(values.get_allocator()); }
+	};
+
+	/**
+	* Iterator over the items in increasing order. Items are decoded from their containers, so they are
+	* returned by value
+	*/
+	class RoaringSetIterator : public Iterator<RoaringSetIterator, const E> {
+		const RoaringSet* set = nullptr;
+		size_t chunk = 0;
+		size_t position = 0; //Index in an array, bit in a bitmap, pair in a run
+		uint32_t offset = 0; //Offset within the current run
+		E current = 0;
+
+		void settle();
+	public:
+		using reference = E;
+		using pointer = void;
+
+		RoaringSetIterator() = default;
+		RoaringSetIterator(const RoaringSet* set, size_t chunk) : set(set), chunk(chunk), position(0), offset(0), current(0) {
+			settle();
+		}
+
+		E operator*() const { return current; }
+
+		RoaringSetIterator& operator++();
+
+		bool operator==(const RoaringSetIterator& other) const {
+			return chunk == other.chunk && position == other.position && offset == other.offset;
+		}
+	};
+
+	/**
+	* Creates an empty set
+	*/
+	RoaringSet();
+
+	/**
+	* Creates an empty set drawing its containers from the given allocator
+	* @param allocator Allocator of the containers
+	*/
+	explicit RoaringSet(const Allocator& allocator);
+
+	/**
+	* Creates a set from items in any order, building each container in one pass
+	* @param items The items, duplicates are kept once
+	* @param count Number of items
+	* @param allocator Allocator of the containers
+	*/
+	RoaringSet(const E* items, size_t count, const Allocator& allocator = Allocator());
+
+	~RoaringSet() override = default;
+
+	//Adding move semantics
+	RoaringSet(RoaringSet&& other) noexcept;
+	RoaringSet& operator=(RoaringSet&& other) noexcept(takesStorageOnMove<Allocator>);
+
+	bool add(E item) override;
+	bool remove(E item) override;
+	[[nodiscard]] bool contains(E item) const override;
+
+	/**
+	* Converts each container to runs when they take less memory, and back when they do not
+	* @return Returns true if a container changed form
+	*/
+	bool optimize();
+
+	/**
+	* @return Returns the number of bytes held by the containers and the chunk index
+	*/
+	[[nodiscard]] size_t getMemoryUsage() const noexcept;
+
+	/**
+	* @return Returns the smallest item
+	* @throws std::out_of_range if the set is empty
+	*/
+	[[nodiscard]] E first() const;
+
+	/**
+	* @return Returns the largest item
+	* @throws std::out_of_range if the set is empty
+	*/
+	[[nodiscard]] E last() const;
+
+	std::unique_ptr<DataEngine<E>> clone() const override;
+	std::unique_ptr<DataEngine<E>> move() override;
+
+	bool removeAll() override;
+
+	/**
+	* @return Returns the items in increasing order
+	*/
+	E* toArray() const override;
+
+	/**
+	* @return Returns the items of the given ranks in increasing order
+	*/
+	E* toArray(int start, int end) const override;
+	size_t copyTo(std::span<E> destination, size_t start) const override;
+
+	/**
+	* The order is fixed by the items, reversing leaves the set untouched
+	*/
+	void reverse() override;
+
+	RoaringSetIterator begin() const;
+	RoaringSetIterator end() const;
+
+protected:
+	//Containers are sized to their content
+	void grow() override;
+	void shrink() override;
+
+	/**
+	* Same as optimize
+	*/
+	void compress() override;
+
+	[[nodiscard]] bool containsAllInternal(std::any* set) override;
+	bool addAllInternal(std::any* set) override;
+	bool retainAllInternal(std::any* set) override;
+	bool discardAllInternal(std::any* set) override;
+
+	/**
+	* Equal sets hold the same items
+	*/
+	[[nodiscard]] bool equalsInternal(const DataEngine<E>& de) const override;
+
+	/**
+	* Sets carry no order of their own, so equivalence and equality coincide
+	*/
+	[[nodiscard]] bool equivalenceInternal(const DataEngine<E>& de) const override;
+
+	/**
+	* Adds the items of the given ranks of the other set to a copy of the invoking set
+	*/
+	[[nodiscard]] std::unique_ptr<DataEngine<E>> mergeInternal(const DataEngine<E>& de, int start, int end) const override;
+
+private:
+	using Key = std::conditional_t<(sizeof(E) > 2), E, uint16_t>;
+
+	EngineVector<Key, Allocator> keys; //High bits of the chunks, increasing
+	EngineVector<Container, Allocator> containers;
+
+	static Key keyOf(E item) noexcept { return static_cast<Key>(static_cast<uint64_t>(item) >> 16); }
+	static uint16_t lowOf(E item) noexcept { return static_cast<uint16_t>(item); }
+	static E itemOf(Key key, uint32_t low) noexcept {
+		return static_cast<E>((static_cast<uint64_t>(key) << 16) | low);
+	}
+
+	/**
+	* @return Returns the index of the chunk, or the one-complement of where it would be inserted
+	*/
+	[[nodiscard]] ptrdiff_t find(Key key) const noexcept;
+
+	/**
+	* Recounts the items after the containers were replaced
+	*/
+	void recount() noexcept;
+
+	/**
+	* Drops the empty containers and their keys
+	*/
+	void prune();
+
+	/**
+	* @return Returns true if every item of the other set is present in the invoking one
+	*/
+	[[nodiscard]] bool covers(const Set<E>* other) const;
+
+	/**
+	* Adds every item of the other set to the invoking one, chunk by chunk when it is a RoaringSet
+	* @return Returns true if the invoking set changed
+	*/
+	bool absorb(const Set<E>* other);
+
+	/**
+	* Empties the vector and gives its storage back to its allocator
+	*/
+	template<typename Vector>
+	static void discard(Vector& vector) noexcept {
+		Vector(vector.get_allocator()).swap(vector);
+	}
+
+	//Container level operations, on the low 16 bits
+	static bool probe(const Container& container, uint16_t low) noexcept;
+	static bool insert(Container& container, uint16_t low);
+	static bool erase(Container& container, uint16_t low);
+	static uint16_t minimum(const Container& container) noexcept;
+	static uint16_t maximum(const Container& container) noexcept;
+
+	/**
+	* Writes the values of a container in increasing order, returns the end of the output
+	*/
+	static uint16_t* decode(const Container& container, uint16_t* out) noexcept;
+
+	/**
+	* Sets the bits from first to last, both included
+	*/
+	static void fill(uint64_t* words, uint32_t first, uint32_t last) noexcept;
+
+	/**
+	* Turns a run container into an array or a bitmap holding the same values
+	*/
+	static void expand(Container& container);
+
+	/**
+	* Turns a bitmap with at most ARRAY_LIMIT items into an array, and an array above it into a bitmap
+	*/
+	static void normalize(Container& container);
+
+	/**
+	* Converts the container to runs if they are smaller, or a run container to its expanded form if
+	* they are not
+	* @return Returns true if the container changed form
+	*/
+	static bool compact(Container& container);
+
+	/**
+	* @return Returns the number of bytes of the container
+	*/
+	static size_t footprint(const Container& container) noexcept;
+
+	static Container unite(const Container& a, const Container& b);
+	static Container intersect(const Container& a, const Container& b);
+	static Container subtract(const Container& a, const Container& b);
+	static bool includes(const Container& a, const Container& b);
+
+	/**
+	* Compares a block of eight sorted values with another
+	* @return Returns a mask whose bit i is set when a[i] is one of the values of b
+	*/
+	static uint32_t matchBlock(const uint16_t* a, const uint16_t* b) noexcept;
+
+	/**
+	* Intersects or subtracts two sorted arrays, keeping the items of a found, or not found, in b
+	* @return Returns the end of the output
+	*/
+	static uint16_t* filter(const uint16_t* a, size_t aSize, const uint16_t* b, size_t bSize, bool keep, uint16_t* out) noexcept;
+
+	/**
+	* Word operations bitmaps are combined with
+	*/
+	enum class Logic { OR, AND, AND_NOT };
+
+	/**
+	* Combines two bitmaps word by word
+	* @return Returns the cardinality of the result
+	*/
+	template<Logic logic>
+	static uint32_t combine(const uint64_t* a, const uint64_t* b, uint64_t* out) noexcept;
+	E_ENGINE_CLASS
+}
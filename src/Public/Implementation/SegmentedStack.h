@@ -0,0 +1,219 @@
+#pragma once
+#include "../../Public/Abstraction/Stack.h"
+#include <algorithm>
+#include <memory>
+#include <new>
+
+namespace core {
+
+	/**
+	* A Stack implementation made of a chain of fixed-size blocks of BLOCK_SIZE items. Pushing into a full
+	* block moves on to the next block of the chain instead of reallocating, so items are never copied or
+	* moved once pushed and their addresses stay valid until they are popped. Every operation is O(1)
+	* without amortization.
+	*
+	* Blocks emptied by pops are kept at the end of the chain as spares, and pushes reuse them before
+	* asking the allocator for a new block. Up to CACHED_BLOCKS spares are kept, so pushes and pops
+	* oscillating around a block boundary never reach the allocator. reserve adds spares up front,
+	* compress releases them all.
+	*
+	* Blocks are the only memory the stack draws from its allocator. A std::pmr::polymorphic_allocator over
+	* a std::pmr::monotonic_buffer_resource makes it arena-backed: blocks are carved from the arena and
+	* freed all at once with it, which suits stacks rebuilt from scratch on every run of a computation
+	*/
+	S_IMPLEMENTATION_CLASS(SegmentedStack, Stack<E>, Nature::MUTABLE, Behavior::DYNAMIC, Ordering::UNSORTED)
+
+	/**
+	* Bytes of items per block, a block holds at least 16 items
+	*/
+	static constexpr size_t BLOCK_BYTES = 16384;
+
+	/**
+	* Items per block
+	*/
+	static constexpr size_t BLOCK_SIZE = std::max<size_t>(BLOCK_BYTES / sizeof(E), 16);
+
+	/**
+	* Largest number of empty blocks kept above the top for later pushes
+	*/
+	static constexpr size_t CACHED_BLOCKS = 2;
+
+	/**
+	* Link of the chain, followed by the storage of its items
+	*/
+	struct Block {
+		Block* below;
+		Block* above;
+		alignas(E) unsigned char storage[BLOCK_SIZE * sizeof(E)];
+
+		E* items() noexcept { return std::launder(reinterpret_cast<E*>(storage)); }
+		const E* items() const noexcept { return std::launder(reinterpret_cast<const E*>(storage)); }
+	};
+
+	/**
+	* Iterator over the items of a SegmentedStack, from the bottom to the top
+	* @tparam T E, or const E for the iterators of a const stack
+	*/
+	template<typename T>
+	class SegmentedStackIterator : public Iterator<SegmentedStackIterator<T>, T, std::bidirectional_iterator_tag> {
+		Block* block = nullptr;
+		Block* top = nullptr;
+		size_t index = 0;
+	public:
+		SegmentedStackIterator() = default;
+		SegmentedStackIterator(Block* block, Block* top, size_t index) : block(block), top(top), index(index) { settle(); }
+
+		T& operator*() const { return block->items()[index]; }
+		T* operator->() const { return block->items() + index; }
+
+		SegmentedStackIterator& operator++() { ++index; settle(); return *this; }
+
+		SegmentedStackIterator& operator--() {
+			if (index == 0) {
+				block = block->below;
+				index = BLOCK_SIZE;
+			}
+			--index;
+			return *this;
+		}
+
+		bool operator==(const SegmentedStackIterator& other) const { return block == other.block && index == other.index; }
+	private:
+		void settle() {
+			if (index == BLOCK_SIZE && block != top) {
+				block = block->above;
+				index = 0;
+			}
+		}
+	};
+
+	using iterator = SegmentedStackIterator<E>;
+	using const_iterator = SegmentedStackIterator<const E>;
+
+	/**
+	* Creates an empty stack, the first block is allocated by the first push
+	*/
+	SegmentedStack();
+
+	/**
+	* Creates an empty stack drawing its blocks from the given allocator
+	* @param allocator Allocator of the blocks
+	*/
+	explicit SegmentedStack(const Allocator& allocator);
+
+	/**
+	* Creates an empty stack able to hold the given number of items without allocating
+	* @param capacity Initial capacity
+	* @param allocator Allocator of the blocks
+	*/
+	explicit SegmentedStack(size_t capacity, const Allocator& allocator = Allocator());
+
+	~SegmentedStack() override;
+
+	//Adding move semantics
+	SegmentedStack(SegmentedStack&& other) noexcept;
+	SegmentedStack& operator=(SegmentedStack&& other) noexcept(takesStorageOnMove<Allocator>);
+
+	bool push(E item) override;
+
+	/**
+	* Constructs an item in place at the top of the stack
+	* @param args Arguments of the constructor of E
+	* @return Returns the new item, whose address stays valid until it is popped
+	*/
+	template<typename... Args>
+	E& emplace(Args&&... args);
+
+	bool pop(E& item) override;
+
+	/**
+	* Removes the item at the top of the stack without returning it
+	* @return Returns true if an item was removed, false if the stack is empty
+	*/
+	bool pop();
+
+	[[nodiscard]] E* peek() override;
+
+	/**
+	* Gets the item at the given position, counted from the bottom, walking the chain from the nearer end
+	* @param index Position of the item
+	* @return Returns the item, nullptr if the position is out of range
+	*/
+	[[nodiscard]] E* get(size_t index);
+
+	std::unique_ptr<DataEngine<E>> clone() const override;
+	std::unique_ptr<DataEngine<E>> move() override;
+
+	bool removeAll() override;
+	E* toArray() const override;
+	E* toArray(int start, int end) const override;
+	size_t copyTo(std::span<E> destination, size_t start) const override;
+	void reverse() override;
+
+	iterator begin();
+	iterator end();
+	const_iterator begin() const;
+	const_iterator end() const;
+
+	/**
+	* Ensures that the stack can hold the given number of items without allocating, the blocks needed are
+	* added as spares and are not trimmed until compress
+	* @param capacity Required capacity
+	*/
+	void reserve(size_t capacity);
+
+protected:
+	/**
+	* Adds a spare block to the end of the chain
+	*/
+	void grow() override;
+
+	/**
+	* Releases the spare blocks beyond CACHED_BLOCKS
+	*/
+	void shrink() override;
+
+	/**
+	* Releases every spare block
+	*/
+	void compress() override;
+
+	[[nodiscard]] bool equalsInternal(const DataEngine<E>& de) const override;
+	[[nodiscard]] bool equivalenceInternal(const DataEngine<E>& de) const override;
+	[[nodiscard]] std::unique_ptr<DataEngine<E>> mergeInternal(const DataEngine<E>& de, int start, int end) const override;
+
+private:
+	Block* bottom; //First block of the chain
+	Block* top; //Block holding the top item, the bottom block when the stack is empty
+	Block* last; //Last block of the chain, spares lie between top and last
+	size_t used; //Items in the top block
+	size_t spares; //Blocks above the top
+	size_t reserved; //Blocks asked for by reserve, the chain is not trimmed below them
+
+	/**
+	* Gives the block above the top, taking a spare or allocating a block, without moving the top
+	*/
+	Block* following();
+
+	/**
+	* Releases spare blocks from the end of the chain until the given number is left, without going
+	* under the reserved blocks unless forced
+	*/
+	void trim(size_t keep, bool force) noexcept;
+
+	/**
+	* Destroys all the items and releases every block
+	*/
+	void release() noexcept;
+
+	/**
+	* Calls the visitor with each run of consecutive items, from the bottom to the top
+	*/
+	template<typename Visitor>
+	void forEachRun(Visitor&& visitor) const;
+
+	Block* allocate() const;
+	void deallocate(Block* block) const noexcept;
+
+	E_ENGINE_CLASS
+}
@@ -0,0 +1,318 @@
+#pragma once
+#include "../../Public/Abstraction/Trie.h"
+#include <concepts>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace core {
+
+	/**
+	* An immutable succinct implementation of Trie, built once from a sorted key set. The shape of the trie
+	* is encoded with LOUDS, the level-order unary degree sequence: nodes are numbered breadth first and
+	* each contributes its degree in unary, so the whole shape takes 2n + 1 bits for n nodes. Edge labels
+	* take one byte per node and a second bitvector marks the nodes at which a key ends, about 10 bits per
+	* node in all. Navigation needs select on the zeros of the shape and rank on the terminal marks, both
+	* answered in constant time from small directories: one cumulative count per 512 bits, and for select
+	* one sample per 512 zeros.
+	*
+	* The encoding is a single block of fixed-width integers at offsets from its start, with no pointers,
+	* so it can be written to a file as is and used straight from a memory-mapped copy of that file: the
+	* view constructor only checks the header, whose section offsets and size must match its counts. Values
+	* are stored in the encoding as well and must be trivially copyable. The encoding uses the byte order
+	* of the machine that built it.
+	*
+	* Keys are std::string, ordered by their bytes. Every method that would modify the trie throws
+	* std::logic_error, merging builds a new trie instead
+	*/
+	S_MAP_IMPLEMENTATION_CLASS(SuccinctTrie, Trie, Nature::IMMUTABLE, Behavior::FIXED_LENGTH, Ordering::SORTED)
+	static_assert(std::same_as<K, std::string>, "SuccinctTrie requires std::string keys");
+	static_assert(std::is_trivially_copyable_v<V>, "SuccinctTrie stores its values in the encoding, they must be trivially copyable");
+
+	/**
+	* Iterator over the entries in ascending key order, rebuilding each key along the way
+	*/
+	class SuccinctTrieIterator : public Iterator<SuccinctTrieIterator, const E> {
+		struct Frame {
+			size_t next; //Next child to visit
+			size_t end;
+		};
+		const SuccinctTrie* trie = nullptr;
+		std::vector<Frame> path;
+		std::string key;
+		size_t node = NONE;
+	public:
+		using reference = E;
+		using pointer = void;
+
+		SuccinctTrieIterator() = default;
+		explicit SuccinctTrieIterator(const SuccinctTrie* trie) : trie(trie), node(NONE) {
+			if (trie != nullptr && trie->getActiveSize() > 0) {
+				auto [first, count] = trie->children(0);
+				path.push_back({ first, first + count });
+				if (trie->terminal(0)) {
+					node = 0;
+				}
+				else {
+					advance();
+				}
+			}
+		}
+
+		E operator*() const { return E{ key, trie->valueOf(node) }; }
+
+		SuccinctTrieIterator& operator++() { advance(); return *this; }
+
+		bool operator==(const SuccinctTrieIterator& other) const { return node == other.node; }
+	private:
+		void advance() {
+			//Preorder walk, the key holds one label per frame below the root
+			while (!path.empty()) {
+				Frame& frame = path.back();
+				if (frame.next == frame.end) {
+					path.pop_back();
+					key.resize(path.empty() ? 0 : path.size() - 1);
+					continue;
+				}
+				const size_t child = frame.next++;
+				key.push_back(static_cast<char>(trie->labels[child - 1]));
+				auto [first, count] = trie->children(child);
+				path.push_back({ first, first + count });
+				if (trie->terminal(child)) {
+					node = child;
+					return;
+				}
+			}
+			node = NONE;
+		}
+	};
+
+	/**
+	* Creates an empty trie
+	*/
+	SuccinctTrie();
+
+	/**
+	* Creates an empty trie whose clones and merges draw their encoding from the given allocator
+	* @param allocator Allocator of the encodings
+	*/
+	explicit SuccinctTrie(const Allocator& allocator);
+
+	/**
+	* Builds the trie from sorted entries in time linear in the total key length
+	* @param entries Entries sorted by strictly increasing key
+	* @param count Number of entries
+	* @param allocator Allocator of the encoding
+	* @throws std::invalid_argument if the keys are not strictly increasing
+	*/
+	SuccinctTrie(const E* entries, size_t count, const Allocator& allocator = Allocator());
+
+	/**
+	* Uses an encoding in place, without copying or decoding it. The memory must stay valid and unchanged
+	* for the lifetime of the trie, typically a read-only mapping of a file written from getEncoding
+	* @param encoding Start of the encoding, aligned to 8 bytes, its sections start on cache lines when aligned to 64
+	* @param size Number of bytes available
+	* @param allocator Allocator of the encodings of clones and merges, the view itself allocates none
+	* @throws std::invalid_argument if the memory does not hold a whole encoding built for this value type
+	*/
+	SuccinctTrie(const void* encoding, size_t size, const Allocator& allocator = Allocator());
+
+	~SuccinctTrie() override = default;
+
+	//Adding move semantics, the other trie is left holding an encoding of its own for no entries, which is
+	//allocated and may throw
+	SuccinctTrie(SuccinctTrie&& other);
+	SuccinctTrie& operator=(SuccinctTrie&& other);
+
+	/**
+	* @throws std::logic_error The trie is immutable
+	*/
+	bool put(K key, V value) override;
+	[[nodiscard]] bool get(const K& key, V& value) const override;
+
+	/**
+	* @throws std::logic_error The trie is immutable
+	*/
+	bool remove(const K& key) override;
+	[[nodiscard]] bool containsKey(const K& key) const override;
+	[[nodiscard]] bool containsValue(const V& value) override;
+	size_t scanPrefix(const K& prefix, std::function<bool(const E&)> visitor) const override;
+	[[nodiscard]] bool longestPrefix(const K& key, E& entry) const override;
+
+	/**
+	* @return Returns the start of the encoding, which can be saved and later used through the view
+	* constructor
+	*/
+	[[nodiscard]] const void* getEncoding() const;
+
+	/**
+	* @return Returns the size of the encoding in bytes, directories and values included
+	*/
+	[[nodiscard]] size_t getEncodedSize() const;
+
+	/**
+	* @return Returns the number of nodes, the root included
+	*/
+	[[nodiscard]] size_t getNodeCount() const;
+
+	/**
+	* Copies the encoding, a copy of a view owns its memory
+	*/
+	std::unique_ptr<DataEngine<E>> clone() const override;
+	std::unique_ptr<DataEngine<E>> move() override;
+
+	/**
+	* @throws std::logic_error The trie is immutable
+	*/
+	bool removeAll() override;
+	E* toArray() const override;
+	E* toArray(int start, int end) const override;
+	size_t copyTo(std::span<E> destination, size_t start) const override;
+
+	/**
+	* The order is fixed by the key bytes, reversing leaves the trie untouched
+	*/
+	void reverse() override;
+
+	SuccinctTrieIterator begin() const;
+	SuccinctTrieIterator end() const;
+
+protected:
+	//The size is fixed when the trie is built
+	void grow() override;
+	void shrink() override;
+	void compress() override;
+
+	[[nodiscard]] bool equalsInternal(const DataEngine<E>& de) const override;
+	[[nodiscard]] bool equivalenceInternal(const DataEngine<E>& de) const override;
+
+	/**
+	* Builds a new trie holding the union of both, the other trie's value wins on equal keys
+	*/
+	[[nodiscard]] std::unique_ptr<DataEngine<E>> mergeInternal(const DataEngine<E>& de, int start, int end) const override;
+
+private:
+	static constexpr uint32_t MAGIC = 0x53554354; //Reads differently on a machine of the other byte order
+	static constexpr uint32_t VERSION = 1;
+	static constexpr size_t BLOCK_BITS = 512; //Bits per rank directory entry
+	static constexpr size_t BLOCK_WORDS = BLOCK_BITS / 64;
+	static constexpr size_t SELECT_SAMPLE = 512; //Zeros per select sample
+	static constexpr size_t SECTION_ALIGNMENT = 64;
+	static constexpr size_t NONE = SIZE_MAX;
+
+	/**
+	* Start of the encoding, all offsets are in bytes from it
+	*/
+	struct Header {
+		uint32_t magic;
+		uint32_t version;
+		uint32_t valueSize;
+		uint32_t reserved;
+		uint64_t keyCount;
+		uint64_t nodeCount;
+		uint64_t louds; //2n + 1 shape bits
+		uint64_t loudsRanks; //Ones before each block, plus the total
+		uint64_t loudsSelects; //Block holding every SELECT_SAMPLE-th zero
+		uint64_t labels; //Label of node i at i - 1, the root has none
+		uint64_t terminals; //Bit i set if a key ends at node i
+		uint64_t terminalRanks;
+		uint64_t values; //Values in the order of the terminal nodes
+		uint64_t size;
+	};
+
+	/**
+	* Unit of the owned encoding, aligned so that every section starts on a cache line of its own
+	*/
+	struct alignas(SECTION_ALIGNMENT) Line {
+		uint64_t words[SECTION_ALIGNMENT / sizeof(uint64_t)];
+	};
+
+	EngineVector<Line, Allocator> storage; //Empty for a view
+	const Header* header;
+	const uint64_t* louds;
+	const uint64_t* loudsRanks;
+	const uint32_t* loudsSelects;
+	const uint8_t* labels;
+	const uint64_t* terminals;
+	const uint64_t* terminalRanks;
+	const uint8_t* values;
+
+	/**
+	* Points the section pointers into the encoding
+	*/
+	void bind(const void* encoding) noexcept;
+
+	/**
+	* Encodes the entries into owned storage
+	*/
+	void build(const E* entries, size_t count);
+
+	/**
+	* Lays the sections out one after the other, each at a multiple of SECTION_ALIGNMENT from the start
+	* @return Returns the header of the encoding of the given number of keys and nodes
+	*/
+	static Header layout(size_t keys, size_t nodes) noexcept;
+
+	/**
+	* Fills a rank directory for a bitvector
+	*/
+	static void rankDirectory(const uint64_t* bits, size_t words, uint64_t* ranks) noexcept;
+
+	static size_t rank(const uint64_t* bits, const uint64_t* ranks, size_t position) noexcept;
+
+	/**
+	* @return Returns the position of the zero with the given index in the shape
+	*/
+	size_t select0(size_t index) const noexcept;
+
+	/**
+	* @return Returns the position of the first zero of the shape at or after the position
+	*/
+	size_t nextZero(size_t position) const noexcept;
+
+	/**
+	* @return Returns the first child and the number of children of a node
+	*/
+	std::pair<size_t, size_t> children(size_t node) const noexcept;
+
+	/**
+	* @return Returns the child of the node reached through the label, NONE if there is none
+	*/
+	size_t child(size_t node, uint8_t label) const noexcept;
+
+	/**
+	* @return Returns the node reached by the bytes, NONE if they leave the trie
+	*/
+	size_t descend(const std::string& bytes) const noexcept;
+
+	bool terminal(size_t node) const noexcept { return (terminals[node / 64] >> (node % 64)) & 1; }
+
+	/**
+	* @return Returns the value of a terminal node
+	*/
+	V valueOf(size_t node) const noexcept;
+
+	/**
+	* Visits the keys of the subtree in order, the key holds the bytes leading to the node
+	* @return Returns false if the visitor stopped the walk
+	*/
+	template<typename Function>
+	bool walk(size_t node, std::string& key, Function& visitor) const {
+		if (terminal(node) && !visitor(static_cast<const E&>(E{ key, valueOf(node) }))) {
+			return false;
+		}
+		auto [first, count] = children(node);
+		for (size_t i = first; i < first + count; i++) {
+			key.push_back(static_cast<char>(labels[i - 1]));
+			if (!walk(i, key, visitor)) {
+				return false;
+			}
+			key.pop_back();
+		}
+		return true;
+	}
+	E_ENGINE_CLASS
+}
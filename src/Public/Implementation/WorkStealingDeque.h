@@ -0,0 +1,212 @@
+#pragma once
+#include "../../Public/Abstraction/Deque.h"
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+
+namespace core {
+
+	/**
+	* A Chase-Lev work-stealing Deque implementation. A single owner thread pushes and pops at the tail
+	* through addLast/removeLast without locks, while any number of thief threads take items from the
+	* head through steal/removeFirst with one CAS each. Memory ordering follows the C11 formulation of
+	* Le et al., which is correct on weakly ordered processors such as ARM as well as on x86.
+	*
+	* The ring grows through grow() once the load crosses GROWTH_LOAD_FACTOR. Retired rings are kept
+	* until destruction because thieves may still be reading them, they add up to less than the live ring.
+	* Items are read speculatively by thieves before their CAS, so the element type must be trivially
+	* copyable, e.g. a task pointer. addFirst and mergeFirst are not supported and return false/nullptr.
+	* Every other operation besides steal, removeFirst, peekFirst and getActiveSize is owner-only, and the
+	* whole-deque operations (sort, reverse, retainAll, clone, toArray, equality, merge, iteration) also
+	* require that no thief is running
+	*/
+	S_IMPLEMENTATION_CLASS(WorkStealingDeque, Deque<E>, Nature::THREAD_MUTABLE, Behavior::DYNAMIC, Ordering::UNSORTED)
+	static_assert(std::is_trivially_copyable_v<E>, "WorkStealingDeque requires a trivially copyable element type");
+
+	/**
+	* A slot of the ring, aligned so that it can be accessed through std::atomic_ref
+	*/
+	struct Slot {
+		alignas(std::atomic_ref<E>::required_alignment) E value;
+	};
+
+	/**
+	* A power of two ring of slots indexed by absolute position. Each ring keeps the one it replaced
+	*/
+	struct Ring {
+		size_t capacity;
+		size_t mask;
+		Slot* slots;
+		Ring* previous;
+
+		Ring(size_t capacity, Slot* slots, Ring* previous) : capacity(capacity), mask(capacity - 1), slots(slots), previous(previous) {}
+
+		E load(std::ptrdiff_t position) const noexcept {
+			return std::atomic_ref<E>(slots[static_cast<size_t>(position) & mask].value).load(std::memory_order_relaxed);
+		}
+
+		void store(std::ptrdiff_t position, E item) noexcept {
+			std::atomic_ref<E>(slots[static_cast<size_t>(position) & mask].value).store(item, std::memory_order_relaxed);
+		}
+	};
+
+	/**
+	* Iterator over the items from head to tail, only valid while no thread modifies the deque
+	* @tparam T E, or const E for the iterators of a const deque
+	*/
+	template<typename T>
+	class WorkStealingDequeIterator : public Iterator<WorkStealingDequeIterator<T>, T, std::bidirectional_iterator_tag> {
+		Ring* ring = nullptr;
+		std::ptrdiff_t position = 0;
+	public:
+		WorkStealingDequeIterator() = default;
+		WorkStealingDequeIterator(Ring* ring, std::ptrdiff_t position) : ring(ring), position(position) {}
+
+		T& operator*() const { return ring->slots[static_cast<size_t>(position) & ring->mask].value; }
+		T* operator->() const { return &ring->slots[static_cast<size_t>(position) & ring->mask].value; }
+
+		WorkStealingDequeIterator& operator++() { ++position; return *this; }
+		WorkStealingDequeIterator& operator--() { --position; return *this; }
+
+		bool operator==(const WorkStealingDequeIterator& other) const { return position == other.position; }
+	};
+
+	using iterator = WorkStealingDequeIterator<E>;
+	using const_iterator = WorkStealingDequeIterator<const E>;
+
+	/**
+	* Creates an empty deque with DEFAULT_CAPACITY
+	*/
+	WorkStealingDeque();
+
+	/**
+	* Creates an empty deque with DEFAULT_CAPACITY drawing its rings from the given allocator
+	* @param allocator Allocator of the rings
+	*/
+	explicit WorkStealingDeque(const Allocator& allocator);
+
+	/**
+	* Creates an empty deque able to hold the given number of items before growing
+	* @param capacity Initial capacity
+	* @param allocator Allocator of the rings
+	*/
+	explicit WorkStealingDeque(size_t capacity, const Allocator& allocator = Allocator());
+
+	~WorkStealingDeque() override;
+
+	/**
+	* Not supported, only the owner's tail accepts items
+	* @return Returns false
+	*/
+	bool addFirst(E item) override;
+
+	/**
+	* Owner-only. Pushes the item at the tail, growing the ring if required
+	* @param item The item to be added
+	* @return Returns true
+	*/
+	bool addLast(E item) override;
+
+	/**
+	* Thief-safe. Steals the item at the head, retrying while other thieves win the race
+	* @return Returns the stolen item
+	* @throws std::out_of_range if the deque is observed empty
+	*/
+	[[nodiscard]] E removeFirst() override;
+
+	/**
+	* Owner-only. Pops the item at the tail
+	* @return Returns the popped item
+	* @throws std::out_of_range if the deque is empty or the last item was stolen meanwhile
+	*/
+	[[nodiscard]] E removeLast() override;
+
+	/**
+	* Thief-safe. Makes a single attempt to steal the item at the head
+	* @param item Receives the stolen item
+	* @return Returns true if an item was stolen, false if the deque was empty or another thief won
+	*/
+	bool steal(E& item);
+
+	/**
+	* Owner-only. Pops the item at the tail without throwing
+	* @param item Receives the popped item
+	* @return Returns true if an item was popped, false if the deque was empty or the last item was stolen
+	*/
+	bool tryRemoveLast(E& item);
+
+	/**
+	* Thief-safe. The returned item may be stolen by the time the caller looks at it
+	* @return Returns the item at the head
+	* @throws std::out_of_range if the deque is observed empty
+	*/
+	[[nodiscard]] E peekFirst() override;
+	[[nodiscard]] E peekLast() override;
+
+	[[nodiscard]] bool contains(E item) override;
+
+	using Deque<E>::replaceAll;
+	void replaceAll(std::function<E* (E*)> operatorFunction, int start, int end) override;
+
+	/**
+	* @return Returns the number of items at some instant during the call
+	*/
+	[[nodiscard]] size_t getActiveSize() const override;
+
+	/**
+	* Sorts the items from head to tail through ParallelSort. Types without a total order keep their order
+	*/
+	void sort() override;
+
+	std::unique_ptr<DataEngine<E>> clone() const override;
+	std::unique_ptr<DataEngine<E>> move() override;
+
+	bool removeAll() override;
+	E* toArray() const override;
+	E* toArray(int start, int end) const override;
+	size_t copyTo(std::span<E> destination, size_t start) const override;
+	void reverse() override;
+
+	iterator begin();
+	iterator end();
+	const_iterator begin() const;
+	const_iterator end() const;
+
+protected:
+	void grow() override;
+
+	//Thieves may still be reading the current ring, so it is never replaced by a smaller one
+	void shrink() override;
+	void compress() override;
+
+	[[nodiscard]] bool containsAllInternal(std::any* deque, int start, int end) override;
+	[[nodiscard]] std::any* retainAll(std::any* deque) override;
+	[[nodiscard]] std::any* mergeFirst(std::any* deque) override;
+	[[nodiscard]] std::any* mergeLast(std::any* deque) override;
+
+	[[nodiscard]] bool equalsInternal(const DataEngine<E>& de) const override;
+	[[nodiscard]] bool equivalenceInternal(const DataEngine<E>& de) const override;
+	[[nodiscard]] std::unique_ptr<DataEngine<E>> mergeInternal(const DataEngine<E>& de, int start, int end) const override;
+
+private:
+	alignas(DataEngine<E>::CACHE_LINE_SIZE) std::atomic<std::ptrdiff_t> top; //Next position to steal
+	alignas(DataEngine<E>::CACHE_LINE_SIZE) std::atomic<std::ptrdiff_t> bottom; //Next position to push
+	std::atomic<Ring*> ring;
+	size_t growthThreshold; //Owner-only
+
+	//Keeps the members of subclasses off the owner's line
+	char padding[DataEngine<E>::CACHE_LINE_SIZE - sizeof(std::atomic<std::ptrdiff_t>) - sizeof(std::atomic<Ring*>) - sizeof(size_t)];
+
+	Ring* allocateRing(size_t capacity, Ring* previous) const;
+	void deallocateRing(Ring* released) const noexcept;
+
+	/**
+	* Copies the items lying between the given positions, counted from the head, into initialized storage
+	* @param destination Destination storage
+	* @param start Starting position
+	* @param end Endpoint position
+	*/
+	void copyOut(E* destination, size_t start, size_t end) const;
+	E_ENGINE_CLASS
+}
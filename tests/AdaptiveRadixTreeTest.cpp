@@ -0,0 +1,105 @@
+#include "../src/Private/DataEngine.cpp"
+#include "../src/Private/Abstraction/Trie.cpp"
+#include "../src/Private/Implementation/AdaptiveRadixTree.cpp"
+#include "TestSupport.h"
+#include <map>
+#include <random>
+#include <string>
+
+using core::AdaptiveRadixTree;
+using core::Entry;
+
+namespace {
+	/**
+	* Short keys over an alphabet of the given size, so that keys share prefixes, end where others go on,
+	* and nodes pass through every size as the alphabet widens
+	*/
+	std::string randomKey(std::mt19937& random, int alphabet) {
+		std::string key(random() % 6, '\0');
+		for (char& byte : key) {
+			byte = static_cast<char>(random() % alphabet);
+		}
+		return key;
+	}
+
+	void againstReference(int alphabet) {
+		AdaptiveRadixTree<std::string, int> tree;
+		std::map<std::string, int> reference;
+		std::mt19937 random(alphabet);
+		for (int step = 0; step < 60000; step++) {
+			const std::string key = randomKey(random, alphabet);
+			if (random() % 3 != 0) {
+				CHECK(tree.put(key, step) == reference.insert_or_assign(key, step).second);
+			}
+			else {
+				CHECK(tree.remove(key) == (reference.erase(key) == 1));
+			}
+			int value = -1;
+			CHECK(tree.get(key, value) == reference.contains(key));
+		}
+		CHECK(tree.getActiveSize() == reference.size());
+		auto expected = reference.begin();
+		for (auto& entry : tree) {
+			CHECK(entry.key == expected->first && entry.value == expected->second);
+			++expected;
+		}
+		CHECK(expected == reference.end());
+		for (int probe = 0; probe < 200; probe++) {
+			const std::string prefix = randomKey(random, alphabet);
+			auto from = reference.lower_bound(prefix);
+			size_t visited = tree.scanPrefix(prefix, [&](const Entry<std::string, int>& entry) {
+				CHECK(from != reference.end() && entry.key == from->first);
+				++from;
+				return true;
+			});
+			CHECK(from == reference.end() || !from->first.starts_with(prefix));
+			size_t count = 0;
+			for (auto it = reference.lower_bound(prefix); it != reference.end() && it->first.starts_with(prefix); ++it) {
+				count++;
+			}
+			CHECK(visited == count);
+			Entry<std::string, int> longest;
+			bool found = false;
+			for (size_t length = prefix.size() + 1; length-- > 0 && !found;) {
+				found = reference.contains(prefix.substr(0, length));
+				if (found) {
+					CHECK(tree.longestPrefix(prefix, longest) && longest.key == prefix.substr(0, length));
+				}
+			}
+			CHECK(found || !tree.longestPrefix(prefix, longest));
+		}
+		//Removing everything shrinks the nodes back down to an empty tree
+		for (const auto& [key, value] : reference) {
+			CHECK(tree.remove(key));
+		}
+		CHECK(tree.getActiveSize() == 0 && tree.begin() == tree.end());
+	}
+
+	//Integers are traversed in numeric order, negative ones first
+	void integerKeys() {
+		AdaptiveRadixTree<int, int> tree;
+		for (int key = -1000; key < 1000; key += 3) {
+			CHECK(tree.put(key, -key));
+		}
+		int previous = -1001;
+		size_t visited = 0;
+		for (auto& entry : tree) {
+			CHECK(entry.key > previous && entry.value == -entry.key);
+			previous = entry.key;
+			visited++;
+		}
+		CHECK(visited == tree.getActiveSize());
+		int value = 0;
+		CHECK(tree.get(-1000, value) && value == 1000);
+		CHECK(!tree.get(-999, value));
+	}
+}
+
+int main() {
+	againstReference(3);
+	againstReference(20);
+	againstReference(60);
+	againstReference(256);
+	integerKeys();
+	return 0;
+}
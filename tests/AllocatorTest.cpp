@@ -0,0 +1,260 @@
+#include "../src/Private/DataEngine.cpp"
+#include "../src/Private/Abstraction/Graph.cpp"
+#include "../src/Private/Abstraction/List.cpp"
+#include "../src/Private/Abstraction/Matrix.cpp"
+#include "../src/Private/Abstraction/Map.cpp"
+#include "../src/Private/Abstraction/SkipList.cpp"
+#include "../src/Private/Abstraction/Stack.cpp"
+#include "../src/Private/Abstraction/Tree.cpp"
+#include "../src/Private/Abstraction/Trie.cpp"
+#include "../src/Private/Implementation/AdaptiveRadixTree.cpp"
+#include "../src/Private/Implementation/ArrayList.cpp"
+#include "../src/Private/Implementation/BPlusTree.cpp"
+#include "../src/Private/Implementation/CSCMatrix.cpp"
+#include "../src/Private/Implementation/CSRGraph.cpp"
+#include "../src/Private/Implementation/CSRMatrix.cpp"
+#include "../src/Private/Implementation/ConcurrentHashMap.cpp"
+#include "../src/Private/Implementation/ConcurrentSkipList.cpp"
+#include "../src/Private/Implementation/DenseMatrix.cpp"
+#include "../src/Private/Implementation/DynamicGraph.cpp"
+#include "../src/Private/Implementation/HashMap.cpp"
+#include "../src/Private/Implementation/SegmentedStack.cpp"
+#include "TestSupport.h"
+#include <atomic>
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+using namespace core;
+
+namespace {
+	using Polymorphic = std::pmr::polymorphic_allocator<std::byte>;
+
+	/**
+	* Resource counting the bytes it has handed out and not yet got back
+	*/
+	class CountingResource : public std::pmr::memory_resource {
+	public:
+		std::atomic<long long> outstanding{ 0 };
+		std::atomic<long long> allocations{ 0 };
+
+	protected:
+		void* do_allocate(size_t bytes, size_t alignment) override {
+			outstanding += static_cast<long long>(bytes);
+			allocations++;
+			return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+		}
+
+		void do_deallocate(void* block, size_t bytes, size_t alignment) override {
+			outstanding -= static_cast<long long>(bytes);
+			std::pmr::new_delete_resource()->deallocate(block, bytes, alignment);
+		}
+
+		[[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+			return this == &other;
+		}
+	};
+
+	/**
+	* Allocator over a counting resource that follows the storage on move assignment, so that the target of
+	* a move gives back its own storage and then adopts the resource of the source
+	*/
+	template<typename T>
+	class Propagating {
+	public:
+		using value_type = T;
+		using propagate_on_container_move_assignment = std::true_type;
+
+		explicit Propagating(CountingResource* resource) noexcept : resource(resource) {}
+
+		template<typename U>
+		Propagating(const Propagating<U>& other) noexcept : resource(other.resource) {}
+
+		T* allocate(size_t count) {
+			return static_cast<T*>(resource->allocate(count * sizeof(T), alignof(T)));
+		}
+
+		void deallocate(T* block, size_t count) noexcept {
+			resource->deallocate(block, count * sizeof(T), alignof(T));
+		}
+
+		template<typename U>
+		bool operator==(const Propagating<U>& other) const noexcept {
+			return resource == other.resource;
+		}
+
+		CountingResource* resource;
+	};
+
+	std::string text(int index) {
+		return "an entry long enough to be allocated " + std::to_string(index);
+	}
+
+	/**
+	* Fills two engines drawing from the resource, clones, merges and move assigns them, then checks that
+	* everything was drawn from the resource and given back to it
+	*/
+	template<typename Engine, typename Fill, typename Verify>
+	void roundTrip(Fill fill, Verify verify) {
+		CountingResource resource;
+		{
+			Polymorphic allocator(&resource);
+			Engine first(allocator);
+			Engine second(allocator);
+			fill(first, 0);
+			fill(second, 1000);
+			CHECK(resource.allocations > 0);
+			auto copy = first.clone();
+			auto merged = first.merge(second);
+			CHECK(merged != nullptr);
+			CHECK(merged->get_allocator() == allocator);
+			//The concurrent engines are not move assignable
+			if constexpr (std::is_move_assignable_v<Engine>) {
+				second = std::move(first);
+				verify(second, 0);
+			}
+			verify(*static_cast<Engine*>(copy.get()), 0);
+			verify(*merged, 0);
+			verify(*merged, 1000);
+		}
+		CHECK(resource.outstanding == 0);
+	}
+
+	void lists() {
+		roundTrip<ArrayList<std::string, Polymorphic>>([](auto& list, int base) {
+			for (int i = 0; i < 100; i++) {
+				list.add(text(base + i));
+			}
+		}, [](auto& list, int base) {
+			CHECK(list.contains(text(base + 42)));
+		});
+	}
+
+	template<typename Engine>
+	void maps() {
+		roundTrip<Engine>([](auto& map, int base) {
+			for (int i = 0; i < 500; i++) {
+				map.put(text(base + i), text(-i));
+			}
+		}, [](auto& map, int base) {
+			std::string value;
+			CHECK(map.get(text(base + 42), value) && value == text(-42));
+		});
+	}
+
+	void trees() {
+		roundTrip<BPlusTree<int, std::string, Polymorphic>>([](auto& tree, int base) {
+			for (int i = 0; i < 500; i++) {
+				tree.put(base + i, text(i));
+			}
+		}, [](auto& tree, int base) {
+			std::string value;
+			CHECK(tree.get(base + 42, value) && value == text(42));
+		});
+	}
+
+	void stacks() {
+		roundTrip<SegmentedStack<std::string, Polymorphic>>([](auto& stack, int base) {
+			for (int i = 0; i < 500; i++) {
+				stack.push(text(base + i));
+			}
+		}, [](auto& stack, int) {
+			CHECK(stack.getActiveSize() >= 500);
+		});
+	}
+
+	//A transposed graph draws from the allocator of the graph, whether it swaps the arcs or copies them
+	void graphs() {
+		CountingResource resource;
+		{
+			using Graph = CSRGraph<unsigned, Polymorphic>;
+			const GraphEdge<unsigned> edges[] = { { 0, 1 }, { 1, 2 }, { 2, 0 }, { 2, 3 } };
+			const Polymorphic allocator(&resource);
+			for (const bool directed : { true, false }) {
+				const Graph graph(4, edges, 4, directed, 1, allocator);
+				const long long before = resource.outstanding;
+				const Graph transposed = graph.transpose();
+				CHECK(transposed.get_allocator() == allocator && resource.outstanding > before);
+				CHECK(transposed.containsEdge(1, 0) && transposed.getActiveSize() == graph.getActiveSize());
+			}
+		}
+		CHECK(resource.outstanding == 0);
+	}
+
+	/**
+	* Moves between engines over different resources. Engines holding their storage directly refuse them and
+	* keep their own items, engines keeping vectors move the items into storage of their own resource
+	*/
+	void unequalMoves() {
+		CountingResource first;
+		CountingResource second;
+		{
+			using List = ArrayList<std::string, Polymorphic>;
+			static_assert(!std::is_nothrow_move_assignable_v<List> && std::is_nothrow_move_assignable_v<ArrayList<std::string>>);
+			List kept{ Polymorphic(&first) };
+			List moved{ Polymorphic(&second) };
+			kept.add(text(1));
+			moved.add(text(2));
+			bool rejected = false;
+			try {
+				kept = std::move(moved);
+			}
+			catch (const std::invalid_argument&) {
+				rejected = true;
+			}
+			CHECK(rejected && kept.getActiveSize() == 1 && kept.get(0) == text(1) && moved.get(0) == text(2));
+			//Allocators over the same resource compare equal, the buffer is taken over
+			List same{ Polymorphic(&first) };
+			same = std::move(kept);
+			CHECK(same.get(0) == text(1) && kept.getActiveSize() == 0);
+
+			using Matrix = CSRMatrix<double, Polymorphic>;
+			const MatrixTriplet<double> triplets[] = { { 0, 1, 2.0 }, { 1, 0, 3.0 }, { 2, 2, 4.0 } };
+			Matrix target(3, 3, Polymorphic(&first));
+			Matrix source(3, 3, triplets, 3, Polymorphic(&second));
+			const long long before = first.outstanding;
+			target = std::move(source);
+			CHECK(target.get(0, 1) == 2.0 && target.get(2, 2) == 4.0 && target.getNonZeros() == 3);
+			CHECK(first.outstanding > before);
+		}
+		CHECK(first.outstanding == 0 && second.outstanding == 0);
+	}
+
+	/**
+	* Move assignment of a DynamicGraph adopting the allocator of the source. The pages and versions the
+	* target had retired must be freed through the allocator they came from before it is replaced
+	*/
+	void propagatingMoves() {
+		CountingResource first;
+		CountingResource second;
+		{
+			using Graph = DynamicGraph<uint32_t, Propagating<uint32_t>>;
+			Graph target(200, true, Propagating<uint32_t>(&first));
+			for (uint32_t i = 0; i < 100; i++) {
+				target.insertEdge(i, i + 1);
+			}
+			Graph source(200, true, Propagating<uint32_t>(&second));
+			source.insertEdge(1, 2);
+			target = std::move(source);
+			CHECK(target.containsEdge(1, 2) && !target.containsEdge(5, 6));
+			target.insertEdge(5, 6);
+			CHECK(target.containsEdge(5, 6));
+		}
+		CHECK(first.outstanding == 0 && second.outstanding == 0);
+	}
+}
+
+int main() {
+	lists();
+	maps<HashMap<std::string, std::string, Polymorphic>>();
+	maps<ConcurrentHashMap<std::string, std::string, Polymorphic>>();
+	maps<ConcurrentSkipList<std::string, std::string, Polymorphic>>();
+	maps<AdaptiveRadixTree<std::string, std::string, Polymorphic>>();
+	trees();
+	stacks();
+	graphs();
+	unequalMoves();
+	propagatingMoves();
+	return 0;
+}
@@ -0,0 +1,103 @@
+#include "../src/Private/DataEngine.cpp"
+#include "../src/Private/Abstraction/Deque.cpp"
+#include "../src/Private/Implementation/ArrayDeque.cpp"
+#include "TestSupport.h"
+#include <algorithm>
+#include <deque>
+#include <random>
+#include <string>
+#include <vector>
+
+using core::ArrayDeque;
+
+namespace {
+	template<typename E>
+	void same(ArrayDeque<E>& deque, const std::deque<E>& reference) {
+		CHECK(deque.getActiveSize() == reference.size());
+		for (size_t index = 0; index < reference.size(); index++) {
+			CHECK(deque.get(static_cast<int>(index)) == reference[index]);
+		}
+		CHECK(std::equal(deque.begin(), deque.end(), reference.begin(), reference.end()));
+	}
+
+	/**
+	* Random operations at both ends, so that the head wraps around the ring in both directions while it
+	* grows and shrinks
+	*/
+	template<typename E, typename Make>
+	void againstReference(Make make) {
+		ArrayDeque<E> deque;
+		std::deque<E> reference;
+		std::mt19937 random(29);
+		for (int step = 0; step < 100000; step++) {
+			const bool growing = (step / 10000) % 2 == 0;
+			const unsigned choice = random() % 8;
+			if (reference.empty() || choice < (growing ? 5u : 2u)) {
+				if (choice % 2 == 0) {
+					CHECK(deque.addFirst(make(step)));
+					reference.push_front(make(step));
+				}
+				else {
+					CHECK(deque.addLast(make(step)));
+					reference.push_back(make(step));
+				}
+			}
+			else if (choice % 2 == 0) {
+				CHECK(deque.peekFirst() == reference.front());
+				CHECK(deque.removeFirst() == reference.front());
+				reference.pop_front();
+			}
+			else {
+				CHECK(deque.peekLast() == reference.back());
+				CHECK(deque.removeLast() == reference.back());
+				reference.pop_back();
+			}
+			if (step % 1000 == 0) {
+				same(deque, reference);
+			}
+		}
+		same(deque, reference);
+	}
+
+	std::string text(int index) {
+		return "an item long enough to be allocated " + std::to_string(index);
+	}
+
+	//Bulk additions keep their order at either end, and copyTo reads across the wrap of the ring
+	void bulk() {
+		ArrayDeque<int> deque(8);
+		std::deque<int> reference;
+		std::vector<int> items(1000);
+		for (int round = 0; round < 20; round++) {
+			for (size_t index = 0; index < items.size(); index++) {
+				items[index] = round * 1000 + static_cast<int>(index);
+			}
+			if (round % 2 == 0) {
+				CHECK(deque.addFirst(items.data(), items.size()));
+				reference.insert(reference.begin(), items.begin(), items.end());
+			}
+			else {
+				CHECK(deque.addLast(items.data(), items.size()));
+				reference.insert(reference.end(), items.begin(), items.end());
+			}
+			for (int removed = 0; removed < 300; removed++) {
+				CHECK(deque.removeFirst() == reference.front());
+				reference.pop_front();
+			}
+		}
+		same(deque, reference);
+		std::vector<int> copied(500);
+		CHECK(deque.copyTo(copied, 100) == copied.size());
+		CHECK(std::equal(copied.begin(), copied.end(), reference.begin() + 100));
+		deque.reverse();
+		std::reverse(reference.begin(), reference.end());
+		same(deque, reference);
+	}
+}
+
+int main() {
+	againstReference<int>([](int step) { return step; });
+	againstReference<std::string>(text);
+	bulk();
+	return 0;
+}
@@ -0,0 +1,68 @@
+#include "../src/Private/DataEngine.cpp"
+#include "../src/Private/Abstraction/List.cpp"
+#include "../src/Private/Implementation/ArrayList.cpp"
+#include "TestSupport.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+using core::ArrayList;
+
+namespace {
+	constexpr int ITEMS = 50000000;
+	constexpr int RUNS = 3;
+
+	//Best of the runs, in milliseconds
+	template<typename Run>
+	double milliseconds(Run run) {
+		double best = 0;
+		for (int attempt = 0; attempt < RUNS; attempt++) {
+			const auto started = std::chrono::steady_clock::now();
+			run();
+			const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - started;
+			best = attempt == 0 ? elapsed.count() : std::min(best, elapsed.count());
+		}
+		return best;
+	}
+}
+
+int main() {
+	long long sum = 0;
+	const double listAdd = milliseconds([&] {
+		ArrayList<int> list;
+		for (int item = 0; item < ITEMS; item++) {
+			list.add(item);
+		}
+		sum += list.get(ITEMS - 1);
+	});
+	const double vectorAdd = milliseconds([&] {
+		std::vector<int> vector;
+		for (int item = 0; item < ITEMS; item++) {
+			vector.push_back(item);
+		}
+		sum += vector[ITEMS - 1];
+	});
+	ArrayList<int> list;
+	std::vector<int> vector;
+	for (int item = 0; item < ITEMS; item++) {
+		list.add(item);
+		vector.push_back(item);
+	}
+	//Each item is read, bumped and written back through the engine interface
+	const double listAccess = milliseconds([&] {
+		for (int index = 0; index < ITEMS; index++) {
+			list.set(index, list.get(index) + 1);
+		}
+	});
+	const double vectorAccess = milliseconds([&] {
+		for (int index = 0; index < ITEMS; index++) {
+			vector[index] = vector[index] + 1;
+		}
+	});
+	CHECK(list.get(0) == vector[0] && sum == 2LL * RUNS * (ITEMS - 1));
+	std::printf("%d ints, best of %d runs (ms)\n", ITEMS, RUNS);
+	std::printf("add      ArrayList %8.1f  std::vector %8.1f\n", listAdd, vectorAdd);
+	std::printf("get/set  ArrayList %8.1f  std::vector %8.1f\n", listAccess, vectorAccess);
+	return 0;
+}
@@ -0,0 +1,102 @@
+#include "../src/Private/DataEngine.cpp"
+#include "../src/Private/Abstraction/List.cpp"
+#include "../src/Private/Implementation/ArrayList.cpp"
+#include "TestSupport.h"
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+using core::ArrayList;
+
+namespace {
+	template<typename E>
+	void same(const ArrayList<E>& list, const std::vector<E>& reference) {
+		CHECK(list.getActiveSize() == reference.size());
+		CHECK(std::equal(list.begin(), list.end(), reference.begin(), reference.end()));
+		CHECK(list.view().data() == list.begin() && list.view().size() == reference.size());
+	}
+
+	/**
+	* Random insertions and removals anywhere in the list, so that it grows and shrinks many times. Trivially
+	* copyable items are relocated with memcpy, strings one by one
+	*/
+	template<typename E, typename Make>
+	void againstReference(Make make) {
+		ArrayList<E> list;
+		std::vector<E> reference;
+		std::mt19937 random(23);
+		for (int step = 0; step < 50000; step++) {
+			const bool growing = (step / 5000) % 2 == 0;
+			if (reference.empty() || random() % 4 < (growing ? 3u : 1u)) {
+				const int index = static_cast<int>(random() % (reference.size() + 1));
+				CHECK(list.add(make(step), index));
+				reference.insert(reference.begin() + index, make(step));
+			}
+			else {
+				const int index = static_cast<int>(random() % reference.size());
+				CHECK(list.get(index) == reference[index]);
+				CHECK(list.removeAt(index));
+				reference.erase(reference.begin() + index);
+			}
+			CHECK(list.getMaxCapacity() >= list.getActiveSize());
+			if (step % 500 == 0) {
+				same(list, reference);
+			}
+		}
+		same(list, reference);
+		CHECK(!list.add(make(0), static_cast<int>(reference.size()) + 1));
+		CHECK(!list.removeAt(static_cast<int>(reference.size())));
+	}
+
+	std::string text(int index) {
+		return "an item long enough to be allocated " + std::to_string(index);
+	}
+
+	//The buffer shrinks back as the list empties, and reserve avoids growing
+	void capacity() {
+		ArrayList<int> list;
+		for (int item = 0; item < 100000; item++) {
+			list.add(item);
+		}
+		const size_t full = list.getMaxCapacity();
+		for (int item = 0; item < 99990; item++) {
+			CHECK(list.removeAt(static_cast<int>(list.getActiveSize()) - 1));
+		}
+		CHECK(list.getMaxCapacity() < full / 100);
+		ArrayList<int> reserved;
+		reserved.reserve(5000);
+		const int* buffer = reserved.view().data();
+		for (int item = 0; item < 5000; item++) {
+			reserved.add(item);
+		}
+		CHECK(reserved.view().data() == buffer);
+	}
+
+	void lookups() {
+		ArrayList<std::string> list;
+		for (int item = 0; item < 10; item++) {
+			list.add(text(item % 5));
+		}
+		CHECK(list.getFirstIndex(text(3)) == 3);
+		CHECK(list.getLastIndex(text(3)) == 8);
+		CHECK(list.getFirstIndex(text(7)) == -1);
+		//Every occurrence goes at once
+		CHECK(list.remove(text(3)) && list.getFirstIndex(text(3)) == -1);
+		CHECK(list.getActiveSize() == 8 && list.get(7) == text(4));
+		list.set(0, text(9));
+		CHECK(list.contains(text(9)) && list.get(0) == text(9));
+		auto copy = list.clone();
+		CHECK(*copy == list);
+		list.reverse();
+		CHECK(list.get(0) == text(4) && list.get(7) == text(9));
+	}
+}
+
+int main() {
+	againstReference<int>([](int step) { return step; });
+	againstReference<std::string>(text);
+	capacity();
+	lookups();
+	return 0;
+}
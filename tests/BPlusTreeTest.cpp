@@ -0,0 +1,104 @@
+#include "../src/Private/DataEngine.cpp"
+#include "../src/Private/Abstraction/Tree.cpp"
+#include "../src/Private/Implementation/BPlusTree.cpp"
+#include "TestSupport.h"
+#include <iterator>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using core::BPlusTree;
+using core::Entry;
+
+namespace {
+	using Reference = std::map<int, int>;
+
+	//Ordered lookups and scans of the tree must agree with the reference at any key
+	void compare(BPlusTree<int, int>& tree, const Reference& reference, int key) {
+		Entry<int, int> entry;
+		auto above = reference.lower_bound(key);
+		CHECK(tree.ceiling(key, entry) == (above != reference.end()));
+		CHECK(above == reference.end() || (entry.key == above->first && entry.value == above->second));
+		auto below = reference.upper_bound(key);
+		CHECK(tree.floor(key, entry) == (below != reference.begin()));
+		CHECK(below == reference.begin() || entry.key == std::prev(below)->first);
+		size_t scanned = 0;
+		tree.scan(key, [&](const Entry<int, int>& visited) {
+			CHECK(above != reference.end() && visited.key == above->first && visited.value == above->second);
+			++above;
+			return ++scanned < 20;
+		});
+		CHECK(scanned == 20 || above == reference.end());
+	}
+
+	//Random puts and removes split and merge nodes over many levels
+	void againstReference() {
+		BPlusTree<int, int> tree;
+		Reference reference;
+		std::mt19937 random(11);
+		std::uniform_int_distribution<int> keys(0, 20000);
+		for (int step = 0; step < 100000; step++) {
+			const int key = keys(random);
+			if (random() % 4 != 0) {
+				CHECK(tree.put(key, step) == reference.insert_or_assign(key, step).second);
+			}
+			else {
+				CHECK(tree.remove(key) == (reference.erase(key) == 1));
+			}
+			if (step % 97 == 0) {
+				compare(tree, reference, keys(random));
+			}
+		}
+		CHECK(tree.getActiveSize() == reference.size());
+		Entry<int, int> entry;
+		CHECK(tree.first(entry) && entry.key == reference.begin()->first);
+		CHECK(tree.last(entry) && entry.key == reference.rbegin()->first);
+		auto expected = reference.begin();
+		for (auto& visited : tree) {
+			CHECK(visited.key == expected->first && visited.value == expected->second);
+			++expected;
+		}
+		CHECK(expected == reference.end());
+		//Emptied one key at a time, the tree collapses back to no levels
+		for (const auto& [key, value] : reference) {
+			CHECK(tree.remove(key));
+		}
+		CHECK(tree.getActiveSize() == 0 && tree.getHeight() == 0);
+		CHECK(!tree.first(entry));
+	}
+
+	void bulkLoad() {
+		std::vector<Entry<int, int>> entries;
+		for (int key = 0; key < 10000; key++) {
+			entries.push_back({ key * 2, key });
+		}
+		BPlusTree<int, int> tree(entries.data(), entries.size());
+		CHECK(tree.getActiveSize() == entries.size());
+		int value = -1;
+		CHECK(tree.get(5000, value) && value == 2500);
+		CHECK(!tree.get(5001, value));
+		size_t visited = tree.scan(100, 200, [&](const Entry<int, int>& entry) {
+			CHECK(entry.key >= 100 && entry.key < 200);
+		});
+		CHECK(visited == 50);
+		//The packed tree still accepts insertions between its keys
+		CHECK(tree.put(5001, -1));
+		CHECK(tree.get(5001, value) && value == -1);
+		std::swap(entries[10], entries[11]);
+		bool rejected = false;
+		try {
+			BPlusTree<int, int> unsorted(entries.data(), entries.size());
+		}
+		catch (const std::invalid_argument&) {
+			rejected = true;
+		}
+		CHECK(rejected);
+	}
+}
+
+int main() {
+	againstReference();
+	bulkLoad();
+	return 0;
+}
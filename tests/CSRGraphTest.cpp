@@ -0,0 +1,123 @@
+#include "../src/Private/DataEngine.cpp"
+#include "../src/Private/Abstraction/Graph.cpp"
+#include "../src/Private/Implementation/CSRGraph.cpp"
+#include "TestSupport.h"
+#include <algorithm>
+#include <queue>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using core::CSRGraph;
+using core::GraphEdge;
+
+namespace {
+	using Graph = CSRGraph<unsigned>;
+
+	/**
+	* A few hubs with many arcs and a long tail of vertices with few, so that the search switches to the
+	* bottom-up direction in its middle steps. The last vertices stay unreachable
+	*/
+	std::vector<GraphEdge<unsigned>> randomEdges(unsigned vertices, size_t count) {
+		std::mt19937 random(41);
+		std::vector<GraphEdge<unsigned>> edges;
+		const unsigned reachable = vertices - 100;
+		for (size_t index = 0; index < count; index++) {
+			const unsigned source = index % 4 == 0 ? static_cast<unsigned>(random() % 16) : static_cast<unsigned>(random() % reachable);
+			edges.push_back({ source, static_cast<unsigned>(random() % reachable) });
+		}
+		return edges;
+	}
+
+	//Level of each vertex in a plain queue-based search, -1 when not reached
+	std::vector<int> levels(const Graph& graph, unsigned source) {
+		std::vector<int> level(graph.getVertices(), -1);
+		std::queue<unsigned> queue;
+		level[source] = 0;
+		queue.push(source);
+		while (!queue.empty()) {
+			const unsigned vertex = queue.front();
+			queue.pop();
+			for (unsigned target : graph.neighbors(vertex)) {
+				if (level[target] < 0) {
+					level[target] = level[vertex] + 1;
+					queue.push(target);
+				}
+			}
+		}
+		return level;
+	}
+
+	//Any shortest path tree is valid, so each parent is checked to be one level above its child through an arc
+	void searches(const Graph& graph) {
+		for (unsigned source : { 0u, 5000u }) {
+			const auto level = levels(graph, source);
+			for (unsigned threads : { 1u, 4u }) {
+				const auto parents = graph.breadthFirst(source, threads);
+				CHECK(parents.size() == graph.getVertices());
+				CHECK(parents[source] == source);
+				for (unsigned vertex = 0; vertex < graph.getVertices(); vertex++) {
+					if (level[vertex] < 0) {
+						CHECK(parents[vertex] == Graph::NONE);
+					}
+					else if (vertex != source) {
+						const unsigned parent = parents[vertex];
+						CHECK(parent != Graph::NONE && level[parent] == level[vertex] - 1);
+						CHECK(graph.containsEdge(parent, vertex));
+					}
+				}
+			}
+		}
+	}
+
+	void directed() {
+		constexpr unsigned VERTICES = 100000;
+		const auto edges = randomEdges(VERTICES, 800000);
+		const Graph graph(VERTICES, edges.data(), edges.size(), true, 4);
+		std::vector<std::vector<unsigned>> expected(VERTICES);
+		for (const auto& edge : edges) {
+			expected[edge.source].push_back(edge.target);
+		}
+		size_t arcs = 0;
+		for (unsigned vertex = 0; vertex < VERTICES; vertex += 97) {
+			auto& targets = expected[vertex];
+			std::sort(targets.begin(), targets.end());
+			targets.erase(std::unique(targets.begin(), targets.end()), targets.end());
+			const auto neighbors = graph.neighbors(vertex);
+			CHECK(std::equal(neighbors.begin(), neighbors.end(), targets.begin(), targets.end()));
+			CHECK(graph.getDegree(vertex) == targets.size());
+			arcs += targets.size();
+		}
+		CHECK(arcs > 0);
+		//Built on one thread, the graph is the same
+		CHECK(Graph(VERTICES, edges.data(), edges.size(), true, 1) == graph);
+		searches(graph);
+		const auto reversed = graph.transpose();
+		CHECK(reversed.containsEdge(edges[7].target, edges[7].source));
+	}
+
+	void undirected() {
+		const GraphEdge<unsigned> edges[] = { { 0, 1 }, { 1, 2 }, { 2, 0 }, { 3, 4 }, { 1, 0 } };
+		const Graph graph(6, edges, 5, false);
+		CHECK(graph.containsEdge(1, 0) && graph.containsEdge(0, 1) && graph.containsEdge(4, 3));
+		CHECK(graph.getDegree(0) == 2);
+		const auto parents = graph.breadthFirst(2);
+		CHECK(parents[2] == 2 && parents[0] == 2 && parents[1] == 2);
+		CHECK(parents[3] == Graph::NONE && parents[5] == Graph::NONE);
+		bool rejected = false;
+		try {
+			const GraphEdge<unsigned> outside[] = { { 0, 6 } };
+			Graph invalid(6, outside, 1);
+		}
+		catch (const std::out_of_range&) {
+			rejected = true;
+		}
+		CHECK(rejected);
+	}
+}
+
+int main() {
+	undirected();
+	directed();
+	return 0;
+}
@@ -0,0 +1,95 @@
+#include "../src/Private/DataEngine.cpp"
+#include "../src/Private/Abstraction/Queue.cpp"
+#include "../src/Private/Implementation/ConcurrentArrayQueue.cpp"
+#include "TestSupport.h"
+#include <atomic>
+#include <memory>
+#include <vector>
+
+using core::ConcurrentArrayQueue;
+
+namespace {
+	constexpr size_t PRODUCERS = 4;
+	constexpr size_t CONSUMERS = 4;
+	constexpr size_t ITEMS = 10000; //Per producer
+
+	//Each item tells its producer and its rank among that producer's items
+	size_t item(size_t producer, size_t rank) {
+		return producer * ITEMS + rank;
+	}
+
+	/**
+	* Producers and consumers share a small queue, which keeps filling up and draining. Every item must be
+	* consumed exactly once, and each consumer must see the items of a producer in the order they were put
+	*/
+	void producersAndConsumers() {
+		ConcurrentArrayQueue<size_t> queue(64);
+		auto taken = std::make_unique<std::atomic<unsigned>[]>(PRODUCERS * ITEMS);
+		std::atomic<size_t> consumed{ 0 };
+		test::concurrently(PRODUCERS + CONSUMERS, [&](size_t thread) {
+			if (thread < PRODUCERS) {
+				std::vector<size_t> batch;
+				for (size_t rank = 0; rank < ITEMS;) {
+					//Alternates single puts with batches that may only partly fit
+					if (rank % 3 == 0) {
+						queue.put(item(thread, rank++));
+						continue;
+					}
+					batch.clear();
+					for (size_t next = rank; next < std::min(rank + 16, ITEMS); next++) {
+						batch.push_back(item(thread, next));
+					}
+					queue.putAll(batch.data(), batch.size());
+					rank += batch.size();
+				}
+				return;
+			}
+			std::vector<size_t> last(PRODUCERS, 0);
+			std::vector<bool> seen(PRODUCERS, false);
+			size_t items[8];
+			while (consumed < PRODUCERS * ITEMS) {
+				const size_t count = thread % 2 == 0 ? queue.dequeue(items, 8) : (queue.dequeue(items[0]) ? 1 : 0);
+				for (size_t index = 0; index < count; index++) {
+					const size_t producer = items[index] / ITEMS;
+					const size_t rank = items[index] % ITEMS;
+					CHECK(producer < PRODUCERS);
+					CHECK(!seen[producer] || rank > last[producer]);
+					seen[producer] = true;
+					last[producer] = rank;
+					taken[items[index]]++;
+				}
+				consumed += count;
+			}
+		});
+		CHECK(consumed == PRODUCERS * ITEMS);
+		for (size_t index = 0; index < PRODUCERS * ITEMS; index++) {
+			CHECK(taken[index] == 1);
+		}
+		CHECK(queue.getActiveSize() == 0);
+	}
+
+	//The capacity is rounded up to a power of two and never exceeded
+	void bounded() {
+		ConcurrentArrayQueue<int> queue(5);
+		int accepted = 0;
+		while (queue.enqueue(accepted)) {
+			accepted++;
+		}
+		CHECK(accepted == 8);
+		const int items[] = { 100, 101, 102 };
+		CHECK(queue.enqueue(items, 3) == 0);
+		int item = -1;
+		CHECK(queue.dequeue(item) && item == 0);
+		CHECK(queue.enqueue(items, 3) == 1);
+		int drained[16];
+		CHECK(queue.dequeue(drained, 16) == 8);
+		CHECK(drained[0] == 1 && drained[6] == 7 && drained[7] == 100);
+		CHECK(!queue.dequeue(item));
+	}
+}
+
+int main() {
+	bounded();
+	producersAndConsumers();
+	return 0;
+}
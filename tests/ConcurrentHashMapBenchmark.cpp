@@ -0,0 +1,93 @@
+#include "../src/Private/DataEngine.cpp"
+#include "../src/Private/Abstraction/Map.cpp"
+#include "../src/Private/Implementation/ConcurrentHashMap.cpp"
+#include "TestSupport.h"
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <random>
+#include <shared_mutex>
+#include <unordered_map>
+
+using core::ConcurrentHashMap;
+
+namespace {
+	constexpr size_t KEYS = size_t{ 1 } << 16;
+	constexpr size_t OPERATIONS = size_t{ 1 } << 22; //Split between the threads of a run
+
+	/**
+	* The baseline the map is measured against, one reader-writer lock around a standard map
+	*/
+	class LockedMap {
+	public:
+		bool put(size_t key, size_t value) {
+			std::unique_lock lock(mutex);
+			return map.insert_or_assign(key, value).second;
+		}
+
+		bool get(size_t key, size_t& value) const {
+			std::shared_lock lock(mutex);
+			const auto found = map.find(key);
+			if (found == map.end()) {
+				return false;
+			}
+			value = found->second;
+			return true;
+		}
+
+		bool remove(size_t key) {
+			std::unique_lock lock(mutex);
+			return map.erase(key) == 1;
+		}
+
+	private:
+		mutable std::shared_mutex mutex;
+		std::unordered_map<size_t, size_t> map;
+	};
+
+	/**
+	* Runs the mix on a map holding every other key. Writes alternate between putting and removing, so
+	* the size stays about the same and the table neither grows nor shrinks during the run
+	* @return Returns millions of operations per second
+	*/
+	template<typename Map>
+	double measure(unsigned threads, unsigned readPercent) {
+		Map map;
+		for (size_t key = 0; key < KEYS; key += 2) {
+			map.put(key, key);
+		}
+		const auto started = std::chrono::steady_clock::now();
+		test::concurrently(threads, [&](size_t thread) {
+			std::mt19937_64 random(thread + 1);
+			size_t value = 0;
+			size_t found = 0;
+			for (size_t operation = 0; operation < OPERATIONS / threads; operation++) {
+				const size_t key = random() % KEYS;
+				if (random() % 100 < readPercent) {
+					found += map.get(key, value) ? 1 : 0;
+				}
+				else if (operation % 2 == 0) {
+					map.put(key, key);
+				}
+				else {
+					map.remove(key);
+				}
+			}
+			CHECK(found <= OPERATIONS);
+		});
+		const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - started;
+		return static_cast<double>(OPERATIONS / threads * threads) / elapsed.count() / 1e6;
+	}
+}
+
+int main() {
+	std::printf("threads  reads  ConcurrentHashMap  shared_mutex+unordered_map  (Mops/s, %u hardware threads)\n", std::thread::hardware_concurrency());
+	for (unsigned readPercent : { 90u, 50u }) {
+		for (unsigned threads = 1; threads <= 64; threads *= 2) {
+			const double concurrent = measure<ConcurrentHashMap<size_t, size_t>>(threads, readPercent);
+			const double locked = measure<LockedMap>(threads, readPercent);
+			std::printf("%7u  %4u%%  %17.2f  %26.2f\n", threads, readPercent, concurrent, locked);
+		}
+	}
+	return 0;
+}
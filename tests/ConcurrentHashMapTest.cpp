@@ -0,0 +1,172 @@
+#include "../src/Private/DataEngine.cpp"
+#include "../src/Private/Abstraction/Map.cpp"
+#include "../src/Private/Implementation/ConcurrentHashMap.cpp"
+#include "TestSupport.h"
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using core::ConcurrentHashMap;
+
+namespace {
+	constexpr size_t THREADS = 8;
+	constexpr size_t KEYS = 4096;
+
+	//Long enough to live on the heap, so that a use after a free is visible to the sanitizers
+	std::string value(size_t index, size_t thread) {
+		return "a value long enough to be allocated " + std::to_string(index) + "/" + std::to_string(thread);
+	}
+
+	bool belongsTo(const std::string& text, size_t index) {
+		return text.starts_with("a value long enough to be allocated " + std::to_string(index) + "/");
+	}
+
+	//Every thread adds the same keys to a map starting small, so that the table resizes under contention
+	void contendedInsertions() {
+		ConcurrentHashMap<size_t, std::string> map(4);
+		std::atomic<size_t> added{ 0 };
+		test::concurrently(THREADS, [&](size_t thread) {
+			for (size_t index = 0; index < KEYS; index++) {
+				if (map.putIfAbsent(index, value(index, thread))) {
+					added++;
+				}
+				map.put(index, value(index, thread));
+			}
+		});
+		CHECK(added == KEYS);
+		CHECK(map.getActiveSize() == KEYS);
+		std::string found;
+		for (size_t index = 0; index < KEYS; index++) {
+			CHECK(map.get(index, found) && belongsTo(found, index));
+		}
+	}
+
+	//Half of the threads remove what the others insert while every thread reads
+	void insertionsAndRemovals() {
+		ConcurrentHashMap<size_t, std::string> map;
+		test::concurrently(THREADS, [&](size_t thread) {
+			std::string found;
+			for (size_t round = 0; round < 4; round++) {
+				for (size_t index = 0; index < KEYS / 4; index++) {
+					if (thread % 2 == 0) {
+						map.put(index, value(index, thread));
+					}
+					else {
+						map.remove(index);
+					}
+					if (map.get(index, found)) {
+						CHECK(belongsTo(found, index));
+					}
+				}
+			}
+		});
+		size_t present = 0;
+		std::string found;
+		for (size_t index = 0; index < KEYS / 4; index++) {
+			present += map.get(index, found) ? 1 : 0;
+		}
+		CHECK(present == map.getActiveSize());
+	}
+
+	//Each thread owns a disjoint range, so the final content is known exactly
+	void disjointRanges() {
+		ConcurrentHashMap<size_t, size_t> map;
+		test::concurrently(THREADS, [&](size_t thread) {
+			for (size_t index = thread * KEYS; index < (thread + 1) * KEYS; index++) {
+				CHECK(map.put(index, index * 2));
+			}
+			for (size_t index = thread * KEYS; index < (thread + 1) * KEYS; index += 2) {
+				CHECK(map.remove(index));
+			}
+		});
+		CHECK(map.getActiveSize() == THREADS * KEYS / 2);
+		size_t found = 0;
+		for (size_t index = 0; index < THREADS * KEYS; index++) {
+			CHECK(map.get(index, found) == (index % 2 == 1));
+			CHECK(index % 2 == 0 || found == index * 2);
+		}
+	}
+
+	//Emptying a grown map shrinks it back to the smallest table, one stripe per bucket
+	void shrinking() {
+		ConcurrentHashMap<size_t, size_t> map;
+		for (size_t index = 0; index < 5000; index++) {
+			CHECK(map.put(index, index));
+		}
+		CHECK(map.getMaxCapacity() > 5000);
+		for (size_t index = 0; index < 5000; index++) {
+			CHECK(map.remove(index));
+		}
+		//Later writes finish moving the entries left over to the smallest table
+		for (size_t round = 0; round < 100; round++) {
+			CHECK(map.put(round, round) && map.remove(round));
+		}
+		const ConcurrentHashMap<size_t, size_t> smallest(0);
+		CHECK(map.getActiveSize() == 0 && map.getMaxCapacity() == smallest.getMaxCapacity());
+	}
+
+	/**
+	* Value whose copies throw while failing is set, moves never do
+	*/
+	struct Fragile {
+		static inline bool failing = false;
+		int value = 0;
+
+		Fragile() = default;
+		explicit Fragile(int value) : value(value) {}
+		Fragile(const Fragile& other) : value(other.value) {
+			if (failing) {
+				throw std::runtime_error("copy failed");
+			}
+		}
+		Fragile(Fragile&&) noexcept = default;
+		Fragile& operator=(const Fragile& other) {
+			if (failing) {
+				throw std::runtime_error("copy failed");
+			}
+			value = other.value;
+			return *this;
+		}
+		Fragile& operator=(Fragile&&) noexcept = default;
+		bool operator==(const Fragile&) const = default;
+	};
+
+	//A copy throwing while every stripe is locked leaves them unlocked, writers would spin forever otherwise
+	void failingCopies() {
+		ConcurrentHashMap<int, Fragile> map;
+		for (int key = 0; key < 100; key++) {
+			map.put(key, Fragile(key));
+		}
+		std::vector<core::Entry<int, Fragile>> destination(10);
+		Fragile::failing = true;
+		int rejected = 0;
+		try {
+			map.clone();
+		}
+		catch (const std::runtime_error&) {
+			rejected++;
+		}
+		try {
+			map.copyTo(std::span<core::Entry<int, Fragile>>(destination), 0);
+		}
+		catch (const std::runtime_error&) {
+			rejected++;
+		}
+		Fragile::failing = false;
+		CHECK(rejected == 2);
+		for (int key = 0; key < 100; key++) {
+			CHECK(map.remove(key) && map.put(key + 100, Fragile(key)));
+		}
+		CHECK(map.getActiveSize() == 100 && map.clone()->getActiveSize() == 100);
+	}
+}
+
+int main() {
+	contendedInsertions();
+	insertionsAndRemovals();
+	disjointRanges();
+	shrinking();
+	failingCopies();
+	return 0;
+}
@@ -0,0 +1,138 @@
+#include "../src/Private/DataEngine.cpp"
+#include "../src/Private/Abstraction/SkipList.cpp"
+#include "../src/Private/Implementation/ConcurrentSkipList.cpp"
+#include "TestSupport.h"
+#include <atomic>
+#include <string>
+
+using core::ConcurrentSkipList;
+using core::Entry;
+
+namespace {
+	constexpr size_t THREADS = 8;
+	constexpr size_t KEYS = 512;
+
+	//Long enough to live on the heap, so that a use after a move or a free is visible to the sanitizers
+	std::string key(size_t index) {
+		std::string text = "a key long enough to be allocated ";
+		text += std::to_string(1000000 + index);
+		return text;
+	}
+
+	std::string value(size_t index, size_t thread) {
+		return "a value long enough to be allocated " + std::to_string(index) + "/" + std::to_string(thread);
+	}
+
+	bool belongsTo(const std::string& text, size_t index) {
+		return text.starts_with("a value long enough to be allocated " + std::to_string(index) + "/");
+	}
+
+	//Every thread adds and replaces the same keys, so most insertions lose their race to another one
+	void contendedInsertions() {
+		ConcurrentSkipList<std::string, std::string> list;
+		std::atomic<size_t> added{ 0 };
+		test::concurrently(THREADS, [&](size_t thread) {
+			for (size_t round = 0; round < 2; round++) {
+				for (size_t index = 0; index < KEYS; index++) {
+					if (list.putIfAbsent(key(index), value(index, thread))) {
+						added++;
+					}
+					list.put(key(index), value(index, thread));
+				}
+			}
+		});
+		CHECK(added == KEYS);
+		CHECK(list.getActiveSize() == KEYS);
+		std::string found;
+		for (size_t index = 0; index < KEYS; index++) {
+			CHECK(list.get(key(index), found));
+			CHECK(belongsTo(found, index));
+		}
+		size_t visited = 0;
+		list.scan(key(0), [&](const Entry<std::string, std::string>& entry) {
+			CHECK(entry.key == key(visited));
+			CHECK(belongsTo(entry.value, visited));
+			visited++;
+			return true;
+		});
+		CHECK(visited == KEYS);
+	}
+
+	//Trivially copyable keys with allocated values, values must never be stored moved-from
+	void contendedValues() {
+		ConcurrentSkipList<int, std::string> list;
+		test::concurrently(THREADS, [&](size_t thread) {
+			for (size_t index = 0; index < KEYS; index++) {
+				list.put(static_cast<int>(index), value(index, thread));
+			}
+		});
+		std::string found;
+		for (size_t index = 0; index < KEYS; index++) {
+			CHECK(list.get(static_cast<int>(index), found));
+			CHECK(belongsTo(found, index));
+		}
+	}
+
+	//Half of the threads remove what the others insert, readers walk the list meanwhile
+	void insertionsAndRemovals() {
+		ConcurrentSkipList<std::string, std::string> list;
+		test::concurrently(THREADS, [&](size_t thread) {
+			for (size_t index = 0; index < KEYS; index++) {
+				if (thread % 2 == 0) {
+					list.put(key(index), value(index, thread));
+				}
+				else {
+					list.remove(key(index));
+				}
+				std::string found;
+				if (list.get(key(index), found)) {
+					CHECK(belongsTo(found, index));
+				}
+			}
+		});
+		size_t visited = 0;
+		std::string previous;
+		list.scan(key(0), [&](const Entry<std::string, std::string>& entry) {
+			CHECK(visited == 0 || previous < entry.key);
+			previous = entry.key;
+			visited++;
+			return true;
+		});
+		CHECK(visited == list.getActiveSize());
+	}
+
+	//Few keys added and removed over and over, so that insertions keep failing their compare-and-swap
+	void churn() {
+		constexpr size_t CHURN_KEYS = 4;
+		constexpr size_t ROUNDS = 20000;
+		ConcurrentSkipList<std::string, std::string> list;
+		test::concurrently(THREADS, [&](size_t thread) {
+			std::string found;
+			for (size_t round = 0; round < ROUNDS; round++) {
+				const size_t index = (round + thread) % CHURN_KEYS;
+				switch ((round / CHURN_KEYS + thread) % 3) {
+				case 0:
+					list.put(key(index), value(index, thread));
+					break;
+				case 1:
+					list.putIfAbsent(key(index), value(index, thread));
+					break;
+				default:
+					list.remove(key(index));
+				}
+				if (list.get(key(index), found)) {
+					CHECK(belongsTo(found, index));
+				}
+			}
+		});
+		CHECK(list.getActiveSize() <= CHURN_KEYS);
+	}
+}
+
+int main() {
+	contendedInsertions();
+	contendedValues();
+	insertionsAndRemovals();
+	churn();
+	return 0;
+}
@@ -0,0 +1,142 @@
+#include "../src/Private/DataEngine.cpp"
+#include "../src/Private/Abstraction/Deque.cpp"
+#include "../src/Private/Abstraction/Graph.cpp"
+#include "../src/Private/Abstraction/List.cpp"
+#include "../src/Private/Abstraction/Map.cpp"
+#include "../src/Private/Abstraction/Matrix.cpp"
+#include "../src/Private/Abstraction/Set.cpp"
+#include "../src/Private/Abstraction/Stack.cpp"
+#include "../src/Private/Abstraction/Tree.cpp"
+#include "../src/Private/Implementation/ArrayDeque.cpp"
+#include "../src/Private/Implementation/ArrayList.cpp"
+#include "../src/Private/Implementation/BPlusTree.cpp"
+#include "../src/Private/Implementation/CSRGraph.cpp"
+#include "../src/Private/Implementation/DenseMatrix.cpp"
+#include "../src/Private/Implementation/CSRMatrix.cpp"
+#include "../src/Private/Implementation/CSCMatrix.cpp"
+#include "../src/Private/Implementation/HashMap.cpp"
+#include "../src/Private/Implementation/RoaringSet.cpp"
+#include "../src/Private/Implementation/SegmentedStack.cpp"
+#include "TestSupport.h"
+#include <algorithm>
+#include <memory>
+#include <span>
+#include <vector>
+
+using core::ArrayDeque;
+using core::ArrayList;
+using core::BPlusTree;
+using core::Contiguous;
+using core::CSRGraph;
+using core::CSRMatrix;
+using core::DataEngine;
+using core::DenseMatrix;
+using core::GraphEdge;
+using core::HashMap;
+using core::MatrixTriplet;
+using core::RoaringSet;
+using core::SegmentedStack;
+
+namespace {
+	static_assert(Contiguous<ArrayList<int>> && Contiguous<CSRMatrix<double>> && Contiguous<CSRGraph<unsigned>>);
+	static_assert(!Contiguous<ArrayDeque<int>> && !Contiguous<HashMap<int, int>> && !Contiguous<SegmentedStack<int>>);
+
+	/**
+	* Streams the engine out through buffers of several sizes, none of which divides its size, and checks
+	* the chunks put back together give the array toArray copies
+	*/
+	template<typename E>
+	void streamed(const DataEngine<E>& engine) {
+		const size_t size = engine.getActiveSize();
+		CHECK(size > 0);
+		const std::unique_ptr<E[]> expected(engine.toArray());
+		for (size_t chunk : { size_t{ 1 }, size_t{ 7 }, size_t{ 64 }, size + 3 }) {
+			std::vector<E> buffer(chunk);
+			std::vector<E> copied;
+			size_t start = 0;
+			while (const size_t count = engine.copyTo(std::span<E>(buffer), start)) {
+				CHECK(count == std::min(chunk, size - start));
+				copied.insert(copied.end(), buffer.begin(), buffer.begin() + count);
+				start += count;
+			}
+			CHECK(std::equal(copied.begin(), copied.end(), expected.get(), expected.get() + size));
+		}
+		//A range of toArray matches a copy from the same index
+		const size_t start = size / 3;
+		const std::unique_ptr<E[]> part(engine.toArray(static_cast<int>(start), static_cast<int>(size)));
+		std::vector<E> copied(size - start);
+		CHECK(engine.copyTo(std::span<E>(copied), start) == size - start);
+		CHECK(std::equal(copied.begin(), copied.end(), part.get()));
+		CHECK(engine.copyTo(std::span<E>(copied), size) == 0);
+		CHECK(engine.copyTo(std::span<E>(), 0) == 0);
+	}
+
+	void engines() {
+		ArrayList<int> list;
+		ArrayDeque<int> deque;
+		HashMap<int, int> map;
+		BPlusTree<int, int> tree;
+		SegmentedStack<int> stack;
+		RoaringSet<unsigned> set;
+		for (int item = 0; item < 3001; item++) {
+			list.add(item * 3);
+			//The deque wraps around its ring
+			if (item % 2 == 0) {
+				deque.addFirst(item);
+			}
+			else {
+				deque.addLast(item);
+			}
+			map.put(item * 11, item);
+			tree.put((item * 7) % 3001, item);
+			stack.push(item);
+			set.add(static_cast<unsigned>(item) * 97);
+		}
+		streamed(list);
+		streamed(deque);
+		streamed(map);
+		streamed(tree);
+		streamed(stack);
+		streamed(set);
+		//Elements of a dense matrix skip the padding of its rows
+		std::vector<double> values(9 * 13);
+		for (size_t index = 0; index < values.size(); index++) {
+			values[index] = static_cast<double>(index);
+		}
+		const DenseMatrix<double> matrix(9, 13, values.data());
+		streamed(matrix);
+		std::vector<double> copied(values.size());
+		CHECK(matrix.copyTo(std::span<double>(copied), 0) == values.size() && copied == values);
+	}
+
+	//Views alias the live storage, writes through them show in the engine and no copy is made
+	void views() {
+		ArrayList<int> list;
+		for (int item = 0; item < 100; item++) {
+			list.add(item);
+		}
+		const auto view = list.view();
+		CHECK(view.data() == std::to_address(list.begin()) && view.size() == 100);
+		view[42] = -1;
+		CHECK(list.get(42) == -1);
+		std::ranges::fill(view, 5);
+		CHECK(std::ranges::all_of(list, [](int item) { return item == 5; }));
+		const MatrixTriplet<double> triplets[] = { { 0, 1, 2.0 }, { 2, 0, 3.0 }, { 2, 2, 4.0 }, { 0, 1, 1.0 } };
+		CSRMatrix<double> sparse(3, 3, triplets, 4);
+		CHECK(sparse.view().size() == sparse.getNonZeros() && sparse.view().size() == 3);
+		CHECK(sparse.view()[0] == 3.0);
+		sparse.view()[2] = 8.0;
+		CHECK(sparse.get(2, 2) == 8.0);
+		const GraphEdge<unsigned> edges[] = { { 0, 1 }, { 0, 2 }, { 1, 2 }, { 2, 0 } };
+		const CSRGraph<unsigned> graph(3, edges, 4);
+		const std::span<const unsigned> targets = graph.view();
+		CHECK(targets.size() == graph.getActiveSize() && std::ranges::equal(targets, std::vector<unsigned>{ 1, 2, 2, 0 }));
+		CHECK(targets.data() == graph.neighbors(0).data());
+	}
+}
+
+int main() {
+	engines();
+	views();
+	return 0;
+}
@@ -0,0 +1,80 @@
+#include "../src/Private/DataEngine.cpp"
+#include "../src/Private/Abstraction/Matrix.cpp"
+#include "../src/Private/Implementation/DenseMatrix.cpp"
+#include "TestSupport.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using core::DenseMatrix;
+
+namespace {
+	template<typename E>
+	DenseMatrix<E> randomMatrix(size_t size, std::mt19937& random) {
+		std::vector<E> values(size * size);
+		for (E& value : values) {
+			value = static_cast<E>(random() % 17) / 8 - 1;
+		}
+		return DenseMatrix<E>(size, size, values.data());
+	}
+
+	//Best of a few runs, in billions of floating point operations per second
+	template<typename Product>
+	double gflops(size_t size, int runs, Product product) {
+		double best = 0;
+		for (int run = 0; run < runs; run++) {
+			const auto started = std::chrono::steady_clock::now();
+			product();
+			const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - started;
+			best = std::max(best, 2.0 * static_cast<double>(size * size * size) / elapsed.count() / 1e9);
+		}
+		return best;
+	}
+
+	//The naive triple loop the kernel is measured against, over the same padded rows
+	template<typename E>
+	void naive(const DenseMatrix<E>& left, const DenseMatrix<E>& right, DenseMatrix<E>& result) {
+		for (size_t row = 0; row < left.getRows(); row++) {
+			for (size_t column = 0; column < right.getColumns(); column++) {
+				E sum = 0;
+				for (size_t k = 0; k < left.getColumns(); k++) {
+					sum += left(row, k) * right(k, column);
+				}
+				result(row, column) = sum;
+			}
+		}
+	}
+
+	template<typename E>
+	void measure(const char* type, unsigned threads) {
+		std::mt19937 random(1);
+		for (size_t size : { 256, 512, 1024, 2048 }) {
+			const auto left = randomMatrix<E>(size, random);
+			const auto right = randomMatrix<E>(size, random);
+			DenseMatrix<E> result(size, size);
+			const double blocked = gflops(size, 3, [&] { DenseMatrix<E>::multiply(left, right, result, threads); });
+			CHECK(result(size - 1, size - 1) == result(size - 1, size - 1));
+			//The naive loop is only timed where it finishes in seconds
+			const double plain = size <= 512 ? gflops(size, 1, [&] { naive(left, right, result); }) : 0.0;
+			std::printf("%-6s  %5zu  %7u  %8.2f  %8.2f\n", type, size, threads, blocked, plain);
+		}
+	}
+}
+
+int main() {
+#if ENGINE_AVX512
+	const char* lanes = "AVX-512";
+#elif ENGINE_AVX2
+	const char* lanes = "AVX2";
+#elif ENGINE_SSE2
+	const char* lanes = "SSE2";
+#else
+	const char* lanes = "scalar";
+#endif
+	std::printf("%s lanes, %u hardware threads\ntype     size  threads   blocked     naive  (GFLOPS)\n", lanes, std::thread::hardware_concurrency());
+	measure<double>("double", 1);
+	measure<float>("float", 1);
+	return 0;
+}
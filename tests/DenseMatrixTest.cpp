@@ -0,0 +1,160 @@
+#include "../src/Private/DataEngine.cpp"
+#include "../src/Private/Abstraction/Matrix.cpp"
+#include "../src/Private/Implementation/DenseMatrix.cpp"
+#include "TestSupport.h"
+#include <atomic>
+#include <memory_resource>
+#include <new>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using core::DenseMatrix;
+
+namespace {
+	//Small integers, so that every product is exact whatever order the kernel adds in
+	template<typename E>
+	DenseMatrix<E> randomMatrix(size_t rows, size_t columns, std::mt19937& random) {
+		std::vector<E> values(rows * columns);
+		for (E& value : values) {
+			value = static_cast<E>(static_cast<int>(random() % 17) - 8);
+		}
+		return DenseMatrix<E>(rows, columns, values.data());
+	}
+
+	template<typename E>
+	bool naiveProduct(const DenseMatrix<E>& left, const DenseMatrix<E>& right, const DenseMatrix<E>& product) {
+		for (size_t row = 0; row < left.getRows(); row++) {
+			for (size_t column = 0; column < right.getColumns(); column++) {
+				E sum = 0;
+				for (size_t inner = 0; inner < left.getColumns(); inner++) {
+					sum += left(row, inner) * right(inner, column);
+				}
+				if (product(row, column) != sum) {
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	//The padding of every row must stay at zero, the kernels read it as part of their vectors
+	template<typename E>
+	bool paddedWithZeros(const DenseMatrix<E>& matrix) {
+		for (size_t row = 0; row < matrix.getRows(); row++) {
+			for (size_t column = matrix.getColumns(); column < matrix.getStride(); column++) {
+				if (matrix.getRow(row)[column] != 0) {
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	/**
+	* Sizes off every block and kernel boundary, and large enough for several depth slices and threads
+	*/
+	template<typename E>
+	void products() {
+		std::mt19937 random(31);
+		const size_t shapes[][3] = { { 1, 1, 1 }, { 3, 5, 7 }, { 17, 33, 9 }, { 64, 64, 64 }, { 130, 257, 71 }, { 300, 700, 200 } };
+		for (const auto& shape : shapes) {
+			const auto left = randomMatrix<E>(shape[0], shape[1], random);
+			const auto right = randomMatrix<E>(shape[1], shape[2], random);
+			for (unsigned threads : { 1u, 4u }) {
+				const auto product = left.multiply(right, threads);
+				CHECK(product.getRows() == shape[0] && product.getColumns() == shape[2]);
+				CHECK(naiveProduct(left, right, product));
+				CHECK(paddedWithZeros(product));
+			}
+		}
+		const auto square = randomMatrix<E>(5, 5, random);
+		bool rejected = false;
+		try {
+			(void)square.multiply(randomMatrix<E>(4, 5, random));
+		}
+		catch (const std::invalid_argument&) {
+			rejected = true;
+		}
+		CHECK(rejected);
+	}
+
+	void elements() {
+		DenseMatrix<double> matrix(3, 13);
+		CHECK(matrix.getStride() % 8 == 0 && matrix.getStride() >= 13);
+		CHECK(matrix.set(2, 12, 4.5));
+		CHECK(matrix.get(2, 12) == 4.5);
+		bool outside = false;
+		try {
+			matrix.set(3, 0, 1.0);
+		}
+		catch (const std::out_of_range&) {
+			outside = true;
+		}
+		CHECK(outside);
+		const auto transpose = matrix.transpose();
+		CHECK(transpose.getRows() == 13 && transpose(12, 2) == 4.5);
+		CHECK(paddedWithZeros(transpose));
+		size_t visited = 0;
+		for (double value : matrix) {
+			CHECK(value == 0.0 || value == 4.5);
+			visited++;
+		}
+		CHECK(visited == 3 * 13);
+	}
+
+	/**
+	* Resource refusing every allocation once its budget is spent, so that the packing buffers of the
+	* workers fail after the matrices themselves are built
+	*/
+	class LimitedResource : public std::pmr::memory_resource {
+	public:
+		explicit LimitedResource(int budget) : budget(budget) {}
+
+	protected:
+		void* do_allocate(size_t bytes, size_t alignment) override {
+			if (budget-- <= 0) {
+				throw std::bad_alloc();
+			}
+			return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+		}
+
+		void do_deallocate(void* block, size_t bytes, size_t alignment) override {
+			std::pmr::new_delete_resource()->deallocate(block, bytes, alignment);
+		}
+
+		[[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+			return this == &other;
+		}
+
+	private:
+		std::atomic<int> budget;
+	};
+
+	//A worker failing to allocate reaches the caller as an exception once every worker is done
+	void failingWorkers() {
+		using Matrix = DenseMatrix<double, std::pmr::polymorphic_allocator<std::byte>>;
+		LimitedResource resource(3);
+		const std::pmr::polymorphic_allocator<std::byte> allocator(&resource);
+		const Matrix left(256, 256, allocator);
+		const Matrix right(256, 256, allocator);
+		Matrix result(256, 256, allocator);
+		bool rejected = false;
+		try {
+			Matrix::multiply(left, right, result, 4);
+		}
+		catch (const std::bad_alloc&) {
+			rejected = true;
+		}
+		CHECK(rejected);
+	}
+}
+
+int main() {
+	products<double>();
+	products<float>();
+	products<int>();
+	elements();
+	failingWorkers();
+	return 0;
+}
@@ -0,0 +1,142 @@
+#include "../src/Private/DataEngine.cpp"
+#include "../src/Private/Abstraction/Graph.cpp"
+#include "../src/Private/Implementation/CSRGraph.cpp"
+#include "../src/Private/Implementation/DynamicGraph.cpp"
+#include "TestSupport.h"
+#include <atomic>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+using core::CSRGraph;
+using core::DynamicGraph;
+using core::GraphEdge;
+
+namespace {
+	using Graph = DynamicGraph<unsigned>;
+	using Reference = std::set<std::pair<unsigned, unsigned>>;
+
+	//Random batches of insertions and removals, with repeats and missing edges, over many pages
+	void againstReference() {
+		constexpr unsigned VERTICES = 5000;
+		Graph graph(VERTICES);
+		Reference reference;
+		std::mt19937 random(53);
+		std::vector<GraphEdge<unsigned>> batch;
+		for (int round = 0; round < 60; round++) {
+			batch.clear();
+			const size_t size = round % 5 == 0 ? 20000 : 1 + random() % 500;
+			for (size_t index = 0; index < size; index++) {
+				//Removals pick existing edges half of the time
+				if (round % 3 == 2 && index % 2 == 0 && !reference.empty()) {
+					auto edge = reference.lower_bound({ static_cast<unsigned>(random() % VERTICES), 0 });
+					if (edge != reference.end()) {
+						batch.push_back({ edge->first, edge->second });
+						continue;
+					}
+				}
+				batch.push_back({ static_cast<unsigned>(random() % VERTICES), static_cast<unsigned>(random() % VERTICES) });
+			}
+			const unsigned threads = round % 2 == 0 ? 1 : 4;
+			size_t changed = 0;
+			for (const auto& edge : batch) {
+				changed += round % 3 == 2 ? reference.erase({ edge.source, edge.target }) : reference.insert({ edge.source, edge.target }).second;
+			}
+			if (round % 3 == 2) {
+				CHECK(graph.removeEdges(batch.data(), batch.size(), threads) == changed);
+			}
+			else {
+				CHECK(graph.insertEdges(batch.data(), batch.size(), threads) == changed);
+			}
+			CHECK(graph.getActiveSize() == reference.size());
+		}
+		std::vector<GraphEdge<unsigned>> remaining;
+		for (const auto& [source, target] : reference) {
+			remaining.push_back({ source, target });
+		}
+		CHECK(graph.toCSR(4) == CSRGraph<unsigned>(VERTICES, remaining.data(), remaining.size()));
+		for (unsigned vertex = 0; vertex < VERTICES; vertex += 37) {
+			std::vector<unsigned> expected;
+			for (auto edge = reference.lower_bound({ vertex, 0 }); edge != reference.end() && edge->first == vertex; ++edge) {
+				expected.push_back(edge->second);
+			}
+			CHECK(graph.getNeighbors(vertex) == expected);
+		}
+	}
+
+	/**
+	* Every batch gives each vertex one more arc or takes one away, over several pages, two insertions for
+	* each removal. A snapshot seeing part of a batch would find vertices of different degrees
+	*/
+	void snapshotsDuringBatches() {
+		constexpr unsigned VERTICES = 1024;
+		constexpr unsigned BATCHES = 200;
+		constexpr size_t READERS = 4;
+		Graph graph(VERTICES);
+		std::atomic<bool> writing{ true };
+		test::concurrently(READERS + 1, [&](size_t thread) {
+			if (thread == READERS) {
+				std::vector<GraphEdge<unsigned>> batch(VERTICES);
+				//Arcs of a batch go the same distance ahead, removals take away the oldest distance left
+				unsigned inserted = 0;
+				unsigned removed = 0;
+				for (unsigned round = 0; round < BATCHES; round++) {
+					const bool removing = round % 3 == 2;
+					const unsigned distance = 1 + (removing ? removed++ : inserted++);
+					for (unsigned vertex = 0; vertex < VERTICES; vertex++) {
+						batch[vertex] = { vertex, (vertex + distance) % VERTICES };
+					}
+					if (removing) {
+						CHECK(graph.removeEdges(batch.data(), VERTICES, 2) == VERTICES);
+					}
+					else {
+						CHECK(graph.insertEdges(batch.data(), VERTICES, 2) == VERTICES);
+					}
+				}
+				writing = false;
+				return;
+			}
+			do {
+				const auto snapshot = graph.snapshot();
+				const size_t degree = snapshot.getDegree(0);
+				CHECK(snapshot.getArcs() == degree * VERTICES);
+				for (unsigned vertex = 0; vertex < VERTICES; vertex += 7) {
+					CHECK(snapshot.getDegree(vertex) == degree);
+					CHECK(snapshot.neighbors(vertex).size() == degree);
+				}
+			} while (writing);
+		});
+	}
+
+	void growth() {
+		Graph graph(2, false);
+		CHECK(graph.insertEdge(0, 1));
+		CHECK(!graph.insertEdge(1, 0));
+		CHECK(graph.insertEdge(1, 700));
+		CHECK(graph.getVertices() == 701);
+		CHECK(graph.containsEdge(700, 1) && graph.containsEdge(0, 1));
+		const auto parents = graph.breadthFirst(0);
+		CHECK(parents[700] == 1 && parents[1] == 0 && parents[350] == Graph::NONE);
+		const GraphEdge<unsigned> invalid[] = { { 0, 2 }, { 0, Graph::NONE } };
+		bool rejected = false;
+		try {
+			graph.insertEdges(invalid, 2);
+		}
+		catch (const std::out_of_range&) {
+			rejected = true;
+		}
+		CHECK(rejected && !graph.containsEdge(0, 2));
+		Graph moved(std::move(graph));
+		CHECK(moved.containsEdge(1, 700) && graph.getActiveSize() == 0);
+		CHECK(moved.removeEdge(700, 1) && !moved.containsEdge(1, 700));
+	}
+}
+
+int main() {
+	againstReference();
+	snapshotsDuringBatches();
+	growth();
+	return 0;
+}
@@ -0,0 +1,160 @@
+#include "../src/Private/DataEngine.cpp"
+#include "../src/Private/Abstraction/Graph.cpp"
+#include "../src/Private/Implementation/CSRGraph.cpp"
+#include "TestSupport.h"
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <queue>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+using core::CSRGraph;
+using core::GraphEdge;
+using core::GraphPhase;
+using core::WeightedGraphEdge;
+
+namespace {
+	using Graph = CSRGraph<unsigned>;
+
+	void dijkstra(const Graph& graph, unsigned source, std::vector<double>& distances) {
+		distances.assign(graph.getVertices(), std::numeric_limits<double>::infinity());
+		using Item = std::pair<double, unsigned>;
+		std::priority_queue<Item, std::vector<Item>, std::greater<>> queue;
+		distances[source] = 0;
+		queue.push({ 0, source });
+		while (!queue.empty()) {
+			const auto [distance, vertex] = queue.top();
+			queue.pop();
+			if (distance > distances[vertex]) {
+				continue;
+			}
+			const auto targets = graph.neighbors(vertex);
+			const auto weights = graph.neighborWeights(vertex);
+			for (size_t arc = 0; arc < targets.size(); arc++) {
+				if (distance + weights[arc] < distances[targets[arc]]) {
+					distances[targets[arc]] = distance + weights[arc];
+					queue.push({ distances[targets[arc]], targets[arc] });
+				}
+			}
+		}
+	}
+
+	/**
+	* Whole weights, so that every path length is exact and both algorithms agree to the last bit, with
+	* repeated edges of which the lightest must be kept
+	*/
+	void shortestPaths() {
+		constexpr unsigned VERTICES = 50000;
+		std::mt19937 random(43);
+		std::vector<WeightedGraphEdge<unsigned>> edges;
+		for (size_t index = 0; index < 400000; index++) {
+			const unsigned source = static_cast<unsigned>(random() % (VERTICES - 10));
+			const unsigned target = static_cast<unsigned>(random() % (VERTICES - 10));
+			edges.push_back({ source, target, static_cast<float>(1 + random() % 20) });
+			if (index % 10 == 0) {
+				edges.push_back({ source, target, 1.0f });
+			}
+		}
+		for (bool directed : { true, false }) {
+			const Graph graph(VERTICES, edges.data(), edges.size(), directed, 4);
+			CHECK(graph.isWeighted());
+			std::vector<double> expected;
+			dijkstra(graph, 0, expected);
+			CHECK(expected[VERTICES - 1] == std::numeric_limits<double>::infinity());
+			for (double delta : { 1.0, 8.0, 100.0 }) {
+				for (unsigned threads : { 1u, 4u }) {
+					std::vector<GraphPhase> phases;
+					CHECK(graph.shortestPaths(0, delta, threads, &phases) == expected);
+					CHECK(!phases.empty());
+				}
+			}
+		}
+		const Graph graph(VERTICES, edges.data(), edges.size());
+		bool rejected = false;
+		try {
+			(void)graph.shortestPaths(0, 0.0);
+		}
+		catch (const std::invalid_argument&) {
+			rejected = true;
+		}
+		CHECK(rejected);
+	}
+
+	//Paths far longer than the bucket width land in sparse buckets instead of an array indexed by bucket
+	void distantBuckets() {
+		constexpr unsigned VERTICES = 200;
+		std::vector<WeightedGraphEdge<unsigned>> edges;
+		for (unsigned vertex = 0; vertex + 1 < VERTICES; vertex++) {
+			edges.push_back({ vertex, vertex + 1, vertex % 2 == 0 ? 1e30f : 0.5f });
+			edges.push_back({ vertex, (vertex * 7 + 3) % VERTICES, 2e25f });
+		}
+		const Graph graph(VERTICES, edges.data(), edges.size());
+		std::vector<double> expected;
+		dijkstra(graph, 0, expected);
+		for (double delta : { 1e-3, 1.0, 1e28 }) {
+			for (unsigned threads : { 1u, 4u }) {
+				CHECK(graph.shortestPaths(0, delta, threads) == expected);
+			}
+		}
+		//Infinite weights are rejected when the graph is built, before any search
+		for (float weight : { std::numeric_limits<float>::infinity(), -1.0f, std::numeric_limits<float>::quiet_NaN() }) {
+			const WeightedGraphEdge<unsigned> bad[] = { { 0, 1, 1.0f }, { 1, 2, weight } };
+			bool rejected = false;
+			try {
+				const Graph invalid(3, bad, 2);
+			}
+			catch (const std::invalid_argument&) {
+				rejected = true;
+			}
+			CHECK(rejected);
+		}
+	}
+
+	unsigned find(std::vector<unsigned>& parents, unsigned vertex) {
+		while (parents[vertex] != vertex) {
+			vertex = parents[vertex] = parents[parents[vertex]];
+		}
+		return vertex;
+	}
+
+	//Many small components beside a giant one, arcs of the directed graph count both ways
+	void components() {
+		constexpr unsigned VERTICES = 100000;
+		std::mt19937 random(47);
+		std::vector<GraphEdge<unsigned>> edges;
+		for (size_t index = 0; index < 60000; index++) {
+			const unsigned source = static_cast<unsigned>(random() % VERTICES);
+			//Half of the arcs stay within a block of 8 vertices, the rest join blocks together
+			const unsigned target = index % 2 == 0 ? (source & ~7u) + static_cast<unsigned>(random() % 8) : static_cast<unsigned>(random() % VERTICES);
+			edges.push_back({ source, target });
+		}
+		std::vector<unsigned> parents(VERTICES);
+		std::iota(parents.begin(), parents.end(), 0u);
+		for (const auto& edge : edges) {
+			const unsigned first = find(parents, edge.source);
+			const unsigned second = find(parents, edge.target);
+			parents[std::max(first, second)] = std::min(first, second);
+		}
+		for (bool directed : { true, false }) {
+			const Graph graph(VERTICES, edges.data(), edges.size(), directed, 4);
+			for (unsigned threads : { 1u, 4u }) {
+				std::vector<GraphPhase> phases;
+				const auto labels = graph.components(threads, &phases);
+				CHECK(!phases.empty());
+				for (unsigned vertex = 0; vertex < VERTICES; vertex++) {
+					CHECK(labels[vertex] == find(parents, vertex));
+				}
+			}
+		}
+	}
+}
+
+int main() {
+	shortestPaths();
+	distantBuckets();
+	components();
+	return 0;
+}
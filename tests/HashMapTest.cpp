@@ -0,0 +1,123 @@
+#include "../src/Private/DataEngine.cpp"
+#include "../src/Private/Abstraction/Map.cpp"
+#include "../src/Private/Implementation/HashMap.cpp"
+#include "TestSupport.h"
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+using core::HashMap;
+
+namespace {
+	//Random puts and removes over a small key range, so that probes keep crossing deleted slots and the table grows and shrinks
+	void againstReference() {
+		HashMap<int, std::string> map;
+		std::unordered_map<int, std::string> reference;
+		std::mt19937 random(7);
+		std::uniform_int_distribution<int> keys(0, 2000);
+		for (int step = 0; step < 200000; step++) {
+			const int key = keys(random);
+			std::string value;
+			if (random() % 3 != 0) {
+				const bool added = reference.insert_or_assign(key, std::to_string(step)).second;
+				CHECK(map.put(key, std::to_string(step)) == added);
+			}
+			else {
+				CHECK(map.remove(key) == (reference.erase(key) == 1));
+			}
+			CHECK(map.get(key, value) == reference.contains(key));
+			if (step % 1000 == 0) {
+				CHECK(map.getActiveSize() == reference.size());
+			}
+		}
+		size_t visited = 0;
+		for (auto& entry : map) {
+			CHECK(reference.at(entry.key) == entry.value);
+			visited++;
+		}
+		CHECK(visited == reference.size());
+	}
+
+	//Keys whose hashes share their low bits land in the same groups
+	void collidingKeys() {
+		HashMap<long long, int> map;
+		constexpr int COUNT = 5000;
+		for (int index = 0; index < COUNT; index++) {
+			CHECK(map.put(static_cast<long long>(index) << 32, index));
+		}
+		int value = -1;
+		for (int index = 0; index < COUNT; index++) {
+			CHECK(map.get(static_cast<long long>(index) << 32, value) && value == index);
+		}
+		CHECK(!map.get(1, value));
+		for (int index = 0; index < COUNT; index += 2) {
+			CHECK(map.remove(static_cast<long long>(index) << 32));
+		}
+		CHECK(map.getActiveSize() == COUNT / 2);
+		CHECK(map.get(static_cast<long long>(COUNT - 1) << 32, value) && value == COUNT - 1);
+	}
+
+	void copies() {
+		HashMap<std::string, int> map;
+		for (int index = 0; index < 300; index++) {
+			map.put(std::to_string(index), index);
+		}
+		auto copy = map.clone();
+		map.removeAll();
+		CHECK(map.getActiveSize() == 0);
+		CHECK(copy->getActiveSize() == 300);
+		CHECK(!(map == *copy));
+		HashMap<std::string, int> moved(std::move(*static_cast<HashMap<std::string, int>*>(copy.get())));
+		int value = -1;
+		CHECK(moved.get("299", value) && value == 299);
+	}
+
+	/**
+	* Value owning heap memory whose copies throw once the budget of copies is spent
+	*/
+	struct Limited {
+		static inline int budget = -1;
+		std::string payload = std::string(64, 'x');
+
+		Limited() = default;
+		Limited(const Limited& other) : payload(other.payload) {
+			if (budget == 0) {
+				throw std::runtime_error("copy failed");
+			}
+			budget--;
+		}
+		Limited(Limited&&) noexcept = default;
+		Limited& operator=(const Limited&) = default;
+		Limited& operator=(Limited&&) noexcept = default;
+		bool operator==(const Limited&) const = default;
+	};
+
+	//A copy failing part way through a clone destroys only the entries already copied, and the source is untouched
+	void failingClone() {
+		HashMap<int, Limited> map;
+		for (int key = 0; key < 100; key++) {
+			map.put(key, Limited());
+		}
+		Limited::budget = 40;
+		bool rejected = false;
+		try {
+			map.clone();
+		}
+		catch (const std::runtime_error&) {
+			rejected = true;
+		}
+		Limited::budget = -1;
+		CHECK(rejected && map.getActiveSize() == 100);
+		auto copy = map.clone();
+		CHECK(copy->getActiveSize() == 100 && map == *copy);
+	}
+}
+
+int main() {
+	againstReference();
+	collidingKeys();
+	copies();
+	failingClone();
+	return 0;
+}
@@ -0,0 +1,222 @@
+#include "../src/Private/DataEngine.cpp"
+#include "../src/Private/Abstraction/Deque.cpp"
+#include "../src/Private/Abstraction/Graph.cpp"
+#include "../src/Private/Abstraction/List.cpp"
+#include "../src/Private/Abstraction/Map.cpp"
+#include "../src/Private/Abstraction/Matrix.cpp"
+#include "../src/Private/Abstraction/Queue.cpp"
+#include "../src/Private/Abstraction/Set.cpp"
+#include "../src/Private/Abstraction/SkipList.cpp"
+#include "../src/Private/Abstraction/Stack.cpp"
+#include "../src/Private/Abstraction/Tree.cpp"
+#include "../src/Private/Abstraction/Trie.cpp"
+#include "../src/Private/Implementation/AdaptiveRadixTree.cpp"
+#include "../src/Private/Implementation/ArrayDeque.cpp"
+#include "../src/Private/Implementation/ArrayList.cpp"
+#include "../src/Private/Implementation/BPlusTree.cpp"
+#include "../src/Private/Implementation/ConcurrentArrayQueue.cpp"
+#include "../src/Private/Implementation/ConcurrentHashMap.cpp"
+#include "../src/Private/Implementation/ConcurrentSkipList.cpp"
+#include "../src/Private/Implementation/DenseMatrix.cpp"
+#include "../src/Private/Implementation/DynamicGraph.cpp"
+#include "../src/Private/Implementation/HashMap.cpp"
+#include "../src/Private/Implementation/RoaringSet.cpp"
+#include "../src/Private/Implementation/SegmentedStack.cpp"
+#include "../src/Private/Implementation/SuccinctTrie.cpp"
+#include "../src/Private/Implementation/WorkStealingDeque.cpp"
+#include "TestSupport.h"
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+#include <ranges>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+using core::AdaptiveRadixTree;
+using core::ArrayDeque;
+using core::ArrayList;
+using core::BPlusTree;
+using core::ConcurrentArrayQueue;
+using core::ConcurrentHashMap;
+using core::ConcurrentSkipList;
+using core::DenseMatrix;
+using core::DynamicGraph;
+using core::Entry;
+using core::GraphEdge;
+using core::HashMap;
+using core::Iterable;
+using core::RoaringSet;
+using core::SegmentedStack;
+using core::SuccinctTrie;
+using core::WorkStealingDeque;
+
+namespace {
+	template<typename Engine>
+	using IteratorOf = decltype(std::declval<Engine&>().begin());
+
+	//Each engine models the strongest category its layout allows, and no more
+	static_assert(std::contiguous_iterator<IteratorOf<ArrayList<int>>>);
+	static_assert(std::random_access_iterator<IteratorOf<ArrayDeque<int>>>);
+	static_assert(!std::contiguous_iterator<IteratorOf<ArrayDeque<int>>>);
+	static_assert(std::bidirectional_iterator<IteratorOf<BPlusTree<int, int>>>);
+	static_assert(std::bidirectional_iterator<IteratorOf<DenseMatrix<double>>>);
+	static_assert(std::bidirectional_iterator<IteratorOf<SegmentedStack<int>>>);
+	static_assert(std::forward_iterator<IteratorOf<HashMap<int, int>>>);
+	static_assert(std::forward_iterator<IteratorOf<RoaringSet<unsigned>>>);
+	static_assert(!std::bidirectional_iterator<IteratorOf<HashMap<int, int>>>);
+	static_assert(Iterable<ArrayList<int>> && Iterable<ArrayDeque<int>> && Iterable<BPlusTree<int, int>> && Iterable<HashMap<int, int>>);
+	static_assert(std::ranges::random_access_range<ArrayDeque<int>> && std::ranges::contiguous_range<ArrayList<int>>);
+
+	template<typename Engine>
+	using ReferenceOf = std::iter_reference_t<IteratorOf<const Engine>>;
+
+	//The iterators of a const engine hand out const references or copies, never a way to change the engine
+	template<typename Engine>
+	concept ReadOnly = Iterable<const Engine> &&
+		(!std::is_lvalue_reference_v<ReferenceOf<Engine>> || std::is_const_v<std::remove_reference_t<ReferenceOf<Engine>>>);
+
+	static_assert(ReadOnly<AdaptiveRadixTree<uint64_t, int>> && ReadOnly<ArrayDeque<int>> && ReadOnly<ArrayList<int>>);
+	static_assert(ReadOnly<BPlusTree<int, int>> && ReadOnly<ConcurrentArrayQueue<int>> && ReadOnly<ConcurrentHashMap<int, int>>);
+	static_assert(ReadOnly<ConcurrentSkipList<int, int>> && ReadOnly<DenseMatrix<double>> && ReadOnly<DynamicGraph<unsigned>>);
+	static_assert(ReadOnly<HashMap<int, int>> && ReadOnly<RoaringSet<unsigned>> && ReadOnly<SegmentedStack<int>>);
+	static_assert(ReadOnly<SuccinctTrie<std::string, int>> && ReadOnly<WorkStealingDeque<int>>);
+	static_assert(std::random_access_iterator<IteratorOf<const ArrayDeque<int>>> && std::bidirectional_iterator<IteratorOf<const BPlusTree<int, int>>>);
+
+	//Sorting through the iterators of a deque whose head has wrapped around the end of its ring
+	void randomAccess() {
+		ArrayDeque<int> deque;
+		for (int item = 0; item < 40; item++) {
+			deque.addLast((item * 17) % 41);
+		}
+		for (int item = 0; item < 30; item++) {
+			deque.addFirst(100 + (item * 7) % 31);
+		}
+		std::vector<int> expected(deque.begin(), deque.end());
+		CHECK(expected.size() == 70);
+		std::ranges::sort(deque);
+		std::ranges::sort(expected);
+		CHECK(std::ranges::equal(deque, expected));
+		CHECK(std::ranges::binary_search(deque, 123));
+		auto middle = deque.begin() + 35;
+		CHECK(*middle == expected[35] && middle - deque.begin() == 35 && deque.end() - middle == 35);
+		CHECK(middle[-5] == expected[30] && *(middle--) == expected[35] && *middle == expected[34]);
+		std::ranges::reverse(deque);
+		CHECK(std::ranges::equal(deque, expected | std::views::reverse));
+	}
+
+	//Stepping back from the end crosses leaves, and entries can be updated in place
+	void bidirectional() {
+		BPlusTree<int, int> tree;
+		for (int key = 0; key < 5000; key++) {
+			tree.put((key * 7919) % 5000, key);
+		}
+		CHECK(std::ranges::is_sorted(tree, {}, &Entry<int, int>::key));
+		int expected = 4999;
+		for (const auto& entry : tree | std::views::reverse) {
+			CHECK(entry.key == expected--);
+		}
+		CHECK(expected == -1);
+		for (auto& entry : tree) {
+			entry.value = -entry.key;
+		}
+		CHECK(std::ranges::all_of(tree, [](const Entry<int, int>& entry) { return entry.value == -entry.key; }));
+		auto last = std::ranges::prev(tree.end());
+		CHECK(last->key == 4999 && (last++)->key == 4999 && last == tree.end());
+		//The padding at the end of each row is never visited
+		DenseMatrix<double> matrix(5, 11);
+		std::ranges::fill(matrix, 2.0);
+		CHECK(std::ranges::distance(matrix) == 55);
+		CHECK(std::accumulate(matrix.begin(), matrix.end(), 0.0) == 110.0);
+		CHECK(matrix.getRow(4)[matrix.getStride() - 1] == 0.0);
+		SegmentedStack<int> stack;
+		for (int item = 0; item < 3000; item++) {
+			stack.push(item % 10);
+		}
+		CHECK(std::ranges::count(stack, 3) == 300);
+		CHECK(std::ranges::distance(stack.begin(), stack.end()) == 3000);
+		CHECK(std::ranges::equal(stack | std::views::reverse | std::views::reverse, stack));
+	}
+
+	void forward() {
+		HashMap<int, int> map;
+		for (int key = 0; key < 1000; key++) {
+			map.put(key, key * 2);
+		}
+		CHECK(std::ranges::distance(map) == 1000);
+		CHECK(std::ranges::count_if(map, [](const Entry<int, int>& entry) { return entry.value == entry.key * 2; }) == 1000);
+		//Items decoded on the fly are returned by value and still come in increasing order
+		RoaringSet<unsigned> set;
+		for (unsigned item = 0; item < 100000; item += 3) {
+			set.add(item);
+		}
+		CHECK(std::ranges::is_sorted(set) && std::ranges::distance(set) == 33334);
+		CHECK(*std::ranges::find(set, 99999u) == 99999u && std::ranges::find(set, 100u) == set.end());
+		ArrayList<int> list;
+		for (int item = 0; item < 100; item++) {
+			list.add(99 - item);
+		}
+		std::ranges::sort(list);
+		CHECK(std::to_address(list.begin()) + 99 == std::to_address(std::ranges::prev(list.end())));
+		CHECK(std::ranges::equal(list, std::views::iota(0, 100)));
+	}
+
+	//Counts the items of an engine through a range-for over a const reference
+	template<typename Engine>
+	size_t visit(const Engine& engine) {
+		size_t count = 0;
+		for ([[maybe_unused]] const auto& item : engine) {
+			count++;
+		}
+		return count;
+	}
+
+	void constRanges() {
+		AdaptiveRadixTree<uint64_t, int> radix;
+		ArrayDeque<int> deque;
+		BPlusTree<int, int> tree;
+		ConcurrentArrayQueue<int> queue(128);
+		ConcurrentHashMap<int, int> concurrentMap;
+		ConcurrentSkipList<int, int> skipList;
+		HashMap<int, int> map;
+		RoaringSet<unsigned> set;
+		SegmentedStack<int> stack;
+		WorkStealingDeque<int> stealing(16);
+		std::vector<Entry<std::string, int>> entries;
+		std::vector<GraphEdge<unsigned>> edges;
+		for (int item = 0; item < 100; item++) {
+			radix.put(static_cast<uint64_t>(item) * 977, item);
+			deque.addFirst(item);
+			tree.put(item, item);
+			queue.enqueue(item);
+			concurrentMap.put(item, item);
+			skipList.put(item, item);
+			map.put(item, item);
+			set.add(static_cast<unsigned>(item) * 5);
+			stack.push(item);
+			stealing.addLast(item);
+			entries.push_back({ "key" + std::to_string(1000 + item), item });
+			edges.push_back({ static_cast<unsigned>(item), static_cast<unsigned>((item + 1) % 100) });
+		}
+		const SuccinctTrie<std::string, int> trie(entries.data(), entries.size());
+		const DynamicGraph<unsigned> graph(100, edges.data(), edges.size());
+		const DenseMatrix<double> matrix(10, 10);
+		CHECK(visit(radix) == 100 && visit(deque) == 100 && visit(tree) == 100 && visit(queue) == 100);
+		CHECK(visit(concurrentMap) == 100 && visit(skipList) == 100 && visit(map) == 100 && visit(set) == 100);
+		CHECK(visit(stack) == 100 && visit(stealing) == 100 && visit(trie) == 100 && visit(graph) == 100);
+		CHECK(visit(matrix) == 100);
+		//A const engine reads the same items in the same order as a mutable one
+		const ArrayDeque<int>& view = deque;
+		CHECK(std::ranges::equal(view, deque) && view.end() - view.begin() == 100 && view.begin()[99] == 0);
+		const BPlusTree<int, int>& sorted = tree;
+		CHECK(std::ranges::prev(sorted.end())->key == 99);
+	}
+}
+
+int main() {
+	randomAccess();
+	bidirectional();
+	forward();
+	constRanges();
+	return 0;
+}
@@ -0,0 +1,98 @@
+#include "../src/Private/DataEngine.cpp"
+#include "../src/Private/Abstraction/Matrix.cpp"
+#include "../src/Private/Implementation/DenseMatrix.cpp"
+#include "TestSupport.h"
+#include <stdexcept>
+#include <vector>
+
+using core::DenseMatrix;
+
+namespace {
+	//Columns off the vector width, so that each row ends with elements done one by one
+	constexpr size_t ROWS = 7;
+	constexpr size_t COLUMNS = 13;
+
+	DenseMatrix<double> sequence(double first, double step, size_t rows = ROWS, size_t columns = COLUMNS) {
+		std::vector<double> values(rows * columns);
+		for (size_t index = 0; index < values.size(); index++) {
+			values[index] = first + step * static_cast<double>(index);
+		}
+		return DenseMatrix<double>(rows, columns, values.data());
+	}
+
+	template<typename Expected>
+	bool matches(const DenseMatrix<double>& matrix, Expected expected) {
+		for (size_t row = 0; row < matrix.getRows(); row++) {
+			for (size_t column = 0; column < matrix.getColumns(); column++) {
+				if (matrix(row, column) != expected(row, column)) {
+					return false;
+				}
+			}
+			for (size_t column = matrix.getColumns(); column < matrix.getStride(); column++) {
+				if (matrix.getRow(row)[column] != 0) {
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	void chained() {
+		const auto a = sequence(1, 1);
+		const auto b = sequence(100, -2);
+		const auto c = sequence(0.5, 0.25);
+		DenseMatrix<double> result = a + b * 2.0 - hadamard(a, c) / 4.0;
+		CHECK(matches(result, [&](size_t row, size_t column) {
+			return a(row, column) + b(row, column) * 2.0 - a(row, column) * c(row, column) / 4.0;
+		}));
+		result = 1.0 - result;
+		CHECK(matches(result, [&](size_t row, size_t column) {
+			return 1.0 - (a(row, column) + b(row, column) * 2.0 - a(row, column) * c(row, column) / 4.0);
+		}));
+	}
+
+	//Reading the destination where it is written is done in place, the compound assignments included
+	void inPlace() {
+		auto a = sequence(1, 1);
+		const auto b = sequence(3, 0.5);
+		const double* storage = a.getRow(0);
+		a = a * 3.0 + b;
+		a -= b;
+		a /= 3.0;
+		CHECK(a.getRow(0) == storage);
+		CHECK(matches(a, [](size_t row, size_t column) { return 1.0 + static_cast<double>(row * COLUMNS + column); }));
+	}
+
+	//A transpose of the destination reads it elsewhere, so the result is built aside and swapped in
+	void aliased() {
+		auto square = sequence(0, 1, 9, 9);
+		const auto original = sequence(0, 1, 9, 9);
+		square = transposed(square) + square;
+		CHECK(matches(square, [&](size_t row, size_t column) { return original(column, row) + original(row, column); }));
+		auto wide = sequence(0, 1, 3, 11);
+		wide = transposed(wide) * 2.0;
+		CHECK(wide.getRows() == 11 && wide.getColumns() == 3);
+		CHECK(matches(wide, [](size_t row, size_t column) { return 2.0 * static_cast<double>(column * 11 + row); }));
+	}
+
+	void mismatchedSizes() {
+		const auto a = sequence(0, 1);
+		const auto b = sequence(0, 1, ROWS, COLUMNS + 1);
+		bool rejected = false;
+		try {
+			DenseMatrix<double> sum = a + b;
+		}
+		catch (const std::invalid_argument&) {
+			rejected = true;
+		}
+		CHECK(rejected);
+	}
+}
+
+int main() {
+	chained();
+	inPlace();
+	aliased();
+	mismatchedSizes();
+	return 0;
+}
@@ -0,0 +1,173 @@
+#include "../src/Private/DataEngine.cpp"
+#include "../src/Private/Abstraction/Map.cpp"
+#include "../src/Private/Abstraction/Tree.cpp"
+#include "../src/Private/Abstraction/Trie.cpp"
+#include "../src/Private/Implementation/AdaptiveRadixTree.cpp"
+#include "../src/Private/Implementation/BPlusTree.cpp"
+#include "../src/Public/EnginePool.h"
+#include "TestSupport.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+using core::AdaptiveRadixTree;
+using core::BPlusTree;
+using core::NodePool;
+using core::PoolAllocator;
+
+namespace {
+	/**
+	* Resource counting the bytes it has handed out and not yet got back
+	*/
+	class CountingResource : public std::pmr::memory_resource {
+	public:
+		std::atomic<long long> outstanding{ 0 };
+		std::atomic<long long> allocations{ 0 };
+
+	protected:
+		void* do_allocate(size_t bytes, size_t alignment) override {
+			outstanding += static_cast<long long>(bytes);
+			allocations++;
+			return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+		}
+
+		void do_deallocate(void* block, size_t bytes, size_t alignment) override {
+			outstanding -= static_cast<long long>(bytes);
+			std::pmr::new_delete_resource()->deallocate(block, bytes, alignment);
+		}
+
+		[[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+			return this == &other;
+		}
+	};
+
+	bool aligned(const void* block, size_t alignment) {
+		return reinterpret_cast<std::uintptr_t>(block) % alignment == 0;
+	}
+
+	//Small blocks come from slabs carved in batches, freed ones are handed out again first, large ones go upstream
+	void blocks() {
+		CountingResource resource;
+		{
+			NodePool pool(&resource);
+			for (size_t bytes : { 1, 8, 24, 100, 1000, 4096 }) {
+				for (size_t alignment : { 8, 16, 32, 64 }) {
+					void* block = pool.allocate(bytes, alignment);
+					CHECK(aligned(block, alignment));
+					std::memset(block, 0xAB, bytes);
+					pool.deallocate(block, bytes, alignment);
+				}
+			}
+			std::vector<void*> nodes;
+			const long long before = resource.allocations;
+			for (int index = 0; index < 1000; index++) {
+				nodes.push_back(pool.allocate(48, 8));
+			}
+			CHECK(resource.allocations - before < 10);
+			void* last = nodes.back();
+			pool.deallocate(last, 48, 8);
+			CHECK(pool.allocate(48, 8) == last);
+			for (void* node : nodes) {
+				pool.deallocate(node, 48, 8);
+			}
+			//Freeing every block keeps the slabs, the same blocks serve the next nodes without going upstream
+			const long long settled = resource.allocations;
+			for (int index = 0; index < 1000; index++) {
+				nodes[index] = pool.allocate(48, 8);
+			}
+			CHECK(resource.allocations == settled);
+			const long long held = resource.outstanding;
+			void* large = pool.allocate(NodePool::MAX_BLOCK + 1, 32);
+			CHECK(aligned(large, 32) && resource.allocations == settled + 1 && resource.outstanding > held);
+			pool.deallocate(large, NodePool::MAX_BLOCK + 1, 32);
+			CHECK(resource.outstanding == held);
+			//Release drops the slabs and the large blocks still held alike
+			void* kept = pool.allocate(NodePool::MAX_BLOCK * 2, 8);
+			CHECK(kept != nullptr && resource.outstanding > held);
+			std::memset(kept, 0xCD, NodePool::MAX_BLOCK * 2);
+			pool.release();
+			CHECK(resource.outstanding < held);
+			CHECK(aligned(pool.allocate(64, 64), 64));
+		}
+		CHECK(resource.outstanding == 0);
+	}
+
+	/**
+	* Blocks allocated on one thread are freed on another, so batches move between the caches through the
+	* shared pool while every thread keeps allocating
+	*/
+	void crossThreads() {
+		constexpr size_t THREADS = 4;
+		constexpr size_t NODES = 20000;
+		CountingResource resource;
+		{
+			NodePool pool(&resource);
+			std::vector<std::vector<uint64_t*>> owned(THREADS);
+			for (int round = 0; round < 3; round++) {
+				test::concurrently(THREADS, [&](size_t thread) {
+					auto& mine = owned[thread];
+					for (uint64_t* node : mine) {
+						CHECK(node[0] == ((thread + THREADS - 1) % THREADS) && node[1] == reinterpret_cast<uint64_t>(node));
+						pool.deallocate(node, 2 * sizeof(uint64_t), alignof(uint64_t));
+					}
+					mine.clear();
+					for (size_t index = 0; index < NODES; index++) {
+						auto node = static_cast<uint64_t*>(pool.allocate(2 * sizeof(uint64_t), alignof(uint64_t)));
+						node[0] = thread;
+						node[1] = reinterpret_cast<uint64_t>(node);
+						mine.push_back(node);
+					}
+				});
+				//Each thread frees the nodes of its neighbour next round
+				std::rotate(owned.begin(), owned.end() - 1, owned.end());
+			}
+		}
+		CHECK(resource.outstanding == 0);
+	}
+
+	//A tree holding the only allocator over its pool drops the whole pool at once when emptied
+	void engines() {
+		CountingResource resource;
+		{
+			using Pooled = PoolAllocator<std::byte>;
+			using Tree = BPlusTree<int, int, Pooled>;
+			Tree tree(Pooled(std::make_shared<NodePool>(&resource)));
+			CHECK(tree.put(0, 0));
+			const long long started = resource.outstanding;
+			for (int key = 1; key < 100000; key++) {
+				CHECK(tree.put((key * 7919) % 100000, key));
+			}
+			CHECK(resource.outstanding > started && tree.getActiveSize() == 100000);
+			auto copy = tree.clone();
+			CHECK(copy->getActiveSize() == 100000 && tree.get_allocator() == static_cast<Tree*>(copy.get())->get_allocator());
+			//The copy shares the pool, so emptying the tree gives its nodes back one by one
+			CHECK(tree.removeAll());
+			CHECK(resource.outstanding > started);
+			copy.reset();
+			for (int key = 0; key < 1000; key++) {
+				CHECK(tree.put(key, key));
+			}
+			CHECK(tree.removeAll());
+			CHECK(resource.outstanding < started);
+			AdaptiveRadixTree<uint64_t, int, Pooled> radix(Pooled(std::make_shared<NodePool>(&resource)));
+			for (uint64_t key = 0; key < 50000; key++) {
+				CHECK(radix.put(key * 0x9E3779B97F4A7C15ull, static_cast<int>(key)));
+			}
+			int value = 0;
+			CHECK(radix.get(7 * 0x9E3779B97F4A7C15ull, value) && value == 7);
+			CHECK(radix.remove(7 * 0x9E3779B97F4A7C15ull) && !radix.get(7 * 0x9E3779B97F4A7C15ull, value));
+		}
+		CHECK(resource.outstanding == 0);
+	}
+}
+
+int main() {
+	blocks();
+	crossThreads();
+	engines();
+	return 0;
+}
@@ -0,0 +1,148 @@
+#include "../src/Public/EngineSort.h"
+#include "TestSupport.h"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+using core::ParallelSort;
+
+namespace {
+	//Below, at and well above the radix threshold, the largest spread over several threads
+	constexpr size_t SIZES[] = { 0, 1, 2, 100, ParallelSort::RADIX_THRESHOLD - 1, ParallelSort::RADIX_THRESHOLD, 600000 };
+	constexpr unsigned THREADS[] = { 1, 2, 4, 8 };
+
+	template<typename E, typename Generate>
+	void againstStableSort(Generate generate) {
+		std::mt19937_64 random(13);
+		for (size_t size : SIZES) {
+			std::vector<E> items(size);
+			for (auto& item : items) {
+				item = generate(random);
+			}
+			std::vector<E> expected = items;
+			std::stable_sort(expected.begin(), expected.end());
+			for (unsigned threads : THREADS) {
+				std::vector<E> sorted = items;
+				ParallelSort::sort(sorted.data(), sorted.size(), threads);
+				CHECK(sorted == expected);
+			}
+		}
+	}
+
+	void integers() {
+		againstStableSort<int>([](auto& random) { return static_cast<int>(random()); });
+		againstStableSort<uint64_t>([](auto& random) { return random(); });
+		//Equal high bytes, so that the radix sort skips passes
+		againstStableSort<int64_t>([](auto& random) { return static_cast<int64_t>(random() % 1000) - 500; });
+		againstStableSort<short>([](auto& random) { return static_cast<short>(random()); });
+	}
+
+	void floats() {
+		againstStableSort<double>([](auto& random) { return std::ldexp(static_cast<double>(random()) - 0x1p63, -60); });
+		againstStableSort<float>([](auto& random) { return static_cast<float>(static_cast<int>(random() % 2001) - 1000) / 8; });
+	}
+
+	//Zeros of both signs and NaNs are placed by their bit patterns, whether the input is small or large
+	void signedZeros() {
+		for (size_t size : { size_t(16), ParallelSort::RADIX_THRESHOLD * 2 }) {
+			std::vector<double> items(size);
+			for (size_t index = 0; index < size; index++) {
+				items[index] = index % 2 == 0 ? 0.0 : -0.0;
+			}
+			items[3] = std::numeric_limits<double>::quiet_NaN();
+			items[4] = -std::numeric_limits<double>::quiet_NaN();
+			items[5] = 1.0;
+			items[6] = -1.0;
+			ParallelSort::sort(items.data(), items.size(), 1);
+			CHECK(std::isnan(items.front()) && std::signbit(items.front()));
+			CHECK(std::isnan(items.back()) && !std::signbit(items.back()));
+			CHECK(items[1] == -1.0 && items[size - 2] == 1.0);
+			CHECK(std::is_partitioned(items.begin() + 2, items.end() - 2, [](double zero) { return std::signbit(zero); }));
+		}
+	}
+
+	//Items equal under the comparison keep their input order on every path of the merge sort
+	void stability() {
+		using Item = std::pair<int, size_t>;
+		std::mt19937 random(17);
+		for (size_t size : SIZES) {
+			std::vector<Item> items(size);
+			for (size_t index = 0; index < size; index++) {
+				items[index] = { static_cast<int>(random() % 50), index };
+			}
+			auto byKey = [](const Item& first, const Item& second) { return first.first < second.first; };
+			for (unsigned threads : THREADS) {
+				std::vector<Item> sorted = items;
+				ParallelSort::sort(sorted.data(), sorted.size(), threads, byKey);
+				CHECK(std::is_sorted(sorted.begin(), sorted.end()));
+			}
+		}
+	}
+
+	/**
+	* Not default constructible, so the runs are merged in place. Strings are allocated, a moved-from
+	* item left behind shows as an empty one
+	*/
+	struct Named {
+		std::string name;
+		explicit Named(std::string name) : name(std::move(name)) {}
+		bool operator<(const Named& other) const { return name < other.name; }
+	};
+
+	void inPlaceMerges() {
+		std::mt19937 random(19);
+		std::vector<Named> items;
+		for (size_t index = 0; index < 300000; index++) {
+			items.emplace_back("an item long enough to be allocated " + std::to_string(random() % 100000));
+		}
+		std::vector<std::string> expected;
+		for (const auto& item : items) {
+			expected.push_back(item.name);
+		}
+		std::sort(expected.begin(), expected.end());
+		ParallelSort::sort(items.data(), items.size(), 4);
+		for (size_t index = 0; index < items.size(); index++) {
+			CHECK(items[index].name == expected[index]);
+		}
+	}
+
+	//A comparison throwing on a worker thread reaches the caller instead of terminating the program
+	void throwingComparison() {
+		std::vector<int> items(300000);
+		for (size_t index = 0; index < items.size(); index++) {
+			items[index] = static_cast<int>((index * 7919) % items.size());
+		}
+		std::atomic<size_t> comparisons{ 0 };
+		bool rejected = false;
+		try {
+			ParallelSort::sort(items.data(), items.size(), 4, [&](int first, int second) {
+				if (++comparisons == 100000) {
+					throw std::runtime_error("comparison failed");
+				}
+				return first > second;
+			});
+		}
+		catch (const std::runtime_error&) {
+			rejected = true;
+		}
+		CHECK(rejected);
+	}
+}
+
+int main() {
+	integers();
+	floats();
+	signedZeros();
+	stability();
+	inPlaceMerges();
+	throwingComparison();
+	return 0;
+}
@@ -0,0 +1,158 @@
+#include "../src/Private/DataEngine.cpp"
+#include "../src/Private/Abstraction/Set.cpp"
+#include "../src/Private/Implementation/RoaringSet.cpp"
+#include "TestSupport.h"
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+using core::RoaringSet;
+
+namespace {
+	using Roaring = RoaringSet<unsigned>;
+	using Reference = std::set<unsigned>;
+
+	bool matches(Roaring& set, const Reference& reference) {
+		if (set.getActiveSize() != reference.size()) {
+			return false;
+		}
+		std::vector<unsigned> iterated;
+		for (unsigned item : set) {
+			iterated.push_back(item);
+		}
+		if (!std::equal(iterated.begin(), iterated.end(), reference.begin(), reference.end())) {
+			return false;
+		}
+		if (reference.empty()) {
+			return true;
+		}
+		const std::unique_ptr<unsigned[]> items(set.toArray());
+		return std::equal(items.get(), items.get() + reference.size(), reference.begin()) && set.first() == *reference.begin() && set.last() == *reference.rbegin();
+	}
+
+	/**
+	* One chunk filled past ARRAY_LIMIT so that it turns into a bitmap, sparse chunks around it staying
+	* arrays, then the dense chunk thinned out again below the limit
+	*/
+	void againstReference() {
+		Roaring set;
+		Reference reference;
+		std::mt19937 random(59);
+		for (int index = 0; index < 40000; index++) {
+			const unsigned item = index % 4 == 0 ? static_cast<unsigned>(random()) : (1u << 16) + static_cast<unsigned>(random() % 20000);
+			CHECK(set.add(item) == reference.insert(item).second);
+		}
+		CHECK(matches(set, reference));
+		for (int index = 0; index < 60000; index++) {
+			const unsigned item = index % 2 == 0 ? *reference.begin() : (1u << 16) + static_cast<unsigned>(random() % 20000);
+			CHECK(set.remove(item) == (reference.erase(item) == 1));
+			const unsigned probe = static_cast<unsigned>(random() % (3u << 16));
+			CHECK(set.contains(probe) == reference.contains(probe));
+		}
+		CHECK(matches(set, reference));
+		//Built in one pass from the same items in any order
+		std::vector<unsigned> items(reference.begin(), reference.end());
+		std::shuffle(items.begin(), items.end(), random);
+		items.insert(items.end(), items.begin(), items.begin() + items.size() / 3);
+		Roaring built(items.data(), items.size());
+		CHECK(matches(built, reference));
+		CHECK(built == set);
+	}
+
+	//Long ranges become runs once optimized, and stay correct as items are taken out of their middle and put back
+	void runs() {
+		Roaring set;
+		Reference reference;
+		for (unsigned item = 1000; item < 60000; item++) {
+			set.add(item);
+			reference.insert(item);
+		}
+		for (unsigned item = (5u << 16) + 10; item < (5u << 16) + 3000; item++) {
+			set.add(item);
+			reference.insert(item);
+		}
+		const size_t before = set.getMemoryUsage();
+		CHECK(set.optimize());
+		CHECK(set.getMemoryUsage() < before);
+		CHECK(matches(set, reference));
+		for (unsigned item = 2000; item < 60000; item += 97) {
+			CHECK(set.remove(item) && reference.erase(item) == 1);
+		}
+		CHECK(set.add(999) && set.add(60000) && set.add(2000));
+		reference.insert({ 999, 60000, 2000 });
+		CHECK(!set.add(1500) && !set.remove(500));
+		CHECK(matches(set, reference));
+		CHECK(!set.contains((5u << 16) + 9) && set.contains((5u << 16) + 2999));
+		set.optimize();
+		CHECK(matches(set, reference));
+	}
+
+	//The bulk operations against the standard set algorithms, over every mix of container forms
+	void bulk() {
+		std::mt19937 random(61);
+		Reference first;
+		Reference second;
+		for (int index = 0; index < 30000; index++) {
+			first.insert(static_cast<unsigned>(random() % 5) << 16 | static_cast<unsigned>(random() % (index % 2 == 0 ? 9000 : 65536)));
+			second.insert(static_cast<unsigned>(random() % 5) << 16 | static_cast<unsigned>(random() % 3000));
+		}
+		for (unsigned item = (2u << 16) + 100; item < (2u << 16) + 40000; item++) {
+			second.insert(item);
+		}
+		const std::vector<unsigned> firstItems(first.begin(), first.end());
+		const std::vector<unsigned> secondItems(second.begin(), second.end());
+		for (bool optimized : { false, true }) {
+			Roaring left(firstItems.data(), firstItems.size());
+			Roaring right(secondItems.data(), secondItems.size());
+			if (optimized) {
+				right.optimize();
+			}
+			Reference expected;
+			std::set_union(first.begin(), first.end(), second.begin(), second.end(), std::inserter(expected, expected.end()));
+			auto united = left.clone();
+			CHECK(static_cast<Roaring*>(united.get())->addAll(&right));
+			CHECK(matches(*static_cast<Roaring*>(united.get()), expected));
+			CHECK(static_cast<Roaring*>(united.get())->containsAll(&right));
+			expected.clear();
+			std::set_intersection(first.begin(), first.end(), second.begin(), second.end(), std::inserter(expected, expected.end()));
+			auto intersected = left.clone();
+			CHECK(static_cast<Roaring*>(intersected.get())->retainAll(&right));
+			CHECK(matches(*static_cast<Roaring*>(intersected.get()), expected));
+			CHECK(right.containsAll(static_cast<Roaring*>(intersected.get())));
+			expected.clear();
+			std::set_difference(first.begin(), first.end(), second.begin(), second.end(), std::inserter(expected, expected.end()));
+			auto subtracted = left.clone();
+			CHECK(static_cast<Roaring*>(subtracted.get())->discardAll(&right));
+			CHECK(matches(*static_cast<Roaring*>(subtracted.get()), expected));
+			CHECK(!left.containsAll(&right));
+		}
+	}
+
+	void empty() {
+		Roaring set;
+		CHECK(matches(set, {}));
+		bool rejected = false;
+		try {
+			(void)set.first();
+		}
+		catch (const std::out_of_range&) {
+			rejected = true;
+		}
+		CHECK(rejected);
+		CHECK(set.add(0) && set.add(~0u) && set.first() == 0 && set.last() == ~0u);
+		Roaring moved(std::move(set));
+		CHECK(moved.contains(~0u) && set.getActiveSize() == 0);
+	}
+}
+
+int main() {
+	againstReference();
+	runs();
+	bulk();
+	empty();
+	return 0;
+}
@@ -0,0 +1,105 @@
+#include "../src/Private/DataEngine.cpp"
+#include "../src/Private/Abstraction/Stack.cpp"
+#include "../src/Private/Implementation/SegmentedStack.cpp"
+#include "TestSupport.h"
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <stdexcept>
+#include <vector>
+
+using core::SegmentedStack;
+
+namespace {
+	using Arena = std::pmr::polymorphic_allocator<std::byte>;
+	using Stack = SegmentedStack<long long, Arena>;
+
+	//Every block comes from the arena, which has no upstream to fall back on
+	void arenaBacked() {
+		constexpr size_t BLOCKS = 8;
+		std::vector<std::byte> buffer((BLOCKS + 1) * sizeof(Stack::Block));
+		std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+		Stack stack{ Arena(&arena) };
+		std::vector<const long long*> addresses;
+		for (long long item = 0; item < static_cast<long long>(BLOCKS * Stack::BLOCK_SIZE); item++) {
+			addresses.push_back(&stack.emplace(item));
+		}
+		//Items never move once pushed
+		for (size_t index = 0; index < addresses.size(); index++) {
+			CHECK(*addresses[index] == static_cast<long long>(index));
+			CHECK(stack.get(index) == addresses[index]);
+		}
+		//Popping below a block boundary and pushing back reuses the spare block
+		for (size_t round = 0; round < 100; round++) {
+			for (size_t item = 0; item < Stack::BLOCK_SIZE + 1; item++) {
+				CHECK(stack.pop());
+			}
+			for (size_t item = 0; item < Stack::BLOCK_SIZE + 1; item++) {
+				CHECK(stack.push(0));
+			}
+		}
+		CHECK(stack.getActiveSize() == BLOCKS * Stack::BLOCK_SIZE);
+	}
+
+	void lastInFirstOut() {
+		SegmentedStack<int> stack;
+		const int count = static_cast<int>(SegmentedStack<int>::BLOCK_SIZE * 3 + 5);
+		for (int item = 0; item < count; item++) {
+			CHECK(stack.push(item));
+		}
+		CHECK(*stack.peek() == count - 1);
+		int item = -1;
+		for (int expected = count - 1; expected >= 0; expected--) {
+			CHECK(stack.pop(item) && item == expected);
+		}
+		CHECK(!stack.pop(item) && stack.peek() == nullptr);
+	}
+
+	/**
+	* Item whose construction throws when asked to
+	*/
+	struct Checked {
+		int value = 0;
+
+		Checked() = default;
+		Checked(int value, bool failing) : value(value) {
+			if (failing) {
+				throw std::runtime_error("construction failed");
+			}
+		}
+		bool operator==(const Checked&) const = default;
+	};
+
+	//A constructor throwing at a block boundary leaves the top where it was
+	void failingEmplace() {
+		using Checks = SegmentedStack<Checked>;
+		Checks stack;
+		const int count = static_cast<int>(Checks::BLOCK_SIZE);
+		for (int item = 0; item < count; item++) {
+			stack.emplace(item, false);
+		}
+		for (int attempt = 0; attempt < 2; attempt++) {
+			bool rejected = false;
+			try {
+				stack.emplace(count, true);
+			}
+			catch (const std::runtime_error&) {
+				rejected = true;
+			}
+			CHECK(rejected && stack.getActiveSize() == Checks::BLOCK_SIZE && stack.peek()->value == count - 1);
+		}
+		stack.emplace(count, false);
+		CHECK(stack.peek()->value == count);
+		for (int expected = count; expected >= 0; expected--) {
+			CHECK(stack.peek()->value == expected && stack.pop());
+		}
+		CHECK(stack.getActiveSize() == 0);
+	}
+}
+
+int main() {
+	arenaBacked();
+	lastInFirstOut();
+	failingEmplace();
+	return 0;
+}
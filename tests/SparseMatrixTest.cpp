@@ -0,0 +1,144 @@
+#include "../src/Private/DataEngine.cpp"
+#include "../src/Private/Abstraction/Matrix.cpp"
+#include "../src/Private/Implementation/DenseMatrix.cpp"
+#include "../src/Private/Implementation/CSRMatrix.cpp"
+#include "../src/Private/Implementation/CSCMatrix.cpp"
+#include "TestSupport.h"
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+using core::CSCMatrix;
+using core::CSRMatrix;
+using core::DenseMatrix;
+using core::MatrixTriplet;
+
+namespace {
+	constexpr size_t ROWS = 2000;
+	constexpr size_t COLUMNS = 3000;
+
+	using Reference = std::map<std::pair<size_t, size_t>, double>;
+
+	/**
+	* Elements in random order with repeated positions, which are summed. One row holds a third of them,
+	* so that the merge path has to cut it between threads. Values are small integers, which keeps every
+	* sum exact whatever its order
+	*/
+	std::vector<MatrixTriplet<double>> randomTriplets(Reference& reference) {
+		std::mt19937 random(37);
+		std::vector<MatrixTriplet<double>> triplets;
+		for (size_t index = 0; index < 300000; index++) {
+			const size_t row = index % 3 == 0 ? 17 : random() % ROWS;
+			const size_t column = random() % COLUMNS;
+			const double value = static_cast<double>(static_cast<int>(random() % 9) - 4);
+			triplets.push_back({ row, column, value });
+			reference[{ row, column }] += value;
+		}
+		return triplets;
+	}
+
+	std::vector<double> randomVector(size_t size, unsigned seed) {
+		std::mt19937 random(seed);
+		std::vector<double> vector(size);
+		for (double& value : vector) {
+			value = static_cast<double>(static_cast<int>(random() % 7) - 3);
+		}
+		return vector;
+	}
+
+	template<typename Sparse>
+	void products(const Sparse& matrix, const Reference& reference) {
+		const auto right = randomVector(COLUMNS, 1);
+		const auto left = randomVector(ROWS, 2);
+		std::vector<double> expected(ROWS, 0.0);
+		std::vector<double> expectedTransposed(COLUMNS, 0.0);
+		for (const auto& [position, value] : reference) {
+			expected[position.first] += value * right[position.second];
+			expectedTransposed[position.second] += value * left[position.first];
+		}
+		const auto denseValues = randomVector(COLUMNS * 5, 3);
+		const DenseMatrix<double> dense(COLUMNS, 5, denseValues.data());
+		for (unsigned threads : { 1u, 4u }) {
+			std::vector<double> result(ROWS, -1.0);
+			matrix.multiply(right.data(), result.data(), threads);
+			CHECK(result == expected);
+			std::vector<double> transposedResult(COLUMNS, -1.0);
+			matrix.multiplyTransposed(left.data(), transposedResult.data(), threads);
+			CHECK(transposedResult == expectedTransposed);
+			const auto product = matrix.multiply(dense, threads);
+			for (size_t column = 0; column < 5; column++) {
+				std::vector<double> expectedColumn(ROWS, 0.0);
+				for (const auto& [position, value] : reference) {
+					expectedColumn[position.first] += value * dense(position.second, column);
+				}
+				for (size_t row = 0; row < ROWS; row++) {
+					CHECK(product(row, column) == expectedColumn[row]);
+				}
+			}
+		}
+	}
+
+	template<typename Sparse>
+	void elements(Sparse& matrix, const Reference& reference) {
+		CHECK(matrix.getRows() == ROWS && matrix.getColumns() == COLUMNS);
+		CHECK(matrix.getNonZeros() == reference.size());
+		for (const auto& [position, value] : reference) {
+			CHECK(matrix.get(position.first, position.second) == value);
+		}
+		CHECK(matrix.get(ROWS - 1, COLUMNS - 1) == (reference.contains({ ROWS - 1, COLUMNS - 1 }) ? reference.at({ ROWS - 1, COLUMNS - 1 }) : 0.0));
+		//The structure is fixed, only stored elements can change
+		const auto& [stored, value] = *reference.begin();
+		CHECK(matrix.set(stored.first, stored.second, value + 1));
+		CHECK(matrix.get(stored.first, stored.second) == value + 1);
+		CHECK(matrix.set(stored.first, stored.second, value));
+		size_t missing = 0;
+		while (reference.contains({ 0, missing })) {
+			missing++;
+		}
+		CHECK(!matrix.set(0, missing, 1.0));
+	}
+
+	void compressedRows() {
+		Reference reference;
+		const auto triplets = randomTriplets(reference);
+		CSRMatrix<double> matrix(ROWS, COLUMNS, triplets.data(), triplets.size());
+		elements(matrix, reference);
+		products(matrix, reference);
+		//Converting back and forth keeps every element
+		const CSCMatrix<double> columns(matrix);
+		CHECK(CSRMatrix<double>(columns) == matrix);
+		const auto transpose = matrix.transpose();
+		CHECK(transpose.getRows() == COLUMNS && transpose.getNonZeros() == reference.size());
+		const auto& [position, value] = *reference.rbegin();
+		CHECK(transpose.get(position.second, position.first) == value);
+	}
+
+	void compressedColumns() {
+		Reference reference;
+		const auto triplets = randomTriplets(reference);
+		CSCMatrix<double> matrix(ROWS, COLUMNS, triplets.data(), triplets.size());
+		elements(matrix, reference);
+		products(matrix, reference);
+	}
+
+	void outside() {
+		const MatrixTriplet<double> triplet{ 3, 0, 1.0 };
+		bool rejected = false;
+		try {
+			CSRMatrix<double> matrix(3, 3, &triplet, 1);
+		}
+		catch (const std::out_of_range&) {
+			rejected = true;
+		}
+		CHECK(rejected);
+	}
+}
+
+int main() {
+	compressedRows();
+	compressedColumns();
+	outside();
+	return 0;
+}
@@ -0,0 +1,153 @@
+#include "../src/Private/DataEngine.cpp"
+#include "../src/Private/Abstraction/Deque.cpp"
+#include "../src/Private/Abstraction/Graph.cpp"
+#include "../src/Private/Abstraction/Map.cpp"
+#include "../src/Private/Abstraction/Matrix.cpp"
+#include "../src/Private/Abstraction/Tree.cpp"
+#include "../src/Private/Implementation/ArrayDeque.cpp"
+#include "../src/Private/Implementation/BPlusTree.cpp"
+#include "../src/Private/Implementation/CSRGraph.cpp"
+#include "../src/Private/Implementation/CSRMatrix.cpp"
+#include "../src/Private/Implementation/DenseMatrix.cpp"
+#include "../src/Private/Implementation/HashMap.cpp"
+#include "TestSupport.h"
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+using namespace core;
+
+namespace {
+	//A deque wrapped around its buffer equals one stored from the start of it
+	void dequeEquality() {
+		ArrayDeque<int> wrapped;
+		ArrayDeque<int> straight;
+		for (int item = 0; item < 10; item++) {
+			wrapped.addFirst(9 - item);
+			straight.addLast(item);
+		}
+		CHECK(wrapped == straight);
+		const Deque<int>& erased = straight;
+		CHECK(wrapped == erased);
+		straight.addLast(10);
+		CHECK(!(wrapped == straight));
+	}
+
+	//Inserted in opposite orders, the trees split their leaves differently
+	void treeEquality() {
+		BPlusTree<int, std::string> ascending;
+		BPlusTree<int, std::string> descending;
+		constexpr int COUNT = 1000;
+		for (int key = 0; key < COUNT; key++) {
+			ascending.put(key, std::to_string(key));
+			descending.put(COUNT - 1 - key, std::to_string(COUNT - 1 - key));
+		}
+		CHECK(ascending == descending);
+		CHECK(ascending.equivalence(descending));
+		descending.put(COUNT / 2, "changed");
+		CHECK(!(ascending == descending));
+	}
+
+	void graphEquality() {
+		const GraphEdge<unsigned> edges[] = { { 0, 1 }, { 1, 2 }, { 2, 0 }, { 2, 3 } };
+		const GraphEdge<unsigned> reordered[] = { { 2, 3 }, { 2, 0 }, { 0, 1 }, { 1, 2 } };
+		CSRGraph<unsigned> graph(4, edges, 4);
+		CSRGraph<unsigned> same(4, reordered, 4);
+		CSRGraph<unsigned> other(4, edges, 3);
+		CHECK(graph == same);
+		CHECK(!(graph == other));
+	}
+
+	//Without a range, graphs merge every vertex of the other graph, and matrices every row of the other matrix
+	void wholeMerges() {
+		const GraphEdge<unsigned> edges[] = { { 0, 1 }, { 0, 2 }, { 1, 2 }, { 2, 0 }, { 1, 0 } };
+		const GraphEdge<unsigned> others[] = { { 2, 1 }, { 0, 1 }, { 0, 2 }, { 1, 2 } };
+		CSRGraph<unsigned> graph(3, edges, 5);
+		CSRGraph<unsigned> other(3, others, 4);
+		std::unique_ptr<CSRGraph<unsigned>> graphs = graph.merge(other);
+		CHECK(graphs != nullptr && graphs->getVertices() == 3 && graphs->getActiveSize() == 6 && graphs->containsEdge(2, 1));
+		const Graph<unsigned>& erasedGraph = other;
+		CHECK(graph.merge(erasedGraph) != nullptr && graph.merge(other, 1) != nullptr);
+
+		const double values[] = { 1.0, 2.0, 3.0, 4.0, 5.0, 6.0 };
+		DenseMatrix<double> dense(3, 2, values);
+		std::unique_ptr<DenseMatrix<double>> stacked = dense.merge(dense);
+		CHECK(stacked != nullptr && stacked->getRows() == 6 && stacked->get(5, 1) == 6.0);
+
+		const MatrixTriplet<double> triplets[] = { { 0, 0, 1.0 } };
+		CSRMatrix<double> sparse(3, 2, triplets, 1);
+		std::unique_ptr<CSRMatrix<double>> sparseStacked = sparse.merge(sparse);
+		CHECK(sparseStacked != nullptr && sparseStacked->getRows() == 6 && sparseStacked->get(3, 0) == 1.0);
+		const Matrix<double>& erasedMatrix = dense;
+		std::unique_ptr<CSRMatrix<double>> mixed = sparse.merge(erasedMatrix);
+		CHECK(mixed != nullptr && mixed->getRows() == 6 && mixed->get(4, 1) == 4.0);
+	}
+
+	//HashMap has no static merge, merge goes through the dynamic form and still returns a HashMap
+	void dynamicMerge() {
+		HashMap<int, int> first;
+		HashMap<int, int> second;
+		for (int key = 0; key < 100; key++) {
+			first.put(key, key);
+			second.put(key + 50, -key);
+		}
+		std::unique_ptr<HashMap<int, int>> merged = first.merge(second);
+		CHECK(merged != nullptr);
+		CHECK(merged->getActiveSize() == 150);
+		int value = 0;
+		CHECK(merged->get(10, value) && value == 10);
+		CHECK(merged->get(120, value) && value == -70);
+	}
+
+	/**
+	* Value whose copies throw once it is poisoned, moves never do
+	*/
+	struct Fragile {
+		bool poisoned = false;
+
+		Fragile() = default;
+		explicit Fragile(bool poisoned) : poisoned(poisoned) {}
+		Fragile(const Fragile& other) : poisoned(other.poisoned) {
+			if (poisoned) {
+				throw std::runtime_error("copy failed");
+			}
+		}
+		Fragile(Fragile&&) noexcept = default;
+		Fragile& operator=(const Fragile& other) {
+			if (other.poisoned) {
+				throw std::runtime_error("copy failed");
+			}
+			return *this;
+		}
+		Fragile& operator=(Fragile&&) noexcept = default;
+		bool operator==(const Fragile&) const = default;
+	};
+
+	//A merge failing part way through frees the engine it was building, the leak checker of the sanitizer builds sees it otherwise
+	void failingMerge() {
+		HashMap<int, Fragile> first;
+		HashMap<int, Fragile> second;
+		for (int key = 0; key < 100; key++) {
+			first.put(key, Fragile());
+			second.put(key + 50, Fragile(key == 70));
+		}
+		bool rejected = false;
+		try {
+			first.merge(second);
+		}
+		catch (const std::runtime_error&) {
+			rejected = true;
+		}
+		CHECK(rejected && first.getActiveSize() == 100);
+	}
+}
+
+int main() {
+	dequeEquality();
+	treeEquality();
+	graphEquality();
+	wholeMerges();
+	dynamicMerge();
+	failingMerge();
+	return 0;
+}
@@ -0,0 +1,208 @@
+#include "../src/Private/DataEngine.cpp"
+#include "../src/Private/Abstraction/Trie.cpp"
+#include "../src/Private/Implementation/SuccinctTrie.cpp"
+#include "TestSupport.h"
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using core::Entry;
+using core::SuccinctTrie;
+
+namespace {
+	using Reference = std::map<std::string, int>;
+
+	Reference randomKeys(unsigned seed, size_t count) {
+		Reference reference;
+		std::mt19937 random(seed);
+		while (reference.size() < count) {
+			std::string key(1 + random() % 8, '\0');
+			for (char& byte : key) {
+				byte = static_cast<char>('a' + random() % 5);
+			}
+			reference.emplace(key, static_cast<int>(reference.size()));
+		}
+		return reference;
+	}
+
+	std::vector<Entry<std::string, int>> entriesOf(const Reference& reference) {
+		std::vector<Entry<std::string, int>> entries;
+		for (const auto& [key, value] : reference) {
+			entries.push_back({ key, value });
+		}
+		return entries;
+	}
+
+	//Every lookup of the trie must agree with the map it was built from
+	void verify(SuccinctTrie<std::string, int>& trie, const Reference& reference) {
+		CHECK(trie.getActiveSize() == reference.size());
+		auto expected = reference.begin();
+		for (const auto& entry : trie) {
+			CHECK(entry.key == expected->first && entry.value == expected->second);
+			++expected;
+		}
+		CHECK(expected == reference.end());
+		int value = -1;
+		for (const auto& [key, stored] : reference) {
+			CHECK(trie.get(key, value) && value == stored);
+			CHECK(!trie.containsKey(key + "z"));
+		}
+		for (const std::string prefix : { "", "a", "bc", "eeee" }) {
+			size_t count = 0;
+			trie.scanPrefix(prefix, [&](const Entry<std::string, int>& entry) {
+				CHECK(entry.key.starts_with(prefix) && reference.at(entry.key) == entry.value);
+				count++;
+				return true;
+			});
+			size_t expectedCount = 0;
+			for (auto it = reference.lower_bound(prefix); it != reference.end() && it->first.starts_with(prefix); ++it) {
+				expectedCount++;
+			}
+			CHECK(count == expectedCount);
+		}
+		Entry<std::string, int> longest;
+		const std::string probe = "abcdeabcdeabcde";
+		bool found = false;
+		for (size_t length = probe.size() + 1; length-- > 0 && !found;) {
+			found = reference.contains(probe.substr(0, length));
+			CHECK(!found || (trie.longestPrefix(probe, longest) && longest.key == probe.substr(0, length)));
+		}
+		CHECK(found || !trie.longestPrefix(probe, longest));
+	}
+
+	//Large enough for the rank and select directories to span several blocks
+	void built() {
+		const Reference reference = randomKeys(3, 20000);
+		const auto entries = entriesOf(reference);
+		SuccinctTrie<std::string, int> trie(entries.data(), entries.size());
+		verify(trie, reference);
+	}
+
+	//A view over a copy of the encoding, as a memory mapped file would be, answers like the trie itself
+	void view() {
+		const Reference reference = randomKeys(5, 3000);
+		const auto entries = entriesOf(reference);
+		SuccinctTrie<std::string, int> trie(entries.data(), entries.size());
+		const size_t size = trie.getEncodedSize();
+		auto buffer = std::make_unique<uint64_t[]>((size + 7) / 8);
+		std::memcpy(buffer.get(), trie.getEncoding(), size);
+		SuccinctTrie<std::string, int> mapped(buffer.get(), size);
+		verify(mapped, reference);
+		CHECK(mapped == trie);
+		bool rejected = false;
+		try {
+			SuccinctTrie<std::string, int> truncated(buffer.get(), 8);
+		}
+		catch (const std::invalid_argument&) {
+			rejected = true;
+		}
+		CHECK(rejected);
+	}
+
+	/**
+	* Rewrites one word of the header of a copied encoding and checks that a view over it is rejected. The
+	* header words are the magic and version, the value size, the key count, the node count, the section
+	* offsets and the total size
+	*/
+	bool rejects(const SuccinctTrie<std::string, int>& trie, size_t word, uint64_t value, size_t size) {
+		auto buffer = std::make_unique<uint64_t[]>((trie.getEncodedSize() + 7) / 8);
+		std::memcpy(buffer.get(), trie.getEncoding(), trie.getEncodedSize());
+		buffer[word] = value;
+		try {
+			SuccinctTrie<std::string, int> corrupt(buffer.get(), size);
+		}
+		catch (const std::invalid_argument&) {
+			return true;
+		}
+		return false;
+	}
+
+	//Owned encodings start every section on a cache line, views check every section against the counts and the size
+	void corruptViews() {
+		constexpr size_t NODES = 3;
+		constexpr size_t VALUES = 10;
+		constexpr size_t SIZE = 11;
+		const auto entries = entriesOf(randomKeys(7, 3000));
+		SuccinctTrie<std::string, int> trie(entries.data(), entries.size());
+		CHECK(reinterpret_cast<uintptr_t>(trie.getEncoding()) % 64 == 0);
+		auto header = static_cast<const uint64_t*>(trie.getEncoding());
+		const size_t size = trie.getEncodedSize();
+		CHECK(header[SIZE] == size);
+		//A buffer cut after the offset of the values, with a header claiming it is whole
+		CHECK(rejects(trie, SIZE, header[VALUES], header[VALUES]));
+		//More nodes than the sections were laid out for
+		CHECK(rejects(trie, NODES, header[NODES] * 2, size));
+		CHECK(rejects(trie, NODES, UINT64_MAX, size));
+		CHECK(rejects(trie, VALUES, header[VALUES] + 64, size));
+		CHECK(!rejects(trie, SIZE, size, size));
+	}
+
+	void immutable() {
+		const auto entries = entriesOf(randomKeys(7, 10));
+		SuccinctTrie<std::string, int> trie(entries.data(), entries.size());
+		bool rejected = false;
+		try {
+			trie.put("new", 1);
+		}
+		catch (const std::logic_error&) {
+			rejected = true;
+		}
+		CHECK(rejected);
+		CHECK(trie.getActiveSize() == 10);
+		SuccinctTrie<std::string, int> empty;
+		int value = 0;
+		CHECK(empty.getActiveSize() == 0 && !empty.get("", value));
+	}
+
+	//Merging builds a new trie, the other trie's value wins on equal keys
+	void merged() {
+		Reference first = randomKeys(9, 500);
+		Reference second = randomKeys(10, 500);
+		for (auto& [key, value] : second) {
+			value += 1000;
+		}
+		const auto firstEntries = entriesOf(first);
+		const auto secondEntries = entriesOf(second);
+		SuccinctTrie<std::string, int> left(firstEntries.data(), firstEntries.size());
+		SuccinctTrie<std::string, int> right(secondEntries.data(), secondEntries.size());
+		auto both = left.merge(right);
+		CHECK(both != nullptr);
+		for (const auto& [key, value] : second) {
+			first.insert_or_assign(key, value);
+		}
+		verify(*both, first);
+	}
+
+	//Moving takes the encoding over, owned or viewed, and leaves an empty trie behind
+	void moves() {
+		const Reference reference = randomKeys(11, 800);
+		const auto entries = entriesOf(reference);
+		SuccinctTrie<std::string, int> trie(entries.data(), entries.size());
+		SuccinctTrie<std::string, int> moved(std::move(trie));
+		verify(moved, reference);
+		int value = 0;
+		CHECK(trie.getActiveSize() == 0 && !trie.get(reference.begin()->first, value));
+		const size_t size = moved.getEncodedSize();
+		auto buffer = std::make_unique<uint64_t[]>((size + 7) / 8);
+		std::memcpy(buffer.get(), moved.getEncoding(), size);
+		SuccinctTrie<std::string, int> mapped(buffer.get(), size);
+		trie = std::move(mapped);
+		verify(trie, reference);
+		CHECK(trie.getEncoding() == buffer.get() && mapped.getActiveSize() == 0);
+	}
+}
+
+int main() {
+	built();
+	view();
+	corruptViews();
+	immutable();
+	merged();
+	moves();
+	return 0;
+}
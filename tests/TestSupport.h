@@ -0,0 +1,40 @@
+#pragma once
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <latch>
+#include <thread>
+#include <vector>
+
+//Aborts the test with the failed condition and its location, in release builds as well
+#define CHECK(condition) \
+	do { \
+		if (!(condition)) { \
+			std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+			std::abort(); \
+		} \
+	} while (false)
+
+namespace test {
+
+	/**
+	* Runs the task on the given number of threads, all released at once so that they contend
+	* @param threads Number of threads
+	* @param task Function called with the index of the thread
+	*/
+	template<typename Task>
+	void concurrently(size_t threads, Task&& task) {
+		std::latch start(static_cast<std::ptrdiff_t>(threads));
+		std::vector<std::thread> pool;
+		pool.reserve(threads);
+		for (size_t thread = 0; thread < threads; thread++) {
+			pool.emplace_back([&, thread] {
+				start.arrive_and_wait();
+				task(thread);
+			});
+		}
+		for (auto& thread : pool) {
+			thread.join();
+		}
+	}
+}
@@ -0,0 +1,138 @@
+#include "../src/Private/DataEngine.cpp"
+#include "../src/Private/Abstraction/Map.cpp"
+#include "../src/Private/Abstraction/Tree.cpp"
+#include "../src/Private/Abstraction/Trie.cpp"
+#include "../src/Private/Implementation/AdaptiveRadixTree.cpp"
+#include "../src/Private/Implementation/BPlusTree.cpp"
+#include "../src/Private/Implementation/ConcurrentHashMap.cpp"
+#include "../src/Private/Implementation/HashMap.cpp"
+#include "TestSupport.h"
+#include <atomic>
+#include <memory>
+#include <string>
+
+using core::AdaptiveRadixTree;
+using core::BPlusTree;
+using core::ConcurrentHashMap;
+using core::Entry;
+using core::HashMap;
+
+namespace {
+	constexpr size_t READERS = 6;
+	constexpr int KEYS = 64;
+	constexpr int VERSIONS = 2000;
+
+	//Every version maps all the keys to its own number
+	void fill(HashMap<int, int>& map, int version) {
+		for (int key = 0; key < KEYS; key++) {
+			map.put(key, version);
+		}
+	}
+
+	//Readers must see each snapshot as one whole version, never older than one they saw before
+	void readersAndWriter() {
+		HashMap<int, int> initial;
+		fill(initial, 0);
+		auto image = initial.getThreadSafeImage<HashMap<int, int>>();
+		CHECK(image != nullptr);
+		std::atomic<bool> writing{ true };
+		test::concurrently(READERS + 1, [&](size_t thread) {
+			if (thread == READERS) {
+				for (int version = 1; version <= VERSIONS; version++) {
+					//Alternates copies of the current version with engines built aside
+					if (version % 2 == 0) {
+						image->update([version](HashMap<int, int>& map) { fill(map, version); });
+					}
+					else {
+						auto next = std::make_unique<HashMap<int, int>>();
+						fill(*next, version);
+						image->publish(std::move(next));
+					}
+				}
+				writing = false;
+				return;
+			}
+			int seen = 0;
+			do {
+				auto snapshot = image->snapshot();
+				CHECK(snapshot->getActiveSize() == KEYS);
+				int version = -1;
+				CHECK(snapshot->get(0, version));
+				CHECK(version >= seen);
+				seen = version;
+				int value = -1;
+				for (int key = 1; key < KEYS; key++) {
+					CHECK(snapshot->get(key, value) && value == version);
+				}
+			} while (writing);
+		});
+		auto last = image->snapshot();
+		int version = -1;
+		CHECK(last->get(KEYS - 1, version) && version == VERSIONS);
+	}
+
+	//A snapshot keeps its version alive and unchanged after newer ones are published
+	void heldSnapshot() {
+		HashMap<int, int> initial;
+		fill(initial, 0);
+		auto image = initial.getThreadSafeImage<HashMap<int, int>>();
+		auto held = image->snapshot();
+		for (int version = 1; version <= 10; version++) {
+			image->update([version](HashMap<int, int>& map) { fill(map, version); });
+		}
+		int value = -1;
+		CHECK(held->get(KEYS / 2, value) && value == 0);
+		CHECK(image->snapshot()->get(KEYS / 2, value) && value == 10);
+		//The engine the image was taken from is a copy, not shared
+		initial.put(0, -1);
+		CHECK(held->get(0, value) && value == 0);
+	}
+
+	//Snapshots of ordered engines answer every lookup of their tree or trie through the const interface
+	void orderedSnapshots() {
+		using Tree = BPlusTree<int, int>;
+		Tree tree;
+		for (int key = 0; key < 1000; key += 2) {
+			tree.put(key, key * 3);
+		}
+		auto treeImage = tree.getThreadSafeImage<Tree>();
+		auto treeView = treeImage->snapshot();
+		treeImage->update([](Tree& next) { next.put(1, 1); });
+		const Tree& frozen = *treeView;
+		int value = -1;
+		Entry<int, int> entry;
+		CHECK(frozen.get(500, value) && value == 1500 && !frozen.containsKey(1));
+		CHECK(frozen.first(entry) && entry.key == 0 && frozen.last(entry) && entry.key == 998);
+		CHECK(frozen.ceiling(501, entry) && entry.key == 502 && frozen.floor(501, entry) && entry.key == 500);
+		CHECK(frozen.scan(990, [](const Entry<int, int>&) { return true; }) == 5);
+		CHECK(treeImage->snapshot()->containsKey(1));
+
+		using Trie = AdaptiveRadixTree<std::string, int>;
+		Trie trie;
+		for (int index = 0; index < 100; index++) {
+			trie.put("key" + std::to_string(index), index);
+		}
+		auto trieImage = trie.getThreadSafeImage<Trie>();
+		auto trieView = trieImage->snapshot();
+		trieImage->update([](Trie& next) { next.remove("key7"); });
+		const Trie& held = *trieView;
+		Entry<std::string, int> match;
+		CHECK(held.get("key7", value) && value == 7 && held.containsKey("key42"));
+		CHECK(held.scanPrefix("key9", [](const Entry<std::string, int>&) { return true; }) == 11);
+		CHECK(held.longestPrefix("key42suffix", match) && match.key == "key42");
+		CHECK(!trieImage->snapshot()->containsKey("key7"));
+	}
+
+	void mismatchedType() {
+		HashMap<int, int> map;
+		CHECK((map.getThreadSafeImage<ConcurrentHashMap<int, int>>() == nullptr));
+	}
+}
+
+int main() {
+	readersAndWriter();
+	heldSnapshot();
+	orderedSnapshots();
+	mismatchedType();
+	return 0;
+}
@@ -0,0 +1,78 @@
+#include "../src/Private/DataEngine.cpp"
+#include "../src/Private/Abstraction/Deque.cpp"
+#include "../src/Private/Implementation/WorkStealingDeque.cpp"
+#include "TestSupport.h"
+#include <atomic>
+#include <memory>
+
+using core::WorkStealingDeque;
+
+namespace {
+	constexpr size_t THIEVES = 6;
+	constexpr size_t ITEMS = 200000;
+
+	/**
+	* The owner pushes every item and pops some of them back while thieves steal from the head. The small
+	* initial capacity makes the ring grow under the thieves. Each item must be taken exactly once
+	*/
+	void ownerAndThieves() {
+		WorkStealingDeque<size_t> deque(4);
+		auto taken = std::make_unique<std::atomic<unsigned>[]>(ITEMS);
+		std::atomic<bool> pushing{ true };
+		auto take = [&](size_t item) {
+			CHECK(item < ITEMS);
+			taken[item]++;
+		};
+		test::concurrently(THIEVES + 1, [&](size_t thread) {
+			size_t item = 0;
+			if (thread == 0) {
+				for (size_t next = 0; next < ITEMS; next++) {
+					deque.addLast(next);
+					if (next % 3 == 0 && deque.tryRemoveLast(item)) {
+						take(item);
+					}
+				}
+				pushing = false;
+				while (deque.tryRemoveLast(item)) {
+					take(item);
+				}
+				return;
+			}
+			while (pushing || deque.getActiveSize() > 0) {
+				if (deque.steal(item)) {
+					take(item);
+				}
+			}
+		});
+		CHECK(deque.getActiveSize() == 0);
+		for (size_t item = 0; item < ITEMS; item++) {
+			CHECK(taken[item] == 1);
+		}
+	}
+
+	//Without thieves the owner's end behaves as a stack
+	void ownerOnly() {
+		WorkStealingDeque<int> deque(2);
+		for (int item = 0; item < 100; item++) {
+			deque.addLast(item);
+		}
+		CHECK(deque.getActiveSize() == 100);
+		CHECK(deque.peekFirst() == 0);
+		int item = -1;
+		for (int expected = 99; expected >= 50; expected--) {
+			CHECK(deque.tryRemoveLast(item) && item == expected);
+		}
+		for (int expected = 0; expected < 50; expected++) {
+			CHECK(deque.steal(item) && item == expected);
+		}
+		CHECK(!deque.steal(item));
+		CHECK(!deque.tryRemoveLast(item));
+		CHECK(!deque.addFirst(0));
+	}
+}
+
+int main() {
+	ownerOnly();
+	ownerAndThieves();
+	return 0;
+}